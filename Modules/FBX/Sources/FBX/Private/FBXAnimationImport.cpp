@@ -79,20 +79,6 @@ void SaveAnimation(const FBXAnimationStackData& fbxStackAnimationData, const Fil
     using namespace FBXAnimationImportDetails;
 
     //binary file format described in 'AnimationBinaryFormat.md'
-    struct ChannelHeader
-    {
-        //Track part
-        uint8 target;
-        uint8 pad0[3];
-
-        //Channel part
-        uint32 signature = AnimationChannel::ANIMATION_CHANNEL_DATA_SIGNATURE;
-        uint8 dimension = 0;
-        uint8 interpolation = 0;
-        uint16 compression = 0;
-        uint32 keyCount = 0;
-    } channelHeader;
-
     ScopedPtr<File> file(File::Create(filePath, File::CREATE | File::WRITE));
     if (file)
     {
@@ -132,51 +118,46 @@ void SaveAnimation(const FBXAnimationStackData& fbxStackAnimationData, const Fil
             {
                 if (!fbxChannelData.animationKeys.empty())
                 {
-                    channelHeader.target = fbxChannelData.channel;
-                    channelHeader.keyCount = uint32(fbxChannelData.animationKeys.size());
-
-                    if (channelHeader.target == AnimationTrack::CHANNEL_TARGET_POSITION)
+                    uint8 dimension = 0;
+                    AnimationChannel::eInterpolation interpolation = AnimationChannel::INTERPOLATION_LINEAR;
+                    if (fbxChannelData.channel == AnimationTrack::CHANNEL_TARGET_POSITION)
                     {
-                        channelHeader.dimension = 3;
-                        channelHeader.interpolation = uint8(AnimationChannel::INTERPOLATION_LINEAR);
+                        dimension = 3;
                     }
-                    else if (channelHeader.target == AnimationTrack::CHANNEL_TARGET_ORIENTATION)
+                    else if (fbxChannelData.channel == AnimationTrack::CHANNEL_TARGET_ORIENTATION)
                     {
-                        channelHeader.dimension = 4;
-                        channelHeader.interpolation = uint8(AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR);
+                        dimension = 4;
+                        interpolation = AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR;
                     }
-                    else if (channelHeader.target == AnimationTrack::CHANNEL_TARGET_SCALE)
+                    else if (fbxChannelData.channel == AnimationTrack::CHANNEL_TARGET_SCALE)
                     {
-                        channelHeader.dimension = 1;
-                        channelHeader.interpolation = uint8(AnimationChannel::INTERPOLATION_LINEAR);
+                        dimension = 1;
                     }
 
-                    WriteToBuffer(animationData, &channelHeader);
-
-                    for (uint32 k = 0; k < channelHeader.keyCount; ++k)
+                    Vector<float32> keyTimes;
+                    Vector<float32> keyValues;
+                    for (const FBXAnimationKey& key : fbxChannelData.animationKeys)
                     {
-                        const FBXAnimationKey& key = fbxChannelData.animationKeys[k];
-
-                        float32 relativeKeyTime = key.time - fbxStackAnimationData.minTimeStamp;
-                        WriteToBuffer(animationData, &relativeKeyTime);
+                        keyTimes.push_back(key.time - fbxStackAnimationData.minTimeStamp);
 
-                        if (channelHeader.target == AnimationTrack::CHANNEL_TARGET_POSITION)
-                        {
-                            Vector3 position = Vector3(key.value.data);
-                            WriteToBuffer(animationData, &position);
-                        }
-                        else if (channelHeader.target == AnimationTrack::CHANNEL_TARGET_ORIENTATION)
+                        Vector4 value = key.value;
+                        if (fbxChannelData.channel == AnimationTrack::CHANNEL_TARGET_ORIENTATION)
                         {
                             Quaternion orientation = Quaternion(key.value.data);
                             orientation.Normalize();
-                            WriteToBuffer(animationData, &orientation);
-                        }
-                        else if (channelHeader.target == AnimationTrack::CHANNEL_TARGET_SCALE)
-                        {
-                            float32 scale = key.value.x;
-                            WriteToBuffer(animationData, &scale);
+                            value = Vector4(orientation.data);
                         }
+                        keyValues.insert(keyValues.end(), value.data, value.data + dimension);
                     }
+
+                    //Track part
+                    uint8 target = uint8(fbxChannelData.channel);
+                    WriteToBuffer(animationData, &target);
+                    uint8 pad[3] = {};
+                    WriteToBuffer(animationData, pad, 3);
+
+                    //Channel part
+                    AnimationChannel::WriteData(dimension, interpolation, AnimationChannel::COMPRESSION_QUANTIZED, keyTimes, keyValues, animationData);
                 }
             }
         }
@@ -2,6 +2,7 @@
 
 #include <Base/Platform.h>
 #include <Debug/DebuggerDetection.h>
+#include <Logger/Logger.h>
 #if defined(__DAVAENGINE_WIN32__)
 #pragma warning(push)
 #pragma warning(disable : 4091) // 'typedef ': ignored on left of '' when no variable is declared
@@ -60,6 +61,7 @@ void MakeMinidump(EXCEPTION_POINTERS* e)
 
 LONG CALLBACK UnhandledHandler(EXCEPTION_POINTERS* e)
 {
+    Logger::FlushLog();
     MakeMinidump(e);
     SetUnhandledExceptionFilter(prevFilter);
     return EXCEPTION_CONTINUE_SEARCH;
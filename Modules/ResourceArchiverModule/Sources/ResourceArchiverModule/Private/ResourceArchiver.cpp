@@ -14,6 +14,7 @@
 #include <Utils/CRC32.h>
 #include <Compression/LZ4Compressor.h>
 #include <Compression/ZipCompressor.h>
+#include <Compression/DictionaryTrainer.h>
 #include <Platform/DeviceInfo.h>
 #include <Time/DateTime.h>
 #include <Logger/Logger.h>
@@ -28,6 +29,7 @@ ENUM_DECLARE(DAVA::Compressor::Type)
     ENUM_ADD_DESCR(static_cast<int>(DAVA::Compressor::Type::Lz4), "lz4");
     ENUM_ADD_DESCR(static_cast<int>(DAVA::Compressor::Type::Lz4HC), "lz4hc");
     ENUM_ADD_DESCR(static_cast<int>(DAVA::Compressor::Type::RFC1951), "rfc1951");
+    ENUM_ADD_DESCR(static_cast<int>(DAVA::Compressor::Type::Lz4Dict), "lz4dict");
     ENUM_ADD_DESCR(static_cast<int>(DAVA::Compressor::Type::None), "none");
 };
 
@@ -442,11 +444,85 @@ const Compressor* GetCompressor(Compressor::Type compressorType)
     }
 }
 
+// split content into blocks of `blockSize` bytes and compress every block independently
+// packed layout is described near PackFormat::IsChunkedEntry
+bool CompressBlocks(const Compressor* compressor, const Vector<uint8>& in, uint32 blockSize, Vector<uint8>& out)
+{
+    const uint32 originalSize = static_cast<uint32>(in.size());
+    const uint32 blocksCount = PackFormat::GetBlocksCount(originalSize, blockSize);
+
+    Vector<uint32> compressedBlockSizes(blocksCount);
+    Vector<uint8> blocksData;
+    Vector<uint8> blockIn;
+    Vector<uint8> blockOut;
+
+    for (uint32 i = 0; i < blocksCount; ++i)
+    {
+        const uint32 blockBegin = i * blockSize;
+        const uint32 blockOriginalSize = std::min(blockSize, originalSize - blockBegin);
+        blockIn.assign(in.begin() + blockBegin, in.begin() + blockBegin + blockOriginalSize);
+
+        if (!compressor->Compress(blockIn, blockOut))
+        {
+            return false;
+        }
+
+        // block that can't be compressed is stored as is
+        const Vector<uint8>& useBlock = (blockOut.size() < blockIn.size()) ? blockOut : blockIn;
+        compressedBlockSizes[i] = static_cast<uint32>(useBlock.size());
+        blocksData.insert(blocksData.end(), useBlock.begin(), useBlock.end());
+    }
+
+    const size_t tableSize = blocksCount * sizeof(uint32);
+    out.resize(tableSize);
+    Memcpy(out.data(), compressedBlockSizes.data(), tableSize);
+    out.insert(out.end(), blocksData.begin(), blocksData.end());
+
+    return true;
+}
+
+// train dictionary on small files, which benefit from it the most
+Vector<uint8> TrainDictionary(const Vector<CollectedFile>& collectedFiles, uint32 dictionarySize)
+{
+    const uint32 maxSampleSize = 128 * 1024;
+    const size_t maxSamplesCount = 4096;
+    const uint64 maxSamplesTotalSize = 100ull * dictionarySize;
+
+    FileSystem* fs = FileSystem::Instance();
+
+    Vector<Vector<uint8>> samples;
+    uint64 samplesTotalSize = 0;
+
+    // take files evenly from all folders, collected files are sorted by path
+    const size_t step = std::max(collectedFiles.size() / maxSamplesCount, static_cast<size_t>(1));
+    for (size_t i = 0; i < collectedFiles.size() && samplesTotalSize < maxSamplesTotalSize; i += step)
+    {
+        uint64 fileSize = 0;
+        if (!fs->GetFileSize(collectedFiles[i].absPath, fileSize) || fileSize == 0 || fileSize > maxSampleSize)
+        {
+            continue;
+        }
+
+        Vector<uint8> sample;
+        if (fs->ReadFileContents(collectedFiles[i].absPath, sample))
+        {
+            samplesTotalSize += sample.size();
+            samples.push_back(std::move(sample));
+        }
+    }
+
+    Vector<uint8> dictionary = DictionaryTrainer::Train(samples, dictionarySize);
+    Logger::Info("dictionary of %u bytes is trained on %u files", static_cast<uint32>(dictionary.size()), static_cast<uint32>(samples.size()));
+    return dictionary;
+}
+
 bool Pack(const Vector<CollectedFile>& collectedFiles,
           const DAVA::Compressor::Type compressionType,
           const FilePath& metaDb,
           File* outputFile,
-          bool dummyFileData)
+          bool dummyFileData,
+          uint32 blockSize,
+          uint32 dictionarySize)
 {
     // validate input params
     if (collectedFiles.empty())
@@ -493,6 +569,16 @@ bool Pack(const Vector<CollectedFile>& collectedFiles,
         return false;
     }
 
+    std::unique_ptr<LZ4DictCompressor> dictionaryCompressor;
+    if (dictionarySize > 0 && !dummyFileData && (compressionType == Compressor::Type::Lz4 || compressionType == Compressor::Type::Lz4HC))
+    {
+        Vector<uint8> dictionary = TrainDictionary(collectedFiles, std::min(dictionarySize, LZ4DictCompressor::MAX_DICTIONARY_SIZE));
+        if (!dictionary.empty())
+        {
+            dictionaryCompressor.reset(new LZ4DictCompressor(dictionary));
+        }
+    }
+
     const size_t numOfFiles = collectedFiles.size();
     PackFormat::PackFile packFile;
     packFile.filesTable.data.files.resize(numOfFiles);
@@ -542,7 +628,25 @@ bool Pack(const Vector<CollectedFile>& collectedFiles,
 
                                             if (useCompressedBuffer)
                                             {
-                                                if (!compressor->Compress(origFileBuffer, compressedFileBuffer))
+                                                bool compressed = false;
+                                                if (blockSize > 0 && origFileBuffer.size() > blockSize)
+                                                {
+                                                    // big files are split into blocks to decompress them in parallel
+                                                    compressed = CompressBlocks(compressor, origFileBuffer, blockSize, compressedFileBuffer);
+                                                }
+                                                else if (dictionaryCompressor)
+                                                {
+                                                    // pack dictionary is only a history preceding content, so file compresses with it
+                                                    // not worse than without it and there is no need to try both
+                                                    compressed = dictionaryCompressor->Compress(origFileBuffer, compressedFileBuffer);
+                                                    useCompression = Compressor::Type::Lz4Dict;
+                                                }
+                                                else
+                                                {
+                                                    compressed = compressor->Compress(origFileBuffer, compressedFileBuffer);
+                                                }
+
+                                                if (!compressed)
                                                 {
                                                     Logger::Error("Can't compress contents of: %s", collectedFile.absPath.GetAbsolutePathname().c_str());
                                                     return;
@@ -626,6 +730,18 @@ bool Pack(const Vector<CollectedFile>& collectedFiles,
     useBuffers.clear();
     useBuffers.shrink_to_fit(); // free memory
 
+    uint32 packDictionarySize = 0;
+    if (dictionaryCompressor)
+    {
+        const Vector<uint8>& dictionary = dictionaryCompressor->GetDictionary();
+        if (!WriteRawData(outputFile, dictionary))
+        {
+            Logger::Error("can't write dictionary");
+            return false;
+        }
+        packDictionarySize = static_cast<uint32>(dictionary.size());
+    }
+
     Vector<uint8> metaBytes;
     if (meta)
     {
@@ -690,6 +806,8 @@ bool Pack(const Vector<CollectedFile>& collectedFiles,
         }
     }
 
+    footerBlock.info.blockSize = blockSize;
+    footerBlock.info.dictionarySize = packDictionarySize;
     footerBlock.info.filesTableSize = fileTableSize;
     footerBlock.info.filesTableCrc32 = CRC32::ForBuffer(tmpFileTable.data(), tmpFileTable.size());
     footerBlock.info.packArchiveMarker = PackFormat::FILE_MARKER;
@@ -718,7 +836,7 @@ bool Pack(const Vector<CollectedFile>& collectedFiles,
     return true;
 }
 
-bool Pack(const Vector<CollectedFile>& collectedFiles, DAVA::Compressor::Type compressionType, const FilePath& archivePath, const FilePath& metaDb, bool dummyFileData)
+bool Pack(const Vector<CollectedFile>& collectedFiles, DAVA::Compressor::Type compressionType, const FilePath& archivePath, const FilePath& metaDb, bool dummyFileData, uint32 blockSize, uint32 dictionarySize)
 {
     ScopedPtr<File> outputFile(File::Create(archivePath, File::CREATE | File::WRITE));
     if (!outputFile)
@@ -727,7 +845,7 @@ bool Pack(const Vector<CollectedFile>& collectedFiles, DAVA::Compressor::Type co
         return false;
     }
 
-    if (!Pack(collectedFiles, compressionType, metaDb, outputFile, dummyFileData))
+    if (!Pack(collectedFiles, compressionType, metaDb, outputFile, dummyFileData, blockSize, dictionarySize))
     {
         outputFile.reset();
         if (!FileSystem::Instance()->DeleteFile(archivePath))
@@ -756,7 +874,7 @@ bool CreateArchive(const Params& params)
         return false;
     }
 
-    if (Pack(collectedFiles, params.compressionType, params.archivePath, params.metaDbPath, params.dummyFileData))
+    if (Pack(collectedFiles, params.compressionType, params.archivePath, params.metaDbPath, params.dummyFileData, params.blockSize, params.dictionarySize))
     {
         return true;
     }
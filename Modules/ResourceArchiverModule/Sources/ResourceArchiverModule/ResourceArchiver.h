@@ -14,6 +14,8 @@ struct Params
     FilePath baseDirPath;
     FilePath metaDbPath;
     bool dummyFileData = false;
+    uint32 blockSize = 0; // 0 or size of blocks, files bigger than blockSize are split into independently compressed blocks
+    uint32 dictionarySize = 0; // 0 or size of dictionary trained on archive files, used with lz4/lz4hc compression
 };
 
 bool CreateArchive(const Params& params);
@@ -0,0 +1,284 @@
+#include "SkeletonTest.h"
+
+#include <Base/BaseTypes.h>
+#include <Logger/Logger.h>
+#include <Math/Quaternion.h>
+#include <Scene3D/Components/SkeletonComponent.h>
+#include <Scene3D/Entity.h>
+#include <Scene3D/Scene.h>
+#include <Utils/StringFormat.h>
+#include <Utils/FpsMeter.h>
+
+namespace SkeletonTestDetails
+{
+using namespace DAVA;
+
+const uint32 SKELETONS_COUNT = 100;
+const uint32 JOINTS_COUNT = 64;
+const float32 EXPOSURE_DURATION_SEC = 3.f;
+
+// joints form binary tree, parent always goes before its children
+Vector<SkeletonComponent::Joint> CreateJoints(uint32 jointsCount)
+{
+    Vector<SkeletonComponent::Joint> joints(jointsCount);
+    for (uint32 i = 0; i < jointsCount; ++i)
+    {
+        SkeletonComponent::Joint& joint = joints[i];
+        joint.parentIndex = (i == 0) ? SkeletonComponent::INVALID_JOINT_INDEX : (i - 1) / 2;
+        joint.name = FastName(Format("joint%u", i));
+        joint.uid = joint.name;
+        joint.bbox = AABBox3(Vector3(-0.1f, -0.1f, -0.1f), Vector3(0.1f, 0.1f, 0.1f));
+        joint.bindTransform = Matrix4::MakeTranslation(Vector3(0.f, 0.f, (i == 0) ? 0.f : 0.5f));
+        joint.bindTransformInv = Matrix4::MakeTranslation(Vector3(0.f, 0.f, -0.5f * i));
+    }
+    return joints;
+}
+}
+
+class SkeletonTestImpl final
+{
+public:
+    explicit SkeletonTestImpl(DAVA::Engine& engine, SkeletonTestListener* listener);
+    ~SkeletonTestImpl();
+
+    bool Start(const DAVA::ScopedPtr<DAVA::UI3DView>& s);
+    void Stop();
+
+    SkeletonTest::State GetState() const;
+    SkeletonTestResult& GetResult();
+
+private:
+    enum class Phase
+    {
+        MeasuringBase,
+        MeasuringSkeletons
+    };
+
+    void Update(DAVA::float32 timeElapsed);
+
+    void AddSkeletons();
+    void RemoveSkeletons();
+    void AnimateSkeletons();
+
+    void SetState(SkeletonTest::State newState);
+
+private:
+    DAVA::Engine& engine;
+
+    SkeletonTestListener* listener = nullptr;
+    DAVA::Scene* scene = nullptr;
+    DAVA::ScopedPtr<DAVA::UI3DView> sceneView;
+
+    SkeletonTest::State state = SkeletonTest::StateFinished;
+    Phase phase = Phase::MeasuringBase;
+
+    DAVA::FpsMeter fpsMeter;
+    DAVA::float32 animationTime = 0.f;
+
+    DAVA::Vector<DAVA::Entity*> skeletonEntities;
+    DAVA::Vector<DAVA::SkeletonComponent*> skeletons;
+
+    SkeletonTestResult result;
+};
+
+SkeletonTestImpl::SkeletonTestImpl(DAVA::Engine& engine, SkeletonTestListener* listener)
+    : engine(engine)
+    , listener(listener)
+    , fpsMeter(SkeletonTestDetails::EXPOSURE_DURATION_SEC)
+{
+    engine.update.Connect(this, &SkeletonTestImpl::Update);
+}
+
+SkeletonTestImpl::~SkeletonTestImpl()
+{
+    engine.update.Disconnect(this);
+    Stop();
+}
+
+SkeletonTest::State SkeletonTestImpl::GetState() const
+{
+    return state;
+}
+
+SkeletonTestResult& SkeletonTestImpl::GetResult()
+{
+    return result;
+}
+
+bool SkeletonTestImpl::Start(const DAVA::ScopedPtr<DAVA::UI3DView>& view)
+{
+    using namespace SkeletonTestDetails;
+
+    if (state != SkeletonTest::StateFinished)
+    {
+        DVASSERT(false, "can't start already started test");
+        return false;
+    }
+
+    sceneView = view;
+    if (!sceneView)
+    {
+        DVASSERT(false, "scene view is empty");
+        return false;
+    }
+
+    scene = sceneView->GetScene();
+    if (!scene)
+    {
+        DVASSERT(false, "scene view contains no scene");
+        return false;
+    }
+
+    result = SkeletonTestResult();
+    result.skeletonsCount = SKELETONS_COUNT;
+    result.jointsCount = JOINTS_COUNT;
+
+    fpsMeter = DAVA::FpsMeter(EXPOSURE_DURATION_SEC);
+    phase = Phase::MeasuringBase;
+    SetState(SkeletonTest::StateRunning);
+
+    return true;
+}
+
+void SkeletonTestImpl::Stop()
+{
+    if (state == SkeletonTest::StateRunning)
+    {
+        RemoveSkeletons();
+        state = SkeletonTest::StateFinished;
+    }
+}
+
+void SkeletonTestImpl::AddSkeletons()
+{
+    using namespace DAVA;
+    using namespace SkeletonTestDetails;
+
+    Vector<SkeletonComponent::Joint> joints = CreateJoints(JOINTS_COUNT);
+    for (uint32 i = 0; i < SKELETONS_COUNT; ++i)
+    {
+        Entity* entity = new Entity();
+        entity->SetName(FastName(Format("SkeletonTest_%u", i)));
+
+        SkeletonComponent* skeleton = new SkeletonComponent();
+        skeleton->SetJoints(joints);
+        entity->AddComponent(skeleton);
+        scene->AddNode(entity);
+
+        skeletonEntities.push_back(entity);
+        skeletons.push_back(skeleton);
+    }
+    animationTime = 0.f;
+}
+
+void SkeletonTestImpl::RemoveSkeletons()
+{
+    for (DAVA::Entity* entity : skeletonEntities)
+    {
+        scene->RemoveNode(entity);
+        DAVA::SafeRelease(entity);
+    }
+    skeletonEntities.clear();
+    skeletons.clear();
+}
+
+void SkeletonTestImpl::AnimateSkeletons()
+{
+    using namespace DAVA;
+
+    // every joint is changed each frame, so all hierarchies are evaluated by skeleton system
+    for (SkeletonComponent* skeleton : skeletons)
+    {
+        for (uint32 j = 0; j < SkeletonTestDetails::JOINTS_COUNT; ++j)
+        {
+            skeleton->SetJointOrientation(j, Quaternion::MakeRotationFastY(animationTime + j * 0.1f));
+        }
+    }
+}
+
+void SkeletonTestImpl::Update(DAVA::float32 timeElapsed)
+{
+    using namespace DAVA;
+
+    if (state != SkeletonTest::StateRunning)
+    {
+        return;
+    }
+
+    if (phase == Phase::MeasuringSkeletons)
+    {
+        animationTime += timeElapsed;
+        AnimateSkeletons();
+    }
+
+    fpsMeter.Update(timeElapsed);
+    if (!fpsMeter.IsFpsReady())
+    {
+        return;
+    }
+
+    if (phase == Phase::MeasuringBase)
+    {
+        result.baseFPS = fpsMeter.GetFps();
+
+        AddSkeletons();
+        fpsMeter = FpsMeter(SkeletonTestDetails::EXPOSURE_DURATION_SEC);
+        phase = Phase::MeasuringSkeletons;
+    }
+    else
+    {
+        result.skeletonsFPS = fpsMeter.GetFps();
+        if (result.baseFPS > 0.f && result.skeletonsFPS > 0.f)
+        {
+            float32 frameTimeDeltaMs = 1000.f / result.skeletonsFPS - 1000.f / result.baseFPS;
+            result.msPer100Skeletons = frameTimeDeltaMs * 100.f / result.skeletonsCount;
+        }
+
+        Logger::Info("Skeleton test: %u skeletons x %u joints, fps %.1f -> %.1f, %.3f ms per 100 skeletons",
+                     result.skeletonsCount, result.jointsCount, result.baseFPS, result.skeletonsFPS, result.msPer100Skeletons);
+
+        RemoveSkeletons();
+        SetState(SkeletonTest::StateFinished);
+    }
+}
+
+void SkeletonTestImpl::SetState(SkeletonTest::State newState)
+{
+    SkeletonTest::State prevState = state;
+    state = newState;
+
+    if (listener && newState != prevState)
+    {
+        listener->OnSkeletonTestStateChanged();
+    }
+}
+
+SkeletonTest::SkeletonTest(DAVA::Engine& engine, SkeletonTestListener* listener)
+    : impl(new SkeletonTestImpl(engine, listener))
+{
+}
+
+SkeletonTest::~SkeletonTest()
+{
+    DAVA::SafeDelete(impl);
+}
+
+bool SkeletonTest::Start(const DAVA::ScopedPtr<DAVA::UI3DView>& s)
+{
+    return impl->Start(s);
+}
+
+void SkeletonTest::Stop()
+{
+    impl->Stop();
+}
+
+SkeletonTest::State SkeletonTest::GetState() const
+{
+    return impl->GetState();
+}
+
+SkeletonTestResult& SkeletonTest::GetResult()
+{
+    return impl->GetResult();
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Base/BaseTypes.h>
+#include <Base/ScopedPtr.h>
+#include <Engine/Engine.h>
+#include <UI/UI3DView.h>
+
+class SkeletonTestListener
+{
+public:
+    virtual ~SkeletonTestListener()
+    {
+    }
+    virtual void OnSkeletonTestStateChanged() = 0;
+};
+
+class SkeletonTestImpl;
+
+struct SkeletonTestResult
+{
+    DAVA::uint32 skeletonsCount = 0;
+    DAVA::uint32 jointsCount = 0;
+    DAVA::float32 baseFPS = 0.f;
+    DAVA::float32 skeletonsFPS = 0.f;
+    DAVA::float32 msPer100Skeletons = 0.f;
+};
+
+/**
+    Measures cost of animated skeletons in the scene of given view.
+    At first fps of the scene itself is measured, then 100 skeletons with every joint changed each frame
+    are added to the scene and fps is measured again. Difference of frame times is reported per 100 skeletons.
+*/
+class SkeletonTest final
+{
+public:
+    enum State : DAVA::uint8
+    {
+        StateRunning,
+        StateFinished
+    };
+
+    explicit SkeletonTest(DAVA::Engine& engine, SkeletonTestListener* listener);
+    ~SkeletonTest();
+
+    bool Start(const DAVA::ScopedPtr<DAVA::UI3DView>& s);
+    void Stop();
+
+    State GetState() const;
+    SkeletonTestResult& GetResult();
+
+private:
+    SkeletonTestImpl* impl = nullptr;
+};
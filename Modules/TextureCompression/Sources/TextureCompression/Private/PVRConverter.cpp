@@ -228,7 +228,11 @@ FilePath PVRConverter::ConvertToPvr(const TextureDescriptor& descriptor, eGPUFam
     else
     {
         Vector<String> args;
-        GetToolCommandLine(descriptor, inputPathname, gpuFamily, quality, outFolder, args);
+        if (!GetToolCommandLine(descriptor, inputPathname, gpuFamily, quality, outFolder, args))
+        {
+            return FilePath();
+        }
+
         Process process(pvrTexToolPathname, args);
         if (process.Run(false))
         {
@@ -368,12 +372,19 @@ FilePath PVRConverter::ConvertNormalMapToPvr(const TextureDescriptor& descriptor
     return convertedTexturePath;
 }
 
-void PVRConverter::GetToolCommandLine(const TextureDescriptor& descriptor, const FilePath& fileToConvert, eGPUFamily gpuFamily, TextureConverter::eConvertQuality quality, const FilePath& outFolder, Vector<String>& args)
+bool PVRConverter::GetToolCommandLine(const TextureDescriptor& descriptor, const FilePath& fileToConvert, eGPUFamily gpuFamily, TextureConverter::eConvertQuality quality, const FilePath& outFolder, Vector<String>& args)
 {
     DVASSERT(descriptor.compression);
     const TextureDescriptor::Compression* compression = &descriptor.compression[gpuFamily];
 
-    String format = pixelFormatToPVRFormat[static_cast<PixelFormat>(compression->format)];
+    // map isn't modified here: textures can be converted on several threads at once
+    auto formatIt = pixelFormatToPVRFormat.find(static_cast<PixelFormat>(compression->format));
+    if (formatIt == pixelFormatToPVRFormat.end())
+    {
+        Logger::Error("PVRTexTool doesn't support format %s", GlobalEnumMap<PixelFormat>::Instance()->ToString(compression->format));
+        return false;
+    }
+    const String& format = formatIt->second;
     FilePath outputFile = GetConvertedTexturePath(descriptor, gpuFamily, outFolder);
 
     // input file
@@ -456,6 +467,8 @@ void PVRConverter::GetToolCommandLine(const TextureDescriptor& descriptor, const
     }
 
     //args.push_back("-l"); //Alpha Bleed: Discards any data in fully transparent areas to optimise the texture for better compression.
+
+    return true;
 }
 
 FilePath PVRConverter::GetConvertedTexturePath(const TextureDescriptor& descriptor, eGPUFamily gpuFamily, const FilePath& outFolder)
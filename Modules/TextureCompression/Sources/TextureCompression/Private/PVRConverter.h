@@ -30,11 +30,12 @@ protected:
     FilePath PrepareCubeMapForPvrConvert(const TextureDescriptor& descriptor);
     void CleanupCubemapAfterConversion(const TextureDescriptor& descriptor);
 
-    void GetToolCommandLine(const TextureDescriptor& descriptor, const FilePath& fileToConvert, eGPUFamily gpuFamily, TextureConverter::eConvertQuality quality, const FilePath& outFolder, Vector<String>& args);
+    bool GetToolCommandLine(const TextureDescriptor& descriptor, const FilePath& fileToConvert, eGPUFamily gpuFamily, TextureConverter::eConvertQuality quality, const FilePath& outFolder, Vector<String>& args);
 
     String GenerateInputName(const TextureDescriptor& descriptor, const FilePath& fileToConvert);
 
 protected:
+    // filled in constructor and only read after, so converter can be used from several threads
     Map<PixelFormat, String> pixelFormatToPVRFormat;
 
     FilePath pvrTexToolPathname;
@@ -1,6 +1,8 @@
 #include "TextureCompression/Private/QualcommUtils.h"
 #include "TextureCompression/Private/NvttUtils.h"
 
+#include <Concurrency/LockGuard.h>
+#include <Concurrency/Mutex.h>
 #include <Debug/DVAssert.h>
 #include <Logger/Logger.h>
 #include <Render/Image/Image.h>
@@ -24,6 +26,9 @@ namespace DAVA
 {
 namespace QualcommUtilsDetails
 {
+// Qualcomm library doesn't state that Qonvert is thread-safe, so textures exported on several threads are converted one by one
+Mutex qonvertMutex;
+
 int32 GetQualcommFromDava(PixelFormat format)
 {
     switch (format)
@@ -83,6 +88,7 @@ bool QualcommUtils::DecompressAtcToRgba(const Image* srcImage, Image* dstImage)
     dstImg.nDataSize = 0;
     dstImg.pData = nullptr;
 
+    LockGuard<Mutex> lock(QualcommUtilsDetails::qonvertMutex);
     if (Qonvert(&srcImg, &dstImg) != Q_SUCCESS)
     {
         Logger::Error("[QualcommUtils::DecompressAtcToRGBA] Failed to get dst data size");
@@ -144,6 +150,7 @@ bool QualcommUtils::CompressRgbaToAtc(const Image* srcImage, Image* dstImage)
     dstImg.nDataSize = 0;
     dstImg.pData = nullptr;
 
+    LockGuard<Mutex> lock(QualcommUtilsDetails::qonvertMutex);
     if (Qonvert(&srcImg, &dstImg) != Q_SUCCESS || dstImg.nDataSize == 0)
     {
         Logger::Error("[QualcommUtils::CompressRgbaToAtc] Convert error");
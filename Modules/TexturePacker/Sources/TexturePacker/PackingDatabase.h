@@ -0,0 +1,94 @@
+#pragma once
+
+#include <Base/BaseTypes.h>
+#include <FileSystem/FilePath.h>
+#include <Utils/MD5.h>
+
+namespace DAVA
+{
+/**
+    Persistent build database of one packed folder.
+
+    For every input file it keeps size, modification date and content hash, so on next packing only files
+    with changed size or date are hashed again. It also keeps names of outputs produced from every input file,
+    so packer can rebuild only changed inputs and remove outputs of inputs which are deleted.
+*/
+class PackingDatabase
+{
+public:
+    struct FileInfo
+    {
+        uint64 size = 0;
+        String modificationDate;
+        MD5::MD5Digest digest;
+        Vector<String> outputFiles; //!< names of files in output folder
+        Vector<String> outputTextures; //!< names of textures in output folder, texture owns all its image files and descriptor
+    };
+
+    bool Load(const FilePath& pathname);
+    bool Save(const FilePath& pathname) const;
+
+    /**
+        Update info of files in `dir` and return digest of `dir`, which is the same as `MD5::ForDirectory(dir, digest, isRecursive, false)`.
+        Names of new and changed files are put into `changedFiles`, files in subfolders are named by path relative to `dir`.
+        Infos of files which don't exist anymore are removed from database and put into `removedFiles`.
+    */
+    MD5::MD5Digest Scan(const FilePath& dir, Set<String>& changedFiles, Vector<FileInfo>& removedFiles, bool isRecursive = false);
+
+    const Map<String, FileInfo>& GetFiles() const;
+    const FileInfo* GetFileInfo(const String& name) const;
+    void SetOutputs(const String& name, const Vector<String>& outputFiles, const Vector<String>& outputTextures);
+    void ClearOutputs(const String& name);
+    /** Clear outputs of all files and mark them unknown. */
+    void ResetOutputs();
+
+    /** Outputs are known if last packing of folder recorded outputs of every packed file. */
+    bool AreOutputsKnown() const;
+    void SetOutputsKnown(bool known);
+
+    const MD5::MD5Digest& GetSettingsDigest() const;
+    void SetSettingsDigest(const MD5::MD5Digest& digest);
+
+    /** Return count of files which were hashed by last `Scan`. */
+    uint32 GetHashedFilesCount() const;
+
+private:
+    void ScanDirectory(const FilePath& dir, const String& prefix, bool isRecursive, const String& currentDate,
+                       MD5& dirMD5, Set<String>& foundFiles, Set<String>& changedFiles);
+
+    Map<String, FileInfo> files;
+    MD5::MD5Digest settingsDigest;
+    bool outputsKnown = false;
+    uint32 hashedFilesCount = 0;
+};
+
+inline const Map<String, PackingDatabase::FileInfo>& PackingDatabase::GetFiles() const
+{
+    return files;
+}
+
+inline bool PackingDatabase::AreOutputsKnown() const
+{
+    return outputsKnown;
+}
+
+inline void PackingDatabase::SetOutputsKnown(bool known)
+{
+    outputsKnown = known;
+}
+
+inline const MD5::MD5Digest& PackingDatabase::GetSettingsDigest() const
+{
+    return settingsDigest;
+}
+
+inline void PackingDatabase::SetSettingsDigest(const MD5::MD5Digest& digest)
+{
+    settingsDigest = digest;
+}
+
+inline uint32 PackingDatabase::GetHashedFilesCount() const
+{
+    return hashedFilesCount;
+}
+}
@@ -0,0 +1,243 @@
+#include "TexturePacker/PackingDatabase.h"
+
+#include <Base/ScopedPtr.h>
+#include <FileSystem/File.h>
+#include <FileSystem/FileList.h>
+#include <FileSystem/FileSystem.h>
+#include <FileSystem/KeyedArchive.h>
+#include <Logger/Logger.h>
+#include <Utils/StringFormat.h>
+
+#include <ctime>
+
+namespace DAVA
+{
+namespace PackingDatabaseDetails
+{
+const uint32 DATABASE_VERSION = 1;
+
+String GetCurrentDate()
+{
+    // same format as File::GetModificationDate
+    time_t now = time(nullptr);
+    tm* utcTime = gmtime(&now);
+    return Format("%04d.%02d.%02d %02d:%02d:%02d",
+                  utcTime->tm_year + 1900, utcTime->tm_mon + 1, utcTime->tm_mday,
+                  utcTime->tm_hour, utcTime->tm_min, utcTime->tm_sec);
+}
+
+void SaveStrings(KeyedArchive* archive, const String& key, const Vector<String>& strings)
+{
+    archive->SetUInt32(key + "Count", static_cast<uint32>(strings.size()));
+    for (uint32 i = 0; i < static_cast<uint32>(strings.size()); ++i)
+    {
+        archive->SetString(Format("%s%u", key.c_str(), i), strings[i]);
+    }
+}
+
+Vector<String> LoadStrings(const KeyedArchive* archive, const String& key)
+{
+    Vector<String> strings(archive->GetUInt32(key + "Count"));
+    for (uint32 i = 0; i < static_cast<uint32>(strings.size()); ++i)
+    {
+        strings[i] = archive->GetString(Format("%s%u", key.c_str(), i));
+    }
+    return strings;
+}
+}
+
+bool PackingDatabase::Load(const FilePath& pathname)
+{
+    using namespace PackingDatabaseDetails;
+
+    files.clear();
+    settingsDigest = MD5::MD5Digest();
+    outputsKnown = false;
+
+    if (FileSystem::Instance()->Exists(pathname) == false)
+    {
+        return false;
+    }
+
+    ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+    if (archive->Load(pathname) == false || archive->GetUInt32("version") != DATABASE_VERSION)
+    {
+        Logger::Warning("Packing database %s is not loaded", pathname.GetAbsolutePathname().c_str());
+        return false;
+    }
+
+    settingsDigest = archive->GetByteArrayAsType("settings", MD5::MD5Digest());
+    outputsKnown = archive->GetBool("outputsKnown");
+
+    uint32 filesCount = archive->GetUInt32("filesCount");
+    for (uint32 i = 0; i < filesCount; ++i)
+    {
+        const KeyedArchive* fileArchive = archive->GetArchive(Format("file%u", i));
+        if (fileArchive == nullptr)
+        {
+            Logger::Warning("Packing database %s is corrupted", pathname.GetAbsolutePathname().c_str());
+            files.clear();
+            outputsKnown = false;
+            return false;
+        }
+
+        FileInfo& info = files[fileArchive->GetString("name")];
+        info.size = fileArchive->GetUInt64("size");
+        info.modificationDate = fileArchive->GetString("date");
+        info.digest = fileArchive->GetByteArrayAsType("md5", MD5::MD5Digest());
+        info.outputFiles = LoadStrings(fileArchive, "outputFile");
+        info.outputTextures = LoadStrings(fileArchive, "outputTexture");
+    }
+
+    return true;
+}
+
+bool PackingDatabase::Save(const FilePath& pathname) const
+{
+    using namespace PackingDatabaseDetails;
+
+    ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+    archive->SetUInt32("version", DATABASE_VERSION);
+    archive->SetByteArrayAsType("settings", settingsDigest);
+    archive->SetBool("outputsKnown", outputsKnown);
+    archive->SetUInt32("filesCount", static_cast<uint32>(files.size()));
+
+    uint32 index = 0;
+    for (const auto& entry : files)
+    {
+        const FileInfo& info = entry.second;
+
+        ScopedPtr<KeyedArchive> fileArchive(new KeyedArchive());
+        fileArchive->SetString("name", entry.first);
+        fileArchive->SetUInt64("size", info.size);
+        fileArchive->SetString("date", info.modificationDate);
+        fileArchive->SetByteArrayAsType("md5", info.digest);
+        SaveStrings(fileArchive, "outputFile", info.outputFiles);
+        SaveStrings(fileArchive, "outputTexture", info.outputTextures);
+
+        archive->SetArchive(Format("file%u", index++), fileArchive);
+    }
+
+    return archive->Save(pathname);
+}
+
+MD5::MD5Digest PackingDatabase::Scan(const FilePath& dir, Set<String>& changedFiles, Vector<FileInfo>& removedFiles, bool isRecursive)
+{
+    hashedFilesCount = 0;
+
+    // file modified during current second can be modified again without changing of date,
+    // so its date isn't stored and file will be hashed on next scan
+    const String currentDate = PackingDatabaseDetails::GetCurrentDate();
+
+    MD5 dirMD5;
+    dirMD5.Init();
+
+    Set<String> foundFiles;
+    ScanDirectory(dir, String(), isRecursive, currentDate, dirMD5, foundFiles, changedFiles);
+
+    for (auto it = files.begin(); it != files.end();)
+    {
+        if (foundFiles.count(it->first) == 0)
+        {
+            removedFiles.push_back(std::move(it->second));
+            it = files.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    dirMD5.Final();
+    return dirMD5.GetDigest();
+}
+
+void PackingDatabase::ScanDirectory(const FilePath& dir, const String& prefix, bool isRecursive, const String& currentDate,
+                                    MD5& dirMD5, Set<String>& foundFiles, Set<String>& changedFiles)
+{
+    // files and folders are hashed in the same order as in MD5::ForDirectory
+    ScopedPtr<FileList> fileList(new FileList(dir, false));
+    fileList->Sort();
+    for (uint32 i = 0; i < fileList->GetCount(); ++i)
+    {
+        if (fileList->IsHidden(i))
+        {
+            continue;
+        }
+
+        if (fileList->IsDirectory(i))
+        {
+            if (isRecursive && !fileList->IsNavigationDirectory(i))
+            {
+                String dirName = fileList->GetPathname(i).GetLastDirectoryName();
+                dirMD5.Update(reinterpret_cast<const uint8*>(dirName.c_str()), static_cast<uint32>(dirName.size()));
+                ScanDirectory(fileList->GetPathname(i), prefix + dirName + "/", isRecursive, currentDate, dirMD5, foundFiles, changedFiles);
+            }
+            continue;
+        }
+
+        const String& filename = fileList->GetFilename(i);
+        const String name = prefix + filename;
+        const FilePath& pathname = fileList->GetPathname(i);
+        foundFiles.insert(name);
+
+        uint64 size = fileList->GetFileSize(i);
+        String date = File::GetModificationDate(pathname);
+
+        auto found = files.find(name);
+        bool isKnown = (found != files.end());
+        if (!isKnown || found->second.size != size || found->second.modificationDate.empty() || found->second.modificationDate != date)
+        {
+            FileInfo& info = files[name];
+
+            MD5::MD5Digest digest;
+            MD5::ForFile(pathname, digest);
+            ++hashedFilesCount;
+
+            if (!isKnown || !(info.digest == digest))
+            {
+                changedFiles.insert(name);
+            }
+
+            info.size = size;
+            info.modificationDate = (date >= currentDate) ? String() : date;
+            info.digest = digest;
+        }
+
+        const MD5::MD5Digest& digest = files[name].digest;
+        dirMD5.Update(reinterpret_cast<const uint8*>(filename.c_str()), static_cast<uint32>(filename.size()));
+        dirMD5.Update(digest.digest.data(), static_cast<uint32>(digest.digest.size()));
+    }
+}
+
+const PackingDatabase::FileInfo* PackingDatabase::GetFileInfo(const String& name) const
+{
+    auto found = files.find(name);
+    return (found != files.end()) ? &found->second : nullptr;
+}
+
+void PackingDatabase::SetOutputs(const String& name, const Vector<String>& outputFiles, const Vector<String>& outputTextures)
+{
+    auto found = files.find(name);
+    if (found != files.end())
+    {
+        found->second.outputFiles = outputFiles;
+        found->second.outputTextures = outputTextures;
+    }
+}
+
+void PackingDatabase::ClearOutputs(const String& name)
+{
+    SetOutputs(name, Vector<String>(), Vector<String>());
+}
+
+void PackingDatabase::ResetOutputs()
+{
+    for (auto& entry : files)
+    {
+        entry.second.outputFiles.clear();
+        entry.second.outputTextures.clear();
+    }
+    outputsKnown = false;
+}
+}
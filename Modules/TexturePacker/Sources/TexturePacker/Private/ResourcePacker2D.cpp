@@ -1,8 +1,14 @@
 #include "TexturePacker/ResourcePacker2D.h"
 #include "TexturePacker/DefinitionFile.h"
+#include "TexturePacker/PackingDatabase.h"
 #include "TexturePacker/TexturePacker.h"
 
 #include <CommandLine/CommandLineParser.h>
+#include <Concurrency/ConditionVariable.h>
+#include <Concurrency/LockGuard.h>
+#include <Concurrency/Mutex.h>
+#include <Concurrency/Thread.h>
+#include <Concurrency/UniqueLock.h>
 #include <Engine/Engine.h>
 #include <FileSystem/FileSystem.h>
 #include <FileSystem/FileList.h>
@@ -92,6 +98,147 @@ bool IsBasenameContainsTag(const String& basename, const String& tag)
     }
     return isTagged;
 }
+
+/**
+    Threads executing sheet export tasks in order of adding.
+    Count of queued tasks is limited, because every task holds copy of sheet image.
+*/
+class ExportWorkers
+{
+public:
+    explicit ExportWorkers(uint32 workersCount);
+    ~ExportWorkers();
+
+    void Add(const Function<void()>& task);
+    void Wait();
+
+private:
+    void WorkerFunc();
+
+    const size_t maxQueuedTasks;
+
+    Mutex mutex;
+    ConditionVariable tasksCV;
+    ConditionVariable doneCV;
+    Deque<Function<void()>> tasks;
+    uint32 runningTasks = 0;
+    bool stop = false;
+
+    Vector<RefPtr<Thread>> workers;
+};
+
+ExportWorkers::ExportWorkers(uint32 workersCount)
+    : maxQueuedTasks(workersCount * 2)
+{
+    DVASSERT(workersCount > 0);
+    for (uint32 i = 0; i < workersCount; ++i)
+    {
+        RefPtr<Thread> worker(Thread::Create([this]() { WorkerFunc(); }));
+        worker->SetName(Format("SheetExport%u", i));
+        worker->Start();
+        workers.push_back(worker);
+    }
+}
+
+ExportWorkers::~ExportWorkers()
+{
+    {
+        LockGuard<Mutex> lock(mutex);
+        stop = true;
+    }
+    tasksCV.NotifyAll();
+
+    for (RefPtr<Thread>& worker : workers)
+    {
+        worker->Join();
+    }
+}
+
+void ExportWorkers::Add(const Function<void()>& task)
+{
+    UniqueLock<Mutex> lock(mutex);
+    doneCV.Wait(lock, [this]() { return tasks.size() < maxQueuedTasks; });
+    tasks.push_back(task);
+    lock.Unlock();
+
+    tasksCV.NotifyOne();
+}
+
+void ExportWorkers::Wait()
+{
+    UniqueLock<Mutex> lock(mutex);
+    doneCV.Wait(lock, [this]() { return tasks.empty() && runningTasks == 0; });
+}
+
+void ExportWorkers::WorkerFunc()
+{
+    UniqueLock<Mutex> lock(mutex);
+    while (true)
+    {
+        tasksCV.Wait(lock, [this]() { return stop || !tasks.empty(); });
+        if (tasks.empty())
+        {
+            break;
+        }
+
+        Function<void()> task = std::move(tasks.front());
+        tasks.pop_front();
+        ++runningTasks;
+        lock.Unlock();
+
+        task();
+
+        lock.Lock();
+        --runningTasks;
+        doneCV.NotifyAll();
+    }
+}
+
+void DeleteOutputs(const FilePath& outputDir, const Vector<const PackingDatabase::FileInfo*>& infos)
+{
+    Set<String> files;
+    Set<String> textures;
+    for (const PackingDatabase::FileInfo* info : infos)
+    {
+        files.insert(info->outputFiles.begin(), info->outputFiles.end());
+        textures.insert(info->outputTextures.begin(), info->outputTextures.end());
+    }
+
+    if (textures.empty() == false)
+    {
+        // texture is written as descriptor and images with names <texture>.<ext> or <texture><GPU prefix>.<ext>
+        ScopedPtr<FileList> fileList(new FileList(outputDir));
+        for (uint32 fi = 0; fi < fileList->GetCount(); ++fi)
+        {
+            if (fileList->IsDirectory(fi))
+            {
+                continue;
+            }
+
+            const String& filename = fileList->GetFilename(fi);
+            String stem = filename.substr(0, filename.rfind('.'));
+            bool isTextureFile = (textures.count(stem) > 0);
+            for (int32 gpu = 0; gpu < GPU_DEVICE_COUNT && !isTextureFile; ++gpu)
+            {
+                const String& prefix = GPUFamilyDescriptor::GetGPUPrefix(static_cast<eGPUFamily>(gpu));
+                if (stem.size() > prefix.size() && stem.compare(stem.size() - prefix.size(), prefix.size(), prefix) == 0)
+                {
+                    isTextureFile = (textures.count(stem.substr(0, stem.size() - prefix.size())) > 0);
+                }
+            }
+
+            if (isTextureFile)
+            {
+                files.insert(filename);
+            }
+        }
+    }
+
+    for (const String& file : files)
+    {
+        FileSystem::Instance()->DeleteFile(outputDir + file);
+    }
+}
 } // namespace ResourcePacker2DDetails
 
 String ResourcePacker2D::GetProcessFolderName()
@@ -200,7 +347,7 @@ void ResourcePacker2D::PackResources(const Vector<eGPUFamily>& forGPUs)
 
     FileSystem::Instance()->CreateDirectory(outputGfxDirectory, true);
 
-    bool outputGfxDirChanged = RecalculateDirMD5(outputGfxDirectory, processDirectoryPath + gfxDirName + ".md5", true);
+    bool outputGfxDirChanged = RecalculateOutputDirMD5(processDirectoryPath);
     if (outputGfxDirChanged)
     {
         if (Engine::Instance()->IsConsoleMode())
@@ -227,10 +374,47 @@ void ResourcePacker2D::PackResources(const Vector<eGPUFamily>& forGPUs)
         }
     }
 
-    PackRecursively(inputGfxDirectory, outputGfxDirectory, packAlgorithms);
+    uint32 threadsCount = (workersCount == 0) ? static_cast<uint32>(DeviceInfo::GetCpuCount()) : workersCount;
+    if (threadsCount > 1)
+    {
+        // folders are packed one by one, because packing options are passed through global command line flags.
+        // Sheets writing and conversion for GPUs doesn't depend on flags and is executed by workers
+        ResourcePacker2DDetails::ExportWorkers workers(threadsCount);
+        exportExecutor = [&workers](const Function<void()>& task) { workers.Add(task); };
+
+        PackRecursively(inputGfxDirectory, outputGfxDirectory, packAlgorithms);
+
+        workers.Wait();
+        exportExecutor = nullptr;
+    }
+    else
+    {
+        PackRecursively(inputGfxDirectory, outputGfxDirectory, packAlgorithms);
+    }
+
+    // md5 files of folder are updated before it is packed, so folders which weren't fully packed are invalidated to be repacked next time
+    for (const std::shared_ptr<FolderExport>& folder : packedFolders)
+    {
+        if (folder->dropped)
+        {
+            InvalidateFolder(folder->processDir);
+        }
+    }
+    packedFolders.clear();
+
+    // cache items should contain converted textures, so they are added in packing order when all sheets are exported
+    for (const PackedFolder& folder : foldersToCache)
+    {
+        if (cancelled)
+        {
+            break;
+        }
+        AddFilesToCache(folder.key, folder.inputPath, folder.outputPath);
+    }
+    foldersToCache.clear();
 
     // Put latest md5 after convertation
-    RecalculateDirMD5(outputGfxDirectory, processDirectoryPath + gfxDirName + ".md5", true);
+    RecalculateOutputDirMD5(processDirectoryPath);
 }
 
 void ResourcePacker2D::RecalculateMD5ForOutputDir()
@@ -241,7 +425,7 @@ void ResourcePacker2D::RecalculateMD5ForOutputDir()
     FilePath processDirectoryPath = rootDirectory + GetProcessFolderName();
     FileSystem::Instance()->CreateDirectory(processDirectoryPath, true);
 
-    RecalculateDirMD5(outputGfxDirectory, processDirectoryPath + gfxDirName + ".md5", true);
+    RecalculateOutputDirMD5(processDirectoryPath);
 }
 
 bool ResourcePacker2D::ReadMD5FromFile(const FilePath& md5file, MD5::MD5Digest& digest) const
@@ -268,15 +452,12 @@ void ResourcePacker2D::WriteMD5ToFile(const FilePath& md5file, const MD5::MD5Dig
     DVASSERT(bytesWritten == MD5::MD5Digest::DIGEST_SIZE && "16 bytes should be always written for md5 file");
 }
 
-bool ResourcePacker2D::RecalculateParamsMD5(const String& params, const FilePath& md5file) const
+bool ResourcePacker2D::ReplaceMD5InFile(const FilePath& md5file, const MD5::MD5Digest& newMD5Digest) const
 {
     MD5::MD5Digest oldMD5Digest;
-    MD5::MD5Digest newMD5Digest;
 
     bool oldMD5Read = ReadMD5FromFile(md5file, oldMD5Digest);
 
-    MD5::ForData(reinterpret_cast<const uint8*>(params.data()), static_cast<uint32>(params.size()), newMD5Digest);
-
     WriteMD5ToFile(md5file, newMD5Digest);
 
     bool isChanged = true;
@@ -286,23 +467,34 @@ bool ResourcePacker2D::RecalculateParamsMD5(const String& params, const FilePath
     }
     return isChanged;
 }
+
+bool ResourcePacker2D::RecalculateParamsMD5(const String& params, const FilePath& md5file) const
+{
+    MD5::MD5Digest newMD5Digest;
+    MD5::ForData(reinterpret_cast<const uint8*>(params.data()), static_cast<uint32>(params.size()), newMD5Digest);
+    return ReplaceMD5InFile(md5file, newMD5Digest);
+}
 bool ResourcePacker2D::RecalculateDirMD5(const FilePath& pathname, const FilePath& md5file, bool isRecursive) const
 {
-    MD5::MD5Digest oldMD5Digest;
     MD5::MD5Digest newMD5Digest;
-
-    bool oldMD5Read = ReadMD5FromFile(md5file, oldMD5Digest);
-
     MD5::ForDirectory(pathname, newMD5Digest, isRecursive, false);
+    return ReplaceMD5InFile(md5file, newMD5Digest);
+}
 
-    WriteMD5ToFile(md5file, newMD5Digest);
-
-    bool isChanged = true;
-    if (oldMD5Read)
-    {
-        isChanged = !(oldMD5Digest == newMD5Digest);
-    }
-    return isChanged;
+bool ResourcePacker2D::RecalculateOutputDirMD5(const FilePath& processDirectoryPath) const
+{
+    // output tree is checked twice per run, so only files with changed size or modification date are hashed again.
+    // Digest is the same as for RecalculateDirMD5, so md5 files of previous runs stay valid
+    const FilePath databasePath = processDirectoryPath + gfxDirName + ".db";
+    PackingDatabase database;
+    database.Load(databasePath);
+
+    Set<String> changedFiles;
+    Vector<PackingDatabase::FileInfo> removedFiles;
+    MD5::MD5Digest newMD5Digest = database.Scan(outputGfxDirectory, changedFiles, removedFiles, true);
+    database.Save(databasePath);
+
+    return ReplaceMD5InFile(processDirectoryPath + gfxDirName + ".md5", newMD5Digest);
 }
 
 bool ResourcePacker2D::RecalculateFileMD5(const FilePath& pathname, const FilePath& md5file) const
@@ -375,7 +567,7 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
         return;
     }
 
-    uint64 packTime = SystemTimer::GetMs();
+    uint64 packStartTime = SystemTimer::GetMs();
 
     String inputRelativePath = inputDir.GetRelativePathname(rootDirectory);
     FilePath processDir = rootDirectory + GetProcessFolderName() + inputRelativePath;
@@ -423,6 +615,12 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
         packingParams += String("Tag = ") + tag;
     }
 
+    // settings of packing without list of files, files are tracked by packing database
+    String settingsParams = packingParams;
+    settingsParams += String("TexturePostfix = ") + texturePostfix;
+    settingsParams += Format("Lightmaps = %d", isLightmapsPacking ? 1 : 0);
+    settingsParams += Format("DescriptorVersion = %i", TextureDescriptor::CURRENT_VERSION);
+
     ScopedPtr<FileList> fileList(new FileList(inputDir));
     fileList->Sort();
 
@@ -512,7 +710,21 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
     packingParams += Format("FilesCount = %u", pickedFiles.size());
     packingParams += Format("DescriptorVersion = %i", TextureDescriptor::CURRENT_VERSION);
 
-    bool inputDirModified = RecalculateDirMD5(inputDir, processDir + "dir.md5", false);
+    // files with same size and modification date are not hashed again
+    const FilePath databasePath = processDir + "files.db";
+    PackingDatabase database;
+    database.Load(databasePath);
+
+    Set<String> changedFiles;
+    Vector<PackingDatabase::FileInfo> removedFiles;
+    MD5::MD5Digest dirDigest = database.Scan(inputDir, changedFiles, removedFiles);
+
+    MD5::MD5Digest settingsDigest;
+    MD5::ForData(reinterpret_cast<const uint8*>(settingsParams.data()), static_cast<uint32>(settingsParams.size()), settingsDigest);
+    bool settingsModified = !(database.GetSettingsDigest() == settingsDigest);
+    database.SetSettingsDigest(settingsDigest);
+
+    bool inputDirModified = ReplaceMD5InFile(processDir + "dir.md5", dirDigest);
     bool paramsModified = RecalculateParamsMD5(packingParams, processDir + "params.md5");
 
     bool modified = outputDirModified || inputDirModified || paramsModified;
@@ -520,6 +732,10 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
     {
         if (pickedFiles.empty() == false)
         {
+            // with separate sheets for every file only sheets of changed files are rebuilt
+            bool isSplit = CommandLineParser::Instance()->IsFlagSet("--split");
+            bool isIncremental = isSplit && !outputDirModified && !settingsModified && database.AreOutputsKnown();
+
             AssetCache::CacheItemKey cacheKey;
             if (IsUsingCache())
             {
@@ -533,8 +749,19 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
             }
 
             bool needRepack = (false == GetFilesFromCache(cacheKey, inputDir, outputDir));
-            if (needRepack)
+            if (!needRepack)
+            {
+                database.ResetOutputs();
+            }
+            else
             {
+                // sheets of the folder may be exported after it is packed, folder is logged when its last export is done
+                std::shared_ptr<FolderExport> folderExport = std::make_shared<FolderExport>();
+                folderExport->inputPath = inputDir.GetAbsolutePathname();
+                folderExport->processDir = processDir;
+                folderExport->startTime = packStartTime;
+                packedFolders.push_back(folderExport);
+
                 // read textures margins settings
                 bool useTwoSideMargin = CommandLineParser::Instance()->IsFlagSet("--add2sidepixel");
                 uint32 marginInPixels = useTwoSideMargin ? 0 : 1;
@@ -553,12 +780,54 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
                 bool useLayerNames = CommandLineParser::Instance()->IsFlagSet("--useLayerNames");
                 bool verbose = CommandLineParser::Instance()->GetVerbose();
 
-                if (clearOutputDirectory)
+                Set<String> filesToPack;
+                for (const PickedFile& file : pickedFiles)
+                {
+                    const PackingDatabase::FileInfo* info = database.GetFileInfo(file.name);
+                    bool hasOutputs = (info != nullptr) && (!info->outputFiles.empty() || !info->outputTextures.empty());
+                    if (!isIncremental || !hasOutputs || changedFiles.count(file.name) > 0)
+                    {
+                        filesToPack.insert(file.name);
+                    }
+                }
+
+                if (isIncremental)
+                {
+                    // remove outputs of files which are repacked, deleted or not picked anymore
+                    Vector<const PackingDatabase::FileInfo*> staleOutputs;
+                    for (const PackingDatabase::FileInfo& info : removedFiles)
+                    {
+                        staleOutputs.push_back(&info);
+                    }
+
+                    Vector<String> filesWithStaleOutputs;
+                    for (const auto& entry : database.GetFiles())
+                    {
+                        bool isPicked = std::any_of(pickedFiles.begin(), pickedFiles.end(), [&entry](const PickedFile& file) { return file.name == entry.first; });
+                        if (!isPicked || filesToPack.count(entry.first) > 0)
+                        {
+                            staleOutputs.push_back(&entry.second);
+                            filesWithStaleOutputs.push_back(entry.first);
+                        }
+                    }
+
+                    DeleteOutputs(outputDir, staleOutputs);
+                    for (const String& name : filesWithStaleOutputs)
+                    {
+                        database.ClearOutputs(name);
+                    }
+                }
+                else
                 {
-                    FileSystem::Instance()->DeleteDirectoryFiles(outputDir, false);
+                    database.ResetOutputs();
+                    if (clearOutputDirectory)
+                    {
+                        FileSystem::Instance()->DeleteDirectoryFiles(outputDir, false);
+                    }
                 }
 
                 DefinitionFile::Collection definitionFileList;
+                Vector<PickedFile*> definitionSources;
                 Vector<PickedFile*> justCopyList;
                 definitionFileList.reserve(pickedFiles.size());
                 for (PickedFile& file : pickedFiles)
@@ -568,6 +837,11 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
                         break;
                     }
 
+                    if (filesToPack.count(file.name) == 0)
+                    {
+                        continue;
+                    }
+
                     DAVA::RefPtr<DefinitionFile> defFile(new DefinitionFile());
 
                     bool shouldAcceptFile = false;
@@ -594,6 +868,7 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
                     if (shouldAcceptFile)
                     {
                         definitionFileList.push_back(defFile);
+                        definitionSources.push_back(&file);
                     }
                 }
 
@@ -620,10 +895,35 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
                     packer.SetTexturesMargin(marginInPixels);
                     packer.SetAlgorithms(packAlgorithms);
                     packer.SetTexturePostfix(texturePostfix);
+                    if (exportExecutor)
+                    {
+                        packer.SetExportExecutor([this, folderExport](const Function<void()>& task) {
+                            folderExport->pendingCount++;
+                            exportExecutor([this, folderExport, task]() {
+                                if (cancelled)
+                                {
+                                    folderExport->dropped = true;
+                                }
+                                else
+                                {
+                                    task();
+                                }
+                                FinishFolderExport(*folderExport);
+                            });
+                        });
+                    }
 
-                    if (CommandLineParser::Instance()->IsFlagSet("--split"))
+                    if (isSplit)
                     {
-                        packer.PackToTexturesSeparate(outputDir, definitionFileList, requestedGPUs);
+                        // pack files one by one to know which textures are produced from every file
+                        for (size_t i = 0; i < definitionFileList.size(); ++i)
+                        {
+                            size_t texturesCount = packer.GetTextureNames().size();
+                            packer.PackToTexturesSeparate(outputDir, { definitionFileList[i] }, requestedGPUs);
+
+                            Vector<String> textures(packer.GetTextureNames().begin() + texturesCount, packer.GetTextureNames().end());
+                            database.SetOutputs(definitionSources[i]->name, { definitionFileList[i]->filename.GetFilename() }, textures);
+                        }
                     }
                     else
                     {
@@ -645,26 +945,32 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
                     {
                         Logger::Error("Can't copy %s to %s", srcPath.GetStringValue().c_str(), destPath.GetStringValue().c_str());
                     }
+                    database.SetOutputs(file->name, { file->outName }, Vector<String>());
                 }
 
-                packTime = SystemTimer::GetMs() - packTime;
+                // outputs of files packed into common sheets can't be separated
+                database.SetOutputsKnown(isSplit && !cancelled);
 
                 if (Engine::Instance()->IsConsoleMode())
                 {
                     Logger::Info("[%u files packed with flags: %s]", static_cast<uint32>(definitionFileList.size()), mergedFlags.c_str());
                 }
 
-                const char* result = definitionFileList.empty() ? "[unchanged]" : "[REPACKED]";
-                Logger::Info("[%s - %.2lf secs] - %s", inputDir.GetAbsolutePathname().c_str(),
-                             static_cast<float64>(packTime) / 1000.0, result);
+                folderExport->result = definitionFileList.empty() ? "[unchanged]" : "[REPACKED]";
+                if (cancelled)
+                {
+                    folderExport->dropped = true;
+                }
+                FinishFolderExport(*folderExport);
 
-                AddFilesToCache(cacheKey, inputDir, outputDir);
+                AddFilesToCacheAfterExport(cacheKey, inputDir, outputDir);
             }
         }
         else if (outputDirModified || inputDirModified)
         {
             Logger::Info("[%s] - empty directory. Clearing output folder", inputDir.GetAbsolutePathname().c_str());
             FileSystem::Instance()->DeleteDirectoryFiles(outputDir, false);
+            database.ResetOutputs();
         }
     }
     else
@@ -672,6 +978,8 @@ void ResourcePacker2D::PackRecursively(const FilePath& inputDir, const FilePath&
         Logger::Info("[%s] - unchanged", inputDir.GetAbsolutePathname().c_str());
     }
 
+    database.Save(databasePath);
+
     const auto& flagsToPass = CommandLineParser::Instance()->IsFlagSet("--recursive") ? currentFlags : passedFlags;
 
     for (uint32 fi = 0; fi < fileList->GetCount(); ++fi)
@@ -713,6 +1021,11 @@ void ResourcePacker2D::SetTexturePostfix(const String& postfix)
     texturePostfix = postfix;
 }
 
+void ResourcePacker2D::SetWorkersCount(uint32 count)
+{
+    workersCount = count;
+}
+
 void ResourcePacker2D::SetTag(const String& tag_)
 {
     tag = tag_;
@@ -821,6 +1134,40 @@ bool ResourcePacker2D::AddFilesToCache(const AssetCache::CacheItemKey& key, cons
 #endif
 }
 
+void ResourcePacker2D::FinishFolderExport(FolderExport& folder) const
+{
+    if (folder.pendingCount.fetch_sub(1) == 1)
+    {
+        // time includes writing and conversion of sheets
+        uint64 packTime = SystemTimer::GetMs() - folder.startTime;
+        const char* result = folder.dropped ? "[cancelled]" : folder.result;
+        Logger::Info("[%s - %.2lf secs] - %s", folder.inputPath.c_str(), static_cast<float64>(packTime) / 1000.0, result);
+    }
+}
+
+void ResourcePacker2D::InvalidateFolder(const FilePath& processDir) const
+{
+    FileSystem::Instance()->DeleteFile(processDir + "dir.md5");
+    FileSystem::Instance()->DeleteFile(processDir + "params.md5");
+    FileSystem::Instance()->DeleteFile(processDir + "files.db");
+}
+
+void ResourcePacker2D::AddFilesToCacheAfterExport(const AssetCache::CacheItemKey& key, const FilePath& inputPath, const FilePath& outputPath)
+{
+    if (!exportExecutor)
+    {
+        AddFilesToCache(key, inputPath, outputPath);
+    }
+    else if (IsUsingCache())
+    {
+        PackedFolder folder;
+        folder.key = key;
+        folder.inputPath = inputPath;
+        folder.outputPath = outputPath;
+        foldersToCache.push_back(folder);
+    }
+}
+
 const Set<String>& ResourcePacker2D::GetErrors() const
 {
     return errors;
@@ -153,6 +153,7 @@ void TexturePacker::SaveResultSheets(const FilePath& outputPath, const char* bas
         String textureName = MakeTextureName(basename, imageNum);
         FilePath texturePathWithoutExtension = outputPath + textureName;
         ExportImage(finalImages[imageNum], imageExportKeys, texturePathWithoutExtension);
+        textureNames.push_back(textureName);
     }
 
     for (const RectanglePacker::SpriteIndexedData& spriteIndexedData : packResult.resultIndexedSprites)
@@ -454,7 +455,7 @@ Vector<TexturePacker::ImageExportKeys> TexturePacker::GetExportKeys(const Vector
 
 void TexturePacker::ExportImage(const ImageExt& image, const Vector<ImageExportKeys>& keys, const FilePath& pathnameWithoutExtension)
 {
-    std::unique_ptr<TextureDescriptor> descriptor(new TextureDescriptor());
+    std::shared_ptr<TextureDescriptor> descriptor(new TextureDescriptor());
 
     { // prepare general info for sprite drawing
         descriptor->drawSettings.wrapModeS = descriptor->drawSettings.wrapModeT = GetDescriptorWrapMode();
@@ -467,6 +468,24 @@ void TexturePacker::ExportImage(const ImageExt& image, const Vector<ImageExportK
         descriptor->pathname = pathnameWithoutExtension + TextureDescriptor::GetDescriptorExtension();
     }
 
+    if (exportExecutor)
+    {
+        // writing and conversion don't depend on command line flags, so they can be executed on other thread
+        std::shared_ptr<ImageExt> exportedImage(new ImageExt(image));
+        TextureConverter::eConvertQuality convertQuality = quality;
+        exportExecutor([descriptor, exportedImage, keys, pathnameWithoutExtension, convertQuality]()
+                       {
+                           WriteImage(*descriptor, *exportedImage, keys, pathnameWithoutExtension, convertQuality);
+                       });
+    }
+    else
+    {
+        WriteImage(*descriptor, image, keys, pathnameWithoutExtension, quality);
+    }
+}
+
+void TexturePacker::WriteImage(TextureDescriptor& descriptor, const ImageExt& image, const Vector<ImageExportKeys>& keys, const FilePath& pathnameWithoutExtension, TextureConverter::eConvertQuality quality)
+{
     for (const ImageExportKeys& key : keys)
     {
         if (key.imageFormat == ImageFormat::IMAGE_FORMAT_UNKNOWN || key.pixelFormat == PixelFormat::FORMAT_INVALID)
@@ -475,51 +494,51 @@ void TexturePacker::ExportImage(const ImageExt& image, const Vector<ImageExportK
             continue;
         }
 
-        descriptor->compression[key.forGPU].format = key.pixelFormat;
-        descriptor->compression[key.forGPU].imageFormat = key.imageFormat;
+        descriptor.compression[key.forGPU].format = key.pixelFormat;
+        descriptor.compression[key.forGPU].imageFormat = key.imageFormat;
 
         ImageExt imageForGPU(image);
         if (key.imageFormat == ImageFormat::IMAGE_FORMAT_DDS || key.imageFormat == ImageFormat::IMAGE_FORMAT_PVR)
         {
-            descriptor->dataSettings.sourceFileFormat = IMAGE_FORMAT_PNG;
+            descriptor.dataSettings.sourceFileFormat = IMAGE_FORMAT_PNG;
         }
         else
         {
-            descriptor->dataSettings.sourceFileFormat = key.imageFormat;
+            descriptor.dataSettings.sourceFileFormat = key.imageFormat;
             if (key.toConvertOrigin)
             {
                 imageForGPU.ConvertToFormat(key.pixelFormat);
             }
         }
 
-        String srcExtension = ImageSystem::GetExtensionsFor(descriptor->dataSettings.sourceFileFormat)[0];
-        descriptor->dataSettings.sourceFileExtension = srcExtension;
+        String srcExtension = ImageSystem::GetExtensionsFor(descriptor.dataSettings.sourceFileFormat)[0];
+        descriptor.dataSettings.sourceFileExtension = srcExtension;
 
         imageForGPU.DitherAlpha();
-        imageForGPU.Write(descriptor->GetSourceTexturePathname(), key.imageQuality); // save source image
+        imageForGPU.Write(descriptor.GetSourceTexturePathname(), key.imageQuality); // save source image
 
         if (key.toComressForGPU)
         {
-            TextureConverter::ConvertTexture(*descriptor, key.forGPU, false, quality);
+            TextureConverter::ConvertTexture(descriptor, key.forGPU, false, quality);
         }
         else if (key.forGPU != eGPUFamily::GPU_ORIGIN)
         {
-            FilePath gpuPath = descriptor->CreateMultiMipPathnameForGPU(key.forGPU);
-            FileSystem::Instance()->MoveFile(descriptor->GetSourceTexturePathname(), gpuPath); //create image for gpu (webp/tga ...)
+            FilePath gpuPath = descriptor.CreateMultiMipPathnameForGPU(key.forGPU);
+            FileSystem::Instance()->MoveFile(descriptor.GetSourceTexturePathname(), gpuPath); //create image for gpu (webp/tga ...)
         }
     }
 
     if (keys.size() == 1)
     {
-        descriptor->Export(descriptor->pathname, keys[0].forGPU);
+        descriptor.Export(descriptor.pathname, keys[0].forGPU);
         if (keys[0].toComressForGPU)
         {
-            FileSystem::Instance()->DeleteFile(descriptor->GetSourceTexturePathname());
+            FileSystem::Instance()->DeleteFile(descriptor.GetSourceTexturePathname());
         }
     }
     else
     {
-        descriptor->Save(descriptor->pathname);
+        descriptor.Save(descriptor.pathname);
     }
 }
 
@@ -640,6 +659,16 @@ void TexturePacker::SetConvertQuality(TextureConverter::eConvertQuality _quality
     quality = _quality;
 }
 
+void TexturePacker::SetExportExecutor(const ExportExecutor& executor)
+{
+    exportExecutor = executor;
+}
+
+const Vector<String>& TexturePacker::GetTextureNames() const
+{
+    return textureNames;
+}
+
 void TexturePacker::AddError(const String& errorMsg)
 {
     Logger::Error(errorMsg.c_str());
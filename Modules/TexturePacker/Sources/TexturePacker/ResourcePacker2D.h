@@ -6,6 +6,7 @@
 #include "AssetCache/AssetCacheClient.h"
 
 #include <Base/BaseTypes.h>
+#include <Functional/Function.h>
 #include <Render/RenderBase.h>
 #include <FileSystem/FilePath.h>
 
@@ -39,17 +40,24 @@ public:
     void SetTag(const String& tag);
     void SetAllTags(const Vector<String>& tags);
     void SetIgnoresFile(const String& ignoresPath);
+    /**
+        Set count of threads which write and convert packed sheets.
+        0 (default) means count of CPU cores, 1 means that everything is done on calling thread.
+    */
+    void SetWorkersCount(uint32 count);
 
     void PackResources(const Vector<eGPUFamily>& forGPUs);
 
     const Set<String>& GetErrors() const;
 
 private:
+    bool RecalculateOutputDirMD5(const FilePath& processDirectoryPath) const;
     bool RecalculateParamsMD5(const String& params, const FilePath& md5file) const;
     bool RecalculateFileMD5(const FilePath& pathname, const FilePath& md5file) const;
 
     bool ReadMD5FromFile(const FilePath& md5file, MD5::MD5Digest& digest) const;
     void WriteMD5ToFile(const FilePath& md5file, const MD5::MD5Digest& digest) const;
+    bool ReplaceMD5InFile(const FilePath& md5file, const MD5::MD5Digest& digest) const;
 
     uint32 GetMaxTextureSize() const;
     Vector<String> FetchFlags(const FilePath& flagsPathname);
@@ -61,6 +69,19 @@ private:
 
     bool GetFilesFromCache(const AssetCache::CacheItemKey& key, const FilePath& inputPath, const FilePath& outputPath);
     bool AddFilesToCache(const AssetCache::CacheItemKey& key, const FilePath& inputPath, const FilePath& outputPath);
+    void AddFilesToCacheAfterExport(const AssetCache::CacheItemKey& key, const FilePath& inputPath, const FilePath& outputPath);
+
+    struct FolderExport
+    {
+        String inputPath;
+        FilePath processDir;
+        uint64 startTime = 0;
+        const char* result = "";
+        std::atomic<uint32> pendingCount = { 1 }; // queued sheet exports plus packing of folder itself
+        std::atomic<bool> dropped = { false }; // packing or some exports were skipped because packing was cancelled
+    };
+    void FinishFolderExport(FolderExport& folder) const;
+    void InvalidateFolder(const FilePath& processDir) const;
 
 public:
     FilePath inputGfxDirectory;
@@ -89,6 +110,18 @@ private:
 
     Set<String> errors;
 
+    uint32 workersCount = 0;
+    Function<void(const Function<void()>&)> exportExecutor;
+
+    struct PackedFolder
+    {
+        AssetCache::CacheItemKey key;
+        FilePath inputPath;
+        FilePath outputPath;
+    };
+    Vector<PackedFolder> foldersToCache; // folders which are put into cache after all sheets are exported
+    Vector<std::shared_ptr<FolderExport>> packedFolders; // folders repacked during current PackResources call
+
     std::atomic<bool> cancelled = { false };
 };
 
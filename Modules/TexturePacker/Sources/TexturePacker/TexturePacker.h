@@ -39,6 +39,9 @@ public:
     };
 
 public:
+    /** Function which executes export task, it can run task on other thread. */
+    using ExportExecutor = Function<void(const Function<void()>&)>;
+
     TexturePacker();
 
     // pack textures to single texture
@@ -50,6 +53,12 @@ public:
 
     void SetConvertQuality(TextureConverter::eConvertQuality quality);
     void SetTexturePostfix(const String& postfix);
+    /**
+        Set executor of sheet writing and conversion tasks. Tasks don't use command line flags and write
+        different files, so they can be executed in parallel. Caller should wait for all passed tasks
+        before using packed results. Empty executor (default) runs tasks immediately.
+    */
+    void SetExportExecutor(const ExportExecutor& executor);
 
     // Proxy setters
     void SetUseOnlySquareTextures(bool value = true);
@@ -58,6 +67,8 @@ public:
     void SetTwoSideMargin(bool val = true);
     void SetTexturesMargin(uint32 margin);
     const Set<String>& GetErrors() const;
+    /** Return names of all textures written by packer, without extensions, in order of writing. */
+    const Vector<String>& GetTextureNames() const;
 
 private:
     struct ImageExportKeys
@@ -72,6 +83,7 @@ private:
 
     Vector<ImageExportKeys> GetExportKeys(const Vector<eGPUFamily>& forGPUs);
     void ExportImage(const ImageExt& image, const Vector<ImageExportKeys>& exportKeys, const FilePath& exportedPathname);
+    static void WriteImage(TextureDescriptor& descriptor, const ImageExt& image, const Vector<ImageExportKeys>& exportKeys, const FilePath& exportedPathname, TextureConverter::eConvertQuality quality);
 
     rhi::TextureAddrMode GetDescriptorWrapMode();
     FilterItem GetDescriptorFilter(bool generateMipMaps = false);
@@ -92,8 +104,10 @@ private:
     bool NeedSquareTextureForCompression(const Vector<ImageExportKeys>& keys);
 
     TextureConverter::eConvertQuality quality;
+    ExportExecutor exportExecutor;
 
     String texturePostfix;
+    Vector<String> textureNames;
 
     Set<String> errors;
     void AddError(const String& errorMsg);
@@ -4,6 +4,7 @@
 
 #include <AssetCache/CachedItemValue.h>
 
+#include <FileSystem/DynamicMemoryFile.h>
 #include <FileSystem/File.h>
 #include <FileSystem/FileSystem.h>
 #include <FileSystem/KeyedArchive.h>
@@ -13,10 +14,17 @@
 #include <Logger/Logger.h>
 
 const DAVA::String CacheDB::DB_FILE_NAME = "cache.dat";
+const DAVA::String CacheDB::JOURNAL_FILE_NAME = "cache.journal";
 const DAVA::uint32 CacheDB::VERSION = 1;
 
+namespace CacheDBDetails
+{
+const DAVA::uint64 MIN_JOURNAL_RECORDS_TO_COMPACT = 100000;
+}
+
 CacheDB::CacheDB(CacheDBOwner& _owner)
     : owner(_owner)
+    , pendingJournal(DAVA::DynamicMemoryFile::Create(DAVA::File::CREATE | DAVA::File::WRITE))
     , dbStateChanged(false)
 {
 }
@@ -48,6 +56,7 @@ void CacheDB::UpdateSettings(const DAVA::FilePath& folderPath, const DAVA::uint6
 
         cacheRootFolder = newCacheRootFolder;
         cacheSettings = cacheRootFolder + DB_FILE_NAME;
+        cacheJournal = cacheRootFolder + JOURNAL_FILE_NAME;
 
         Load();
         fullCacheChanged = true;
@@ -109,6 +118,7 @@ void CacheDB::Load()
     }
 
     DAVA::uint64 cacheSize = header->GetUInt64("itemsCount");
+    journalID = header->GetUInt64("journalID");
     fullCache.reserve(static_cast<size_t>(cacheSize));
 
     DAVA::ScopedPtr<DAVA::KeyedArchive> cache(new DAVA::KeyedArchive());
@@ -134,10 +144,138 @@ void CacheDB::Load()
         fullCache[key] = std::move(entry);
     }
 
+    if (LoadJournal() == false)
+    {
+        // snapshot should be rewritten, as journal on disk cannot be continued
+        compactionRequired = true;
+    }
+
+    nextItemID = 0;
+    for (const auto& item : fullCache)
+    {
+        DAVA::uint64 timestamp = item.second.GetTimestamp();
+        lruIndex.emplace(timestamp, item.first);
+        nextItemID = std::max(nextItemID, timestamp + 1);
+    }
+
     NotifySizeChanged();
     dbStateChanged = false;
 }
 
+bool CacheDB::LoadJournal()
+{
+    DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(cacheJournal, DAVA::File::OPEN | DAVA::File::READ));
+    if (!file)
+    {
+        return true;
+    }
+
+    DAVA::uint64 id = 0;
+    if (file->Read(&id) != sizeof(id) || id != journalID)
+    {
+        DAVA::Logger::Warning("[CacheDB::%s] Journal %s doesn't match cache snapshot and is ignored", __FUNCTION__, cacheJournal.GetStringValue().c_str());
+        return false;
+    }
+
+    journalRecordsCount = 0;
+    while (file->GetPos() < file->GetSize())
+    {
+        if (ReplayJournalRecord(file) == false)
+        {
+            DAVA::Logger::Warning("[CacheDB::%s] Journal %s is damaged, %llu records are loaded", __FUNCTION__, cacheJournal.GetStringValue().c_str(), journalRecordsCount);
+            return false;
+        }
+        ++journalRecordsCount;
+    }
+
+    return true;
+}
+
+bool CacheDB::ReplayJournalRecord(DAVA::File* file)
+{
+    eJournalRecord type;
+    DAVA::AssetCache::CacheItemKey key;
+    if (file->Read(&type) != sizeof(type) || file->Read(key.data(), static_cast<DAVA::uint32>(key.size())) != key.size())
+    {
+        return false;
+    }
+
+    auto found = fullCache.find(key);
+    switch (type)
+    {
+    case JOURNAL_INSERT:
+    {
+        DAVA::ScopedPtr<DAVA::KeyedArchive> itemArchieve(new DAVA::KeyedArchive());
+        if (!itemArchieve->Load(file))
+        {
+            return false;
+        }
+
+        ServerCacheEntry entry;
+        entry.Deserialize(itemArchieve);
+
+        if (found != fullCache.end())
+        {
+            occupiedSize -= found->second.GetValue().GetSize();
+        }
+        occupiedSize += entry.GetValue().GetSize();
+        fullCache[key] = std::move(entry);
+        return true;
+    }
+    case JOURNAL_ACCESS:
+    {
+        DAVA::uint64 timestamp = 0;
+        if (file->Read(&timestamp) != sizeof(timestamp))
+        {
+            return false;
+        }
+
+        if (found != fullCache.end())
+        {
+            found->second.UpdateAccessTimestamp(timestamp);
+        }
+        return true;
+    }
+    case JOURNAL_REMOVE:
+    {
+        if (found != fullCache.end())
+        {
+            occupiedSize -= found->second.GetValue().GetSize();
+            fullCache.erase(found);
+        }
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+void CacheDB::WriteJournalRecord(eJournalRecord type, const DAVA::AssetCache::CacheItemKey& key, const ServerCacheEntry* entry)
+{
+    pendingJournal->Write(&type, sizeof(type));
+    pendingJournal->Write(key.data(), static_cast<DAVA::uint32>(key.size()));
+
+    if (type == JOURNAL_INSERT)
+    {
+        DAVA::ScopedPtr<DAVA::KeyedArchive> itemArchieve(new DAVA::KeyedArchive());
+        entry->Serialize(itemArchieve);
+        itemArchieve->Save(pendingJournal);
+    }
+    else if (type == JOURNAL_ACCESS)
+    {
+        DAVA::uint64 timestamp = entry->GetTimestamp();
+        pendingJournal->Write(&timestamp, sizeof(timestamp));
+    }
+
+    ++journalRecordsCount;
+    dbStateChanged = true;
+}
+
+void CacheDB::ResetPendingJournal()
+{
+    pendingJournal = DAVA::DynamicMemoryFile::Create(DAVA::File::CREATE | DAVA::File::WRITE);
+}
+
 void CacheDB::Unload()
 {
     Save();
@@ -149,64 +287,139 @@ void CacheDB::Unload()
 
     fastCache.clear();
     fullCache.clear();
+    lruIndex.clear();
     occupiedSize = 0;
+    nextItemID = 0;
+
+    ResetPendingJournal();
+    journalID = 0;
+    journalRecordsCount = 0;
+    compactionRequired = false;
+
     NotifySizeChanged();
 }
 
 void CacheDB::Save()
 {
-    DAVA::FileSystem::Instance()->CreateDirectory(cacheRootFolder, true);
+    using namespace DAVA;
 
-    DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(cacheSettings, DAVA::File::CREATE | DAVA::File::WRITE));
-    if (!file)
+    FileSystem* fs = FileSystem::Instance();
+    uint64 recordsToCompact = std::max(CacheDBDetails::MIN_JOURNAL_RECORDS_TO_COMPACT, static_cast<uint64>(fullCache.size()));
+    if (compactionRequired || journalRecordsCount >= recordsToCompact || fs->IsFile(cacheSettings) == false)
     {
-        DAVA::Logger::Error("[CacheDB::%s] Cannot create file %s", __FUNCTION__, cacheSettings.GetStringValue().c_str());
+        Compact();
         return;
     }
 
-    DAVA::ScopedPtr<DAVA::KeyedArchive> header(new DAVA::KeyedArchive());
-    header->SetString("signature", "cache");
-    header->SetUInt32("version", VERSION);
-    header->SetUInt64("itemsCount", fullCache.size());
-    header->Save(file);
+    uint32 pendingSize = static_cast<uint32>(pendingJournal->GetDataVector().size());
+    if (pendingSize > 0)
+    {
+        bool journalExists = fs->IsFile(cacheJournal);
+        ScopedPtr<File> file(File::Create(cacheJournal, File::APPEND | File::WRITE));
+        if (!file)
+        {
+            Logger::Error("[CacheDB::%s] Cannot open file %s", __FUNCTION__, cacheJournal.GetStringValue().c_str());
+            return;
+        }
+
+        bool written = (journalExists || file->Write(&journalID) == sizeof(journalID));
+        written = written && (file->Write(pendingJournal->GetData(), pendingSize) == pendingSize);
+        if (!written)
+        {
+            Logger::Error("[CacheDB::%s] Cannot write to file %s", __FUNCTION__, cacheJournal.GetStringValue().c_str());
+            compactionRequired = true;
+            return;
+        }
+
+        ResetPendingJournal();
+    }
+
+    dbStateChanged = false;
+    lastSaveTime = SystemTimer::GetMs();
+}
+
+void CacheDB::Compact()
+{
+    using namespace DAVA;
+
+    FileSystem* fs = FileSystem::Instance();
+    fs->CreateDirectory(cacheRootFolder, true);
+
+    uint64 newJournalID = journalID + 1;
+    FilePath tempCacheSettings = cacheRootFolder + (DB_FILE_NAME + ".tmp");
 
-    DAVA::ScopedPtr<DAVA::KeyedArchive> cache(new DAVA::KeyedArchive());
-    DAVA::uint64 index = 0;
-    for (auto& item : fullCache)
     {
-        DAVA::ScopedPtr<DAVA::KeyedArchive> itemArchieve(new DAVA::KeyedArchive());
-        item.first.Serialize(itemArchieve);
-        item.second.Serialize(itemArchieve);
+        ScopedPtr<File> file(File::Create(tempCacheSettings, File::CREATE | File::WRITE));
+        if (!file)
+        {
+            Logger::Error("[CacheDB::%s] Cannot create file %s", __FUNCTION__, tempCacheSettings.GetStringValue().c_str());
+            return;
+        }
 
-        cache->SetArchive(DAVA::Format("item_%d", index++), itemArchieve);
+        ScopedPtr<KeyedArchive> header(new KeyedArchive());
+        header->SetString("signature", "cache");
+        header->SetUInt32("version", VERSION);
+        header->SetUInt64("itemsCount", fullCache.size());
+        header->SetUInt64("journalID", newJournalID);
+        header->Save(file);
+
+        ScopedPtr<KeyedArchive> cache(new KeyedArchive());
+        uint64 index = 0;
+        for (auto& item : fullCache)
+        {
+            ScopedPtr<KeyedArchive> itemArchieve(new KeyedArchive());
+            item.first.Serialize(itemArchieve);
+            item.second.Serialize(itemArchieve);
+
+            cache->SetArchive(Format("item_%d", index++), itemArchieve);
+        }
+        cache->Save(file);
     }
-    cache->Save(file);
+
+    if (fs->MoveFile(tempCacheSettings, cacheSettings, true) == false)
+    {
+        Logger::Error("[CacheDB::%s] Cannot replace file %s", __FUNCTION__, cacheSettings.GetStringValue().c_str());
+        return;
+    }
+
+    // journal of previous snapshot is not valid anymore
+    ScopedPtr<File> journal(File::Create(cacheJournal, File::CREATE | File::WRITE));
+    if (journal)
+    {
+        journal->Write(&newJournalID);
+    }
+
+    journalID = newJournalID;
+    journalRecordsCount = 0;
+    compactionRequired = false;
+    ResetPendingJournal();
 
     dbStateChanged = false;
-    lastSaveTime = DAVA::SystemTimer::GetMs();
+    lastSaveTime = SystemTimer::GetMs();
 }
 
 void CacheDB::ReduceFullCacheToSize(DAVA::uint64 toSize)
 {
     while (occupiedSize > toSize)
     {
-        const auto& found = std::min_element(fullCache.begin(), fullCache.end(), [](const CacheMap::value_type& left, const CacheMap::value_type& right) -> bool
-                                             {
-                                                 return left.second.GetTimestamp() < right.second.GetTimestamp();
-                                             });
+        if (lruIndex.empty())
+        {
+            DAVA::Logger::Warning("Occupied size is %u, should be 0", occupiedSize);
+            occupiedSize = 0;
+            NotifySizeChanged();
+            break;
+        }
+
+        auto oldest = lruIndex.begin();
+        auto found = fullCache.find(oldest->second);
         if (found != fullCache.end())
         {
             Remove(found);
         }
         else
         {
-            if (occupiedSize > 0)
-            {
-                DAVA::Logger::Warning("Occupied size is %u, should be 0", occupiedSize);
-                occupiedSize = 0;
-                NotifySizeChanged();
-                break;
-            }
+            DVASSERT(false, "LRU index is out of sync with cache");
+            lruIndex.erase(oldest);
         }
     }
 }
@@ -258,7 +471,7 @@ ServerCacheEntry* CacheDB::Get(const DAVA::AssetCache::CacheItemKey& key)
         }
     }
 
-    UpdateAccessTimestamp(entry);
+    UpdateAccessTimestamp(key, entry);
 
     return entry;
 }
@@ -329,10 +542,13 @@ void CacheDB::Insert(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry
     ServerCacheEntry* insertedEntry = &fullCache[key];
     DAVA::FilePath savedPath = CreateFolderPath(key);
     insertedEntry->GetValue().ExportToFolder(savedPath);
-    insertedEntry->UpdateAccessTimestamp();
+    insertedEntry->UpdateAccessTimestamp(nextItemID++);
+    lruIndex.emplace(insertedEntry->GetTimestamp(), key);
     occupiedSize += insertedEntry->GetValue().GetSize();
     NotifySizeChanged();
 
+    WriteJournalRecord(JOURNAL_INSERT, key, insertedEntry);
+
     InsertInFastCache(key, insertedEntry);
 
     if (occupiedSize > maxStorageSize)
@@ -369,15 +585,31 @@ void CacheDB::UpdateAccessTimestamp(const DAVA::AssetCache::CacheItemKey& key)
         entry = FindInFullCache(key);
     }
 
-    UpdateAccessTimestamp(entry);
+    UpdateAccessTimestamp(key, entry);
 }
 
-void CacheDB::UpdateAccessTimestamp(ServerCacheEntry* entry)
+void CacheDB::UpdateAccessTimestamp(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry* entry)
 {
     if (nullptr != entry)
     {
-        entry->UpdateAccessTimestamp();
-        dbStateChanged = true;
+        RemoveFromLRUIndex(key, entry->GetTimestamp());
+        entry->UpdateAccessTimestamp(nextItemID++);
+        lruIndex.emplace(entry->GetTimestamp(), key);
+
+        WriteJournalRecord(JOURNAL_ACCESS, key, entry);
+    }
+}
+
+void CacheDB::RemoveFromLRUIndex(const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 timestamp)
+{
+    auto range = lruIndex.equal_range(timestamp);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second == key)
+        {
+            lruIndex.erase(it);
+            return;
+        }
     }
 }
 
@@ -401,8 +633,9 @@ void CacheDB::Remove(const CacheMap::iterator& it)
         RemoveFromFastCache(found);
     }
 
+    RemoveFromLRUIndex(it->first, it->second.GetTimestamp());
+    WriteJournalRecord(JOURNAL_REMOVE, it->first);
     RemoveFromFullCache(it);
-    dbStateChanged = true;
 }
 
 void CacheDB::RemoveFromFullCache(const CacheMap::iterator& it)
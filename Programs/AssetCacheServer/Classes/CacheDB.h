@@ -3,6 +3,8 @@
 #include <AssetCache/CacheItemKey.h>
 
 #include <Base/BaseTypes.h>
+#include <Base/ScopedPtr.h>
+#include <FileSystem/DynamicMemoryFile.h>
 #include <FileSystem/FilePath.h>
 
 #include <atomic>
@@ -22,13 +24,30 @@ struct CacheDBOwner
     virtual void OnStorageSizeChanged(DAVA::uint64 occupied, DAVA::uint64 overall) = 0;
 };
 
+/*
+    Index of cached items is stored in two files: snapshot with all items (DB_FILE_NAME)
+    and append-only journal (JOURNAL_FILE_NAME) with changes made after the snapshot was written.
+    `Save` appends accumulated changes to the journal, `Compact` rewrites the snapshot and starts new journal.
+    Compaction is done by `Save` automatically when journal becomes as long as the snapshot.
+
+    Items are evicted in order of last access, which is kept in `lruIndex` sorted by access timestamp.
+*/
 class CacheDB final
 {
     static const DAVA::String DB_FILE_NAME;
+    static const DAVA::String JOURNAL_FILE_NAME;
     static const DAVA::uint32 VERSION;
 
     using CacheMap = DAVA::UnorderedMap<DAVA::AssetCache::CacheItemKey, ServerCacheEntry>;
     using FastCacheMap = DAVA::UnorderedMap<DAVA::AssetCache::CacheItemKey, ServerCacheEntry*>;
+    using LRUIndex = DAVA::MultiMap<DAVA::uint64, DAVA::AssetCache::CacheItemKey>;
+
+    enum eJournalRecord : DAVA::uint8
+    {
+        JOURNAL_INSERT = 0,
+        JOURNAL_ACCESS,
+        JOURNAL_REMOVE
+    };
 
 public:
     CacheDB(CacheDBOwner& owner);
@@ -37,6 +56,7 @@ public:
     void UpdateSettings(const DAVA::FilePath& folderPath, const DAVA::uint64 size, const DAVA::uint32 itemsInMemory, const DAVA::uint64 autoSaveTimeout);
 
     void Save();
+    void Compact();
     void Load();
 
     ServerCacheEntry* Get(const DAVA::AssetCache::CacheItemKey& key);
@@ -50,6 +70,7 @@ public:
     const DAVA::uint64 GetStorageSize() const;
     const DAVA::uint64 GetAvailableSize() const;
     const DAVA::uint64 GetOccupiedSize() const;
+    DAVA::uint64 GetItemsCount() const;
 
     void Update();
 
@@ -66,7 +87,8 @@ private:
 
     void InsertInFastCache(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry* entry);
 
-    void UpdateAccessTimestamp(ServerCacheEntry* entry);
+    void UpdateAccessTimestamp(const DAVA::AssetCache::CacheItemKey& key, ServerCacheEntry* entry);
+    void RemoveFromLRUIndex(const DAVA::AssetCache::CacheItemKey& key, DAVA::uint64 timestamp);
 
     void ReduceFullCacheToSize(DAVA::uint64 toSize);
     void ReduceFastCacheByCount(DAVA::uint32 countToRemove);
@@ -78,11 +100,17 @@ private:
 
     void NotifySizeChanged();
 
+    bool LoadJournal();
+    bool ReplayJournalRecord(DAVA::File* file);
+    void WriteJournalRecord(eJournalRecord type, const DAVA::AssetCache::CacheItemKey& key, const ServerCacheEntry* entry = nullptr);
+    void ResetPendingJournal();
+
 private:
     CacheDBOwner& owner;
 
     DAVA::FilePath cacheRootFolder; //path to folder with settings and cache of files
     DAVA::FilePath cacheSettings; //path to settings
+    DAVA::FilePath cacheJournal; //path to journal of changes in settings
 
     DAVA::uint64 maxStorageSize = 0; //maximum cache size
     DAVA::uint32 maxItemsInMemory = 0; //count of items in memory, to use for fast access
@@ -95,6 +123,12 @@ private:
 
     FastCacheMap fastCache; //runtime, week storage
     CacheMap fullCache; //stored on disk, strong storage
+    LRUIndex lruIndex; //keys of fullCache ordered by access timestamp
+
+    DAVA::ScopedPtr<DAVA::DynamicMemoryFile> pendingJournal; //journal records not written to disk yet
+    DAVA::uint64 journalID = 0; //id of snapshot, journal is applied only to snapshot with same id
+    DAVA::uint64 journalRecordsCount = 0; //count of journal records written to disk and pending
+    bool compactionRequired = false;
 
     std::atomic<bool> dbStateChanged; //flag about changes in db
 };
@@ -113,3 +147,8 @@ inline const DAVA::uint64 CacheDB::GetOccupiedSize() const
 {
     return occupiedSize;
 }
+
+inline DAVA::uint64 CacheDB::GetItemsCount() const
+{
+    return fullCache.size();
+}
@@ -0,0 +1,125 @@
+#include "CacheDBBenchmark.h"
+#include "CacheDB.h"
+#include "ServerCacheEntry.h"
+
+#include <AssetCache/CachedItemValue.h>
+
+#include <FileSystem/File.h>
+#include <FileSystem/FileSystem.h>
+#include <FileSystem/KeyedArchive.h>
+#include <Logger/Logger.h>
+#include <Time/SystemTimer.h>
+#include <Utils/StringFormat.h>
+
+namespace CacheDBBenchmarkDetails
+{
+const DAVA::uint32 ITEM_DATA_SIZE = 1024;
+const DAVA::uint32 ACCESSED_ITEMS_PERCENT = 10;
+
+struct BenchmarkOwner : public CacheDBOwner
+{
+    void OnStorageSizeChanged(DAVA::uint64, DAVA::uint64) override
+    {
+    }
+};
+
+DAVA::AssetCache::CacheItemKey CreateKey(DAVA::uint32 index)
+{
+    DAVA::AssetCache::CacheItemKey key;
+    key.fill(0xAB);
+    Memcpy(key.data(), &index, sizeof(index));
+    return key;
+}
+
+bool CreateSnapshot(const DAVA::FilePath& path, DAVA::uint32 itemsCount)
+{
+    using namespace DAVA;
+
+    // all items share same data, only the size of data is stored in index
+    AssetCache::CachedItemValue value;
+    value.Add("data", std::make_shared<Vector<uint8>>(ITEM_DATA_SIZE));
+
+    ScopedPtr<File> file(File::Create(path, File::CREATE | File::WRITE));
+    if (!file)
+    {
+        return false;
+    }
+
+    ScopedPtr<KeyedArchive> header(new KeyedArchive());
+    header->SetString("signature", "cache");
+    header->SetUInt32("version", 1);
+    header->SetUInt64("itemsCount", itemsCount);
+    header->Save(file);
+
+    ScopedPtr<KeyedArchive> cache(new KeyedArchive());
+    for (uint32 index = 0; index < itemsCount; ++index)
+    {
+        ServerCacheEntry entry(value);
+        entry.UpdateAccessTimestamp(index);
+
+        ScopedPtr<KeyedArchive> itemArchieve(new KeyedArchive());
+        CreateKey(index).Serialize(itemArchieve);
+        entry.Serialize(itemArchieve);
+        cache->SetArchive(Format("item_%d", index), itemArchieve);
+    }
+    cache->Save(file);
+
+    return true;
+}
+}
+
+int RunCacheDBBenchmark(const DAVA::FilePath& folder, DAVA::uint32 itemsCount)
+{
+    using namespace DAVA;
+    using namespace CacheDBBenchmarkDetails;
+
+    FilePath benchmarkFolder = folder;
+    benchmarkFolder.MakeDirectoryPathname();
+    FileSystem::Instance()->DeleteDirectory(benchmarkFolder);
+    FileSystem::Instance()->CreateDirectory(benchmarkFolder, true);
+
+    Logger::Info("[CacheDBBenchmark] Creating index with %u items", itemsCount);
+    if (CreateSnapshot(benchmarkFolder + "cache.dat", itemsCount) == false)
+    {
+        Logger::Error("[CacheDBBenchmark] Cannot create index in %s", benchmarkFolder.GetAbsolutePathname().c_str());
+        return -1;
+    }
+
+    const uint64 storageSize = static_cast<uint64>(itemsCount) * ITEM_DATA_SIZE;
+
+    BenchmarkOwner owner;
+    CacheDB db(owner);
+
+    int64 startTime = SystemTimer::GetMs();
+    db.UpdateSettings(benchmarkFolder, storageSize, 0, 0);
+    int64 loadTime = SystemTimer::GetMs() - startTime;
+
+    uint32 accessedCount = itemsCount / 100 * ACCESSED_ITEMS_PERCENT;
+    startTime = SystemTimer::GetMs();
+    for (uint32 i = 0; i < accessedCount; ++i)
+    {
+        db.UpdateAccessTimestamp(CreateKey(i * 7 % itemsCount));
+    }
+    int64 accessTime = SystemTimer::GetMs() - startTime;
+
+    startTime = SystemTimer::GetMs();
+    db.Save();
+    int64 saveTime = SystemTimer::GetMs() - startTime;
+
+    startTime = SystemTimer::GetMs();
+    db.UpdateSettings(benchmarkFolder, storageSize / 2, 0, 0);
+    int64 evictTime = SystemTimer::GetMs() - startTime;
+
+    startTime = SystemTimer::GetMs();
+    db.Compact();
+    int64 compactTime = SystemTimer::GetMs() - startTime;
+
+    Logger::Info("[CacheDBBenchmark] items: %u, left after eviction: %llu", itemsCount, db.GetItemsCount());
+    Logger::Info("[CacheDBBenchmark] load: %lld ms", loadTime);
+    Logger::Info("[CacheDBBenchmark] access of %u items: %lld ms", accessedCount, accessTime);
+    Logger::Info("[CacheDBBenchmark] incremental save: %lld ms", saveTime);
+    Logger::Info("[CacheDBBenchmark] eviction of half of storage with save: %lld ms", evictTime);
+    Logger::Info("[CacheDBBenchmark] compaction: %lld ms", compactTime);
+
+    return 0;
+}
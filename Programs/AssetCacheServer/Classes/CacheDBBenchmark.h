@@ -0,0 +1,12 @@
+#pragma once
+
+#include <Base/BaseTypes.h>
+#include <FileSystem/FilePath.h>
+
+/*
+    Measures time of index operations of CacheDB with `itemsCount` synthetic items:
+    loading, access timestamps updates with incremental save, eviction and compaction.
+    Index is created in `folder`, files of items are not created.
+    Is started with `--cachedb-benchmark [itemsCount]` command line option.
+*/
+int RunCacheDBBenchmark(const DAVA::FilePath& folder, DAVA::uint32 itemsCount);
@@ -1,4 +1,5 @@
 #include "UI/AssetCacheServerWindow.h"
+#include "CacheDBBenchmark.h"
 #include "ServerCore.h"
 #include "Logger/RotationLogger.h"
 
@@ -134,6 +135,23 @@ int DAVAMain(DAVA::Vector<DAVA::String> cmdLine)
     Engine e;
     e.Init(eEngineRunMode::CONSOLE_MODE, modules, options);
 
+    auto benchmarkArg = std::find(cmdLine.begin(), cmdLine.end(), "--cachedb-benchmark");
+    if (benchmarkArg != cmdLine.end())
+    {
+        uint32 itemsCount = 1000000;
+        if (std::next(benchmarkArg) != cmdLine.end())
+        {
+            itemsCount = static_cast<uint32>(std::max(std::atoi(std::next(benchmarkArg)->c_str()), 1));
+        }
+
+        e.update.Connect([&e, itemsCount](float32)
+                         {
+                             int result = RunCacheDBBenchmark("~doc:/CacheDBBenchmark/", itemsCount);
+                             e.QuitAsync(result);
+                         });
+        return e.Run();
+    }
+
     e.update.Connect([&e](float32)
                      {
                          int result = Process(e);
@@ -10,6 +10,11 @@
 #include "Tests/UniversalTest.h"
 #include "Tests/MaterialsTest.h"
 #include "Tests/LoadingTest.h"
+#include "Tests/JobSchedulerTest.h"
+#include "Tests/CompressionTest.h"
+#include "Tests/DispatcherQueueTest.h"
+#include "Tests/SkeletonSystemTest.h"
+#include "Tests/SceneFormatTest.h"
 
 #include <Version/Version.h>
 
@@ -133,6 +138,48 @@ void GameCore::RegisterTests()
 
         testChain.push_back(new LoadingTest(params));
     }
+
+    // scene format test uses same maps as loading test
+    for (const auto& scene : scenes)
+    {
+        BaseTest::TestParams params = defaultTestParams;
+        params.sceneName = scene.first;
+        params.scenePath = scene.second;
+
+        testChain.push_back(new SceneFormatTest(params));
+    }
+
+    // job scheduler test doesn't need any map
+    {
+        BaseTest::TestParams params = defaultTestParams;
+        params.sceneName = "Jobs";
+
+        testChain.push_back(new JobSchedulerTest(params));
+    }
+
+    // dispatcher queue test doesn't need any map
+    {
+        BaseTest::TestParams params = defaultTestParams;
+        params.sceneName = "Dispatcher";
+
+        testChain.push_back(new DispatcherQueueTest(params));
+    }
+
+    // skeleton system test creates its own scenes
+    {
+        BaseTest::TestParams params = defaultTestParams;
+        params.sceneName = "Skeletons";
+
+        testChain.push_back(new SkeletonSystemTest(params));
+    }
+
+    // compression test uses resources of the test itself
+    {
+        BaseTest::TestParams params = defaultTestParams;
+        params.sceneName = "Compression";
+
+        testChain.push_back(new CompressionTest(params));
+    }
 }
 
 void GameCore::LoadMaps(const String& testName, Vector<std::pair<String, String>>& mapsVector)
@@ -0,0 +1,147 @@
+#include "CompressionTest.h"
+
+#include <Compression/DictionaryTrainer.h>
+#include <Compression/LZ4Compressor.h>
+
+namespace CompressionTestDetails
+{
+static const uint32 MAX_SAMPLE_SIZE = 128 * 1024;
+static const uint64 MAX_SAMPLES_SIZE = 64 * 1024 * 1024;
+static const uint32 DECOMPRESS_REPEATS = 20;
+}
+
+const String CompressionTest::TEST_NAME = "CompressionTest";
+
+CompressionTest::CompressionTest(const TestParams& testParams)
+    : BaseTest(TEST_NAME, testParams)
+{
+}
+
+void CompressionTest::LoadResources()
+{
+    ScopedPtr<Font> font12(FTFont::Create("~res:/Fonts/korinna.ttf"));
+    font12->SetSize(12.f);
+
+    testText = new UIStaticText();
+    testText->SetFont(font12);
+    testText->SetTextColor(Color(0.f, 1.f, 0.f, 1.f));
+    testText->SetTextAlign(ALIGN_LEFT | ALIGN_VCENTER);
+    testText->SetRect(Rect(10.f, 10.f, 300.f, 10.f));
+    testText->SetText(UTF8Utils::EncodeToWideString(TEST_NAME));
+    AddControl(testText);
+
+    samples.clear();
+    samplesSize = 0;
+    CollectSamples("~res:/");
+
+    configurations.clear();
+    configurations.push_back({ "LZ4HC", 0, 0, 0.0 });
+    configurations.push_back({ "LZ4Dict_16Kb", 16 * 1024, 0, 0.0 });
+    configurations.push_back({ "LZ4Dict_64Kb", 64 * 1024, 0, 0.0 });
+    currentConfiguration = 0;
+}
+
+void CompressionTest::UnloadResources()
+{
+    samples.clear();
+    SafeRelease(testText);
+}
+
+void CompressionTest::CollectSamples(const FilePath& directory)
+{
+    using namespace CompressionTestDetails;
+
+    ScopedPtr<FileList> fileList(new FileList(directory));
+    for (uint32 i = 0; i < fileList->GetCount() && samplesSize < MAX_SAMPLES_SIZE; ++i)
+    {
+        if (fileList->IsNavigationDirectory(i))
+        {
+            continue;
+        }
+
+        const FilePath& path = fileList->GetPathname(i);
+        if (fileList->IsDirectory(i))
+        {
+            CollectSamples(path);
+        }
+        else
+        {
+            Vector<uint8> content;
+            if (FileSystem::Instance()->ReadFileContents(path, content) && !content.empty() && content.size() <= MAX_SAMPLE_SIZE)
+            {
+                samplesSize += content.size();
+                samples.push_back(std::move(content));
+            }
+        }
+    }
+}
+
+void CompressionTest::RunConfiguration(Configuration& config)
+{
+    using namespace CompressionTestDetails;
+
+    std::unique_ptr<Compressor> compressor;
+    if (config.dictionarySize > 0)
+    {
+        compressor.reset(new LZ4DictCompressor(DictionaryTrainer::Train(samples, config.dictionarySize)));
+    }
+    else
+    {
+        compressor.reset(new LZ4HCCompressor());
+    }
+
+    Vector<Vector<uint8>> compressedSamples(samples.size());
+    config.compressedSize = 0;
+    for (size_t i = 0; i < samples.size(); ++i)
+    {
+        compressor->Compress(samples[i], compressedSamples[i]);
+        config.compressedSize += compressedSamples[i].size();
+    }
+
+    Vector<uint8> output(MAX_SAMPLE_SIZE);
+    int64 startTime = SystemTimer::GetUs();
+    for (uint32 repeat = 0; repeat < DECOMPRESS_REPEATS; ++repeat)
+    {
+        for (size_t i = 0; i < samples.size(); ++i)
+        {
+            const Vector<uint8>& compressed = compressedSamples[i];
+            compressor->Decompress(compressed.data(), static_cast<uint32>(compressed.size()), output.data(), static_cast<uint32>(samples[i].size()));
+        }
+    }
+    int64 timeUs = std::max(SystemTimer::GetUs() - startTime, int64(1));
+
+    config.decompressMBs = (static_cast<float64>(samplesSize) * DECOMPRESS_REPEATS / (1024.0 * 1024.0)) / (timeUs / 1000000.0);
+}
+
+void CompressionTest::Update(float32 timeElapsed)
+{
+    BaseScreen::Update(timeElapsed);
+
+    if (currentConfiguration < configurations.size())
+    {
+        RunConfiguration(configurations[currentConfiguration]);
+        ++currentConfiguration;
+    }
+}
+
+void CompressionTest::OnStart()
+{
+    Logger::Info(TeamcityPerformanceTestsOutput::FormatTestStarted(GetSceneName()).c_str());
+}
+
+void CompressionTest::OnFinish()
+{
+    for (const Configuration& config : configurations)
+    {
+        float64 ratio = (config.compressedSize > 0) ? static_cast<float64>(samplesSize) / config.compressedSize : 0.0;
+        Logger::Info(TeamcityPerformanceTestsOutput::FormatBuildStatistic(Format("%s_Ratio", config.name.c_str()), Format("%.3f", ratio)).c_str());
+        Logger::Info(TeamcityPerformanceTestsOutput::FormatBuildStatistic(Format("%s_DecompressMBs", config.name.c_str()), Format("%.1f", config.decompressMBs)).c_str());
+    }
+
+    Logger::Info(TeamcityPerformanceTestsOutput::FormatTestFinished(GetSceneName()).c_str());
+}
+
+bool CompressionTest::IsFinished() const
+{
+    return (currentConfiguration >= configurations.size());
+}
@@ -0,0 +1,53 @@
+#ifndef __COMPRESSION_TEST_H__
+#define __COMPRESSION_TEST_H__
+
+#include "BaseTest.h"
+
+// Compares compression ratio and decompression speed of LZ4HC and LZ4 with trained dictionary
+// on small resource files (yaml, materials, scenes) of the test data.
+// Every frame runs one configuration and remembers its results.
+class CompressionTest : public BaseTest
+{
+public:
+    static const String TEST_NAME;
+
+    CompressionTest(const TestParams& testParams);
+
+    void OnStart() override;
+    void OnFinish() override;
+
+    void Update(float32 timeElapsed) override;
+
+    bool IsFinished() const override;
+
+protected:
+    void LoadResources() override;
+    void UnloadResources() override;
+
+    void CreateUI() override{};
+    void UpdateUI() override{};
+
+    void PerformTestLogic(float32 timeElapsed) override{};
+
+private:
+    struct Configuration
+    {
+        String name;
+        uint32 dictionarySize;
+        uint64 compressedSize;
+        float64 decompressMBs;
+    };
+
+    void CollectSamples(const FilePath& directory);
+    void RunConfiguration(Configuration& config);
+
+    Vector<Vector<uint8>> samples;
+    uint64 samplesSize = 0;
+
+    Vector<Configuration> configurations;
+    uint32 currentConfiguration = 0;
+
+    UIStaticText* testText = nullptr;
+};
+
+#endif
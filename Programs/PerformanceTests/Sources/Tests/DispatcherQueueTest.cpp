@@ -0,0 +1,196 @@
+#include "DispatcherQueueTest.h"
+
+#include <Concurrency/Dispatcher.h>
+#include <Concurrency/LockGuard.h>
+#include <Concurrency/Mutex.h>
+#include <Concurrency/Thread.h>
+
+#include <atomic>
+
+namespace DispatcherQueueTestDetails
+{
+static const uint32 PRODUCERS_COUNTS[] = { 1, 2, 4, 8 };
+static const uint32 EVENTS_PER_PRODUCER = 200000;
+
+struct Event
+{
+    int64 postTimeNs;
+};
+
+// Event queue as it was implemented by Dispatcher before lock-free queue
+class MutexEventQueue
+{
+public:
+    MutexEventQueue(const Function<void(const Event&)>& handler)
+        : eventHandler(handler)
+    {
+    }
+
+    void PostEvent(const Event& e)
+    {
+        LockGuard<Mutex> lock(mutex);
+        eventQueue.push_back(e);
+    }
+
+    void ProcessEvents()
+    {
+        {
+            LockGuard<Mutex> lock(mutex);
+            eventQueue.swap(readyEvents);
+        }
+        for (const Event& e : readyEvents)
+        {
+            eventHandler(e);
+        }
+        readyEvents.clear();
+    }
+
+private:
+    Mutex mutex;
+    Vector<Event> eventQueue;
+    Vector<Event> readyEvents;
+    Function<void(const Event&)> eventHandler;
+};
+
+float64 GetPercentileUs(const Vector<int64>& sortedLatenciesNs, float64 percentile)
+{
+    size_t index = static_cast<size_t>(percentile * (sortedLatenciesNs.size() - 1));
+    return sortedLatenciesNs[index] / 1000.0;
+}
+}
+
+const String DispatcherQueueTest::TEST_NAME = "DispatcherQueueTest";
+
+DispatcherQueueTest::DispatcherQueueTest(const TestParams& testParams)
+    : BaseTest(TEST_NAME, testParams)
+{
+}
+
+void DispatcherQueueTest::LoadResources()
+{
+    ScopedPtr<Font> font12(FTFont::Create("~res:/Fonts/korinna.ttf"));
+    font12->SetSize(12.f);
+
+    testText = new UIStaticText();
+    testText->SetFont(font12);
+    testText->SetTextColor(Color(0.f, 1.f, 0.f, 1.f));
+    testText->SetTextAlign(ALIGN_LEFT | ALIGN_VCENTER);
+    testText->SetRect(Rect(10.f, 10.f, 300.f, 10.f));
+    testText->SetText(UTF8Utils::EncodeToWideString(TEST_NAME));
+    AddControl(testText);
+
+    configurations.clear();
+    for (uint32 producersCount : DispatcherQueueTestDetails::PRODUCERS_COUNTS)
+    {
+        configurations.push_back({ true, producersCount, 0.0, 0.0, 0.0, 0.0 });
+        configurations.push_back({ false, producersCount, 0.0, 0.0, 0.0, 0.0 });
+    }
+    currentConfiguration = 0;
+}
+
+void DispatcherQueueTest::UnloadResources()
+{
+    SafeRelease(testText);
+}
+
+void DispatcherQueueTest::Update(float32 timeElapsed)
+{
+    BaseScreen::Update(timeElapsed);
+
+    if (currentConfiguration < configurations.size())
+    {
+        RunConfiguration(configurations[currentConfiguration]);
+        ++currentConfiguration;
+    }
+}
+
+void DispatcherQueueTest::RunConfiguration(Configuration& config)
+{
+    using namespace DispatcherQueueTestDetails;
+
+    const uint32 totalEvents = EVENTS_PER_PRODUCER * config.producersCount;
+
+    Vector<int64> latencies;
+    latencies.reserve(totalEvents);
+    auto handler = [&latencies](const Event& e) {
+        latencies.push_back(SystemTimer::GetNs() - e.postTimeNs);
+    };
+
+    MutexEventQueue mutexQueue(handler);
+    Dispatcher<Event> dispatcher(handler);
+    dispatcher.LinkToCurrentThread();
+
+    Function<void(const Event&)> post;
+    Function<void()> process;
+    if (config.mutexQueue)
+    {
+        post = [&mutexQueue](const Event& e) { mutexQueue.PostEvent(e); };
+        process = [&mutexQueue]() { mutexQueue.ProcessEvents(); };
+    }
+    else
+    {
+        post = [&dispatcher](const Event& e) { dispatcher.PostEvent(e); };
+        process = [&dispatcher]() { dispatcher.ProcessEvents(); };
+    }
+
+    std::atomic<bool> startFlag(false);
+    Vector<Thread*> producers;
+    for (uint32 i = 0; i < config.producersCount; ++i)
+    {
+        Thread* thread = Thread::Create([&startFlag, &post]() {
+            while (!startFlag)
+            {
+            }
+            for (uint32 k = 0; k < EVENTS_PER_PRODUCER; ++k)
+            {
+                post(Event{ SystemTimer::GetNs() });
+            }
+        });
+        thread->Start();
+        producers.push_back(thread);
+    }
+
+    int64 startTime = SystemTimer::GetNs();
+    startFlag = true;
+    while (latencies.size() < totalEvents)
+    {
+        process();
+    }
+    int64 elapsedNs = SystemTimer::GetNs() - startTime;
+
+    for (Thread* thread : producers)
+    {
+        thread->Join();
+        SafeRelease(thread);
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    config.eventsPerSecond = totalEvents / (elapsedNs / 1000000000.0);
+    config.latencyP99Us = GetPercentileUs(latencies, 0.99);
+    config.latencyP999Us = GetPercentileUs(latencies, 0.999);
+    config.latencyMaxUs = latencies.back() / 1000.0;
+}
+
+void DispatcherQueueTest::OnStart()
+{
+    Logger::Info(TeamcityPerformanceTestsOutput::FormatTestStarted(GetSceneName()).c_str());
+}
+
+void DispatcherQueueTest::OnFinish()
+{
+    for (const Configuration& config : configurations)
+    {
+        const char* name = config.mutexQueue ? "MutexQueue" : "Dispatcher";
+        Logger::Info(TeamcityPerformanceTestsOutput::FormatBuildStatistic(Format("%s_EventsPerSec_%u", name, config.producersCount), Format("%.0f", config.eventsPerSecond)).c_str());
+        Logger::Info(TeamcityPerformanceTestsOutput::FormatBuildStatistic(Format("%s_LatencyP99_%u", name, config.producersCount), Format("%.3f", config.latencyP99Us)).c_str());
+        Logger::Info(TeamcityPerformanceTestsOutput::FormatBuildStatistic(Format("%s_LatencyP999_%u", name, config.producersCount), Format("%.3f", config.latencyP999Us)).c_str());
+        Logger::Info(TeamcityPerformanceTestsOutput::FormatBuildStatistic(Format("%s_LatencyMax_%u", name, config.producersCount), Format("%.3f", config.latencyMaxUs)).c_str());
+    }
+
+    Logger::Info(TeamcityPerformanceTestsOutput::FormatTestFinished(GetSceneName()).c_str());
+}
+
+bool DispatcherQueueTest::IsFinished() const
+{
+    return (currentConfiguration >= configurations.size());
+}
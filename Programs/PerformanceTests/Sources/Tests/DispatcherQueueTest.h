@@ -0,0 +1,52 @@
+#ifndef __DISPATCHER_QUEUE_TEST_H__
+#define __DISPATCHER_QUEUE_TEST_H__
+
+#include "BaseTest.h"
+
+// Compares mutex-guarded event queue (former Dispatcher implementation) against lock-free Dispatcher queue.
+// Several producer threads post events while test thread processes them, test measures throughput
+// and latency between posting and processing of event.
+// Every frame runs one configuration (queue x producers count) and remembers its results.
+class DispatcherQueueTest : public BaseTest
+{
+public:
+    static const String TEST_NAME;
+
+    DispatcherQueueTest(const TestParams& testParams);
+
+    void OnStart() override;
+    void OnFinish() override;
+
+    void Update(float32 timeElapsed) override;
+
+    bool IsFinished() const override;
+
+protected:
+    void LoadResources() override;
+    void UnloadResources() override;
+
+    void CreateUI() override{};
+    void UpdateUI() override{};
+
+    void PerformTestLogic(float32 timeElapsed) override{};
+
+private:
+    struct Configuration
+    {
+        bool mutexQueue;
+        uint32 producersCount;
+        float64 eventsPerSecond;
+        float64 latencyP99Us;
+        float64 latencyP999Us;
+        float64 latencyMaxUs;
+    };
+
+    void RunConfiguration(Configuration& config);
+
+    Vector<Configuration> configurations;
+    uint32 currentConfiguration = 0;
+
+    UIStaticText* testText = nullptr;
+};
+
+#endif
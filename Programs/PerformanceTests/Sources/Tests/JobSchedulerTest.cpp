@@ -0,0 +1,195 @@
+#include "JobSchedulerTest.h"
+
+#include <Job/JobQueue.h>
+#include <Job/JobScheduler.h>
+#include <Job/JobThread.h>
+
+namespace JobSchedulerTestDetails
+{
+static const uint32 WORKERS_COUNTS[] = { 1, 4, 8, 16 };
+
+// legacy queue has fixed capacity of 1024 jobs, so both implementations are fed with batches
+static const uint32 JOBS_BATCH_SIZE = 1000;
+static const uint32 JOBS_BATCHES_COUNT = 50;
+static const uint32 JOB_WORK_ITERATIONS = 2000;
+
+static const uint32 PARALLEL_FOR_RANGE = 1 << 20;
+static const uint32 PARALLEL_FOR_GRAIN = 2048;
+static const uint32 PARALLEL_FOR_REPEATS = 20;
+
+void DoJobWork(uint32 seed, uint32* out)
+{
+    uint32 value = seed;
+    for (uint32 i = 0; i < JOB_WORK_ITERATIONS; ++i)
+    {
+        value = value * 1664525u + 1013904223u;
+    }
+    *out = value;
+}
+
+void DoRangeWork(uint32 begin, uint32 end, Vector<float32>& data)
+{
+    for (uint32 i = begin; i < end; ++i)
+    {
+        data[i] = std::sqrt(data[i] * data[i] + 1.0f);
+    }
+}
+}
+
+const String JobSchedulerTest::TEST_NAME = "JobSchedulerTest";
+
+JobSchedulerTest::JobSchedulerTest(const TestParams& testParams)
+    : BaseTest(TEST_NAME, testParams)
+{
+}
+
+void JobSchedulerTest::LoadResources()
+{
+    ScopedPtr<Font> font12(FTFont::Create("~res:/Fonts/korinna.ttf"));
+    font12->SetSize(12.f);
+
+    testText = new UIStaticText();
+    testText->SetFont(font12);
+    testText->SetTextColor(Color(0.f, 1.f, 0.f, 1.f));
+    testText->SetTextAlign(ALIGN_LEFT | ALIGN_VCENTER);
+    testText->SetRect(Rect(10.f, 10.f, 300.f, 10.f));
+    testText->SetText(UTF8Utils::EncodeToWideString(TEST_NAME));
+    AddControl(testText);
+
+    configurations.clear();
+    for (uint32 workersCount : JobSchedulerTestDetails::WORKERS_COUNTS)
+    {
+        configurations.push_back({ true, workersCount, 0, 0 });
+        configurations.push_back({ false, workersCount, 0, 0 });
+    }
+    currentConfiguration = 0;
+}
+
+void JobSchedulerTest::UnloadResources()
+{
+    SafeRelease(testText);
+}
+
+void JobSchedulerTest::Update(float32 timeElapsed)
+{
+    BaseScreen::Update(timeElapsed);
+
+    if (currentConfiguration < configurations.size())
+    {
+        Configuration& config = configurations[currentConfiguration];
+        if (config.legacyQueue)
+        {
+            RunLegacyQueue(config);
+        }
+        else
+        {
+            RunJobScheduler(config);
+        }
+
+        ++currentConfiguration;
+    }
+}
+
+void JobSchedulerTest::RunLegacyQueue(Configuration& config)
+{
+    using namespace JobSchedulerTestDetails;
+
+    JobQueueWorker queue;
+    Semaphore doneSem(0);
+    Vector<JobThread*> threads;
+    for (uint32 i = 0; i < config.workersCount; ++i)
+    {
+        threads.push_back(new JobThread(&queue, &doneSem));
+    }
+
+    auto waitQueue = [&queue, &doneSem]() {
+        while (!queue.IsEmpty())
+        {
+            queue.Broadcast();
+            doneSem.Wait();
+        }
+    };
+
+    Vector<uint32> results(JOBS_BATCH_SIZE);
+    int64 startTime = SystemTimer::GetUs();
+    for (uint32 batch = 0; batch < JOBS_BATCHES_COUNT; ++batch)
+    {
+        for (uint32 i = 0; i < JOBS_BATCH_SIZE; ++i)
+        {
+            uint32* out = &results[i];
+            queue.Push([i, out]() { DoJobWork(i, out); });
+        }
+        queue.Broadcast();
+        waitQueue();
+    }
+    config.jobsTimeUs = SystemTimer::GetUs() - startTime;
+
+    Vector<float32> data(PARALLEL_FOR_RANGE, 1.0f);
+    startTime = SystemTimer::GetUs();
+    for (uint32 repeat = 0; repeat < PARALLEL_FOR_REPEATS; ++repeat)
+    {
+        for (uint32 begin = 0; begin < PARALLEL_FOR_RANGE; begin += PARALLEL_FOR_GRAIN)
+        {
+            uint32 end = std::min(begin + PARALLEL_FOR_GRAIN, PARALLEL_FOR_RANGE);
+            queue.Push([begin, end, &data]() { DoRangeWork(begin, end, data); });
+        }
+        queue.Broadcast();
+        waitQueue();
+    }
+    config.parallelForTimeUs = SystemTimer::GetUs() - startTime;
+
+    for (JobThread* thread : threads)
+    {
+        SafeDelete(thread);
+    }
+}
+
+void JobSchedulerTest::RunJobScheduler(Configuration& config)
+{
+    using namespace JobSchedulerTestDetails;
+
+    JobScheduler scheduler(config.workersCount);
+
+    Vector<uint32> results(JOBS_BATCH_SIZE);
+    int64 startTime = SystemTimer::GetUs();
+    for (uint32 batch = 0; batch < JOBS_BATCHES_COUNT; ++batch)
+    {
+        for (uint32 i = 0; i < JOBS_BATCH_SIZE; ++i)
+        {
+            uint32* out = &results[i];
+            scheduler.Schedule([i, out]() { DoJobWork(i, out); });
+        }
+        scheduler.WaitAll();
+    }
+    config.jobsTimeUs = SystemTimer::GetUs() - startTime;
+
+    Vector<float32> data(PARALLEL_FOR_RANGE, 1.0f);
+    startTime = SystemTimer::GetUs();
+    for (uint32 repeat = 0; repeat < PARALLEL_FOR_REPEATS; ++repeat)
+    {
+        scheduler.ParallelFor(0, PARALLEL_FOR_RANGE, PARALLEL_FOR_GRAIN, [&data](uint32 begin, uint32 end) { DoRangeWork(begin, end, data); });
+    }
+    config.parallelForTimeUs = SystemTimer::GetUs() - startTime;
+}
+
+void JobSchedulerTest::OnStart()
+{
+    Logger::Info(TeamcityPerformanceTestsOutput::FormatTestStarted(GetSceneName()).c_str());
+}
+
+void JobSchedulerTest::OnFinish()
+{
+    for (const Configuration& config : configurations)
+    {
+        const char* name = config.legacyQueue ? "JobQueue" : "JobScheduler";
+        Logger::Info(TeamcityPerformanceTestsOutput::FormatBuildStatistic(Format("%s_Jobs_%u", name, config.workersCount), Format("%.3f", config.jobsTimeUs / 1000.0)).c_str());
+        Logger::Info(TeamcityPerformanceTestsOutput::FormatBuildStatistic(Format("%s_ParallelFor_%u", name, config.workersCount), Format("%.3f", config.parallelForTimeUs / 1000.0)).c_str());
+    }
+
+    Logger::Info(TeamcityPerformanceTestsOutput::FormatTestFinished(GetSceneName()).c_str());
+}
+
+bool JobSchedulerTest::IsFinished() const
+{
+    return (currentConfiguration >= configurations.size());
+}
@@ -0,0 +1,49 @@
+#ifndef __JOB_SCHEDULER_TEST_H__
+#define __JOB_SCHEDULER_TEST_H__
+
+#include "BaseTest.h"
+
+// Compares legacy single-queue JobQueueWorker against work-stealing JobScheduler.
+// Every frame runs one configuration (implementation x workers count) and remembers its time.
+class JobSchedulerTest : public BaseTest
+{
+public:
+    static const String TEST_NAME;
+
+    JobSchedulerTest(const TestParams& testParams);
+
+    void OnStart() override;
+    void OnFinish() override;
+
+    void Update(float32 timeElapsed) override;
+
+    bool IsFinished() const override;
+
+protected:
+    void LoadResources() override;
+    void UnloadResources() override;
+
+    void CreateUI() override{};
+    void UpdateUI() override{};
+
+    void PerformTestLogic(float32 timeElapsed) override{};
+
+private:
+    struct Configuration
+    {
+        bool legacyQueue;
+        uint32 workersCount;
+        uint64 jobsTimeUs;
+        uint64 parallelForTimeUs;
+    };
+
+    void RunLegacyQueue(Configuration& config);
+    void RunJobScheduler(Configuration& config);
+
+    Vector<Configuration> configurations;
+    uint32 currentConfiguration = 0;
+
+    UIStaticText* testText = nullptr;
+};
+
+#endif
@@ -0,0 +1,102 @@
+#include "SceneFormatTest.h"
+
+#include <FileSystem/FileSystem.h>
+#include <Scene3D/Scene.h>
+#include <Scene3D/SceneFileV2.h>
+
+namespace SceneFormatTestDetails
+{
+static const uint32 LOADS_COUNT = 10;
+static const char* LAYOUT_NAMES[] = { "Archives", "Flat" };
+}
+
+const String SceneFormatTest::TEST_NAME = "SceneFormatTest";
+
+SceneFormatTest::SceneFormatTest(const TestParams& testParams)
+    : BaseTest(TEST_NAME, testParams)
+{
+}
+
+void SceneFormatTest::LoadResources()
+{
+    ScopedPtr<Font> font12(FTFont::Create("~res:/Fonts/korinna.ttf"));
+    font12->SetSize(12.f);
+
+    testText = new UIStaticText();
+    testText->SetFont(font12);
+    testText->SetTextColor(Color(0.f, 1.f, 0.f, 1.f));
+    testText->SetTextAlign(ALIGN_LEFT | ALIGN_VCENTER);
+    testText->SetRect(Rect(10.f, 10.f, 300.f, 10.f));
+    testText->SetText(UTF8Utils::EncodeToWideString(TEST_NAME));
+    AddControl(testText);
+
+    FilePath folder("~doc:/SceneFormatTest/");
+    GetEngineContext()->fileSystem->CreateDirectory(folder, true);
+
+    scenePathes[LAYOUT_ARCHIVES] = folder + "archives.sc2";
+    scenePathes[LAYOUT_FLAT] = folder + "flat.sc2";
+
+    // source map may be saved by old versions, so it's resaved first and then converted
+    ScopedPtr<Scene> scene(new Scene());
+    prepared = (scene->LoadScene("~res:/3d/Maps/" + GetParams().scenePath) == SceneFileV2::ERROR_NO_ERROR)
+    && (scene->SaveScene(scenePathes[LAYOUT_ARCHIVES]) == SceneFileV2::ERROR_NO_ERROR)
+    && (SceneFileV2::ConvertToFlatArchives(scenePathes[LAYOUT_ARCHIVES], scenePathes[LAYOUT_FLAT]) == SceneFileV2::ERROR_NO_ERROR);
+
+    if (!prepared)
+    {
+        Logger::Error("SceneFormatTest: failed to prepare map '%s'", GetParams().sceneName.c_str());
+    }
+
+    loadTime.fill(0);
+    loadsCount = 0;
+}
+
+void SceneFormatTest::UnloadResources()
+{
+    SafeRelease(testText);
+
+    GetEngineContext()->fileSystem->DeleteDirectory("~doc:/SceneFormatTest/");
+}
+
+void SceneFormatTest::Update(float32 timeElapsed)
+{
+    BaseScreen::Update(timeElapsed);
+
+    if (!IsFinished())
+    {
+        uint32 layout = loadsCount % LAYOUT_COUNT;
+
+        uint64 time = SystemTimer::GetMs();
+        {
+            ScopedPtr<Scene> scene(new Scene());
+            scene->LoadScene(scenePathes[layout]);
+        }
+        loadTime[layout] += SystemTimer::GetMs() - time;
+
+        ++loadsCount;
+    }
+}
+
+void SceneFormatTest::OnStart()
+{
+    Logger::Info(TeamcityPerformanceTestsOutput::FormatTestStarted(GetSceneName()).c_str());
+}
+
+void SceneFormatTest::OnFinish()
+{
+    if (prepared)
+    {
+        for (uint32 layout = 0; layout < LAYOUT_COUNT; ++layout)
+        {
+            String name = Format("SceneLoad_%s", SceneFormatTestDetails::LAYOUT_NAMES[layout]);
+            Logger::Info(TeamcityPerformanceTestsOutput::FormatBuildStatistic(name, Format("%lld", loadTime[layout] / SceneFormatTestDetails::LOADS_COUNT)).c_str());
+        }
+    }
+
+    Logger::Info(TeamcityPerformanceTestsOutput::FormatTestFinished(GetSceneName()).c_str());
+}
+
+bool SceneFormatTest::IsFinished() const
+{
+    return !prepared || (loadsCount >= SceneFormatTestDetails::LOADS_COUNT * LAYOUT_COUNT);
+}
@@ -0,0 +1,48 @@
+#ifndef __SCENE_FORMAT_TEST_H__
+#define __SCENE_FORMAT_TEST_H__
+
+#include "BaseTest.h"
+
+// Compares loading time of same map saved with archives layout and with flat archives layout.
+// Map is resaved into ~doc: in both layouts, then every frame loads one copy, alternating layouts.
+class SceneFormatTest : public BaseTest
+{
+public:
+    static const String TEST_NAME;
+
+    SceneFormatTest(const TestParams& testParams);
+
+    void OnStart() override;
+    void OnFinish() override;
+
+    void Update(float32 timeElapsed) override;
+
+    bool IsFinished() const override;
+
+protected:
+    void LoadResources() override;
+    void UnloadResources() override;
+
+    void CreateUI() override{};
+    void UpdateUI() override{};
+
+    void PerformTestLogic(float32 timeElapsed) override{};
+
+private:
+    enum eLayout : uint32
+    {
+        LAYOUT_ARCHIVES = 0,
+        LAYOUT_FLAT,
+
+        LAYOUT_COUNT
+    };
+
+    Array<FilePath, LAYOUT_COUNT> scenePathes;
+    Array<uint64, LAYOUT_COUNT> loadTime = {};
+    uint32 loadsCount = 0;
+    bool prepared = false;
+
+    UIStaticText* testText = nullptr;
+};
+
+#endif
@@ -0,0 +1,140 @@
+#include "SkeletonSystemTest.h"
+
+#include <Scene3D/Components/SkeletonComponent.h>
+#include <Scene3D/Entity.h>
+#include <Scene3D/Scene.h>
+#include <Scene3D/Systems/SkeletonSystem.h>
+
+namespace SkeletonSystemTestDetails
+{
+static const uint32 SKELETONS_COUNTS[] = { 100, 500, 1000 };
+static const uint32 JOINTS_COUNTS[] = { 32, 64 };
+static const uint32 FRAMES_COUNT = 60;
+
+// joints form binary tree, parent always goes before its children
+Vector<SkeletonComponent::Joint> CreateJoints(uint32 jointsCount)
+{
+    Vector<SkeletonComponent::Joint> joints(jointsCount);
+    for (uint32 i = 0; i < jointsCount; ++i)
+    {
+        SkeletonComponent::Joint& joint = joints[i];
+        joint.parentIndex = (i == 0) ? SkeletonComponent::INVALID_JOINT_INDEX : (i - 1) / 2;
+        joint.name = FastName(Format("joint%u", i));
+        joint.uid = joint.name;
+        joint.bbox = AABBox3(Vector3(-0.1f, -0.1f, -0.1f), Vector3(0.1f, 0.1f, 0.1f));
+        joint.bindTransform = Matrix4::MakeTranslation(Vector3(0.f, 0.f, (i == 0) ? 0.f : 0.5f));
+        joint.bindTransformInv = Matrix4::MakeTranslation(Vector3(0.f, 0.f, -0.5f * i));
+    }
+    return joints;
+}
+}
+
+const String SkeletonSystemTest::TEST_NAME = "SkeletonSystemTest";
+
+SkeletonSystemTest::SkeletonSystemTest(const TestParams& testParams)
+    : BaseTest(TEST_NAME, testParams)
+{
+}
+
+void SkeletonSystemTest::LoadResources()
+{
+    ScopedPtr<Font> font12(FTFont::Create("~res:/Fonts/korinna.ttf"));
+    font12->SetSize(12.f);
+
+    testText = new UIStaticText();
+    testText->SetFont(font12);
+    testText->SetTextColor(Color(0.f, 1.f, 0.f, 1.f));
+    testText->SetTextAlign(ALIGN_LEFT | ALIGN_VCENTER);
+    testText->SetRect(Rect(10.f, 10.f, 300.f, 10.f));
+    testText->SetText(UTF8Utils::EncodeToWideString(TEST_NAME));
+    AddControl(testText);
+
+    configurations.clear();
+    for (uint32 jointsCount : SkeletonSystemTestDetails::JOINTS_COUNTS)
+    {
+        for (uint32 skeletonsCount : SkeletonSystemTestDetails::SKELETONS_COUNTS)
+        {
+            configurations.push_back({ skeletonsCount, jointsCount, 0.0 });
+        }
+    }
+    currentConfiguration = 0;
+}
+
+void SkeletonSystemTest::UnloadResources()
+{
+    SafeRelease(testText);
+}
+
+void SkeletonSystemTest::Update(float32 timeElapsed)
+{
+    BaseScreen::Update(timeElapsed);
+
+    if (currentConfiguration < configurations.size())
+    {
+        RunConfiguration(configurations[currentConfiguration]);
+        ++currentConfiguration;
+    }
+}
+
+void SkeletonSystemTest::RunConfiguration(Configuration& config)
+{
+    using namespace SkeletonSystemTestDetails;
+
+    ScopedPtr<Scene> testScene(new Scene());
+
+    Vector<SkeletonComponent::Joint> joints = CreateJoints(config.jointsCount);
+    Vector<SkeletonComponent*> skeletons;
+    for (uint32 i = 0; i < config.skeletonsCount; ++i)
+    {
+        ScopedPtr<Entity> entity(new Entity());
+        SkeletonComponent* skeleton = new SkeletonComponent();
+        skeleton->SetJoints(joints);
+        entity->AddComponent(skeleton);
+        testScene->AddNode(entity);
+
+        skeletons.push_back(skeleton);
+    }
+
+    // first processing evaluates whole skeletons after rebuild
+    testScene->skeletonSystem->Process(0.f);
+
+    const float32 frameTime = 1.f / 60.f;
+    int64 processTimeUs = 0;
+    for (uint32 frame = 0; frame < FRAMES_COUNT; ++frame)
+    {
+        float32 angle = frame * frameTime;
+        for (SkeletonComponent* skeleton : skeletons)
+        {
+            for (uint32 j = 0; j < config.jointsCount; ++j)
+            {
+                skeleton->SetJointOrientation(j, Quaternion::MakeRotationFastY(angle + j * 0.1f));
+            }
+        }
+
+        int64 startTime = SystemTimer::GetUs();
+        testScene->skeletonSystem->Process(frameTime);
+        processTimeUs += SystemTimer::GetUs() - startTime;
+    }
+
+    config.msPer100Skeletons = (processTimeUs / 1000.0) / FRAMES_COUNT * (100.0 / config.skeletonsCount);
+}
+
+void SkeletonSystemTest::OnStart()
+{
+    Logger::Info(TeamcityPerformanceTestsOutput::FormatTestStarted(GetSceneName()).c_str());
+}
+
+void SkeletonSystemTest::OnFinish()
+{
+    for (const Configuration& config : configurations)
+    {
+        Logger::Info(TeamcityPerformanceTestsOutput::FormatBuildStatistic(Format("SkeletonSystem_MsPer100Skeletons_%u_%u", config.skeletonsCount, config.jointsCount), Format("%.3f", config.msPer100Skeletons)).c_str());
+    }
+
+    Logger::Info(TeamcityPerformanceTestsOutput::FormatTestFinished(GetSceneName()).c_str());
+}
+
+bool SkeletonSystemTest::IsFinished() const
+{
+    return (currentConfiguration >= configurations.size());
+}
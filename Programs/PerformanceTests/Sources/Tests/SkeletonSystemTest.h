@@ -0,0 +1,48 @@
+#ifndef __SKELETON_SYSTEM_TEST_H__
+#define __SKELETON_SYSTEM_TEST_H__
+
+#include "BaseTest.h"
+
+// Measures time of SkeletonSystem::Process for scene with many animated skeletons.
+// Every joint of every skeleton is changed each frame, so all hierarchies are evaluated.
+// Every frame runs one configuration (skeletons count x joints count) and reports time per 100 skeletons.
+class SkeletonSystemTest : public BaseTest
+{
+public:
+    static const String TEST_NAME;
+
+    SkeletonSystemTest(const TestParams& testParams);
+
+    void OnStart() override;
+    void OnFinish() override;
+
+    void Update(float32 timeElapsed) override;
+
+    bool IsFinished() const override;
+
+protected:
+    void LoadResources() override;
+    void UnloadResources() override;
+
+    void CreateUI() override{};
+    void UpdateUI() override{};
+
+    void PerformTestLogic(float32 timeElapsed) override{};
+
+private:
+    struct Configuration
+    {
+        uint32 skeletonsCount;
+        uint32 jointsCount;
+        float64 msPer100Skeletons;
+    };
+
+    void RunConfiguration(Configuration& config);
+
+    Vector<Configuration> configurations;
+    uint32 currentConfiguration = 0;
+
+    UIStaticText* testText = nullptr;
+};
+
+#endif
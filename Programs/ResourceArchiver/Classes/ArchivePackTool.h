@@ -24,6 +24,8 @@ private:
     DAVA::String compressionStr;
     DAVA::Compressor::Type compressionType;
     bool dummyFileData = false;
+    DAVA::uint32 blockSize = 0;
+    DAVA::uint32 dictionarySize = 0;
     DAVA::String packFileName;
     DAVA::String baseDir;
     DAVA::String metaDbPath;
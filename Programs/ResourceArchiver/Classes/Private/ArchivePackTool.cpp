@@ -13,6 +13,8 @@ const DAVA::String Compression = "-compression";
 const DAVA::String BaseDir = "-basedir";
 const DAVA::String MetaDbFile = "-metadb";
 const DAVA::String DummyFileData = "-dummyFileData";
+const DAVA::String BlockSize = "-blocksize";
+const DAVA::String DictionarySize = "-dictsize";
 }
 
 ArchivePackTool::ArchivePackTool()
@@ -24,6 +26,8 @@ ArchivePackTool::ArchivePackTool()
     options.AddOption(OptionNames::BaseDir, VariantType(String("")), "source base directory");
     options.AddOption(OptionNames::MetaDbFile, VariantType(String("")), "sqlite db with metadata");
     options.AddOption(OptionNames::DummyFileData, VariantType(false), "write dummy single-byte files instead of actual file data, useful if you are interested in pack footer only");
+    options.AddOption(OptionNames::BlockSize, VariantType(static_cast<uint32>(0)), "split files bigger than blocksize bytes into independently compressed blocks to decompress them in parallel, such pack can't be used as DLC superpack, 0 - default, don't split");
+    options.AddOption(OptionNames::DictionarySize, VariantType(static_cast<uint32>(0)), "train dictionary of dictsize bytes (64Kb max) on packed files and use it for lz4/lz4hc compression, such pack can't be used as DLC superpack, 0 - default, no dictionary");
     options.AddArgument("packfile");
 }
 
@@ -41,6 +45,8 @@ bool ArchivePackTool::ConvertOptionsToParamsInternal()
     compressionType = static_cast<Compressor::Type>(type);
 
     dummyFileData = options.GetOption(OptionNames::DummyFileData).AsBool();
+    blockSize = options.GetOption(OptionNames::BlockSize).AsUInt32();
+    dictionarySize = options.GetOption(OptionNames::DictionarySize).AsUInt32();
 
     baseDir = options.GetOption(OptionNames::BaseDir).AsString();
     if (baseDir.empty())
@@ -75,6 +81,8 @@ int ArchivePackTool::ProcessInternal()
     params.baseDirPath = (baseDir.empty() ? FileSystem::Instance()->GetCurrentWorkingDirectory() : baseDir);
     params.metaDbPath = metaDbPath;
     params.dummyFileData = dummyFileData;
+    params.blockSize = blockSize;
+    params.dictionarySize = dictionarySize;
 
     if (!CreateArchive(params))
     {
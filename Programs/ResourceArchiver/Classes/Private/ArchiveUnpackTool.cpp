@@ -8,10 +8,14 @@
 #include <Engine/Engine.h>
 #include <Compression/LZ4Compressor.h>
 #include <Compression/ZipCompressor.h>
+#include <Concurrency/LockGuard.h>
+#include <Concurrency/Mutex.h>
 
 #include "ResultCodes.h"
 
 static int UnpackFile(const DAVA::FilePath& archivePath,
+                      const DAVA::PackArchive& packArchive,
+                      DAVA::Mutex& packArchiveMutex,
                       const DAVA::PackFormat::PackFile::FilesTableBlock::FilesData::Data& fileInfo,
                       const DAVA::String& relativeFilePath,
                       const bool extractInDvplFormat);
@@ -89,6 +93,7 @@ int ArchiveUnpackTool::ProcessInternal()
         DVASSERT(jobManager != nullptr);
 
         std::atomic<int> countExtractedFiles(0);
+        Mutex packArchiveMutex;
 
         const auto& fileInfoBase = packArchive.GetFilesInfo();
 
@@ -99,7 +104,7 @@ int ArchiveUnpackTool::ProcessInternal()
                                             const auto& fileInfoFromArchive = packFile.filesTable.data.files[i];
                                             const auto& fileInfo = fileInfoBase[i];
 
-                                            if (UnpackFile(packFilename, fileInfoFromArchive, fileInfo.relativeFilePath, extractInDvplFormat) == OK)
+                                            if (UnpackFile(packFilename, packArchive, packArchiveMutex, fileInfoFromArchive, fileInfo.relativeFilePath, extractInDvplFormat) == OK)
                                             {
                                                 ++countExtractedFiles;
                                             }
@@ -133,28 +138,50 @@ int ArchiveUnpackTool::ProcessInternal()
 }
 
 static int UnpackFile(const DAVA::FilePath& archivePath,
-                      const DAVA::PackFormat::PackFile::FilesTableBlock::FilesData::Data& fileInfo,
+                      const DAVA::PackArchive& packArchive,
+                      DAVA::Mutex& packArchiveMutex,
+                      const DAVA::PackFormat::PackFile::FilesTableBlock::FilesData::Data& packedFileInfo,
                       const DAVA::String& relativeFilePath,
                       const bool extractInDvplFormat)
 {
     using namespace DAVA;
 
-    ScopedPtr<File> ifs(File::Create(archivePath.GetAbsolutePathname(), File::OPEN | File::READ));
-    if (!ifs)
-    {
-        return ERROR_CANT_EXTRACT_FILE;
-    }
+    PackFormat::FileTableEntry fileInfo = packedFileInfo;
+    Vector<uint8> compressedContent;
 
-    if (!ifs->Seek(fileInfo.startPosition, File::eFileSeek::SEEK_FROM_START))
+    // chunked and dictionary compressed content can be decoded only with data from pack,
+    // so it is unpacked by archive itself and stored without compression
+    if (PackFormat::IsChunkedEntry(fileInfo, packArchive.GetPackFile().footer.info.blockSize) || fileInfo.type == Compressor::Type::Lz4Dict)
     {
-        return ERROR_CANT_EXTRACT_FILE;
+        LockGuard<Mutex> lock(packArchiveMutex);
+        if (!packArchive.LoadFile(relativeFilePath, compressedContent))
+        {
+            return ERROR_CANT_EXTRACT_FILE;
+        }
+
+        fileInfo.type = Compressor::Type::None;
+        fileInfo.compressedSize = fileInfo.originalSize;
+        fileInfo.compressedCrc32 = fileInfo.originalCrc32;
     }
+    else
+    {
+        ScopedPtr<File> ifs(File::Create(archivePath.GetAbsolutePathname(), File::OPEN | File::READ));
+        if (!ifs)
+        {
+            return ERROR_CANT_EXTRACT_FILE;
+        }
 
-    Vector<uint8> compressedContent(fileInfo.compressedSize);
+        if (!ifs->Seek(fileInfo.startPosition, File::eFileSeek::SEEK_FROM_START))
+        {
+            return ERROR_CANT_EXTRACT_FILE;
+        }
 
-    if (fileInfo.compressedSize != ifs->Read(compressedContent.data(), static_cast<uint32>(compressedContent.size())))
-    {
-        return ERROR_CANT_EXTRACT_FILE;
+        compressedContent.resize(fileInfo.compressedSize);
+
+        if (fileInfo.compressedSize != ifs->Read(compressedContent.data(), static_cast<uint32>(compressedContent.size())))
+        {
+            return ERROR_CANT_EXTRACT_FILE;
+        }
     }
 
     FilePath fullPath(relativeFilePath);
@@ -424,23 +424,28 @@ void WriteToBuffer(Vector<uint8>& buffer, const String& string)
     }
 }
 
-eColladaErrorCodes ColladaImporter::SaveAnimations(ColladaScene* colladaScene, const FilePath& dir)
+template <class T>
+void WriteChannelToBuffer(Vector<uint8>& buffer, AnimationTrack::eChannelTarget target, uint8 dimension, AnimationChannel::eInterpolation interpolation, const Vector<std::pair<float32, T>>& keys)
 {
-    //binary file format described in 'AnimationBinaryFormat.md'
-    struct ChannelHeader
+    Vector<float32> keyTimes;
+    Vector<float32> keyValues;
+    for (const std::pair<float32, T>& key : keys)
     {
-        //Track part
-        uint8 target;
-        uint8 pad0[3];
-
-        //Channel part
-        uint32 signature = AnimationChannel::ANIMATION_CHANNEL_DATA_SIGNATURE;
-        uint8 dimension = 0;
-        uint8 interpolation = 0;
-        uint16 compression = 0;
-        uint32 keyCount = 0;
-    } channelHeader;
+        keyTimes.push_back(key.first);
+        keyValues.insert(keyValues.end(), key.second.data, key.second.data + dimension);
+    }
+
+    //Track part
+    uint8 targetData[4] = { uint8(target), 0, 0, 0 }; //target and pad
+    WriteToBuffer(buffer, targetData, 4);
 
+    //Channel part
+    AnimationChannel::WriteData(dimension, interpolation, AnimationChannel::COMPRESSION_QUANTIZED, keyTimes, keyValues, buffer);
+}
+
+eColladaErrorCodes ColladaImporter::SaveAnimations(ColladaScene* colladaScene, const FilePath& dir)
+{
+    //binary file format described in 'AnimationBinaryFormat.md'
     for (auto canimation : colladaScene->colladaAnimations)
     {
         FilePath filePath = dir + String(canimation->name + ".anim");
@@ -477,52 +482,22 @@ eColladaErrorCodes ColladaImporter::SaveAnimations(ColladaScene* colladaScene, c
 
                 WriteToBuffer(animationClipData, &channelsCount);
 
+                //Write position channel
                 if (!animationData.translations.empty())
                 {
-                    //Write position channel
-                    channelHeader.dimension = 3;
-                    channelHeader.interpolation = uint8(AnimationChannel::INTERPOLATION_LINEAR);
-                    channelHeader.target = AnimationTrack::CHANNEL_TARGET_POSITION;
-                    channelHeader.keyCount = uint32(animationData.translations.size());
-                    WriteToBuffer(animationClipData, &channelHeader);
-
-                    for (auto& t : animationData.translations)
-                    {
-                        WriteToBuffer(animationClipData, &t.first); //time
-                        WriteToBuffer(animationClipData, &t.second); //position
-                    }
+                    WriteChannelToBuffer(animationClipData, AnimationTrack::CHANNEL_TARGET_POSITION, 3, AnimationChannel::INTERPOLATION_LINEAR, animationData.translations);
                 }
 
                 //Write orientation channel
                 if (!animationData.rotations.empty())
                 {
-                    channelHeader.dimension = 4;
-                    channelHeader.interpolation = uint8(AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR);
-                    channelHeader.target = AnimationTrack::CHANNEL_TARGET_ORIENTATION;
-                    channelHeader.keyCount = uint32(animationData.rotations.size());
-                    WriteToBuffer(animationClipData, &channelHeader);
-
-                    for (auto& r : animationData.rotations)
-                    {
-                        WriteToBuffer(animationClipData, &r.first); //time
-                        WriteToBuffer(animationClipData, &r.second); //rotation
-                    }
+                    WriteChannelToBuffer(animationClipData, AnimationTrack::CHANNEL_TARGET_ORIENTATION, 4, AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR, animationData.rotations);
                 }
 
                 //Write scale channel
                 if (!animationData.scales.empty())
                 {
-                    channelHeader.dimension = 1;
-                    channelHeader.interpolation = uint8(AnimationChannel::INTERPOLATION_LINEAR);
-                    channelHeader.target = AnimationTrack::CHANNEL_TARGET_SCALE;
-                    channelHeader.keyCount = uint32(animationData.scales.size());
-                    WriteToBuffer(animationClipData, &channelHeader);
-
-                    for (auto& s : animationData.scales)
-                    {
-                        WriteToBuffer(animationClipData, &s.first); //time
-                        WriteToBuffer(animationClipData, &s.second.x); //scale
-                    }
+                    WriteChannelToBuffer(animationClipData, AnimationTrack::CHANNEL_TARGET_SCALE, 1, AnimationChannel::INTERPOLATION_LINEAR, animationData.scales);
                 }
             }
 
@@ -8,6 +8,7 @@
 #include <TArc/Utils/ModuleCollection.h>
 
 #include <Logger/Logger.h>
+#include <Scene3D/SceneFileV2.h>
 
 SceneSaverTool::SceneSaverTool(const DAVA::Vector<DAVA::String>& commandLine)
     : CommandLineModule(commandLine, "-scenesaver")
@@ -17,6 +18,7 @@ SceneSaverTool::SceneSaverTool(const DAVA::Vector<DAVA::String>& commandLine)
     options.AddOption(OptionName::Save, VariantType(false), "Saving scene from indir to outdir");
     options.AddOption(OptionName::Resave, VariantType(false), "Resave file into indir");
     options.AddOption(OptionName::Yaml, VariantType(false), "Target is *.yaml file");
+    options.AddOption(OptionName::Convert, VariantType(false), "Convert scene file in indir into flat archives layout");
     options.AddOption(OptionName::InDir, VariantType(String("")), "Path for Project/DataSource/3d/ folder");
     options.AddOption(OptionName::OutDir, VariantType(String("")), "Path for Project/Data/3d/ folder");
     options.AddOption(OptionName::ProcessFile, VariantType(String("")), "Filename from DataSource/3d/ for exporting");
@@ -63,6 +65,10 @@ bool SceneSaverTool::PostInitInternal()
             commandAction = ACTION_RESAVE_SCENE;
         }
     }
+    else if (options.GetOption(OptionName::Convert).AsBool())
+    {
+        commandAction = ACTION_CONVERT_SCENE;
+    }
 
     if (commandAction == ACTION_SAVE)
     {
@@ -138,6 +144,16 @@ DAVA::ConsoleModule::eFrameResult SceneSaverTool::OnFrameInternal()
         saver.ResaveYamlFilesRecursive(inFolder);
         break;
     }
+    case SceneSaverTool::eAction::ACTION_CONVERT_SCENE:
+    {
+        DAVA::FilePath scenePathname = inFolder + filename;
+        DAVA::SceneFileV2::eError result = DAVA::SceneFileV2::ConvertToFlatArchives(scenePathname, scenePathname);
+        if (result != DAVA::SceneFileV2::ERROR_NO_ERROR)
+        {
+            DAVA::Logger::Error("Cannot convert scene %s, error %d", scenePathname.GetAbsolutePathname().c_str(), result);
+        }
+        break;
+    }
 
     default:
         DAVA::Logger::Error("Unhandled action!");
@@ -164,6 +180,7 @@ void SceneSaverTool::ShowHelpInternal()
 
     DAVA::Logger::Info("\t-scenesaver -resave -indir /Users/SmokeTest/DataSource/3d/ -processfile Maps/scene.sc2 -qualitycfgpath Users/SmokeTest/Data/quality.yaml");
     DAVA::Logger::Info("\t-scenesaver -resave -yaml -indir /Users/SmokeTest/Data/Configs/");
+    DAVA::Logger::Info("\t-scenesaver -convert -indir /Users/SmokeTest/Data/3d/ -processfile Maps/scene.sc2");
 }
 
 DECL_TARC_MODULE(SceneSaverTool);
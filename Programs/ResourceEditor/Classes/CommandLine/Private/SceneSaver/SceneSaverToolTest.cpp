@@ -9,6 +9,8 @@
 #include <Engine/Engine.h>
 #include <FileSystem/FileList.h>
 #include <Render/TextureDescriptor.h>
+#include <Scene3D/Scene.h>
+#include <Scene3D/SceneFileV2.h>
 
 namespace SSTestDetail
 {
@@ -139,6 +141,40 @@ DAVA_TARC_TESTCLASS(SceneSaverToolTest)
         CommandLineModuleTestUtils::ClearTestFolder(SSTestDetail::projectStr);
     }
 
+    DAVA_TEST (ConvertSceneTest)
+    {
+        using namespace DAVA;
+
+        std::unique_ptr<CommandLineModuleTestUtils::TextureLoadingGuard> guard = CommandLineModuleTestUtils::CreateTextureGuard({ eGPUFamily::GPU_ORIGIN });
+        CommandLineModuleTestUtils::CreateProjectInfrastructure(SSTestDetail::projectStr);
+        CommandLineModuleTestUtils::SceneBuilder::CreateFullScene(SSTestDetail::scenePathnameStr, SSTestDetail::projectStr);
+
+        FilePath dataSourcePath = SSTestDetail::projectStr + "DataSource/3d/";
+
+        Vector<String> cmdLine =
+        {
+          "ResourceEditor",
+          "-scenesaver",
+          "-convert",
+          "-indir",
+          dataSourcePath.GetAbsolutePathname(),
+          "-processfile",
+          FilePath(SSTestDetail::scenePathnameStr).GetRelativePathname(dataSourcePath),
+        };
+
+        std::unique_ptr<CommandLineModule> tool = std::make_unique<SceneSaverTool>(cmdLine);
+        DAVA::ConsoleModuleTestExecution::ExecuteModule(tool.get());
+
+        VersionInfo::SceneVersion version = SceneFileV2::LoadSceneVersion(SSTestDetail::scenePathnameStr);
+        TEST_VERIFY(version.version == FLAT_ARCHIVES_SCENE_VERSION);
+
+        ScopedPtr<Scene> scene(new Scene());
+        TEST_VERIFY(scene->LoadScene(SSTestDetail::scenePathnameStr) == SceneFileV2::ERROR_NO_ERROR);
+        TEST_VERIFY(scene->GetChildrenCount() > 0);
+
+        CommandLineModuleTestUtils::ClearTestFolder(SSTestDetail::projectStr);
+    }
+
     DAVA_TEST (ResaveYamlTest)
     {
         using namespace DAVA;
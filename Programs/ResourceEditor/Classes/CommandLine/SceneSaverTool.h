@@ -21,6 +21,7 @@ private:
         ACTION_SAVE,
         ACTION_RESAVE_SCENE,
         ACTION_RESAVE_YAML,
+        ACTION_CONVERT_SCENE,
     };
     eAction commandAction = ACTION_NONE;
     DAVA::String filename;
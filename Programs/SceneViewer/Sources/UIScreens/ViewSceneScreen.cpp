@@ -42,6 +42,7 @@ ViewSceneScreen::ViewSceneScreen(SceneViewerData& data)
     , fpsMeter(ViewSceneScreenDetails::INFO_UPDATE_INTERVAL_SEC)
 #ifdef WITH_SCENE_PERFORMANCE_TESTS
     , gridTest(data.engine, this)
+    , skeletonTest(data.engine, this)
 #endif
 {
     GetOrCreateComponent<DAVA::UIUpdateComponent>();
@@ -94,6 +95,7 @@ void ViewSceneScreen::PlaceSceneAtScreen()
             reloadShadersMenuItem->SetEnabled(true);
 #ifdef WITH_SCENE_PERFORMANCE_TESTS
             performanceTestMenuItem->SetEnabled(true);
+            skeletonTestMenuItem->SetEnabled(true);
 #endif
             characterSpawnMenuItem->SetEnabled(true);
         }
@@ -120,6 +122,10 @@ void ViewSceneScreen::RemoveSceneFromScreen()
             characterSpawned = false;
         }
 
+#ifdef WITH_SCENE_PERFORMANCE_TESTS
+        skeletonTest.Stop();
+#endif
+
         SafeDelete(rotationControllerSystem);
         SafeDelete(wasdSystem);
 
@@ -131,6 +137,7 @@ void ViewSceneScreen::RemoveSceneFromScreen()
             qualitySettingsMenuItem->SetEnabled(false);
             reloadShadersMenuItem->SetEnabled(false);
             performanceTestMenuItem->SetEnabled(false);
+            skeletonTestMenuItem->SetEnabled(false);
             characterSpawnMenuItem->SetEnabled(false);
         }
     }
@@ -227,12 +234,14 @@ void ViewSceneScreen::AddMenuControl()
     qualitySettingsMenuItem = mainSubMenu->AddActionItem(L"Quality settings", DAVA::Message(this, &ViewSceneScreen::OnButtonQualitySettings));
     reloadShadersMenuItem = mainSubMenu->AddActionItem(L"Reload shaders", DAVA::Message(this, &ViewSceneScreen::OnButtonReloadShaders));
     performanceTestMenuItem = mainSubMenu->AddActionItem(L"Performance test", DAVA::Message(this, &ViewSceneScreen::OnButtonPerformanceTest));
+    skeletonTestMenuItem = mainSubMenu->AddActionItem(L"Skeletons test", DAVA::Message(this, &ViewSceneScreen::OnButtonSkeletonTest));
     characterSpawnMenuItem = mainSubMenu->AddActionItem(L"Toggle Spawn Character", DAVA::Message(this, &ViewSceneScreen::OnButtonToggleSpawnCharacter));
     mainSubMenu->AddBackItem();
 
     qualitySettingsMenuItem->SetEnabled(false);
     reloadShadersMenuItem->SetEnabled(false);
     performanceTestMenuItem->SetEnabled(false);
+    skeletonTestMenuItem->SetEnabled(false);
     characterSpawnMenuItem->SetEnabled(false);
 
     Menu* selectSceneSubMenu = selectSceneSubMenuItem->submenu.get();
@@ -304,6 +313,7 @@ void ViewSceneScreen::RemoveControls()
     qualitySettingsMenuItem = nullptr;
     reloadShadersMenuItem = nullptr;
     performanceTestMenuItem = nullptr;
+    skeletonTestMenuItem = nullptr;
     characterSpawnMenuItem = nullptr;
 }
 
@@ -404,6 +414,16 @@ void ViewSceneScreen::OnButtonPerformanceTest(DAVA::BaseObject* caller, void* pa
 #endif
 }
 
+void ViewSceneScreen::OnButtonSkeletonTest(DAVA::BaseObject* caller, void* param, void* callerData)
+{
+#ifdef WITH_SCENE_PERFORMANCE_TESTS
+    if (scene && skeletonTest.GetState() == SkeletonTest::StateFinished)
+    {
+        skeletonTest.Start(sceneView);
+    }
+#endif
+}
+
 void ViewSceneScreen::OnButtonQualitySettings(DAVA::BaseObject* caller, void* param, void* callerData)
 {
     menu->SetEnabled(false);
@@ -574,6 +594,15 @@ void ViewSceneScreen::OnGridTestStateChanged()
         SetNextScreen();
     }
 }
+
+void ViewSceneScreen::OnSkeletonTestStateChanged()
+{
+    // results are written to log, menu item is blocked only while test is running
+    if (skeletonTestMenuItem)
+    {
+        skeletonTestMenuItem->SetEnabled(skeletonTest.GetState() == SkeletonTest::StateFinished);
+    }
+}
 #endif
 
 // void ViewSceneScreen::DidAppear()
@@ -7,6 +7,7 @@
 
 #ifdef WITH_SCENE_PERFORMANCE_TESTS
 #include <GridTest.h>
+#include <SkeletonTest.h>
 #endif
 
 #include <UI/UIList.h>
@@ -19,6 +20,7 @@ class ViewSceneScreen
   public DAVA::UIFileSystemDialogDelegate,
 #ifdef WITH_SCENE_PERFORMANCE_TESTS
   public GridTestListener,
+  public SkeletonTestListener,
 #endif
   public QualitySettingsDialogDelegate
 {
@@ -47,6 +49,9 @@ private:
 #ifdef WITH_SCENE_PERFORMANCE_TESTS
     // GridTestListener
     void OnGridTestStateChanged() override;
+
+    // SkeletonTestListener
+    void OnSkeletonTestStateChanged() override;
 #endif
 
     void AddMenuControl();
@@ -61,6 +66,7 @@ private:
     void OnButtonQualitySettings(DAVA::BaseObject* caller, void* param, void* callerData);
     void OnButtonReloadShaders(DAVA::BaseObject* caller, void* param, void* callerData);
     void OnButtonPerformanceTest(DAVA::BaseObject* caller, void* param, void* callerData);
+    void OnButtonSkeletonTest(DAVA::BaseObject* caller, void* param, void* callerData);
     void OnButtonSelectFromRes(DAVA::BaseObject* caller, void* param, void* callerData);
     void OnButtonSelectFromDoc(DAVA::BaseObject* caller, void* param, void* callerData);
     void OnButtonSelectFromExt(DAVA::BaseObject* caller, void* param, void* callerData);
@@ -94,6 +100,7 @@ private:
     MenuItem* qualitySettingsMenuItem = nullptr;
     MenuItem* reloadShadersMenuItem = nullptr;
     MenuItem* performanceTestMenuItem = nullptr;
+    MenuItem* skeletonTestMenuItem = nullptr;
     MenuItem* characterSpawnMenuItem = nullptr;
 
     DAVA::RotationControllerSystem* rotationControllerSystem = nullptr;
@@ -103,6 +110,7 @@ private:
 
 #ifdef WITH_SCENE_PERFORMANCE_TESTS
     GridTest gridTest;
+    SkeletonTest skeletonTest;
 #endif
 
     bool characterSpawned = false;
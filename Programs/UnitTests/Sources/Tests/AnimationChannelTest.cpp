@@ -0,0 +1,167 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Animation/AnimationChannel.h"
+#include "Animation/AnimationTrack.h"
+#include "Base/BaseMath.h"
+
+using namespace DAVA;
+
+namespace AnimationChannelTestDetails
+{
+const uint32 KEYS_COUNT = 300;
+const float32 KEYS_PER_SECOND = 30.f;
+const float32 TOLERANCE = 0.001f;
+
+void CreatePositionKeys(Vector<float32>& keyTimes, Vector<float32>& keyValues)
+{
+    for (uint32 k = 0; k < KEYS_COUNT; ++k)
+    {
+        float32 time = k / KEYS_PER_SECOND;
+        keyTimes.push_back(time);
+        keyValues.push_back(std::sin(time) * 2.f);
+        keyValues.push_back(1.5f); //constant component
+        keyValues.push_back(time * 0.5f); //linear component
+    }
+}
+
+void CreateOrientationKeys(Vector<float32>& keyTimes, Vector<float32>& keyValues)
+{
+    for (uint32 k = 0; k < KEYS_COUNT; ++k)
+    {
+        float32 time = k / KEYS_PER_SECOND;
+        Quaternion q = Quaternion::MakeRotation(Vector3(0.f, 0.f, 1.f), time) * Quaternion::MakeRotation(Vector3(1.f, 0.f, 0.f), std::sin(time * 3.f));
+        q.Normalize();
+
+        keyTimes.push_back(time);
+        keyValues.insert(keyValues.end(), q.data, q.data + 4);
+    }
+}
+
+float32 GetDifference(const float32* v0, const float32* v1, uint32 dimension, bool quaternion)
+{
+    float32 difference = 0.f;
+    float32 negatedDifference = 0.f;
+    for (uint32 d = 0; d < dimension; ++d)
+    {
+        difference = Max(difference, std::abs(v0[d] - v1[d]));
+        negatedDifference = Max(negatedDifference, std::abs(v0[d] + v1[d]));
+    }
+    return quaternion ? Min(difference, negatedDifference) : difference;
+}
+
+// compares quantized channel with uncompressed one at times between keys and returns max error
+float32 CompareChannels(uint8 dimension, AnimationChannel::eInterpolation interpolation, const Vector<float32>& keyTimes, const Vector<float32>& keyValues, float32* compressionRatio)
+{
+    Vector<uint8> rawData;
+    Vector<uint8> quantizedData;
+    AnimationChannel::WriteData(dimension, interpolation, AnimationChannel::COMPRESSION_NONE, keyTimes, keyValues, rawData);
+    AnimationChannel::WriteData(dimension, interpolation, AnimationChannel::COMPRESSION_QUANTIZED, keyTimes, keyValues, quantizedData, TOLERANCE);
+
+    AnimationChannel rawChannel;
+    AnimationChannel quantizedChannel;
+    TEST_VERIFY(rawChannel.Bind(rawData.data()) == uint32(rawData.size()));
+    TEST_VERIFY(quantizedChannel.Bind(quantizedData.data()) == uint32(quantizedData.size()));
+    TEST_VERIFY(quantizedChannel.GetCompression() == AnimationChannel::COMPRESSION_QUANTIZED);
+    TEST_VERIFY(quantizedChannel.GetKeysCount() < rawChannel.GetKeysCount());
+
+    *compressionRatio = float32(rawData.size()) / float32(quantizedData.size());
+
+    float32 maxError = 0.f;
+    uint32 cursor = 0;
+    float32 duration = keyTimes.back();
+    for (float32 time = -0.1f; time < duration + 0.1f; time += 0.01f)
+    {
+        float32 expected[4];
+        float32 actual[4];
+        rawChannel.Evaluate(time, expected, 4);
+        quantizedChannel.Evaluate(time, actual, 4, &cursor);
+        maxError = Max(maxError, GetDifference(expected, actual, dimension, interpolation == AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR));
+    }
+    return maxError;
+}
+}
+
+DAVA_TESTCLASS (AnimationChannelTest)
+{
+    DAVA_TEST (QuantizedPositionTest)
+    {
+        using namespace AnimationChannelTestDetails;
+
+        Vector<float32> keyTimes;
+        Vector<float32> keyValues;
+        CreatePositionKeys(keyTimes, keyValues);
+
+        float32 compressionRatio = 0.f;
+        float32 maxError = CompareChannels(3, AnimationChannel::INTERPOLATION_LINEAR, keyTimes, keyValues, &compressionRatio);
+        TEST_VERIFY(maxError < TOLERANCE * 2.f);
+        TEST_VERIFY(compressionRatio > 3.f);
+    }
+
+    DAVA_TEST (QuantizedOrientationTest)
+    {
+        using namespace AnimationChannelTestDetails;
+
+        Vector<float32> keyTimes;
+        Vector<float32> keyValues;
+        CreateOrientationKeys(keyTimes, keyValues);
+
+        float32 compressionRatio = 0.f;
+        float32 maxError = CompareChannels(4, AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR, keyTimes, keyValues, &compressionRatio);
+        TEST_VERIFY(maxError < TOLERANCE * 2.f);
+        TEST_VERIFY(compressionRatio > 2.5f); //rotation is fast, so most keys are kept, but every key takes 8 bytes instead of 20
+    }
+
+    DAVA_TEST (ConstantChannelTest)
+    {
+        Vector<float32> keyTimes = { 0.f, 0.5f, 1.f };
+        Vector<float32> keyValues = { 2.f, 2.f, 2.f };
+
+        Vector<uint8> data;
+        AnimationChannel::WriteData(1, AnimationChannel::INTERPOLATION_LINEAR, AnimationChannel::COMPRESSION_QUANTIZED, keyTimes, keyValues, data);
+
+        AnimationChannel channel;
+        TEST_VERIFY(channel.Bind(data.data()) == uint32(data.size()));
+        TEST_VERIFY(channel.GetKeysCount() == 1);
+
+        float32 value = 0.f;
+        channel.Evaluate(0.75f, &value, 1);
+        TEST_VERIFY(value == 2.f);
+    }
+
+    DAVA_TEST (CursorTest)
+    {
+        using namespace AnimationChannelTestDetails;
+
+        Vector<float32> keyTimes;
+        Vector<float32> keyValues;
+        CreatePositionKeys(keyTimes, keyValues);
+
+        const AnimationChannel::eCompression compressions[] = { AnimationChannel::COMPRESSION_NONE, AnimationChannel::COMPRESSION_QUANTIZED };
+        for (AnimationChannel::eCompression compression : compressions)
+        {
+            Vector<uint8> data;
+            AnimationChannel::WriteData(3, AnimationChannel::INTERPOLATION_LINEAR, compression, keyTimes, keyValues, data);
+
+            AnimationChannel channel;
+            channel.Bind(data.data());
+
+            // forward playback with small and large steps, looping and seeking back should give the same values as evaluation without cursor
+            const float32 steps[] = { 0.001f, 0.016f, 0.5f, 3.f };
+            for (float32 step : steps)
+            {
+                uint32 cursor = 0;
+                for (uint32 loop = 0; loop < 2; ++loop)
+                {
+                    for (float32 time = 0.f; time < keyTimes.back() + 0.5f; time += step)
+                    {
+                        float32 expected[3];
+                        float32 actual[3];
+                        channel.Evaluate(time, expected, 3);
+                        channel.Evaluate(time, actual, 3, &cursor);
+                        TEST_VERIFY(expected[0] == actual[0] && expected[1] == actual[1] && expected[2] == actual[2]);
+                    }
+                }
+            }
+        }
+    }
+};
@@ -2,6 +2,8 @@
 #include <FileSystem/Private/PackArchive.h>
 #include <FileSystem/Private/ZipArchive.h>
 #include <FileSystem/FileSystem.h>
+#include <Compression/LZ4Compressor.h>
+#include <Utils/CRC32.h>
 #include <Logger/Logger.h>
 
 #include <cstring>
@@ -58,6 +60,176 @@ DAVA_TESTCLASS (ArchiveTest)
 #endif // __DAVAENGINE_IPHONE__
     }
 
+    DAVA_TEST (TestMemoryMappedDavaArchive)
+    {
+#if !defined(__DAVAENGINE_IPHONE__) && !defined(__DAVAENGINE_ANDROID__)
+        try
+        {
+            RefPtr<File> fileDvpk(File::Create("~res:/TestData/ArchiveTest/archive.dvpk", File::OPEN | File::READ));
+            PackArchive readArchive(fileDvpk, "~res:/TestData/ArchiveTest/archive.dvpk");
+
+            RefPtr<File> fileDvpkMapped(File::Create("~res:/TestData/ArchiveTest/archive.dvpk", File::OPEN | File::READ));
+            PackArchive mappedArchive(fileDvpkMapped, "~res:/TestData/ArchiveTest/archive.dvpk", true);
+
+            TEST_VERIFY(mappedArchive.IsMemoryMapped());
+
+            for (const ResourceArchive::FileInfo& info : readArchive.GetFilesInfo())
+            {
+                Vector<uint8> readContent;
+                Vector<uint8> mappedContent;
+                TEST_VERIFY(readArchive.LoadFile(info.relativeFilePath, readContent));
+                TEST_VERIFY(mappedArchive.LoadFile(info.relativeFilePath, mappedContent));
+                TEST_VERIFY(readContent == mappedContent);
+
+                ResourceArchive::ContentView view;
+                TEST_VERIFY(!readArchive.LoadFileView(info.relativeFilePath, view));
+
+                bool hasView = mappedArchive.LoadFileView(info.relativeFilePath, view);
+                TEST_VERIFY(hasView == (info.compressionType == Compressor::Type::None));
+                if (hasView)
+                {
+                    TEST_VERIFY(view.size == readContent.size());
+                    TEST_VERIFY(std::equal(readContent.begin(), readContent.end(), view.data));
+                }
+            }
+        }
+        catch (std::exception& ex)
+        {
+            Logger::Info(ex.what());
+        }
+#endif // __DAVAENGINE_IPHONE__
+    }
+
+    DAVA_TEST (TestChunkedDavaArchive)
+    {
+        const FilePath packPath("~doc:/ArchiveTest/chunked.dvpk");
+        const char* fileName = "chunked.bin";
+        const uint32 blockSize = 4096;
+
+        // content is 3.5 blocks long, some blocks are compressible and one of them is stored as is
+        Vector<uint8> content(blockSize * 3 + blockSize / 2);
+        uint32 seed = 12345;
+        for (size_t i = 0; i < content.size(); ++i)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            content[i] = (i / blockSize == 1) ? static_cast<uint8>(seed >> 24) : static_cast<uint8>(i / 64);
+        }
+
+        // build pack with one chunked entry, see PackFormat::IsChunkedEntry
+        Vector<uint8> packedContent;
+        {
+            const uint32 blocksCount = PackFormat::GetBlocksCount(static_cast<uint32>(content.size()), blockSize);
+            Vector<uint32> blockSizes;
+            Vector<uint8> blocksData;
+            for (uint32 i = 0; i < blocksCount; ++i)
+            {
+                auto blockBegin = content.begin() + i * blockSize;
+                Vector<uint8> blockIn(blockBegin, blockBegin + std::min<size_t>(blockSize, content.end() - blockBegin));
+                Vector<uint8> blockOut;
+                TEST_VERIFY(LZ4HCCompressor().Compress(blockIn, blockOut));
+                const Vector<uint8>& useBlock = (blockOut.size() < blockIn.size()) ? blockOut : blockIn;
+                blockSizes.push_back(static_cast<uint32>(useBlock.size()));
+                blocksData.insert(blocksData.end(), useBlock.begin(), useBlock.end());
+            }
+            packedContent.resize(blocksCount * sizeof(uint32));
+            Memcpy(packedContent.data(), blockSizes.data(), packedContent.size());
+            packedContent.insert(packedContent.end(), blocksData.begin(), blocksData.end());
+        }
+
+        PackFormat::FileTableEntry entry = {};
+        entry.startPosition = 0;
+        entry.compressedSize = static_cast<uint32>(packedContent.size());
+        entry.originalSize = static_cast<uint32>(content.size());
+        entry.compressedCrc32 = CRC32::ForBuffer(packedContent.data(), packedContent.size());
+        entry.type = Compressor::Type::Lz4HC;
+        entry.originalCrc32 = CRC32::ForBuffer(content.data(), content.size());
+        entry.metaIndex = 0;
+
+        Vector<uint8> names(fileName, fileName + strlen(fileName) + 1);
+        Vector<uint8> compressedNames;
+        TEST_VERIFY(LZ4HCCompressor().Compress(names, compressedNames));
+        uint32 namesCrc32 = CRC32::ForBuffer(compressedNames.data(), compressedNames.size());
+
+        Vector<uint8> filesTable(sizeof(entry));
+        Memcpy(filesTable.data(), &entry, sizeof(entry));
+        filesTable.insert(filesTable.end(), compressedNames.begin(), compressedNames.end());
+        filesTable.insert(filesTable.end(), reinterpret_cast<uint8*>(&namesCrc32), reinterpret_cast<uint8*>(&namesCrc32) + sizeof(namesCrc32));
+
+        PackFormat::PackFile::FooterBlock footer;
+        footer.info.blockSize = blockSize;
+        footer.info.numFiles = 1;
+        footer.info.namesSizeCompressed = static_cast<uint32>(compressedNames.size());
+        footer.info.namesSizeOriginal = static_cast<uint32>(names.size());
+        footer.info.filesTableSize = static_cast<uint32>(filesTable.size());
+        footer.info.filesTableCrc32 = CRC32::ForBuffer(filesTable.data(), filesTable.size());
+        footer.info.packArchiveMarker = PackFormat::FILE_MARKER;
+        footer.infoCrc32 = CRC32::ForBuffer(&footer.info, sizeof(footer.info));
+
+        FileSystem::Instance()->CreateDirectory(packPath.GetDirectory(), true);
+        {
+            ScopedPtr<File> output(File::Create(packPath, File::CREATE | File::WRITE));
+            TEST_VERIFY(output);
+            output->Write(packedContent.data(), static_cast<uint32>(packedContent.size()));
+            output->Write(filesTable.data(), static_cast<uint32>(filesTable.size()));
+            output->Write(&footer, sizeof(footer));
+        }
+
+        try
+        {
+            for (bool useMapping : { false, true })
+            {
+                RefPtr<File> fileDvpk(File::Create(packPath, File::OPEN | File::READ));
+                PackArchive archive(fileDvpk, packPath, useMapping);
+
+                Vector<uint8> loaded;
+                TEST_VERIFY(archive.LoadFile(fileName, loaded));
+                TEST_VERIFY(loaded == content);
+
+                // ranges inside of one block, crossing blocks boundaries and touching the last partial block
+                const uint64 ranges[][2] = { { 0, 10 }, { 100, blockSize }, { blockSize - 1, 2 }, { blockSize * 2 + 7, blockSize + 100 }, { content.size() - 1, 1 }, { 0, content.size() } };
+                for (const auto& range : ranges)
+                {
+                    Vector<uint8> part;
+                    TEST_VERIFY(archive.LoadFileRange(fileName, range[0], range[1], part));
+                    TEST_VERIFY(part.size() == range[1]);
+                    TEST_VERIFY(std::equal(part.begin(), part.end(), content.begin() + static_cast<size_t>(range[0])));
+                }
+
+                Vector<uint8> outOfBounds;
+                TEST_VERIFY(!archive.LoadFileRange(fileName, content.size() - 1, 2, outOfBounds));
+            }
+        }
+        catch (std::exception& ex)
+        {
+            Logger::Error("%s", ex.what());
+            TEST_VERIFY(false && "can't read chunked pack file");
+        }
+
+        // block size is covered by footer crc32, so pack with changed block size is refused
+        footer.info.blockSize = blockSize * 2;
+        {
+            ScopedPtr<File> output(File::Create(packPath, File::CREATE | File::WRITE));
+            TEST_VERIFY(output);
+            output->Write(packedContent.data(), static_cast<uint32>(packedContent.size()));
+            output->Write(filesTable.data(), static_cast<uint32>(filesTable.size()));
+            output->Write(&footer, sizeof(footer));
+        }
+
+        bool refused = false;
+        try
+        {
+            RefPtr<File> fileDvpk(File::Create(packPath, File::OPEN | File::READ));
+            PackArchive archive(fileDvpk, packPath, false);
+        }
+        catch (std::exception&)
+        {
+            refused = true;
+        }
+        TEST_VERIFY(refused);
+
+        FileSystem::Instance()->DeleteFile(packPath);
+    }
+
     DAVA_TEST (TestZipArchive)
     {
         try
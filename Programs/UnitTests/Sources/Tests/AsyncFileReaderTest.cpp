@@ -0,0 +1,149 @@
+#include "UnitTests/UnitTests.h"
+#include <FileSystem/AsyncFileReader.h>
+#include <FileSystem/FileSystem.h>
+#include <FileSystem/ResourceArchive.h>
+#include <Logger/Logger.h>
+
+#include <atomic>
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (AsyncFileReaderTest)
+{
+    DAVA_TEST (TestReadRanges)
+    {
+        FileSystem* fs = FileSystem::Instance();
+        FilePath dir("~doc:/AsyncFileReaderTest/");
+        fs->DeleteDirectory(dir, true);
+        fs->CreateDirectory(dir, true);
+
+        FilePath filePath = dir + "content.bin";
+        Vector<uint8> content(512 * 1024);
+        for (size_t i = 0; i < content.size(); ++i)
+        {
+            content[i] = static_cast<uint8>((i * 31) ^ (i >> 8));
+        }
+        {
+            ScopedPtr<File> file(File::Create(filePath, File::CREATE | File::WRITE));
+            TEST_VERIFY(file);
+            TEST_VERIFY(file->Write(content.data(), static_cast<uint32>(content.size())) == content.size());
+        }
+
+        // neighbouring, overlapping and distant ranges with mixed priorities
+        const uint64 ranges[][2] = {
+            { 0, 1024 },
+            { 1024, 4096 },
+            { 3000, 10000 },
+            { 200 * 1024, 100 },
+            { 500 * 1024, 12 * 1024 },
+            { 100, 0 }
+        };
+
+        AsyncFileReader reader;
+        std::atomic<uint32> callbacksCount(0);
+        Vector<AsyncFileReader::RequestPtr> requests;
+        uint32 index = 0;
+        for (const auto& range : ranges)
+        {
+            AsyncFileReader::ePriority priority = static_cast<AsyncFileReader::ePriority>(index++ % 3);
+            requests.push_back(reader.Read(filePath, range[0], range[1], priority, [&callbacksCount](const AsyncFileReader::RequestPtr& request) {
+                ++callbacksCount;
+            }));
+        }
+
+        AsyncFileReader::RequestPtr beyondEof = reader.Read(filePath, content.size() - 10, 20);
+        AsyncFileReader::RequestPtr missingFile = reader.Read(dir + "missing.bin", 0, 10);
+        AsyncFileReader::RequestPtr wholeFile = reader.ReadFile(filePath, AsyncFileReader::ePriority::Low);
+
+        reader.WaitAll();
+        TEST_VERIFY(reader.GetPendingRequestsCount() == 0);
+        TEST_VERIFY(callbacksCount == requests.size());
+
+        for (size_t i = 0; i < requests.size(); ++i)
+        {
+            const AsyncFileReader::RequestPtr& request = requests[i];
+            TEST_VERIFY(request->GetStatus() == AsyncFileReader::eStatus::Done);
+
+            const Vector<uint8>& data = request->GetData();
+            TEST_VERIFY(data.size() == ranges[i][1]);
+            TEST_VERIFY(std::equal(data.begin(), data.end(), content.begin() + static_cast<size_t>(ranges[i][0])));
+        }
+
+        TEST_VERIFY(beyondEof->GetStatus() == AsyncFileReader::eStatus::Failed);
+        TEST_VERIFY(missingFile->GetStatus() == AsyncFileReader::eStatus::Failed);
+        TEST_VERIFY(wholeFile->GetStatus() == AsyncFileReader::eStatus::Done);
+        TEST_VERIFY(wholeFile->GetData() == content);
+
+        // request can't be cancelled after it is finished
+        TEST_VERIFY(!wholeFile->Cancel());
+
+        fs->DeleteDirectory(dir, true);
+    }
+
+    DAVA_TEST (TestWaitAndCancel)
+    {
+        FilePath filePath("~res:/TestData/Utf8Test/utf16le.txt");
+
+        AsyncFileReader reader;
+        Vector<AsyncFileReader::RequestPtr> requests;
+        for (uint32 i = 0; i < 64; ++i)
+        {
+            requests.push_back(reader.ReadFile(filePath));
+        }
+
+        uint32 cancelledCount = 0;
+        for (const AsyncFileReader::RequestPtr& request : requests)
+        {
+            if (request->Cancel())
+            {
+                TEST_VERIFY(request->GetStatus() == AsyncFileReader::eStatus::Cancelled);
+                ++cancelledCount;
+            }
+        }
+
+        for (const AsyncFileReader::RequestPtr& request : requests)
+        {
+            request->Wait();
+            TEST_VERIFY(request->IsFinished());
+        }
+        reader.WaitAll();
+
+        uint32 doneCount = 0;
+        for (const AsyncFileReader::RequestPtr& request : requests)
+        {
+            doneCount += request->GetStatus() == AsyncFileReader::eStatus::Done ? 1 : 0;
+        }
+        TEST_VERIFY(doneCount + cancelledCount == requests.size());
+    }
+
+    DAVA_TEST (TestReadFromArchive)
+    {
+#if !defined(__DAVAENGINE_IPHONE__) && !defined(__DAVAENGINE_ANDROID__)
+        try
+        {
+            ResourceArchive archive("~res:/TestData/ArchiveTest/archive.dvpk");
+
+            AsyncFileReader reader;
+            Vector<AsyncFileReader::RequestPtr> requests;
+            for (const ResourceArchive::FileInfo& info : archive.GetFilesInfo())
+            {
+                requests.push_back(reader.ReadFromArchive(archive, info.relativeFilePath));
+            }
+            reader.WaitAll();
+
+            for (const AsyncFileReader::RequestPtr& request : requests)
+            {
+                TEST_VERIFY(request->GetStatus() == AsyncFileReader::eStatus::Done);
+
+                Vector<uint8> content;
+                TEST_VERIFY(archive.LoadFile(request->GetArchiveFilePath(), content));
+                TEST_VERIFY(request->GetData() == content);
+            }
+        }
+        catch (std::exception& ex)
+        {
+            Logger::Info(ex.what());
+        }
+#endif // __DAVAENGINE_IPHONE__
+    }
+};
@@ -0,0 +1,119 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Concurrency/Thread.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+#include "Logger/AsyncLogWriter.h"
+#include "Utils/StringFormat.h"
+#include "Utils/Utils.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (AsyncLogWriterTest)
+{
+    const FilePath logFilePath = "~doc:/AsyncLogWriterTest/test.log";
+    const FilePath rotatedLogFilePath = "~doc:/AsyncLogWriterTest/test.log.1";
+
+    AsyncLogWriterTest()
+    {
+        FileSystem::Instance()->DeleteDirectory("~doc:/AsyncLogWriterTest/");
+        FileSystem::Instance()->CreateDirectory("~doc:/AsyncLogWriterTest/", true);
+    }
+
+    ~AsyncLogWriterTest()
+    {
+        FileSystem::Instance()->DeleteDirectory("~doc:/AsyncLogWriterTest/");
+    }
+
+    Vector<String> ReadLines(const FilePath& path)
+    {
+        Vector<String> lines;
+        String content = FileSystem::Instance()->ReadFileContents(path);
+        Split(content, "\n", lines);
+        return lines;
+    }
+
+    DAVA_TEST (ConcurrentWriteTest)
+    {
+        const uint32 threadsCount = 4;
+        const uint32 messagesCount = 5000;
+
+        FileSystem::Instance()->DeleteFile(logFilePath);
+        {
+            AsyncLogWriter writer(logFilePath, 64 * 1024 * 1024);
+
+            Vector<RefPtr<Thread>> threads;
+            for (uint32 t = 0; t < threadsCount; ++t)
+            {
+                threads.emplace_back(Thread::Create([&writer, t, messagesCount]() {
+                    for (uint32 i = 0; i < messagesCount; ++i)
+                    {
+                        writer.Write(Logger::LEVEL_INFO, Format("thread %u message %u\n", t, i).c_str());
+                    }
+                }));
+                threads.back()->Start();
+            }
+
+            for (RefPtr<Thread>& thread : threads)
+            {
+                thread->Join();
+            }
+
+            writer.Flush();
+
+            // all messages are in file after flush, messages of each thread are in order
+            Vector<String> lines = ReadLines(logFilePath);
+            TEST_VERIFY(lines.size() == threadsCount * messagesCount);
+
+            Vector<uint32> nextMessage(threadsCount, 0);
+            for (const String& line : lines)
+            {
+                TEST_VERIFY(line.find("[info] ") != String::npos);
+
+                uint32 t = 0;
+                uint32 i = 0;
+                TEST_VERIFY(sscanf(line.c_str() + line.find("thread"), "thread %u message %u", &t, &i) == 2);
+                TEST_VERIFY(t < threadsCount && nextMessage[t] == i);
+                nextMessage[t] = i + 1;
+            }
+        }
+    }
+
+    DAVA_TEST (FlushOnDestructionTest)
+    {
+        FileSystem::Instance()->DeleteFile(logFilePath);
+        {
+            AsyncLogWriter writer(logFilePath, 64 * 1024 * 1024);
+            writer.Write(Logger::LEVEL_WARNING, "last message\n");
+        }
+
+        Vector<String> lines = ReadLines(logFilePath);
+        TEST_VERIFY(lines.size() == 1);
+        TEST_VERIFY(lines.size() == 1 && lines[0].find("[warning] last message") != String::npos);
+    }
+
+    DAVA_TEST (RotationTest)
+    {
+        const uint32 maxFileSize = 1024;
+
+        FileSystem::Instance()->DeleteFile(logFilePath);
+        FileSystem::Instance()->DeleteFile(rotatedLogFilePath);
+        {
+            AsyncLogWriter writer(logFilePath, maxFileSize);
+            for (uint32 i = 0; i < 1000; ++i)
+            {
+                writer.Write(Logger::LEVEL_DEBUG, Format("message %u\n", i).c_str());
+            }
+        }
+
+        TEST_VERIFY(FileSystem::Instance()->IsFile(rotatedLogFilePath));
+
+        ScopedPtr<File> log(File::Create(logFilePath, File::OPEN | File::READ));
+        TEST_VERIFY(log);
+        TEST_VERIFY(log && log->GetSize() <= maxFileSize);
+
+        // last message is always in current file
+        Vector<String> lines = ReadLines(logFilePath);
+        TEST_VERIFY(!lines.empty() && lines.back().find("message 999") != String::npos);
+    }
+};
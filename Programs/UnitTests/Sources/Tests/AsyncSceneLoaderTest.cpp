@@ -0,0 +1,154 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Particles/ParticleEmitter.h"
+#include "Particles/ParticleEmitterInstance.h"
+#include "Render/Material/NMaterialNames.h"
+#include "Render/TextureDescriptor.h"
+#include "Scene3D/AsyncSceneLoader.h"
+#include "Scene3D/Components/ComponentHelpers.h"
+#include "Scene3D/Components/ParticleEffectComponent.h"
+#include "Scene3D/Components/RenderComponent.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (AsyncSceneLoaderTest)
+{
+    const uint32 ENTITIES_COUNT = 100;
+
+    ScopedPtr<Scene> scene;
+    ScopedPtr<AsyncSceneLoader> loader;
+    FilePath scenePath;
+    FilePath texturePath;
+    Vector<float32> progress;
+    bool finished = false;
+
+    DAVA_TEST (LoadSceneTest)
+    {
+        scenePath = FileSystem::Instance()->GetCurrentDocumentsDirectory() + "AsyncSceneLoaderTest/scene.sc2";
+        texturePath = scenePath.GetDirectory() + "number_0.tex";
+        FilePath emitterPath = scenePath.GetDirectory() + "shared_emitter.yaml";
+        FileSystem::Instance()->CreateDirectory(scenePath.GetDirectory(), true);
+        FileSystem::Instance()->CopyFile("~res:/TestData/PVRTest/DecompressedPNG/number_0.tex", texturePath, true);
+        FileSystem::Instance()->CopyFile("~res:/TestData/PVRTest/DecompressedPNG/number_0.png", scenePath.GetDirectory() + "number_0.png", true);
+        FileSystem::Instance()->CopyFile("~res:/TestData/ParticleEffectSystemTest/shared_emitter.yaml", emitterPath, true);
+
+        {
+            ScopedPtr<Scene> sourceScene(new Scene());
+            for (uint32 i = 0; i < ENTITIES_COUNT; ++i)
+            {
+                ScopedPtr<Entity> entity(new Entity());
+                entity->SetName(FastName(Format("entity%u", i)));
+                sourceScene->AddNode(entity);
+            }
+
+            // entity with textured material
+            ScopedPtr<PolygonGroup> polygonGroup(new PolygonGroup());
+            polygonGroup->AllocateData(EVF_VERTEX | EVF_TEXCOORD0, 3, 3);
+            for (int32 i = 0; i < 3; ++i)
+            {
+                polygonGroup->SetCoord(i, Vector3(static_cast<float32>(i), static_cast<float32>(i % 2), 0.f));
+                polygonGroup->SetTexcoord(0, i, Vector2(static_cast<float32>(i % 2), static_cast<float32>(i / 2)));
+                polygonGroup->SetIndex(i, static_cast<int16>(i));
+            }
+            polygonGroup->RecalcAABBox();
+
+            ScopedPtr<Texture> texture(Texture::CreateFromFile(texturePath));
+            ScopedPtr<NMaterial> material(new NMaterial());
+            material->SetFXName(NMaterialName::TEXTURED_OPAQUE);
+            material->AddTexture(NMaterialTextureName::TEXTURE_ALBEDO, texture);
+
+            ScopedPtr<RenderBatch> batch(new RenderBatch());
+            batch->SetPolygonGroup(polygonGroup);
+            batch->SetMaterial(material);
+            ScopedPtr<RenderObject> renderObject(new RenderObject());
+            renderObject->AddRenderBatch(batch);
+
+            ScopedPtr<Entity> meshEntity(new Entity());
+            meshEntity->SetName(FastName("mesh"));
+            meshEntity->AddComponent(new RenderComponent(renderObject));
+            sourceScene->AddNode(meshEntity);
+
+            // entity with particle effect
+            ScopedPtr<ParticleEmitter> emitter(ParticleEmitter::LoadEmitter(emitterPath));
+            ParticleEffectComponent* effect = new ParticleEffectComponent();
+            effect->AddEmitterInstance(emitter);
+            ScopedPtr<Entity> effectEntity(new Entity());
+            effectEntity->SetName(FastName("effect"));
+            effectEntity->AddComponent(effect);
+            sourceScene->AddNode(effectEntity);
+
+            TEST_VERIFY(sourceScene->SaveScene(scenePath) == SceneFileV2::ERROR_NO_ERROR);
+        }
+
+        // texture of source scene is released, so loader should create it from images decoded on loading thread
+        Texture* cachedTexture = Texture::Get(TextureDescriptor::GetDescriptorPathname(texturePath));
+        TEST_VERIFY(cachedTexture == nullptr);
+        SafeRelease(cachedTexture);
+
+        scene = new Scene();
+        loader = new AsyncSceneLoader(scene);
+        // each frame performs single step
+        loader->SetFrameBudget(0);
+        loader->progressChanged.Connect([this](AsyncSceneLoader*, float32 value) {
+            progress.push_back(value);
+        });
+        loader->loadFinished.Connect([this](AsyncSceneLoader* l, SceneFileV2::eError error) {
+            TEST_VERIFY(l == loader);
+            TEST_VERIFY(error == SceneFileV2::ERROR_NO_ERROR);
+            finished = true;
+        });
+        loader->Start(scenePath);
+
+        TEST_VERIFY(loader->GetState() == AsyncSceneLoader::STATE_LOADING);
+        TEST_VERIFY(scene->GetChildrenCount() == 0);
+    }
+
+    bool TestComplete(const String& testName) const override
+    {
+        return finished;
+    }
+
+    void TearDown(const String& testName) override
+    {
+        TEST_VERIFY(loader->GetState() == AsyncSceneLoader::STATE_FINISHED);
+        TEST_VERIFY(loader->GetProgress() == 1.f);
+        TEST_VERIFY(scene->GetChildrenCount() == static_cast<int32>(ENTITIES_COUNT + 2));
+        TEST_VERIFY(scene->FindByName("entity0") != nullptr);
+
+        // entities are created from parsed archives and added during several frames and progress is growing
+        TEST_VERIFY(progress.size() > 2 * ENTITIES_COUNT);
+        TEST_VERIFY(std::is_sorted(progress.begin(), progress.end()));
+        TEST_VERIFY(!progress.empty() && progress.back() == 1.f);
+
+        // texture created by loader is bound to loaded material
+        Entity* meshEntity = scene->FindByName("mesh");
+        RenderObject* renderObject = (meshEntity != nullptr) ? GetRenderObject(meshEntity) : nullptr;
+        TEST_VERIFY(renderObject != nullptr && renderObject->GetRenderBatchCount() == 1);
+        if (renderObject != nullptr && renderObject->GetRenderBatchCount() == 1)
+        {
+            // vertex data of polygon group is loaded from parsed archive
+            PolygonGroup* polygonGroup = renderObject->GetRenderBatch(0)->GetPolygonGroup();
+            TEST_VERIFY(polygonGroup != nullptr && polygonGroup->GetVertexCount() == 3);
+
+            NMaterial* material = renderObject->GetRenderBatch(0)->GetMaterial();
+            TEST_VERIFY(material != nullptr && material->HasLocalTexture(NMaterialTextureName::TEXTURE_ALBEDO));
+            if (material != nullptr && material->HasLocalTexture(NMaterialTextureName::TEXTURE_ALBEDO))
+            {
+                const MaterialTextureInfo* textureInfo = material->GetLocalTextures().at(NMaterialTextureName::TEXTURE_ALBEDO);
+                TEST_VERIFY(textureInfo->texture != nullptr);
+                TEST_VERIFY(textureInfo->texture != nullptr && !textureInfo->texture->IsPinkPlaceholder());
+                TEST_VERIFY(textureInfo->texture != nullptr && textureInfo->texture->GetPathname() == TextureDescriptor::GetDescriptorPathname(texturePath));
+            }
+        }
+
+        // particle effect is loaded with its emitter
+        Entity* effectEntity = scene->FindByName("effect");
+        ParticleEffectComponent* effect = (effectEntity != nullptr) ? GetEffectComponent(effectEntity) : nullptr;
+        TEST_VERIFY(effect != nullptr && effect->GetEmitterInstance(0) != nullptr);
+
+        loader = nullptr;
+        scene = nullptr;
+        FileSystem::Instance()->DeleteDirectory(scenePath.GetDirectory());
+    }
+};
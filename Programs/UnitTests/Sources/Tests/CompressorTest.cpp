@@ -1,5 +1,7 @@
 #include <Compression/ZipCompressor.h>
 #include <Compression/LZ4Compressor.h>
+#include <Compression/DictionaryTrainer.h>
+#include <Utils/StringFormat.h>
 
 #include "UnitTests/UnitTests.h"
 
@@ -60,4 +62,66 @@ DAVA_TESTCLASS (CompressorTest)
             TEST_VERIFY(uncompressedZip == in);
         }
     }
+
+    DAVA_TEST (TestLZ4DictWithTrainedDictionary)
+    {
+        // many small similar files, like materials or yaml configs
+        Vector<Vector<uint8>> samples;
+        for (uint32 i = 0; i < 200; ++i)
+        {
+            String content = Format("material:\n    name: \"material_%u\"\n    fxName: \"~res:/Materials/NormalizedBlinnPhongPerPixel.material\"\n"
+                                    "    textures:\n        albedo: \"~res:/3d/Maps/texture_%u.tex\"\n    flags:\n        ALPHATEST: %u\n",
+                                    i, i * 7, i % 2);
+            samples.emplace_back(content.begin(), content.end());
+        }
+
+        Vector<uint8> dictionary = DictionaryTrainer::Train(samples, 4096);
+        TEST_VERIFY(!dictionary.empty());
+        TEST_VERIFY(dictionary.size() <= 4096);
+
+        LZ4DictCompressor lz4dict(dictionary);
+        LZ4HCCompressor lz4hc;
+
+        size_t sizeLz4hc = 0;
+        size_t sizeLz4dict = 0;
+        for (const Vector<uint8>& sample : samples)
+        {
+            Vector<uint8> compressedLz4hc;
+            Vector<uint8> compressedLz4dict;
+            TEST_VERIFY(lz4hc.Compress(sample, compressedLz4hc));
+            TEST_VERIFY(lz4dict.Compress(sample, compressedLz4dict));
+
+            Vector<uint8> uncompressed(sample.size(), '\0');
+            TEST_VERIFY(lz4dict.Decompress(compressedLz4dict, uncompressed));
+            TEST_VERIFY(uncompressed == sample);
+
+            sizeLz4hc += compressedLz4hc.size();
+            sizeLz4dict += compressedLz4dict.size();
+        }
+
+        TEST_VERIFY(sizeLz4dict < sizeLz4hc);
+
+        // bigger content after small one makes compressor reallocate its window with dictionary
+        Vector<uint8> bigSample;
+        for (const Vector<uint8>& sample : samples)
+        {
+            bigSample.insert(bigSample.end(), sample.begin(), sample.end());
+        }
+        for (const Vector<uint8>* sample : { &bigSample, &samples[1], &bigSample })
+        {
+            Vector<uint8> compressedLz4dict;
+            TEST_VERIFY(lz4dict.Compress(*sample, compressedLz4dict));
+            Vector<uint8> uncompressed(sample->size(), '\0');
+            TEST_VERIFY(lz4dict.Decompress(compressedLz4dict, uncompressed));
+            TEST_VERIFY(uncompressed == *sample);
+        }
+
+        // compressor with empty dictionary works as plain lz4hc
+        LZ4DictCompressor emptyDict(Vector<uint8>{});
+        Vector<uint8> compressed;
+        TEST_VERIFY(emptyDict.Compress(samples[0], compressed));
+        Vector<uint8> uncompressed(samples[0].size(), '\0');
+        TEST_VERIFY(emptyDict.Decompress(compressed, uncompressed));
+        TEST_VERIFY(uncompressed == samples[0]);
+    }
 };
@@ -0,0 +1,101 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "Entity/EntityGroup.h"
+#include "Scene3D/Components/ActionComponent.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (EntityGroupTest)
+{
+    DAVA_TEST (FillGroupTest)
+    {
+        Scene* scene = new Scene();
+
+        Entity* e1 = new Entity();
+        e1->AddComponent(new LightComponent());
+        e1->AddComponent(new ActionComponent());
+        scene->AddNode(e1);
+
+        Entity* e2 = new Entity();
+        e2->AddComponent(new LightComponent());
+        e1->AddNode(e2);
+
+        EntityGroup<LightComponent>* lights = scene->AcquireEntityGroup<LightComponent>();
+        EntityGroup<LightComponent, ActionComponent>* actions = scene->AcquireEntityGroup<LightComponent, ActionComponent>();
+
+        TEST_VERIFY(scene->AcquireEntityGroup<LightComponent>() == lights);
+        TEST_VERIFY(lights->GetSize() == 2);
+        TEST_VERIFY(actions->GetSize() == 1);
+        TEST_VERIFY(actions->GetEntities()[0] == e1);
+        TEST_VERIFY(actions->GetComponents<LightComponent>()[0] == e1->GetComponent<LightComponent>());
+        TEST_VERIFY(actions->GetComponents<ActionComponent>()[0] == e1->GetComponent<ActionComponent>());
+
+        uint32 visited = 0;
+        lights->ForEach([&visited](Entity* entity, LightComponent* light) {
+            TEST_VERIFY(entity->GetComponent<LightComponent>() == light);
+            ++visited;
+        });
+        TEST_VERIFY(visited == 2);
+
+        scene->RemoveNode(e1);
+
+        TEST_VERIFY(lights->GetSize() == 0);
+        TEST_VERIFY(actions->GetSize() == 0);
+
+        e2->Release();
+        e1->Release();
+        scene->Release();
+    }
+
+    DAVA_TEST (UpdateGroupTest)
+    {
+        Scene* scene = new Scene();
+        EntityGroup<LightComponent, ActionComponent>* group = scene->AcquireEntityGroup<LightComponent, ActionComponent>();
+
+        Entity* e1 = new Entity();
+        Entity* e2 = new Entity();
+        scene->AddNode(e1);
+        scene->AddNode(e2);
+
+        TEST_VERIFY(group->GetSize() == 0);
+
+        e1->AddComponent(new LightComponent());
+        TEST_VERIFY(group->GetSize() == 0);
+
+        e1->AddComponent(new ActionComponent());
+        e2->AddComponent(new ActionComponent());
+        e2->AddComponent(new LightComponent());
+        TEST_VERIFY(group->GetSize() == 2);
+
+        // second component of same type doesn't change group, first one is stored
+        LightComponent* firstLight = e1->GetComponent<LightComponent>();
+        e1->AddComponent(new LightComponent());
+        TEST_VERIFY(group->GetSize() == 2);
+
+        e1->RemoveComponent(firstLight);
+        TEST_VERIFY(group->GetSize() == 2);
+        for (uint32 i = 0; i < group->GetSize(); ++i)
+        {
+            Entity* entity = group->GetEntities()[i];
+            TEST_VERIFY(group->GetComponents<LightComponent>()[i] == entity->GetComponent<LightComponent>());
+            TEST_VERIFY(group->GetComponents<ActionComponent>()[i] == entity->GetComponent<ActionComponent>());
+        }
+
+        e1->RemoveComponent<LightComponent>();
+        TEST_VERIFY(group->GetSize() == 1);
+        TEST_VERIFY(group->GetEntities()[0] == e2);
+        TEST_VERIFY(group->GetComponents<LightComponent>()[0] == e2->GetComponent<LightComponent>());
+        TEST_VERIFY(group->GetComponents<ActionComponent>()[0] == e2->GetComponent<ActionComponent>());
+
+        e2->RemoveComponent<ActionComponent>();
+        TEST_VERIFY(group->GetSize() == 0);
+
+        scene->RemoveNode(e1);
+        scene->RemoveNode(e2);
+
+        e2->Release();
+        e1->Release();
+        scene->Release();
+    }
+};
@@ -0,0 +1,193 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "FileSystem/DynamicMemoryFile.h"
+#include "FileSystem/FastNameKeyedArchive.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (FastNameKeyedArchiveTest)
+{
+    DAVA_TEST (SetGetTest)
+    {
+        const uint8 bytes[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20 };
+
+        ScopedPtr<FastNameKeyedArchive> archive(new FastNameKeyedArchive());
+        archive->SetBool(FastName("bool"), true);
+        archive->SetInt32(FastName("int32"), -1);
+        archive->SetFloat(FastName("float"), 0.5f);
+        archive->SetString(FastName("short"), "short");
+        archive->SetString(FastName("long"), "string which doesn't fit into item");
+        archive->SetFastName(FastName("fastName"), FastName("name"));
+        archive->SetMatrix4(FastName("matrix4"), Matrix4::MakeTranslation(Vector3(1.f, 2.f, 3.f)));
+        archive->SetByteArray(FastName("byteArray"), bytes, sizeof(bytes));
+
+        TEST_VERIFY(archive->Count() == 8);
+        TEST_VERIFY(archive->GetBool(FastName("bool")) == true);
+        TEST_VERIFY(archive->GetInt32(FastName("int32")) == -1);
+        TEST_VERIFY(archive->GetFloat(FastName("float")) == 0.5f);
+        TEST_VERIFY(archive->GetString(FastName("short")) == "short");
+        TEST_VERIFY(archive->GetString(FastName("long")) == "string which doesn't fit into item");
+        TEST_VERIFY(archive->GetFastName(FastName("fastName")) == FastName("name"));
+        TEST_VERIFY(archive->GetMatrix4(FastName("matrix4")) == Matrix4::MakeTranslation(Vector3(1.f, 2.f, 3.f)));
+        TEST_VERIFY(archive->GetByteArraySize(FastName("byteArray")) == sizeof(bytes));
+        TEST_VERIFY(Memcmp(archive->GetByteArray(FastName("byteArray")), bytes, sizeof(bytes)) == 0);
+
+        // missing keys and other types give default values
+        TEST_VERIFY(archive->GetInt32(FastName("missing"), 7) == 7);
+        TEST_VERIFY(archive->GetUInt32(FastName("int32"), 7) == 7);
+        TEST_VERIFY(archive->GetType(FastName("missing")) == VariantType::TYPE_NONE);
+        TEST_VERIFY(archive->GetType(FastName("long")) == VariantType::TYPE_STRING);
+
+        // values may be replaced by values of other types and sizes
+        archive->SetString(FastName("short"), "string which is longer than previous one");
+        archive->SetString(FastName("long"), "short");
+        archive->SetInt32(FastName("matrix4"), 42);
+        TEST_VERIFY(archive->GetString(FastName("short")) == "string which is longer than previous one");
+        TEST_VERIFY(archive->GetString(FastName("long")) == "short");
+        TEST_VERIFY(archive->GetInt32(FastName("matrix4")) == 42);
+
+        archive->DeleteKey(FastName("bool"));
+        TEST_VERIFY(!archive->IsKeyExists(FastName("bool")));
+        TEST_VERIFY(archive->Count() == 7);
+
+        archive->DeleteAllKeys();
+        TEST_VERIFY(archive->Count() == 0);
+    }
+
+    DAVA_TEST (KeyedArchiveCompatibilityTest)
+    {
+        ScopedPtr<KeyedArchive> nested(new KeyedArchive());
+        nested->SetInt32("int32", 42);
+
+        ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+        archive->SetBool("bool", true);
+        archive->SetUInt64("uint64", 1000000000000);
+        archive->SetFloat64("float64", 0.25);
+        archive->SetString("string", "value");
+        archive->SetWideString("wideString", L"wide value");
+        archive->SetFastName("fastName", FastName("name"));
+        archive->SetVector3("vector3", Vector3(1.f, 2.f, 3.f));
+        archive->SetColor("color", Color(0.1f, 0.2f, 0.3f, 0.4f));
+        archive->SetArchive("archive", nested);
+
+        ScopedPtr<DynamicMemoryFile> file(DynamicMemoryFile::Create(File::CREATE | File::WRITE | File::READ));
+        TEST_VERIFY(archive->Save(file));
+        TEST_VERIFY(nested->Save(file));
+        file->Seek(0, File::SEEK_FROM_START);
+
+        ScopedPtr<FastNameKeyedArchive> loaded(new FastNameKeyedArchive());
+        TEST_VERIFY(loaded->Load(file));
+        TEST_VERIFY(loaded->Count() == archive->Count());
+        TEST_VERIFY(loaded->GetBool(FastName("bool")) == true);
+        TEST_VERIFY(loaded->GetUInt64(FastName("uint64")) == 1000000000000);
+        TEST_VERIFY(loaded->GetFloat64(FastName("float64")) == 0.25);
+        TEST_VERIFY(loaded->GetString(FastName("string")) == "value");
+        TEST_VERIFY(loaded->GetString(FastName("wideString")) == "wide value");
+        TEST_VERIFY(loaded->GetFastName(FastName("fastName")) == FastName("name"));
+        TEST_VERIFY(loaded->GetVector3(FastName("vector3")) == Vector3(1.f, 2.f, 3.f));
+        TEST_VERIFY(loaded->GetColor(FastName("color")) == Color(0.1f, 0.2f, 0.3f, 0.4f));
+
+        ScopedPtr<FastNameKeyedArchive> loadedNested(new FastNameKeyedArchive());
+        TEST_VERIFY(loaded->GetArchive(FastName("archive"), loadedNested));
+        TEST_VERIFY(loadedNested->GetInt32(FastName("int32")) == 42);
+
+        // file position is moved past loaded archive
+        ScopedPtr<FastNameKeyedArchive> second(new FastNameKeyedArchive());
+        TEST_VERIFY(second->Load(file));
+        TEST_VERIFY(second->GetInt32(FastName("int32")) == 42);
+        TEST_VERIFY(file->GetPos() == file->GetSize());
+
+        // saved data is readable by KeyedArchive
+        ScopedPtr<KeyedArchive> converted(new KeyedArchive());
+        loaded->CopyTo(converted);
+        TEST_VERIFY(converted->GetString("wideString") == "wide value");
+        TEST_VERIFY(converted->GetArchive("archive") != nullptr);
+
+        Vector<uint8> data;
+        TEST_VERIFY(loaded->Save(data));
+
+        ScopedPtr<KeyedArchive> reloaded(new KeyedArchive());
+        TEST_VERIFY(reloaded->Load(data.data(), static_cast<uint32>(data.size())));
+        TEST_VERIFY(reloaded->Count() == archive->Count());
+        TEST_VERIFY(reloaded->GetUInt64("uint64") == 1000000000000);
+        TEST_VERIFY(reloaded->GetFastName("fastName") == FastName("name"));
+        TEST_VERIFY(reloaded->GetColor("color") == Color(0.1f, 0.2f, 0.3f, 0.4f));
+
+        ScopedPtr<FastNameKeyedArchive> copied(new FastNameKeyedArchive());
+        copied->CopyFrom(archive);
+        TEST_VERIFY(copied->Count() == archive->Count());
+        TEST_VERIFY(copied->GetString(FastName("string")) == "value");
+    }
+
+    DAVA_TEST (LoadIntoFilledArchiveTest)
+    {
+        ScopedPtr<FastNameKeyedArchive> source(new FastNameKeyedArchive());
+        for (uint32 i = 0; i < 100; ++i)
+        {
+            source->SetUInt32(FastName(Format("key%u", 99 - i)), i);
+        }
+        source->SetString(FastName("string"), "new string value which is stored in buffer");
+        Vector<uint8> data;
+        TEST_VERIFY(source->Save(data));
+
+        // loaded values replace values of existing keys, other keys are kept
+        ScopedPtr<FastNameKeyedArchive> archive(new FastNameKeyedArchive());
+        archive->SetUInt32(FastName("key0"), 1000);
+        archive->SetString(FastName("string"), "old string value which is stored in buffer");
+        archive->SetInt32(FastName("kept"), 7);
+        TEST_VERIFY(archive->Load(data.data(), static_cast<uint32>(data.size())));
+        TEST_VERIFY(archive->Count() == 102);
+        TEST_VERIFY(archive->GetUInt32(FastName("key0")) == 99);
+        TEST_VERIFY(archive->GetUInt32(FastName("key99")) == 0);
+        TEST_VERIFY(archive->GetString(FastName("string")) == "new string value which is stored in buffer");
+        TEST_VERIFY(archive->GetInt32(FastName("kept")) == 7);
+
+        // loading same data again doesn't add keys
+        TEST_VERIFY(archive->Load(data.data(), static_cast<uint32>(data.size())));
+        TEST_VERIFY(archive->Count() == 102);
+        TEST_VERIFY(archive->GetUInt32(FastName("key50")) == 49);
+    }
+
+    DAVA_TEST (BufferReuseTest)
+    {
+        ScopedPtr<FastNameKeyedArchive> archive(new FastNameKeyedArchive());
+        archive->SetString(FastName("stable"), "value which is stored in buffer and isn't changed");
+
+        // values are grown, shrunk and deleted many times, values left in buffer should stay intact
+        for (uint32 i = 0; i < 1000; ++i)
+        {
+            String value(32 + (i % 64), static_cast<char>('a' + i % 26));
+            archive->SetString(FastName("changed"), value);
+            archive->SetString(FastName(Format("temporary%u", i % 8)), value);
+            if (i % 3 == 0)
+            {
+                archive->DeleteKey(FastName(Format("temporary%u", (i + 4) % 8)));
+            }
+
+            TEST_VERIFY(archive->GetString(FastName("changed")) == value);
+            TEST_VERIFY(archive->GetString(FastName(Format("temporary%u", i % 8))) == value);
+        }
+
+        TEST_VERIFY(archive->GetString(FastName("stable")) == "value which is stored in buffer and isn't changed");
+
+        // inline value replaces value in buffer
+        archive->SetInt32(FastName("changed"), 5);
+        TEST_VERIFY(archive->GetInt32(FastName("changed")) == 5);
+        TEST_VERIFY(archive->GetString(FastName("stable")) == "value which is stored in buffer and isn't changed");
+    }
+
+    DAVA_TEST (SetVariantTest)
+    {
+        ScopedPtr<FastNameKeyedArchive> archive(new FastNameKeyedArchive());
+        archive->SetVariant(FastName("int32"), VariantType(int32(-5)));
+        archive->SetVariant(FastName("string"), VariantType(String("string value")));
+        archive->SetVariant(FastName("wideString"), VariantType(WideString(L"wide value")));
+        archive->SetVariant(FastName("vector3"), VariantType(Vector3(1.f, 2.f, 3.f)));
+
+        TEST_VERIFY(archive->GetInt32(FastName("int32")) == -5);
+        TEST_VERIFY(archive->GetString(FastName("string")) == "string value");
+        TEST_VERIFY(archive->GetString(FastName("wideString")) == "wide value");
+        TEST_VERIFY(archive->GetVector3(FastName("vector3")) == Vector3(1.f, 2.f, 3.f));
+    }
+};
@@ -0,0 +1,186 @@
+#include "DAVAEngine.h"
+#include "UnitTests/UnitTests.h"
+
+#include "FileSystem/DynamicMemoryFile.h"
+#include "Scene3D/SceneFile/FlatArchive.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (FlatArchiveTest)
+{
+    DAVA_TEST (ReadWriteArchiveTest)
+    {
+        const uint8 bytes[] = { 1, 2, 3, 4, 5 };
+
+        ScopedPtr<KeyedArchive> nested(new KeyedArchive());
+        nested->SetInt32("int32", -42);
+        nested->SetString("string", "nested");
+
+        ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+        archive->SetBool("bool", true);
+        archive->SetInt32("int32", -1);
+        archive->SetUInt32("uint32", 1);
+        archive->SetInt64("int64", -1000000000000);
+        archive->SetUInt64("uint64", 1000000000000);
+        archive->SetFloat("float", 0.5f);
+        archive->SetFloat64("float64", 0.25);
+        archive->SetString("string", "value");
+        archive->SetString("empty", "");
+        archive->SetWideString("wideString", L"wide value");
+        archive->SetFastName("fastName", FastName("name"));
+        archive->SetByteArray("byteArray", bytes, sizeof(bytes));
+        archive->SetVector3("vector3", Vector3(1.f, 2.f, 3.f));
+        archive->SetMatrix4("matrix4", Matrix4::MakeTranslation(Vector3(1.f, 2.f, 3.f)));
+        archive->SetColor("color", Color(0.1f, 0.2f, 0.3f, 0.4f));
+        archive->SetArchive("archive", nested);
+
+        ScopedPtr<DynamicMemoryFile> file(DynamicMemoryFile::Create(File::CREATE | File::WRITE | File::READ));
+
+        FlatArchiveWriter writer;
+        TEST_VERIFY(writer.WriteArchive(archive, file));
+        TEST_VERIFY(writer.WriteArchive(nested, file));
+
+        uint64 keysOffset = file->GetPos();
+        TEST_VERIFY(writer.WriteKeys(file));
+
+        FlatArchiveReader reader;
+        TEST_VERIFY(reader.Open(file, keysOffset));
+
+        uint64 offset = 0;
+        ScopedPtr<KeyedArchive> loaded(new KeyedArchive());
+        TEST_VERIFY(reader.ReadArchive(offset, loaded));
+
+        TEST_VERIFY(loaded->Count() == archive->Count());
+        TEST_VERIFY(loaded->GetBool("bool") == true);
+        TEST_VERIFY(loaded->GetInt32("int32") == -1);
+        TEST_VERIFY(loaded->GetUInt32("uint32") == 1);
+        TEST_VERIFY(loaded->GetInt64("int64") == -1000000000000);
+        TEST_VERIFY(loaded->GetUInt64("uint64") == 1000000000000);
+        TEST_VERIFY(loaded->GetFloat("float") == 0.5f);
+        TEST_VERIFY(loaded->GetFloat64("float64") == 0.25);
+        TEST_VERIFY(loaded->GetString("string") == "value");
+        TEST_VERIFY(loaded->IsKeyExists("empty") && loaded->GetString("empty").empty());
+        TEST_VERIFY(loaded->GetWideString("wideString") == L"wide value");
+        TEST_VERIFY(loaded->GetFastName("fastName") == FastName("name"));
+        TEST_VERIFY(loaded->GetByteArraySize("byteArray") == sizeof(bytes));
+        TEST_VERIFY(Memcmp(loaded->GetByteArray("byteArray"), bytes, sizeof(bytes)) == 0);
+        TEST_VERIFY(loaded->GetVector3("vector3") == Vector3(1.f, 2.f, 3.f));
+        TEST_VERIFY(loaded->GetMatrix4("matrix4") == Matrix4::MakeTranslation(Vector3(1.f, 2.f, 3.f)));
+        TEST_VERIFY(loaded->GetColor("color") == Color(0.1f, 0.2f, 0.3f, 0.4f));
+
+        KeyedArchive* loadedNested = loaded->GetArchive("archive");
+        TEST_VERIFY(loadedNested != nullptr);
+        if (loadedNested != nullptr)
+        {
+            TEST_VERIFY(loadedNested->GetInt32("int32") == -42);
+            TEST_VERIFY(loadedNested->GetString("string") == "nested");
+        }
+
+        // second archive goes right after the first one and shares keys table with it
+        ScopedPtr<KeyedArchive> loadedSecond(new KeyedArchive());
+        TEST_VERIFY(reader.ReadArchive(offset, loadedSecond));
+        TEST_VERIFY(loadedSecond->GetInt32("int32") == -42);
+        TEST_VERIFY(loadedSecond->GetString("string") == "nested");
+        TEST_VERIFY(offset == keysOffset);
+    }
+
+    DAVA_TEST (SaveLoadSceneTest)
+    {
+        FilePath scenePath = FileSystem::Instance()->GetCurrentDocumentsDirectory() + "FlatArchiveTest/scene.sc2";
+        FileSystem::Instance()->CreateDirectory(scenePath.GetDirectory(), true);
+
+        ScopedPtr<Scene> scene(new Scene());
+        for (uint32 i = 0; i < 3; ++i)
+        {
+            ScopedPtr<Entity> entity(new Entity());
+            entity->SetName(FastName(Format("entity%u", i)));
+            entity->SetLocalTransform(Matrix4::MakeTranslation(Vector3(float32(i), 0.f, 0.f)));
+
+            ScopedPtr<Entity> child(new Entity());
+            child->SetName(FastName(Format("child%u", i)));
+            entity->AddNode(child);
+
+            scene->AddNode(entity);
+        }
+
+        ScopedPtr<SceneFileV2> sceneFile(new SceneFileV2());
+        sceneFile->EnableFlatArchives(true);
+        TEST_VERIFY(sceneFile->SaveScene(scenePath, scene) == SceneFileV2::ERROR_NO_ERROR);
+        TEST_VERIFY(SceneFileV2::LoadSceneVersion(scenePath).version == FLAT_ARCHIVES_SCENE_VERSION);
+
+        ScopedPtr<Scene> loadedScene(new Scene());
+        TEST_VERIFY(loadedScene->LoadScene(scenePath) == SceneFileV2::ERROR_NO_ERROR);
+        TEST_VERIFY(loadedScene->GetChildrenCount() == scene->GetChildrenCount());
+
+        for (int32 i = 0; i < scene->GetChildrenCount(); ++i)
+        {
+            Entity* entity = scene->GetChild(i);
+            Entity* loadedEntity = loadedScene->FindByName(entity->GetName());
+            TEST_VERIFY(loadedEntity != nullptr);
+            if (loadedEntity != nullptr)
+            {
+                TEST_VERIFY(loadedEntity->GetLocalTransform() == entity->GetLocalTransform());
+                TEST_VERIFY(loadedEntity->GetChildrenCount() == 1);
+                TEST_VERIFY(loadedEntity->FindByName(entity->GetChild(0)->GetName()) != nullptr);
+            }
+        }
+
+        FileSystem::Instance()->DeleteDirectory(scenePath.GetDirectory());
+    }
+
+    DAVA_TEST (ReservedValuesTest)
+    {
+        // flat archives are read into values reserved in one block, they should behave like separately allocated ones
+        ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+        archive->SetString("existing", "value");
+        archive->ReserveValues(3);
+        archive->SetInt32("int", 1);
+        archive->SetString("string", "reserved string");
+        archive->SetMatrix4("matrix", Matrix4::MakeTranslation(Vector3(1.f, 2.f, 3.f)));
+        // no reserved values left, value is allocated separately
+        archive->SetFloat("float", 0.5f);
+
+        archive->DeleteKey("string");
+        archive->SetString("string", "new string");
+        archive->SetInt32("int", 2);
+
+        TEST_VERIFY(archive->Count() == 5);
+        TEST_VERIFY(archive->GetString("existing") == "value");
+        TEST_VERIFY(archive->GetInt32("int") == 2);
+        TEST_VERIFY(archive->GetString("string") == "new string");
+        TEST_VERIFY(archive->GetMatrix4("matrix") == Matrix4::MakeTranslation(Vector3(1.f, 2.f, 3.f)));
+        TEST_VERIFY(archive->GetFloat("float") == 0.5f);
+
+        ScopedPtr<KeyedArchive> copy(new KeyedArchive(*archive));
+        archive->DeleteAllKeys();
+        TEST_VERIFY(archive->Count() == 0);
+        TEST_VERIFY(copy->Count() == 5);
+        TEST_VERIFY(copy->GetString("string") == "new string");
+
+        archive->ReserveValues(2);
+        archive->SetString("string", "after clear");
+        TEST_VERIFY(archive->Count() == 1);
+        TEST_VERIFY(archive->GetString("string") == "after clear");
+
+        // values of several blocks and separately allocated ones are released and reused by new keys
+        for (int32 i = 0; i < 8; ++i)
+        {
+            archive->ReserveValues(1);
+            archive->SetInt32(Format("block%d", i), i);
+            archive->SetInt32(Format("separate%d", i), i);
+        }
+        for (int32 i = 0; i < 8; i += 2)
+        {
+            archive->DeleteKey(Format("block%d", i));
+            archive->DeleteKey(Format("separate%d", i));
+        }
+        for (int32 i = 0; i < 8; i += 2)
+        {
+            archive->SetInt32(Format("block%d", i), i * 10);
+        }
+        TEST_VERIFY(archive->Count() == 13);
+        TEST_VERIFY(archive->GetInt32("block2") == 20);
+        TEST_VERIFY(archive->GetInt32("block3") == 3);
+        TEST_VERIFY(archive->GetInt32("separate5") == 5);
+    }
+};
@@ -0,0 +1,216 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Base/ScopedPtr.h"
+#include "Render/3D/PolygonGroup.h"
+#include "Render/Highlevel/Camera.h"
+#include "Render/Highlevel/FlatRenderHierarchy.h"
+#include "Render/Highlevel/GeometryGenerator.h"
+#include "Render/Highlevel/RenderBatch.h"
+#include "Render/Highlevel/RenderObject.h"
+#include "Render/Highlevel/VisibilityQuadTree.h"
+
+#include <random>
+
+using namespace DAVA;
+
+namespace FlatRenderHierarchyTestDetails
+{
+// more objects than FlatRenderHierarchy clips in one job, so clipping is split between several jobs
+const uint32 OBJECTS_COUNT = 5000;
+const uint32 RAYS_COUNT = 500;
+const uint32 RANDOM_SEED = 42;
+const float32 WORLD_HALF_SIZE = 500.0f;
+const float32 WORLD_HEIGHT = 50.0f;
+
+/**
+    Same set of objects for each hierarchy: tree node index is stored in render object,
+    so one object can't be added to two hierarchies at once.
+    Both sets share transforms, so objects with equal index have equal boxes.
+*/
+struct ObjectSet
+{
+    Vector<RenderObject*> objects;
+    Map<RenderObject*, uint32> indices;
+
+    Vector<uint32> ToIndices(const Vector<RenderObject*>& found) const
+    {
+        Vector<uint32> result;
+        result.reserve(found.size());
+        for (RenderObject* object : found)
+        {
+            result.push_back(indices.at(object));
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+};
+
+void CreateObjects(ObjectSet& set, PolygonGroup* geometry, Vector<Matrix4>& transforms, const Vector<uint32>& flags)
+{
+    for (uint32 i = 0; i < OBJECTS_COUNT; ++i)
+    {
+        ScopedPtr<RenderBatch> batch(new RenderBatch());
+        batch->SetPolygonGroup(geometry);
+
+        RenderObject* object = new RenderObject();
+        object->AddRenderBatch(batch);
+        object->SetFlags(flags[i]);
+        object->SetWorldTransformPtr(&transforms[i]);
+
+        Matrix4 inverse;
+        transforms[i].GetInverse(inverse);
+        object->SetInverseTransform(inverse);
+        object->RecalculateWorldBoundingBox();
+
+        set.objects.push_back(object);
+        set.indices[object] = i;
+    }
+}
+
+void ReleaseObjects(ObjectSet& set)
+{
+    for (RenderObject* object : set.objects)
+    {
+        SafeRelease(object);
+    }
+    set.objects.clear();
+    set.indices.clear();
+}
+}
+
+DAVA_TESTCLASS (FlatRenderHierarchyTest)
+{
+    DAVA_TEST (ResultsMatchQuadTreeTest)
+    {
+        using namespace FlatRenderHierarchyTestDetails;
+
+        std::mt19937 generator(RANDOM_SEED);
+        std::uniform_real_distribution<float32> positionXY(-WORLD_HALF_SIZE, WORLD_HALF_SIZE);
+        std::uniform_real_distribution<float32> positionZ(0.0f, WORLD_HEIGHT);
+        std::uniform_real_distribution<float32> scale(0.5f, 8.0f);
+        std::uniform_int_distribution<uint32> flagsChoice(0, 15);
+
+        Vector<Matrix4> transforms(OBJECTS_COUNT);
+        Vector<uint32> flags(OBJECTS_COUNT);
+        for (uint32 i = 0; i < OBJECTS_COUNT; ++i)
+        {
+            Vector3 position(positionXY(generator), positionXY(generator), positionZ(generator));
+            Vector3 size(scale(generator), scale(generator), scale(generator));
+            transforms[i] = Matrix4::MakeScale(size) * Matrix4::MakeTranslation(position);
+
+            // some objects are always visible and some are hidden, both hierarchies should respect it
+            uint32 choice = flagsChoice(generator);
+            flags[i] = RenderObject::DEFAULT_RENDEROBJECT_FLAGS;
+            if (choice == 0)
+            {
+                flags[i] |= RenderObject::ALWAYS_CLIPPING_VISIBLE;
+            }
+            else if (choice == 1)
+            {
+                flags[i] &= ~RenderObject::VISIBLE;
+            }
+        }
+
+        PolygonGroup* geometry = GeometryGenerator::GenerateBox(AABBox3(Vector3(-0.5f, -0.5f, -0.5f), Vector3(0.5f, 0.5f, 0.5f)), Map<FastName, float32>());
+        geometry->GenerateGeometryOctTree();
+
+        ObjectSet quadTreeSet;
+        ObjectSet flatSet;
+        CreateObjects(quadTreeSet, geometry, transforms, flags);
+        CreateObjects(flatSet, geometry, transforms, flags);
+
+        QuadTree quadTree(10);
+        FlatRenderHierarchy flatHierarchy;
+        for (uint32 i = 0; i < OBJECTS_COUNT; ++i)
+        {
+            quadTree.AddRenderObject(quadTreeSet.objects[i]);
+            flatHierarchy.AddRenderObject(flatSet.objects[i]);
+        }
+        quadTree.Initialize();
+        flatHierarchy.Initialize();
+
+        // Clip
+        struct CameraSetup
+        {
+            Vector3 position;
+            Vector3 target;
+            float32 zFar;
+        };
+        const CameraSetup cameraSetups[] =
+        {
+          { Vector3(0.0f, -600.0f, 100.0f), Vector3(0.0f, 0.0f, 0.0f), 1500.0f },
+          { Vector3(0.0f, 0.0f, 20.0f), Vector3(100.0f, 100.0f, 0.0f), 300.0f },
+          { Vector3(-400.0f, 300.0f, 200.0f), Vector3(-300.0f, 200.0f, 0.0f), 200.0f },
+          { Vector3(0.0f, 0.0f, 1000.0f), Vector3(0.0f, 300.0f, 0.0f), 2000.0f },
+        };
+
+        ScopedPtr<Camera> camera(new Camera());
+        for (const CameraSetup& setup : cameraSetups)
+        {
+            camera->SetupPerspective(70.0f, 1.0f, 1.0f, setup.zFar);
+            camera->SetPosition(setup.position);
+            camera->SetTarget(setup.target);
+            camera->PrepareDynamicParameters(false);
+
+            Vector<RenderObject*> quadTreeVisible;
+            Vector<RenderObject*> flatVisible;
+            quadTree.Clip(camera, quadTreeVisible, RenderObject::CLIPPING_VISIBILITY_CRITERIA);
+            flatHierarchy.Clip(camera, flatVisible, RenderObject::CLIPPING_VISIBILITY_CRITERIA);
+
+            TEST_VERIFY(!flatVisible.empty());
+            TEST_VERIFY(quadTreeSet.ToIndices(quadTreeVisible) == flatSet.ToIndices(flatVisible));
+        }
+
+        // GetAllObjectsInBBox
+        const AABBox3 boxes[] =
+        {
+          AABBox3(Vector3(-WORLD_HALF_SIZE, -WORLD_HALF_SIZE, -10.0f), Vector3(WORLD_HALF_SIZE, WORLD_HALF_SIZE, WORLD_HEIGHT + 10.0f)),
+          AABBox3(Vector3(-50.0f, -50.0f, 0.0f), Vector3(50.0f, 50.0f, 10.0f)),
+          AABBox3(Vector3(100.0f, -300.0f, 20.0f), Vector3(350.0f, -100.0f, 30.0f)),
+          AABBox3(Vector3(-10.0f, -10.0f, 100.0f), Vector3(10.0f, 10.0f, 200.0f)),
+        };
+
+        for (const AABBox3& box : boxes)
+        {
+            Vector<RenderObject*> quadTreeFound;
+            Vector<RenderObject*> flatFound;
+            quadTree.GetAllObjectsInBBox(box, quadTreeFound);
+            flatHierarchy.GetAllObjectsInBBox(box, flatFound);
+
+            TEST_VERIFY(quadTreeSet.ToIndices(quadTreeFound) == flatSet.ToIndices(flatFound));
+        }
+
+        // RayTrace
+        std::uniform_real_distribution<float32> direction(-1.0f, 1.0f);
+        const Vector<RenderObject*> noIgnoredObjects;
+        uint32 hitsCount = 0;
+        for (uint32 i = 0; i < RAYS_COUNT; ++i)
+        {
+            Vector3 origin(positionXY(generator), positionXY(generator), WORLD_HEIGHT * 2.0f);
+            Vector3 rayDirection(direction(generator) * 0.3f, direction(generator) * 0.3f, -1.0f);
+            Ray3 ray(origin, rayDirection * 100.0f);
+
+            RayTraceCollision quadTreeCollision;
+            RayTraceCollision flatCollision;
+            bool quadTreeHit = quadTree.RayTrace(ray, quadTreeCollision, noIgnoredObjects);
+            bool flatHit = flatHierarchy.RayTrace(ray, flatCollision, noIgnoredObjects);
+
+            TEST_VERIFY(quadTreeHit == flatHit);
+            if (quadTreeHit && flatHit)
+            {
+                ++hitsCount;
+                TEST_VERIFY(quadTreeSet.indices.at(quadTreeCollision.renderObject) == flatSet.indices.at(flatCollision.renderObject));
+                TEST_VERIFY(quadTreeCollision.triangleIndex == flatCollision.triangleIndex);
+                TEST_VERIFY(FLOAT_EQUAL(quadTreeCollision.t, flatCollision.t));
+            }
+        }
+        TEST_VERIFY(hitsCount > 0);
+
+        quadTree.PrepareForShutdown();
+        flatHierarchy.PrepareForShutdown();
+
+        ReleaseObjects(quadTreeSet);
+        ReleaseObjects(flatSet);
+        SafeRelease(geometry);
+    }
+};
@@ -0,0 +1,210 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Engine/Engine.h"
+#include "Render/2D/GlyphAtlas.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (GlyphAtlasTest)
+{
+    const int32 faceA = 0;
+    const int32 faceB = 0;
+
+    std::unique_ptr<GlyphAtlas> framesAtlas; // atlas of test which is checked in next frames
+    uint32 startFrame = 0;
+    uint32 firstPage = 0;
+    uint32 secondPage = 0;
+    uint32 thirdPage = 0;
+
+    GlyphAtlas::Key MakeKey(const void* face, uint32 glyphIndex)
+    {
+        GlyphAtlas::Key key;
+        key.face = face;
+        key.size = 16 << 6;
+        key.glyphIndex = glyphIndex;
+        return key;
+    }
+
+    const GlyphAtlas::Glyph* AddGlyph(GlyphAtlas & atlas, const GlyphAtlas::Key& key, uint32 size, uint8 value)
+    {
+        Vector<uint8> bitmap(size * size, value);
+        return atlas.AddGlyph(key, bitmap.data(), size, size, size, 1, size);
+    }
+
+    DAVA_TEST (AddAndFindTest)
+    {
+        GlyphAtlas atlas(64, 2);
+
+        const GlyphAtlas::Glyph* added = AddGlyph(atlas, MakeKey(&faceA, 1), 10, 255);
+        TEST_VERIFY(added != nullptr);
+        TEST_VERIFY(added->rect.dx == 10 && added->rect.dy == 10);
+        TEST_VERIFY(added->left == 1 && added->top == 10);
+
+        const GlyphAtlas::Glyph* found = atlas.FindGlyph(MakeKey(&faceA, 1));
+        TEST_VERIFY(found == added);
+        TEST_VERIFY(atlas.FindGlyph(MakeKey(&faceA, 2)) == nullptr);
+        TEST_VERIFY(atlas.FindGlyph(MakeKey(&faceB, 1)) == nullptr);
+
+        GlyphAtlas::Key otherSize = MakeKey(&faceA, 1);
+        otherSize.size = 20 << 6;
+        TEST_VERIFY(atlas.FindGlyph(otherSize) == nullptr);
+
+        // glyphs without pixels are cached but don't use pages
+        TEST_VERIFY(atlas.AddGlyph(MakeKey(&faceA, 3), nullptr, 0, 0, 0, 0, 0) != nullptr);
+        TEST_VERIFY(atlas.GetPagesCount() == 1);
+        TEST_VERIFY(atlas.GetGlyphsCount() == 2);
+
+        // glyph bigger than page can't be cached
+        TEST_VERIFY(AddGlyph(atlas, MakeKey(&faceA, 4), 64, 255) == nullptr);
+
+        // page drawn in this frame isn't changed, new glyph is placed on other page
+        TEST_VERIFY(atlas.GetPageTexture(0) != nullptr);
+        const GlyphAtlas::Glyph* afterDraw = AddGlyph(atlas, MakeKey(&faceA, 5), 10, 255);
+        TEST_VERIFY(afterDraw != nullptr && afterDraw->page == 1);
+        TEST_VERIFY(atlas.GetPageGeneration(0) == 0);
+    }
+
+    DAVA_TEST (PackingTest)
+    {
+        const uint32 pageSize = 64;
+        const uint32 glyphSize = 7; // 8x8 with padding, so 64 glyphs fit into page
+        GlyphAtlas atlas(pageSize, 1);
+
+        Vector<Rect2i> rects;
+        for (uint32 i = 0; i < 64; ++i)
+        {
+            const GlyphAtlas::Glyph* glyph = AddGlyph(atlas, MakeKey(&faceA, i + 1), glyphSize, 255);
+            TEST_VERIFY(glyph != nullptr);
+            TEST_VERIFY(glyph->page == 0);
+            TEST_VERIFY(glyph->rect.x + glyph->rect.dx <= int32(pageSize) && glyph->rect.y + glyph->rect.dy <= int32(pageSize));
+            rects.push_back(glyph->rect);
+        }
+
+        for (size_t i = 0; i < rects.size(); ++i)
+        {
+            for (size_t j = i + 1; j < rects.size(); ++j)
+            {
+                TEST_VERIFY(!rects[i].RectIntersects(rects[j]));
+            }
+        }
+
+        TEST_VERIFY(atlas.GetPageGeneration(0) == 0);
+        TEST_VERIFY(atlas.GetGlyphsCount() == 64);
+    }
+
+    void FillSurplusPage()
+    {
+        // every glyph occupies whole page
+        framesAtlas.reset(new GlyphAtlas(16, 2));
+        GlyphAtlas& atlas = *framesAtlas;
+        startFrame = Engine::Instance()->GetGlobalFrameIndex();
+
+        const GlyphAtlas::Glyph* first = AddGlyph(atlas, MakeKey(&faceA, 1), 15, 1);
+        const GlyphAtlas::Glyph* second = AddGlyph(atlas, MakeKey(&faceA, 2), 15, 2);
+        TEST_VERIFY(first != nullptr && second != nullptr);
+        TEST_VERIFY(first->page != second->page);
+        firstPage = first->page;
+        secondPage = second->page;
+
+        // pages used in this frame are not evicted, atlas grows instead
+        const GlyphAtlas::Glyph* third = AddGlyph(atlas, MakeKey(&faceA, 3), 15, 3);
+        TEST_VERIFY(third != nullptr);
+        TEST_VERIFY(third->page != firstPage && third->page != secondPage);
+        thirdPage = third->page;
+        TEST_VERIFY(atlas.GetPagesCount() == 3);
+        TEST_VERIFY(atlas.GetPageGeneration(firstPage) == 0);
+        TEST_VERIFY(atlas.GetPageGeneration(secondPage) == 0);
+        TEST_VERIFY(atlas.FindGlyph(MakeKey(&faceA, 2)) != nullptr);
+    }
+
+    DAVA_TEST (EvictionTest)
+    {
+        FillSurplusPage();
+    }
+
+    DAVA_TEST (TrimTest)
+    {
+        FillSurplusPage();
+    }
+
+    bool TestComplete(const String& testName) const override
+    {
+        // eviction is checked in next frame, trimming - when pages are not used for a whole frame
+        uint32 passedFrames = Engine::Instance()->GetGlobalFrameIndex() - startFrame;
+        if (testName == "EvictionTest")
+        {
+            return passedFrames >= 1;
+        }
+        if (testName == "TrimTest")
+        {
+            return passedFrames >= 2;
+        }
+        return true;
+    }
+
+    void TearDown(const String& testName) override
+    {
+        if (testName == "EvictionTest")
+        {
+            GlyphAtlas& atlas = *framesAtlas;
+
+            // pages used in previous frame are not trimmed
+            // first and third pages become most recently used, so second one is evicted
+            TEST_VERIFY(atlas.FindGlyph(MakeKey(&faceA, 1)) != nullptr);
+            TEST_VERIFY(atlas.FindGlyph(MakeKey(&faceA, 3)) != nullptr);
+            TEST_VERIFY(atlas.GetPagesCount() == 3);
+
+            const GlyphAtlas::Glyph* fourth = AddGlyph(atlas, MakeKey(&faceA, 4), 15, 4);
+            TEST_VERIFY(fourth != nullptr);
+            TEST_VERIFY(fourth->page == secondPage);
+            TEST_VERIFY(atlas.GetPagesCount() == 3);
+            TEST_VERIFY(atlas.GetPageGeneration(secondPage) == 1);
+            TEST_VERIFY(atlas.GetPageGeneration(firstPage) == 0);
+
+            TEST_VERIFY(atlas.FindGlyph(MakeKey(&faceA, 1)) != nullptr);
+            TEST_VERIFY(atlas.FindGlyph(MakeKey(&faceA, 2)) == nullptr);
+            TEST_VERIFY(atlas.FindGlyph(MakeKey(&faceA, 4)) != nullptr);
+
+            framesAtlas.reset();
+        }
+        else if (testName == "TrimTest")
+        {
+            GlyphAtlas& atlas = *framesAtlas;
+
+            // surplus page is released on first access: first page is least recently used
+            TEST_VERIFY(atlas.FindGlyph(MakeKey(&faceA, 2)) != nullptr);
+            TEST_VERIFY(atlas.GetPagesCount() == 2);
+            TEST_VERIFY(atlas.GetPageGeneration(firstPage) == 1);
+            TEST_VERIFY(atlas.FindGlyph(MakeKey(&faceA, 1)) == nullptr);
+            TEST_VERIFY(atlas.FindGlyph(MakeKey(&faceA, 3)) != nullptr);
+
+            // released page is reused when atlas has to grow again
+            const GlyphAtlas::Glyph* fourth = AddGlyph(atlas, MakeKey(&faceA, 4), 15, 4);
+            TEST_VERIFY(fourth != nullptr);
+            TEST_VERIFY(fourth->page == firstPage);
+            TEST_VERIFY(atlas.GetPagesCount() == 3);
+            TEST_VERIFY(atlas.GetPageGeneration(firstPage) == 1);
+            TEST_VERIFY(atlas.GetPageGeneration(secondPage) == 0);
+            TEST_VERIFY(atlas.GetPageGeneration(thirdPage) == 0);
+
+            framesAtlas.reset();
+        }
+    }
+
+    DAVA_TEST (RemoveGlyphsTest)
+    {
+        GlyphAtlas atlas(64, 1);
+
+        AddGlyph(atlas, MakeKey(&faceA, 1), 8, 255);
+        AddGlyph(atlas, MakeKey(&faceB, 1), 8, 255);
+        TEST_VERIFY(atlas.GetGlyphsCount() == 2);
+
+        atlas.RemoveGlyphs(&faceA);
+        TEST_VERIFY(atlas.FindGlyph(MakeKey(&faceA, 1)) == nullptr);
+        TEST_VERIFY(atlas.FindGlyph(MakeKey(&faceB, 1)) != nullptr);
+
+        atlas.Clear();
+        TEST_VERIFY(atlas.GetGlyphsCount() == 0);
+        TEST_VERIFY(atlas.GetPageGeneration(0) == 1);
+    }
+};
@@ -1,6 +1,8 @@
 #include "DAVAEngine.h"
 #include "UnitTests/UnitTests.h"
 
+#include "Concurrency/ManualResetEvent.h"
+
 using namespace DAVA;
 
 #define JOBS_COUNT 500
@@ -83,8 +85,117 @@ DAVA_TESTCLASS (JobManagerTest)
 
     DAVA_TEST (TestWorkerJobs)
     {
-        // TODO:
-        // ...
+        JobManager* jobManager = GetEngineContext()->jobManager;
+
+        Atomic<uint32> counter(0);
+        for (uint32 i = 0; i < JOBS_COUNT; ++i)
+        {
+            jobManager->CreateWorkerJob([&counter]() { counter++; });
+        }
+        jobManager->WaitWorkerJobs();
+
+        TEST_VERIFY(counter == JOBS_COUNT);
+        TEST_VERIFY(!jobManager->HasWorkerJobs());
+    }
+
+    DAVA_TEST (TestWorkerJobDependencies)
+    {
+        JobManager* jobManager = GetEngineContext()->jobManager;
+
+        Atomic<uint32> order(0);
+        uint32 firstOrder = 0;
+        uint32 childOrder = 0;
+        uint32 lastOrder = 0;
+
+        // parent can't finish before child is attached to it
+        ManualResetEvent childCreated(false);
+
+        JobHandle first = jobManager->CreateWorkerJob([&]() { firstOrder = ++order; });
+        JobHandle parent = jobManager->CreateWorkerJob([&]() { childCreated.Wait(); });
+        jobManager->CreateChildWorkerJob(parent, [&]() { childOrder = ++order; });
+        childCreated.Signal();
+
+        JobHandle last = jobManager->CreateDependentWorkerJob({ first, parent }, [&]() { lastOrder = ++order; });
+
+        jobManager->WaitWorkerJob(last);
+
+        TEST_VERIFY(first.IsDone());
+        TEST_VERIFY(parent.IsDone());
+        TEST_VERIFY(firstOrder != 0 && childOrder != 0);
+        TEST_VERIFY(firstOrder < lastOrder && childOrder < lastOrder);
+        TEST_VERIFY(lastOrder == 3);
+    }
+
+    DAVA_TEST (TestWaitWorkerJobsFromJob)
+    {
+        JobManager* jobManager = GetEngineContext()->jobManager;
+
+        Atomic<uint32> counter(0);
+        JobHandle outer = jobManager->CreateWorkerJob([&]() {
+            for (uint32 i = 0; i < JOBS_COUNT; ++i)
+            {
+                jobManager->CreateWorkerJob([&counter]() { counter++; });
+            }
+            // must not wait for the calling job itself
+            jobManager->WaitWorkerJobs();
+        });
+
+        jobManager->WaitWorkerJob(outer);
+        jobManager->WaitWorkerJobs();
+
+        TEST_VERIFY(counter == JOBS_COUNT);
+        TEST_VERIFY(!jobManager->HasWorkerJobs());
+    }
+
+    DAVA_TEST (TestParallelFor)
+    {
+        const uint32 count = 100000;
+        Vector<uint32> values(count, 0);
+
+        GetEngineContext()->jobManager->ParallelFor(0, count, 64, [&values](uint32 begin, uint32 end) {
+            for (uint32 i = begin; i < end; ++i)
+            {
+                values[i] += i;
+            }
+        });
+
+        bool allProcessedOnce = true;
+        for (uint32 i = 0; i < count; ++i)
+        {
+            allProcessedOnce = allProcessedOnce && (values[i] == i);
+        }
+        TEST_VERIFY(allProcessedOnce);
+    }
+
+    DAVA_TEST (TestWaitDoesntExecuteForeignJobs)
+    {
+        JobManager* jobManager = GetEngineContext()->jobManager;
+
+        Atomic<bool> waiting(false);
+        Atomic<uint32> foreignOnWaitingThread(0);
+        for (uint32 i = 0; i < JOBS_COUNT; ++i)
+        {
+            jobManager->CreateWorkerJob([&]() {
+                if (waiting && Thread::IsMainThread())
+                {
+                    foreignOnWaitingThread++;
+                }
+                Thread::Sleep(1);
+            });
+        }
+
+        Atomic<uint32> counter(0);
+        JobHandle waited = jobManager->CreateWorkerJob([&]() {
+            jobManager->ParallelFor(0, JOBS_COUNT, 1, [&counter](uint32 begin, uint32 end) { counter += end - begin; });
+        });
+
+        waiting = true;
+        jobManager->WaitWorkerJob(waited);
+        waiting = false;
+        jobManager->WaitWorkerJobs();
+
+        TEST_VERIFY(counter == JOBS_COUNT);
+        TEST_VERIFY(foreignOnWaitingThread == 0);
     }
 
     void ThreadFunc(JobManagerTestData * data)
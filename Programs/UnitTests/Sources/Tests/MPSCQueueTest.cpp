@@ -0,0 +1,111 @@
+#include "Concurrency/MPSCQueue.h"
+#include "Concurrency/Thread.h"
+#include "Utils/StringFormat.h"
+#include "UnitTests/UnitTests.h"
+
+#include <atomic>
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (MPSCQueueTest)
+{
+    DAVA_TEST (ElementsOrderTest)
+    {
+        MPSCQueue<uint32> queue;
+        TEST_VERIFY(queue.IsEmpty());
+
+        for (uint32 i = 0; i < 10; ++i)
+        {
+            queue.Push(i);
+        }
+        TEST_VERIFY(!queue.IsEmpty());
+
+        Vector<uint32> output = { 100 };
+        TEST_VERIFY(queue.PopAll(output) == 10);
+        TEST_VERIFY(queue.IsEmpty());
+        TEST_VERIFY(output.size() == 11);
+        TEST_VERIFY(output[0] == 100);
+        for (uint32 i = 0; i < 10; ++i)
+        {
+            TEST_VERIFY(output[i + 1] == i);
+        }
+    }
+
+    DAVA_TEST (NodesReuseTest)
+    {
+        // more elements in flight than pooled nodes, so queue also uses nodes allocated one by one
+        const uint32 elementsCount = 70000;
+
+        MPSCQueue<String> queue;
+        for (uint32 pass = 0; pass < 3; ++pass)
+        {
+            for (uint32 i = 0; i < elementsCount; ++i)
+            {
+                queue.Push(Format("%u", i));
+            }
+
+            Vector<String> output;
+            TEST_VERIFY(queue.PopAll(output) == elementsCount);
+            TEST_VERIFY(queue.IsEmpty());
+
+            bool orderIsValid = (output.size() == elementsCount);
+            for (uint32 i = 0; i < elementsCount && orderIsValid; ++i)
+            {
+                orderIsValid = (output[i] == Format("%u", i));
+            }
+            TEST_VERIFY(orderIsValid);
+        }
+
+        // elements left in queue are destroyed with it
+        queue.Push(String(256, 'x'));
+    }
+
+    DAVA_TEST (MultipleProducersTest)
+    {
+        const uint32 producersCount = 4;
+        const uint32 elementsPerProducer = 100000;
+
+        // element is (producer index, sequence number)
+        MPSCQueue<std::pair<uint32, uint32>> queue;
+        std::atomic<uint32> finishedProducers(0);
+
+        Vector<Thread*> threads;
+        for (uint32 p = 0; p < producersCount; ++p)
+        {
+            threads.push_back(Thread::Create([&queue, &finishedProducers, p, elementsPerProducer]() {
+                for (uint32 i = 0; i < elementsPerProducer; ++i)
+                {
+                    queue.Push(std::make_pair(p, i));
+                }
+                ++finishedProducers;
+            }));
+            threads.back()->Start();
+        }
+
+        Vector<uint32> expectedSequence(producersCount, 0);
+        Vector<std::pair<uint32, uint32>> output;
+        bool orderIsValid = true;
+        uint32 received = 0;
+        while (received < producersCount * elementsPerProducer)
+        {
+            output.clear();
+            queue.PopAll(output);
+            for (const std::pair<uint32, uint32>& e : output)
+            {
+                orderIsValid = orderIsValid && (e.second == expectedSequence[e.first]);
+                expectedSequence[e.first] = e.second + 1;
+            }
+            received += static_cast<uint32>(output.size());
+        }
+
+        for (Thread* thread : threads)
+        {
+            thread->Join();
+            SafeRelease(thread);
+        }
+
+        TEST_VERIFY(orderIsValid);
+        TEST_VERIFY(finishedProducers == producersCount);
+        TEST_VERIFY(queue.IsEmpty());
+    }
+};
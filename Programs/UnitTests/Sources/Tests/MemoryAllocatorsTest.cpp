@@ -1,5 +1,6 @@
 #include "DAVAEngine.h"
 #include "UnitTests/UnitTests.h"
+#include "Base/FrameArena.h"
 
 using namespace DAVA;
 
@@ -73,5 +74,67 @@ DAVA_TESTCLASS (MemoryAllocatorsTest)
         ObjectWithNDOverload* object2 = new ObjectWithNDOverload;
         SafeDelete(object2);
     }
+
+    DAVA_TEST (FrameArenaAllocationTest)
+    {
+        FrameArena arena(2, 1024);
+        uint32 frameIndex = arena.GetFrameIndex();
+
+        uint8* first = static_cast<uint8*>(arena.Allocate(10, 1));
+        uint8* second = static_cast<uint8*>(arena.Allocate(16, 16));
+        TEST_VERIFY(second >= first + 10);
+        TEST_VERIFY(reinterpret_cast<uintptr_t>(second) % 16 == 0);
+
+        // allocations which don't fit into chunk take new chunks
+        void* big = arena.Allocate(4096, 64);
+        TEST_VERIFY(big != nullptr);
+        TEST_VERIFY(reinterpret_cast<uintptr_t>(big) % 64 == 0);
+        for (uint32 i = 0; i < 100; ++i)
+        {
+            TEST_VERIFY(arena.Allocate(100) != nullptr);
+        }
+        size_t usedSize = arena.GetUsedSize();
+        TEST_VERIFY(usedSize >= 10 + 16 + 4096 + 100 * 100);
+
+        // second buffer doesn't touch memory of the first one
+        arena.BeginFrame();
+        TEST_VERIFY(arena.GetUsedSize() == 0);
+        uint8* otherFrame = static_cast<uint8*>(arena.Allocate(10, 1));
+        TEST_VERIFY(otherFrame != first);
+
+        // first buffer is reused with chunks merged into one
+        arena.BeginFrame();
+        size_t reservedSize = arena.GetReservedSize();
+        for (uint32 i = 0; i < 100; ++i)
+        {
+            arena.Allocate(100);
+        }
+        TEST_VERIFY(arena.GetReservedSize() == reservedSize);
+        TEST_VERIFY(arena.GetHighWaterMark() == usedSize);
+        TEST_VERIFY(arena.GetFrameIndex() == frameIndex + 2);
+    }
+
+    DAVA_TEST (FrameArenaAllocatorTest)
+    {
+        FrameArena arena(1, 256);
+
+        FrameVector<uint32> values{ FrameArenaAllocator<uint32>(&arena) };
+        for (uint32 i = 0; i < 1000; ++i)
+        {
+            values.push_back(i);
+        }
+        for (uint32 i = 0; i < 1000; ++i)
+        {
+            TEST_VERIFY(values[i] == i);
+        }
+
+        FrameVector<uint32> copy(values);
+        TEST_VERIFY(copy == values);
+        TEST_VERIFY(copy.get_allocator() == values.get_allocator());
+        TEST_VERIFY(arena.GetUsedSize() >= 2 * 1000 * sizeof(uint32));
+
+        FrameArenaAllocator<float64> rebound(values.get_allocator());
+        TEST_VERIFY(rebound.GetArena() == &arena);
+    }
 }
 ;
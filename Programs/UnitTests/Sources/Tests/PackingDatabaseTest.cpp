@@ -0,0 +1,173 @@
+#include <DAVAEngine.h>
+#include <UnitTests/UnitTests.h>
+
+#if defined(__DAVAENGINE_WIN32__) || defined(__DAVAENGINE_MACOS__)
+
+#include <TexturePacker/PackingDatabase.h>
+
+#include <Engine/EngineContext.h>
+#include <FileSystem/FileSystem.h>
+
+#include <ctime>
+
+DAVA_TESTCLASS (PackingDatabaseTest)
+{
+    const DAVA::FilePath rootDir = "~doc:/TestData/PackingDatabaseTest/";
+    const DAVA::FilePath inputDir = rootDir + "Input/";
+    const DAVA::FilePath databasePath = rootDir + "files.db";
+
+    DAVA::PackingDatabase skipDatabase;
+    time_t skipWriteTime = 0;
+
+    void WriteFile(const DAVA::String& name, const DAVA::String& content)
+    {
+        DAVA::ScopedPtr<DAVA::File> file(DAVA::File::Create(inputDir + name, DAVA::File::CREATE | DAVA::File::WRITE));
+        TEST_VERIFY(file);
+        file->WriteNonTerminatedString(content);
+    }
+
+    DAVA_TEST (ScanTest)
+    {
+        using namespace DAVA;
+
+        DAVA::GetEngineContext()->fileSystem->DeleteDirectory(rootDir, true);
+        TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->CreateDirectory(inputDir, true) != FileSystem::DIRECTORY_CANT_CREATE);
+        WriteFile("a.png", "first");
+        WriteFile("b.psd", "second");
+
+        PackingDatabase database;
+        TEST_VERIFY(database.Load(databasePath) == false);
+
+        Set<String> changedFiles;
+        Vector<PackingDatabase::FileInfo> removedFiles;
+        MD5::MD5Digest digest = database.Scan(inputDir, changedFiles, removedFiles);
+
+        MD5::MD5Digest dirDigest;
+        MD5::ForDirectory(inputDir, dirDigest, false, false);
+        TEST_VERIFY(digest == dirDigest);
+        TEST_VERIFY(changedFiles == Set<String>({ "a.png", "b.psd" }));
+        TEST_VERIFY(removedFiles.empty());
+        TEST_VERIFY(database.GetHashedFilesCount() == 2);
+
+        database.SetOutputs("b.psd", { "b.txt" }, { "b0" });
+        database.SetOutputsKnown(true);
+        TEST_VERIFY(database.Save(databasePath) == true);
+
+        PackingDatabase loadedDatabase;
+        TEST_VERIFY(loadedDatabase.Load(databasePath) == true);
+        TEST_VERIFY(loadedDatabase.AreOutputsKnown() == true);
+        const PackingDatabase::FileInfo* info = loadedDatabase.GetFileInfo("b.psd");
+        TEST_VERIFY(info != nullptr);
+        TEST_VERIFY(info->outputFiles == Vector<String>({ "b.txt" }));
+        TEST_VERIFY(info->outputTextures == Vector<String>({ "b0" }));
+
+        // unchanged content is not reported even if file is hashed again
+        changedFiles.clear();
+        TEST_VERIFY(loadedDatabase.Scan(inputDir, changedFiles, removedFiles) == dirDigest);
+        TEST_VERIFY(changedFiles.empty());
+
+        WriteFile("a.png", "changed");
+        TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->DeleteFile(inputDir + "b.psd") == true);
+
+        changedFiles.clear();
+        digest = loadedDatabase.Scan(inputDir, changedFiles, removedFiles);
+        MD5::ForDirectory(inputDir, dirDigest, false, false);
+        TEST_VERIFY(digest == dirDigest);
+        TEST_VERIFY(changedFiles == Set<String>({ "a.png" }));
+        TEST_VERIFY(removedFiles.size() == 1);
+        TEST_VERIFY(removedFiles.front().outputTextures == Vector<String>({ "b0" }));
+        TEST_VERIFY(loadedDatabase.GetFileInfo("b.psd") == nullptr);
+
+        loadedDatabase.ResetOutputs();
+        TEST_VERIFY(loadedDatabase.AreOutputsKnown() == false);
+    };
+
+    DAVA_TEST (RecursiveScanTest)
+    {
+        using namespace DAVA;
+
+        DAVA::GetEngineContext()->fileSystem->DeleteDirectory(rootDir, true);
+        TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->CreateDirectory(inputDir + "sub/inner/", true) != FileSystem::DIRECTORY_CANT_CREATE);
+        WriteFile("a.png", "first");
+        WriteFile("sub/b.psd", "second");
+        WriteFile("sub/inner/c.txt", "third");
+
+        PackingDatabase database;
+        Set<String> changedFiles;
+        Vector<PackingDatabase::FileInfo> removedFiles;
+        MD5::MD5Digest digest = database.Scan(inputDir, changedFiles, removedFiles, true);
+
+        MD5::MD5Digest dirDigest;
+        MD5::ForDirectory(inputDir, dirDigest, true, false);
+        TEST_VERIFY(digest == dirDigest);
+        TEST_VERIFY(changedFiles == Set<String>({ "a.png", "sub/b.psd", "sub/inner/c.txt" }));
+
+        TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->DeleteFile(inputDir + "sub/inner/c.txt") == true);
+        changedFiles.clear();
+        digest = database.Scan(inputDir, changedFiles, removedFiles, true);
+        MD5::ForDirectory(inputDir, dirDigest, true, false);
+        TEST_VERIFY(digest == dirDigest);
+        TEST_VERIFY(changedFiles.empty());
+        TEST_VERIFY(removedFiles.size() == 1);
+        TEST_VERIFY(database.GetFileInfo("sub/inner/c.txt") == nullptr);
+    };
+
+    DAVA_TEST (SkipUnchangedFilesTest)
+    {
+        using namespace DAVA;
+
+        DAVA::GetEngineContext()->fileSystem->DeleteDirectory(rootDir, true);
+        TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->CreateDirectory(inputDir, true) != FileSystem::DIRECTORY_CANT_CREATE);
+        WriteFile("a.png", "first");
+        WriteFile("b.psd", "second");
+        skipWriteTime = time(nullptr);
+
+        Set<String> changedFiles;
+        Vector<PackingDatabase::FileInfo> removedFiles;
+        skipDatabase.Scan(inputDir, changedFiles, removedFiles);
+        TEST_VERIFY(skipDatabase.GetHashedFilesCount() == 2);
+    };
+
+    bool TestComplete(const DAVA::String& testName) const override
+    {
+        // dates of files written during current second aren't stored, so scan is repeated after that second
+        return testName != "SkipUnchangedFilesTest" || time(nullptr) > skipWriteTime + 1;
+    }
+
+    void TearDown(const DAVA::String& testName) override
+    {
+        using namespace DAVA;
+
+        if (testName != "SkipUnchangedFilesTest")
+        {
+            return;
+        }
+
+        Set<String> changedFiles;
+        Vector<PackingDatabase::FileInfo> removedFiles;
+        MD5::MD5Digest dirDigest;
+        MD5::ForDirectory(inputDir, dirDigest, false, false);
+
+        // files are hashed once more to store their dates
+        TEST_VERIFY(skipDatabase.Scan(inputDir, changedFiles, removedFiles) == dirDigest);
+        TEST_VERIFY(skipDatabase.GetHashedFilesCount() == 2);
+        TEST_VERIFY(changedFiles.empty());
+
+        TEST_VERIFY(skipDatabase.Save(databasePath) == true);
+        PackingDatabase loadedDatabase;
+        TEST_VERIFY(loadedDatabase.Load(databasePath) == true);
+
+        // files with same size and date are not hashed
+        TEST_VERIFY(loadedDatabase.Scan(inputDir, changedFiles, removedFiles) == dirDigest);
+        TEST_VERIFY(loadedDatabase.GetHashedFilesCount() == 0);
+        TEST_VERIFY(changedFiles.empty());
+
+        WriteFile("a.png", "changed content");
+        MD5::ForDirectory(inputDir, dirDigest, false, false);
+        TEST_VERIFY(loadedDatabase.Scan(inputDir, changedFiles, removedFiles) == dirDigest);
+        TEST_VERIFY(loadedDatabase.GetHashedFilesCount() == 1);
+        TEST_VERIFY(changedFiles == Set<String>({ "a.png" }));
+    }
+};
+
+#endif
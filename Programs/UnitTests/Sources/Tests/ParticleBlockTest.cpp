@@ -0,0 +1,145 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Particles/ParticleBlock.h"
+
+using namespace DAVA;
+
+namespace ParticleBlockTestDetails
+{
+// odd number of particles to check both vectorized and scalar tail of passes
+const uint32 PARTICLES_COUNT = 11;
+
+void FillBlock(ParticleBlock& particles)
+{
+    for (uint32 i = 0; i < PARTICLES_COUNT; ++i)
+    {
+        uint32 index = particles.Add();
+        float32 value = static_cast<float32>(i);
+        particles.SetPosition(index, Vector3(value, -value, value * 0.5f));
+        particles.SetSpeed(index, Vector3(1.0f, value, -2.0f * value));
+        particles.lifeTime[index] = value + 0.5f;
+        particles.currRadius[index] = value * 0.1f;
+        particles.attributes[index].randomSeed = i;
+    }
+}
+}
+
+DAVA_TESTCLASS (ParticleBlockTest)
+{
+    DAVA_TEST (AddRemoveTest)
+    {
+        using namespace ParticleBlockTestDetails;
+
+        ParticleBlock particles;
+        TEST_VERIFY(particles.IsEmpty());
+
+        FillBlock(particles);
+        TEST_VERIFY(particles.GetSize() == PARTICLES_COUNT);
+
+        // last particle takes place of removed one
+        particles.Remove(2);
+        TEST_VERIFY(particles.GetSize() == PARTICLES_COUNT - 1);
+        TEST_VERIFY(particles.attributes[2].randomSeed == PARTICLES_COUNT - 1);
+        TEST_VERIFY(particles.GetPosition(2) == Vector3(10.0f, -10.0f, 5.0f));
+        TEST_VERIFY(particles.lifeTime[2] == 10.5f);
+
+        particles.Remove(particles.GetSize() - 1);
+        TEST_VERIFY(particles.GetSize() == PARTICLES_COUNT - 2);
+        TEST_VERIFY(particles.attributes.size() == particles.positionX.size() && particles.color.size() == particles.speedZ.size());
+
+        particles.Shrink(3);
+        TEST_VERIFY(particles.GetSize() == 3);
+
+        particles.Clear();
+        TEST_VERIFY(particles.IsEmpty());
+    }
+
+    DAVA_TEST (UpdateLifeTest)
+    {
+        using namespace ParticleBlockTestDetails;
+
+        ParticleBlock particles;
+        FillBlock(particles);
+
+        // particles with lifeTime 0.5, 1.5 and 2.5 are over
+        particles.UpdateLife(3.0f);
+        TEST_VERIFY(particles.GetSize() == PARTICLES_COUNT - 3);
+        for (uint32 i = 0; i < particles.GetSize(); ++i)
+        {
+            TEST_VERIFY(particles.life[i] == 3.0f);
+            TEST_VERIFY(particles.attributes[i].randomSeed >= 3);
+        }
+    }
+
+    DAVA_TEST (IntegrationTest)
+    {
+        using namespace ParticleBlockTestDetails;
+
+        ParticleBlock particles;
+        FillBlock(particles);
+
+        const float32 dt = 0.25f;
+        Vector<float32> velocityScale(PARTICLES_COUNT);
+        Vector<float32> accelerationX(PARTICLES_COUNT, 1.0f);
+        Vector<float32> accelerationY(PARTICLES_COUNT, 0.0f);
+        Vector<float32> accelerationZ(PARTICLES_COUNT);
+        for (uint32 i = 0; i < PARTICLES_COUNT; ++i)
+        {
+            velocityScale[i] = 1.0f + i * 0.5f;
+            accelerationZ[i] = -static_cast<float32>(i);
+        }
+
+        Vector<Vector3> expectedPositions(PARTICLES_COUNT);
+        Vector<Vector3> expectedSpeeds(PARTICLES_COUNT);
+        for (uint32 i = 0; i < PARTICLES_COUNT; ++i)
+        {
+            expectedPositions[i] = particles.GetPosition(i) + particles.GetSpeed(i) * (velocityScale[i] * dt);
+            expectedSpeeds[i] = particles.GetSpeed(i) + Vector3(accelerationX[i], accelerationY[i], accelerationZ[i]) * dt;
+        }
+
+        Vector<float32> prevX(PARTICLES_COUNT);
+        Vector<float32> prevY(PARTICLES_COUNT);
+        Vector<float32> prevZ(PARTICLES_COUNT);
+        Vector<float32> initialX = particles.positionX;
+        particles.IntegratePositions(dt, velocityScale.data(), prevX.data(), prevY.data(), prevZ.data());
+        particles.IntegrateSpeeds(dt, accelerationX.data(), accelerationY.data(), accelerationZ.data());
+
+        TEST_VERIFY(prevX == initialX);
+        for (uint32 i = 0; i < PARTICLES_COUNT; ++i)
+        {
+            TEST_VERIFY(FLOAT_EQUAL(particles.positionX[i], expectedPositions[i].x));
+            TEST_VERIFY(FLOAT_EQUAL(particles.positionY[i], expectedPositions[i].y));
+            TEST_VERIFY(FLOAT_EQUAL(particles.positionZ[i], expectedPositions[i].z));
+            TEST_VERIFY(FLOAT_EQUAL(particles.speedX[i], expectedSpeeds[i].x));
+            TEST_VERIFY(FLOAT_EQUAL(particles.speedY[i], expectedSpeeds[i].y));
+            TEST_VERIFY(FLOAT_EQUAL(particles.speedZ[i], expectedSpeeds[i].z));
+        }
+    }
+
+    DAVA_TEST (BBoxTest)
+    {
+        using namespace ParticleBlockTestDetails;
+
+        ParticleBlock particles;
+        FillBlock(particles);
+
+        Vector3 offset(1.0f, 2.0f, 3.0f);
+        AABBox3 expected;
+        for (uint32 i = 0; i < PARTICLES_COUNT; ++i)
+        {
+            Vector3 radius(particles.currRadius[i], particles.currRadius[i], particles.currRadius[i]);
+            expected.AddPoint(particles.GetPosition(i) + offset - radius);
+            expected.AddPoint(particles.GetPosition(i) + offset + radius);
+        }
+
+        AABBox3 bbox;
+        particles.AddToBBox(offset, bbox);
+        TEST_VERIFY(bbox == expected);
+
+        // empty block doesn't change box
+        ParticleBlock empty;
+        AABBox3 emptyBox;
+        empty.AddToBBox(offset, emptyBox);
+        TEST_VERIFY(emptyBox.IsEmpty());
+    }
+};
@@ -0,0 +1,90 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Base/ScopedPtr.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Particles/ParticleEmitter.h"
+#include "Particles/ParticleEmitterInstance.h"
+#include "Scene3D/Components/ParticleEffectComponent.h"
+#include "Scene3D/Entity.h"
+#include "Scene3D/Scene.h"
+#include "Utils/Random.h"
+
+using namespace DAVA;
+
+namespace ParticleEffectSystemTestDetails
+{
+// more effects than one job takes, so effects are updated by several jobs at once
+const uint32 EFFECTS_COUNT = 16;
+const uint32 FRAMES_COUNT = 90;
+const float32 FRAME_TIME = 1.0f / 30.0f;
+const uint32 RANDOM_SEED = 42;
+
+struct EffectState
+{
+    AABBox3 bbox;
+    int32 particlesCount = 0;
+};
+
+/**
+    Simulate effects made from one emitter file with different playback speeds,
+    so effects updated at the same time evaluate shared property lines at different times.
+*/
+Vector<EffectState> SimulateSharedEmitterEffects()
+{
+    GetEngineContext()->random->Seed(RANDOM_SEED);
+
+    const FilePath emitterPath = "~res:/TestData/ParticleEffectSystemTest/shared_emitter.yaml";
+    ScopedPtr<Scene> scene(new Scene());
+    Vector<ParticleEffectComponent*> effects;
+    ParticleEmitter* sharedEmitter = nullptr;
+    for (uint32 i = 0; i < EFFECTS_COUNT; ++i)
+    {
+        ScopedPtr<ParticleEmitter> emitter(ParticleEmitter::LoadEmitter(emitterPath));
+        sharedEmitter = (sharedEmitter != nullptr) ? sharedEmitter : emitter.get();
+        TEST_VERIFY(emitter.get() == sharedEmitter);
+
+        ParticleEffectComponent* effect = new ParticleEffectComponent();
+        effect->AddEmitterInstance(emitter);
+        effect->SetPlaybackSpeed(0.5f + 0.1f * static_cast<float32>(i));
+        effects.push_back(effect);
+
+        ScopedPtr<Entity> entity(new Entity());
+        entity->AddComponent(effect);
+        scene->AddNode(entity);
+        effect->Start();
+    }
+
+    for (uint32 frame = 0; frame < FRAMES_COUNT; ++frame)
+    {
+        scene->Update(FRAME_TIME);
+    }
+
+    Vector<EffectState> states(EFFECTS_COUNT);
+    for (uint32 i = 0; i < EFFECTS_COUNT; ++i)
+    {
+        TEST_VERIFY(effects[i]->GetEmitterInstance(0)->GetEmitter() == sharedEmitter);
+        states[i].bbox = effects[i]->GetRenderObject()->GetBoundingBox();
+        states[i].particlesCount = effects[i]->GetActiveParticlesCount();
+    }
+    return states;
+}
+}
+
+DAVA_TESTCLASS (ParticleEffectSystemTest)
+{
+    DAVA_TEST (SharedEmitterTest)
+    {
+        using namespace ParticleEffectSystemTestDetails;
+
+        // effects sharing cached emitter are updated in parallel, result should not depend on job scheduling
+        Vector<EffectState> firstRun = SimulateSharedEmitterEffects();
+        Vector<EffectState> secondRun = SimulateSharedEmitterEffects();
+        for (uint32 i = 0; i < EFFECTS_COUNT; ++i)
+        {
+            TEST_VERIFY(firstRun[i].particlesCount > 0);
+            TEST_VERIFY(firstRun[i].particlesCount == secondRun[i].particlesCount);
+            TEST_VERIFY(firstRun[i].bbox == secondRun[i].bbox);
+        }
+    }
+};
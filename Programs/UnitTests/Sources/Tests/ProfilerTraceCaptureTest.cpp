@@ -0,0 +1,193 @@
+#include "UnitTests/UnitTests.h"
+#include <Concurrency/Thread.h>
+#include <Debug/ProfilerCPU.h>
+#include <Debug/ProfilerTraceCapture.h>
+#include <FileSystem/File.h>
+#include <FileSystem/FileSystem.h>
+
+using namespace DAVA;
+
+namespace ProfilerTraceCaptureTestDetails
+{
+const char* FRAME_MARKER = "ProfilerTraceCaptureTest::Frame";
+const char* INNER_MARKER = "ProfilerTraceCaptureTest::Inner";
+const char* WORKER_MARKER = "ProfilerTraceCaptureTest::Worker";
+
+const uint32 FRAMES_COUNT = 200;
+const uint32 WORKER_COUNTERS_COUNT = 100;
+
+// ring array of profiler is smaller than number of counters, capture should not lose any of them
+void ProfileFrames(ProfilerCPU* profiler, ProfilerTraceCapture& capture)
+{
+    for (uint32 frame = 1; frame <= FRAMES_COUNT; ++frame)
+    {
+        DAVA_PROFILER_CPU_SCOPE_CUSTOM_WITH_FRAME_INDEX(FRAME_MARKER, profiler, frame);
+        {
+            DAVA_PROFILER_CPU_SCOPE_CUSTOM(INNER_MARKER, profiler);
+        }
+
+        if (frame % 50 == 0)
+        {
+            capture.Flush();
+        }
+    }
+
+    Thread* thread = Thread::Create([profiler]() {
+        for (uint32 i = 0; i < WORKER_COUNTERS_COUNT; ++i)
+        {
+            DAVA_PROFILER_CPU_SCOPE_CUSTOM(WORKER_MARKER, profiler);
+        }
+    });
+    thread->Start();
+    thread->Join();
+    SafeRelease(thread);
+}
+}
+
+DAVA_TESTCLASS (ProfilerTraceCaptureTest)
+{
+    DAVA_TEST (BinaryCaptureTest)
+    {
+        using namespace ProfilerTraceCaptureTestDetails;
+
+        FilePath dir("~doc:/ProfilerTraceCaptureTest/");
+        FilePath binaryPath = dir + "trace.dvtrace";
+        FilePath jsonPath = dir + "trace.json";
+        FileSystem::Instance()->DeleteDirectory(dir, true);
+
+        ProfilerCPU profiler(64);
+        profiler.Start();
+        {
+            ProfilerTraceCapture capture(&profiler, nullptr, binaryPath, ProfilerTraceCapture::FORMAT_BINARY);
+            TEST_VERIFY(capture.IsCapturing());
+            TEST_VERIFY(profiler.IsCaptureEnabled());
+
+            ProfileFrames(&profiler, capture);
+
+            capture.Finish();
+            TEST_VERIFY(!capture.IsCapturing());
+            TEST_VERIFY(!profiler.IsCaptureEnabled());
+            TEST_VERIFY(capture.GetWrittenEventsCount() == FRAMES_COUNT * 2 + WORKER_COUNTERS_COUNT);
+        }
+        profiler.Stop();
+
+        Vector<TraceEvent> trace;
+        TEST_VERIFY(ProfilerTraceCapture::ReadBinaryTrace(binaryPath, trace));
+        TEST_VERIFY(trace.size() == FRAMES_COUNT * 2 + WORKER_COUNTERS_COUNT);
+
+        uint32 framesCount = 0, innerCount = 0, workerCount = 0;
+        uint64 mainThreadID = Thread::GetCurrentIdAsUInt64();
+        for (const TraceEvent& event : trace)
+        {
+            TEST_VERIFY(event.phase == TraceEvent::PHASE_DURATION);
+            if (event.name == FastName(FRAME_MARKER))
+            {
+                ++framesCount;
+                TEST_VERIFY(event.threadID == mainThreadID);
+                TEST_VERIFY(event.args.size() == 1 && event.args[0].first == ProfilerCPU::TRACE_ARG_FRAME && event.args[0].second == framesCount);
+            }
+            else if (event.name == FastName(INNER_MARKER))
+            {
+                ++innerCount;
+                TEST_VERIFY(event.threadID == mainThreadID);
+                TEST_VERIFY(event.args.empty());
+            }
+            else if (event.name == FastName(WORKER_MARKER))
+            {
+                ++workerCount;
+                TEST_VERIFY(event.threadID != mainThreadID);
+            }
+        }
+        TEST_VERIFY(framesCount == FRAMES_COUNT);
+        TEST_VERIFY(innerCount == FRAMES_COUNT);
+        TEST_VERIFY(workerCount == WORKER_COUNTERS_COUNT);
+
+        // inner counter is completed before frame counter, so it goes first and lies inside of frame
+        for (size_t i = 0; i + 1 < FRAMES_COUNT * 2; i += 2)
+        {
+            const TraceEvent& inner = trace[i];
+            const TraceEvent& frame = trace[i + 1];
+            TEST_VERIFY(inner.name == FastName(INNER_MARKER) && frame.name == FastName(FRAME_MARKER));
+            TEST_VERIFY(frame.timestamp <= inner.timestamp && inner.timestamp + inner.duration <= frame.timestamp + frame.duration);
+        }
+
+        TEST_VERIFY(ProfilerTraceCapture::ConvertBinaryToJSON(binaryPath, jsonPath));
+        TEST_VERIFY(FileSystem::Instance()->Exists(jsonPath));
+
+        // JSON file is not a binary trace
+        Vector<TraceEvent> invalidTrace;
+        TEST_VERIFY(!ProfilerTraceCapture::ReadBinaryTrace(jsonPath, invalidTrace));
+
+        FileSystem::Instance()->DeleteDirectory(dir, true);
+    }
+
+    DAVA_TEST (JSONCaptureTest)
+    {
+        using namespace ProfilerTraceCaptureTestDetails;
+
+        FilePath dir("~doc:/ProfilerTraceCaptureTest/");
+        FilePath jsonPath = dir + "trace.json";
+        FileSystem::Instance()->DeleteDirectory(dir, true);
+
+        ProfilerCPU profiler(64);
+        profiler.Start();
+        {
+            ProfilerTraceCapture capture(&profiler, nullptr, jsonPath, ProfilerTraceCapture::FORMAT_JSON);
+            ProfileFrames(&profiler, capture);
+        }
+        profiler.Stop();
+
+        String json = FileSystem::Instance()->ReadFileContents(jsonPath);
+        TEST_VERIFY(json.find("{ \"traceEvents\": [") == 0);
+        TEST_VERIFY(json.rfind("] }") != String::npos);
+
+        size_t eventsCount = 0;
+        for (size_t pos = json.find("\"ph\": \"X\""); pos != String::npos; pos = json.find("\"ph\": \"X\"", pos + 1))
+        {
+            ++eventsCount;
+        }
+        TEST_VERIFY(eventsCount == FRAMES_COUNT * 2 + WORKER_COUNTERS_COUNT);
+
+        FileSystem::Instance()->DeleteDirectory(dir, true);
+    }
+
+    DAVA_TEST (CaptureLimitTest)
+    {
+        using namespace ProfilerTraceCaptureTestDetails;
+
+        ProfilerCPU profiler(64);
+        profiler.Start();
+
+        // counters which were not taken are discarded when capture is disabled
+        profiler.SetCaptureEnabled(true);
+        for (uint32 i = 0; i < WORKER_COUNTERS_COUNT; ++i)
+        {
+            DAVA_PROFILER_CPU_SCOPE_CUSTOM(INNER_MARKER, &profiler);
+        }
+        profiler.SetCaptureEnabled(false);
+        profiler.SetCaptureEnabled(true);
+
+        Vector<TraceEvent> trace;
+        profiler.TakeCapturedTrace(trace);
+        TEST_VERIFY(trace.empty());
+
+        // without consumer capture keeps at most MAX_CAPTURED_COUNTERS counters
+        for (uint32 i = 0; i < ProfilerCPU::MAX_CAPTURED_COUNTERS + WORKER_COUNTERS_COUNT; ++i)
+        {
+            DAVA_PROFILER_CPU_SCOPE_CUSTOM(INNER_MARKER, &profiler);
+        }
+        profiler.TakeCapturedTrace(trace);
+        TEST_VERIFY(trace.size() == ProfilerCPU::MAX_CAPTURED_COUNTERS);
+
+        // taken counters free place for new ones
+        trace.clear();
+        {
+            DAVA_PROFILER_CPU_SCOPE_CUSTOM(INNER_MARKER, &profiler);
+        }
+        profiler.TakeCapturedTrace(trace);
+        TEST_VERIFY(trace.size() == 1);
+
+        profiler.SetCaptureEnabled(false);
+        profiler.Stop();
+    }
+};
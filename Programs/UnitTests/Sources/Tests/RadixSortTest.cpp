@@ -0,0 +1,46 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Base/Radix/Radix.h"
+
+#include <random>
+
+DAVA_TESTCLASS (RadixSortTest)
+{
+    void SortAndCompare(DAVA::Vector<DAVA::RadixSortItem> items)
+    {
+        using namespace DAVA;
+
+        Vector<RadixSortItem> expected = items;
+        std::stable_sort(expected.begin(), expected.end(), [](const RadixSortItem& l, const RadixSortItem& r) { return l.key < r.key; });
+
+        Vector<RadixSortItem> temp(items.size());
+        RadixSort(items.data(), temp.data(), static_cast<uint32>(items.size()));
+
+        bool equal = std::equal(items.begin(), items.end(), expected.begin(), [](const RadixSortItem& l, const RadixSortItem& r) {
+            return l.key == r.key && l.value == r.value;
+        });
+        TEST_VERIFY(equal);
+    }
+
+    DAVA_TEST (SortsStableByKey)
+    {
+        using namespace DAVA;
+
+        std::mt19937_64 random(42);
+        const uint32 counts[] = { 0, 1, 2, 100, 10000 };
+        const uint64 masks[] = { ~0ull, 0xF00000000000FFFFull, 0xF000000000000000ull };
+
+        for (uint32 count : counts)
+        {
+            for (uint64 mask : masks)
+            {
+                Vector<RadixSortItem> items(count);
+                for (uint32 i = 0; i < count; ++i)
+                {
+                    items[i] = { random() & mask, i };
+                }
+                SortAndCompare(items);
+            }
+        }
+    }
+};
@@ -203,6 +203,131 @@ DAVA_TESTCLASS (ResourcePackerTest)
 
         TEST_VERIFY(packer.GetErrors().empty() == false); // should contain error about absence of ".china" tag in allTags
     };
+
+    struct GpuParams
+    {
+        DAVA::eGPUFamily gpu = DAVA::eGPUFamily::GPU_ORIGIN;
+        DAVA::PixelFormat pixelFormat = DAVA::FORMAT_RGBA8888;
+        DAVA::ImageFormat imageFormat = DAVA::IMAGE_FORMAT_PNG;
+    };
+
+    /** Pack same sources with one and several workers and compare outputs. */
+    void VerifyParallelExport(const DAVA::Vector<GpuParams>& gpuParams)
+    {
+        using namespace DAVA;
+
+        ClearWorkingFolders();
+        CopyPsdSources();
+
+        Vector<eGPUFamily> requestedGPUs;
+        {
+            ScopedPtr<File> flagsFile(File::Create(inputDir + "flags.txt", File::CREATE | File::WRITE));
+            flagsFile->WriteNonTerminatedString("--split ");
+            for (const GpuParams& params : gpuParams)
+            {
+                const String& gpuName = GPUFamilyDescriptor::GetGPUName(params.gpu);
+                const char* pixelFormatString = PixelFormatDescriptor::GetPixelFormatString(params.pixelFormat);
+                const String& imageFormatString = ImageSystem::GetImageFormatInterface(params.imageFormat)->GetName();
+                flagsFile->WriteNonTerminatedString(Format("--%s %s %s ", gpuName.c_str(), pixelFormatString, imageFormatString.c_str()));
+                requestedGPUs.push_back(params.gpu);
+            }
+        }
+
+        const FilePath parallelOutputDir = rootDir + "ParallelOutput/";
+
+        {
+            ResourcePacker2D packer;
+            packer.InitFolders(inputDir, outputDir);
+            packer.SetWorkersCount(1);
+            packer.PackResources(requestedGPUs);
+            TEST_VERIFY(packer.GetErrors().empty() == true);
+        }
+
+        {
+            ResourcePacker2D packer;
+            packer.InitFolders(inputDir, parallelOutputDir);
+            packer.forceRepack = true;
+            packer.SetWorkersCount(4);
+            packer.PackResources(requestedGPUs);
+            TEST_VERIFY(packer.GetErrors().empty() == true);
+        }
+
+        // all sheets should be exported before PackResources returns, and output shouldn't depend on workers count
+        MD5::MD5Digest serialDigest;
+        MD5::MD5Digest parallelDigest;
+        MD5::ForDirectory(outputDir, serialDigest, true, false);
+        MD5::ForDirectory(parallelOutputDir, parallelDigest, true, false);
+        TEST_VERIFY(serialDigest == parallelDigest);
+
+        for (const String& name : psdBaseNames)
+        {
+            TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->Exists(parallelOutputDir + (name + ".txt")) == true);
+            for (const GpuParams& params : gpuParams)
+            {
+                String sheetName = name + "0" + GPUFamilyDescriptor::GetGPUPrefix(params.gpu) + ImageSystem::GetDefaultExtension(params.imageFormat);
+                TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->Exists(parallelOutputDir + sheetName) == true);
+            }
+        }
+    }
+
+    DAVA_TEST (ParallelExportTest)
+    {
+        using namespace DAVA;
+
+        VerifyParallelExport({ { eGPUFamily::GPU_ORIGIN, PixelFormat::FORMAT_RGBA8888, ImageFormat::IMAGE_FORMAT_PNG } });
+
+        // sheets are compressed by nvtt, Qualcomm library and PVRTexTool on several threads at once
+        VerifyParallelExport({
+        { eGPUFamily::GPU_POWERVR_IOS, PixelFormat::FORMAT_RGBA8888, ImageFormat::IMAGE_FORMAT_PVR },
+        { eGPUFamily::GPU_ADRENO, PixelFormat::FORMAT_ATC_RGB, ImageFormat::IMAGE_FORMAT_DDS },
+        { eGPUFamily::GPU_DX11, PixelFormat::FORMAT_DXT1, ImageFormat::IMAGE_FORMAT_DDS }
+        });
+    };
+
+    DAVA_TEST (IncrementalSplitTest)
+    {
+        using namespace DAVA;
+
+        ClearWorkingFolders();
+        CopyPsdSources();
+        {
+            ScopedPtr<File> flagsFile(File::Create(inputDir + "flags.txt", File::CREATE | File::WRITE));
+            flagsFile->WriteNonTerminatedString("--split");
+        }
+
+        {
+            ResourcePacker2D packer;
+            packer.InitFolders(inputDir, outputDir);
+            packer.PackResources({ eGPUFamily::GPU_ORIGIN });
+            TEST_VERIFY(packer.GetErrors().empty() == true);
+            TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->Exists(outputDir + "target_tut.txt") == true);
+            TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->Exists(outputDir + "target_tut0.png") == true);
+        }
+
+        // only outputs of removed and added files should be changed
+        TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->DeleteFile(inputDir + "target_tut.psd") == true);
+        TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->CopyFile(resourcesDir + "air.psd", inputDir + "air_copy.psd") == true);
+
+        {
+            ResourcePacker2D packer;
+            packer.InitFolders(inputDir, outputDir);
+            packer.PackResources({ eGPUFamily::GPU_ORIGIN });
+            TEST_VERIFY(packer.GetErrors().empty() == true);
+        }
+
+        TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->Exists(outputDir + "target_tut.txt") == false);
+        TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->Exists(outputDir + "target_tut0.png") == false);
+        TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->Exists(outputDir + "target_tut0.tex") == false);
+        TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->Exists(outputDir + "air_copy.txt") == true);
+        TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->Exists(outputDir + "air_copy0.png") == true);
+        TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->CompareBinaryFiles(outputDir + "air0.png", outputDir + "air_copy0.png") == true);
+
+        for (const String& name : { "air", "arrow_tut", "eye_tut" })
+        {
+            TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->Exists(outputDir + (String(name) + ".txt")) == true);
+            TEST_VERIFY(DAVA::GetEngineContext()->fileSystem->Exists(outputDir + (String(name) + "0.tex")) == true);
+        }
+    };
 };
 
 #endif
@@ -0,0 +1,237 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Base/Hash.h"
+#include "Base/ScopedPtr.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+#include "Logger/Logger.h"
+#include "Render/Renderer.h"
+#include "Render/RHI/rhi_Public.h"
+#include "Render/RHI/rhi_ShaderSource.h"
+#include "Render/ShaderCache.h"
+#include "Utils/StringFormat.h"
+
+using namespace DAVA;
+
+namespace ShaderCacheTestDetails
+{
+const FilePath workingFolder("~doc:/TestData/ShaderCacheTest/");
+const FastName shaderName("~res:/Materials/Shaders/Default/materials");
+const FilePath vertexSourcePath("~res:/Materials/Shaders/Default/materials-vp.sl");
+const FastName testDefine("SHADER_CACHE_TEST");
+const uint32 VARIANTS_COUNT = 3;
+
+UnorderedMap<FastName, int32> MakeDefines(int32 variant)
+{
+    UnorderedMap<FastName, int32> defines;
+    defines[FastName("MATERIAL_TEXTURE")] = 1;
+    defines[testDefine] = variant;
+    return defines;
+}
+
+class ForbiddenCallsCounter : public LoggerOutput
+{
+public:
+    void Output(Logger::eLogLevel ll, const char8* text) override
+    {
+        if (ll == Logger::LEVEL_ERROR && strstr(text, "Forbidden call to GetShaderDescriptor") != nullptr)
+        {
+            ++forbiddenCalls;
+        }
+    }
+
+    uint32 forbiddenCalls = 0;
+};
+
+/** Variants of test shader found in warmup list, entries of other shaders are skipped. */
+bool ReadWarmupList(const FilePath& pathname, uint32& version, Set<int32>& variants)
+{
+    ScopedPtr<File> file(File::Create(pathname, File::OPEN | File::READ));
+    if (!file)
+        return false;
+
+    uint32 count = 0;
+    if (file->Read(&version) != sizeof(version) || file->Read(&count) != sizeof(count))
+        return false;
+
+    String str;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        str.clear();
+        if (file->ReadString(str) == 0)
+            return false;
+        bool isTestShader = (FastName(str) == shaderName);
+
+        uint32 definesCount = 0;
+        if (file->Read(&definesCount) != sizeof(definesCount))
+            return false;
+
+        for (uint32 d = 0; d < definesCount; ++d)
+        {
+            int32 value = 0;
+            str.clear();
+            if (file->ReadString(str) == 0 || file->Read(&value) != sizeof(value))
+                return false;
+
+            if (isTestShader && FastName(str) == testDefine)
+            {
+                variants.insert(value);
+            }
+        }
+    }
+    return true;
+}
+
+bool WriteWarmupList(const FilePath& pathname, uint32 version, const Vector<int32>& variants)
+{
+    ScopedPtr<File> file(File::Create(pathname, File::CREATE | File::WRITE));
+    if (!file)
+        return false;
+
+    bool written = true;
+    uint32 count = static_cast<uint32>(variants.size());
+    written &= (file->Write(&version) == sizeof(version));
+    written &= (file->Write(&count) == sizeof(count));
+    for (int32 variant : variants)
+    {
+        UnorderedMap<FastName, int32> defines = MakeDefines(variant);
+        uint32 definesCount = static_cast<uint32>(defines.size());
+        written &= file->WriteString(String(shaderName.c_str()));
+        written &= (file->Write(&definesCount) == sizeof(definesCount));
+        for (const auto& define : defines)
+        {
+            written &= file->WriteString(String(define.first.c_str()));
+            written &= (file->Write(&define.second) == sizeof(define.second));
+        }
+    }
+    return written;
+}
+}
+
+DAVA_TESTCLASS (ShaderCacheTest)
+{
+    ShaderCacheTest()
+    {
+        FileSystem::Instance()->CreateDirectory(ShaderCacheTestDetails::workingFolder, true);
+    }
+
+    ~ShaderCacheTest()
+    {
+        FileSystem::Instance()->DeleteDirectory(ShaderCacheTestDetails::workingFolder, true);
+    }
+
+    DAVA_TEST (SourceCacheRoundTripTest)
+    {
+        using namespace ShaderCacheTestDetails;
+
+        // shader sources are generated for host api, nothing to check without renderer
+        if (!Renderer::IsInitialized())
+            return;
+
+        String sourceText = FileSystem::Instance()->ReadFileContents(vertexSourcePath);
+        TEST_VERIFY(!sourceText.empty());
+        if (sourceText.empty())
+            return;
+
+        uint32 sourceHash = HashValue_N(sourceText.c_str(), static_cast<uint32>(sourceText.length()));
+
+        Vector<FastName> uids;
+        Vector<String> codes;
+        for (uint32 i = 0; i < VARIANTS_COUNT; ++i)
+        {
+            FastName uid(Format("ShaderCacheTest vSource %u", i));
+            std::vector<std::string> defines = { "MATERIAL_TEXTURE", "1", testDefine.c_str(), Format("%u", i) };
+
+            const rhi::ShaderSource* source = rhi::ShaderSourceCache::Add(vertexSourcePath.GetFrameworkPath().c_str(), uid, rhi::PROG_VERTEX, sourceText.c_str(), defines);
+            TEST_VERIFY(source != nullptr);
+            if (source == nullptr)
+                return;
+
+            // sources are looked up by uid and hash of source text
+            TEST_VERIFY(rhi::ShaderSourceCache::Get(uid, sourceHash) == source);
+            TEST_VERIFY(rhi::ShaderSourceCache::Get(uid, sourceHash + 1) == nullptr);
+
+            uids.push_back(uid);
+            codes.push_back(source->GetSourceCode(rhi::HostApi()));
+        }
+        TEST_VERIFY(rhi::ShaderSourceCache::Get(FastName("ShaderCacheTest unknown source"), sourceHash) == nullptr);
+
+        // re-adding existing uid replaces entry instead of adding new one
+        std::vector<std::string> defines = { "MATERIAL_TEXTURE", "1", testDefine.c_str(), "0" };
+        const rhi::ShaderSource* replaced = rhi::ShaderSourceCache::Add(vertexSourcePath.GetFrameworkPath().c_str(), uids[0], rhi::PROG_VERTEX, sourceText.c_str(), defines);
+        TEST_VERIFY(replaced != nullptr);
+        TEST_VERIFY(rhi::ShaderSourceCache::Get(uids[0], sourceHash) == replaced);
+
+        // cache is cleared on load, so entries found after it are read from file
+        FilePath cachePath = workingFolder + "ShaderSource.bin";
+        rhi::ShaderSourceCache::Save(cachePath.GetAbsolutePathname().c_str());
+        TEST_VERIFY(FileSystem::Instance()->Exists(cachePath));
+
+        rhi::ShaderSourceCache::Load(cachePath.GetAbsolutePathname().c_str());
+        for (uint32 i = 0; i < VARIANTS_COUNT; ++i)
+        {
+            const rhi::ShaderSource* source = rhi::ShaderSourceCache::Get(uids[i], sourceHash);
+            TEST_VERIFY(source != nullptr);
+            if (source != nullptr)
+            {
+                TEST_VERIFY(source->GetSourceCode(rhi::HostApi()) == codes[i]);
+            }
+            TEST_VERIFY(rhi::ShaderSourceCache::Get(uids[i], sourceHash + 1) == nullptr);
+        }
+        TEST_VERIFY(rhi::ShaderSourceCache::Get(FastName("ShaderCacheTest unknown source"), sourceHash) == nullptr);
+    }
+
+    DAVA_TEST (WarmupListTest)
+    {
+        using namespace ShaderCacheTestDetails;
+
+        if (!Renderer::IsInitialized())
+            return;
+
+        // descriptors created during this launch are written to warmup list
+        for (uint32 i = 0; i < VARIANTS_COUNT; ++i)
+        {
+            ShaderDescriptor* shader = ShaderDescriptorCache::GetShaderDescriptor(shaderName, MakeDefines(i));
+            TEST_VERIFY(shader != nullptr && shader->IsValid());
+        }
+
+        FilePath savedListPath = workingFolder + "SavedWarmupList.bin";
+        ShaderDescriptorCache::SaveWarmupList(savedListPath);
+
+        uint32 version = 0;
+        Set<int32> savedVariants;
+        TEST_VERIFY(ReadWarmupList(savedListPath, version, savedVariants));
+        for (uint32 i = 0; i < VARIANTS_COUNT; ++i)
+        {
+            TEST_VERIFY(savedVariants.count(i) == 1);
+        }
+
+        // list of previous launch with variants not created yet
+        const Vector<int32> warmupVariants = { 100, 101, 102, 103, 104, 105, 106, 107, 108, 109 };
+        FilePath listPath = workingFolder + "WarmupList.bin";
+        TEST_VERIFY(WriteWarmupList(listPath, version, warmupVariants));
+
+        ShaderDescriptorCache::Prewarm(listPath);
+
+        ForbiddenCallsCounter counter;
+        Logger::AddCustomOutput(&counter);
+        ShaderDescriptorCache::SetLoadingNotifyEnabled(true);
+        SCOPE_EXIT
+        {
+            ShaderDescriptorCache::SetLoadingNotifyEnabled(false);
+            Logger::RemoveCustomOutput(&counter);
+        };
+
+        // prewarmed descriptors are not built on first use
+        for (int32 variant : warmupVariants)
+        {
+            ShaderDescriptor* shader = ShaderDescriptorCache::GetShaderDescriptor(shaderName, MakeDefines(variant));
+            TEST_VERIFY(shader != nullptr && shader->IsValid());
+        }
+        TEST_VERIFY(counter.forbiddenCalls == 0);
+
+        // variant missing in list is still built on first use
+        ShaderDescriptorCache::GetShaderDescriptor(shaderName, MakeDefines(200));
+        TEST_VERIFY(counter.forbiddenCalls == 1);
+    }
+};
@@ -0,0 +1,125 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Base/ScopedPtr.h"
+#include "Scene3D/Entity.h"
+#include "Scene3D/Scene.h"
+#include "Scene3D/Systems/TransformSystem.h"
+
+using namespace DAVA;
+
+namespace TransformSystemTestDetails
+{
+// more top-level subtrees than one job takes, so subtrees are transformed by several jobs at once
+const uint32 TOP_ENTITIES_COUNT = 40;
+const uint32 CHILDREN_COUNT = 3;
+const uint32 GRANDCHILDREN_COUNT = 2;
+const uint32 ENTITIES_PER_TOP = 1 + CHILDREN_COUNT * (1 + GRANDCHILDREN_COUNT);
+const uint32 ENTITIES_COUNT = TOP_ENTITIES_COUNT * ENTITIES_PER_TOP;
+
+Matrix4 MakeTransform(uint32 index, float32 phase)
+{
+    float32 value = static_cast<float32>(index) + phase;
+    return Matrix4::MakeRotation(Vector3(0.0f, 0.0f, 1.0f), value * 0.1f) * Matrix4::MakeTranslation(Vector3(value, -0.5f * value, 1.0f));
+}
+
+/** Scene with nested hierarchies, entities are collected in order of creation. */
+struct TestScene
+{
+    ScopedPtr<Scene> scene;
+    Vector<Entity*> entities;
+
+    explicit TestScene(bool parallelUpdate)
+        : scene(new Scene())
+    {
+        scene->transformSystem->SetParallelUpdateEnabled(parallelUpdate);
+        for (uint32 i = 0; i < TOP_ENTITIES_COUNT; ++i)
+        {
+            Entity* top = AddEntity(scene);
+            for (uint32 j = 0; j < CHILDREN_COUNT; ++j)
+            {
+                Entity* child = AddEntity(top);
+                for (uint32 k = 0; k < GRANDCHILDREN_COUNT; ++k)
+                {
+                    AddEntity(child);
+                }
+            }
+        }
+    }
+
+    Entity* AddEntity(Entity* parent)
+    {
+        ScopedPtr<Entity> entity(new Entity());
+        entity->SetLocalTransform(MakeTransform(static_cast<uint32>(entities.size()), 0.0f));
+        parent->AddNode(entity);
+        entities.push_back(entity);
+        return entity;
+    }
+
+    /** Change transforms of top-level entities and of their nested children in the same frame. */
+    void ChangeSubtrees(float32 phase)
+    {
+        for (uint32 i = 0; i < TOP_ENTITIES_COUNT; ++i)
+        {
+            uint32 top = i * ENTITIES_PER_TOP;
+            entities[top]->SetLocalTransform(MakeTransform(top, phase));
+            entities[top + ENTITIES_PER_TOP - 1]->SetLocalTransform(MakeTransform(top + ENTITIES_PER_TOP - 1, phase));
+        }
+    }
+};
+
+void VerifySameTransforms(const TestScene& parallel, const TestScene& serial)
+{
+    const TransformSystem::Statistics& parallelStatistics = parallel.scene->transformSystem->GetStatistics();
+    const TransformSystem::Statistics& serialStatistics = serial.scene->transformSystem->GetStatistics();
+    TEST_VERIFY(parallelStatistics.transformedSubtrees == serialStatistics.transformedSubtrees);
+    TEST_VERIFY(parallelStatistics.multipliedNodes == serialStatistics.multipliedNodes);
+
+    for (uint32 i = 0; i < ENTITIES_COUNT; ++i)
+    {
+        TEST_VERIFY(parallel.entities[i]->GetWorldTransform() == serial.entities[i]->GetWorldTransform());
+    }
+}
+}
+
+DAVA_TESTCLASS (TransformSystemTest)
+{
+    DAVA_TEST (ParallelUpdateTest)
+    {
+        using namespace TransformSystemTestDetails;
+
+        TestScene parallel(true);
+        TestScene serial(false);
+
+        parallel.scene->Update(0.1f);
+        serial.scene->Update(0.1f);
+        VerifySameTransforms(parallel, serial);
+        TEST_VERIFY(parallel.scene->transformSystem->GetStatistics().transformedSubtrees == TOP_ENTITIES_COUNT);
+        TEST_VERIFY(parallel.scene->transformSystem->GetStatistics().multipliedNodes == ENTITIES_COUNT);
+
+        // independent subtrees with changed nested entities
+        parallel.ChangeSubtrees(1.0f);
+        serial.ChangeSubtrees(1.0f);
+        parallel.scene->Update(0.1f);
+        serial.scene->Update(0.1f);
+        VerifySameTransforms(parallel, serial);
+        TEST_VERIFY(parallel.scene->transformSystem->GetStatistics().transformedSubtrees == TOP_ENTITIES_COUNT);
+        TEST_VERIFY(parallel.scene->transformSystem->GetStatistics().multipliedNodes == ENTITIES_COUNT);
+
+        // scene itself and changed top-level entities are scheduled for update, nested subtrees should be transformed once
+        Matrix4 sceneTransform = Matrix4::MakeTranslation(Vector3(10.0f, 20.0f, 30.0f));
+        parallel.scene->SetLocalTransform(sceneTransform);
+        serial.scene->SetLocalTransform(sceneTransform);
+        parallel.ChangeSubtrees(2.0f);
+        serial.ChangeSubtrees(2.0f);
+        parallel.scene->Update(0.1f);
+        serial.scene->Update(0.1f);
+        VerifySameTransforms(parallel, serial);
+        TEST_VERIFY(parallel.scene->transformSystem->GetStatistics().transformedSubtrees == 1);
+        TEST_VERIFY(parallel.scene->transformSystem->GetStatistics().multipliedNodes == ENTITIES_COUNT);
+
+        // world transform is accumulated along the whole hierarchy
+        Entity* grandchild = parallel.entities[ENTITIES_PER_TOP - 1];
+        Matrix4 expected = grandchild->AccamulateLocalTransform(parallel.scene);
+        TEST_VERIFY(grandchild->GetWorldTransform() == expected);
+    }
+};
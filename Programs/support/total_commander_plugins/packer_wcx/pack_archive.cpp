@@ -73,6 +73,11 @@ PackArchive::PackArchive(const std::string& archiveName)
         throw std::runtime_error("incorrect marker in pack file: " + fileName);
     }
 
+    if (footerBlock.info.version != file_version)
+    {
+        throw std::runtime_error("unsupported version of pack file: " + fileName);
+    }
+
     if (footerBlock.info.num_files > 0)
     {
         uint64_t startFilesTableBlock =
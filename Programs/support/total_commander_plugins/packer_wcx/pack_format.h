@@ -11,6 +11,7 @@ namespace pack_format
 {
 const std::array<char, 4> file_marker{ { 'D', 'V', 'P', 'K' } };
 const std::array<char, 4> file_marker_lite{ { 'D', 'V', 'P', 'L' } };
+const uint32_t file_version = 1;
 
 struct pack_file
 {
@@ -48,12 +49,14 @@ struct pack_file
 
     struct footer_block
     {
-        std::array<uint8_t, 8> reserved;
         uint32_t meta_data_crc32; // 0 or hash
         uint32_t meta_data_size; // 0 or size of meta data block
         uint32_t info_crc32;
         struct info
         {
+            uint32_t version;
+            uint32_t block_size; // 0 or size of independently compressed blocks
+            uint32_t dictionary_size; // 0 or size of dictionary block
             uint32_t num_files;
             uint32_t names_size_compressed; // lz4hc
             uint32_t names_size_original;
@@ -96,7 +99,7 @@ struct file_info
 
 using file_table_entry = pack_file::files_table_block::files_data::data;
 
-static_assert(sizeof(pack_file::footer_block) == 44,
+static_assert(sizeof(pack_file::footer_block) == 48,
               "header block size changed, something bad happened!");
 static_assert(sizeof(file_table_entry) == 32,
               "file table entry size changed, something bad happened!");
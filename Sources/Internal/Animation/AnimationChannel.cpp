@@ -4,9 +4,321 @@
 
 namespace DAVA
 {
+namespace AnimationChannelDetails
+{
+const uint32 QUANTIZED_MAX = 0xffff;
+const uint32 QUATERNION_COMPONENT_MAX = 0x7fff;
+const float32 QUATERNION_COMPONENT_RANGE = 0.70710678f; //all components except the largest one are in [-1/sqrt(2), 1/sqrt(2)]
+
+//forward playback usually moves cursor by a few keys, for longer jumps binary search is used
+const uint32 CURSOR_LINEAR_SEARCH_STEPS = 4;
+
+struct ChannelHeader
+{
+    uint32 signature = AnimationChannel::ANIMATION_CHANNEL_DATA_SIGNATURE;
+    uint8 dimension = 0;
+    uint8 interpolation = 0;
+    uint16 compression = 0;
+    uint32 keyCount = 0;
+};
+
+inline uint32 GetAlignedSize(uint32 size)
+{
+    return (size + 3) & ~3u;
+}
+
+void WriteToBuffer(Vector<uint8>& buffer, const void* data, uint32 size)
+{
+    const uint8* bytes = reinterpret_cast<const uint8*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+//as animation data is used directly from memory, every block of channel is aligned by 4 bytes
+void WriteToBufferAligned(Vector<uint8>& buffer, const void* data, uint32 size)
+{
+    WriteToBuffer(buffer, data, size);
+    buffer.resize(buffer.size() + GetAlignedSize(size) - size, 0);
+}
+
+uint32 GetQuantizedComponentsCount(uint8 dimension, AnimationChannel::eInterpolation interpolation)
+{
+    return (interpolation == AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR) ? 3 : uint32(dimension);
+}
+
+void Interpolate(AnimationChannel::eInterpolation interpolation, uint32 dimension, const float32* v0, const float32* v1, float32 t, float32* outData)
+{
+    switch (interpolation)
+    {
+    case AnimationChannel::INTERPOLATION_LINEAR:
+    {
+        for (uint32 d = 0; d < dimension; ++d)
+        {
+            outData[d] = Lerp(v0[d], v1[d], t);
+        }
+    }
+    break;
+
+    case AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR:
+    {
+        DVASSERT(dimension == 4); //should be quaternion
+
+        Quaternion q0(v0);
+        Quaternion q(v1);
+        q.Slerp(q0, q, t);
+        q.Normalize();
+
+        Memcpy(outData, q.data, dimension * sizeof(float32));
+    }
+    break;
+
+    case AnimationChannel::INTERPOLATION_BEZIER:
+    {
+        DVASSERT(false, "Bezier not supported yet");
+    }
+    break;
+
+    default:
+        break;
+    }
+}
+
+float32 GetValuesDifference(AnimationChannel::eInterpolation interpolation, uint32 dimension, const float32* v0, const float32* v1)
+{
+    float32 difference = 0.f;
+    float32 negatedDifference = 0.f;
+    for (uint32 d = 0; d < dimension; ++d)
+    {
+        difference = Max(difference, std::abs(v0[d] - v1[d]));
+        negatedDifference = Max(negatedDifference, std::abs(v0[d] + v1[d]));
+    }
+
+    //q and -q are the same rotation
+    return (interpolation == AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR) ? Min(difference, negatedDifference) : difference;
+}
+
+//returns indices of keys which can't be restored by interpolation of kept keys
+Vector<uint32> DecimateKeys(uint8 dimension, AnimationChannel::eInterpolation interpolation, const Vector<float32>& keyTimes, const Vector<float32>& keyValues, float32 tolerance)
+{
+    uint32 keysCount = uint32(keyTimes.size());
+
+    Vector<uint32> keptKeys;
+    keptKeys.push_back(0);
+
+    float32 interpolated[4];
+    uint32 anchor = 0;
+    for (uint32 next = 2; next < keysCount; ++next)
+    {
+        const float32* anchorValue = keyValues.data() + anchor * dimension;
+        const float32* nextValue = keyValues.data() + next * dimension;
+        float32 timeRange = keyTimes[next] - keyTimes[anchor];
+
+        bool fits = (timeRange > 0.f);
+        for (uint32 k = anchor + 1; k < next && fits; ++k)
+        {
+            float32 t = (keyTimes[k] - keyTimes[anchor]) / timeRange;
+            Interpolate(interpolation, dimension, anchorValue, nextValue, t, interpolated);
+            fits = GetValuesDifference(interpolation, dimension, interpolated, keyValues.data() + k * dimension) <= tolerance;
+        }
+
+        if (!fits)
+        {
+            anchor = next - 1;
+            keptKeys.push_back(anchor);
+        }
+    }
+
+    if (keysCount > 1)
+    {
+        //constant channel is stored as single key
+        const float32* lastValue = keyValues.data() + (keysCount - 1) * dimension;
+        if (keptKeys.size() > 1 || GetValuesDifference(interpolation, dimension, keyValues.data(), lastValue) > tolerance)
+        {
+            keptKeys.push_back(keysCount - 1);
+        }
+    }
+
+    return keptKeys;
+}
+
+void EncodeQuaternion(const float32* q, uint16* outData)
+{
+    uint32 largest = 0;
+    for (uint32 c = 1; c < 4; ++c)
+    {
+        if (std::abs(q[c]) > std::abs(q[largest]))
+            largest = c;
+    }
+
+    //largest component is restored as positive
+    float32 sign = (q[largest] < 0.f) ? -1.f : 1.f;
+
+    uint32 written = 0;
+    for (uint32 c = 0; c < 4; ++c)
+    {
+        if (c != largest)
+        {
+            float32 normalized = Clamp((q[c] * sign / QUATERNION_COMPONENT_RANGE) * 0.5f + 0.5f, 0.f, 1.f);
+            outData[written] = uint16(std::lround(normalized * QUATERNION_COMPONENT_MAX));
+            ++written;
+        }
+    }
+
+    //index of largest component is stored in high bits of first two components
+    outData[0] |= uint16((largest >> 1) << 15);
+    outData[1] |= uint16((largest & 1) << 15);
+}
+
+void DecodeQuaternion(const uint16* data, float32* outQ)
+{
+    uint32 largest = ((data[0] >> 15) << 1) | (data[1] >> 15);
+
+    float32 sum = 0.f;
+    uint32 read = 0;
+    for (uint32 c = 0; c < 4; ++c)
+    {
+        if (c != largest)
+        {
+            float32 normalized = float32(data[read] & QUATERNION_COMPONENT_MAX) / QUATERNION_COMPONENT_MAX;
+            outQ[c] = (normalized * 2.f - 1.f) * QUATERNION_COMPONENT_RANGE;
+            sum += outQ[c] * outQ[c];
+            ++read;
+        }
+    }
+
+    outQ[largest] = std::sqrt(Max(0.f, 1.f - sum));
+}
+
+void WriteUncompressedData(uint8 dimension, const Vector<float32>& keyTimes, const Vector<float32>& keyValues, Vector<uint8>& outData)
+{
+    for (size_t k = 0; k < keyTimes.size(); ++k)
+    {
+        WriteToBuffer(outData, &keyTimes[k], sizeof(float32));
+        WriteToBuffer(outData, keyValues.data() + k * dimension, dimension * sizeof(float32));
+    }
+}
+
+//times of close keys may become equal after quantization, such keys are removed except the last one
+void QuantizeKeyTimes(const Vector<float32>& keyTimes, Vector<uint32>& keys, float32& timeStart, float32& timeScale, Vector<uint16>& times)
+{
+    timeStart = keyTimes[keys.front()];
+    timeScale = (keyTimes[keys.back()] - timeStart) / QUANTIZED_MAX;
+
+    Vector<uint32> timedKeys;
+    for (uint32 key : keys)
+    {
+        uint16 time = (timeScale > 0.f) ? uint16(std::lround((keyTimes[key] - timeStart) / timeScale)) : 0;
+        if (!times.empty() && times.back() == time)
+        {
+            if (key != keys.back())
+                continue;
+
+            times.pop_back();
+            timedKeys.pop_back();
+        }
+
+        times.push_back(time);
+        timedKeys.push_back(key);
+    }
+
+    keys.swap(timedKeys);
+}
+
+void WriteQuantizedData(uint8 dimension, AnimationChannel::eInterpolation interpolation, const Vector<uint32>& timedKeys, const Vector<uint16>& times, const Vector<float32>& keyValues, Vector<uint8>& outData)
+{
+    Vector<uint16> values;
+    if (interpolation == AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR)
+    {
+        DVASSERT(dimension == 4);
+
+        values.resize(timedKeys.size() * 3);
+        for (size_t k = 0; k < timedKeys.size(); ++k)
+        {
+            Quaternion q(keyValues.data() + timedKeys[k] * dimension);
+            q.Normalize();
+            EncodeQuaternion(q.data, values.data() + k * 3);
+        }
+    }
+    else
+    {
+        Vector<float32> valuesRange(dimension * 2);
+        for (uint32 d = 0; d < dimension; ++d)
+        {
+            float32 minValue = std::numeric_limits<float32>::max();
+            float32 maxValue = -std::numeric_limits<float32>::max();
+            for (uint32 key : timedKeys)
+            {
+                minValue = Min(minValue, keyValues[key * dimension + d]);
+                maxValue = Max(maxValue, keyValues[key * dimension + d]);
+            }
+
+            valuesRange[d] = minValue;
+            valuesRange[dimension + d] = (maxValue - minValue) / QUANTIZED_MAX;
+        }
+        WriteToBuffer(outData, valuesRange.data(), uint32(valuesRange.size() * sizeof(float32)));
+
+        values.resize(timedKeys.size() * dimension);
+        for (size_t k = 0; k < timedKeys.size(); ++k)
+        {
+            for (uint32 d = 0; d < dimension; ++d)
+            {
+                float32 scale = valuesRange[dimension + d];
+                float32 value = keyValues[timedKeys[k] * dimension + d];
+                values[k * dimension + d] = (scale > 0.f) ? uint16(Clamp(std::lround((value - valuesRange[d]) / scale), 0l, long(QUANTIZED_MAX))) : 0;
+            }
+        }
+    }
+
+    WriteToBufferAligned(outData, times.data(), uint32(times.size() * sizeof(uint16)));
+    WriteToBufferAligned(outData, values.data(), uint32(values.size() * sizeof(uint16)));
+}
+}
+
+void AnimationChannel::WriteData(uint8 dimension, eInterpolation interpolation, eCompression compression, const Vector<float32>& keyTimes, const Vector<float32>& keyValues, Vector<uint8>& outData, float32 tolerance)
+{
+    using namespace AnimationChannelDetails;
+
+    DVASSERT(dimension > 0 && dimension <= 4);
+    DVASSERT(interpolation != INTERPOLATION_BEZIER, "Bezier not supported yet");
+    DVASSERT(keyValues.size() == keyTimes.size() * dimension);
+
+    //quantized times can't address more keys
+    if (keyTimes.empty() || keyTimes.size() > QUANTIZED_MAX)
+        compression = COMPRESSION_NONE;
+
+    ChannelHeader header;
+    header.dimension = dimension;
+    header.interpolation = uint8(interpolation);
+    header.compression = uint16(compression);
+
+    if (compression == COMPRESSION_QUANTIZED)
+    {
+        Vector<uint32> keys = DecimateKeys(dimension, interpolation, keyTimes, keyValues, tolerance);
+
+        float32 timeStart = 0.f, timeScale = 0.f;
+        Vector<uint16> times;
+        QuantizeKeyTimes(keyTimes, keys, timeStart, timeScale, times);
+
+        header.keyCount = uint32(keys.size());
+        WriteToBuffer(outData, &header, sizeof(ChannelHeader));
+        WriteToBuffer(outData, &timeStart, sizeof(float32));
+        WriteToBuffer(outData, &timeScale, sizeof(float32));
+        WriteQuantizedData(dimension, interpolation, keys, times, keyValues, outData);
+    }
+    else
+    {
+        header.keyCount = uint32(keyTimes.size());
+        WriteToBuffer(outData, &header, sizeof(ChannelHeader));
+        WriteUncompressedData(dimension, keyTimes, keyValues, outData);
+    }
+}
+
 uint32 AnimationChannel::Bind(const uint8* _data)
 {
+    using namespace AnimationChannelDetails;
+
     keysData = nullptr;
+    quantizedTimes = quantizedValues = nullptr;
+    valuesRange = nullptr;
     dimension = 0;
     keyStride = keysCount = 0;
 
@@ -21,102 +333,164 @@ uint32 AnimationChannel::Bind(const uint8* _data)
         interpolation = eInterpolation(*dataptr);
         dataptr += 1;
 
-        compression = *reinterpret_cast<const uint16*>(dataptr);
+        compression = eCompression(*reinterpret_cast<const uint16*>(dataptr));
         dataptr += 2;
 
         keysCount = *reinterpret_cast<const uint32*>(dataptr);
         dataptr += 4;
 
-        keysData = dataptr;
+        if (compression == COMPRESSION_NONE)
+        {
+            keysData = dataptr;
+
+            keyStride = uint32(sizeof(float32)) * (dimension + 1);
+            if (interpolation == INTERPOLATION_BEZIER)
+                keyStride += uint32(sizeof(float32) * 4); //four float32 as tangents
+
+            dataptr += keysCount * keyStride;
+        }
+        else if (compression == COMPRESSION_QUANTIZED && dimension <= 4)
+        {
+            timeStart = *reinterpret_cast<const float32*>(dataptr);
+            dataptr += 4;
+
+            timeScale = *reinterpret_cast<const float32*>(dataptr);
+            dataptr += 4;
+
+            if (interpolation != INTERPOLATION_SPHERICAL_LINEAR)
+            {
+                valuesRange = reinterpret_cast<const float32*>(dataptr);
+                dataptr += 2 * dimension * sizeof(float32);
+            }
+
+            quantizedTimes = reinterpret_cast<const uint16*>(dataptr);
+            dataptr += GetAlignedSize(keysCount * sizeof(uint16));
 
-        keyStride = uint32(sizeof(float32)) * (dimension + 1);
-        if (interpolation == INTERPOLATION_BEZIER)
-            keyStride += uint32(sizeof(float32) * 4); //four float32 as tangents
+            quantizedValues = reinterpret_cast<const uint16*>(dataptr);
+            dataptr += GetAlignedSize(keysCount * GetQuantizedComponentsCount(dimension, interpolation) * sizeof(uint16));
+        }
+        else
+        {
+            keysCount = 0;
+            return 0;
+        }
     }
 
-    return uint32(keysData - _data) + keysCount * keyStride;
+    return uint32(dataptr - _data);
 }
 
-#define KEY_DATA_SIZE (dimension * sizeof(float32))
-#define KEY_TIME(keyIndex) (*reinterpret_cast<const float32*>(keysData + (keyIndex)*keyStride))
-#define KEY_DATA(keyIndex) (reinterpret_cast<const float32*>(keysData + (keyIndex)*keyStride + sizeof(float32)))
-#define KEY_META(keyIndex) (KEY_DATA(keyIndex) + KEY_DATA_SIZE) //tangents for bezier interpolation
+float32 AnimationChannel::GetKeyTime(uint32 key) const
+{
+    if (compression == COMPRESSION_QUANTIZED)
+        return timeStart + timeScale * float32(quantizedTimes[key]);
+    else
+        return *reinterpret_cast<const float32*>(keysData + key * keyStride);
+}
 
-void AnimationChannel::Evaluate(float32 time, float32* outData, uint32 dataSize) const
+void AnimationChannel::GetKeyValue(uint32 key, float32* outData) const
 {
-    DVASSERT(dataSize >= GetDimension());
+    using namespace AnimationChannelDetails;
 
-    uint32 k = startKey;
+    if (compression == COMPRESSION_QUANTIZED)
+    {
+        if (interpolation == INTERPOLATION_SPHERICAL_LINEAR)
+        {
+            DecodeQuaternion(quantizedValues + key * 3, outData);
+        }
+        else
+        {
+            const uint16* values = quantizedValues + key * dimension;
+            for (uint32 d = 0; d < uint32(dimension); ++d)
+            {
+                outData[d] = valuesRange[d] + valuesRange[dimension + d] * float32(values[d]);
+            }
+        }
+    }
+    else
+    {
+        Memcpy(outData, keysData + key * keyStride + sizeof(float32), dimension * sizeof(float32));
+    }
+}
 
-    if (KEY_TIME(k) > time)
+uint32 AnimationChannel::FindKeyBinary(uint32 begin, uint32 end, float32 time) const
+{
+    //first key in [begin, end) with time greater than `time`
+    while (begin < end)
     {
-        k = 0;
+        uint32 middle = begin + (end - begin) / 2;
+        if (GetKeyTime(middle) > time)
+            end = middle;
+        else
+            begin = middle + 1;
     }
+    return begin;
+}
+
+uint32 AnimationChannel::FindKey(float32 time, uint32* keyCursor) const
+{
+    using namespace AnimationChannelDetails;
 
-    for (; k < keysCount; ++k)
+    uint32 k = 0;
+    if (keyCursor != nullptr && *keyCursor < keysCount && GetKeyTime(*keyCursor) <= time)
     {
-        if (KEY_TIME(k) > time)
-            break;
+        k = *keyCursor + 1;
+        uint32 searchEnd = Min(k + CURSOR_LINEAR_SEARCH_STEPS, keysCount);
+        while (k < searchEnd && GetKeyTime(k) <= time)
+            ++k;
 
-        startKey = k;
+        if (k == searchEnd && k < keysCount)
+            k = FindKeyBinary(k, keysCount, time);
     }
+    else
+    {
+        k = FindKeyBinary(0, keysCount, time);
+    }
+
+    if (keyCursor != nullptr)
+        *keyCursor = (k > 0) ? k - 1 : 0;
+
+    return k;
+}
+
+void AnimationChannel::Evaluate(float32 time, float32* outData, uint32 dataSize, uint32* keyCursor) const
+{
+    DVASSERT(dataSize >= GetDimension());
+
+    if (keysCount == 0)
+        return;
+
+    uint32 k = FindKey(time, keyCursor);
 
     if (k == 0)
     {
-        Memcpy(outData, KEY_DATA(0), KEY_DATA_SIZE);
+        GetKeyValue(0, outData);
         return;
     }
 
     if (k == keysCount)
     {
-        Memcpy(outData, KEY_DATA(keysCount - 1), KEY_DATA_SIZE);
+        GetKeyValue(keysCount - 1, outData);
         return;
     }
 
     uint32 k0 = k - 1;
-    float32 time0 = KEY_TIME(k0);
-    float32 time1 = KEY_TIME(k);
+    float32 time0 = GetKeyTime(k0);
+    float32 time1 = GetKeyTime(k);
     float32 t = (time - time0) / (time1 - time0);
 
-    switch (interpolation)
-    {
-    case INTERPOLATION_LINEAR:
-    {
-        for (uint32 d = 0; d < uint32(dimension); ++d)
-        {
-            float32 v0 = *(KEY_DATA(k0) + d);
-            float32 v1 = *(KEY_DATA(k) + d);
-            *(outData + d) = Lerp(v0, v1, t);
-        }
-    }
-    break;
-
-    case INTERPOLATION_SPHERICAL_LINEAR:
+    if (compression == COMPRESSION_QUANTIZED)
     {
-        DVASSERT(dimension == 4); //should be quaternion
-
-        Quaternion q0(KEY_DATA(k0));
-        Quaternion q(KEY_DATA(k));
-        q.Slerp(q0, q, t);
-        q.Normalize();
-
-        Memcpy(outData, q.data, KEY_DATA_SIZE);
+        float32 v0[4];
+        float32 v1[4];
+        GetKeyValue(k0, v0);
+        GetKeyValue(k, v1);
+        AnimationChannelDetails::Interpolate(interpolation, dimension, v0, v1, t, outData);
     }
-    break;
-
-    case INTERPOLATION_BEZIER:
+    else
     {
-        DVASSERT(false, "Bezier not supported yet");
-    }
-    break;
-
-    default:
-        break;
+        const float32* v0 = reinterpret_cast<const float32*>(keysData + k0 * keyStride + sizeof(float32));
+        const float32* v1 = reinterpret_cast<const float32*>(keysData + k * keyStride + sizeof(float32));
+        AnimationChannelDetails::Interpolate(interpolation, dimension, v0, v1, t, outData);
     }
 }
-
-#undef KEY_DATA_SIZE
-#undef KEY_TIME
-#undef KEY_DATA
-#undef KEY_META
 }
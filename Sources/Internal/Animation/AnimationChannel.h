@@ -18,19 +18,57 @@ public:
         INTERPOLATION_COUNT
     };
 
+    enum eCompression : uint16
+    {
+        COMPRESSION_NONE = 0,
+        COMPRESSION_QUANTIZED, //decimated keys, 16-bit times and values normalized by channel range, 'smallest three' quaternions
+
+        COMPRESSION_COUNT
+    };
+
     AnimationChannel() = default;
 
+    /**
+        Write channel data in binary format described in 'AnimationBinaryFormat.md' to the end of `outData`.
+        `keyTimes` should be sorted in ascending order, `keyValues` contains `dimension` values for every key.
+        With COMPRESSION_QUANTIZED keys which are restored by interpolation of neighbours with error less than `tolerance` are dropped.
+        Bezier interpolation is not supported.
+    */
+    static void WriteData(uint8 dimension, eInterpolation interpolation, eCompression compression, const Vector<float32>& keyTimes, const Vector<float32>& keyValues, Vector<uint8>& outData, float32 tolerance = 0.0001f);
+
     uint32 Bind(const uint8* data);
-    void Evaluate(float32 time, float32* outData, uint32 dataSize) const;
+
+    /**
+        Evaluate channel value at `time`.
+        `keyCursor` keeps index of key sampled last time, with cursor keys are found in O(1) for forward playback,
+        without it keys are found by binary search. Use separate cursor for every user of channel.
+    */
+    void Evaluate(float32 time, float32* outData, uint32 dataSize, uint32* keyCursor = nullptr) const;
 
     uint32 GetDimension() const;
+    uint32 GetKeysCount() const;
+    eCompression GetCompression() const;
 
 private:
+    uint32 FindKey(float32 time, uint32* keyCursor) const;
+    uint32 FindKeyBinary(uint32 begin, uint32 end, float32 time) const;
+
+    float32 GetKeyTime(uint32 key) const;
+    void GetKeyValue(uint32 key, float32* outData) const;
+
+    //uncompressed data
     const DAVA::uint8* keysData = nullptr;
-    mutable uint32 startKey = 0;
-    uint32 keysCount = 0;
     uint32 keyStride = 0;
-    uint16 compression = 0;
+
+    //quantized data
+    const uint16* quantizedTimes = nullptr;
+    const uint16* quantizedValues = nullptr;
+    const float32* valuesRange = nullptr; //[dimension] minimums followed by [dimension] scales
+    float32 timeStart = 0.f;
+    float32 timeScale = 0.f;
+
+    uint32 keysCount = 0;
+    eCompression compression = COMPRESSION_NONE;
     uint8 dimension = 0;
     eInterpolation interpolation = INTERPOLATION_COUNT;
 };
@@ -39,4 +77,14 @@ inline uint32 AnimationChannel::GetDimension() const
 {
     return uint32(dimension);
 }
-}
\ No newline at end of file
+
+inline uint32 AnimationChannel::GetKeysCount() const
+{
+    return keysCount;
+}
+
+inline AnimationChannel::eCompression AnimationChannel::GetCompression() const
+{
+    return compression;
+}
+}
@@ -41,10 +41,13 @@ uint32 AnimationTrack::Bind(const uint8* _data)
     return uint32(dataptr - _data);
 }
 
-void AnimationTrack::Evaluate(float32 time, uint32 channel, float32* outData, uint32 dataSize) const
+void AnimationTrack::Evaluate(float32 time, uint32 channel, float32* outData, uint32 dataSize, Cursor* cursor) const
 {
     DVASSERT(channel < GetChannelsCount());
-    channels[channel].channel.Evaluate(time, outData, dataSize);
+
+    //usually track has one channel per target, cursor doesn't track extra channels
+    uint32* keyCursor = (cursor != nullptr && channel < CHANNEL_TARGET_COUNT) ? &cursor->keys[channel] : nullptr;
+    channels[channel].channel.Evaluate(time, outData, dataSize, keyCursor);
 }
 
 uint32 AnimationTrack::GetChannelsCount() const
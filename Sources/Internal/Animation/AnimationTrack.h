@@ -18,8 +18,17 @@ public:
         CHANNEL_TARGET_COUNT
     };
 
+    /**
+        Sampling state of one user of track: indices of keys sampled last time in each channel.
+        Evaluation with cursor finds keys in O(1) for forward playback. Keep separate cursor for every animated object.
+    */
+    struct Cursor
+    {
+        uint32 keys[CHANNEL_TARGET_COUNT] = {};
+    };
+
     uint32 Bind(const uint8* data);
-    void Evaluate(float32 time, uint32 channel, float32* outData, uint32 dataSize) const;
+    void Evaluate(float32 time, uint32 channel, float32* outData, uint32 dataSize, Cursor* cursor = nullptr) const;
 
     uint32 GetChannelsCount() const;
     eChannelTarget GetChannelTarget(uint32 channel) const;
@@ -0,0 +1,155 @@
+#include "Base/FrameArena.h"
+#include "Debug/DVAssert.h"
+#include "MemoryManager/MemoryProfiler.h"
+
+namespace DAVA
+{
+namespace FrameArenaDetails
+{
+inline uint8* AlignPointer(uint8* ptr, size_t align)
+{
+    return reinterpret_cast<uint8*>((reinterpret_cast<uintptr_t>(ptr) + align - 1) & ~(uintptr_t(align) - 1));
+}
+}
+
+void* FrameArenaAllocate(FrameArena* arena, size_t size, size_t align)
+{
+    DVASSERT(arena != nullptr);
+    return arena->Allocate(size, align);
+}
+
+FrameArena::FrameArena(uint32 bufferCount_, size_t chunkSize_)
+    : chunkSize(chunkSize_)
+{
+    DVASSERT(chunkSize > 0);
+    SetBufferCount(bufferCount_);
+}
+
+FrameArena::~FrameArena()
+{
+    for (Buffer& buffer : buffers)
+    {
+        ReleaseBuffer(buffer);
+    }
+}
+
+void* FrameArena::Allocate(size_t size, size_t align)
+{
+    using namespace FrameArenaDetails;
+
+    DVASSERT(align > 0 && (align & (align - 1)) == 0);
+
+    Buffer& buffer = buffers[currentBuffer];
+    if (!buffer.chunks.empty())
+    {
+        const Chunk& chunk = buffer.chunks.back();
+        uint8* begin = chunk.data + buffer.chunkOffset;
+        uint8* ptr = AlignPointer(begin, align);
+        if (ptr + size <= chunk.data + chunk.size)
+        {
+            buffer.chunkOffset = static_cast<size_t>(ptr + size - chunk.data);
+            buffer.usedSize += static_cast<size_t>(ptr + size - begin);
+            return ptr;
+        }
+    }
+    return AllocateInNewChunk(buffer, size, align);
+}
+
+void* FrameArena::AllocateInNewChunk(Buffer& buffer, size_t size, size_t align)
+{
+    using namespace FrameArenaDetails;
+
+    // chunk memory is aligned to max_align_t, so greater alignment may require padding
+    size_t requiredSize = size + (align > alignof(std::max_align_t) ? align : 0);
+
+    Chunk chunk;
+    chunk.size = std::max(chunkSize, requiredSize);
+    chunk.data = AllocateChunkMemory(chunk.size);
+    buffer.chunks.push_back(chunk);
+
+    uint8* ptr = AlignPointer(chunk.data, align);
+    buffer.chunkOffset = static_cast<size_t>(ptr + size - chunk.data);
+    buffer.usedSize += buffer.chunkOffset;
+    return ptr;
+}
+
+void FrameArena::BeginFrame()
+{
+    highWaterMark = std::max(highWaterMark, buffers[currentBuffer].usedSize);
+
+    currentBuffer = (currentBuffer + 1) % bufferCount;
+    frameIndex += 1;
+    ResetBuffer(buffers[currentBuffer]);
+}
+
+void FrameArena::SetBufferCount(uint32 bufferCount_)
+{
+    DVASSERT(bufferCount_ > 0);
+
+    for (Buffer& buffer : buffers)
+    {
+        ReleaseBuffer(buffer);
+    }
+
+    bufferCount = (bufferCount_ < MAX_BUFFER_COUNT) ? std::max(bufferCount_, 1u) : MAX_BUFFER_COUNT;
+    currentBuffer = 0;
+    frameIndex += 1;
+}
+
+size_t FrameArena::GetReservedSize() const
+{
+    size_t reservedSize = 0;
+    for (const Buffer& buffer : buffers)
+    {
+        for (const Chunk& chunk : buffer.chunks)
+        {
+            reservedSize += chunk.size;
+        }
+    }
+    return reservedSize;
+}
+
+void FrameArena::ResetBuffer(Buffer& buffer)
+{
+    // merge chunks into one to serve the next frame with single chunk
+    if (buffer.chunks.size() > 1)
+    {
+        size_t totalSize = 0;
+        for (const Chunk& chunk : buffer.chunks)
+        {
+            totalSize += chunk.size;
+        }
+        ReleaseBuffer(buffer);
+
+        Chunk chunk;
+        chunk.size = totalSize;
+        chunk.data = AllocateChunkMemory(totalSize);
+        buffer.chunks.push_back(chunk);
+    }
+
+    buffer.chunkOffset = 0;
+    buffer.usedSize = 0;
+}
+
+void FrameArena::ReleaseBuffer(Buffer& buffer)
+{
+    for (const Chunk& chunk : buffer.chunks)
+    {
+        FreeChunkMemory(chunk.data);
+    }
+    buffer.chunks.clear();
+    buffer.chunkOffset = 0;
+    buffer.usedSize = 0;
+}
+
+uint8* FrameArena::AllocateChunkMemory(size_t size)
+{
+    DAVA_MEMORY_PROFILER_ALLOC_SCOPE(ALLOC_POOL_FRAME_ARENA);
+    return new uint8[size];
+}
+
+void FrameArena::FreeChunkMemory(uint8* data)
+{
+    delete[] data;
+}
+} // namespace DAVA
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/STLAllocator.h"
+
+namespace DAVA
+{
+/**
+    Linear allocator for data which lives no longer than one frame.
+
+    Memory is taken from one of `bufferCount` buffers by bumping pointer and is never freed individually.
+    `BeginFrame` switches arena to the next buffer and resets it, so memory allocated during frame stays valid
+    for `bufferCount - 1` next frames. It allows to pass frame data to render thread which lags behind the main thread
+    (use RHI threaded frame count + 1 as number of buffers).
+
+    When buffer runs out of space it takes new chunk of memory, on reset all chunks of buffer are merged into one
+    chunk large enough for the whole frame. So after first frames arena works without any system allocations.
+    Chunks are allocated in `ALLOC_POOL_FRAME_ARENA` memory pool, so its stats in memory profiler show high-water
+    marks of arenas.
+
+    Arena is not thread-safe, all allocations and `BeginFrame` calls should be made from the same thread.
+*/
+class FrameArena final
+{
+public:
+    static const uint32 MAX_BUFFER_COUNT = 4;
+    static const size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+    explicit FrameArena(uint32 bufferCount = 1, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /** Allocate `size` bytes aligned to `align` in current buffer. `align` should be power of two. */
+    void* Allocate(size_t size, size_t align = alignof(std::max_align_t));
+
+    /** Switch to the next buffer and discard all allocations made in it `bufferCount` frames ago. */
+    void BeginFrame();
+
+    /** Release memory of all buffers and set new number of buffers (clamped to MAX_BUFFER_COUNT). All previous allocations become invalid. */
+    void SetBufferCount(uint32 bufferCount);
+    uint32 GetBufferCount() const;
+
+    /** Return number of `BeginFrame` calls, can be used to check whether memory allocated earlier is still valid. */
+    uint32 GetFrameIndex() const;
+
+    /** Return number of bytes allocated in current frame. */
+    size_t GetUsedSize() const;
+
+    /** Return max number of bytes allocated in one frame. */
+    size_t GetHighWaterMark() const;
+
+    /** Return number of bytes reserved by all buffers. */
+    size_t GetReservedSize() const;
+
+private:
+    struct Chunk
+    {
+        uint8* data = nullptr;
+        size_t size = 0;
+    };
+
+    struct Buffer
+    {
+        Vector<Chunk> chunks;
+        size_t chunkOffset = 0; // offset of free memory in last chunk
+        size_t usedSize = 0;
+    };
+
+    void* AllocateInNewChunk(Buffer& buffer, size_t size, size_t align);
+    void ResetBuffer(Buffer& buffer);
+    void ReleaseBuffer(Buffer& buffer);
+
+    static uint8* AllocateChunkMemory(size_t size);
+    static void FreeChunkMemory(uint8* data);
+
+    Buffer buffers[MAX_BUFFER_COUNT];
+    uint32 bufferCount = 1;
+    uint32 currentBuffer = 0;
+    uint32 frameIndex = 0;
+    size_t chunkSize = DEFAULT_CHUNK_SIZE;
+    size_t highWaterMark = 0;
+};
+
+/** Vector with storage in frame arena, it should not be used after its buffer is reset by `FrameArena::BeginFrame`. */
+template <typename T>
+using FrameVector = std::vector<T, FrameArenaAllocator<T>>;
+
+inline uint32 FrameArena::GetBufferCount() const
+{
+    return bufferCount;
+}
+
+inline uint32 FrameArena::GetFrameIndex() const
+{
+    return frameIndex;
+}
+
+inline size_t FrameArena::GetUsedSize() const
+{
+    return buffers[currentBuffer].usedSize;
+}
+
+inline size_t FrameArena::GetHighWaterMark() const
+{
+    return std::max(highWaterMark, GetUsedSize());
+}
+} // namespace DAVA
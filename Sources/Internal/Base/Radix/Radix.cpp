@@ -102,4 +102,50 @@ void RadixSortImpl(intptr_t* array, int offset, int end, int shift)
         }
     }
 }
+
+void RadixSort(RadixSortItem* items, RadixSortItem* temp, uint32 count)
+{
+    const uint32 keyBytes = sizeof(uint64);
+
+    uint32 histograms[keyBytes][256] = {};
+    for (uint32 i = 0; i < count; ++i)
+    {
+        uint64 key = items[i].key;
+        for (uint32 b = 0; b < keyBytes; ++b)
+        {
+            ++histograms[b][(key >> (b * 8)) & 0xFF];
+        }
+    }
+
+    RadixSortItem* src = items;
+    RadixSortItem* dst = temp;
+    for (uint32 b = 0; b < keyBytes && count > 0; ++b)
+    {
+        uint32* histogram = histograms[b];
+        uint32 shift = b * 8;
+        if (histogram[(src[0].key >> shift) & 0xFF] == count)
+        {
+            continue;
+        }
+
+        uint32 offset = 0;
+        for (uint32 x = 0; x < 256; ++x)
+        {
+            uint32 bucketSize = histogram[x];
+            histogram[x] = offset;
+            offset += bucketSize;
+        }
+
+        for (uint32 i = 0; i < count; ++i)
+        {
+            dst[histogram[(src[i].key >> shift) & 0xFF]++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    if (src != items)
+    {
+        std::copy(src, src + count, items);
+    }
+}
 }
@@ -40,6 +40,19 @@ inline void RadixSort(void* array, int offset, int end, int shift)
 
     RadixSortImpl(static_cast<intptr_t*>(array), offset, end, shift);
 }
+
+struct RadixSortItem
+{
+    uint64 key;
+    uint32 value;
+};
+
+/*
+    Stable LSD radix sort of `count` items in ascending order of their 64-bit keys.
+    `temp` should point to buffer of at least `count` items. Passes over key bytes which
+    are equal for all items are skipped, so keys with narrow ranges of values are sorted faster.
+*/
+void RadixSort(RadixSortItem* items, RadixSortItem* temp, uint32 count);
 };
 
 #endif // __DAVAENGINE_BASE_RADIX_RADIX__
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 
 namespace DAVA
@@ -13,4 +14,74 @@ using DefaultSTLAllocator = std::allocator<T>;
 template <typename T>
 using DefaultSTLAllocator = std::allocator<T>;
 #endif
+
+class FrameArena;
+void* FrameArenaAllocate(FrameArena* arena, size_t size, size_t align);
+
+/**
+    Allocator which takes memory from `FrameArena`, deallocation does nothing.
+    Containers using it should not outlive the frame they were filled in (see `FrameArena`).
+*/
+template <typename T>
+class FrameArenaAllocator
+{
+public:
+    using value_type = T;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using reference = T&;
+    using const_reference = const T&;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef FrameArenaAllocator<U> other;
+    };
+
+    explicit FrameArenaAllocator(FrameArena* arena_) noexcept
+        : arena(arena_)
+    {
+    }
+
+    template <typename U>
+    FrameArenaAllocator(const FrameArenaAllocator<U>& other) noexcept
+        : arena(other.GetArena())
+    {
+    }
+
+    pointer allocate(size_type n)
+    {
+        return static_cast<pointer>(FrameArenaAllocate(arena, n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(pointer ptr, size_type n)
+    {
+    }
+
+    FrameArena* GetArena() const
+    {
+        return arena;
+    }
+
+private:
+    FrameArena* arena = nullptr;
+};
+
+template <typename T, typename U>
+inline bool operator==(const FrameArenaAllocator<T>& l, const FrameArenaAllocator<U>& r)
+{
+    return l.GetArena() == r.GetArena();
+}
+
+template <typename T, typename U>
+inline bool operator!=(const FrameArenaAllocator<T>& l, const FrameArenaAllocator<U>& r)
+{
+    return l.GetArena() != r.GetArena();
+}
 }
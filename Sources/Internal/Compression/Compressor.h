@@ -13,6 +13,7 @@ public:
         Lz4,
         Lz4HC,
         RFC1951, // deflate, inflate
+        Lz4Dict, // lz4hc with preset dictionary, see LZ4DictCompressor
     };
 
     virtual ~Compressor();
@@ -20,6 +21,8 @@ public:
     virtual bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const = 0;
     // you should resize output to correct size before call this method
     virtual bool Decompress(const Vector<uint8>& in, Vector<uint8>& out) const = 0;
+    // same as above but works with raw memory (e.g. memory-mapped file), out should point to outSize bytes of decompressed content
+    virtual bool Decompress(const uint8* in, uint32 inSize, uint8* out, uint32 outSize) const = 0;
 };
 
 } // end namespace DAVA
@@ -0,0 +1,128 @@
+#include "Compression/DictionaryTrainer.h"
+#include "Base/UnordererMap.h"
+#include "Base/UnordererSet.h"
+
+namespace DAVA
+{
+namespace DictionaryTrainerDetails
+{
+// byte sequences of DMER_SIZE bytes are counted, segments of SEGMENT_SIZE bytes are selected into dictionary
+const uint32 DMER_SIZE = sizeof(uint64);
+const uint32 SEGMENT_SIZE = 256;
+const uint32 SEGMENT_STEP = 16;
+
+uint64 ReadDmer(const uint8* data)
+{
+    uint64 dmer;
+    Memcpy(&dmer, data, DMER_SIZE);
+    return dmer;
+}
+
+struct Segment
+{
+    uint32 begin;
+    uint32 score;
+};
+}
+
+namespace DictionaryTrainer
+{
+Vector<uint8> Train(const Vector<Vector<uint8>>& samples, uint32 dictionarySize)
+{
+    using namespace DictionaryTrainerDetails;
+
+    Vector<uint8> corpus;
+    for (const Vector<uint8>& sample : samples)
+    {
+        corpus.insert(corpus.end(), sample.begin(), sample.end());
+    }
+
+    if (corpus.size() <= dictionarySize)
+    {
+        // everything fits into dictionary
+        return corpus;
+    }
+
+    // count number of samples containing every dmer, dmers met in one sample only are useless
+    UnorderedMap<uint64, uint32> frequencies;
+    UnorderedSet<uint64> sampleDmers;
+    for (const Vector<uint8>& sample : samples)
+    {
+        sampleDmers.clear();
+        for (size_t i = 0; i + DMER_SIZE <= sample.size(); ++i)
+        {
+            sampleDmers.insert(ReadDmer(&sample[i]));
+        }
+        for (uint64 dmer : sampleDmers)
+        {
+            ++frequencies[dmer];
+        }
+    }
+
+    auto scoreSegment = [&](uint32 begin) {
+        uint32 score = 0;
+        sampleDmers.clear();
+        for (uint32 i = begin; i + DMER_SIZE <= begin + SEGMENT_SIZE; ++i)
+        {
+            uint64 dmer = ReadDmer(&corpus[i]);
+            if (sampleDmers.insert(dmer).second)
+            {
+                auto found = frequencies.find(dmer);
+                if (found != frequencies.end() && found->second > 1)
+                {
+                    score += found->second;
+                }
+            }
+        }
+        return score;
+    };
+
+    // take best segment from every epoch (equal part of corpus)
+    const uint32 corpusSize = static_cast<uint32>(corpus.size());
+    const uint32 epochsCount = std::max(dictionarySize / SEGMENT_SIZE, 1u);
+    const uint32 epochSize = std::max(corpusSize / epochsCount, SEGMENT_SIZE);
+
+    Vector<Segment> segments;
+    for (uint32 epochBegin = 0; epochBegin + SEGMENT_SIZE <= corpusSize; epochBegin += epochSize)
+    {
+        const uint32 epochEnd = std::min(epochBegin + epochSize, corpusSize);
+
+        Segment best = { epochBegin, 0 };
+        for (uint32 begin = epochBegin; begin + SEGMENT_SIZE <= epochEnd; begin += SEGMENT_STEP)
+        {
+            uint32 score = scoreSegment(begin);
+            if (score > best.score)
+            {
+                best = { begin, score };
+            }
+        }
+
+        if (best.score > 0)
+        {
+            segments.push_back(best);
+
+            // content of selected segment is already in dictionary, don't select it again
+            for (uint32 i = best.begin; i + DMER_SIZE <= best.begin + SEGMENT_SIZE; ++i)
+            {
+                frequencies.erase(ReadDmer(&corpus[i]));
+            }
+        }
+    }
+
+    std::stable_sort(segments.begin(), segments.end(), [](const Segment& l, const Segment& r) { return l.score < r.score; });
+
+    // when there are more segments than fits, the least valuable ones are dropped
+    const size_t segmentsToSkip = segments.size() - std::min(segments.size(), static_cast<size_t>(dictionarySize / SEGMENT_SIZE));
+
+    Vector<uint8> dictionary;
+    dictionary.reserve(dictionarySize);
+    for (size_t i = segmentsToSkip; i < segments.size(); ++i)
+    {
+        auto segmentBegin = corpus.begin() + segments[i].begin;
+        dictionary.insert(dictionary.end(), segmentBegin, segmentBegin + SEGMENT_SIZE);
+    }
+
+    return dictionary;
+}
+}
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+namespace DAVA
+{
+namespace DictionaryTrainer
+{
+/**
+    Build compression dictionary of at most `dictionarySize` bytes from `samples`.
+
+    Samples are split into `dictionarySize / SEGMENT_SIZE` equal ranges and the segment
+    covering the most frequent (across samples) byte sequences is taken from every range.
+    Segments are placed in order of increasing score, so the most valuable content is
+    at the end of dictionary, closest to compressed data.
+    Return empty vector if there is nothing worth to put into dictionary.
+*/
+Vector<uint8> Train(const Vector<Vector<uint8>>& samples, uint32 dictionarySize);
+}
+}
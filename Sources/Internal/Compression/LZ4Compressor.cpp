@@ -1,5 +1,6 @@
 #include "Compression/LZ4Compressor.h"
 #include "Logger/Logger.h"
+#include "Concurrency/LockGuard.h"
 
 #include <lz4/lz4.h>
 #include <lz4/lz4hc.h>
@@ -31,7 +32,12 @@ bool LZ4Compressor::Compress(const Vector<uint8>& in, Vector<uint8>& out) const
 
 bool LZ4Compressor::Decompress(const Vector<uint8>& in, Vector<uint8>& out) const
 {
-    int32 decompressResult = LZ4_decompress_fast(reinterpret_cast<const char*>(in.data()), reinterpret_cast<char*>(out.data()), static_cast<uint32>(out.size()));
+    return Decompress(in.data(), static_cast<uint32>(in.size()), out.data(), static_cast<uint32>(out.size()));
+}
+
+bool LZ4Compressor::Decompress(const uint8* in, uint32 inSize, uint8* out, uint32 outSize) const
+{
+    int32 decompressResult = LZ4_decompress_fast(reinterpret_cast<const char*>(in), reinterpret_cast<char*>(out), outSize);
     if (decompressResult < 0)
     {
         Logger::Error("LZ4 decompress failed");
@@ -66,4 +72,156 @@ bool LZ4HCCompressor::Compress(const Vector<uint8>& in, Vector<uint8>& out) cons
     return true;
 }
 
+const uint32 LZ4DictCompressor::MAX_DICTIONARY_SIZE;
+
+namespace LZ4CompressorDetails
+{
+// windows for bigger content are freed after use to not hold memory of rare big files
+const size_t MAX_POOLED_WINDOW_SIZE = 1024 * 1024;
+}
+
+/**
+    Buffer with dictionary followed by space for content. LZ4 takes history from memory right before
+    compressed or decompressed content, so content is placed right after dictionary.
+*/
+struct LZ4DictCompressor::Window
+{
+    Vector<uint8> buffer;
+    // lz4hc state after compression of dictionary, it points into buffer and is valid while buffer isn't reallocated
+    Vector<uint8> primedState;
+    const uint8* primedBuffer = nullptr;
+    Vector<uint8> state;
+};
+
+LZ4DictCompressor::LZ4DictCompressor(const Vector<uint8>& dictionary_)
+{
+    // lz4 can't reference data farther than 64Kb back, so keep only the tail of dictionary
+    size_t dictionarySize = std::min(dictionary_.size(), static_cast<size_t>(MAX_DICTIONARY_SIZE));
+    dictionary.assign(dictionary_.end() - dictionarySize, dictionary_.end());
+}
+
+LZ4DictCompressor::~LZ4DictCompressor() = default;
+
+const Vector<uint8>& LZ4DictCompressor::GetDictionary() const
+{
+    return dictionary;
+}
+
+std::unique_ptr<LZ4DictCompressor::Window> LZ4DictCompressor::AcquireWindow(uint32 contentSize) const
+{
+    std::unique_ptr<Window> window;
+    {
+        LockGuard<Mutex> lock(windowsMutex);
+        if (!freeWindows.empty())
+        {
+            window = std::move(freeWindows.back());
+            freeWindows.pop_back();
+        }
+    }
+
+    if (!window)
+    {
+        window.reset(new Window());
+        window->buffer = dictionary;
+    }
+
+    // growing keeps dictionary in the beginning of buffer
+    size_t windowSize = dictionary.size() + contentSize;
+    if (window->buffer.size() < windowSize)
+    {
+        window->buffer.resize(windowSize);
+    }
+    return window;
+}
+
+void LZ4DictCompressor::ReleaseWindow(std::unique_ptr<Window> window) const
+{
+    if (window->buffer.size() <= LZ4CompressorDetails::MAX_POOLED_WINDOW_SIZE)
+    {
+        LockGuard<Mutex> lock(windowsMutex);
+        freeWindows.push_back(std::move(window));
+    }
+}
+
+bool LZ4DictCompressor::Compress(const Vector<uint8>& in, Vector<uint8>& out) const
+{
+    if (in.size() > LZ4_MAX_INPUT_SIZE - dictionary.size())
+    {
+        Logger::Error("LZ4 compress failed too big input buffer");
+        return false;
+    }
+    if (in.empty())
+    {
+        Logger::Error("LZ4 can't compress empty buffer");
+        return false;
+    }
+
+    int32 dictionarySize = static_cast<int32>(dictionary.size());
+    int32 inSize = static_cast<int32>(in.size());
+    uint32 maxSize = static_cast<uint32>(LZ4_compressBound(std::max(dictionarySize, inSize)));
+    if (out.size() < maxSize)
+    {
+        out.resize(maxSize);
+    }
+
+    std::unique_ptr<Window> window = AcquireWindow(static_cast<uint32>(in.size()));
+    char* windowData = reinterpret_cast<char*>(window->buffer.data());
+
+    if (window->primedBuffer != window->buffer.data())
+    {
+        // stream compressor requires blocks to follow each other, so compress dictionary once
+        // to fill compressor history and keep that state for all next files, result is dropped
+        window->primedBuffer = nullptr;
+        window->primedState.resize(static_cast<size_t>(LZ4_sizeofStreamStateHC()));
+        if (LZ4_resetStreamStateHC(window->primedState.data(), windowData) != 0 ||
+            (dictionarySize > 0 && LZ4_compressHC_continue(window->primedState.data(), windowData, reinterpret_cast<char*>(out.data()), dictionarySize) == 0))
+        {
+            Logger::Error("LZ4 can't prepare compression state with dictionary");
+            ReleaseWindow(std::move(window));
+            return false;
+        }
+        window->primedBuffer = window->buffer.data();
+    }
+
+    window->state = window->primedState;
+    std::copy(in.begin(), in.end(), window->buffer.begin() + dictionarySize);
+
+    int32 compressedSize = LZ4_compressHC_continue(window->state.data(), windowData + dictionarySize, reinterpret_cast<char*>(out.data()), inSize);
+    ReleaseWindow(std::move(window));
+
+    if (compressedSize == 0)
+    {
+        return false;
+    }
+    out.resize(static_cast<uint32>(compressedSize));
+    return true;
+}
+
+bool LZ4DictCompressor::Decompress(const Vector<uint8>& in, Vector<uint8>& out) const
+{
+    return Decompress(in.data(), static_cast<uint32>(in.size()), out.data(), static_cast<uint32>(out.size()));
+}
+
+bool LZ4DictCompressor::Decompress(const uint8* in, uint32 inSize, uint8* out, uint32 outSize) const
+{
+    // decoder takes history from memory right before output, so decompress right after dictionary in window
+    std::unique_ptr<Window> window = AcquireWindow(outSize);
+    char* windowOut = reinterpret_cast<char*>(window->buffer.data() + dictionary.size());
+
+    int32 decompressResult = LZ4_decompress_safe_withPrefix64k(reinterpret_cast<const char*>(in), windowOut, static_cast<int32>(inSize), static_cast<int32>(outSize));
+    bool decompressed = (decompressResult == static_cast<int32>(outSize));
+    if (decompressed)
+    {
+        Memcpy(out, windowOut, outSize);
+    }
+    ReleaseWindow(std::move(window));
+
+    if (!decompressed)
+    {
+        Logger::Error("LZ4 decompress with dictionary failed");
+        return false;
+    }
+    return true;
+}
+
 } // end namespace DAVA
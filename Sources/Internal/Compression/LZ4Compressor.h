@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Compression/Compressor.h"
+#include "Concurrency/Mutex.h"
 
 namespace DAVA
 {
@@ -10,6 +11,7 @@ public:
     bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const override;
     // you should resize output to correct size before call this method
     bool Decompress(const Vector<uint8>& in, Vector<uint8>& out) const override;
+    bool Decompress(const uint8* in, uint32 inSize, uint8* out, uint32 outSize) const override;
 };
 
 class LZ4HCCompressor final : public LZ4Compressor
@@ -18,4 +20,39 @@ public:
     bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const override;
 };
 
+/**
+    LZ4HC compressor with preset dictionary.
+    Dictionary is used as a history preceding compressed content, so small files with
+    content similar to dictionary (e.g. yaml, materials) compress much better.
+    Only last `MAX_DICTIONARY_SIZE` bytes of dictionary can be referenced by LZ4.
+    Same dictionary should be used to compress and decompress content.
+    Compressor can be used from several threads at once, it keeps pool of buffers with dictionary
+    (and compression state primed by dictionary) to not prepare them on every call.
+*/
+class LZ4DictCompressor final : public Compressor
+{
+public:
+    static const uint32 MAX_DICTIONARY_SIZE = 64 * 1024;
+
+    explicit LZ4DictCompressor(const Vector<uint8>& dictionary);
+    ~LZ4DictCompressor() override;
+
+    const Vector<uint8>& GetDictionary() const;
+
+    bool Compress(const Vector<uint8>& in, Vector<uint8>& out) const override;
+    // you should resize output to correct size before call this method
+    bool Decompress(const Vector<uint8>& in, Vector<uint8>& out) const override;
+    bool Decompress(const uint8* in, uint32 inSize, uint8* out, uint32 outSize) const override;
+
+private:
+    struct Window;
+
+    std::unique_ptr<Window> AcquireWindow(uint32 contentSize) const;
+    void ReleaseWindow(std::unique_ptr<Window> window) const;
+
+    Vector<uint8> dictionary;
+    mutable Mutex windowsMutex;
+    mutable Vector<std::unique_ptr<Window>> freeWindows;
+};
+
 } // end namespace DAVA
@@ -2,8 +2,7 @@
 
 #include "Base/BaseTypes.h"
 
-#include "Concurrency/Mutex.h"
-#include "Concurrency/LockGuard.h"
+#include "Concurrency/MPSCQueue.h"
 #include "Concurrency/Semaphore.h"
 #include "Concurrency/AutoResetEvent.h"
 #include "Concurrency/Thread.h"
@@ -23,6 +22,9 @@ namespace DAVA
     Dispatcher manages event queue and provides methods to place events to queue and extract events from queue.
     Application can place events from any thread, but extraction **must** be performed only from single thread
     which should stay the same until dispatcher dies. Event extraction thread is set by `LinkToCurrentThread` method.
+
+    Event queue is lock-free (see `MPSCQueue`): posting threads do not block each other and `ProcessEvents`
+    takes all queued events at once.
 */
 template <typename T>
 class Dispatcher final
@@ -86,9 +88,21 @@ public:
     void ViewEventQueue(const Function<void(const T&)>& viewer);
 
 private:
-    mutable Mutex mutex; // Mutex to guard event queue
-    Vector<T> eventQueue;
-    Vector<T> readyEvents;
+    struct QueuedEvent
+    {
+        template <typename U>
+        QueuedEvent(U&& e, bool blocking)
+            : event(std::forward<U>(e))
+            , blocking(blocking)
+        {
+        }
+
+        T event;
+        bool blocking; // event is placed by blocking SendEvent, sender waits for its procession
+    };
+
+    MPSCQueue<QueuedEvent> eventQueue;
+    Vector<QueuedEvent> readyEvents;
     Function<void(const T&)> eventHandler;
     Function<void()> sendEventTrigger;
     size_t curEventIndex = 0;
@@ -96,7 +110,6 @@ private:
     uint64 linkedThreadId = 0; // Identifier of thread that calls Dispatcher::ProcessEvents method
     Semaphore semaphore; // Semaphore to ensure only one blocking call
     AutoResetEvent signalEvent; // Event to signal about blocking call completion
-    bool blockingCallInQueue = false; // Flag indicating that queue contains blocking event
     bool processEventsInProgress = false; // Flag indicating that ProcessEvents in progress to prevent nested event processing
 };
 
@@ -123,16 +136,14 @@ uint64 Dispatcher<T>::GetLinkedThread() const
 template <typename T>
 bool Dispatcher<T>::HasEvents() const
 {
-    LockGuard<Mutex> lock(mutex);
-    return !eventQueue.empty();
+    return !eventQueue.IsEmpty();
 }
 
 template <typename T>
 template <typename U>
 void Dispatcher<T>::PostEvent(U&& e)
 {
-    LockGuard<Mutex> lock(mutex);
-    eventQueue.emplace_back(std::forward<U>(e));
+    eventQueue.Push(QueuedEvent(std::forward<U>(e), false));
 }
 
 template <typename T>
@@ -147,12 +158,7 @@ void Dispatcher<T>::SendEvent(U&& e, eSendPolicy policy)
         switch (policy)
         {
         case eSendPolicy::QUEUED_EXECUTION:
-            // clang-format off
-            {
-                LockGuard<Mutex> lock(mutex);
-                eventQueue.emplace_back(std::forward<U>(e));
-            }
-            // clang-format on
+            eventQueue.Push(QueuedEvent(std::forward<U>(e), false));
             ProcessEvents();
             break;
         case eSendPolicy::IMMEDIATE_EXECUTION:
@@ -168,11 +174,7 @@ void Dispatcher<T>::SendEvent(U&& e, eSendPolicy policy)
         // Wait till current blocking call completion if any
         semaphore.Wait();
 
-        {
-            LockGuard<Mutex> lock(mutex);
-            eventQueue.emplace_back(std::forward<U>(e));
-            blockingCallInQueue = true;
-        }
+        eventQueue.Push(QueuedEvent(std::forward<U>(e), true));
 
         DAVA_BEGIN_BLOCKING_CALL(linkedThreadId);
 
@@ -192,16 +194,13 @@ void Dispatcher<T>::ProcessEvents()
 
     bool shouldCompleteBlockingCall = false;
     processEventsInProgress = true;
-    {
-        LockGuard<Mutex> lock(mutex);
-        eventQueue.swap(readyEvents);
-        std::swap(blockingCallInQueue, shouldCompleteBlockingCall);
-    }
+    eventQueue.PopAll(readyEvents);
 
     curEventIndex = 0;
-    for (const T& w : readyEvents)
+    for (const QueuedEvent& w : readyEvents)
     {
-        eventHandler(w);
+        eventHandler(w.event);
+        shouldCompleteBlockingCall |= w.blocking;
         curEventIndex += 1;
     }
     readyEvents.clear();
@@ -217,7 +216,7 @@ void Dispatcher<T>::ViewEventQueue(const Function<void(const T&)>& viewer)
 {
     for (size_t i = curEventIndex + 1, n = readyEvents.size(); i < n; ++i)
     {
-        viewer(readyEvents[i]);
+        viewer(readyEvents[i].event);
     }
 }
 
@@ -0,0 +1,248 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Concurrency/Mutex.h"
+#include "Concurrency/LockGuard.h"
+
+#include <atomic>
+
+namespace DAVA
+{
+/**
+    Unbounded lock-free multiple-producer single-consumer queue.
+
+    Producers push elements from any thread with single CAS on queue head, consumer takes all pushed elements
+    at once with single atomic exchange (see `PopAll`) and receives them in order of pushing. Elements pushed
+    by one thread are always received in the same order they were pushed.
+
+    Nodes are allocated in chunks and reused: `PopAll` returns nodes into lock-free free list and `Push` takes
+    node from it, so queue allocates memory only when number of elements in flight grows. Free list head holds
+    node index with modification tag to protect it from ABA problem.
+*/
+template <typename T>
+class MPSCQueue final
+{
+public:
+    MPSCQueue() = default;
+    ~MPSCQueue();
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    /** Push element into queue. Can be called from any thread. */
+    template <typename U>
+    void Push(U&& value);
+
+    /** Check whether queue has elements. */
+    bool IsEmpty() const;
+
+    /**
+        Move all elements currently in queue to the end of `output` in order of pushing.
+        Return number of moved elements.
+    */
+    size_t PopAll(Vector<T>& output);
+
+private:
+    struct Node
+    {
+        T* Value()
+        {
+            return reinterpret_cast<T*>(&storage);
+        }
+
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        Node* next = nullptr;
+        // index + 1 of next node in free list, 0 - end of list
+        std::atomic<uint32> nextFree{ 0 };
+        uint32 index = NOT_POOLED;
+    };
+
+    static const uint32 NODES_PER_CHUNK = 64;
+    // up to 64K nodes are pooled, nodes above that limit are allocated one by one and deleted after pop
+    static const uint32 MAX_CHUNKS = 1024;
+    static const uint32 NOT_POOLED = ~0u;
+
+    Node* AcquireNode();
+    Node* AllocateNodes();
+    // return list of nodes linked by `next` into free list or delete them if they aren't pooled
+    void ReleaseNodes(Node* list);
+    void ReleasePooledNodes(Node* first, Node* last);
+    Node* GetPooledNode(uint32 index) const;
+
+    // last pushed node, nodes are linked from newer to older ones
+    std::atomic<Node*> head{ nullptr };
+
+    // (tag << 32) | (index + 1) of first free node, index 0 - free list is empty
+    std::atomic<uint64> freeHead{ 0 };
+
+    Mutex chunksMutex;
+    Node* chunks[MAX_CHUNKS] = {};
+    uint32 chunksCount = 0;
+};
+
+template <typename T>
+MPSCQueue<T>::~MPSCQueue()
+{
+    Node* list = head.exchange(nullptr, std::memory_order_acquire);
+    while (list != nullptr)
+    {
+        Node* next = list->next;
+        list->Value()->~T();
+        if (list->index == NOT_POOLED)
+        {
+            delete list;
+        }
+        list = next;
+    }
+
+    for (uint32 i = 0; i < chunksCount; ++i)
+    {
+        delete[] chunks[i];
+    }
+}
+
+template <typename T>
+template <typename U>
+void MPSCQueue<T>::Push(U&& value)
+{
+    Node* node = AcquireNode();
+    new (node->Value()) T(std::forward<U>(value));
+
+    Node* oldHead = head.load(std::memory_order_relaxed);
+    do
+    {
+        node->next = oldHead;
+    } while (!head.compare_exchange_weak(oldHead, node, std::memory_order_release, std::memory_order_relaxed));
+}
+
+template <typename T>
+bool MPSCQueue<T>::IsEmpty() const
+{
+    return head.load(std::memory_order_acquire) == nullptr;
+}
+
+template <typename T>
+size_t MPSCQueue<T>::PopAll(Vector<T>& output)
+{
+    Node* list = head.exchange(nullptr, std::memory_order_acquire);
+
+    // reverse list to get nodes in order of pushing
+    Node* reversed = nullptr;
+    size_t count = 0;
+    while (list != nullptr)
+    {
+        Node* next = list->next;
+        list->next = reversed;
+        reversed = list;
+        list = next;
+        ++count;
+    }
+
+    output.reserve(output.size() + count);
+    for (Node* node = reversed; node != nullptr; node = node->next)
+    {
+        T* value = node->Value();
+        output.emplace_back(std::move(*value));
+        value->~T();
+    }
+
+    ReleaseNodes(reversed);
+    return count;
+}
+
+template <typename T>
+typename MPSCQueue<T>::Node* MPSCQueue<T>::AcquireNode()
+{
+    uint64 oldHead = freeHead.load(std::memory_order_acquire);
+    while (static_cast<uint32>(oldHead) != 0)
+    {
+        // node can be taken and returned by other threads meanwhile, so `nextFree` may be stale,
+        // but then tag in head is changed and CAS fails
+        Node* node = GetPooledNode(static_cast<uint32>(oldHead) - 1);
+        uint64 newHead = (((oldHead >> 32) + 1) << 32) | node->nextFree.load(std::memory_order_relaxed);
+        if (freeHead.compare_exchange_weak(oldHead, newHead, std::memory_order_acquire, std::memory_order_acquire))
+        {
+            return node;
+        }
+    }
+    return AllocateNodes();
+}
+
+template <typename T>
+typename MPSCQueue<T>::Node* MPSCQueue<T>::AllocateNodes()
+{
+    Node* chunk = nullptr;
+    {
+        LockGuard<Mutex> lock(chunksMutex);
+        if (chunksCount < MAX_CHUNKS)
+        {
+            chunk = new Node[NODES_PER_CHUNK];
+            for (uint32 i = 0; i < NODES_PER_CHUNK; ++i)
+            {
+                chunk[i].index = chunksCount * NODES_PER_CHUNK + i;
+            }
+            chunks[chunksCount++] = chunk;
+        }
+    }
+
+    if (chunk == nullptr)
+    {
+        return new Node();
+    }
+
+    // keep first node for caller and put others into free list,
+    // release CAS on free list head publishes new chunk to other threads
+    for (uint32 i = 1; i + 1 < NODES_PER_CHUNK; ++i)
+    {
+        chunk[i].nextFree.store(chunk[i + 1].index + 1, std::memory_order_relaxed);
+    }
+    ReleasePooledNodes(&chunk[1], &chunk[NODES_PER_CHUNK - 1]);
+    return &chunk[0];
+}
+
+template <typename T>
+void MPSCQueue<T>::ReleaseNodes(Node* list)
+{
+    Node* first = nullptr;
+    Node* last = nullptr;
+    while (list != nullptr)
+    {
+        Node* next = list->next;
+        if (list->index == NOT_POOLED)
+        {
+            delete list;
+        }
+        else
+        {
+            list->nextFree.store(first != nullptr ? first->index + 1 : 0, std::memory_order_relaxed);
+            last = (last != nullptr ? last : list);
+            first = list;
+        }
+        list = next;
+    }
+
+    if (first != nullptr)
+    {
+        ReleasePooledNodes(first, last);
+    }
+}
+
+template <typename T>
+void MPSCQueue<T>::ReleasePooledNodes(Node* first, Node* last)
+{
+    uint64 oldHead = freeHead.load(std::memory_order_relaxed);
+    uint64 newHead;
+    do
+    {
+        last->nextFree.store(static_cast<uint32>(oldHead), std::memory_order_relaxed);
+        newHead = (((oldHead >> 32) + 1) << 32) | (first->index + 1);
+    } while (!freeHead.compare_exchange_weak(oldHead, newHead, std::memory_order_release, std::memory_order_relaxed));
+}
+
+template <typename T>
+typename MPSCQueue<T>::Node* MPSCQueue<T>::GetPooledNode(uint32 index) const
+{
+    // chunk is written before any of its nodes gets into free list, so it's visible after acquire of free list head
+    return &chunks[index / NODES_PER_CHUNK][index % NODES_PER_CHUNK];
+}
+} // namespace DAVA
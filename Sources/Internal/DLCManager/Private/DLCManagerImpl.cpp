@@ -952,6 +952,26 @@ void DLCManagerImpl::GetFooter()
                 return;
             }
 
+            if (initFooterOnServer.info.version != PackFormat::FILE_VERSION)
+            {
+                initErrorMsg = "error: on server bad superpack!!! Unsupported pack version " + std::to_string(initFooterOnServer.info.version);
+                log << initErrorMsg << std::endl;
+                Logger::Error("%s", initErrorMsg.c_str());
+                TestRetryCountLocalMetaAndGoTo(InitState::LoadingPacksDataFromLocalMeta, InitState::LoadingRequestAskFooter);
+                return;
+            }
+
+            if (initFooterOnServer.info.blockSize != 0 || initFooterOnServer.info.dictionarySize != 0)
+            {
+                // files are downloaded one by one as .dvpl, LitePack footer can't describe chunked entries
+                // and .dvpl has no pack dictionary to decode Lz4Dict entries
+                initErrorMsg = "error: on server bad superpack!!! Superpack with chunked files (blockSize != 0) or dictionary (dictionarySize != 0) can't be used for DLC";
+                log << initErrorMsg << std::endl;
+                Logger::Error("%s", initErrorMsg.c_str());
+                TestRetryCountLocalMetaAndGoTo(InitState::LoadingPacksDataFromLocalMeta, InitState::LoadingRequestAskFooter);
+                return;
+            }
+
             if (!SaveServerFooter())
             {
                 TestRetryCountLocalMetaAndGoTo(InitState::LoadingPacksDataFromLocalMeta, InitState::LoadingRequestAskFooter);
@@ -1282,7 +1302,10 @@ void DLCManagerImpl::LoadLocalCacheServerFooter()
     ScopedPtr<File> f(File::Create(localCacheFooter, File::OPEN | File::READ));
     if (f)
     {
-        if (sizeof(initFooterOnServer) == f->Read(&initFooterOnServer, sizeof(initFooterOnServer)))
+        // footer cached by previous version of application can have other layout
+        if (sizeof(initFooterOnServer) == f->Read(&initFooterOnServer, sizeof(initFooterOnServer)) &&
+            initFooterOnServer.infoCrc32 == CRC32::ForBuffer(&initFooterOnServer.info, sizeof(initFooterOnServer.info)) &&
+            initFooterOnServer.info.version == PackFormat::FILE_VERSION)
         {
             return;
         }
@@ -128,5 +128,11 @@ DAVA::Assert::FailBehaviour HandleAssert(const char* const expr,
         }
     }
 
+    if (resultBehaviour == FailBehaviour::Halt)
+    {
+        // application can be killed at halt, so write pending log messages before it
+        Logger::FlushLog();
+    }
+
     return resultBehaviour;
 }
@@ -53,6 +53,15 @@ void DebugOverlayItemRenderStats::Draw()
             AddUIntStat("Packets", stats.packets2d);
         }
 
+        if (ImGui::CollapsingHeader("Batches Sorting"))
+        {
+            for (const auto& entry : stats.layersSortStats)
+            {
+                AddUIntStat(Format("%s batches", entry.first.c_str()).c_str(), entry.second.sortedBatches);
+                AddUIntStat(Format("%s sort time, us", entry.first.c_str()).c_str(), static_cast<uint32>(entry.second.sortTimeNs / 1000));
+            }
+        }
+
         if (ImGui::CollapsingHeader("Fragments Info"))
         {
             for (uint32 i = 0; i < uint32(VisibilityQueryResults::QUERY_INDEX_COUNT); ++i)
@@ -2,6 +2,7 @@
 #include "Time/SystemTimer.h"
 #include "Concurrency/Thread.h"
 #include "Concurrency/LockGuard.h"
+#include "Concurrency/MPSCQueue.h"
 #include "Base/AllocatorFactory.h"
 #include "Debug/DVAssert.h"
 #include "ProfilerRingArray.h"
@@ -87,6 +88,11 @@ ProfilerCPU::ScopedCounter::ScopedCounter(const char* counterName, ProfilerCPU*
         c.name = counterName;
         c.threadID = Thread::GetCurrentIdAsUInt64();
         c.frame = frame;
+
+        // counter in ring array can be overwritten before scope end, so copy is kept for capture
+        name = counterName;
+        startTime = c.startTime;
+        this->frame = frame;
     }
 }
 
@@ -99,12 +105,33 @@ ProfilerCPU::ScopedCounter::~ScopedCounter()
     // We know it. But it performance reason.
     if (profiler->isStarted && endTime != nullptr)
     {
-        *endTime = SystemTimer::GetUs();
+        uint64 time = SystemTimer::GetUs();
+        *endTime = time;
+
+        if (profiler->captureEnabled)
+        {
+            // capture without consumer shouldn't grow unbounded, so counters over limit are dropped
+            if (profiler->capturedCountersCount.fetch_add(1) < MAX_CAPTURED_COUNTERS)
+            {
+                Counter c;
+                c.startTime = startTime;
+                c.endTime = time;
+                c.name = name;
+                c.threadID = Thread::GetCurrentIdAsUInt64();
+                c.frame = frame;
+                profiler->capturedCounters->Push(c);
+            }
+            else
+            {
+                profiler->capturedCountersCount.fetch_sub(1);
+            }
+        }
     }
 }
 
 ProfilerCPU::ProfilerCPU(uint32 numCounters_)
-    : numCounters(numCounters_)
+    : capturedCounters(new MPSCQueue<Counter>())
+    , numCounters(numCounters_)
 {
 }
 
@@ -112,6 +139,7 @@ ProfilerCPU::~ProfilerCPU()
 {
     DeleteSnapshots();
     SafeDelete(counters);
+    SafeDelete(capturedCounters);
 }
 
 void ProfilerCPU::Start()
@@ -347,6 +375,38 @@ Vector<TraceEvent> ProfilerCPU::GetTrace(const char* counterName, uint32 desired
     return trace;
 }
 
+void ProfilerCPU::SetCaptureEnabled(bool enabled)
+{
+    captureEnabled = enabled;
+    if (!enabled)
+    {
+        Vector<Counter> discarded;
+        capturedCountersCount.fetch_sub(static_cast<uint32>(capturedCounters->PopAll(discarded)));
+    }
+}
+
+bool ProfilerCPU::IsCaptureEnabled() const
+{
+    return captureEnabled;
+}
+
+void ProfilerCPU::TakeCapturedTrace(Vector<TraceEvent>& trace)
+{
+    Vector<Counter> completed;
+    capturedCountersCount.fetch_sub(static_cast<uint32>(capturedCounters->PopAll(completed)));
+
+    trace.reserve(trace.size() + completed.size());
+    for (const Counter& c : completed)
+    {
+        trace.push_back({ FastName(c.name), c.startTime, (c.endTime - c.startTime), c.threadID, 0, TraceEvent::PHASE_DURATION });
+
+        if (c.frame)
+        {
+            trace.back().args.push_back({ TRACE_ARG_FRAME, c.frame });
+        }
+    }
+}
+
 const ProfilerCPU::CounterArray* ProfilerCPU::GetCounterArray(int32 snapshot) const
 {
     if (snapshot != NO_SNAPSHOT_ID)
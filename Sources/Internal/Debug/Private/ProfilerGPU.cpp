@@ -134,6 +134,16 @@ void ProfilerGPU::CheckPendingFrames()
             if (isFrameReliable && profilerStarted)
             {
                 framesInfo.next() = frameInfo;
+
+                if (captureEnabled)
+                {
+                    // like frames ring array keep only last frames if capture isn't taken in time
+                    if (capturedFrames.size() >= framesInfo.size())
+                    {
+                        capturedFrames.pop_front();
+                    }
+                    capturedFrames.push_back(frameInfo);
+                }
             }
 
             ResetPerfQueryPair(frame.perfQuery);
@@ -209,6 +219,30 @@ bool ProfilerGPU::IsStarted()
     return profilerStarted;
 }
 
+void ProfilerGPU::SetCaptureEnabled(bool enabled)
+{
+    captureEnabled = enabled;
+    if (!captureEnabled)
+    {
+        capturedFrames.clear();
+    }
+}
+
+bool ProfilerGPU::IsCaptureEnabled() const
+{
+    return captureEnabled;
+}
+
+void ProfilerGPU::TakeCapturedTrace(Vector<TraceEvent>& trace)
+{
+    for (const FrameInfo& frameInfo : capturedFrames)
+    {
+        Vector<TraceEvent> frameTrace = frameInfo.GetTrace();
+        trace.insert(trace.end(), frameTrace.begin(), frameTrace.end());
+    }
+    capturedFrames.clear();
+}
+
 ProfilerGPU::PerfQueryPair ProfilerGPU::GetPerfQueryPair()
 {
     PerfQueryPair p;
@@ -36,6 +36,7 @@ const char* SCENE_ANIMATION_SYSTEM = "AnimationSystem";
 const char* SCENE_UPDATE_SYSTEM_PRE_TRANSFORM = "UpdateSystem::PreTransform";
 const char* SCENE_UPDATE_SYSTEM_POST_TRANSFORM = "UpdateSystem::PostTransform";
 const char* SCENE_TRANSFORM_SYSTEM = "TransformSystem";
+const char* SCENE_TRANSFORM_SYSTEM_SUBTREES = "TransformSystem::Subtrees";
 const char* SCENE_LOD_SYSTEM = "LodSystem";
 const char* SCENE_SWITCH_SYSTEM = "SwitchSystem";
 const char* SCENE_PARTICLE_SYSTEM = "ParticleEffectSystem";
@@ -0,0 +1,454 @@
+#include "Debug/ProfilerTraceCapture.h"
+#include "Debug/ProfilerCPU.h"
+#include "Debug/ProfilerGPU.h"
+#include "Debug/DVAssert.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+#include "Logger/Logger.h"
+#include "Render/RHI/rhi_Public.h"
+#include <cstring>
+#include <sstream>
+
+namespace DAVA
+{
+namespace ProfilerTraceCaptureDetails
+{
+const char BINARY_MAGIC[4] = { 'D', 'V', 'T', 'R' };
+const uint32 BINARY_VERSION = 1;
+
+enum eRecordType : uint8
+{
+    RECORD_NAME = 1, // index, length, characters
+    RECORD_THREAD, // index, thread ID
+    RECORD_EVENT, // phase, name index, thread index, process ID, timestamp delta, [duration], args count, args
+};
+
+const char* const JSON_HEADER = "{ \"traceEvents\": [\n";
+const char* const JSON_FOOTER = "\n] }\n";
+
+void WriteVarint(Vector<uint8>& buffer, uint64 value)
+{
+    while (value >= 0x80)
+    {
+        buffer.push_back(static_cast<uint8>(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<uint8>(value));
+}
+
+// zigzag encoding keeps small negative deltas small: events of different threads come unordered
+void WriteSignedVarint(Vector<uint8>& buffer, int64 value)
+{
+    WriteVarint(buffer, (static_cast<uint64>(value) << 1) ^ static_cast<uint64>(value >> 63));
+}
+
+class BinaryReader
+{
+public:
+    BinaryReader(const Vector<uint8>& data_)
+        : data(data_)
+    {
+    }
+
+    bool IsEnd() const
+    {
+        return offset == data.size();
+    }
+
+    bool ReadByte(uint8& value)
+    {
+        if (offset >= data.size())
+        {
+            return false;
+        }
+        value = data[offset++];
+        return true;
+    }
+
+    bool ReadVarint(uint64& value)
+    {
+        value = 0;
+        for (uint32 shift = 0; shift < 64; shift += 7)
+        {
+            uint8 byte = 0;
+            if (!ReadByte(byte))
+            {
+                return false;
+            }
+            value |= static_cast<uint64>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool ReadSignedVarint(int64& value)
+    {
+        uint64 encoded = 0;
+        if (!ReadVarint(encoded))
+        {
+            return false;
+        }
+        value = static_cast<int64>(encoded >> 1) ^ -static_cast<int64>(encoded & 1);
+        return true;
+    }
+
+    bool ReadBytes(void* dst, size_t size)
+    {
+        if (data.size() - offset < size)
+        {
+            return false;
+        }
+        std::memcpy(dst, data.data() + offset, size);
+        offset += size;
+        return true;
+    }
+
+private:
+    const Vector<uint8>& data;
+    size_t offset = 0;
+};
+
+bool ReadRecord(BinaryReader& reader, Vector<FastName>& names, Vector<uint64>& threads, uint64& lastTimestamp, Vector<TraceEvent>& trace)
+{
+    uint8 type = 0;
+    if (!reader.ReadByte(type))
+    {
+        return false;
+    }
+
+    if (type == RECORD_NAME)
+    {
+        uint64 index = 0, length = 0;
+        if (!reader.ReadVarint(index) || !reader.ReadVarint(length) || index != names.size() || length > 0xFFFF)
+        {
+            return false;
+        }
+        String name(static_cast<size_t>(length), '\0');
+        if (!reader.ReadBytes(&name[0], name.size()))
+        {
+            return false;
+        }
+        names.push_back(FastName(name));
+        return true;
+    }
+
+    if (type == RECORD_THREAD)
+    {
+        uint64 index = 0, threadID = 0;
+        if (!reader.ReadVarint(index) || !reader.ReadVarint(threadID) || index != threads.size())
+        {
+            return false;
+        }
+        threads.push_back(threadID);
+        return true;
+    }
+
+    if (type == RECORD_EVENT)
+    {
+        uint8 phase = 0;
+        uint64 nameIndex = 0, threadIndex = 0, processID = 0, argsCount = 0;
+        int64 timestampDelta = 0;
+        if (!reader.ReadByte(phase) || phase >= TraceEvent::PHASE_COUNT ||
+            !reader.ReadVarint(nameIndex) || nameIndex >= names.size() ||
+            !reader.ReadVarint(threadIndex) || threadIndex >= threads.size() ||
+            !reader.ReadVarint(processID) || !reader.ReadSignedVarint(timestampDelta))
+        {
+            return false;
+        }
+
+        TraceEvent event;
+        event.name = names[static_cast<size_t>(nameIndex)];
+        event.timestamp = lastTimestamp + static_cast<uint64>(timestampDelta);
+        event.duration = 0;
+        event.threadID = threads[static_cast<size_t>(threadIndex)];
+        event.processID = static_cast<uint32>(processID);
+        event.phase = static_cast<TraceEvent::EventPhase>(phase);
+        lastTimestamp = event.timestamp;
+
+        if (event.phase == TraceEvent::PHASE_DURATION && !reader.ReadVarint(event.duration))
+        {
+            return false;
+        }
+
+        if (!reader.ReadVarint(argsCount))
+        {
+            return false;
+        }
+        for (uint64 i = 0; i < argsCount; ++i)
+        {
+            uint64 argNameIndex = 0, argValue = 0;
+            if (!reader.ReadVarint(argNameIndex) || argNameIndex >= names.size() || !reader.ReadVarint(argValue))
+            {
+                return false;
+            }
+            event.args.emplace_back(names[static_cast<size_t>(argNameIndex)], static_cast<uint32>(argValue));
+        }
+
+        trace.push_back(std::move(event));
+        return true;
+    }
+
+    return false;
+}
+}
+
+ProfilerTraceCapture::ProfilerTraceCapture(ProfilerCPU* cpuProfiler_, ProfilerGPU* gpuProfiler_, const FilePath& filePath, eFormat format_)
+    : cpuProfiler(cpuProfiler_)
+    , gpuProfiler(gpuProfiler_)
+    , format(format_)
+{
+    using namespace ProfilerTraceCaptureDetails;
+
+    FileSystem::Instance()->CreateDirectory(filePath.GetDirectory(), true);
+    file = File::Create(filePath, File::CREATE | File::WRITE);
+    if (file == nullptr)
+    {
+        Logger::Error("[ProfilerTraceCapture] Can't create file %s", filePath.GetStringValue().c_str());
+        return;
+    }
+
+    if (format == FORMAT_BINARY)
+    {
+        file->Write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+        file->Write(&BINARY_VERSION);
+    }
+    else
+    {
+        file->WriteNonTerminatedString(JSON_HEADER);
+    }
+
+    if (gpuProfiler != nullptr)
+    {
+        uint64 cpuTime = 0, gpuTime = 0;
+        rhi::SynchronizeCPUGPU(&cpuTime, &gpuTime);
+        gpuTimeOffset = static_cast<int64>(cpuTime) - static_cast<int64>(gpuTime);
+
+        gpuProfiler->SetCaptureEnabled(true);
+    }
+
+    if (cpuProfiler != nullptr)
+    {
+        cpuProfiler->SetCaptureEnabled(true);
+    }
+}
+
+ProfilerTraceCapture::~ProfilerTraceCapture()
+{
+    Finish();
+}
+
+void ProfilerTraceCapture::Flush()
+{
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    events.clear();
+    if (gpuProfiler != nullptr)
+    {
+        gpuProfiler->TakeCapturedTrace(events);
+        for (TraceEvent& event : events)
+        {
+            event.timestamp = static_cast<uint64>(static_cast<int64>(event.timestamp) + gpuTimeOffset);
+        }
+    }
+    if (cpuProfiler != nullptr)
+    {
+        cpuProfiler->TakeCapturedTrace(events);
+    }
+
+    WriteEvents();
+}
+
+void ProfilerTraceCapture::Finish()
+{
+    using namespace ProfilerTraceCaptureDetails;
+
+    if (file == nullptr)
+    {
+        return;
+    }
+
+    Flush();
+
+    if (cpuProfiler != nullptr)
+    {
+        cpuProfiler->SetCaptureEnabled(false);
+    }
+    if (gpuProfiler != nullptr)
+    {
+        gpuProfiler->SetCaptureEnabled(false);
+    }
+
+    if (format == FORMAT_JSON)
+    {
+        file->WriteNonTerminatedString(JSON_FOOTER);
+    }
+    SafeRelease(file);
+}
+
+void ProfilerTraceCapture::WriteEvents()
+{
+    if (events.empty())
+    {
+        return;
+    }
+
+    if (format == FORMAT_BINARY)
+    {
+        buffer.clear();
+        for (const TraceEvent& event : events)
+        {
+            WriteBinaryEvent(event);
+        }
+        file->Write(buffer.data(), static_cast<uint32>(buffer.size()));
+    }
+    else
+    {
+        std::stringstream stream;
+        for (size_t i = 0; i < events.size(); ++i)
+        {
+            if (writtenEventsCount + i != 0)
+                stream << ",\n";
+
+            TraceEvent::DumpJSONEvent(events[i], stream);
+        }
+        file->WriteNonTerminatedString(stream.str());
+    }
+
+    writtenEventsCount += events.size();
+}
+
+void ProfilerTraceCapture::WriteBinaryEvent(const TraceEvent& event)
+{
+    using namespace ProfilerTraceCaptureDetails;
+
+    // indices should be written before event record which refers to them
+    uint32 nameIndex = GetNameIndex(event.name);
+    uint32 threadIndex = GetThreadIndex(event.threadID);
+    for (const std::pair<FastName, uint32>& arg : event.args)
+    {
+        GetNameIndex(arg.first);
+    }
+
+    buffer.push_back(RECORD_EVENT);
+    buffer.push_back(static_cast<uint8>(event.phase));
+    WriteVarint(buffer, nameIndex);
+    WriteVarint(buffer, threadIndex);
+    WriteVarint(buffer, event.processID);
+    WriteSignedVarint(buffer, static_cast<int64>(event.timestamp - lastTimestamp));
+    lastTimestamp = event.timestamp;
+
+    if (event.phase == TraceEvent::PHASE_DURATION)
+    {
+        WriteVarint(buffer, event.duration);
+    }
+
+    WriteVarint(buffer, event.args.size());
+    for (const std::pair<FastName, uint32>& arg : event.args)
+    {
+        WriteVarint(buffer, GetNameIndex(arg.first));
+        WriteVarint(buffer, arg.second);
+    }
+}
+
+uint32 ProfilerTraceCapture::GetNameIndex(const FastName& name)
+{
+    using namespace ProfilerTraceCaptureDetails;
+
+    auto found = nameIndices.find(name);
+    if (found != nameIndices.end())
+    {
+        return found->second;
+    }
+
+    uint32 index = static_cast<uint32>(nameIndices.size());
+    nameIndices.emplace(name, index);
+
+    const char* str = name.IsValid() ? name.c_str() : "";
+    size_t length = std::min(strlen(str), size_t(0xFFFF));
+    buffer.push_back(RECORD_NAME);
+    WriteVarint(buffer, index);
+    WriteVarint(buffer, length);
+    buffer.insert(buffer.end(), str, str + length);
+    return index;
+}
+
+uint32 ProfilerTraceCapture::GetThreadIndex(uint64 threadID)
+{
+    using namespace ProfilerTraceCaptureDetails;
+
+    auto found = threadIndices.find(threadID);
+    if (found != threadIndices.end())
+    {
+        return found->second;
+    }
+
+    uint32 index = static_cast<uint32>(threadIndices.size());
+    threadIndices.emplace(threadID, index);
+
+    buffer.push_back(RECORD_THREAD);
+    WriteVarint(buffer, index);
+    WriteVarint(buffer, threadID);
+    return index;
+}
+
+bool ProfilerTraceCapture::ReadBinaryTrace(const FilePath& filePath, Vector<TraceEvent>& trace)
+{
+    using namespace ProfilerTraceCaptureDetails;
+
+    ScopedPtr<File> file(File::Create(filePath, File::OPEN | File::READ));
+    if (!file)
+    {
+        Logger::Error("[ProfilerTraceCapture] Can't open file %s", filePath.GetStringValue().c_str());
+        return false;
+    }
+
+    Vector<uint8> data(static_cast<size_t>(file->GetSize()));
+    if (file->Read(data.data(), static_cast<uint32>(data.size())) != data.size())
+    {
+        Logger::Error("[ProfilerTraceCapture] Can't read file %s", filePath.GetStringValue().c_str());
+        return false;
+    }
+
+    BinaryReader reader(data);
+    char magic[4] = {};
+    uint32 version = 0;
+    if (!reader.ReadBytes(magic, sizeof(magic)) || !reader.ReadBytes(&version, sizeof(version)) ||
+        std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) != 0 || version != BINARY_VERSION)
+    {
+        Logger::Error("[ProfilerTraceCapture] File %s is not a binary trace", filePath.GetStringValue().c_str());
+        return false;
+    }
+
+    Vector<FastName> names;
+    Vector<uint64> threads;
+    uint64 lastTimestamp = 0;
+    while (!reader.IsEnd())
+    {
+        if (!ReadRecord(reader, names, threads, lastTimestamp, trace))
+        {
+            Logger::Error("[ProfilerTraceCapture] File %s is corrupted", filePath.GetStringValue().c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ProfilerTraceCapture::ConvertBinaryToJSON(const FilePath& binaryFilePath, const FilePath& jsonFilePath)
+{
+    Vector<TraceEvent> trace;
+    if (!ReadBinaryTrace(binaryFilePath, trace))
+    {
+        return false;
+    }
+
+    TraceEvent::DumpJSON(trace, jsonFilePath);
+    return true;
+}
+
+} //ns DAVA
@@ -3,6 +3,7 @@
 #include "Base/BaseTypes.h"
 #include "Debug/TraceEvent.h"
 #include "Concurrency/Mutex.h"
+#include <atomic>
 #include <iosfwd>
 
 #ifndef PROFILER_CPU_ENABLED
@@ -13,6 +14,8 @@ namespace DAVA
 {
 template <class T>
 class ProfilerRingArray;
+template <typename T>
+class MPSCQueue;
 
 /**
     \ingroup profilers
@@ -83,9 +86,13 @@ public:
     private:
         uint64* endTime = nullptr;
         ProfilerCPU* profiler;
+        const char* name = nullptr;
+        uint64 startTime = 0;
+        uint32 frame = 0;
     };
 
     static const int32 NO_SNAPSHOT_ID = -1; ///< Value used to dump or build trace from current counters array
+    static const uint32 MAX_CAPTURED_COUNTERS = 64 * 1024; ///< Max number of captured counters which were not taken by `TakeCapturedTrace`
     static ProfilerCPU* const globalProfiler; ///< Global Engine Profiler
 
     ProfilerCPU(uint32 numCounters = 2048);
@@ -156,14 +163,36 @@ public:
     */
     Vector<TraceEvent> GetTrace(const char* counterName, uint32 desiredFrameIndex = 0, int32 snapshotID = NO_SNAPSHOT_ID) const;
 
+    /**
+        Enable or disable capture of completed counters. Unlike counters array captured counters are never overwritten,
+        so they should be regularly taken with `TakeCapturedTrace` (see `ProfilerTraceCapture`). At most `MAX_CAPTURED_COUNTERS`
+        captured counters are kept, counters completed while capture is full are dropped.
+        Counters are captured only while profiler is started. Disabling of capture discards counters which were not taken.
+    */
+    void SetCaptureEnabled(bool enabled);
+
+    /**
+        Returns is capture of completed counters enabled
+    */
+    bool IsCaptureEnabled() const;
+
+    /**
+        Append counters completed since previous call to `trace`. Profiler can be started,
+        but method shouldn't be called from several threads simultaneously or together with `SetCaptureEnabled`
+    */
+    void TakeCapturedTrace(Vector<TraceEvent>& trace);
+
 private:
     const CounterArray* GetCounterArray(int32 snapshot) const;
 
     CounterArray* counters = nullptr;
     Vector<CounterArray*> snapshots;
+    MPSCQueue<Counter>* capturedCounters = nullptr;
+    std::atomic<uint32> capturedCountersCount{ 0 };
     Mutex mutex;
     uint32 numCounters = 2048;
     bool isStarted = false;
+    std::atomic<bool> captureEnabled{ false };
 
     friend class ScopedCounter;
 };
@@ -90,6 +90,22 @@ public:
     */
     bool IsStarted();
 
+    /**
+        Enable or disable capture of executed frames. Captured frames are kept until they are taken with `TakeCapturedTrace`
+        (see `ProfilerTraceCapture`), but not more than size of frames ring array, older frames are dropped
+    */
+    void SetCaptureEnabled(bool enabled);
+
+    /**
+        Returns is capture of executed frames enabled
+    */
+    bool IsCaptureEnabled() const;
+
+    /**
+        Append trace of frames executed since previous call to `trace`
+    */
+    void TakeCapturedTrace(Vector<TraceEvent>& trace);
+
 protected:
     ProfilerGPU(uint32 framesCount = 180);
 
@@ -131,11 +147,13 @@ protected:
     void ResetPerfQueryPair(const PerfQueryPair& perfQuery);
 
     RingArray<FrameInfo> framesInfo;
+    Deque<FrameInfo> capturedFrames;
     Vector<rhi::HPerfQuery> queryPool;
     List<Frame> pendingFrames;
     Frame currentFrame;
 
     bool profilerStarted = false;
+    bool captureEnabled = false;
 
     friend struct ProfilerGPUDetails;
 };
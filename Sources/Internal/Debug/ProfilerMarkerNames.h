@@ -36,6 +36,7 @@ extern const char* SCENE_ANIMATION_SYSTEM;
 extern const char* SCENE_UPDATE_SYSTEM_PRE_TRANSFORM;
 extern const char* SCENE_UPDATE_SYSTEM_POST_TRANSFORM;
 extern const char* SCENE_TRANSFORM_SYSTEM;
+extern const char* SCENE_TRANSFORM_SYSTEM_SUBTREES;
 extern const char* SCENE_LOD_SYSTEM;
 extern const char* SCENE_SWITCH_SYSTEM;
 extern const char* SCENE_PARTICLE_SYSTEM;
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/FastName.h"
+#include "Debug/TraceEvent.h"
+#include "FileSystem/FilePath.h"
+
+namespace DAVA
+{
+class File;
+class ProfilerCPU;
+class ProfilerGPU;
+
+/**
+    \ingroup profilers
+             Capture streams counters of `ProfilerCPU` and frames of `ProfilerGPU` to file while profilers are working.
+             Unlike `ProfilerCPU::GetTrace` it isn't limited by size of profiler ring array, so it can be used to record long sessions
+             and find frame spikes later offline.
+
+             Capture enables capture mode of passed profilers (profilers should be started separately) and writes taken events to file
+             on every `Flush` call. Call `Flush` regularly, e.g. once per frame, from the thread which owns GPU profiler.
+             GPU timestamps are converted to CPU time, so both traces can be viewed on the same timeline.
+
+             Two file formats are supported:
+              - FORMAT_JSON    -- Chromium Trace Viewer JSON, can be opened in chrome://tracing or Perfetto UI as is.
+              - FORMAT_BINARY  -- compact binary format for long sessions. Names and threads are written once, timestamps are delta-encoded varints.
+                                  Use `ReadBinaryTrace` or `ConvertBinaryToJSON` to view it.
+
+             Example:
+               \code
+               ProfilerCPU::globalProfiler->Start();
+               ProfilerGPU::globalProfiler->Start();
+               ProfilerTraceCapture capture(ProfilerCPU::globalProfiler, ProfilerGPU::globalProfiler, "~doc:/trace.dvtrace", ProfilerTraceCapture::FORMAT_BINARY);
+               ...
+               capture.Flush(); // every frame
+               ...
+               capture.Finish();
+               ProfilerTraceCapture::ConvertBinaryToJSON("~doc:/trace.dvtrace", "~doc:/trace.json");
+               \endcode
+*/
+class ProfilerTraceCapture
+{
+public:
+    enum eFormat
+    {
+        FORMAT_JSON = 0,
+        FORMAT_BINARY
+    };
+
+    /**
+        Create file with `filePath` and enable capture mode of `cpuProfiler` and `gpuProfiler`. Any of profilers can be nullptr.
+    */
+    ProfilerTraceCapture(ProfilerCPU* cpuProfiler, ProfilerGPU* gpuProfiler, const FilePath& filePath, eFormat format);
+
+    /**
+        Finish capture, see `Finish`
+    */
+    ~ProfilerTraceCapture();
+
+    ProfilerTraceCapture(const ProfilerTraceCapture&) = delete;
+    ProfilerTraceCapture& operator=(const ProfilerTraceCapture&) = delete;
+
+    /**
+        Returns is file opened and capture is in progress
+    */
+    bool IsCapturing() const;
+
+    /**
+        Take events captured by profilers and write them to file
+    */
+    void Flush();
+
+    /**
+        Flush remaining events, disable capture mode of profilers and close file
+    */
+    void Finish();
+
+    /**
+        Returns number of events written to file
+    */
+    uint64 GetWrittenEventsCount() const;
+
+    /**
+        Read all events from file written in FORMAT_BINARY
+    */
+    static bool ReadBinaryTrace(const FilePath& filePath, Vector<TraceEvent>& trace);
+
+    /**
+        Convert file written in FORMAT_BINARY to Chromium Trace Viewer JSON
+    */
+    static bool ConvertBinaryToJSON(const FilePath& binaryFilePath, const FilePath& jsonFilePath);
+
+private:
+    void WriteEvents();
+    void WriteBinaryEvent(const TraceEvent& event);
+    uint32 GetNameIndex(const FastName& name);
+    uint32 GetThreadIndex(uint64 threadID);
+
+    ProfilerCPU* cpuProfiler = nullptr;
+    ProfilerGPU* gpuProfiler = nullptr;
+    File* file = nullptr;
+    eFormat format = FORMAT_JSON;
+
+    int64 gpuTimeOffset = 0;
+    uint64 writtenEventsCount = 0;
+
+    // state of binary stream
+    UnorderedMap<FastName, uint32> nameIndices;
+    UnorderedMap<uint64, uint32> threadIndices;
+    uint64 lastTimestamp = 0;
+    Vector<uint8> buffer;
+    Vector<TraceEvent> events;
+};
+
+inline bool ProfilerTraceCapture::IsCapturing() const
+{
+    return file != nullptr;
+}
+
+inline uint64 ProfilerTraceCapture::GetWrittenEventsCount() const
+{
+    return writtenEventsCount;
+}
+
+} //ns DAVA
@@ -43,6 +43,11 @@ struct TraceEvent
     */
     template <class Container>
     static void DumpJSON(const Container& trace, std::ostream& stream);
+
+    /**
+        Dump single `event` to `stream` as JSON-object. Can be used to write trace by parts (see `ProfilerTraceCapture`)
+    */
+    static void DumpJSONEvent(const TraceEvent& event, std::ostream& stream);
 };
 
 template <class Container>
@@ -65,44 +70,55 @@ void TraceEvent::DumpJSON(const Container& trace, std::ostream& stream)
 {
     static_assert(std::is_same<typename Container::value_type, TraceEvent>::value, "Container should contain TraceEvent class");
 
-    static const char* const PHASE_STR[PHASE_COUNT] = {
-        "B", "E", "I", "X"
-    };
-
     stream << "{ \"traceEvents\": [\n";
 
     auto begin = trace.begin(), end = trace.end();
     for (auto it = begin; it != end; ++it)
     {
-        const TraceEvent& event = (*it);
-
         if (it != begin)
             stream << ",\n";
 
-        stream << "{ ";
-        stream << "\"pid\": " << event.processID << ", ";
-        stream << "\"tid\": " << event.threadID << ", ";
-        stream << "\"ts\": " << event.timestamp << ", ";
+        DumpJSONEvent(*it, stream);
+    }
 
-        if (event.phase == PHASE_DURATION)
-        {
-            stream << "\"dur\": " << event.duration << ", ";
-        }
+    stream << "\n] }\n";
+
+    stream.flush();
+}
 
-        stream << "\"ph\": \"" << PHASE_STR[event.phase] << "\", ";
-        stream << "\"name\": \"" << event.name.c_str() << "\"";
+inline void TraceEvent::DumpJSONEvent(const TraceEvent& event, std::ostream& stream)
+{
+    static const char* const PHASE_STR[PHASE_COUNT] = {
+        "B", "E", "I", "X"
+    };
+
+    stream << "{ ";
+    stream << "\"pid\": " << event.processID << ", ";
+    stream << "\"tid\": " << event.threadID << ", ";
+    stream << "\"ts\": " << event.timestamp << ", ";
+
+    if (event.phase == PHASE_DURATION)
+    {
+        stream << "\"dur\": " << event.duration << ", ";
+    }
 
-        for (const std::pair<FastName, uint32>& arg : event.args)
+    stream << "\"ph\": \"" << PHASE_STR[event.phase] << "\", ";
+    stream << "\"name\": \"" << event.name.c_str() << "\"";
+
+    if (!event.args.empty())
+    {
+        stream << ", \"args\": { ";
+        for (size_t i = 0; i < event.args.size(); ++i)
         {
-            stream << ", \"args\": { \"" << arg.first.c_str() << "\": " << arg.second << " }";
-        }
+            if (i != 0)
+                stream << ", ";
 
+            stream << "\"" << event.args[i].first.c_str() << "\": " << event.args[i].second;
+        }
         stream << " }";
     }
 
-    stream << "\n] }\n";
-
-    stream.flush();
+    stream << " }";
 }
 
 }; //ns DAVA
\ No newline at end of file
@@ -221,8 +221,14 @@ public:
         | max_command_buffer_count        |                            | 0              |
         | max_packet_list_count           |                            | 0              |
         | shader_const_buffer_size        |                            | 0              |
+        | prewarm_shaders                 |                            | false          |
 
         For more info on render options ask RHI guys.
+
+        | **Other options**               | Description                | Default        |
+        | ------------------------------- | -------------------------- | -------------- |
+        | async_file_log                  |                            | false          |
+        | text_glyph_atlas                |                            | false          |
     
         Other options can be found in description for corresponding module.
     */
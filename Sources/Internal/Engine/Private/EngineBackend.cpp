@@ -54,6 +54,7 @@
 #include "Render/Image/ImageConverter.h"
 #include "Render/Renderer.h"
 #include "Render/RHI/rhi_ShaderSource.h"
+#include "Render/ShaderCache.h"
 #include "Scene3D/SceneFile/VersionInfo.h"
 #include "Sound/SoundEvent.h"
 #include "Sound/SoundSystem.h"
@@ -351,6 +352,8 @@ void EngineBackend::OnGameLoopStopped()
     if (!IsConsoleMode())
     {
         rhi::ShaderSourceCache::Save("~doc:/ShaderSource.bin");
+        if (Renderer::IsInitialized())
+            ShaderDescriptorCache::SaveWarmupList("~doc:/ShaderWarmup.bin");
     }
 
     Logger::Info("EngineBackend::OnGameLoopStopped: leave");
@@ -668,6 +671,8 @@ void EngineBackend::HandleAppSuspended(const MainDispatcherEvent& e)
         if (Renderer::IsInitialized())
             rhi::SuspendRendering();
         rhi::ShaderSourceCache::Save("~doc:/ShaderSource.bin");
+        if (Renderer::IsInitialized())
+            ShaderDescriptorCache::SaveWarmupList("~doc:/ShaderWarmup.bin");
         engine->suspended.Emit();
 
         Logger::Info("EngineBackend::HandleAppSuspended: leave");
@@ -794,6 +799,14 @@ void EngineBackend::InitRenderer(Window* w)
     Renderer::Initialize(renderer, rendererParams);
     context->renderSystem2D->Init();
 
+    // create shaders used in previous launch now, instead of on first use;
+    // sources are built in worker jobs, but pipeline states still delay startup, so it's disabled by default
+    if (options->GetBool("prewarm_shaders", false))
+        ShaderDescriptorCache::Prewarm("~doc:/ShaderWarmup.bin");
+
+    // draw FreeType text through shared glyph atlas instead of texture per text block
+    TextBlock::SetGlyphAtlasEnabled(options->GetBool("text_glyph_atlas", false));
+
     if (options->GetBool("init_imgui"))
         ImGui::Initialize();
 }
@@ -939,6 +952,12 @@ void EngineBackend::CreateSubsystems(const Vector<String>& modules)
         context->logger->EnableConsoleMode();
     }
 
+    // write log file on separate thread instead of reopening it for each message
+    if (options->GetBool("async_file_log", false))
+    {
+        context->logger->EnableAsyncFileLog();
+    }
+
     context->imageConverter = new ImageConverter();
 
     context->moduleManager = new ModuleManager(GetEngine());
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/UnordererMap.h"
+
+#include <tuple>
+
+namespace DAVA
+{
+class Entity;
+class Component;
+class Scene;
+
+/**
+    \ingroup systems
+    Base class of `EntityGroup`, keeps entities matching component mask. Groups are owned and updated by scene.
+*/
+class EntityGroupBase
+{
+public:
+    EntityGroupBase(const ComponentMask& mask);
+    virtual ~EntityGroupBase() = default;
+
+    /** Return mask of components which every entity of group has. */
+    const ComponentMask& GetComponentMask() const;
+
+    /** Return entities of group. Order of entities is arbitrary and is changed when entities are removed from group. */
+    const Vector<Entity*>& GetEntities() const;
+
+    /** Return number of entities in group. */
+    uint32 GetSize() const;
+
+protected:
+    friend class Scene;
+
+    /**
+        Add `entity` to group, update its components or remove it from group depending on components `entity` has.
+        `removedComponent` is a component which is still attached to `entity` but is going to be removed, or nullptr.
+    */
+    void UpdateEntity(Entity* entity, const Component* removedComponent);
+    void RemoveEntity(Entity* entity);
+
+    virtual void PushComponents(Entity* entity, const Component* removedComponent) = 0;
+    virtual void SetComponents(uint32 index, Entity* entity, const Component* removedComponent) = 0;
+    virtual void RemoveComponents(uint32 index) = 0;
+
+private:
+    void RemoveAt(uint32 index);
+
+    ComponentMask mask;
+    Vector<Entity*> entities;
+    UnorderedMap<Entity*, uint32> entityIndices;
+};
+
+/**
+    \ingroup systems
+    Dense set of scene entities which have components of all types `T...` (types should be different).
+    For every entity first component of each type is stored in parallel arrays, so systems iterate linear arrays
+    instead of chasing each entity for its components every frame.
+
+    \code
+    using Group = EntityGroup<TransformComponent, RenderComponent>;
+    Group* group = scene->AcquireEntityGroup<TransformComponent, RenderComponent>();
+
+    const Vector<TransformComponent*>& transforms = group->GetComponents<TransformComponent>();
+    const Vector<RenderComponent*>& renders = group->GetComponents<RenderComponent>();
+    for (uint32 i = 0, size = group->GetSize(); i < size; ++i)
+    {
+        // transforms[i] and renders[i] belong to group->GetEntities()[i]
+    }
+    \endcode
+
+    Arrays are changed when entities or components are added to or removed from scene, so they shouldn't be
+    modified while being iterated. Group is valid until scene is destroyed.
+*/
+template <typename... T>
+class EntityGroup : public EntityGroupBase
+{
+public:
+    EntityGroup();
+
+    /** Return components of type `C` (one of `T...`) in order of `GetEntities()`. */
+    template <typename C>
+    const Vector<C*>& GetComponents() const;
+
+    /** Call `fn(Entity*, T*...)` for every entity of group. */
+    template <typename Fn>
+    void ForEach(Fn fn) const;
+
+private:
+    void PushComponents(Entity* entity, const Component* removedComponent) override;
+    void SetComponents(uint32 index, Entity* entity, const Component* removedComponent) override;
+    void RemoveComponents(uint32 index) override;
+
+    std::tuple<Vector<T*>...> components;
+};
+
+inline const ComponentMask& EntityGroupBase::GetComponentMask() const
+{
+    return mask;
+}
+
+inline const Vector<Entity*>& EntityGroupBase::GetEntities() const
+{
+    return entities;
+}
+
+inline uint32 EntityGroupBase::GetSize() const
+{
+    return static_cast<uint32>(entities.size());
+}
+}
+
+#include "Entity/Private/EntityGroup_impl.h"
@@ -0,0 +1,68 @@
+#include "Entity/EntityGroup.h"
+#include "Entity/Component.h"
+#include "Entity/ComponentUtils.h"
+#include "Scene3D/Entity.h"
+#include "Debug/DVAssert.h"
+
+namespace DAVA
+{
+EntityGroupBase::EntityGroupBase(const ComponentMask& mask_)
+    : mask(mask_)
+{
+}
+
+void EntityGroupBase::UpdateEntity(Entity* entity, const Component* removedComponent)
+{
+    DVASSERT(entity != nullptr);
+
+    bool fits = (entity->GetAvailableComponentMask() & mask) == mask;
+    if (fits && removedComponent != nullptr)
+    {
+        const Type* removedType = removedComponent->GetType();
+        fits = !mask.test(ComponentUtils::GetRuntimeId(removedType)) || entity->GetComponentCount(removedType) > 1;
+    }
+
+    auto it = entityIndices.find(entity);
+    if (it == entityIndices.end())
+    {
+        if (fits)
+        {
+            entityIndices[entity] = GetSize();
+            entities.push_back(entity);
+            PushComponents(entity, removedComponent);
+        }
+    }
+    else if (fits)
+    {
+        SetComponents(it->second, entity, removedComponent);
+    }
+    else
+    {
+        RemoveAt(it->second);
+    }
+}
+
+void EntityGroupBase::RemoveEntity(Entity* entity)
+{
+    auto it = entityIndices.find(entity);
+    if (it != entityIndices.end())
+    {
+        RemoveAt(it->second);
+    }
+}
+
+void EntityGroupBase::RemoveAt(uint32 index)
+{
+    DVASSERT(index < GetSize());
+
+    Entity* removed = entities[index];
+    Entity* last = entities.back();
+
+    entities[index] = last;
+    entities.pop_back();
+    entityIndices[last] = index;
+    entityIndices.erase(removed);
+
+    RemoveComponents(index);
+}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "Base/Type.h"
+#include "Entity/ComponentUtils.h"
+#include "Scene3D/Entity.h"
+
+namespace DAVA
+{
+namespace EntityGroupDetails
+{
+template <typename C>
+C* GetFirstComponent(Entity* entity, const Component* removedComponent)
+{
+    const Type* type = Type::Instance<C>();
+    uint32 count = entity->GetComponentCount(type);
+    for (uint32 i = 0; i < count; ++i)
+    {
+        Component* component = entity->GetComponent(type, i);
+        if (component != removedComponent)
+        {
+            return static_cast<C*>(component);
+        }
+    }
+    return nullptr;
+}
+
+template <typename C>
+void SwapRemove(Vector<C*>& array, uint32 index)
+{
+    array[index] = array.back();
+    array.pop_back();
+}
+
+using Expander = int[];
+}
+
+template <typename... T>
+EntityGroup<T...>::EntityGroup()
+    : EntityGroupBase(ComponentUtils::MakeMask<T...>())
+{
+}
+
+template <typename... T>
+template <typename C>
+const Vector<C*>& EntityGroup<T...>::GetComponents() const
+{
+    return std::get<Vector<C*>>(components);
+}
+
+template <typename... T>
+template <typename Fn>
+void EntityGroup<T...>::ForEach(Fn fn) const
+{
+    const Vector<Entity*>& entities = GetEntities();
+    for (uint32 i = 0, size = GetSize(); i < size; ++i)
+    {
+        fn(entities[i], std::get<Vector<T*>>(components)[i]...);
+    }
+}
+
+template <typename... T>
+void EntityGroup<T...>::PushComponents(Entity* entity, const Component* removedComponent)
+{
+    (void)EntityGroupDetails::Expander{ 0, (std::get<Vector<T*>>(components).push_back(EntityGroupDetails::GetFirstComponent<T>(entity, removedComponent)), 0)... };
+}
+
+template <typename... T>
+void EntityGroup<T...>::SetComponents(uint32 index, Entity* entity, const Component* removedComponent)
+{
+    (void)EntityGroupDetails::Expander{ 0, (std::get<Vector<T*>>(components)[index] = EntityGroupDetails::GetFirstComponent<T>(entity, removedComponent), 0)... };
+}
+
+template <typename... T>
+void EntityGroup<T...>::RemoveComponents(uint32 index)
+{
+    (void)EntityGroupDetails::Expander{ 0, (EntityGroupDetails::SwapRemove(std::get<Vector<T*>>(components), index), 0)... };
+}
+}
@@ -0,0 +1,425 @@
+#include "FileSystem/AsyncFileReader.h"
+#include "FileSystem/File.h"
+#include "FileSystem/ResourceArchive.h"
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/Thread.h"
+#include "Base/RefPtr.h"
+#include "Debug/DVAssert.h"
+#include "Logger/Logger.h"
+
+#include <algorithm>
+
+namespace DAVA
+{
+namespace AsyncFileReaderDetails
+{
+// File::Read takes uint32 size, so huge ranges are read by parts
+bool ReadFully(File* file, uint8* buffer, uint64 size)
+{
+    const uint64 maxPartSize = 1u << 30;
+    while (size > 0)
+    {
+        uint32 partSize = static_cast<uint32>(std::min(size, maxPartSize));
+        if (file->Read(buffer, partSize) != partSize)
+        {
+            return false;
+        }
+        buffer += partSize;
+        size -= partSize;
+    }
+    return true;
+}
+}
+
+void AsyncFileReader::Request::SetFinished(eStatus finalStatus)
+{
+    {
+        LockGuard<Mutex> guard(waitMutex);
+        status = finalStatus;
+    }
+    waitCV.NotifyAll();
+}
+
+AsyncFileReader::eStatus AsyncFileReader::Request::GetStatus() const
+{
+    return status;
+}
+
+bool AsyncFileReader::Request::IsFinished() const
+{
+    return status != eStatus::Pending;
+}
+
+void AsyncFileReader::Request::Wait() const
+{
+    UniqueLock<Mutex> lock(waitMutex);
+    waitCV.Wait(lock, [this]() { return IsFinished(); });
+}
+
+bool AsyncFileReader::Request::Cancel()
+{
+    bool expected = false;
+    if (started.compare_exchange_strong(expected, true))
+    {
+        // request stays in the queue and is dropped by I/O thread
+        SetFinished(eStatus::Cancelled);
+        return true;
+    }
+    return false;
+}
+
+const Vector<uint8>& AsyncFileReader::Request::GetData() const
+{
+    return data;
+}
+
+Vector<uint8>& AsyncFileReader::Request::GetData()
+{
+    return data;
+}
+
+const FilePath& AsyncFileReader::Request::GetFilePath() const
+{
+    return filePath;
+}
+
+const String& AsyncFileReader::Request::GetArchiveFilePath() const
+{
+    return archiveFilePath;
+}
+
+AsyncFileReader::AsyncFileReader()
+{
+    ioThread = Thread::Create([this]() { ThreadFunc(); });
+    ioThread->SetName("DAVA::AsyncFileReader");
+    ioThread->Start();
+}
+
+AsyncFileReader::~AsyncFileReader()
+{
+    {
+        LockGuard<Mutex> guard(queueMutex);
+        stopThread = true;
+        for (Deque<RequestPtr>& queue : queues)
+        {
+            for (const RequestPtr& request : queue)
+            {
+                request->Cancel();
+            }
+            activeRequestsCount -= static_cast<uint32>(queue.size());
+            queue.clear();
+        }
+    }
+    queueCV.NotifyAll();
+
+    ioThread->Join();
+    SafeRelease(ioThread);
+}
+
+AsyncFileReader::RequestPtr AsyncFileReader::Read(const FilePath& filePath, uint64 offset, uint64 size, ePriority priority, const Callback& callback)
+{
+    RequestPtr request = std::make_shared<Request>();
+    request->filePath = filePath;
+    request->offset = offset;
+    request->size = size;
+    request->priority = priority;
+    request->callback = callback;
+    return Submit(request);
+}
+
+AsyncFileReader::RequestPtr AsyncFileReader::ReadFile(const FilePath& filePath, ePriority priority, const Callback& callback)
+{
+    RequestPtr request = std::make_shared<Request>();
+    request->filePath = filePath;
+    request->wholeFile = true;
+    request->priority = priority;
+    request->callback = callback;
+    return Submit(request);
+}
+
+AsyncFileReader::RequestPtr AsyncFileReader::ReadFromArchive(const ResourceArchive& archive, const String& relativeFilePath, ePriority priority, const Callback& callback)
+{
+    RequestPtr request = std::make_shared<Request>();
+    request->filePath = archive.GetArchivePath();
+    request->archive = &archive;
+    request->archiveFilePath = relativeFilePath;
+    request->priority = priority;
+    request->callback = callback;
+
+    ResourceArchive::PackedLocation location;
+    if (archive.GetPackedLocation(relativeFilePath, location))
+    {
+        request->offset = location.offset;
+        request->size = location.size;
+    }
+    else
+    {
+        // archive can't give location of packed content (e.g. zip), whole file is loaded by archive itself
+        request->wholeFile = true;
+    }
+    return Submit(request);
+}
+
+uint32 AsyncFileReader::GetPendingRequestsCount() const
+{
+    LockGuard<Mutex> guard(queueMutex);
+    return activeRequestsCount;
+}
+
+void AsyncFileReader::WaitAll() const
+{
+    UniqueLock<Mutex> lock(queueMutex);
+    queueCV.Wait(lock, [this]() { return activeRequestsCount == 0; });
+}
+
+AsyncFileReader::RequestPtr AsyncFileReader::Submit(const RequestPtr& request)
+{
+    {
+        LockGuard<Mutex> guard(queueMutex);
+        DVASSERT(!stopThread);
+
+        queues[static_cast<size_t>(request->priority)].push_back(request);
+        ++activeRequestsCount;
+    }
+    queueCV.NotifyAll();
+    return request;
+}
+
+bool AsyncFileReader::TakeBatch(Vector<RequestPtr>& batch)
+{
+    UniqueLock<Mutex> lock(queueMutex);
+    while (batch.empty())
+    {
+        queueCV.Wait(lock, [this]() {
+            return stopThread || std::any_of(queues.begin(), queues.end(), [](const Deque<RequestPtr>& q) { return !q.empty(); });
+        });
+
+        if (stopThread)
+        {
+            return false;
+        }
+
+        // take the first request with the highest priority
+        for (auto queue = queues.rbegin(); queue != queues.rend() && batch.empty(); ++queue)
+        {
+            while (!queue->empty() && batch.empty())
+            {
+                RequestPtr request = queue->front();
+                queue->pop_front();
+
+                bool expected = false;
+                if (request->started.compare_exchange_strong(expected, true))
+                {
+                    batch.push_back(request);
+                }
+                else
+                {
+                    // cancelled request
+                    --activeRequestsCount;
+                    queueCV.NotifyAll();
+                }
+            }
+        }
+    }
+
+    // take all pending ranged requests to the same file regardless of their priority,
+    // they will be served by the same sequential read
+    RequestPtr first = batch.front();
+    if (!first->wholeFile)
+    {
+        for (Deque<RequestPtr>& queue : queues)
+        {
+            auto it = queue.begin();
+            while (it != queue.end())
+            {
+                const RequestPtr& request = *it;
+                if (!request->wholeFile && request->filePath == first->filePath)
+                {
+                    bool expected = false;
+                    if (request->started.compare_exchange_strong(expected, true))
+                    {
+                        batch.push_back(request);
+                    }
+                    else
+                    {
+                        --activeRequestsCount;
+                        queueCV.NotifyAll();
+                    }
+                    it = queue.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+void AsyncFileReader::ExecuteBatch(Vector<RequestPtr>& batch)
+{
+    using namespace AsyncFileReaderDetails;
+
+    if (batch.front()->wholeFile)
+    {
+        DVASSERT(batch.size() == 1);
+        if (batch.front()->archive != nullptr)
+        {
+            ExecuteArchiveRequest(batch.front());
+        }
+        else
+        {
+            ExecuteWholeFileRequest(batch.front());
+        }
+        return;
+    }
+
+    std::stable_sort(batch.begin(), batch.end(), [](const RequestPtr& l, const RequestPtr& r) { return l->offset < r->offset; });
+
+    RefPtr<File> file(File::Create(batch.front()->filePath, File::OPEN | File::READ));
+    if (!file)
+    {
+        Logger::Error("[AsyncFileReader] can't open file: %s", batch.front()->filePath.GetStringValue().c_str());
+        for (const RequestPtr& request : batch)
+        {
+            Finish(request, false);
+        }
+        return;
+    }
+
+    const uint64 fileSize = file->GetSize();
+    Vector<uint8> buffer;
+
+    size_t segmentBegin = 0;
+    while (segmentBegin < batch.size())
+    {
+        // merge neighbouring ranges into one segment
+        const uint64 readOffset = batch[segmentBegin]->offset;
+        uint64 readEnd = readOffset + batch[segmentBegin]->size;
+        size_t segmentEnd = segmentBegin + 1;
+        while (segmentEnd < batch.size())
+        {
+            const Request& next = *batch[segmentEnd];
+            uint64 mergedEnd = std::max(readEnd, next.offset + next.size);
+            if (next.offset > readEnd + MAX_MERGE_GAP || mergedEnd - readOffset > MAX_MERGED_READ_SIZE)
+            {
+                break;
+            }
+            readEnd = mergedEnd;
+            ++segmentEnd;
+        }
+
+        // ranges beyond the end of file are failed, others are served from the read part
+        readEnd = std::min(readEnd, fileSize);
+        uint64 readSize = readOffset < readEnd ? readEnd - readOffset : 0;
+        buffer.resize(static_cast<size_t>(readSize));
+
+        bool readOk = readSize == 0 || (file->Seek(static_cast<int64>(readOffset), File::SEEK_FROM_START) && ReadFully(file.Get(), buffer.data(), readSize));
+        if (!readOk)
+        {
+            Logger::Error("[AsyncFileReader] can't read %llu bytes at %llu from file: %s", readSize, readOffset, batch.front()->filePath.GetStringValue().c_str());
+        }
+
+        for (size_t i = segmentBegin; i < segmentEnd; ++i)
+        {
+            const RequestPtr& request = batch[i];
+            if (!readOk || request->offset + request->size > readOffset + readSize)
+            {
+                Finish(request, false);
+                continue;
+            }
+
+            const uint8* content = buffer.data() + (request->offset - readOffset);
+            bool success = true;
+            if (request->archive != nullptr)
+            {
+                try
+                {
+                    success = request->archive->DecodePackedContent(request->archiveFilePath, content, static_cast<uint32>(request->size), request->data);
+                }
+                catch (std::exception& ex)
+                {
+                    Logger::Error("[AsyncFileReader] can't decode file: %s from archive: %s, %s", request->archiveFilePath.c_str(), request->filePath.GetStringValue().c_str(), ex.what());
+                    success = false;
+                }
+            }
+            else
+            {
+                request->data.assign(content, content + request->size);
+            }
+            Finish(request, success);
+        }
+
+        segmentBegin = segmentEnd;
+    }
+}
+
+void AsyncFileReader::ExecuteWholeFileRequest(const RequestPtr& request)
+{
+    using namespace AsyncFileReaderDetails;
+
+    RefPtr<File> file(File::Create(request->filePath, File::OPEN | File::READ));
+    if (!file)
+    {
+        Logger::Error("[AsyncFileReader] can't open file: %s", request->filePath.GetStringValue().c_str());
+        Finish(request, false);
+        return;
+    }
+
+    uint64 fileSize = file->GetSize();
+    request->data.resize(static_cast<size_t>(fileSize));
+    bool success = ReadFully(file.Get(), request->data.data(), fileSize);
+    if (!success)
+    {
+        Logger::Error("[AsyncFileReader] can't read file: %s", request->filePath.GetStringValue().c_str());
+    }
+    Finish(request, success);
+}
+
+void AsyncFileReader::ExecuteArchiveRequest(const RequestPtr& request)
+{
+    bool success = false;
+    try
+    {
+        success = request->archive->LoadFile(request->archiveFilePath, request->data);
+    }
+    catch (std::exception& ex)
+    {
+        Logger::Error("[AsyncFileReader] can't load file: %s from archive: %s, %s", request->archiveFilePath.c_str(), request->filePath.GetStringValue().c_str(), ex.what());
+    }
+    Finish(request, success);
+}
+
+void AsyncFileReader::Finish(const RequestPtr& request, bool success)
+{
+    if (!success)
+    {
+        request->data.clear();
+        request->data.shrink_to_fit();
+    }
+    request->SetFinished(success ? eStatus::Done : eStatus::Failed);
+
+    if (request->callback)
+    {
+        request->callback(request);
+    }
+
+    {
+        LockGuard<Mutex> guard(queueMutex);
+        --activeRequestsCount;
+    }
+    queueCV.NotifyAll();
+}
+
+void AsyncFileReader::ThreadFunc()
+{
+    Vector<RequestPtr> batch;
+    while (TakeBatch(batch))
+    {
+        ExecuteBatch(batch);
+        batch.clear();
+    }
+}
+
+} // namespace DAVA
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Concurrency/ConditionVariable.h"
+#include "Concurrency/Mutex.h"
+#include "FileSystem/FilePath.h"
+#include "Functional/Function.h"
+
+#include <atomic>
+
+namespace DAVA
+{
+class Thread;
+class ResourceArchive;
+
+/**
+    Asynchronous file reader.
+
+    Requests are executed in a dedicated I/O thread in order of priority, requests with the same priority
+    are executed in order of submission. When request is taken, all pending requests to the same file
+    are taken with it and read in order of offsets, requests to neighbouring ranges of file are merged
+    into one sequential read. So requests of several files from one pack archive (see `ReadFromArchive`)
+    are usually served by one read of the pack.
+
+    Every request returns `RequestPtr`, that can be used as a future: to check status, to wait for result
+    or to cancel request. Optional completion callback is called in the I/O thread after request is finished,
+    use `RunOnMainThreadAsync` in it to pass result to the main thread. Callback is not called for cancelled requests.
+*/
+class AsyncFileReader final
+{
+public:
+    enum class ePriority : uint32
+    {
+        Low = 0,
+        Normal,
+        High,
+
+        Count
+    };
+
+    enum class eStatus : uint32
+    {
+        Pending,
+        Done,
+        Failed,
+        Cancelled
+    };
+
+    class Request final
+    {
+    public:
+        eStatus GetStatus() const;
+        bool IsFinished() const;
+
+        /** Block calling thread until request is finished. */
+        void Wait() const;
+
+        /** Cancel request if it has not been started yet. Return true if request is cancelled. */
+        bool Cancel();
+
+        /** Return read content. Content is valid only if status is `eStatus::Done`. */
+        const Vector<uint8>& GetData() const;
+        Vector<uint8>& GetData();
+
+        const FilePath& GetFilePath() const;
+        const String& GetArchiveFilePath() const;
+
+    private:
+        void SetFinished(eStatus finalStatus);
+
+        FilePath filePath;
+        uint64 offset = 0;
+        uint64 size = 0;
+        bool wholeFile = false;
+        ePriority priority = ePriority::Normal;
+
+        // request of file from archive, content is decoded by archive after read
+        const ResourceArchive* archive = nullptr;
+        String archiveFilePath;
+
+        Function<void(const std::shared_ptr<Request>&)> callback;
+
+        std::atomic<eStatus> status{ eStatus::Pending };
+        std::atomic<bool> started{ false };
+        Vector<uint8> data;
+
+        mutable Mutex waitMutex;
+        mutable ConditionVariable waitCV;
+
+        friend class AsyncFileReader;
+    };
+
+    using RequestPtr = std::shared_ptr<Request>;
+    using Callback = Function<void(const RequestPtr&)>;
+
+    /** Max distance between neighbouring requested ranges of one file, which are still merged into one read. */
+    static const uint32 MAX_MERGE_GAP = 64 * 1024;
+    /** Max size of one merged read. */
+    static const uint32 MAX_MERGED_READ_SIZE = 8 * 1024 * 1024;
+
+    AsyncFileReader();
+    ~AsyncFileReader();
+
+    AsyncFileReader(const AsyncFileReader&) = delete;
+    AsyncFileReader& operator=(const AsyncFileReader&) = delete;
+
+    /**
+        Read `size` bytes of file `filePath` starting from `offset`.
+        Request fails if file is shorter than `offset + size`.
+    */
+    RequestPtr Read(const FilePath& filePath, uint64 offset, uint64 size, ePriority priority = ePriority::Normal, const Callback& callback = nullptr);
+
+    /** Read whole file `filePath`, compressed `.dvpl` files are supported as by `File::Create`. */
+    RequestPtr ReadFile(const FilePath& filePath, ePriority priority = ePriority::Normal, const Callback& callback = nullptr);
+
+    /**
+        Read file `relativeFilePath` from `archive`. Packed content is read by I/O thread and decoded
+        by archive, see `ResourceArchive::GetPackedLocation`. Archive should be alive until request is finished.
+    */
+    RequestPtr ReadFromArchive(const ResourceArchive& archive, const String& relativeFilePath, ePriority priority = ePriority::Normal, const Callback& callback = nullptr);
+
+    /** Return number of requests which are not finished yet. */
+    uint32 GetPendingRequestsCount() const;
+
+    /** Block calling thread until all submitted requests are finished. */
+    void WaitAll() const;
+
+private:
+    RequestPtr Submit(const RequestPtr& request);
+    bool TakeBatch(Vector<RequestPtr>& batch);
+    void ExecuteBatch(Vector<RequestPtr>& batch);
+    void ExecuteWholeFileRequest(const RequestPtr& request);
+    void ExecuteArchiveRequest(const RequestPtr& request);
+    void Finish(const RequestPtr& request, bool success);
+    void ThreadFunc();
+
+    Thread* ioThread = nullptr;
+
+    mutable Mutex queueMutex;
+    mutable ConditionVariable queueCV;
+    Array<Deque<RequestPtr>, static_cast<size_t>(ePriority::Count)> queues;
+    uint32 activeRequestsCount = 0;
+    bool stopThread = false;
+};
+}
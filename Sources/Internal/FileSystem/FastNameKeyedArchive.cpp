@@ -0,0 +1,931 @@
+#include "FileSystem/FastNameKeyedArchive.h"
+#include "FileSystem/DynamicMemoryFile.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FilePath.h"
+#include "FileSystem/KeyedArchive.h"
+#include "FileSystem/MappedMemoryFile.h"
+#include "Logger/Logger.h"
+#include "Utils/UTF8Utils.h"
+
+#include <algorithm>
+
+namespace DAVA
+{
+namespace FastNameKeyedArchiveDetails
+{
+const uint16 ARCHIVE_VERSION = 1;
+
+template <typename T>
+void Append(Vector<uint8>& data, const T& value)
+{
+    const uint8* bytes = reinterpret_cast<const uint8*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+void AppendBytes(Vector<uint8>& data, const uint8* bytes, uint32 size)
+{
+    Append(data, size);
+    data.insert(data.end(), bytes, bytes + size);
+}
+
+uint32 GetPodSize(VariantType::eVariantType type)
+{
+    switch (type)
+    {
+    case VariantType::TYPE_BOOLEAN:
+    case VariantType::TYPE_INT8:
+    case VariantType::TYPE_UINT8:
+        return 1;
+    case VariantType::TYPE_INT16:
+    case VariantType::TYPE_UINT16:
+        return 2;
+    case VariantType::TYPE_INT32:
+    case VariantType::TYPE_UINT32:
+    case VariantType::TYPE_FLOAT:
+        return 4;
+    case VariantType::TYPE_INT64:
+    case VariantType::TYPE_UINT64:
+    case VariantType::TYPE_FLOAT64:
+        return 8;
+    case VariantType::TYPE_VECTOR2:
+        return sizeof(Vector2);
+    case VariantType::TYPE_VECTOR3:
+        return sizeof(Vector3);
+    case VariantType::TYPE_VECTOR4:
+        return sizeof(Vector4);
+    case VariantType::TYPE_MATRIX2:
+        return sizeof(Matrix2);
+    case VariantType::TYPE_MATRIX3:
+        return sizeof(Matrix3);
+    case VariantType::TYPE_MATRIX4:
+        return sizeof(Matrix4);
+    case VariantType::TYPE_COLOR:
+        return sizeof(Color);
+    case VariantType::TYPE_AABBOX3:
+        return sizeof(AABBox3);
+    default:
+        return 0;
+    }
+}
+
+const uint32 MAX_POD_SIZE = sizeof(Matrix4);
+static_assert(sizeof(Matrix3) <= MAX_POD_SIZE && sizeof(AABBox3) <= MAX_POD_SIZE, "Buffer for POD values is too small");
+
+/** Content of memory file or memory block, values are taken from it without copying. */
+struct MemorySource
+{
+    const uint8* begin;
+    const uint8* current;
+    const uint8* end;
+
+    bool Read(void* value, uint32 size)
+    {
+        if (static_cast<uint64>(end - current) < size)
+        {
+            return false;
+        }
+        Memcpy(value, current, size);
+        current += size;
+        return true;
+    }
+
+    bool ReadView(uint32 size, const uint8*& view)
+    {
+        if (static_cast<uint64>(end - current) < size)
+        {
+            return false;
+        }
+        view = current;
+        current += size;
+        return true;
+    }
+
+    bool Rewind(uint32 size)
+    {
+        if (static_cast<uint64>(current - begin) < size)
+        {
+            return false;
+        }
+        current -= size;
+        return true;
+    }
+
+    bool IsEof() const
+    {
+        return current >= end;
+    }
+};
+
+/** Generic file, values are read one by one into scratch buffer. */
+struct FileSource
+{
+    File* file;
+    Vector<uint8> scratch;
+
+    bool Read(void* value, uint32 size)
+    {
+        return file->Read(value, size) == size;
+    }
+
+    bool ReadView(uint32 size, const uint8*& view)
+    {
+        scratch.resize(size);
+        view = scratch.data();
+        return Read(scratch.data(), size);
+    }
+
+    bool Rewind(uint32 size)
+    {
+        return file->Seek(-static_cast<int64>(size), File::SEEK_FROM_CURRENT);
+    }
+
+    bool IsEof() const
+    {
+        return file->IsEof();
+    }
+};
+}
+
+FastNameKeyedArchive::FastNameKeyedArchive() = default;
+
+FastNameKeyedArchive::~FastNameKeyedArchive() = default;
+
+bool FastNameKeyedArchive::IsKeyExists(const FastName& key) const
+{
+    return FindItem(key) != nullptr;
+}
+
+VariantType::eVariantType FastNameKeyedArchive::GetType(const FastName& key) const
+{
+    const Item* item = FindItem(key);
+    return (item != nullptr) ? item->type : VariantType::TYPE_NONE;
+}
+
+uint32 FastNameKeyedArchive::Count() const
+{
+    return static_cast<uint32>(items.size());
+}
+
+bool FastNameKeyedArchive::GetBool(const FastName& key, bool defaultValue) const
+{
+    return GetValue<uint8>(key, VariantType::TYPE_BOOLEAN, defaultValue ? 1 : 0) != 0;
+}
+
+int32 FastNameKeyedArchive::GetInt32(const FastName& key, int32 defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_INT32, defaultValue);
+}
+
+uint32 FastNameKeyedArchive::GetUInt32(const FastName& key, uint32 defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_UINT32, defaultValue);
+}
+
+int64 FastNameKeyedArchive::GetInt64(const FastName& key, int64 defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_INT64, defaultValue);
+}
+
+uint64 FastNameKeyedArchive::GetUInt64(const FastName& key, uint64 defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_UINT64, defaultValue);
+}
+
+float32 FastNameKeyedArchive::GetFloat(const FastName& key, float32 defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_FLOAT, defaultValue);
+}
+
+float64 FastNameKeyedArchive::GetFloat64(const FastName& key, float64 defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_FLOAT64, defaultValue);
+}
+
+String FastNameKeyedArchive::GetString(const FastName& key, const String& defaultValue) const
+{
+    const Item* item = FindItem(key);
+    if (item != nullptr && item->type == VariantType::TYPE_STRING)
+    {
+        return String(reinterpret_cast<const char*>(GetItemData(*item)), item->size);
+    }
+    return defaultValue;
+}
+
+FastName FastNameKeyedArchive::GetFastName(const FastName& key, const FastName& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_FASTNAME, defaultValue);
+}
+
+FilePath FastNameKeyedArchive::GetFilePath(const FastName& key, const FilePath& defaultValue) const
+{
+    const Item* item = FindItem(key);
+    if (item != nullptr && item->type == VariantType::TYPE_FILEPATH)
+    {
+        return FilePath(String(reinterpret_cast<const char*>(GetItemData(*item)), item->size));
+    }
+    return defaultValue;
+}
+
+Vector2 FastNameKeyedArchive::GetVector2(const FastName& key, const Vector2& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_VECTOR2, defaultValue);
+}
+
+Vector3 FastNameKeyedArchive::GetVector3(const FastName& key, const Vector3& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_VECTOR3, defaultValue);
+}
+
+Vector4 FastNameKeyedArchive::GetVector4(const FastName& key, const Vector4& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_VECTOR4, defaultValue);
+}
+
+Matrix2 FastNameKeyedArchive::GetMatrix2(const FastName& key, const Matrix2& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_MATRIX2, defaultValue);
+}
+
+Matrix3 FastNameKeyedArchive::GetMatrix3(const FastName& key, const Matrix3& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_MATRIX3, defaultValue);
+}
+
+Matrix4 FastNameKeyedArchive::GetMatrix4(const FastName& key, const Matrix4& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_MATRIX4, defaultValue);
+}
+
+Color FastNameKeyedArchive::GetColor(const FastName& key, const Color& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_COLOR, defaultValue);
+}
+
+AABBox3 FastNameKeyedArchive::GetAABBox3(const FastName& key, const AABBox3& defaultValue) const
+{
+    return GetValue(key, VariantType::TYPE_AABBOX3, defaultValue);
+}
+
+const uint8* FastNameKeyedArchive::GetByteArray(const FastName& key, const uint8* defaultValue) const
+{
+    const Item* item = FindItem(key);
+    if (item != nullptr && item->type == VariantType::TYPE_BYTE_ARRAY)
+    {
+        return GetItemData(*item);
+    }
+    return defaultValue;
+}
+
+uint32 FastNameKeyedArchive::GetByteArraySize(const FastName& key, uint32 defaultValue) const
+{
+    const Item* item = FindItem(key);
+    if (item != nullptr && item->type == VariantType::TYPE_BYTE_ARRAY)
+    {
+        return item->size;
+    }
+    return defaultValue;
+}
+
+bool FastNameKeyedArchive::GetArchive(const FastName& key, FastNameKeyedArchive* archive) const
+{
+    DVASSERT(archive != nullptr && archive != this);
+
+    const Item* item = FindItem(key);
+    if (item != nullptr && item->type == VariantType::TYPE_KEYED_ARCHIVE)
+    {
+        archive->DeleteAllKeys();
+        return archive->Load(GetItemData(*item), item->size);
+    }
+    return false;
+}
+
+void FastNameKeyedArchive::SetBool(const FastName& key, bool value)
+{
+    SetValue<uint8>(key, VariantType::TYPE_BOOLEAN, value ? 1 : 0);
+}
+
+void FastNameKeyedArchive::SetInt32(const FastName& key, int32 value)
+{
+    SetValue(key, VariantType::TYPE_INT32, value);
+}
+
+void FastNameKeyedArchive::SetUInt32(const FastName& key, uint32 value)
+{
+    SetValue(key, VariantType::TYPE_UINT32, value);
+}
+
+void FastNameKeyedArchive::SetInt64(const FastName& key, int64 value)
+{
+    SetValue(key, VariantType::TYPE_INT64, value);
+}
+
+void FastNameKeyedArchive::SetUInt64(const FastName& key, uint64 value)
+{
+    SetValue(key, VariantType::TYPE_UINT64, value);
+}
+
+void FastNameKeyedArchive::SetFloat(const FastName& key, float32 value)
+{
+    SetValue(key, VariantType::TYPE_FLOAT, value);
+}
+
+void FastNameKeyedArchive::SetFloat64(const FastName& key, float64 value)
+{
+    SetValue(key, VariantType::TYPE_FLOAT64, value);
+}
+
+void FastNameKeyedArchive::SetString(const FastName& key, const String& value)
+{
+    SetItemData(AcquireItem(key), VariantType::TYPE_STRING, value.data(), static_cast<uint32>(value.size()));
+}
+
+void FastNameKeyedArchive::SetFastName(const FastName& key, const FastName& value)
+{
+    SetValue(key, VariantType::TYPE_FASTNAME, value);
+}
+
+void FastNameKeyedArchive::SetFilePath(const FastName& key, const FilePath& value)
+{
+    String pathname = value.GetAbsolutePathname();
+    SetItemData(AcquireItem(key), VariantType::TYPE_FILEPATH, pathname.data(), static_cast<uint32>(pathname.size()));
+}
+
+void FastNameKeyedArchive::SetVector2(const FastName& key, const Vector2& value)
+{
+    SetValue(key, VariantType::TYPE_VECTOR2, value);
+}
+
+void FastNameKeyedArchive::SetVector3(const FastName& key, const Vector3& value)
+{
+    SetValue(key, VariantType::TYPE_VECTOR3, value);
+}
+
+void FastNameKeyedArchive::SetVector4(const FastName& key, const Vector4& value)
+{
+    SetValue(key, VariantType::TYPE_VECTOR4, value);
+}
+
+void FastNameKeyedArchive::SetMatrix2(const FastName& key, const Matrix2& value)
+{
+    SetValue(key, VariantType::TYPE_MATRIX2, value);
+}
+
+void FastNameKeyedArchive::SetMatrix3(const FastName& key, const Matrix3& value)
+{
+    SetValue(key, VariantType::TYPE_MATRIX3, value);
+}
+
+void FastNameKeyedArchive::SetMatrix4(const FastName& key, const Matrix4& value)
+{
+    SetValue(key, VariantType::TYPE_MATRIX4, value);
+}
+
+void FastNameKeyedArchive::SetColor(const FastName& key, const Color& value)
+{
+    SetValue(key, VariantType::TYPE_COLOR, value);
+}
+
+void FastNameKeyedArchive::SetAABBox3(const FastName& key, const AABBox3& value)
+{
+    SetValue(key, VariantType::TYPE_AABBOX3, value);
+}
+
+void FastNameKeyedArchive::SetByteArray(const FastName& key, const uint8* value, uint32 size)
+{
+    SetItemData(AcquireItem(key), VariantType::TYPE_BYTE_ARRAY, value, size);
+}
+
+void FastNameKeyedArchive::SetArchive(const FastName& key, const FastNameKeyedArchive* archive)
+{
+    DVASSERT(archive != nullptr);
+
+    Vector<uint8> data;
+    archive->Save(data);
+    SetItemData(AcquireItem(key), VariantType::TYPE_KEYED_ARCHIVE, data.data(), static_cast<uint32>(data.size()));
+}
+
+void FastNameKeyedArchive::SetVariant(const FastName& key, const VariantType& value)
+{
+    switch (value.GetType())
+    {
+    case VariantType::TYPE_BOOLEAN:
+        SetBool(key, value.AsBool());
+        break;
+    case VariantType::TYPE_INT8:
+        SetValue(key, VariantType::TYPE_INT8, value.AsInt8());
+        break;
+    case VariantType::TYPE_UINT8:
+        SetValue(key, VariantType::TYPE_UINT8, value.AsUInt8());
+        break;
+    case VariantType::TYPE_INT16:
+        SetValue(key, VariantType::TYPE_INT16, value.AsInt16());
+        break;
+    case VariantType::TYPE_UINT16:
+        SetValue(key, VariantType::TYPE_UINT16, static_cast<uint16>(value.AsUInt16()));
+        break;
+    case VariantType::TYPE_INT32:
+        SetInt32(key, value.AsInt32());
+        break;
+    case VariantType::TYPE_UINT32:
+        SetUInt32(key, value.AsUInt32());
+        break;
+    case VariantType::TYPE_INT64:
+        SetInt64(key, value.AsInt64());
+        break;
+    case VariantType::TYPE_UINT64:
+        SetUInt64(key, value.AsUInt64());
+        break;
+    case VariantType::TYPE_FLOAT:
+        SetFloat(key, value.AsFloat());
+        break;
+    case VariantType::TYPE_FLOAT64:
+        SetFloat64(key, value.AsFloat64());
+        break;
+    case VariantType::TYPE_STRING:
+        SetString(key, value.AsString());
+        break;
+    case VariantType::TYPE_WIDE_STRING:
+        SetString(key, UTF8Utils::EncodeToUTF8(value.AsWideString()));
+        break;
+    case VariantType::TYPE_FASTNAME:
+        SetFastName(key, value.AsFastName());
+        break;
+    case VariantType::TYPE_FILEPATH:
+        SetFilePath(key, value.AsFilePath());
+        break;
+    case VariantType::TYPE_VECTOR2:
+        SetVector2(key, value.AsVector2());
+        break;
+    case VariantType::TYPE_VECTOR3:
+        SetVector3(key, value.AsVector3());
+        break;
+    case VariantType::TYPE_VECTOR4:
+        SetVector4(key, value.AsVector4());
+        break;
+    case VariantType::TYPE_MATRIX2:
+        SetMatrix2(key, value.AsMatrix2());
+        break;
+    case VariantType::TYPE_MATRIX3:
+        SetMatrix3(key, value.AsMatrix3());
+        break;
+    case VariantType::TYPE_MATRIX4:
+        SetMatrix4(key, value.AsMatrix4());
+        break;
+    case VariantType::TYPE_COLOR:
+        SetColor(key, value.AsColor());
+        break;
+    case VariantType::TYPE_AABBOX3:
+        SetAABBox3(key, value.AsAABBox3());
+        break;
+    case VariantType::TYPE_BYTE_ARRAY:
+        SetByteArray(key, value.AsByteArray(), static_cast<uint32>(value.AsByteArraySize()));
+        break;
+    case VariantType::TYPE_KEYED_ARCHIVE:
+    {
+        ScopedPtr<DynamicMemoryFile> file(DynamicMemoryFile::Create(File::CREATE | File::WRITE));
+        value.AsKeyedArchive()->Save(file);
+        SetItemData(AcquireItem(key), VariantType::TYPE_KEYED_ARCHIVE, file->GetData(), static_cast<uint32>(file->GetSize()));
+    }
+    break;
+    default:
+        Logger::Error("[FastNameKeyedArchive] unsupported value type %d for key %s", value.GetType(), key.c_str());
+        DVASSERT(false, "Unsupported value type");
+        break;
+    }
+}
+
+void FastNameKeyedArchive::DeleteKey(const FastName& key)
+{
+    auto it = std::lower_bound(items.begin(), items.end(), key, [](const Item& item, const FastName& key) { return item.key < key; });
+    if (it != items.end() && it->key == key)
+    {
+        ReleaseItemData(*it);
+        items.erase(it);
+        CompactBuffer();
+    }
+}
+
+void FastNameKeyedArchive::DeleteAllKeys()
+{
+    items.clear();
+    buffer.clear();
+    unusedBufferSize = 0;
+}
+
+bool FastNameKeyedArchive::Load(File* file)
+{
+    using namespace FastNameKeyedArchiveDetails;
+
+    DVASSERT(file != nullptr);
+
+    const uint8* content = nullptr;
+    if (DynamicMemoryFile* memoryFile = dynamic_cast<DynamicMemoryFile*>(file))
+    {
+        content = memoryFile->GetData();
+    }
+    else if (MappedMemoryFile* mappedFile = dynamic_cast<MappedMemoryFile*>(file))
+    {
+        content = mappedFile->GetData();
+    }
+
+    uint64 position = file->GetPos();
+    uint64 size = file->GetSize();
+    if (content != nullptr && position < size)
+    {
+        MemorySource source = { content + position, content + position, content + size };
+        bool loaded = LoadItems(source);
+        file->Seek(source.current - content, File::SEEK_FROM_START);
+        return loaded;
+    }
+
+    FileSource source = { file };
+    return LoadItems(source);
+}
+
+bool FastNameKeyedArchive::Load(const uint8* data, uint32 size)
+{
+    using namespace FastNameKeyedArchiveDetails;
+
+    if (nullptr == data || 0 == size)
+    {
+        return false;
+    }
+
+    MemorySource source = { data, data, data + size };
+    return LoadItems(source);
+}
+
+bool FastNameKeyedArchive::Load(const FilePath& pathName)
+{
+    ScopedPtr<File> file(File::Create(pathName, File::OPEN | File::READ));
+    if (!file)
+    {
+        return false;
+    }
+    return Load(file);
+}
+
+bool FastNameKeyedArchive::Save(File* file) const
+{
+    DVASSERT(file != nullptr);
+
+    Vector<uint8> data;
+    if (!Save(data))
+    {
+        return false;
+    }
+
+    uint32 size = static_cast<uint32>(data.size());
+    return file->Write(data.data(), size) == size && file->Flush();
+}
+
+bool FastNameKeyedArchive::Save(Vector<uint8>& data) const
+{
+    using namespace FastNameKeyedArchiveDetails;
+
+    // keys are written in same order as KeyedArchive does, so both classes produce same files
+    Vector<const Item*> orderedItems;
+    orderedItems.reserve(items.size());
+    for (const Item& item : items)
+    {
+        orderedItems.push_back(&item);
+    }
+    std::sort(orderedItems.begin(), orderedItems.end(), [](const Item* l, const Item* r) { return strcmp(l->key.c_str(), r->key.c_str()) < 0; });
+
+    data.push_back('K');
+    data.push_back('A');
+    Append(data, ARCHIVE_VERSION);
+    Append(data, static_cast<uint32>(orderedItems.size()));
+
+    for (const Item* item : orderedItems)
+    {
+        Append(data, static_cast<uint8>(VariantType::TYPE_STRING));
+        AppendBytes(data, reinterpret_cast<const uint8*>(item->key.c_str()), static_cast<uint32>(strlen(item->key.c_str())));
+
+        Append(data, static_cast<uint8>(item->type));
+        const uint8* itemData = GetItemData(*item);
+        switch (item->type)
+        {
+        case VariantType::TYPE_STRING:
+        case VariantType::TYPE_FILEPATH:
+        case VariantType::TYPE_BYTE_ARRAY:
+        case VariantType::TYPE_KEYED_ARCHIVE:
+            AppendBytes(data, itemData, item->size);
+            break;
+        case VariantType::TYPE_FASTNAME:
+        {
+            FastName value;
+            Memcpy(&value, itemData, sizeof(FastName));
+            const char* str = value.IsValid() ? value.c_str() : "";
+            AppendBytes(data, reinterpret_cast<const uint8*>(str), static_cast<uint32>(strlen(str)));
+        }
+        break;
+        default:
+            DVASSERT(GetPodSize(item->type) == item->size);
+            data.insert(data.end(), itemData, itemData + item->size);
+            break;
+        }
+    }
+    return true;
+}
+
+bool FastNameKeyedArchive::Save(const FilePath& pathName) const
+{
+    ScopedPtr<File> file(File::Create(pathName, File::CREATE | File::WRITE));
+    if (!file)
+    {
+        return false;
+    }
+    return Save(file);
+}
+
+void FastNameKeyedArchive::CopyFrom(const KeyedArchive* archive)
+{
+    DVASSERT(archive != nullptr);
+
+    DeleteAllKeys();
+
+    ScopedPtr<DynamicMemoryFile> file(DynamicMemoryFile::Create(File::CREATE | File::WRITE));
+    if (archive->Save(file) && file->GetSize() > 0)
+    {
+        Load(file->GetData(), static_cast<uint32>(file->GetSize()));
+    }
+}
+
+void FastNameKeyedArchive::CopyTo(KeyedArchive* archive) const
+{
+    DVASSERT(archive != nullptr);
+
+    Vector<uint8> data;
+    Save(data);
+    archive->Load(data.data(), static_cast<uint32>(data.size()));
+}
+
+const FastNameKeyedArchive::Item* FastNameKeyedArchive::FindItem(const FastName& key) const
+{
+    auto it = std::lower_bound(items.begin(), items.end(), key, [](const Item& item, const FastName& key) { return item.key < key; });
+    if (it != items.end() && it->key == key)
+    {
+        return &(*it);
+    }
+    return nullptr;
+}
+
+FastNameKeyedArchive::Item& FastNameKeyedArchive::AcquireItem(const FastName& key)
+{
+    DVASSERT(key.IsValid());
+
+    auto it = std::lower_bound(items.begin(), items.end(), key, [](const Item& item, const FastName& key) { return item.key < key; });
+    if (it == items.end() || it->key != key)
+    {
+        it = items.insert(it, Item());
+        it->key = key;
+    }
+    return *it;
+}
+
+FastNameKeyedArchive::Item& FastNameKeyedArchive::AppendItem(const FastName& key)
+{
+    DVASSERT(key.IsValid());
+
+    items.emplace_back();
+    items.back().key = key;
+    return items.back();
+}
+
+const uint8* FastNameKeyedArchive::GetItemData(const Item& item) const
+{
+    return (item.size <= INLINE_SIZE) ? item.inlineData : buffer.data() + item.bufferOffset;
+}
+
+void FastNameKeyedArchive::SetItemData(Item& item, VariantType::eVariantType type, const void* data, uint32 size)
+{
+    const uint8* bytes = static_cast<const uint8*>(data);
+    if (size <= INLINE_SIZE)
+    {
+        ReleaseItemData(item);
+        Memmove(item.inlineData, bytes, size);
+    }
+    else if (item.size > INLINE_SIZE && item.size >= size)
+    {
+        // reuse place of previous value, its tail becomes unused
+        Memmove(buffer.data() + item.bufferOffset, bytes, size);
+        unusedBufferSize += item.size - size;
+    }
+    else
+    {
+        ReleaseItemData(item);
+        bool isOwnData = !buffer.empty() && bytes >= buffer.data() && bytes < buffer.data() + buffer.size();
+        size_t sourceOffset = isOwnData ? static_cast<size_t>(bytes - buffer.data()) : 0;
+
+        item.bufferOffset = static_cast<uint32>(buffer.size());
+        buffer.resize(buffer.size() + size);
+        if (isOwnData)
+        {
+            bytes = buffer.data() + sourceOffset;
+        }
+        Memcpy(buffer.data() + item.bufferOffset, bytes, size);
+    }
+
+    item.type = type;
+    item.size = size;
+    CompactBuffer();
+}
+
+void FastNameKeyedArchive::ReleaseItemData(const Item& item)
+{
+    if (item.size > INLINE_SIZE)
+    {
+        unusedBufferSize += item.size;
+    }
+}
+
+void FastNameKeyedArchive::CompactBuffer()
+{
+    // buffer is rebuilt only when at least half of it is unused, so compaction takes amortized constant time per stored byte
+    if (unusedBufferSize == 0 || static_cast<size_t>(unusedBufferSize) * 2 < buffer.size())
+    {
+        return;
+    }
+
+    Vector<uint8> compacted;
+    compacted.reserve(buffer.size() - unusedBufferSize);
+    for (Item& item : items)
+    {
+        if (item.size > INLINE_SIZE)
+        {
+            const uint8* data = buffer.data() + item.bufferOffset;
+            item.bufferOffset = static_cast<uint32>(compacted.size());
+            compacted.insert(compacted.end(), data, data + item.size);
+        }
+    }
+    buffer.swap(compacted);
+    unusedBufferSize = 0;
+}
+
+void FastNameKeyedArchive::SortLoadedItems(size_t firstLoaded)
+{
+    if (firstLoaded == items.size())
+    {
+        return;
+    }
+
+    // both sort and merge are stable, so items with same key stay in order of setting
+    auto keyLess = [](const Item& l, const Item& r) { return l.key < r.key; };
+    std::stable_sort(items.begin() + firstLoaded, items.end(), keyLess);
+    std::inplace_merge(items.begin(), items.begin() + firstLoaded, items.end(), keyLess);
+
+    // last value of key wins, as in KeyedArchive
+    size_t count = 0;
+    for (size_t i = 0; i < items.size(); ++i)
+    {
+        if (i + 1 < items.size() && items[i + 1].key == items[i].key)
+        {
+            ReleaseItemData(items[i]);
+        }
+        else
+        {
+            items[count++] = items[i];
+        }
+    }
+    items.resize(count);
+    CompactBuffer();
+}
+
+template <typename Source>
+bool FastNameKeyedArchive::LoadItems(Source& source)
+{
+    Array<char, 2> header;
+    if (!source.Read(header.data(), 2))
+    {
+        Logger::Error("[FastNameKeyedArchive] error loading keyed archive header");
+        return false;
+    }
+
+    // items are appended while loading and sorted once in the end
+    size_t firstLoaded = items.size();
+    bool loaded = true;
+    String keyBuffer;
+    if ((header[0] != 'K') || (header[1] != 'A'))
+    {
+        // archive without header is sequence of key-value pairs up to end of content
+        loaded = source.Rewind(2);
+        while (loaded && !source.IsEof())
+        {
+            loaded = LoadItem(source, keyBuffer);
+        }
+        SortLoadedItems(firstLoaded);
+        return loaded;
+    }
+
+    uint16 version = 0;
+    uint32 numberOfItems = 0;
+    if (!source.Read(&version, sizeof(version)) || !source.Read(&numberOfItems, sizeof(numberOfItems)))
+    {
+        return false;
+    }
+    if (version != FastNameKeyedArchiveDetails::ARCHIVE_VERSION)
+    {
+        Logger::Error("[FastNameKeyedArchive] error loading keyed archive, because version is incorrect");
+        return false;
+    }
+
+    items.reserve(items.size() + numberOfItems);
+    for (uint32 i = 0; loaded && i < numberOfItems && !source.IsEof(); ++i)
+    {
+        loaded = LoadItem(source, keyBuffer);
+    }
+    SortLoadedItems(firstLoaded);
+    return loaded;
+}
+
+template <typename Source>
+bool FastNameKeyedArchive::LoadItem(Source& source, String& keyBuffer)
+{
+    using namespace FastNameKeyedArchiveDetails;
+
+    uint8 keyType = VariantType::TYPE_NONE;
+    uint32 keyLength = 0;
+    const uint8* keyData = nullptr;
+    if (!source.Read(&keyType, 1) || keyType != VariantType::TYPE_STRING || !source.Read(&keyLength, 4) || !source.ReadView(keyLength, keyData))
+    {
+        Logger::Error("[FastNameKeyedArchive] error loading key");
+        return false;
+    }
+    keyBuffer.assign(reinterpret_cast<const char*>(keyData), keyLength);
+    FastName key(keyBuffer);
+
+    uint8 type = VariantType::TYPE_NONE;
+    if (!source.Read(&type, 1))
+    {
+        return false;
+    }
+
+    VariantType::eVariantType valueType = static_cast<VariantType::eVariantType>(type);
+    switch (valueType)
+    {
+    case VariantType::TYPE_STRING:
+    case VariantType::TYPE_FILEPATH:
+    case VariantType::TYPE_BYTE_ARRAY:
+    case VariantType::TYPE_KEYED_ARCHIVE:
+    {
+        uint32 length = 0;
+        const uint8* data = nullptr;
+        if (!source.Read(&length, 4) || !source.ReadView(length, data))
+        {
+            return false;
+        }
+        SetItemData(AppendItem(key), valueType, data, length);
+    }
+    break;
+    case VariantType::TYPE_FASTNAME:
+    {
+        uint32 length = 0;
+        const uint8* data = nullptr;
+        if (!source.Read(&length, 4) || !source.ReadView(length, data))
+        {
+            return false;
+        }
+        keyBuffer.assign(reinterpret_cast<const char*>(data), length);
+        FastName value(keyBuffer);
+        SetItemData(AppendItem(key), VariantType::TYPE_FASTNAME, &value, sizeof(FastName));
+    }
+    break;
+    case VariantType::TYPE_WIDE_STRING:
+    {
+        // wide strings are loaded as utf8 strings, same as in VariantType::Read
+        uint32 length = 0;
+        if (!source.Read(&length, 4))
+        {
+            return false;
+        }
+        WideString value(length, 0);
+        if (length > 0 && !source.Read(&value[0], length * sizeof(wchar_t)))
+        {
+            return false;
+        }
+        String utf8Value = UTF8Utils::EncodeToUTF8(value);
+        SetItemData(AppendItem(key), VariantType::TYPE_STRING, utf8Value.data(), static_cast<uint32>(utf8Value.size()));
+    }
+    break;
+    default:
+    {
+        uint32 size = GetPodSize(valueType);
+        if (size == 0)
+        {
+            Logger::Error("[FastNameKeyedArchive] unsupported value type %u for key %s", type, key.c_str());
+            return false;
+        }
+
+        Array<uint8, MAX_POD_SIZE> value;
+        if (!source.Read(value.data(), size))
+        {
+            return false;
+        }
+        SetItemData(AppendItem(key), valueType, value.data(), size);
+    }
+    break;
+    }
+    return true;
+}
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/BaseObject.h"
+#include "Base/FastName.h"
+#include "Debug/DVAssert.h"
+#include "FileSystem/VariantType.h"
+
+#include "Math/AABBox3.h"
+#include "Math/Color.h"
+#include "Math/Matrix2.h"
+#include "Math/Matrix3.h"
+#include "Math/Matrix4.h"
+#include "Math/Vector.h"
+
+namespace DAVA
+{
+class File;
+class FilePath;
+class KeyedArchive;
+
+/**
+    \ingroup filesystem
+    Keyed archive with `FastName` keys and without per-value heap allocations.
+
+    Values up to 16 bytes (numbers, vectors, colors, short strings) are stored inline in items,
+    bigger values are stored in single shared buffer of archive. Items are sorted by key,
+    so lookup is binary search with pointer comparisons instead of string hashing.
+
+    Binary format is same as in `KeyedArchive::Save/Load`, so archives written by one class can be read by another.
+    Nested archives are kept in serialized form and are unpacked by `GetArchive` on request.
+    Getters return default value if there is no such key or if value has other type.
+
+    Pointers returned by `GetByteArray` are valid until archive is modified.
+    Place of deleted and moved big values is reused: buffer is compacted when most of it becomes unused.
+*/
+class FastNameKeyedArchive : public BaseObject
+{
+protected:
+    ~FastNameKeyedArchive() override;
+
+public:
+    FastNameKeyedArchive();
+
+    bool IsKeyExists(const FastName& key) const;
+    /** Return type of value stored for `key`, or `VariantType::TYPE_NONE` if there is no such key. */
+    VariantType::eVariantType GetType(const FastName& key) const;
+    uint32 Count() const;
+
+    bool GetBool(const FastName& key, bool defaultValue = false) const;
+    int32 GetInt32(const FastName& key, int32 defaultValue = 0) const;
+    uint32 GetUInt32(const FastName& key, uint32 defaultValue = 0) const;
+    int64 GetInt64(const FastName& key, int64 defaultValue = 0) const;
+    uint64 GetUInt64(const FastName& key, uint64 defaultValue = 0) const;
+    float32 GetFloat(const FastName& key, float32 defaultValue = 0.0f) const;
+    float64 GetFloat64(const FastName& key, float64 defaultValue = 0.0) const;
+    String GetString(const FastName& key, const String& defaultValue = String()) const;
+    FastName GetFastName(const FastName& key, const FastName& defaultValue = FastName()) const;
+    FilePath GetFilePath(const FastName& key, const FilePath& defaultValue) const;
+    Vector2 GetVector2(const FastName& key, const Vector2& defaultValue = Vector2()) const;
+    Vector3 GetVector3(const FastName& key, const Vector3& defaultValue = Vector3()) const;
+    Vector4 GetVector4(const FastName& key, const Vector4& defaultValue = Vector4()) const;
+    Matrix2 GetMatrix2(const FastName& key, const Matrix2& defaultValue = Matrix2()) const;
+    Matrix3 GetMatrix3(const FastName& key, const Matrix3& defaultValue = Matrix3()) const;
+    Matrix4 GetMatrix4(const FastName& key, const Matrix4& defaultValue = Matrix4()) const;
+    Color GetColor(const FastName& key, const Color& defaultValue = Color()) const;
+    AABBox3 GetAABBox3(const FastName& key, const AABBox3& defaultValue = AABBox3()) const;
+
+    /** Return pointer to byte array stored for `key`, or `defaultValue` if there is no such byte array. */
+    const uint8* GetByteArray(const FastName& key, const uint8* defaultValue = nullptr) const;
+    uint32 GetByteArraySize(const FastName& key, uint32 defaultValue = 0) const;
+
+    /** Unpack nested archive stored for `key` into `archive`. Return false if there is no such archive. */
+    bool GetArchive(const FastName& key, FastNameKeyedArchive* archive) const;
+
+    void SetBool(const FastName& key, bool value);
+    void SetInt32(const FastName& key, int32 value);
+    void SetUInt32(const FastName& key, uint32 value);
+    void SetInt64(const FastName& key, int64 value);
+    void SetUInt64(const FastName& key, uint64 value);
+    void SetFloat(const FastName& key, float32 value);
+    void SetFloat64(const FastName& key, float64 value);
+    void SetString(const FastName& key, const String& value);
+    void SetFastName(const FastName& key, const FastName& value);
+    void SetFilePath(const FastName& key, const FilePath& value);
+    void SetVector2(const FastName& key, const Vector2& value);
+    void SetVector3(const FastName& key, const Vector3& value);
+    void SetVector4(const FastName& key, const Vector4& value);
+    void SetMatrix2(const FastName& key, const Matrix2& value);
+    void SetMatrix3(const FastName& key, const Matrix3& value);
+    void SetMatrix4(const FastName& key, const Matrix4& value);
+    void SetColor(const FastName& key, const Color& value);
+    void SetAABBox3(const FastName& key, const AABBox3& value);
+    void SetByteArray(const FastName& key, const uint8* value, uint32 size);
+    void SetArchive(const FastName& key, const FastNameKeyedArchive* archive);
+    /** Set value of any type supported by `KeyedArchive` binary format, wide strings are stored as utf8 strings. */
+    void SetVariant(const FastName& key, const VariantType& value);
+
+    void DeleteKey(const FastName& key);
+    void DeleteAllKeys();
+
+    /**
+        Load archive saved by `Save` or by `KeyedArchive::Save`.
+        Content of memory files is parsed in place, other files are read value by value.
+    */
+    bool Load(File* file);
+    bool Load(const uint8* data, uint32 size);
+    bool Load(const FilePath& pathName);
+
+    /** Save archive in `KeyedArchive` binary format. */
+    bool Save(File* file) const;
+    bool Save(Vector<uint8>& data) const;
+    bool Save(const FilePath& pathName) const;
+
+    /** Replace content of archive with content of `archive`. */
+    void CopyFrom(const KeyedArchive* archive);
+    /** Add content of this archive into `archive`. */
+    void CopyTo(KeyedArchive* archive) const;
+
+private:
+    static const uint32 INLINE_SIZE = 16;
+
+    struct Item
+    {
+        FastName key;
+        VariantType::eVariantType type = VariantType::TYPE_NONE;
+        uint32 size = 0;
+        union
+        {
+            uint8 inlineData[INLINE_SIZE];
+            uint32 bufferOffset;
+        };
+    };
+
+    template <typename T>
+    T GetValue(const FastName& key, VariantType::eVariantType type, const T& defaultValue) const;
+    template <typename T>
+    void SetValue(const FastName& key, VariantType::eVariantType type, const T& value);
+
+    const Item* FindItem(const FastName& key) const;
+    Item& AcquireItem(const FastName& key);
+    Item& AppendItem(const FastName& key);
+    const uint8* GetItemData(const Item& item) const;
+    void SetItemData(Item& item, VariantType::eVariantType type, const void* data, uint32 size);
+    void ReleaseItemData(const Item& item);
+    void CompactBuffer();
+    void SortLoadedItems(size_t firstLoaded);
+
+    template <typename Source>
+    bool LoadItems(Source& source);
+    template <typename Source>
+    bool LoadItem(Source& source, String& keyBuffer);
+
+    Vector<Item> items;
+    Vector<uint8> buffer;
+    uint32 unusedBufferSize = 0; //!< size of buffer parts which aren't used by items anymore
+};
+
+template <typename T>
+T FastNameKeyedArchive::GetValue(const FastName& key, VariantType::eVariantType type, const T& defaultValue) const
+{
+    const Item* item = FindItem(key);
+    if (item != nullptr && item->type == type)
+    {
+        DVASSERT(item->size == sizeof(T));
+        T value;
+        Memcpy(&value, GetItemData(*item), sizeof(T));
+        return value;
+    }
+    return defaultValue;
+}
+
+template <typename T>
+void FastNameKeyedArchive::SetValue(const FastName& key, VariantType::eVariantType type, const T& value)
+{
+    SetItemData(AcquireItem(key), type, &value, sizeof(T));
+}
+}
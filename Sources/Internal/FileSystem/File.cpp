@@ -6,6 +6,7 @@
 #include "FileSystem/FileAPIHelper.h"
 #include "FileSystem/FileSystem.h"
 #include "FileSystem/FileSystemDelegate.h"
+#include "FileSystem/MappedMemoryFile.h"
 #include "FileSystem/Private/PackFormatSpec.h"
 #include "FileSystem/Private/CheckIOError.h"
 #include "FileSystem/ResourceArchive.h"
@@ -156,6 +157,13 @@ File* File::LoadFileFromMountedArchive(const String& packName, const String& rel
         auto it = fs->resArchiveMap.find(packName);
         if (it != end(fs->resArchiveMap))
         {
+            // uncompressed content of memory-mapped archive is read without copying
+            ResourceArchive::ContentView view;
+            if (it->second.archive->LoadFileView(relative, view))
+            {
+                return MappedMemoryFile::Create(view, "~res:/" + relative);
+            }
+
             Vector<uint8> fileContent;
             if (it->second.archive->LoadFile(relative, fileContent))
             {
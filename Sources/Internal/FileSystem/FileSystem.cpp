@@ -14,6 +14,7 @@
 #include "Utils/Utils.h"
 #include "Logger/Logger.h"
 #include "FileSystem/ResourceArchive.h"
+#include "FileSystem/AsyncFileReader.h"
 #include "Concurrency/LockGuard.h"
 
 #include "Engine/Private/EngineBackend.h"
@@ -913,7 +914,7 @@ void FileSystem::Mount(const FilePath& archiveName, const String& attachPath)
     {
         ResourceArchiveItem item;
         item.attachPath = attachPath;
-        item.archive.reset(new ResourceArchive(archiveName));
+        item.archive.reset(new ResourceArchive(archiveName, ResourceArchive::eOpenMode::MemoryMap));
         item.archiveFilePath = archiveName;
 
         {
@@ -1197,4 +1198,14 @@ FileSystemDelegate* FileSystem::GetDelegate() const
 {
     return fsDelegate;
 }
+
+AsyncFileReader* FileSystem::GetAsyncFileReader()
+{
+    LockGuard<Mutex> lock(asyncFileReaderMutex);
+    if (!asyncFileReader)
+    {
+        asyncFileReader.reset(new AsyncFileReader());
+    }
+    return asyncFileReader.get();
+}
 }
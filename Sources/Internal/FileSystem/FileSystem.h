@@ -26,6 +26,7 @@ namespace DAVA
 	\todo add support for pack files
 */
 class FileSystemDelegate;
+class AsyncFileReader;
 class FileSystem : public Singleton<FileSystem>
 {
 public:
@@ -224,6 +225,7 @@ public:
 		\param[in] archiveName pathname or local filename of archive we want to attach
 		\param[in] attachPath path we attach our archive
 
+        archive is memory-mapped if possible, so uncompressed files are read from it without copying
         can throw std::runtime_exception in case of error
         thread safe
 	*/
@@ -303,6 +305,11 @@ public:
     void SetDelegate(FileSystemDelegate* delegate);
     FileSystemDelegate* GetDelegate() const;
 
+    /**
+    \brief Return shared asynchronous file reader, reader and its I/O thread are created on first call
+    */
+    AsyncFileReader* GetAsyncFileReader();
+
 private:
     bool HasLineEnding(File* f);
 
@@ -336,6 +343,10 @@ private:
 
     FileSystemDelegate* fsDelegate = nullptr;
 
+    // declared after archives, so pending reads from attached archives are finished before archives are destroyed
+    Mutex asyncFileReaderMutex;
+    std::unique_ptr<AsyncFileReader> asyncFileReader;
+
     friend class File;
     friend class FilePath;
     Vector<FilePath> resourceFolders;
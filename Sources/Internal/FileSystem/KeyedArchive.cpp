@@ -320,7 +320,9 @@ void KeyedArchive::SetByteArray(const String& key, const uint8* value, int32 arr
     }
     else
     {
-        objectMap[key] = new VariantType(value, arraySize);
+        VariantType* variant = AllocateValue();
+        variant->SetByteArray(value, arraySize);
+        objectMap[key] = variant;
     }
 }
 
@@ -333,7 +335,9 @@ void KeyedArchive::SetVariant(const String& key, const VariantType& value)
     }
     else
     {
-        objectMap[key] = new VariantType(value);
+        VariantType* variant = AllocateValue();
+        *variant = value;
+        objectMap[key] = variant;
     }
 }
 
@@ -346,7 +350,9 @@ void KeyedArchive::SetVariant(const String& key, VariantType&& value)
     }
     else
     {
-        objectMap[key] = new VariantType(std::move(value));
+        VariantType* variant = AllocateValue();
+        *variant = std::move(value);
+        objectMap[key] = variant;
     }
 }
 
@@ -571,8 +577,8 @@ void KeyedArchive::DeleteKey(const String& key)
     auto it = objectMap.find(key);
     if (it != objectMap.end())
     {
-        delete it->second;
-        objectMap.erase(key);
+        ReleaseValue(it->second);
+        objectMap.erase(it);
     }
 }
 
@@ -580,11 +586,65 @@ void KeyedArchive::DeleteAllKeys()
 {
     for (const auto& obj : objectMap)
     {
-        delete obj.second;
+        ReleaseValue(obj.second);
     }
     objectMap.clear();
 }
 
+void KeyedArchive::ReserveValues(uint32 count)
+{
+    objectMap.reserve(objectMap.size() + count);
+    if (freeValues.size() >= count)
+    {
+        return;
+    }
+
+    ValuesBlock block;
+    block.count = count - static_cast<uint32>(freeValues.size());
+    block.values.reset(new VariantType[block.count]);
+    // free values are taken from the back, so values are used in order of block
+    for (uint32 i = block.count; i > 0; --i)
+    {
+        freeValues.push_back(&block.values[i - 1]);
+    }
+    auto insertPos = std::upper_bound(valuesBlocks.begin(), valuesBlocks.end(), block.values.get(), [](const VariantType* value, const ValuesBlock& b) {
+        return std::less<const VariantType*>()(value, b.values.get());
+    });
+    valuesBlocks.insert(insertPos, std::move(block));
+}
+
+VariantType* KeyedArchive::AllocateValue()
+{
+    if (freeValues.empty())
+    {
+        return new VariantType();
+    }
+
+    VariantType* value = freeValues.back();
+    freeValues.pop_back();
+    return value;
+}
+
+void KeyedArchive::ReleaseValue(VariantType* value)
+{
+    std::less<const VariantType*> less;
+    auto it = std::upper_bound(valuesBlocks.begin(), valuesBlocks.end(), value, [&less](const VariantType* v, const ValuesBlock& b) {
+        return less(v, b.values.get());
+    });
+    if (it != valuesBlocks.begin())
+    {
+        const ValuesBlock& block = *(it - 1);
+        if (less(value, block.values.get() + block.count))
+        {
+            // value stays in block and can be taken by new key
+            *value = VariantType();
+            freeValues.push_back(value);
+            return;
+        }
+    }
+    delete value;
+}
+
 uint32 KeyedArchive::Count(const String& key) const
 {
     if (key.empty())
@@ -438,6 +438,12 @@ public:
 	 */
     void DeleteAllKeys();
 
+    /**
+        \brief Prepares archive for adding of `count` new keys.
+        Values of new keys are taken from one preallocated block instead of separate allocation per value.
+     */
+    void ReserveValues(uint32 count);
+
     uint32 Count(const String& key = "") const;
 
     /**
@@ -487,12 +493,25 @@ private:
         }
         else
         {
-            objectMap[key] = new VariantType(value);
+            VariantType* variant = AllocateValue();
+            (variant->*setVariantMethod)(value);
+            objectMap[key] = variant;
         }
     }
 
+    VariantType* AllocateValue();
+    void ReleaseValue(VariantType* value);
+
+    struct ValuesBlock
+    {
+        std::unique_ptr<VariantType[]> values;
+        uint32 count = 0;
+    };
+
     friend class KeyedArchiveStructureWrapper;
     UnderlyingMap objectMap;
+    Vector<ValuesBlock> valuesBlocks; // sorted by address of values, so owning block is found by binary search
+    Vector<VariantType*> freeValues;
 
     DAVA_VIRTUAL_REFLECTION(KeyedArchive, BaseObject);
 };
@@ -0,0 +1,124 @@
+#include "FileSystem/MappedMemoryFile.h"
+#include "FileSystem/Private/MemoryMappedFile.h"
+#include "Logger/Logger.h"
+
+namespace DAVA
+{
+MappedMemoryFile* MappedMemoryFile::Create(const ResourceArchive::ContentView& view, const FilePath& name)
+{
+    DVASSERT(view.data != nullptr || view.size == 0);
+
+    MappedMemoryFile* f = new MappedMemoryFile();
+    f->view = view;
+    f->filename = name;
+    return f;
+}
+
+MappedMemoryFile* MappedMemoryFile::Create(const FilePath& filePath)
+{
+    std::shared_ptr<MemoryMappedFile> mapping = std::make_shared<MemoryMappedFile>();
+    if (!mapping->Open(filePath))
+    {
+        return nullptr;
+    }
+
+    ResourceArchive::ContentView view;
+    view.data = mapping->GetData();
+    view.size = mapping->GetSize();
+    view.owner = mapping;
+    return Create(view, filePath);
+}
+
+uint32 MappedMemoryFile::Read(void* pointerToData, uint32 dataSize)
+{
+    DVASSERT(nullptr != pointerToData);
+
+    if (currentPtr >= view.size)
+    {
+        // behavior like in DynamicMemoryFile: reading at the end sets eof
+        isEof = (dataSize > 0);
+        return 0;
+    }
+
+    uint64 realReadSize = dataSize;
+    if (currentPtr + realReadSize > view.size)
+    {
+        isEof = true;
+        realReadSize = view.size - currentPtr;
+
+        Logger::Error("mapped_file read failed: %u(expected: %u) bytes from file: %s",
+                      static_cast<uint32>(realReadSize), dataSize, filename.GetStringValue().c_str());
+    }
+
+    Memcpy(pointerToData, view.data + currentPtr, static_cast<size_t>(realReadSize));
+    currentPtr += realReadSize;
+
+    return static_cast<uint32>(realReadSize);
+}
+
+uint64 MappedMemoryFile::GetPos() const
+{
+    return currentPtr;
+}
+
+uint64 MappedMemoryFile::GetSize() const
+{
+    return view.size;
+}
+
+bool MappedMemoryFile::Seek(int64 position, eFileSeek seekType)
+{
+    int64 pos = 0;
+    switch (seekType)
+    {
+    case SEEK_FROM_START:
+        pos = position;
+        break;
+    case SEEK_FROM_CURRENT:
+        pos = GetPos() + position;
+        break;
+    case SEEK_FROM_END:
+        pos = GetSize() - 1 + position;
+        break;
+    default:
+        return false;
+    };
+
+    if (pos < 0)
+    {
+        return false;
+    }
+
+    if (pos > static_cast<int64>(view.size))
+    {
+        Logger::Warning("mapped_file is readonly, you about to seek over EOF (POSIX let it)");
+    }
+
+    currentPtr = pos;
+    // behavior like in std::FILE http://en.cppreference.com/w/c/io/fseek
+    isEof = false;
+
+    return true;
+}
+
+bool MappedMemoryFile::IsEof() const
+{
+    return isEof;
+}
+
+uint32 MappedMemoryFile::Write(const void* pointerToData, uint32 dataSize)
+{
+    DVASSERT(false, "Write is not supported");
+    return 0;
+}
+
+bool MappedMemoryFile::Truncate(uint64 size)
+{
+    return false;
+}
+
+bool MappedMemoryFile::Flush()
+{
+    return false;
+}
+}
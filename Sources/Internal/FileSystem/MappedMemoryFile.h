@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "FileSystem/File.h"
+#include "FileSystem/ResourceArchive.h"
+
+namespace DAVA
+{
+/**
+    Read-only file that streams content directly from ResourceArchive::ContentView (e.g. memory-mapped pack)
+    without copying it into own buffer. View is kept alive while file exists.
+*/
+class MappedMemoryFile : public File
+{
+protected:
+    MappedMemoryFile() = default;
+    ~MappedMemoryFile() override = default;
+
+public:
+    static MappedMemoryFile* Create(const ResourceArchive::ContentView& view, const FilePath& name);
+
+    /**
+        Map whole file from file system into memory.
+        Return nullptr if file can't be mapped, e.g. if it is empty or it is stored inside of other archive.
+    */
+    static MappedMemoryFile* Create(const FilePath& filePath);
+
+    /**
+     \brief returns pointer to the content, it is valid while file exists
+     */
+    const uint8* GetData() const;
+
+    uint32 Read(void* pointerToData, uint32 dataSize) override;
+    uint64 GetPos() const override;
+    uint64 GetSize() const override;
+    bool Seek(int64 position, eFileSeek seekType) override;
+    bool IsEof() const override;
+
+private:
+    uint32 Write(const void* pointerToData, uint32 dataSize) override;
+    bool Truncate(uint64 size) override;
+    bool Flush() override;
+
+    ResourceArchive::ContentView view;
+    uint64 currentPtr = 0;
+    bool isEof = false;
+};
+
+inline const uint8* MappedMemoryFile::GetData() const
+{
+    return view.data;
+}
+}
@@ -0,0 +1,148 @@
+#include "FileSystem/Private/MemoryMappedFile.h"
+#include "FileSystem/FilePath.h"
+#include "Utils/UTF8Utils.h"
+#include "Logger/Logger.h"
+
+#if defined(__DAVAENGINE_WINDOWS__)
+#include "Base/Platform.h"
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+namespace DAVA
+{
+MemoryMappedFile::~MemoryMappedFile()
+{
+    Close();
+}
+
+#if defined(__DAVAENGINE_WINDOWS__)
+
+bool MemoryMappedFile::Open(const FilePath& filePath)
+{
+    Close();
+
+    WideString pathWide = UTF8Utils::EncodeToWideString(filePath.GetAbsolutePathname());
+
+#if defined(__DAVAENGINE_WIN32__)
+    HANDLE hFile = CreateFileW(pathWide.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+#elif defined(__DAVAENGINE_WIN_UAP__)
+    CREATEFILE2_EXTENDED_PARAMETERS params = { sizeof(CREATEFILE2_EXTENDED_PARAMETERS) };
+    params.dwFileAttributes = FILE_ATTRIBUTE_NORMAL;
+    params.dwSecurityQosFlags = SECURITY_ANONYMOUS;
+    HANDLE hFile = CreateFile2(pathWide.c_str(), GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, &params);
+#endif
+
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0 || static_cast<uint64>(fileSize.QuadPart) > std::numeric_limits<size_t>::max())
+    {
+        CloseHandle(hFile);
+        return false;
+    }
+
+#if defined(__DAVAENGINE_WIN32__)
+    HANDLE hMapping = CreateFileMappingW(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+#elif defined(__DAVAENGINE_WIN_UAP__)
+    HANDLE hMapping = CreateFileMappingFromApp(hFile, NULL, PAGE_READONLY, 0, NULL);
+#endif
+
+    if (hMapping == NULL)
+    {
+        CloseHandle(hFile);
+        return false;
+    }
+
+#if defined(__DAVAENGINE_WIN32__)
+    void* view = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+#elif defined(__DAVAENGINE_WIN_UAP__)
+    void* view = MapViewOfFileFromApp(hMapping, FILE_MAP_READ, 0, 0);
+#endif
+
+    if (view == nullptr)
+    {
+        CloseHandle(hMapping);
+        CloseHandle(hFile);
+        return false;
+    }
+
+    fileHandle = hFile;
+    mappingHandle = hMapping;
+    data = static_cast<const uint8*>(view);
+    size = static_cast<uint64>(fileSize.QuadPart);
+    return true;
+}
+
+void MemoryMappedFile::Close()
+{
+    if (data != nullptr)
+    {
+        UnmapViewOfFile(data);
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+
+        data = nullptr;
+        size = 0;
+        mappingHandle = nullptr;
+        fileHandle = nullptr;
+    }
+}
+
+#else
+
+bool MemoryMappedFile::Open(const FilePath& filePath)
+{
+    Close();
+
+    String path = filePath.GetAbsolutePathname();
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0 || static_cast<uint64>(fileStat.st_size) > std::numeric_limits<size_t>::max())
+    {
+        close(fd);
+        return false;
+    }
+
+    size_t length = static_cast<size_t>(fileStat.st_size);
+    void* view = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    // mapping keeps its own reference to file
+    close(fd);
+
+    if (view == MAP_FAILED)
+    {
+        Logger::Warning("can't map file: %s errno: %s", path.c_str(), strerror(errno));
+        return false;
+    }
+
+    data = static_cast<const uint8*>(view);
+    size = static_cast<uint64>(length);
+    return true;
+}
+
+void MemoryMappedFile::Close()
+{
+    if (data != nullptr)
+    {
+        munmap(const_cast<uint8*>(data), static_cast<size_t>(size));
+        data = nullptr;
+        size = 0;
+    }
+}
+
+#endif
+
+} // end namespace DAVA
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+namespace DAVA
+{
+class FilePath;
+
+/**
+    Read-only mapping of the whole file into address space of the process.
+    Mapping stays valid until object is destroyed.
+*/
+class MemoryMappedFile final
+{
+public:
+    MemoryMappedFile() = default;
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+    /** Map file with given absolute path, return false if file can't be opened or mapped. */
+    bool Open(const FilePath& filePath);
+    void Close();
+
+    bool IsOpen() const;
+    const uint8* GetData() const;
+    uint64 GetSize() const;
+
+private:
+    const uint8* data = nullptr;
+    uint64 size = 0;
+
+#if defined(__DAVAENGINE_WINDOWS__)
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+inline bool MemoryMappedFile::IsOpen() const
+{
+    return data != nullptr;
+}
+
+inline const uint8* MemoryMappedFile::GetData() const
+{
+    return data;
+}
+
+inline uint64 MemoryMappedFile::GetSize() const
+{
+    return size;
+}
+
+} // end namespace DAVA
@@ -5,7 +5,10 @@
 #include "Utils/CRC32.h"
 #include "Logger/Logger.h"
 #include "Base/Exception.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
 
+#include <atomic>
 #include <mutex>
 
 namespace DAVA
@@ -86,7 +89,7 @@ void PackArchive::FillFilesInfo(const PackFormat::PackFile& packFile,
                   });
 }
 
-PackArchive::PackArchive(RefPtr<File>& file_, const FilePath& archiveName_)
+PackArchive::PackArchive(RefPtr<File>& file_, const FilePath& archiveName_, bool useMemoryMapping)
     : archiveName(archiveName_)
     , file(file_)
 {
@@ -128,6 +131,11 @@ PackArchive::PackArchive(RefPtr<File>& file_, const FilePath& archiveName_)
         DAVA_THROW(DAVA::Exception, "incorrect marker in pack file: " + fileName);
     }
 
+    if (footerBlock.info.version != FILE_VERSION)
+    {
+        DAVA_THROW(DAVA::Exception, "unsupported version " + std::to_string(footerBlock.info.version) + " of pack file: " + fileName);
+    }
+
     String fileNames;
     if (footerBlock.info.numFiles > 0)
     {
@@ -174,6 +182,33 @@ PackArchive::PackArchive(RefPtr<File>& file_, const FilePath& archiveName_)
         }
         packMeta.reset(new PackMetaData(&metaBlock[0], metaBlock.size(), fileNames));
     }
+
+    if (footerBlock.info.dictionarySize > 0)
+    {
+        // dictionary block is placed right before metadata block
+        uint64 startDictionaryBlock = size - (sizeof(packFile.footer) + packFile.footer.info.filesTableSize + footerBlock.metaDataSize + footerBlock.info.dictionarySize);
+        Vector<uint8> dictionary(footerBlock.info.dictionarySize);
+        if (!file->Seek(startDictionaryBlock, File::SEEK_FROM_START))
+        {
+            DAVA_THROW(Exception, "can't seek dictionary");
+        }
+        if (file->Read(dictionary.data(), footerBlock.info.dictionarySize) != footerBlock.info.dictionarySize)
+        {
+            DAVA_THROW(Exception, "can't read dictionary");
+        }
+        dictionaryCompressor.reset(new LZ4DictCompressor(dictionary));
+    }
+
+    if (useMemoryMapping)
+    {
+        mapping = std::make_shared<MemoryMappedFile>();
+        if (!mapping->Open(archiveName) || mapping->GetSize() != size)
+        {
+            // archive may be inside of another container (e.g. apk), so fallback to regular reading
+            Logger::Warning("can't map pack into memory, regular reading is used: %s", fileName.c_str());
+            mapping.reset();
+        }
+    }
 }
 
 const Vector<ResourceArchive::FileInfo>& PackArchive::GetFilesInfo() const
@@ -219,72 +254,394 @@ bool PackArchive::LoadFile(const String& relativeFilePath, Vector<uint8>& output
         DAVA_THROW(DAVA::Exception, "can't open: " + relativeFilePath + " from pack: " + archiveName.GetStringValue());
     }
 
-    bool isOk = file->Seek(fileEntry.startPosition, File::SEEK_FROM_START);
-    if (!isOk)
+    // content is stored without compression, read it right into output
+    if (fileEntry.type == Compressor::Type::None)
     {
-        Logger::Error("can't load file: %s course: can't find start file position in pack file", relativeFilePath.c_str());
-        return false;
+        if (!ReadPackedRange(relativeFilePath, fileEntry, 0, fileEntry.originalSize, output.data()))
+        {
+            return false;
+        }
     }
-
-    switch (fileEntry.type)
-    {
-    case Compressor::Type::None:
+    else
     {
-        uint32 readOk = file->Read(output.data(), fileEntry.originalSize);
-        if (readOk != fileEntry.originalSize)
+        // with mapping decompress directly from mapped memory without intermediate buffer
+        Vector<uint8> packedBuf;
+        const uint8* packedData = GetPackedRange(relativeFilePath, fileEntry, 0, fileEntry.compressedSize, packedBuf);
+        if (packedData == nullptr || !DecompressPackedContent(relativeFilePath, fileEntry, packedData, output.data()))
         {
-            Logger::Error("can't load file: %s course: can't read uncompressed content", relativeFilePath.c_str());
             return false;
         }
     }
-    break;
-    case Compressor::Type::Lz4:
-    case Compressor::Type::Lz4HC:
+
+    CheckOriginalCrc32(relativeFilePath, fileEntry, output.data(), output.size());
+
+    return true;
+}
+
+bool PackArchive::LoadFileRange(const String& relativeFilePath, uint64 offset, uint64 size, Vector<uint8>& output) const
+{
+    using namespace PackFormat;
+
+    auto it = mapFileData.find(relativeFilePath);
+    if (it == mapFileData.end())
+    {
+        return false;
+    }
+
+    const FileTableEntry& fileEntry = *it->second;
+    if (offset > fileEntry.originalSize || size > fileEntry.originalSize - offset)
+    {
+        return false;
+    }
+
+    if (fileEntry.type == Compressor::Type::None)
+    {
+        output.resize(static_cast<size_t>(size));
+        return ReadPackedRange(relativeFilePath, fileEntry, offset, static_cast<uint32>(size), output.data());
+    }
+
+    const uint32 blockSize = packFile.footer.info.blockSize;
+    if (!IsChunkedEntry(fileEntry, blockSize))
+    {
+        // monolithic stream can be decompressed only from its start
+        return ResourceArchiveImpl::LoadFileRange(relativeFilePath, offset, size, output);
+    }
+
+    output.resize(static_cast<size_t>(size));
+    if (size == 0)
+    {
+        return true;
+    }
+
+    const Compressor* compressor = GetDecompressor(fileEntry.type);
+    if (compressor == nullptr)
+    {
+        Logger::Error("can't load file: %s course: unknown compression type", relativeFilePath.c_str());
+        return false;
+    }
+
+    Vector<uint32> blockOffsets;
+    if (!ReadBlockTable(relativeFilePath, fileEntry, blockOffsets))
+    {
+        return false;
+    }
+
+    // read and decompress only blocks covering requested range
+    const uint32 firstBlock = static_cast<uint32>(offset / blockSize);
+    const uint32 endBlock = static_cast<uint32>((offset + size - 1) / blockSize) + 1;
+
+    Vector<uint8> packedBuf;
+    const uint8* blocksData = GetPackedRange(relativeFilePath, fileEntry, blockOffsets[firstBlock], blockOffsets[endBlock] - blockOffsets[firstBlock], packedBuf);
+    if (blocksData == nullptr)
+    {
+        return false;
+    }
+
+    const uint32 blocksEnd = std::min(endBlock * blockSize, fileEntry.originalSize);
+    Vector<uint8> blocksContent(blocksEnd - firstBlock * blockSize);
+    if (!DecompressBlocks(compressor, fileEntry, blockOffsets, blocksData, firstBlock, endBlock, blocksContent.data()))
+    {
+        Logger::Error("can't load file range: %s  course: decompress error", relativeFilePath.c_str());
+        return false;
+    }
+
+    const size_t rangeStart = static_cast<size_t>(offset - firstBlock * blockSize);
+    std::copy_n(blocksContent.begin() + rangeStart, output.size(), output.begin());
+
+    return true;
+}
+
+bool PackArchive::GetPackedLocation(const String& relativeFilePath, ResourceArchive::PackedLocation& location) const
+{
+    auto it = mapFileData.find(relativeFilePath);
+    if (it == mapFileData.end())
+    {
+        return false;
+    }
+
+    location.offset = it->second->startPosition;
+    location.size = it->second->compressedSize;
+    return true;
+}
+
+bool PackArchive::DecodePackedContent(const String& relativeFilePath, const uint8* packedData, uint32 packedSize, Vector<uint8>& output) const
+{
+    using namespace PackFormat;
+
+    auto it = mapFileData.find(relativeFilePath);
+    if (it == mapFileData.end() || it->second->compressedSize != packedSize)
+    {
+        return false;
+    }
+
+    const FileTableEntry& fileEntry = *it->second;
+    output.resize(fileEntry.originalSize);
+
+    if (fileEntry.type == Compressor::Type::None)
+    {
+        std::copy_n(packedData, fileEntry.originalSize, output.data());
+    }
+    else if (!DecompressPackedContent(relativeFilePath, fileEntry, packedData, output.data()))
+    {
+        return false;
+    }
+
+    CheckOriginalCrc32(relativeFilePath, fileEntry, output.data(), output.size());
+
+    return true;
+}
+
+bool PackArchive::LoadFileView(const String& relativeFilePath, ResourceArchive::ContentView& output) const
+{
+    using namespace PackFormat;
+
+    if (!mapping)
+    {
+        return false;
+    }
+
+    auto it = mapFileData.find(relativeFilePath);
+    if (it == mapFileData.end())
+    {
+        return false;
+    }
+
+    const FileTableEntry& fileEntry = *it->second;
+    if (fileEntry.type != Compressor::Type::None)
     {
-        Vector<uint8> packedBuf(fileEntry.compressedSize);
+        return false;
+    }
+
+    if (fileEntry.startPosition + fileEntry.originalSize > mapping->GetSize())
+    {
+        Logger::Error("can't load file: %s course: content out of pack bounds", relativeFilePath.c_str());
+        return false;
+    }
+
+    const uint8* data = mapping->GetData() + fileEntry.startPosition;
+
+    // mapped content can't change, so it is verified only until first successful check,
+    // entry is marked after check so failed content is checked (and reported) again on next access
+    bool isVerified = false;
+    {
+        LockGuard<Mutex> lock(verifiedViewsMutex);
+        isVerified = (verifiedViews.count(&fileEntry) != 0);
+    }
+    if (!isVerified)
+    {
+        CheckOriginalCrc32(relativeFilePath, fileEntry, data, fileEntry.originalSize);
+
+        LockGuard<Mutex> lock(verifiedViewsMutex);
+        verifiedViews.insert(&fileEntry);
+    }
+
+    output.data = data;
+    output.size = fileEntry.originalSize;
+    output.owner = mapping;
+
+    return true;
+}
+
+bool PackArchive::IsMemoryMapped() const
+{
+    return mapping != nullptr;
+}
 
-        uint32 readOk = file->Read(packedBuf.data(), fileEntry.compressedSize);
-        if (readOk != fileEntry.compressedSize)
+bool PackArchive::ReadPackedRange(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, uint64 offset, uint32 size, uint8* output) const
+{
+    const uint64 position = fileEntry.startPosition + offset;
+
+    if (mapping)
+    {
+        if (position + size > mapping->GetSize())
         {
-            Logger::Error("can't load file: %s course: can't read compressed content", relativeFilePath.c_str());
+            Logger::Error("can't load file: %s course: content out of pack bounds", relativeFilePath.c_str());
             return false;
         }
+        Memcpy(output, mapping->GetData() + position, size);
+        return true;
+    }
+
+    // file position is shared, so reads from different threads (e.g. AsyncFileReader and main thread) are serialized
+    LockGuard<Mutex> lock(fileMutex);
+    bool isOk = file->Seek(position, File::SEEK_FROM_START);
+    if (!isOk)
+    {
+        Logger::Error("can't load file: %s course: can't find start file position in pack file", relativeFilePath.c_str());
+        return false;
+    }
+
+    uint32 readOk = file->Read(output, size);
+    if (readOk != size)
+    {
+        Logger::Error("can't load file: %s course: can't read content", relativeFilePath.c_str());
+        return false;
+    }
+    return true;
+}
 
-        if (!LZ4Compressor().Decompress(packedBuf, output))
+const uint8* PackArchive::GetPackedRange(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, uint64 offset, uint32 size, Vector<uint8>& buffer) const
+{
+    const uint64 position = fileEntry.startPosition + offset;
+
+    if (mapping)
+    {
+        if (position + size > mapping->GetSize())
         {
-            Logger::Error("can't load file: %s  course: decompress error", relativeFilePath.c_str());
-            return false;
+            Logger::Error("can't load file: %s course: compressed content out of pack bounds", relativeFilePath.c_str());
+            return nullptr;
         }
+        return mapping->GetData() + position;
     }
-    break;
-    case Compressor::Type::RFC1951:
+
+    buffer.resize(size);
+    if (!ReadPackedRange(relativeFilePath, fileEntry, offset, size, buffer.data()))
+    {
+        return nullptr;
+    }
+    return buffer.data();
+}
+
+bool PackArchive::ReadBlockTable(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, Vector<uint32>& blockOffsets) const
+{
+    const uint32 blocksCount = PackFormat::GetBlocksCount(fileEntry.originalSize, packFile.footer.info.blockSize);
+    const uint32 tableSize = blocksCount * sizeof(uint32);
+    if (tableSize > fileEntry.compressedSize)
+    {
+        Logger::Error("can't load file: %s course: block table out of packed content", relativeFilePath.c_str());
+        return false;
+    }
+
+    Vector<uint8> tableBuf;
+    const uint8* table = GetPackedRange(relativeFilePath, fileEntry, 0, tableSize, tableBuf);
+    return (table != nullptr) && ParseBlockTable(relativeFilePath, fileEntry, table, blockOffsets);
+}
+
+bool PackArchive::ParseBlockTable(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, const uint8* table, Vector<uint32>& blockOffsets) const
+{
+    const uint32 blocksCount = PackFormat::GetBlocksCount(fileEntry.originalSize, packFile.footer.info.blockSize);
+    const uint32 tableSize = blocksCount * sizeof(uint32);
+    if (tableSize > fileEntry.compressedSize)
     {
-        Vector<uint8> packedBuf(fileEntry.compressedSize);
+        Logger::Error("can't load file: %s course: block table out of packed content", relativeFilePath.c_str());
+        return false;
+    }
+
+    // offsets of blocks from start of packed content, last one is the end of packed content
+    blockOffsets.resize(blocksCount + 1);
+    uint64 blockOffset = tableSize;
+    for (uint32 i = 0; i < blocksCount; ++i)
+    {
+        uint32 compressedBlockSize;
+        Memcpy(&compressedBlockSize, table + i * sizeof(uint32), sizeof(uint32));
+
+        blockOffsets[i] = static_cast<uint32>(blockOffset);
+        blockOffset += compressedBlockSize;
+    }
 
-        uint32 readOk = file->Read(packedBuf.data(), fileEntry.compressedSize);
-        if (readOk != fileEntry.compressedSize)
+    if (blockOffset != fileEntry.compressedSize)
+    {
+        Logger::Error("can't load file: %s course: block table not match packed content size", relativeFilePath.c_str());
+        return false;
+    }
+    blockOffsets[blocksCount] = fileEntry.compressedSize;
+
+    return true;
+}
+
+bool PackArchive::DecompressPackedContent(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, const uint8* packedData, uint8* output) const
+{
+    const Compressor* compressor = GetDecompressor(fileEntry.type);
+    if (compressor == nullptr)
+    {
+        Logger::Error("can't load file: %s course: unknown compression type", relativeFilePath.c_str());
+        return false;
+    }
+
+    bool decompressed = false;
+    if (PackFormat::IsChunkedEntry(fileEntry, packFile.footer.info.blockSize))
+    {
+        Vector<uint32> blockOffsets;
+        if (!ParseBlockTable(relativeFilePath, fileEntry, packedData, blockOffsets))
         {
-            Logger::Error("can't load file: %s course: can't read compressed content", relativeFilePath.c_str());
             return false;
         }
 
-        if (!ZipCompressor().Decompress(packedBuf, output))
+        const uint32 blocksCount = static_cast<uint32>(blockOffsets.size() - 1);
+        decompressed = DecompressBlocks(compressor, fileEntry, blockOffsets, packedData + blockOffsets[0], 0, blocksCount, output);
+    }
+    else
+    {
+        decompressed = compressor->Decompress(packedData, fileEntry.compressedSize, output, fileEntry.originalSize);
+    }
+
+    if (!decompressed)
+    {
+        Logger::Error("can't load file: %s  course: decompress error", relativeFilePath.c_str());
+    }
+    return decompressed;
+}
+
+bool PackArchive::DecompressBlocks(const Compressor* compressor, const PackFormat::FileTableEntry& fileEntry, const Vector<uint32>& blockOffsets,
+                                   const uint8* blocksData, uint32 firstBlock, uint32 endBlock, uint8* output) const
+{
+    const uint32 blockSize = packFile.footer.info.blockSize;
+    std::atomic<bool> failed{ false };
+
+    auto decompressRange = [&](uint32 begin, uint32 end)
+    {
+        for (uint32 i = begin; i < end; ++i)
         {
-            Logger::Error("can't load file: %s  course: decompress error", relativeFilePath.c_str());
-            return false;
+            const uint32 blockOriginalSize = std::min(blockSize, fileEntry.originalSize - i * blockSize);
+            const uint32 blockCompressedSize = blockOffsets[i + 1] - blockOffsets[i];
+            const uint8* src = blocksData + (blockOffsets[i] - blockOffsets[firstBlock]);
+            uint8* dst = output + static_cast<size_t>(i - firstBlock) * blockSize;
+
+            if (blockCompressedSize == blockOriginalSize)
+            {
+                Memcpy(dst, src, blockOriginalSize);
+            }
+            else if (!compressor->Decompress(src, blockCompressedSize, dst, blockOriginalSize))
+            {
+                failed = true;
+            }
         }
+    };
+
+    // blocks are independent, so every block can be decompressed in separate job
+    ParallelForOrSerial(firstBlock, endBlock, 1, decompressRange);
+
+    return !failed;
+}
+
+const Compressor* PackArchive::GetDecompressor(Compressor::Type type) const
+{
+    // decompressors have no state and can be shared between threads
+    static const LZ4Compressor lz4Compressor{};
+    static const ZipCompressor zipCompressor{};
+
+    switch (type)
+    {
+    case Compressor::Type::Lz4:
+    case Compressor::Type::Lz4HC:
+        return &lz4Compressor;
+    case Compressor::Type::RFC1951:
+        return &zipCompressor;
+    case Compressor::Type::Lz4Dict:
+        return dictionaryCompressor.get();
+    default:
+        return nullptr;
     }
-    break;
-    } // end switch
+}
 
+void PackArchive::CheckOriginalCrc32(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, const uint8* data, uint64 size) const
+{
     // check crc32 for file content
-    if (fileEntry.originalCrc32 != 0 && fileEntry.originalCrc32 != CRC32::ForBuffer(output.data(), output.size()))
+    if (fileEntry.originalCrc32 != 0 && fileEntry.originalCrc32 != CRC32::ForBuffer(data, static_cast<size_t>(size)))
     {
         String msg = "original crc32 not match for: " + relativeFilePath + " during decompress from pack: " + archiveName.GetStringValue();
         throw FileCrc32FromPackNotMatch(msg, __FILE__, __LINE__);
     }
-
-    return true;
 }
 
 uint32 PackArchive::GetFileIndex(const String& releativeFilePath) const
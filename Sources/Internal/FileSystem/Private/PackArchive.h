@@ -3,19 +3,29 @@
 #include "FileSystem/Private/ResourceArchivePrivate.h"
 #include "FileSystem/Private/PackFormatSpec.h"
 #include "FileSystem/Private/PackMetaData.h"
+#include "FileSystem/Private/MemoryMappedFile.h"
 #include "FileSystem/File.h"
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/Mutex.h"
+#include "Compression/LZ4Compressor.h"
 
 namespace DAVA
 {
 class PackArchive final : public ResourceArchiveImpl
 {
 public:
-    PackArchive(RefPtr<File>& file_, const FilePath& archiveName);
+    PackArchive(RefPtr<File>& file_, const FilePath& archiveName, bool useMemoryMapping = false);
 
     const Vector<ResourceArchive::FileInfo>& GetFilesInfo() const override;
     const ResourceArchive::FileInfo* GetFileInfo(const String& relativeFilePath) const override;
     bool HasFile(const String& relativeFilePath) const override;
     bool LoadFile(const String& relativeFilePath, Vector<uint8>& output) const override;
+    bool LoadFileView(const String& relativeFilePath, ResourceArchive::ContentView& output) const override;
+    bool LoadFileRange(const String& relativeFilePath, uint64 offset, uint64 size, Vector<uint8>& output) const override;
+    bool GetPackedLocation(const String& relativeFilePath, ResourceArchive::PackedLocation& location) const override;
+    bool DecodePackedContent(const String& relativeFilePath, const uint8* packedData, uint32 packedSize, Vector<uint8>& output) const override;
+
+    bool IsMemoryMapped() const;
 
     /**
 		return index of struct with file info, usefull for meta data
@@ -43,12 +53,32 @@ public:
                               Vector<ResourceArchive::FileInfo>& filesInfo);
 
 private:
+    bool ReadPackedRange(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, uint64 offset, uint32 size, uint8* output) const;
+    // return pointer into mapped memory or into `buffer` filled with packed content, nullptr on error
+    const uint8* GetPackedRange(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, uint64 offset, uint32 size, Vector<uint8>& buffer) const;
+    bool ReadBlockTable(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, Vector<uint32>& blockOffsets) const;
+    bool ParseBlockTable(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, const uint8* table, Vector<uint32>& blockOffsets) const;
+    // decompress whole packed content of compressed entry into `output` of fileEntry.originalSize bytes
+    bool DecompressPackedContent(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, const uint8* packedData, uint8* output) const;
+    bool DecompressBlocks(const Compressor* compressor, const PackFormat::FileTableEntry& fileEntry, const Vector<uint32>& blockOffsets,
+                          const uint8* blocksData, uint32 firstBlock, uint32 endBlock, uint8* output) const;
+    // return nullptr for unknown type or Lz4Dict without dictionary in pack
+    const Compressor* GetDecompressor(Compressor::Type type) const;
+    void CheckOriginalCrc32(const String& relativeFilePath, const PackFormat::FileTableEntry& fileEntry, const uint8* data, uint64 size) const;
+
     const FilePath archiveName;
     mutable RefPtr<File> file;
+    mutable Mutex fileMutex;
     PackFormat::PackFile packFile;
     std::unique_ptr<PackMetaData> packMeta;
     UnorderedMap<String, const PackFormat::FileTableEntry*> mapFileData;
     Vector<ResourceArchive::FileInfo> filesInfo;
+    // whole archive mapped into memory, shared with all views given out
+    std::shared_ptr<MemoryMappedFile> mapping;
+    // entries which content in mapping is already checked by crc32
+    mutable Mutex verifiedViewsMutex;
+    mutable UnorderedSet<const PackFormat::FileTableEntry*> verifiedViews;
+    std::unique_ptr<LZ4DictCompressor> dictionaryCompressor;
 };
 
 } // end namespace DAVA
@@ -8,6 +8,7 @@ namespace PackFormat
 {
 const Array<char8, 4> FILE_MARKER{ { 'D', 'V', 'P', 'K' } };
 const Array<char8, 4> FILE_MARKER_LITE{ { 'D', 'V', 'P', 'L' } };
+const uint32 FILE_VERSION = 1; // version of pack footer, packs with other version are refused
 
 struct PackFile
 {
@@ -16,6 +17,11 @@ struct PackFile
     {
     } rawBytesOfCompressedFiles;
 
+    // 0 or footer.info.dictionarySize bytes - dictionary shared by all Lz4Dict compressed files
+    struct DictionaryBlock
+    {
+    } dictionary;
+
     // 0 or footer.metaDataSize bytes
     struct CustomMetadataBlock
     {
@@ -51,12 +57,14 @@ struct PackFile
 
     struct FooterBlock
     {
-        Array<uint8, 8> reserved{};
         uint32 metaDataCrc32 = 0; // 0 or crc32 for custom user meta block
         uint32 metaDataSize = 0; // 0 or size of custom user meta data block
-        uint32 infoCrc32 = 0;
+        uint32 infoCrc32 = 0; // crc32 of info
         struct Info
         {
+            uint32 version = FILE_VERSION;
+            uint32 blockSize = 0; // 0 or size of independently compressed blocks of chunked entries (see IsChunkedEntry)
+            uint32 dictionarySize = 0; // 0 or size of dictionary block for Compressor::Type::Lz4Dict entries
             uint32 numFiles = 0;
             uint32 namesSizeCompressed = 0; // lz4hc
             uint32 namesSizeOriginal = 0;
@@ -69,6 +77,26 @@ struct PackFile
 
 using FileTableEntry = PackFile::FilesTableBlock::FilesData::Data;
 
+/**
+	Chunked entry - content of file is split into blocks of footer.info.blockSize bytes
+	(last block may be smaller) and every block is compressed independently with
+	entry compression type, so blocks can be decompressed in parallel or alone.
+	Packed content of chunked entry:
+	[uint32 compressedBlockSize] * blocksCount - block table
+	[compressed block bytes] * blocksCount
+	Block with compressedBlockSize equal to its original size is stored as is.
+	compressedSize and compressedCrc32 of entry include block table.
+*/
+inline bool IsChunkedEntry(const FileTableEntry& fileEntry, uint32 blockSize)
+{
+    return blockSize > 0 && fileEntry.type != Compressor::Type::None && fileEntry.originalSize > blockSize;
+}
+
+inline uint32 GetBlocksCount(uint32 originalSize, uint32 blockSize)
+{
+    return (originalSize + blockSize - 1) / blockSize;
+}
+
 /**
 	One file packed with our custom compression + 20 bytes footer
 	in the end of file with info to decompress content.
@@ -92,7 +120,7 @@ struct LitePack
 };
 
 static_assert(sizeof(LitePack::Footer) == 20, "footer block size changed");
-static_assert(sizeof(PackFile::FooterBlock) == 44, "header block size changed");
+static_assert(sizeof(PackFile::FooterBlock) == 48, "header block size changed");
 static_assert(sizeof(FileTableEntry) == 32, "file table entry size changed");
 
 } // end of PackFormat namespace
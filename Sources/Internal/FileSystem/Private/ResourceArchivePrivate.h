@@ -13,6 +13,35 @@ public:
     virtual const ResourceArchive::FileInfo* GetFileInfo(const String& relativeFilePath) const = 0;
     virtual bool HasFile(const String& relativeFilePath) const = 0;
     virtual bool LoadFile(const String& relativeFilePath, Vector<uint8>& output) const = 0;
+
+    // only archives with direct memory access to uncompressed content support views
+    virtual bool LoadFileView(const String& /*relativeFilePath*/, ResourceArchive::ContentView& /*output*/) const
+    {
+        return false;
+    }
+
+    // generic implementation loads whole file, archives with random access to content override it
+    virtual bool LoadFileRange(const String& relativeFilePath, uint64 offset, uint64 size, Vector<uint8>& output) const
+    {
+        Vector<uint8> content;
+        if (!LoadFile(relativeFilePath, content) || offset > content.size() || size > content.size() - offset)
+        {
+            return false;
+        }
+        output.assign(content.begin() + static_cast<size_t>(offset), content.begin() + static_cast<size_t>(offset + size));
+        return true;
+    }
+
+    // only archives with known layout of packed content support direct access to it
+    virtual bool GetPackedLocation(const String& /*relativeFilePath*/, ResourceArchive::PackedLocation& /*location*/) const
+    {
+        return false;
+    }
+
+    virtual bool DecodePackedContent(const String& /*relativeFilePath*/, const uint8* /*packedData*/, uint32 /*packedSize*/, Vector<uint8>& /*output*/) const
+    {
+        return false;
+    }
 };
 
 } // end namespace DAVA
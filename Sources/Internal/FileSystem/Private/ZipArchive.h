@@ -2,6 +2,7 @@
 
 #include "FileSystem/Private/ResourceArchivePrivate.h"
 #include "Compression/ZipCompressor.h"
+#include "Concurrency/Mutex.h"
 
 namespace DAVA
 {
@@ -16,6 +17,7 @@ public:
     bool LoadFile(const String& relativeFilePath, Vector<uint8>& output) const override;
 
 private:
+    mutable Mutex zipFileMutex; // zip reader state isn't thread-safe
     ZipFile zipFile;
     Vector<ResourceArchive::FileInfo> fileInfos;
 };
@@ -19,7 +19,8 @@
 
 namespace DAVA
 {
-ResourceArchive::ResourceArchive(const FilePath& archiveName)
+ResourceArchive::ResourceArchive(const FilePath& archiveName, eOpenMode mode)
+    : archivePath(archiveName)
 {
     const String& fileName = archiveName.GetAbsolutePathname();
 
@@ -51,7 +52,7 @@ ResourceArchive::ResourceArchive(const FilePath& archiveName)
 
     if (PackFormat::FILE_MARKER == lastFourBytes)
     {
-        impl.reset(new PackArchive(f, fileName));
+        impl.reset(new PackArchive(f, fileName, mode == eOpenMode::MemoryMap));
     }
     else
     {
@@ -76,6 +77,11 @@ ResourceArchive::FileInfo::FileInfo(const char8* relativePath_,
 {
 }
 
+const FilePath& ResourceArchive::GetArchivePath() const
+{
+    return archivePath;
+}
+
 const Vector<ResourceArchive::FileInfo>& ResourceArchive::GetFilesInfo() const
 {
     return impl->GetFilesInfo();
@@ -97,6 +103,26 @@ bool ResourceArchive::LoadFile(const String& relativeFilePath,
     return impl->LoadFile(relativeFilePath, output);
 }
 
+bool ResourceArchive::LoadFileView(const String& relativeFilePath, ContentView& outputView) const
+{
+    return impl->LoadFileView(relativeFilePath, outputView);
+}
+
+bool ResourceArchive::LoadFileRange(const String& relativeFilePath, uint64 offset, uint64 size, Vector<uint8>& outputRangeContent) const
+{
+    return impl->LoadFileRange(relativeFilePath, offset, size, outputRangeContent);
+}
+
+bool ResourceArchive::GetPackedLocation(const String& relativeFilePath, PackedLocation& location) const
+{
+    return impl->GetPackedLocation(relativeFilePath, location);
+}
+
+bool ResourceArchive::DecodePackedContent(const String& relativeFilePath, const uint8* packedData, uint32 packedSize, Vector<uint8>& outputFileContent) const
+{
+    return impl->DecodePackedContent(relativeFilePath, packedData, packedSize, outputFileContent);
+}
+
 bool ResourceArchive::UnpackToFolder(const FilePath& dir) const
 {
     Vector<uint8> content;
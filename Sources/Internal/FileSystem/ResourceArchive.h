@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Compression/Compressor.h"
+#include "FileSystem/FilePath.h"
 #include "Base/Exception.h"
 
 namespace DAVA
@@ -18,12 +19,16 @@ public:
 
 class ResourceArchiveImpl;
 
-class FilePath;
-
 class ResourceArchive final
 {
 public:
-    explicit ResourceArchive(const FilePath& filePath);
+    enum class eOpenMode
+    {
+        Read, //!< read files content through File into intermediate buffers
+        MemoryMap //!< map whole archive into memory, uncompressed files can be accessed without copying
+    };
+
+    explicit ResourceArchive(const FilePath& filePath, eOpenMode mode = eOpenMode::Read);
     ~ResourceArchive();
 
     struct FileInfo
@@ -39,14 +44,69 @@ public:
         Compressor::Type compressionType = Compressor::Type::None;
     };
 
+    /**
+        Read-only view of file content inside archive.
+        Content is valid while `owner` (or any of its copies) is alive, even after archive is destroyed.
+    */
+    struct ContentView
+    {
+        const uint8* data = nullptr;
+        uint64 size = 0;
+        std::shared_ptr<const void> owner;
+    };
+
+    /**
+        Place of packed (possibly compressed) file content inside of archive file.
+    */
+    struct PackedLocation
+    {
+        uint64 offset = 0;
+        uint32 size = 0;
+    };
+
+    const FilePath& GetArchivePath() const;
     const Vector<FileInfo>& GetFilesInfo() const;
     const FileInfo* GetFileInfo(const String& relativeFilePath) const;
     bool HasFile(const String& relativeFilePath) const;
+
+    /**
+        Load whole file content into `outputFileContent`.
+        Can be called from any thread, reads of archive file are serialized by archive.
+    */
     bool LoadFile(const String& relativeFilePath, Vector<uint8>& outputFileContent) const;
 
+    /**
+        Get view of file content without copying.
+        Works only for archives opened with eOpenMode::MemoryMap and files stored without compression,
+        return false otherwise, use LoadFile in that case. Content crc32 is checked only on first view of file.
+    */
+    bool LoadFileView(const String& relativeFilePath, ContentView& outputView) const;
+
+    /**
+        Load `size` bytes of file content starting from `offset` into `outputRangeContent`.
+        Chunked entries of pack archives are decompressed partially, only blocks that cover requested range,
+        other archives load whole file and copy requested part of it.
+        Return false if file not found or range is out of file bounds.
+    */
+    bool LoadFileRange(const String& relativeFilePath, uint64 offset, uint64 size, Vector<uint8>& outputRangeContent) const;
+
+    /**
+        Get place of packed file content inside of archive file, so content of several files
+        can be read by one sequential read (see AsyncFileReader) and decoded with `DecodePackedContent`.
+        Return false if file not found or archive doesn't support direct access to packed content (zip).
+    */
+    bool GetPackedLocation(const String& relativeFilePath, PackedLocation& location) const;
+
+    /**
+        Decode packed content read from place given by `GetPackedLocation` into original file content.
+        Can be called from any thread.
+    */
+    bool DecodePackedContent(const String& relativeFilePath, const uint8* packedData, uint32 packedSize, Vector<uint8>& outputFileContent) const;
+
     bool UnpackToFolder(const FilePath& dir) const;
 
 private:
+    FilePath archivePath;
     std::unique_ptr<ResourceArchiveImpl> impl;
 };
 } // end namespace DAVA
@@ -6,7 +6,6 @@
 #include "Engine/Engine.h"
 #include "Concurrency/LockGuard.h"
 #include "Concurrency/UniqueLock.h"
-#include "Job/JobThread.h"
 #include "Platform/DeviceInfo.h"
 
 namespace DAVA
@@ -15,16 +14,9 @@ JobManager::JobManager(Engine* e)
     : engine(e)
     , mainJobIDCounter(1)
     , mainJobLastExecutedID(0)
-    , workerDoneSem(0)
 {
     uint32 cpuCoresCount = DeviceInfo::GetCpuCount();
-    workerThreads.reserve(cpuCoresCount);
-
-    for (uint32 i = 0; i < cpuCoresCount; ++i)
-    {
-        JobThread* thread = new JobThread(&workerQueue, &workerDoneSem);
-        workerThreads.push_back(thread);
-    }
+    workerScheduler.reset(new JobScheduler(cpuCoresCount));
 
     e->update.Connect(this, &JobManager::Update);
 }
@@ -41,12 +33,7 @@ JobManager::~JobManager()
     mainJobIDCounter = 0;
     mainCV.NotifyAll();
 
-    for (uint32 i = 0; i < workerThreads.size(); ++i)
-    {
-        SafeDelete(workerThreads[i]);
-    }
-
-    workerThreads.clear();
+    workerScheduler.reset();
 }
 
 void JobManager::Update(float32 /*frameDelta*/)
@@ -100,7 +87,7 @@ void JobManager::Update(float32 /*frameDelta*/)
 
 uint32 JobManager::GetWorkersCount() const
 {
-    return static_cast<uint32>(workerThreads.size());
+    return workerScheduler->GetWorkersCount();
 }
 
 uint32 JobManager::CreateMainJob(const Function<void()>& fn, eMainJobType mainJobType)
@@ -154,7 +141,7 @@ void JobManager::WaitMainJobs(Thread::Id invokerThreadId /* = 0 */)
     {
         // If main thread is locked by WaitWorkerJobs this instruction will unlock
         // main thread, allowing it to perform all scheduled main-thread jobs
-        workerDoneSem.Post();
+        workerScheduler->WakeWaiters();
 
         // Now check if there are some jobs in the queue and wait for them
         UniqueLock<Mutex> lock(mainCVMutex);
@@ -185,7 +172,7 @@ void JobManager::WaitMainJobID(uint32 mainJobID)
     {
         // If main thread is locked by WaitWorkerJobs this instruction will unlock
         // main thread, allowing it to perform all scheduled main-thread jobs
-        workerDoneSem.Post();
+        workerScheduler->WakeWaiters();
 
         // Now check if there are some jobs in the queue and wait for them
         UniqueLock<Mutex> lock(mainCVMutex);
@@ -235,35 +222,74 @@ bool JobManager::HasMainJobID(uint32 mainJobID)
     return (mainJobID > mainJobLastExecutedID);
 }
 
-void JobManager::CreateWorkerJob(const Function<void()>& fn)
+JobHandle JobManager::CreateWorkerJob(const Function<void()>& fn)
 {
-    workerQueue.Push(fn);
-    workerQueue.Signal();
+    return workerScheduler->Schedule(fn);
+}
+
+JobHandle JobManager::CreateChildWorkerJob(const JobHandle& parent, const Function<void()>& fn)
+{
+    return workerScheduler->Schedule(fn, parent);
+}
+
+JobHandle JobManager::CreateDependentWorkerJob(const Vector<JobHandle>& dependencies, const Function<void()>& fn)
+{
+    return workerScheduler->Schedule(fn, JobHandle(), dependencies);
 }
 
 void JobManager::WaitWorkerJobs()
 {
-    while (HasWorkerJobs())
+    // We want to be able to wait worker jobs, but at the same time
+    // allow any worker job execute main job. Potentially this will cause
+    // dead lock, but there is a simple solution:
+    //
+    // Every time, worker job is trying to execute WaitMainJobs it will
+    // wake up waiting threads, that will give a chance to execute main jobs
+    // in the following Update() call
+    //
+    if (Thread::IsMainThread())
     {
-        if (Thread::IsMainThread())
-        {
-            // We want to be able to wait worker jobs, but at the same time
-            // allow any worker job execute main job. Potentially this will cause
-            // dead lock, but there is a simple solution:
-            //
-            // Every time, worker job is trying to execute WaitMainJobs it will
-            // post workerDoneSem semaphore, that will give a chance to execute main jobs
-            // in the following Update() call
-            //
-            Update();
-        }
+        workerScheduler->WaitAll([this]() { Update(); });
+    }
+    else
+    {
+        workerScheduler->WaitAll();
+    }
+}
 
-        workerDoneSem.Wait();
+void JobManager::WaitWorkerJob(const JobHandle& handle)
+{
+    if (Thread::IsMainThread())
+    {
+        workerScheduler->Wait(handle, [this]() { Update(); });
+    }
+    else
+    {
+        workerScheduler->Wait(handle);
     }
 }
 
+void JobManager::ParallelFor(uint32 begin, uint32 end, uint32 grain, const Function<void(uint32, uint32)>& fn)
+{
+    workerScheduler->ParallelFor(begin, end, grain, fn);
+}
+
 bool JobManager::HasWorkerJobs()
 {
-    return !workerQueue.IsEmpty();
+    return workerScheduler->HasJobs();
+}
+
+void ParallelForOrSerial(uint32 begin, uint32 end, uint32 grain, const Function<void(uint32, uint32)>& fn)
+{
+    const EngineContext* context = GetEngineContext();
+    JobManager* jobManager = (context != nullptr) ? context->jobManager : nullptr;
+    if (jobManager != nullptr && end - begin > grain)
+    {
+        jobManager->ParallelFor(begin, end, grain, fn);
+    }
+    else
+    {
+        fn(begin, end);
+    }
 }
 }
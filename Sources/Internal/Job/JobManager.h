@@ -3,15 +3,13 @@
 #include "Base/BaseTypes.h"
 #include "Concurrency/Atomic.h"
 #include "Concurrency/Mutex.h"
-#include "Concurrency/Semaphore.h"
 #include "Concurrency/Thread.h"
 #include "Functional/Function.h"
-#include "Job/JobQueue.h"
+#include "Job/JobScheduler.h"
 
 namespace DAVA
 {
 class Engine;
-class JobThread;
 class JobManager
 {
 public:
@@ -59,12 +57,38 @@ public:
 
     /*! Add function to execute in the worker-thread.
 		\param [in] fn Function to execute.
+        \return Handle of created job. It can be used to wait for this job only or to make it a parent or a dependency of other jobs.
 	*/
-    void CreateWorkerJob(const Function<void()>& fn);
+    JobHandle CreateWorkerJob(const Function<void()>& fn);
 
-    /*! Wait until all worker-thread jobs are executed. */
+    /*! Add function to execute in the worker-thread as a child of `parent` job.
+        Parent job won't be finished until all its children are finished.
+		\param [in] parent Parent job. Child should be created before the parent is finished, usually from the parent's function.
+		\param [in] fn Function to execute.
+	*/
+    JobHandle CreateChildWorkerJob(const JobHandle& parent, const Function<void()>& fn);
+
+    /*! Add function to execute in the worker-thread after all `dependencies` are finished.
+		\param [in] dependencies Jobs that should be finished before `fn` may start.
+		\param [in] fn Function to execute.
+	*/
+    JobHandle CreateDependentWorkerJob(const Vector<JobHandle>& dependencies, const Function<void()>& fn);
+
+    /*! Wait until all worker-thread jobs are executed.
+        If called from worker job, only executes pending jobs in the calling thread, as the calling job itself can't be finished.
+    */
     void WaitWorkerJobs();
 
+    /*! Wait until worker-thread job referenced by `handle` and all its children are executed.
+        Calling thread helps to execute pending worker jobs while waiting.
+	*/
+    void WaitWorkerJob(const JobHandle& handle);
+
+    /*! Split range [begin, end) into chunks of no more than `grain` elements and call `fn(chunkBegin, chunkEnd)`
+        for every chunk in worker-threads. Calling thread takes part in execution. Returns when all chunks are processed.
+	*/
+    void ParallelFor(uint32 begin, uint32 end, uint32 grain, const Function<void(uint32, uint32)>& fn);
+
     /*!  Check in there are some not executed worker-thread jobs.
 		\return Return true if there are some jobs, otherwise false.
 	*/
@@ -97,8 +121,12 @@ protected:
     ConditionVariable mainCV;
     MainJob curMainJob;
 
-    Semaphore workerDoneSem;
-    JobQueueWorker workerQueue;
-    Vector<JobThread*> workerThreads;
+    std::unique_ptr<JobScheduler> workerScheduler;
 };
+
+/*! Split range [begin, end) between worker-threads with `JobManager::ParallelFor` of engine job manager.
+    If there is no job manager (e.g. in tools without engine) or range fits into single chunk, `fn(begin, end)`
+    is called on calling thread.
+*/
+void ParallelForOrSerial(uint32 begin, uint32 end, uint32 grain, const Function<void(uint32, uint32)>& fn);
 }
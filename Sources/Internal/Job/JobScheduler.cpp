@@ -0,0 +1,620 @@
+#include "Job/JobScheduler.h"
+#include "Job/Private/WorkStealingDeque.h"
+
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/ThreadLocalPtr.h"
+#include "Concurrency/UniqueLock.h"
+#include "Debug/DVAssert.h"
+
+namespace DAVA
+{
+namespace Private
+{
+struct WorkerJob
+{
+    enum eState : int32
+    {
+        STATE_CREATED,
+        STATE_QUEUED,
+        STATE_TAKEN
+    };
+
+    Function<void()> fn;
+    WorkerJob* parent = nullptr;
+
+    // references from handles, help lists and one reference owned by scheduler queue
+    std::atomic<int32> refCount{ 1 };
+    // queued job is executed by the thread that takes it first: worker or thread waiting for it
+    std::atomic<int32> state{ STATE_CREATED };
+    // job itself plus all not finished children
+    std::atomic<int32> unfinishedCount{ 1 };
+    // creation guard plus all not finished dependencies
+    std::atomic<int32> pendingDependencies{ 1 };
+
+    Spinlock continuationsLock;
+    bool completed = false;
+    Vector<WorkerJob*> continuations;
+
+    // submitted children and not finished dependencies, threads waiting for this job may execute them
+    Spinlock helpJobsLock;
+    Vector<WorkerJob*> helpJobs;
+};
+
+struct JobWorker
+{
+    JobWorker(JobScheduler* scheduler_, uint32 index_)
+        : scheduler(scheduler_)
+        , index(index_)
+        , deque(JobWorker::DEQUE_CAPACITY)
+    {
+    }
+
+    static const uint32 DEQUE_CAPACITY = 4096;
+
+    JobScheduler* scheduler = nullptr;
+    uint32 index = 0;
+    WorkStealingDeque<WorkerJob> deque;
+    Thread* thread = nullptr;
+};
+
+namespace JobSchedulerDetails
+{
+void RetainJob(WorkerJob* job)
+{
+    job->refCount.fetch_add(1);
+}
+
+void ReleaseJob(WorkerJob* job)
+{
+    if (job->refCount.fetch_sub(1) == 1)
+    {
+        delete job;
+    }
+}
+
+bool ClaimJob(WorkerJob* job)
+{
+    int32 expected = WorkerJob::STATE_QUEUED;
+    return job->state.compare_exchange_strong(expected, WorkerJob::STATE_TAKEN);
+}
+
+void AddHelpJob(WorkerJob* job, WorkerJob* helpJob)
+{
+    RetainJob(helpJob);
+    LockGuard<Spinlock> guard(job->helpJobsLock);
+    job->helpJobs.push_back(helpJob);
+}
+
+void DontDeleteWorker(JobWorker*)
+{
+    // worker is owned by scheduler
+}
+
+ThreadLocalPtr<JobWorker> currentWorker(&DontDeleteWorker);
+
+void DontDeleteJob(WorkerJob*)
+{
+    // job is released by scheduler
+}
+
+// job which function is executed by current thread
+ThreadLocalPtr<WorkerJob> executingJob(&DontDeleteJob);
+} // namespace JobSchedulerDetails
+} // namespace Private
+
+//////////////////////////////////////////////////////////////////////////
+// JobHandle
+//////////////////////////////////////////////////////////////////////////
+
+JobHandle::JobHandle(Private::WorkerJob* job_)
+    : job(job_)
+{
+    if (job != nullptr)
+    {
+        Private::JobSchedulerDetails::RetainJob(job);
+    }
+}
+
+JobHandle::JobHandle(const JobHandle& other)
+    : JobHandle(other.job)
+{
+}
+
+JobHandle::JobHandle(JobHandle&& other)
+    : job(other.job)
+{
+    other.job = nullptr;
+}
+
+JobHandle::~JobHandle()
+{
+    if (job != nullptr)
+    {
+        Private::JobSchedulerDetails::ReleaseJob(job);
+    }
+}
+
+JobHandle& JobHandle::operator=(const JobHandle& other)
+{
+    if (this != &other)
+    {
+        JobHandle tmp(other);
+        std::swap(job, tmp.job);
+    }
+    return *this;
+}
+
+JobHandle& JobHandle::operator=(JobHandle&& other)
+{
+    if (this != &other)
+    {
+        JobHandle tmp(std::move(other));
+        std::swap(job, tmp.job);
+    }
+    return *this;
+}
+
+bool JobHandle::IsEmpty() const
+{
+    return (nullptr == job);
+}
+
+bool JobHandle::IsDone() const
+{
+    return (nullptr == job || 0 == job->unfinishedCount.load());
+}
+
+//////////////////////////////////////////////////////////////////////////
+// JobScheduler
+//////////////////////////////////////////////////////////////////////////
+
+JobScheduler::JobScheduler(uint32 workersCount, const String& threadName)
+    : queuedJobsCount(0)
+    , activeJobsCount(0)
+    , sleepingWorkersCount(0)
+    , waitersCount(0)
+    , cancelWorkers(false)
+    , workerWakeSem(0)
+    , waitEpoch(0)
+{
+    workers.reserve(workersCount);
+    for (uint32 i = 0; i < workersCount; ++i)
+    {
+        workers.push_back(new Private::JobWorker(this, i));
+    }
+
+    // start threads only when all workers are created, as they steal from each other
+    for (Private::JobWorker* worker : workers)
+    {
+        worker->thread = Thread::Create([this, worker]() { WorkerThreadFunc(worker); });
+        worker->thread->SetName(threadName);
+        worker->thread->Start();
+    }
+}
+
+JobScheduler::~JobScheduler()
+{
+    cancelWorkers = true;
+    workerWakeSem.Post(static_cast<uint32>(workers.size()));
+
+    for (Private::JobWorker* worker : workers)
+    {
+        worker->thread->Join();
+        SafeRelease(worker->thread);
+    }
+
+    // release jobs that weren't executed
+    Private::WorkerJob* job = nullptr;
+    while ((job = TakeJob(nullptr)) != nullptr)
+    {
+        Private::JobSchedulerDetails::ReleaseJob(job);
+    }
+
+    for (Private::JobWorker* worker : workers)
+    {
+        SafeDelete(worker);
+    }
+    workers.clear();
+}
+
+uint32 JobScheduler::GetWorkersCount() const
+{
+    return static_cast<uint32>(workers.size());
+}
+
+JobHandle JobScheduler::Schedule(const Function<void()>& fn, const JobHandle& parent, const Vector<JobHandle>& dependencies)
+{
+    Private::WorkerJob* job = CreateJob(fn, parent.job);
+    JobHandle handle(job);
+
+    for (const JobHandle& dependency : dependencies)
+    {
+        Private::WorkerJob* dependencyJob = dependency.job;
+        if (nullptr != dependencyJob)
+        {
+            LockGuard<Spinlock> guard(dependencyJob->continuationsLock);
+            if (!dependencyJob->completed)
+            {
+                job->pendingDependencies.fetch_add(1);
+                dependencyJob->continuations.push_back(job);
+                Private::JobSchedulerDetails::AddHelpJob(job, dependencyJob);
+            }
+        }
+    }
+
+    // remove creation guard, job will be submitted by the last finished dependency otherwise
+    if (job->pendingDependencies.fetch_sub(1) == 1)
+    {
+        Submit(job);
+    }
+
+    return handle;
+}
+
+void JobScheduler::ParallelFor(uint32 begin, uint32 end, uint32 grain, const Function<void(uint32, uint32)>& fn)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+
+    grain = std::max(grain, 1u);
+    if (end - begin <= grain)
+    {
+        fn(begin, end);
+        return;
+    }
+
+    // root is never executed, it only gathers children created while splitting the range
+    Private::WorkerJob* root = new Private::WorkerJob();
+
+    SplitParallelFor(root, begin, end, grain, &fn);
+    FinishJob(root);
+
+    WaitUntil(root, [root]() { return 0 == root->unfinishedCount.load(); }, nullptr);
+    Private::JobSchedulerDetails::ReleaseJob(root);
+}
+
+void JobScheduler::Wait(const JobHandle& handle, const Function<void()>& onIdle)
+{
+    if (!handle.IsEmpty())
+    {
+        WaitUntil(handle.job, [&handle]() { return handle.IsDone(); }, onIdle);
+    }
+}
+
+void JobScheduler::WaitAll(const Function<void()>& onIdle)
+{
+    if (nullptr != Private::JobSchedulerDetails::executingJob.Get())
+    {
+        // calling job is counted as not finished, so waiting for all jobs would never end
+        while (ExecuteOne())
+        {
+        }
+        return;
+    }
+
+    WaitUntil(nullptr, [this]() { return !HasJobs(); }, onIdle);
+}
+
+bool JobScheduler::HasJobs() const
+{
+    return activeJobsCount.load() > 0;
+}
+
+bool JobScheduler::ExecuteOne()
+{
+    Private::WorkerJob* job = TakeJob(GetCurrentWorker());
+    if (nullptr != job)
+    {
+        Execute(job);
+        Private::JobSchedulerDetails::ReleaseJob(job);
+        return true;
+    }
+    return false;
+}
+
+void JobScheduler::WakeWaiters()
+{
+    LockGuard<Mutex> guard(waitMutex);
+    waitEpoch.fetch_add(1);
+    waitCV.NotifyAll();
+}
+
+Private::WorkerJob* JobScheduler::CreateJob(const Function<void()>& fn, Private::WorkerJob* parent)
+{
+    Private::WorkerJob* job = new Private::WorkerJob();
+    job->fn = fn;
+
+    if (nullptr != parent)
+    {
+        if (parent->unfinishedCount.fetch_add(1) > 0)
+        {
+            Private::JobSchedulerDetails::RetainJob(parent);
+            job->parent = parent;
+        }
+        else
+        {
+            parent->unfinishedCount.fetch_sub(1);
+            DVASSERT(false, "Child job is created for already finished parent");
+        }
+    }
+
+    activeJobsCount.fetch_add(1);
+    return job;
+}
+
+void JobScheduler::Submit(Private::WorkerJob* job)
+{
+    job->state.store(Private::WorkerJob::STATE_QUEUED);
+    if (nullptr != job->parent)
+    {
+        Private::JobSchedulerDetails::AddHelpJob(job->parent, job);
+    }
+
+    Private::JobWorker* worker = GetCurrentWorker();
+    if (nullptr == worker || !worker->deque.Push(job))
+    {
+        LockGuard<Spinlock> guard(injectionLock);
+        injectionQueue.push_back(job);
+    }
+
+    queuedJobsCount.fetch_add(1);
+    if (sleepingWorkersCount.load() > 0)
+    {
+        workerWakeSem.Post();
+    }
+    if (waitersCount.load() > 0)
+    {
+        WakeWaiters();
+    }
+}
+
+void JobScheduler::Execute(Private::WorkerJob* job)
+{
+    if (nullptr != job->fn)
+    {
+        Private::WorkerJob* outerJob = Private::JobSchedulerDetails::executingJob.Get();
+        Private::JobSchedulerDetails::executingJob.Reset(job);
+        job->fn();
+        job->fn = nullptr;
+        Private::JobSchedulerDetails::executingJob.Reset(outerJob);
+    }
+
+    FinishJob(job);
+    activeJobsCount.fetch_sub(1);
+
+    if (waitersCount.load() > 0)
+    {
+        WakeWaiters();
+    }
+}
+
+void JobScheduler::FinishJob(Private::WorkerJob* job)
+{
+    if (job->unfinishedCount.fetch_sub(1) != 1)
+    {
+        // there are not finished children
+        return;
+    }
+
+    Vector<Private::WorkerJob*> readyJobs;
+    {
+        LockGuard<Spinlock> guard(job->continuationsLock);
+        job->completed = true;
+        readyJobs.swap(job->continuations);
+    }
+
+    Vector<Private::WorkerJob*> helpJobs;
+    {
+        LockGuard<Spinlock> guard(job->helpJobsLock);
+        helpJobs.swap(job->helpJobs);
+    }
+    for (Private::WorkerJob* helpJob : helpJobs)
+    {
+        Private::JobSchedulerDetails::ReleaseJob(helpJob);
+    }
+
+    for (Private::WorkerJob* dependent : readyJobs)
+    {
+        if (dependent->pendingDependencies.fetch_sub(1) == 1)
+        {
+            Submit(dependent);
+        }
+    }
+
+    Private::WorkerJob* parent = job->parent;
+    if (nullptr != parent)
+    {
+        job->parent = nullptr;
+        FinishJob(parent);
+        Private::JobSchedulerDetails::ReleaseJob(parent);
+    }
+}
+
+Private::WorkerJob* JobScheduler::TakeJob(Private::JobWorker* worker)
+{
+    while (true)
+    {
+        Private::WorkerJob* job = PopQueuedJob(worker);
+        if (nullptr == job || Private::JobSchedulerDetails::ClaimJob(job))
+        {
+            return job;
+        }
+
+        // job has already been executed by a thread waiting for it, drop queue reference
+        Private::JobSchedulerDetails::ReleaseJob(job);
+    }
+}
+
+Private::WorkerJob* JobScheduler::TakeHelpJob(Private::WorkerJob* waitedJob)
+{
+    if (Private::JobSchedulerDetails::ClaimJob(waitedJob))
+    {
+        // queue keeps its reference until it drops the taken job
+        Private::JobSchedulerDetails::RetainJob(waitedJob);
+        return waitedJob;
+    }
+
+    Vector<Private::WorkerJob*> takenJobs;
+    Private::WorkerJob* job = nullptr;
+    {
+        LockGuard<Spinlock> guard(waitedJob->helpJobsLock);
+        Vector<Private::WorkerJob*>& helpJobs = waitedJob->helpJobs;
+        for (size_t i = helpJobs.size(); i > 0 && nullptr == job; --i)
+        {
+            Private::WorkerJob* helpJob = helpJobs[i - 1];
+            if (Private::JobSchedulerDetails::ClaimJob(helpJob))
+            {
+                job = helpJob;
+            }
+            else if (Private::WorkerJob::STATE_TAKEN == helpJob->state.load())
+            {
+                takenJobs.push_back(helpJob);
+            }
+            else
+            {
+                // dependency that isn't queued yet, keep it for the next attempt
+                continue;
+            }
+            helpJobs.erase(helpJobs.begin() + (i - 1));
+        }
+    }
+
+    // list reference of returned job is passed to the caller
+    for (Private::WorkerJob* takenJob : takenJobs)
+    {
+        Private::JobSchedulerDetails::ReleaseJob(takenJob);
+    }
+    return job;
+}
+
+Private::WorkerJob* JobScheduler::PopQueuedJob(Private::JobWorker* worker)
+{
+    Private::WorkerJob* job = nullptr;
+
+    if (nullptr != worker)
+    {
+        job = worker->deque.Pop();
+    }
+
+    if (nullptr == job)
+    {
+        LockGuard<Spinlock> guard(injectionLock);
+        if (!injectionQueue.empty())
+        {
+            job = injectionQueue.front();
+            injectionQueue.pop_front();
+        }
+    }
+
+    if (nullptr == job && !workers.empty())
+    {
+        // try to steal starting from the next worker to spread thieves across victims
+        uint32 count = static_cast<uint32>(workers.size());
+        uint32 start = (nullptr != worker) ? worker->index + 1 : 0;
+        for (uint32 i = 0; i < count && nullptr == job; ++i)
+        {
+            Private::JobWorker* victim = workers[(start + i) % count];
+            if (victim != worker)
+            {
+                job = victim->deque.Steal();
+            }
+        }
+    }
+
+    if (nullptr != job)
+    {
+        queuedJobsCount.fetch_sub(1);
+    }
+
+    return job;
+}
+
+Private::JobWorker* JobScheduler::GetCurrentWorker() const
+{
+    Private::JobWorker* worker = Private::JobSchedulerDetails::currentWorker.Get();
+    return (nullptr != worker && worker->scheduler == this) ? worker : nullptr;
+}
+
+void JobScheduler::SplitParallelFor(Private::WorkerJob* root, uint32 begin, uint32 end, uint32 grain, const Function<void(uint32, uint32)>* fn)
+{
+    // give away upper halves of the range, so thieves take the biggest chunks
+    while (end - begin > grain)
+    {
+        uint32 middle = begin + (end - begin) / 2;
+        uint32 upperEnd = end;
+        Private::WorkerJob* child = CreateJob([this, root, middle, upperEnd, grain, fn]() {
+            SplitParallelFor(root, middle, upperEnd, grain, fn);
+        },
+                                              root);
+        Submit(child);
+        end = middle;
+    }
+
+    (*fn)(begin, end);
+}
+
+void JobScheduler::WaitUntil(Private::WorkerJob* waitedJob, const Function<bool()>& isDone, const Function<void()>& onIdle)
+{
+    Private::JobWorker* worker = GetCurrentWorker();
+
+    while (true)
+    {
+        uint32 epoch = waitEpoch.load();
+        if (isDone())
+        {
+            break;
+        }
+
+        if (nullptr != onIdle)
+        {
+            onIdle();
+        }
+
+        // help to finish waited job instead of sleeping, without waited job any job can be taken
+        Private::WorkerJob* job = (nullptr != waitedJob) ? TakeHelpJob(waitedJob) : TakeJob(worker);
+        if (nullptr != job)
+        {
+            Execute(job);
+            Private::JobSchedulerDetails::ReleaseJob(job);
+            continue;
+        }
+
+        UniqueLock<Mutex> lock(waitMutex);
+        waitersCount.fetch_add(1);
+        if (!isDone())
+        {
+            waitCV.Wait(lock, [this, epoch]() { return waitEpoch.load() != epoch; });
+        }
+        waitersCount.fetch_sub(1);
+    }
+}
+
+void JobScheduler::WorkerThreadFunc(Private::JobWorker* worker)
+{
+    Private::JobSchedulerDetails::currentWorker.Reset(worker);
+
+    while (!cancelWorkers)
+    {
+        Private::WorkerJob* job = TakeJob(worker);
+        if (nullptr != job)
+        {
+            Execute(job);
+            Private::JobSchedulerDetails::ReleaseJob(job);
+            continue;
+        }
+
+        // Register as sleeping before checking queue, so producer
+        // either sees sleeping worker or worker sees produced job
+        sleepingWorkersCount.fetch_add(1);
+        if (queuedJobsCount.load() <= 0 && !cancelWorkers)
+        {
+            workerWakeSem.Wait();
+        }
+        sleepingWorkersCount.fetch_sub(1);
+    }
+
+    Private::JobSchedulerDetails::currentWorker.Release();
+}
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Concurrency/ConditionVariable.h"
+#include "Concurrency/Mutex.h"
+#include "Concurrency/Semaphore.h"
+#include "Concurrency/Spinlock.h"
+#include "Concurrency/Thread.h"
+#include "Functional/Function.h"
+
+#include <atomic>
+
+namespace DAVA
+{
+namespace Private
+{
+struct WorkerJob;
+struct JobWorker;
+}
+
+/**
+    Handle of a job created by `JobScheduler`.
+
+    Handle can be used to check whether job is finished, to wait for it, to make it a parent of other jobs
+    or a dependency of other jobs. Job is considered finished when its function and functions of all its
+    children have been executed. Empty handle is considered finished.
+*/
+class JobHandle final
+{
+public:
+    JobHandle() = default;
+    JobHandle(const JobHandle& other);
+    JobHandle(JobHandle&& other);
+    ~JobHandle();
+
+    JobHandle& operator=(const JobHandle& other);
+    JobHandle& operator=(JobHandle&& other);
+
+    bool IsEmpty() const;
+    bool IsDone() const;
+
+private:
+    explicit JobHandle(Private::WorkerJob* job);
+
+    Private::WorkerJob* job = nullptr;
+
+    friend class JobScheduler;
+};
+
+/**
+    Work-stealing job scheduler.
+
+    Every worker thread owns lock-free deque of jobs. Jobs created from a worker thread are pushed into
+    the deque of that worker, jobs created from any other thread are pushed into the shared injection queue.
+    Idle worker takes jobs from its own deque first, then from the injection queue and then tries to steal
+    jobs from other workers.
+
+    Thread, that waits for a job (see `Wait`, `ParallelFor`), helps to execute the waited job, its children
+    and its dependencies instead of blocking, so waiting from inside of a job is allowed. Unrelated jobs are
+    never executed by waiting thread, so waiting isn't prolonged by foreign work. `WaitAll` helps with any job.
+*/
+class JobScheduler final
+{
+public:
+    JobScheduler(uint32 workersCount, const String& threadName = "DAVA::JobThread");
+    ~JobScheduler();
+
+    JobScheduler(const JobScheduler&) = delete;
+    JobScheduler& operator=(const JobScheduler&) = delete;
+
+    /** Return the number of worker threads. */
+    uint32 GetWorkersCount() const;
+
+    /**
+        Create job that executes `fn` in one of worker threads.
+
+        \param [in] fn Function to execute.
+        \param [in] parent Optional parent job. Parent won't be finished until this job is finished.
+                    Child should be created before the parent is finished, usually from the parent's function.
+        \param [in] dependencies Jobs that should be finished before `fn` may start.
+        \return Handle of created job.
+    */
+    JobHandle Schedule(const Function<void()>& fn, const JobHandle& parent = JobHandle(), const Vector<JobHandle>& dependencies = Vector<JobHandle>());
+
+    /**
+        Split range [begin, end) into chunks of no more than `grain` elements and execute `fn(chunkBegin, chunkEnd)`
+        for every chunk in worker threads. Calling thread takes part in the execution. Function returns when all chunks are processed.
+    */
+    void ParallelFor(uint32 begin, uint32 end, uint32 grain, const Function<void(uint32, uint32)>& fn);
+
+    /**
+        Wait until job referenced by `handle` is finished. Calling thread executes the job, its pending children
+        and dependencies while waiting.
+        \param [in] onIdle Optional function that is called on every wait iteration, e.g. to process main-thread jobs.
+    */
+    void Wait(const JobHandle& handle, const Function<void()>& onIdle = nullptr);
+
+    /**
+        Wait until all created jobs are finished. See `Wait` for `onIdle` description.
+        Called from a job it can't wait for the calling job itself, so it only executes pending jobs in the calling thread.
+    */
+    void WaitAll(const Function<void()>& onIdle = nullptr);
+
+    /** Return true if there are created jobs that are not finished yet. */
+    bool HasJobs() const;
+
+    /** Take one pending job and execute it in the calling thread. Return false if there were no jobs to execute. */
+    bool ExecuteOne();
+
+    /** Wake up all threads waiting in `Wait` or `WaitAll`, so they can re-check conditions and call `onIdle`. */
+    void WakeWaiters();
+
+private:
+    Private::WorkerJob* CreateJob(const Function<void()>& fn, Private::WorkerJob* parent);
+    void Submit(Private::WorkerJob* job);
+    void Execute(Private::WorkerJob* job);
+    void FinishJob(Private::WorkerJob* job);
+    Private::WorkerJob* TakeJob(Private::JobWorker* worker);
+    Private::WorkerJob* TakeHelpJob(Private::WorkerJob* waitedJob);
+    Private::WorkerJob* PopQueuedJob(Private::JobWorker* worker);
+    Private::JobWorker* GetCurrentWorker() const;
+    void SplitParallelFor(Private::WorkerJob* root, uint32 begin, uint32 end, uint32 grain, const Function<void(uint32, uint32)>* fn);
+    void WaitUntil(Private::WorkerJob* waitedJob, const Function<bool()>& isDone, const Function<void()>& onIdle);
+    void WorkerThreadFunc(Private::JobWorker* worker);
+
+    Vector<Private::JobWorker*> workers;
+
+    Spinlock injectionLock;
+    Deque<Private::WorkerJob*> injectionQueue;
+
+    std::atomic<int32> queuedJobsCount;
+    std::atomic<int32> activeJobsCount;
+    std::atomic<int32> sleepingWorkersCount;
+    std::atomic<int32> waitersCount;
+    std::atomic<bool> cancelWorkers;
+    Semaphore workerWakeSem;
+
+    Mutex waitMutex;
+    ConditionVariable waitCV;
+    std::atomic<uint32> waitEpoch;
+};
+}
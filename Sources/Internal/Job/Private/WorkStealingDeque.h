@@ -0,0 +1,135 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Debug/DVAssert.h"
+#include "Math/MathHelpers.h"
+
+#include <atomic>
+
+namespace DAVA
+{
+namespace Private
+{
+/**
+    Bounded lock-free work-stealing deque (Chase-Lev).
+
+    Only the owner thread may call `Push` and `Pop`, they operate on the bottom end of the deque.
+    Any other thread may call `Steal`, which takes elements from the top end.
+    Deque has fixed capacity, `Push` returns false if there is no free space left.
+*/
+template <typename T>
+class WorkStealingDeque final
+{
+public:
+    WorkStealingDeque(uint32 capacity);
+    ~WorkStealingDeque();
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    bool Push(T* item);
+    T* Pop();
+    T* Steal();
+
+    bool IsEmpty() const;
+
+private:
+    std::atomic<int64> top;
+    std::atomic<int64> bottom;
+    std::atomic<T*>* items = nullptr;
+    int64 mask = 0;
+};
+
+template <typename T>
+WorkStealingDeque<T>::WorkStealingDeque(uint32 capacity)
+    : top(0)
+    , bottom(0)
+{
+    DVASSERT(IsPowerOf2(capacity) && "Capacity of WorkStealingDeque should be pow of two");
+
+    items = new std::atomic<T*>[capacity];
+    for (uint32 i = 0; i < capacity; ++i)
+    {
+        items[i].store(nullptr, std::memory_order_relaxed);
+    }
+    mask = static_cast<int64>(capacity) - 1;
+}
+
+template <typename T>
+WorkStealingDeque<T>::~WorkStealingDeque()
+{
+    SafeDeleteArray(items);
+}
+
+template <typename T>
+bool WorkStealingDeque<T>::Push(T* item)
+{
+    int64 b = bottom.load(std::memory_order_relaxed);
+    int64 t = top.load(std::memory_order_acquire);
+    if (b - t > mask)
+    {
+        return false;
+    }
+
+    items[b & mask].store(item, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return true;
+}
+
+template <typename T>
+T* WorkStealingDeque<T>::Pop()
+{
+    int64 b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64 t = top.load(std::memory_order_relaxed);
+
+    if (t > b)
+    {
+        // deque is empty
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    T* item = items[b & mask].load(std::memory_order_relaxed);
+    if (t == b)
+    {
+        // last item, race against thieves
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            item = nullptr;
+        }
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return item;
+}
+
+template <typename T>
+T* WorkStealingDeque<T>::Steal()
+{
+    int64 t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64 b = bottom.load(std::memory_order_acquire);
+
+    if (t < b)
+    {
+        T* item = items[t & mask].load(std::memory_order_relaxed);
+        if (top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return item;
+        }
+    }
+    return nullptr;
+}
+
+template <typename T>
+bool WorkStealingDeque<T>::IsEmpty() const
+{
+    int64 t = top.load(std::memory_order_relaxed);
+    int64 b = bottom.load(std::memory_order_relaxed);
+    return b <= t;
+}
+
+} // namespace Private
+} // namespace DAVA
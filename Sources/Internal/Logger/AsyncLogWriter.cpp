@@ -0,0 +1,280 @@
+#include "Logger/AsyncLogWriter.h"
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/Thread.h"
+#include "Debug/DVAssert.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+
+#include <ctime>
+
+namespace DAVA
+{
+namespace AsyncLogWriterDetails
+{
+const uint32 STAGING_BUFFER_SIZE = 64 * 1024; // should be power of two
+const uint32 WRITER_PERIOD_MS = 50;
+}
+
+struct AsyncLogWriter::RecordHeader
+{
+    uint32 length;
+    uint32 level;
+    int64 timestamp;
+};
+
+/**
+    Single-producer single-consumer ring buffer of log records.
+    `head` and `tail` are total counts of written and consumed bytes, they are wrapped modulo buffer size.
+*/
+struct AsyncLogWriter::StagingBuffer
+{
+    void Copy(uint32 position, const void* source, uint32 size)
+    {
+        uint32 offset = position & (AsyncLogWriterDetails::STAGING_BUFFER_SIZE - 1);
+        uint32 firstPart = std::min(size, AsyncLogWriterDetails::STAGING_BUFFER_SIZE - offset);
+        Memcpy(data.data() + offset, source, firstPart);
+        Memcpy(data.data(), static_cast<const uint8*>(source) + firstPart, size - firstPart);
+    }
+
+    void CopyTo(uint32 position, void* destination, uint32 size) const
+    {
+        uint32 offset = position & (AsyncLogWriterDetails::STAGING_BUFFER_SIZE - 1);
+        uint32 firstPart = std::min(size, AsyncLogWriterDetails::STAGING_BUFFER_SIZE - offset);
+        Memcpy(destination, data.data() + offset, firstPart);
+        Memcpy(static_cast<uint8*>(destination) + firstPart, data.data(), size - firstPart);
+    }
+
+    Array<uint8, AsyncLogWriterDetails::STAGING_BUFFER_SIZE> data;
+    std::atomic<uint32> head{ 0 };
+    std::atomic<uint32> tail{ 0 };
+    std::atomic<bool> threadExited{ false }; // set by owning thread on exit after its last message
+};
+
+AsyncLogWriter::AsyncLogWriter(const FilePath& filePath_, uint32 maxFileSize_)
+    : filePath(filePath_)
+    , maxFileSize(maxFileSize_)
+{
+#if defined(__DAVAENGINE_WINDOWS__)
+    threadBufferKey = FlsAlloc(&AsyncLogWriter::OnThreadExit);
+    DVASSERT(threadBufferKey != FLS_OUT_OF_INDEXES);
+#else
+    int result = pthread_key_create(&threadBufferKey, &AsyncLogWriter::OnThreadExit);
+    DVASSERT(result == 0);
+#endif
+
+    writerThread = RefPtr<Thread>(Thread::Create([this]() { WriterThreadFunc(); }));
+    writerThread->SetName("AsyncLogWriter");
+    writerThread->Start();
+}
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    stopWriter = true;
+    writerThread->Join();
+
+    Flush();
+    file = nullptr;
+
+    // FlsFree calls exit callback for threads which still have buffers, so slot is freed before buffers
+#if defined(__DAVAENGINE_WINDOWS__)
+    FlsFree(threadBufferKey);
+#else
+    pthread_key_delete(threadBufferKey);
+#endif
+
+    newBuffers.PopAll(buffers);
+    for (StagingBuffer* buffer : buffers)
+    {
+        delete buffer;
+    }
+}
+
+void AsyncLogWriter::Write(Logger::eLogLevel ll, const char8* text)
+{
+    using namespace AsyncLogWriterDetails;
+
+    StagingBuffer* buffer = GetThreadBuffer();
+
+    uint32 length = std::min(static_cast<uint32>(strlen(text)), STAGING_BUFFER_SIZE - static_cast<uint32>(sizeof(RecordHeader)));
+    uint32 recordSize = static_cast<uint32>(sizeof(RecordHeader)) + length;
+
+    uint32 head = buffer->head.load(std::memory_order_relaxed);
+    if (STAGING_BUFFER_SIZE - (head - buffer->tail.load(std::memory_order_acquire)) < recordSize)
+    {
+        Flush();
+        if (STAGING_BUFFER_SIZE - (head - buffer->tail.load(std::memory_order_acquire)) < recordSize)
+        {
+            return; // message is logged by file operations of writer itself and buffer is still full
+        }
+    }
+
+    RecordHeader header;
+    header.length = length;
+    header.level = static_cast<uint32>(ll);
+    header.timestamp = static_cast<int64>(time(nullptr));
+
+    buffer->Copy(head, &header, sizeof(header));
+    buffer->Copy(head + sizeof(header), text, length);
+    buffer->head.store(head + recordSize, std::memory_order_release);
+}
+
+void AsyncLogWriter::Flush()
+{
+    LockGuard<RecursiveMutex> guard(writeMutex);
+    if (!draining)
+    {
+        draining = true;
+        DrainBuffers();
+        if (file)
+        {
+            file->Flush();
+        }
+        draining = false;
+    }
+}
+
+void AsyncLogWriter::SetFilePath(const FilePath& filePath_)
+{
+    Flush();
+
+    LockGuard<RecursiveMutex> guard(writeMutex);
+    file = nullptr;
+    filePath = filePath_;
+}
+
+void AsyncLogWriter::SetMaxFileSize(uint32 size)
+{
+    maxFileSize = size;
+}
+
+AsyncLogWriter::StagingBuffer* AsyncLogWriter::GetThreadBuffer()
+{
+#if defined(__DAVAENGINE_WINDOWS__)
+    StagingBuffer* buffer = static_cast<StagingBuffer*>(FlsGetValue(threadBufferKey));
+#else
+    StagingBuffer* buffer = static_cast<StagingBuffer*>(pthread_getspecific(threadBufferKey));
+#endif
+    if (buffer == nullptr)
+    {
+        buffer = new StagingBuffer();
+#if defined(__DAVAENGINE_WINDOWS__)
+        FlsSetValue(threadBufferKey, buffer);
+#else
+        pthread_setspecific(threadBufferKey, buffer);
+#endif
+        newBuffers.Push(buffer);
+    }
+    return buffer;
+}
+
+void AsyncLogWriter::OnThreadExit(void* buffer)
+{
+    // buffer is owned by writer, which deletes it after the last drain
+    if (buffer != nullptr)
+    {
+        static_cast<StagingBuffer*>(buffer)->threadExited.store(true, std::memory_order_release);
+    }
+}
+
+void AsyncLogWriter::WriterThreadFunc()
+{
+    while (!stopWriter)
+    {
+        Thread::Sleep(AsyncLogWriterDetails::WRITER_PERIOD_MS);
+        Flush();
+    }
+}
+
+void AsyncLogWriter::DrainBuffers()
+{
+    newBuffers.PopAll(buffers);
+
+    for (size_t i = 0; i < buffers.size();)
+    {
+        StagingBuffer* buffer = buffers[i];
+
+        // exit flag is read before draining, so all messages of exited thread are drained
+        bool threadExited = buffer->threadExited.load(std::memory_order_acquire);
+        DrainBuffer(buffer);
+
+        if (threadExited)
+        {
+            delete buffer;
+            buffers.erase(buffers.begin() + i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+void AsyncLogWriter::DrainBuffer(StagingBuffer* buffer)
+{
+    uint32 tail = buffer->tail.load(std::memory_order_relaxed);
+    uint32 head = buffer->head.load(std::memory_order_acquire);
+
+    while (tail != head)
+    {
+        RecordHeader header;
+        buffer->CopyTo(tail, &header, sizeof(header));
+
+        recordText.resize(header.length + 1);
+        buffer->CopyTo(tail + sizeof(header), recordText.data(), header.length);
+        recordText[header.length] = '\0';
+
+        tail += static_cast<uint32>(sizeof(header)) + header.length;
+        buffer->tail.store(tail, std::memory_order_release);
+
+        WriteToFile(header, recordText.data());
+    }
+}
+
+void AsyncLogWriter::WriteToFile(const RecordHeader& header, const char8* text)
+{
+    if (!file)
+    {
+        file = File::Create(filePath, File::APPEND | File::WRITE);
+        if (!file)
+        {
+            return;
+        }
+        fileSize = file->GetSize();
+    }
+
+    Array<char8, 128> prefix;
+
+    int64 timestamp = header.timestamp; //Time in UTC format
+    int32 seconds = timestamp % 60;
+    int32 minutes = (timestamp / 60) % 60;
+    int32 hours = (timestamp / (60 * 60)) % 24;
+
+    Snprintf(&prefix[0], prefix.size(), "%02d:%02d:%02d [%s] ", hours, minutes, seconds, Logger::GetLogLevelString(static_cast<Logger::eLogLevel>(header.level)));
+    uint32 prefixLength = static_cast<uint32>(strlen(prefix.data()));
+    uint32 recordLength = prefixLength + header.length;
+
+    if (fileSize > 0 && fileSize + recordLength > maxFileSize)
+    {
+        RotateFile();
+        if (!file)
+        {
+            return;
+        }
+    }
+
+    file->Write(prefix.data(), prefixLength);
+    file->Write(text, header.length);
+    fileSize += recordLength;
+}
+
+void AsyncLogWriter::RotateFile()
+{
+    file = nullptr;
+
+    FilePath previousFilePath(filePath.GetAbsolutePathname() + ".1");
+    FileSystem::Instance()->MoveFile(filePath, previousFilePath, true);
+
+    file = File::Create(filePath, File::CREATE | File::WRITE);
+    fileSize = 0;
+}
+}
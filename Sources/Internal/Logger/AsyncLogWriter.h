@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/RefPtr.h"
+#include "Base/ScopedPtr.h"
+#include "Concurrency/MPSCQueue.h"
+#include "Concurrency/Mutex.h"
+#include "FileSystem/FilePath.h"
+#include "Logger/Logger.h"
+
+#include <atomic>
+#if defined(__DAVAENGINE_POSIX__)
+#include <pthread.h>
+#endif
+
+namespace DAVA
+{
+class File;
+class Thread;
+
+/**
+    Writes log messages to file on separate writer thread.
+
+    Each thread that logs gets its own staging ring buffer, so `Write` only copies message into that buffer
+    without locks or system calls. Writer thread periodically moves messages from all buffers into log file
+    which is kept open. When next message does not fit into max file size, file is renamed to `<filename>.1`
+    (replacing previous one) and new file is started.
+
+    `Flush` writes all staged messages from calling thread, it is also done when staging buffer of thread
+    is full and when writer is destroyed. Messages of one thread are written in order, messages of different
+    threads can be reordered within one writer period.
+
+    When logging thread exits, its staging buffer is drained for the last time and released by writer thread.
+*/
+class AsyncLogWriter final
+{
+public:
+    AsyncLogWriter(const FilePath& filePath, uint32 maxFileSize);
+    ~AsyncLogWriter();
+
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+    /** Stage message for writing. Can be called from any thread. */
+    void Write(Logger::eLogLevel ll, const char8* text);
+
+    /** Write all staged messages to file and flush it. Can be called from any thread. */
+    void Flush();
+
+    /** Flush staged messages to current file and continue writing to `filePath`. */
+    void SetFilePath(const FilePath& filePath);
+    void SetMaxFileSize(uint32 size);
+
+private:
+    struct StagingBuffer;
+    struct RecordHeader;
+
+    StagingBuffer* GetThreadBuffer();
+    void WriterThreadFunc();
+#if defined(__DAVAENGINE_WINDOWS__)
+    static void WINAPI OnThreadExit(void* buffer);
+#else
+    static void OnThreadExit(void* buffer);
+#endif
+
+    // Following methods should be called with `writeMutex` locked
+    void DrainBuffers();
+    void DrainBuffer(StagingBuffer* buffer);
+    void WriteToFile(const RecordHeader& header, const char8* text);
+    void RotateFile();
+
+    // thread local slot of staging buffer which notifies about thread exit, fiber local storage is used on Windows for that
+#if defined(__DAVAENGINE_WINDOWS__)
+    DWORD threadBufferKey;
+#else
+    pthread_key_t threadBufferKey;
+#endif
+    MPSCQueue<StagingBuffer*> newBuffers; // buffers created by threads and not yet seen by writer
+
+    RecursiveMutex writeMutex;
+    bool draining = false; // guards from draining when file operations log messages
+    Vector<StagingBuffer*> buffers;
+    FilePath filePath;
+    ScopedPtr<File> file;
+    uint64 fileSize = 0;
+    std::atomic<uint32> maxFileSize;
+    Vector<char8> recordText;
+
+    RefPtr<Thread> writerThread;
+    std::atomic<bool> stopWriter{ false };
+};
+}
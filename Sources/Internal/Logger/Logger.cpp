@@ -1,9 +1,11 @@
 #include "Logger/Logger.h"
+#include "Logger/AsyncLogWriter.h"
 #include "Engine/Engine.h"
 #include "FileSystem/FileSystem.h"
 #include "Debug/DVAssert.h"
 #include <cstdarg>
 #include <array>
+#include <csignal>
 #include <ctime>
 
 #include "Utils/Utils.h"
@@ -15,6 +17,85 @@ namespace DAVA
 namespace
 {
 const size_t defaultBufferSize{ 4096 };
+
+// crash handlers write pending messages of async log writer before application is terminated
+#if defined(__DAVAENGINE_WIN32__)
+LPTOP_LEVEL_EXCEPTION_FILTER previousExceptionFilter = nullptr;
+
+LONG WINAPI FlushLogOnUnhandledException(EXCEPTION_POINTERS* e)
+{
+    Logger::FlushLog();
+    return (previousExceptionFilter != nullptr) ? previousExceptionFilter(e) : EXCEPTION_CONTINUE_SEARCH;
+}
+
+void InstallCrashHandlers()
+{
+    previousExceptionFilter = SetUnhandledExceptionFilter(&FlushLogOnUnhandledException);
+}
+
+void UninstallCrashHandlers()
+{
+    LPTOP_LEVEL_EXCEPTION_FILTER currentFilter = SetUnhandledExceptionFilter(previousExceptionFilter);
+    if (currentFilter != &FlushLogOnUnhandledException)
+    {
+        // filter was replaced after installing, keep it
+        SetUnhandledExceptionFilter(currentFilter);
+    }
+}
+#elif defined(__DAVAENGINE_POSIX__)
+const Array<int, 5> crashSignals = { { SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT } };
+Array<struct sigaction, 5> previousSignalActions;
+
+void FlushLogOnCrashSignal(int signal)
+{
+    Logger::FlushLog();
+
+    // restore previous handler and raise signal again, so application crashes as without this handler
+    for (size_t i = 0; i < crashSignals.size(); ++i)
+    {
+        if (crashSignals[i] == signal)
+        {
+            sigaction(signal, &previousSignalActions[i], nullptr);
+        }
+    }
+    raise(signal);
+}
+
+void InstallCrashHandlers()
+{
+    struct sigaction action;
+    Memset(&action, 0, sizeof(action));
+    sigemptyset(&action.sa_mask);
+    action.sa_handler = &FlushLogOnCrashSignal;
+
+    for (size_t i = 0; i < crashSignals.size(); ++i)
+    {
+        sigaction(crashSignals[i], &action, &previousSignalActions[i]);
+    }
+}
+
+void UninstallCrashHandlers()
+{
+    for (size_t i = 0; i < crashSignals.size(); ++i)
+    {
+        struct sigaction currentAction;
+        sigaction(crashSignals[i], &previousSignalActions[i], &currentAction);
+        if (currentAction.sa_handler != &FlushLogOnCrashSignal)
+        {
+            // handler was replaced after installing, keep it
+            sigaction(crashSignals[i], &currentAction, nullptr);
+        }
+    }
+}
+#else
+void InstallCrashHandlers()
+{
+}
+
+void UninstallCrashHandlers()
+{
+}
+#endif
 }
 
 String ConvertCFormatListToString(const char8* format, va_list pargs)
@@ -101,6 +182,13 @@ Logger::Logger()
 
 Logger::~Logger()
 {
+    AsyncLogWriter* writer = asyncLogWriter.exchange(nullptr);
+    if (writer != nullptr)
+    {
+        UninstallCrashHandlers();
+        delete writer;
+    }
+
     for (auto logOutput : customOutputs)
     {
         delete logOutput;
@@ -317,6 +405,12 @@ void Logger::SetLogPathname(const FilePath& filepath)
     DVASSERT(canWorkWithFile);
 
     logFilename = filepath;
+
+    AsyncLogWriter* writer = asyncLogWriter.load();
+    if (writer != nullptr)
+    {
+        writer->SetFilePath(logFilename);
+    }
 }
 
 FilePath Logger::GetLogPathForFilename(const String& filename)
@@ -328,6 +422,40 @@ FilePath Logger::GetLogPathForFilename(const String& filename)
 void Logger::SetMaxFileSize(uint32 size)
 {
     cutLogSize = size;
+
+    AsyncLogWriter* writer = asyncLogWriter.load();
+    if (writer != nullptr)
+    {
+        writer->SetMaxFileSize(cutLogSize);
+    }
+}
+
+void Logger::EnableAsyncFileLog()
+{
+    if (asyncLogWriter.load() == nullptr)
+    {
+        // writer is never reset while logger is alive, so threads logging meanwhile can't see deleted writer
+        AsyncLogWriter* expected = nullptr;
+        AsyncLogWriter* writer = new AsyncLogWriter(logFilename, cutLogSize);
+        if (asyncLogWriter.compare_exchange_strong(expected, writer))
+        {
+            InstallCrashHandlers();
+        }
+        else
+        {
+            delete writer;
+        }
+    }
+}
+
+void Logger::FlushLog()
+{
+    Logger* log = GetLoggerInstance();
+    AsyncLogWriter* writer = (log != nullptr) ? log->asyncLogWriter.load() : nullptr;
+    if (writer != nullptr)
+    {
+        writer->Flush();
+    }
 }
 
 DAVA::Logger* Logger::GetLoggerInstance()
@@ -461,6 +589,17 @@ void Logger::Output(const FilePath& customLogFilename, eLogLevel ll, const char8
 
         if (!customLogFilename.IsEmpty())
         {
+            AsyncLogWriter* writer = asyncLogWriter.load();
+            if (writer != nullptr && customLogFilename == logFilename)
+            {
+                writer->Write(ll, formatedMsg);
+                if (ll >= LEVEL_ERROR)
+                {
+                    writer->Flush();
+                }
+                return;
+            }
+
             if (customLogFilename != logFilename)
             {
                 CutOldLogFileIfExist(customLogFilename);
@@ -13,10 +13,12 @@
 
 #include "FileSystem/FilePath.h"
 
+#include <atomic>
 #include <cstdarg>
 
 namespace DAVA
 {
+class AsyncLogWriter;
 class LoggerOutput;
 
 class Logger
@@ -111,6 +113,24 @@ public:
     void SetMaxFileSize(uint32 size);
     void EnableConsoleMode();
 
+    /**
+        Enable writing to log file (see `SetLogPathname`) on separate thread. Disabled by default, can be enabled
+        with engine option `async_file_log`. Once enabled, async writing stays on until logger destruction,
+        so it's safe to enable it while other threads are logging.
+        Log file is kept open and is rotated when its size exceeds max file size (see `SetMaxFileSize`).
+        Messages are flushed to file on error messages, on halting assert, on `FlushLog` and on logger destruction.
+        Also handlers of fatal signals (unhandled SEH exceptions on Windows) are installed, they flush messages
+        and pass crash to previously installed handlers. Handlers are removed on logger destruction.
+        Messages written to custom log files (`LogToFile` and others) are written synchronously.
+    */
+    void EnableAsyncFileLog();
+
+    /**
+        Write all pending messages to log file if async file logging is enabled.
+        Called by assert and crash handlers before application is stopped.
+    */
+    static void FlushLog();
+
     static const char8* GetLogLevelString(eLogLevel ll);
     //TODO: insert Optional
     static eLogLevel GetLogLevelFromString(const char8* ll);
@@ -130,6 +150,8 @@ private:
     Vector<LoggerOutput*> customOutputs;
     bool consoleModeEnabled;
     uint32 cutLogSize = 512 * 1024; //0.5 MB;
+    // created once by `EnableAsyncFileLog` and deleted in destructor
+    std::atomic<AsyncLogWriter*> asyncLogWriter{ nullptr };
 };
 
 class LoggerOutput
@@ -0,0 +1,14 @@
+#pragma once
+
+/**
+    Detection of SIMD instruction set available on target platform.
+    Defines DAVA_SIMD_SSE or DAVA_SIMD_NEON and includes corresponding intrinsics header,
+    code without either of defines should use scalar fallback.
+*/
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define DAVA_SIMD_SSE 1
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DAVA_SIMD_NEON 1
+#endif
@@ -34,6 +34,8 @@ enum ePredefAllocPools
 
     ALLOC_POOL_PHYSICS,
 
+    ALLOC_POOL_FRAME_ARENA, // Allocation pool for memory chunks of per-frame arenas (see FrameArena)
+
     PREDEF_POOL_COUNT,
     FIRST_CUSTOM_ALLOC_POOL = PREDEF_POOL_COUNT // First custom allocation pool must be FIRST_CUSTOM_ALLOC_POOL
 };
@@ -0,0 +1,334 @@
+#include "Particles/ParticleBlock.h"
+
+#include "Debug/DVAssert.h"
+#include "Math/SIMD.h"
+
+namespace DAVA
+{
+namespace ParticleBlockDetails
+{
+template <typename T>
+inline void SwapRemove(Vector<T>& array, uint32 index)
+{
+    array[index] = array.back();
+    array.pop_back();
+}
+
+// Kernels are written once with these wrappers and process four particles at a time, remaining particles are processed by scalar code.
+#if defined(DAVA_SIMD_SSE)
+#define DAVA_PARTICLE_BLOCK_SIMD 1
+using Float4 = __m128;
+inline Float4 Load4(const float32* p)
+{
+    return _mm_loadu_ps(p);
+}
+inline void Store4(float32* p, Float4 v)
+{
+    _mm_storeu_ps(p, v);
+}
+inline Float4 Splat4(float32 v)
+{
+    return _mm_set1_ps(v);
+}
+inline Float4 Add4(Float4 a, Float4 b)
+{
+    return _mm_add_ps(a, b);
+}
+inline Float4 Sub4(Float4 a, Float4 b)
+{
+    return _mm_sub_ps(a, b);
+}
+inline Float4 Mul4(Float4 a, Float4 b)
+{
+    return _mm_mul_ps(a, b);
+}
+inline Float4 Min4(Float4 a, Float4 b)
+{
+    return _mm_min_ps(a, b);
+}
+inline Float4 Max4(Float4 a, Float4 b)
+{
+    return _mm_max_ps(a, b);
+}
+#elif defined(DAVA_SIMD_NEON)
+#define DAVA_PARTICLE_BLOCK_SIMD 1
+using Float4 = float32x4_t;
+inline Float4 Load4(const float32* p)
+{
+    return vld1q_f32(p);
+}
+inline void Store4(float32* p, Float4 v)
+{
+    vst1q_f32(p, v);
+}
+inline Float4 Splat4(float32 v)
+{
+    return vdupq_n_f32(v);
+}
+inline Float4 Add4(Float4 a, Float4 b)
+{
+    return vaddq_f32(a, b);
+}
+inline Float4 Sub4(Float4 a, Float4 b)
+{
+    return vsubq_f32(a, b);
+}
+inline Float4 Mul4(Float4 a, Float4 b)
+{
+    return vmulq_f32(a, b);
+}
+inline Float4 Min4(Float4 a, Float4 b)
+{
+    return vminq_f32(a, b);
+}
+inline Float4 Max4(Float4 a, Float4 b)
+{
+    return vmaxq_f32(a, b);
+}
+#endif
+}
+
+uint32 ParticleBlock::Add()
+{
+    positionX.push_back(0.0f);
+    positionY.push_back(0.0f);
+    positionZ.push_back(0.0f);
+    speedX.push_back(0.0f);
+    speedY.push_back(0.0f);
+    speedZ.push_back(0.0f);
+    life.push_back(0.0f);
+    lifeTime.push_back(0.0f);
+    angle.push_back(0.0f);
+    spin.push_back(0.0f);
+    currRadius.push_back(0.0f);
+    baseSize.push_back(Vector2());
+    currSize.push_back(Vector2());
+    color.push_back(Color());
+    attributes.emplace_back();
+
+    return GetSize() - 1;
+}
+
+void ParticleBlock::Remove(uint32 index)
+{
+    using namespace ParticleBlockDetails;
+
+    DVASSERT(index < GetSize());
+
+    SwapRemove(positionX, index);
+    SwapRemove(positionY, index);
+    SwapRemove(positionZ, index);
+    SwapRemove(speedX, index);
+    SwapRemove(speedY, index);
+    SwapRemove(speedZ, index);
+    SwapRemove(life, index);
+    SwapRemove(lifeTime, index);
+    SwapRemove(angle, index);
+    SwapRemove(spin, index);
+    SwapRemove(currRadius, index);
+    SwapRemove(baseSize, index);
+    SwapRemove(currSize, index);
+    SwapRemove(color, index);
+    SwapRemove(attributes, index);
+}
+
+void ParticleBlock::Shrink(uint32 size)
+{
+    if (size >= GetSize())
+        return;
+
+    positionX.resize(size);
+    positionY.resize(size);
+    positionZ.resize(size);
+    speedX.resize(size);
+    speedY.resize(size);
+    speedZ.resize(size);
+    life.resize(size);
+    lifeTime.resize(size);
+    angle.resize(size);
+    spin.resize(size);
+    currRadius.resize(size);
+    baseSize.resize(size);
+    currSize.resize(size);
+    color.resize(size);
+    attributes.resize(size);
+}
+
+void ParticleBlock::Clear()
+{
+    Shrink(0);
+}
+
+void ParticleBlock::UpdateLife(float32 dt)
+{
+    uint32 count = GetSize();
+    uint32 i = 0;
+
+#if defined(DAVA_PARTICLE_BLOCK_SIMD)
+    using namespace ParticleBlockDetails;
+
+    Float4 dt4 = Splat4(dt);
+    for (; i + 4 <= count; i += 4)
+    {
+        Store4(&life[i], Add4(Load4(&life[i]), dt4));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        life[i] += dt;
+    }
+
+    i = 0;
+    while (i < GetSize())
+    {
+        if (life[i] >= lifeTime[i])
+            Remove(i); //last particle is moved to i, check it on next iteration
+        else
+            ++i;
+    }
+}
+
+void ParticleBlock::IntegratePositions(float32 dt, const float32* velocityScale, float32* prevX, float32* prevY, float32* prevZ)
+{
+    uint32 count = GetSize();
+    bool storePrevious = (prevX != nullptr && prevY != nullptr && prevZ != nullptr);
+    uint32 i = 0;
+
+#if defined(DAVA_PARTICLE_BLOCK_SIMD)
+    using namespace ParticleBlockDetails;
+
+    Float4 dt4 = Splat4(dt);
+    for (; i + 4 <= count; i += 4)
+    {
+        Float4 x = Load4(&positionX[i]);
+        Float4 y = Load4(&positionY[i]);
+        Float4 z = Load4(&positionZ[i]);
+        if (storePrevious)
+        {
+            Store4(prevX + i, x);
+            Store4(prevY + i, y);
+            Store4(prevZ + i, z);
+        }
+
+        Float4 scale = Mul4(Load4(velocityScale + i), dt4);
+        Store4(&positionX[i], Add4(x, Mul4(Load4(&speedX[i]), scale)));
+        Store4(&positionY[i], Add4(y, Mul4(Load4(&speedY[i]), scale)));
+        Store4(&positionZ[i], Add4(z, Mul4(Load4(&speedZ[i]), scale)));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        if (storePrevious)
+        {
+            prevX[i] = positionX[i];
+            prevY[i] = positionY[i];
+            prevZ[i] = positionZ[i];
+        }
+
+        float32 scale = velocityScale[i] * dt;
+        positionX[i] += speedX[i] * scale;
+        positionY[i] += speedY[i] * scale;
+        positionZ[i] += speedZ[i] * scale;
+    }
+}
+
+void ParticleBlock::IntegrateSpeeds(float32 dt, const float32* accelerationX, const float32* accelerationY, const float32* accelerationZ)
+{
+    uint32 count = GetSize();
+    uint32 i = 0;
+
+#if defined(DAVA_PARTICLE_BLOCK_SIMD)
+    using namespace ParticleBlockDetails;
+
+    Float4 dt4 = Splat4(dt);
+    for (; i + 4 <= count; i += 4)
+    {
+        Store4(&speedX[i], Add4(Load4(&speedX[i]), Mul4(Load4(accelerationX + i), dt4)));
+        Store4(&speedY[i], Add4(Load4(&speedY[i]), Mul4(Load4(accelerationY + i), dt4)));
+        Store4(&speedZ[i], Add4(Load4(&speedZ[i]), Mul4(Load4(accelerationZ + i), dt4)));
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        speedX[i] += accelerationX[i] * dt;
+        speedY[i] += accelerationY[i] * dt;
+        speedZ[i] += accelerationZ[i] * dt;
+    }
+}
+
+void ParticleBlock::AddToBBox(const Vector3& offset, AABBox3& bbox) const
+{
+    uint32 count = GetSize();
+    if (count == 0)
+        return;
+
+    Vector3 minPoint = bbox.min;
+    Vector3 maxPoint = bbox.max;
+    uint32 i = 0;
+
+#if defined(DAVA_PARTICLE_BLOCK_SIMD)
+    using namespace ParticleBlockDetails;
+
+    if (count >= 4)
+    {
+        Float4 offsetX = Splat4(offset.x);
+        Float4 offsetY = Splat4(offset.y);
+        Float4 offsetZ = Splat4(offset.z);
+        Float4 minX = Splat4(minPoint.x);
+        Float4 minY = Splat4(minPoint.y);
+        Float4 minZ = Splat4(minPoint.z);
+        Float4 maxX = Splat4(maxPoint.x);
+        Float4 maxY = Splat4(maxPoint.y);
+        Float4 maxZ = Splat4(maxPoint.z);
+        for (; i + 4 <= count; i += 4)
+        {
+            Float4 radius = Load4(&currRadius[i]);
+            Float4 x = Add4(Load4(&positionX[i]), offsetX);
+            Float4 y = Add4(Load4(&positionY[i]), offsetY);
+            Float4 z = Add4(Load4(&positionZ[i]), offsetZ);
+            minX = Min4(minX, Sub4(x, radius));
+            minY = Min4(minY, Sub4(y, radius));
+            minZ = Min4(minZ, Sub4(z, radius));
+            maxX = Max4(maxX, Add4(x, radius));
+            maxY = Max4(maxY, Add4(y, radius));
+            maxZ = Max4(maxZ, Add4(z, radius));
+        }
+
+        float32 lanes[6][4];
+        Store4(lanes[0], minX);
+        Store4(lanes[1], minY);
+        Store4(lanes[2], minZ);
+        Store4(lanes[3], maxX);
+        Store4(lanes[4], maxY);
+        Store4(lanes[5], maxZ);
+        for (uint32 k = 0; k < 4; ++k)
+        {
+            minPoint.x = Min(minPoint.x, lanes[0][k]);
+            minPoint.y = Min(minPoint.y, lanes[1][k]);
+            minPoint.z = Min(minPoint.z, lanes[2][k]);
+            maxPoint.x = Max(maxPoint.x, lanes[3][k]);
+            maxPoint.y = Max(maxPoint.y, lanes[4][k]);
+            maxPoint.z = Max(maxPoint.z, lanes[5][k]);
+        }
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        float32 radius = currRadius[i];
+        Vector3 position = GetPosition(i) + offset;
+        minPoint.x = Min(minPoint.x, position.x - radius);
+        minPoint.y = Min(minPoint.y, position.y - radius);
+        minPoint.z = Min(minPoint.z, position.z - radius);
+        maxPoint.x = Max(maxPoint.x, position.x + radius);
+        maxPoint.y = Max(maxPoint.y, position.y + radius);
+        maxPoint.z = Max(maxPoint.z, position.z + radius);
+    }
+
+    bbox.min = minPoint;
+    bbox.max = maxPoint;
+}
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/BaseMath.h"
+#include "Math/AABBox3.h"
+#include "Math/Color.h"
+
+namespace DAVA
+{
+/**
+    Per-particle data which is rarely updated during simulation: sprite animation, flow and noise parameters.
+    Stored as array of structures alongside of hot arrays of `ParticleBlock`.
+*/
+struct ParticleAttributes
+{
+    int32 frame = 0;
+    float32 animTime = 0.0f;
+
+    float32 baseFlowSpeed = 0.0f;
+    float32 currFlowSpeed = 0.0f;
+    float32 baseFlowOffset = 0.0f;
+    float32 currFlowOffset = 0.0f;
+
+    float32 baseNoiseScale = 0.0f;
+    float32 currNoiseScale = 0.0f;
+    float32 baseNoiseUScrollSpeed = 0.0f;
+    float32 currNoiseUOffset = 0.0f;
+    float32 baseNoiseVScrollSpeed = 0.0f;
+    float32 currNoiseVOffset = 0.0f;
+
+    float32 alphaRemap = 0.0f;
+
+    int32 positionTarget = 0; //superemitter particles only
+    uint32 randomSeed = 0; //stable per-particle value for forces noise, particle index changes on removal
+};
+
+/**
+    Particles of one `ParticleGroup` stored as structure-of-arrays.
+
+    Data touched by every particle every frame (position, speed, life, size, color) lives in contiguous arrays,
+    so simulation passes run over all particles of group at once and integration of positions, speeds and
+    bounding box accumulation are processed four particles at a time with SIMD.
+
+    Dead particle is removed by moving the last particle to its place, so index of particle is valid only until
+    next `Remove` call and order of particles is not preserved.
+*/
+class ParticleBlock
+{
+public:
+    uint32 GetSize() const;
+    bool IsEmpty() const;
+
+    /** Add particle with default values and return its index. */
+    uint32 Add();
+
+    /** Remove particle at `index` by moving the last particle to its place. */
+    void Remove(uint32 index);
+
+    /** Keep first `size` particles and remove others. */
+    void Shrink(uint32 size);
+
+    void Clear();
+
+    Vector3 GetPosition(uint32 index) const;
+    void SetPosition(uint32 index, const Vector3& position);
+
+    Vector3 GetSpeed(uint32 index) const;
+    void SetSpeed(uint32 index, const Vector3& speed);
+
+    float32 GetOverLife(uint32 index) const;
+
+    /** Add `dt` to life of every particle and remove particles which life is over. */
+    void UpdateLife(float32 dt);
+
+    /**
+        Move particles by their speed: position += speed * velocityScale[i] * dt.
+        If `prevX`, `prevY` and `prevZ` are not null, positions before integration are written to them.
+    */
+    void IntegratePositions(float32 dt, const float32* velocityScale, float32* prevX, float32* prevY, float32* prevZ);
+
+    /** Add acceleration to speed of every particle: speed += acceleration[i] * dt. */
+    void IntegrateSpeeds(float32 dt, const float32* accelerationX, const float32* accelerationY, const float32* accelerationZ);
+
+    /** Add every particle as cube with half size `currRadius` shifted by `offset` to `bbox`. */
+    void AddToBBox(const Vector3& offset, AABBox3& bbox) const;
+
+    Vector<float32> positionX;
+    Vector<float32> positionY;
+    Vector<float32> positionZ;
+    Vector<float32> speedX;
+    Vector<float32> speedY;
+    Vector<float32> speedZ;
+
+    Vector<float32> life;
+    Vector<float32> lifeTime;
+
+    Vector<float32> angle;
+    Vector<float32> spin;
+
+    Vector<float32> currRadius; //for bbox computation
+    Vector<Vector2> baseSize;
+    Vector<Vector2> currSize;
+
+    Vector<Color> color;
+
+    Vector<ParticleAttributes> attributes;
+};
+
+inline uint32 ParticleBlock::GetSize() const
+{
+    return static_cast<uint32>(life.size());
+}
+
+inline bool ParticleBlock::IsEmpty() const
+{
+    return life.empty();
+}
+
+inline Vector3 ParticleBlock::GetPosition(uint32 index) const
+{
+    return Vector3(positionX[index], positionY[index], positionZ[index]);
+}
+
+inline void ParticleBlock::SetPosition(uint32 index, const Vector3& position)
+{
+    positionX[index] = position.x;
+    positionY[index] = position.y;
+    positionZ[index] = position.z;
+}
+
+inline Vector3 ParticleBlock::GetSpeed(uint32 index) const
+{
+    return Vector3(speedX[index], speedY[index], speedZ[index]);
+}
+
+inline void ParticleBlock::SetSpeed(uint32 index, const Vector3& speed)
+{
+    speedX[index] = speed.x;
+    speedY[index] = speed.y;
+    speedZ[index] = speed.z;
+}
+
+inline float32 ParticleBlock::GetOverLife(uint32 index) const
+{
+    return life[index] / lifeTime[index];
+}
+}
@@ -3,7 +3,7 @@
 #include <random>
 #include <chrono>
 
-#include "Particles/Particle.h"
+#include "Particles/ParticleBlock.h"
 #include "Particles/ParticleForce.h"
 #include "Math/MathHelpers.h"
 #include "Math/Noise.h"
@@ -56,15 +56,15 @@ Vector3 GetNoiseValue(float32 particleOverLife, float32 frequency, uint32 clampe
     return Lerp(t1, t2, fractPart);
 }
 
-inline void KillParticle(Particle* particle)
+inline void KillParticle(ParticleBlock* particles, uint32 particleIndex)
 {
-    particle->life = particle->lifeTime + 0.1f;
+    particles->life[particleIndex] = particles->lifeTime[particleIndex] + 0.1f;
 }
 
-inline void KillParticlePlaneCollision(const ParticleForce* force, Particle* particle, Vector3& effectSpaceVelocity)
+inline void KillParticlePlaneCollision(const ParticleForce* force, ParticleBlock* particles, uint32 particleIndex, Vector3& effectSpaceVelocity)
 {
     if (force->killParticles)
-        KillParticle(particle);
+        KillParticle(particles, particleIndex);
     else
         effectSpaceVelocity = Vector3::Zero;
 }
@@ -88,14 +88,14 @@ inline bool IsPositionInForceShape(const ParticleForce* force, const Vector3& pa
     return false;
 }
 
-void ApplyDragForce(const ParticleForce* force, Vector3& velocity, const Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const Particle* particle, const Vector3& forcePosition)
+void ApplyDragForce(const ParticleForce* force, Vector3& velocity, const Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const ParticleBlock* particles, uint32 particleIndex, const Vector3& forcePosition)
 {
-    Vector3 forceStrength = GetValue(force, particleOverLife, layerOverLife, particle->life, force->forcePowerLine.Get(), force->forcePower) * dt;
+    Vector3 forceStrength = GetValue(force, particleOverLife, layerOverLife, particles->life[particleIndex], force->forcePowerLine.Get(), force->forcePower) * dt;
     Vector3 v(Max(Vector3::Zero, 1.0f - forceStrength));
     velocity *= v;
 }
 
-void ApplyVortex(const ParticleForce* force, Vector3& velocity, const Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const Particle* particle, const Vector3& forcePosition)
+void ApplyVortex(const ParticleForce* force, Vector3& velocity, const Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const ParticleBlock* particles, uint32 particleIndex, const Vector3& forcePosition)
 {
     Vector3 forceDir = (position - forcePosition).CrossProduct(force->direction);
     float32 len = forceDir.SquareLength();
@@ -104,26 +104,24 @@ void ApplyVortex(const ParticleForce* force, Vector3& velocity, const Vector3& p
         float32 d = 1.0f / std::sqrt(len);
         forceDir *= d;
     }
-    Vector3 forceStrength = GetValue(force, particleOverLife, layerOverLife, particle->life, force->forcePowerLine.Get(), force->forcePower) * dt;
+    Vector3 forceStrength = GetValue(force, particleOverLife, layerOverLife, particles->life[particleIndex], force->forcePowerLine.Get(), force->forcePower) * dt;
     velocity += forceStrength * forceDir;
 }
 
-void ApplyGravity(const ParticleForce* force, Vector3& velocity, const Vector3& down, float32 dt, float32 particleOverLife, float32 layerOverLife, const Particle* particle)
+void ApplyGravity(const ParticleForce* force, Vector3& velocity, const Vector3& down, float32 dt, float32 particleOverLife, float32 layerOverLife, const ParticleBlock* particles, uint32 particleIndex)
 {
-    velocity += down * GetValue(force, particleOverLife, layerOverLife, particle->life, force->forcePowerLine.Get(), force->forcePower).x * dt;
+    velocity += down * GetValue(force, particleOverLife, layerOverLife, particles->life[particleIndex], force->forcePowerLine.Get(), force->forcePower).x * dt;
 }
 
-void ApplyWind(const ParticleForce* force, Vector3& velocity, Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const Particle* particle, const Vector3& forcePosition)
+void ApplyWind(const ParticleForce* force, Vector3& velocity, Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const ParticleBlock* particles, uint32 particleIndex, const Vector3& forcePosition)
 {
     static const float32 windScale = 100.0f; // Artiom request.
 
-    uintptr_t partInd = reinterpret_cast<uintptr_t>(particle);
-    uint64 particleIndex = static_cast<uint64>(partInd);
     Vector3 turbulence;
 
-    uint32 clampedIndex = particleIndex % noiseWidth;
+    uint32 clampedIndex = particles->attributes[particleIndex].randomSeed % noiseWidth;
     float32 windMultiplier = 1.0f;
-    float32 tubulencePower = GetValue(force, particleOverLife, layerOverLife, particle->life, force->turbulenceLine.Get(), force->windTurbulence);
+    float32 tubulencePower = GetValue(force, particleOverLife, layerOverLife, particles->life[particleIndex], force->turbulenceLine.Get(), force->windTurbulence);
     if (Abs(tubulencePower) > EPSILON)
     {
         turbulence = GetNoiseValue(particleOverLife, force->windTurbulenceFrequency, clampedIndex);
@@ -141,11 +139,11 @@ void ApplyWind(const ParticleForce* force, Vector3& velocity, Vector3& position,
         float32 noiseVal = GetNoiseValue(particleOverLife, force->windFrequency, clampedIndex).x;
         windMultiplier = noiseVal + force->windBias;
     }
-    Vector3 forceStrength = GetValue(force, particleOverLife, layerOverLife, particle->life, force->forcePowerLine.Get(), force->forcePower) * dt;
+    Vector3 forceStrength = GetValue(force, particleOverLife, layerOverLife, particles->life[particleIndex], force->forcePowerLine.Get(), force->forcePower) * dt;
     velocity += force->direction * dt * windMultiplier * forceStrength.x * windScale;
 }
 
-void ApplyPointGravity(const ParticleForce* force, Vector3& velocity, Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, Particle* particle, const Vector3& forcePosition)
+void ApplyPointGravity(const ParticleForce* force, Vector3& velocity, Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, ParticleBlock* particles, uint32 particleIndex, const Vector3& forcePosition)
 {
     Vector3 toCenter = forcePosition - position;
     float32 sqrToCenterDist = toCenter.SquareLength();
@@ -155,29 +153,27 @@ void ApplyPointGravity(const ParticleForce* force, Vector3& velocity, Vector3& p
     Vector3 forceDirection = toCenter;
     if (force->pointGravityUseRandomPointsOnSphere)
     {
-        uintptr_t partInd = reinterpret_cast<uintptr_t>(particle);
-        size_t particleIndex = static_cast<size_t>(partInd);
-        particleIndex %= sphereRandomVectorsSize;
-        Vector3 forcePositionModified = forcePosition + sphereRandomVectors[particleIndex] * force->pointGravityRadius;
+        uint32 randomIndex = particles->attributes[particleIndex].randomSeed % sphereRandomVectorsSize;
+        Vector3 forcePositionModified = forcePosition + sphereRandomVectors[randomIndex] * force->pointGravityRadius;
         forceDirection = forcePositionModified - position;
         float32 sqrDistToTarget = forceDirection.SquareLength();
         if (sqrDistToTarget > 0)
             forceDirection /= sqrt(sqrDistToTarget);
     }
 
-    Vector3 forceStrength = GetValue(force, particleOverLife, layerOverLife, particle->life, force->forcePowerLine.Get(), force->forcePower) * dt;
+    Vector3 forceStrength = GetValue(force, particleOverLife, layerOverLife, particles->life[particleIndex], force->forcePowerLine.Get(), force->forcePower) * dt;
     if (sqrToCenterDist > force->pointGravityRadius * force->pointGravityRadius)
         velocity += forceDirection * forceStrength;
     else
     {
         if (force->killParticles)
-            KillParticle(particle);
+            KillParticle(particles, particleIndex);
         else
             position = forcePosition - force->pointGravityRadius * toCenter;
     }
 }
 
-void ApplyPlaneCollision(const ParticleForce* force, Vector3& velocity, Vector3& position, Particle* particle, const Vector3& prevPosition, const Vector3& forcePosition)
+void ApplyPlaneCollision(const ParticleForce* force, Vector3& velocity, Vector3& position, ParticleBlock* particles, uint32 particleIndex, const Vector3& prevPosition, const Vector3& forcePosition)
 {
     Vector3 normal = Normalize(force->direction);
     Vector3 a = prevPosition - forcePosition;
@@ -188,7 +184,7 @@ void ApplyPlaneCollision(const ParticleForce* force, Vector3& velocity, Vector3&
     {
         if (velocity.SquareLength() < force->velocityThreshold * force->velocityThreshold)
         {
-            KillParticlePlaneCollision(force, particle, velocity);
+            KillParticlePlaneCollision(force, particles, particleIndex, velocity);
             return;
         }
 
@@ -222,14 +218,14 @@ void ApplyPlaneCollision(const ParticleForce* force, Vector3& velocity, Vector3&
                 velocity *= std::uniform_real_distribution<float32>(force->rndReflectionForceMin, force->rndReflectionForceMax)(rng);
         }
         else
-            KillParticlePlaneCollision(force, particle, velocity);
+            KillParticlePlaneCollision(force, particles, particleIndex, velocity);
     }
     else if (bProj < 0.0f && aProj < 0.0f)
-        KillParticlePlaneCollision(force, particle, velocity);
+        KillParticlePlaneCollision(force, particles, particleIndex, velocity);
 }
 }
 
-void ParticleForces::ApplyForce(const ParticleForce* force, Vector3& velocity, Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const Vector3& down, Particle* particle, const Vector3& prevPosition, const Vector3& forcePosition)
+void ParticleForces::ApplyForce(const ParticleForce* force, Vector3& velocity, Vector3& position, float32 dt, float32 particleOverLife, float32 layerOverLife, const Vector3& down, ParticleBlock* particles, uint32 particleIndex, const Vector3& prevPosition, const Vector3& forcePosition)
 {
     using ForceType = ParticleForce::eType;
 
@@ -238,22 +234,22 @@ void ParticleForces::ApplyForce(const ParticleForce* force, Vector3& velocity, V
     switch (force->type)
     {
     case ForceType::DRAG_FORCE:
-        ParticleForcesDetails::ApplyDragForce(force, velocity, position, dt, particleOverLife, layerOverLife, particle, forcePosition);
+        ParticleForcesDetails::ApplyDragForce(force, velocity, position, dt, particleOverLife, layerOverLife, particles, particleIndex, forcePosition);
         break;
     case ForceType::VORTEX:
-        ParticleForcesDetails::ApplyVortex(force, velocity, position, dt, particleOverLife, layerOverLife, particle, forcePosition);
+        ParticleForcesDetails::ApplyVortex(force, velocity, position, dt, particleOverLife, layerOverLife, particles, particleIndex, forcePosition);
         break;
     case ForceType::GRAVITY:
-        ParticleForcesDetails::ApplyGravity(force, velocity, down, dt, particleOverLife, layerOverLife, particle);
+        ParticleForcesDetails::ApplyGravity(force, velocity, down, dt, particleOverLife, layerOverLife, particles, particleIndex);
         break;
     case ForceType::WIND:
-        ParticleForcesDetails::ApplyWind(force, velocity, position, dt, particleOverLife, layerOverLife, particle, forcePosition);
+        ParticleForcesDetails::ApplyWind(force, velocity, position, dt, particleOverLife, layerOverLife, particles, particleIndex, forcePosition);
         break;
     case ForceType::POINT_GRAVITY:
-        ParticleForcesDetails::ApplyPointGravity(force, velocity, position, dt, particleOverLife, layerOverLife, particle, forcePosition);
+        ParticleForcesDetails::ApplyPointGravity(force, velocity, position, dt, particleOverLife, layerOverLife, particles, particleIndex, forcePosition);
         break;
     case ForceType::PLANE_COLLISION:
-        ParticleForcesDetails::ApplyPlaneCollision(force, velocity, position, particle, prevPosition, forcePosition);
+        ParticleForcesDetails::ApplyPlaneCollision(force, velocity, position, particles, particleIndex, prevPosition, forcePosition);
         break;
     default:
         DVASSERT(false, "Unsupported force.");
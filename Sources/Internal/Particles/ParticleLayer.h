@@ -6,7 +6,7 @@
 #include "Render/2D/Sprite.h"
 
 #include "FileSystem/YamlParser.h"
-#include "Particles/Particle.h"
+#include "Particles/ParticleBlock.h"
 #include "Particles/ParticleForceSimplified.h"
 #include "Particles/ParticlePropertyLine.h"
 #include "FileSystem/FilePath.h"
@@ -29,7 +29,8 @@ public:
         return keys;
     }
 
-    virtual const T& GetValue(float32 t) = 0;
+    // property lines are shared by effects updated in parallel, so value is returned by copy and line isn't modified
+    virtual T GetValue(float32 t) = 0;
 
     virtual PropertyLine<T>* Clone()
     {
@@ -61,7 +62,7 @@ public:
         PropertyLine<T>::keys.push_back(v);
     }
 
-    const T& GetValue(float32 /*t*/)
+    T GetValue(float32 /*t*/)
     {
         return PropertyLine<T>::keys[0].value;
     }
@@ -81,9 +82,7 @@ protected:
     }
 
 public:
-    T resultValue;
-
-    const T& GetValue(float32 t)
+    T GetValue(float32 t)
     {
         int32 keysSize = static_cast<int32>(PropertyLine<T>::keys.size());
         DVASSERT(keysSize);
@@ -100,8 +99,7 @@ public:
             if (t < PropertyLine<T>::keys[1].t)
             {
                 float ti = (t - PropertyLine<T>::keys[0].t) / (PropertyLine<T>::keys[1].t - PropertyLine<T>::keys[0].t);
-                resultValue = PropertyLine<T>::keys[0].value + (PropertyLine<T>::keys[1].value - PropertyLine<T>::keys[0].value) * ti;
-                return resultValue;
+                return PropertyLine<T>::keys[0].value + (PropertyLine<T>::keys[1].value - PropertyLine<T>::keys[0].value) * ti;
             }
             else
             {
@@ -115,9 +113,8 @@ public:
             int32 l = BinaryFind(t, 0, static_cast<int32>(PropertyLine<T>::keys.size()) - 1);
 
             float ti = (t - PropertyLine<T>::keys[l].t) / (PropertyLine<T>::keys[l + 1].t - PropertyLine<T>::keys[l].t);
-            resultValue = PropertyLine<T>::keys[l].value + (PropertyLine<T>::keys[l + 1].value - PropertyLine<T>::keys[l].value) * ti;
+            return PropertyLine<T>::keys[l].value + (PropertyLine<T>::keys[l + 1].value - PropertyLine<T>::keys[l].value) * ti;
         }
-        return resultValue;
     }
 
     int32 BinaryFind(float32 t, int32 l, int32 r)
@@ -198,11 +195,10 @@ public:
     {
         return valueLine;
     }
-    const T& GetValue(float32 t);
+    T GetValue(float32 t);
     virtual PropertyLine<T>* Clone();
 
 protected:
-    T resultValue; //well - this how ProertyLine itself work - err
     T modifier;
     RefPtr<PropertyLine<T>> modificationLine;
     RefPtr<PropertyLine<T>> valueLine;
@@ -218,17 +214,13 @@ void ModifiablePropertyLine<T>::SetModifier(float32 v)
 }
 
 template <class T>
-const T& ModifiablePropertyLine<T>::GetValue(float32 t)
+T ModifiablePropertyLine<T>::GetValue(float32 t)
 {
     if (!valueLine)
     {
-        resultValue = T();
-    }
-    else
-    {
-        resultValue = modifier * (valueLine->GetValue(t));
+        return T();
     }
-    return resultValue;
+    return modifier * (valueLine->GetValue(t));
 }
 
 template <class T>
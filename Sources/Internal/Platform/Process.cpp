@@ -5,6 +5,7 @@
 #if defined(__DAVAENGINE_WIN32__) || defined(__DAVAENGINE_MACOS__)
 
 #if defined(__DAVAENGINE_MACOS__)
+#include <fcntl.h>
 #include <sys/wait.h>
 #include <unistd.h>
 #endif
@@ -303,6 +304,11 @@ bool Process::Run(bool showWindow)
         return result;
     }
 
+    // processes can be started from several threads at once, so pipes shouldn't leak into children of other threads
+    // (stdout and stderr duplicated in child don't inherit this flag)
+    fcntl(pipes[READ], F_SETFD, FD_CLOEXEC);
+    fcntl(pipes[WRITE], F_SETFD, FD_CLOEXEC);
+
     Vector<char*> execArgs;
 
     String execPath = executablePath.GetAbsolutePathname();
@@ -363,13 +369,14 @@ void Process::Wait()
         return;
     running = false;
 
+    // wait for own child only, other threads can wait for their processes meanwhile
     int status = 0;
     int64 pd = -1;
     do
     {
         status = 0;
-        pd = wait(&status);
-    } while (pd != pid && pd != -1);
+        pd = waitpid(pid, &status, 0);
+    } while (pd == -1 && errno == EINTR);
 
     exitCode = WEXITSTATUS(status);
     if (WIFEXITED(status) == 0)
@@ -2,6 +2,7 @@
 #include "Render/Renderer.h"
 #include "Render/2D/FTFont.h"
 #include "Render/2D/FontManager.h"
+#include "Render/2D/GlyphAtlas.h"
 #include "Logger/Logger.h"
 #include "Utils/UTF8Utils.h"
 #include "Debug/DVAssert.h"
@@ -39,7 +40,9 @@ public:
                                    int32 justifyWidth, int32 spaceAddon,
                                    float32 ascendScale, float32 descendScale,
                                    Vector<float32>* charSizes = NULL,
-                                   bool contentScaleIncluded = false);
+                                   bool contentScaleIncluded = false,
+                                   GlyphAtlas* atlas = nullptr,
+                                   Vector<FTFont::GlyphQuad>* quads = nullptr);
     uint32 GetFontHeight(float32 size, float32 ascendScale, float32 descendScale);
     bool IsCharAvaliable(char16 ch);
 
@@ -69,6 +72,7 @@ private:
     void ClearString();
     int32 LoadString(float32 size, const WideString& str);
     void Prepare(FT_Face face, FT_Vector* advances);
+    const GlyphAtlas::Glyph* LookupAtlasGlyph(GlyphAtlas* atlas, const Glyph& glyph, float32 size, int32 width, int32 height);
 
     inline int32 FtRound(int32 val);
     inline int32 FtCeil(int32 val);
@@ -185,6 +189,12 @@ Font::StringMetrics FTFont::DrawStringToBuffer(void* buffer, int32 bufWidth, int
     return internalFont->DrawString(str, buffer, bufWidth, bufHeight, 255, 255, 255, 255, size, true, offsetX, offsetY, justifyWidth, spaceAddon, ascendScale, descendScale, NULL, contentScaleIncluded);
 }
 
+Font::StringMetrics FTFont::DrawStringToAtlas(GlyphAtlas* atlas, Vector<GlyphQuad>& quads, int32 offsetX, int32 offsetY, int32 justifyWidth, int32 spaceAddon, const WideString& str, bool contentScaleIncluded)
+{
+    DVASSERT(atlas != nullptr);
+    return internalFont->DrawString(str, nullptr, 0, 0, 255, 255, 255, 255, size, true, offsetX, offsetY, justifyWidth, spaceAddon, ascendScale, descendScale, NULL, contentScaleIncluded, atlas, &quads);
+}
+
 Font::StringMetrics FTFont::GetStringMetrics(const WideString& str, Vector<float32>* charSizes) const
 {
     if (charSizes != nullptr)
@@ -275,6 +285,7 @@ FTInternalFont::FTInternalFont(const FilePath& path)
 FTInternalFont::~FTInternalFont()
 {
     ClearString();
+    FontManager::Instance()->GetGlyphAtlas()->RemoveGlyphs(this);
     ftm->RemoveFace(this);
 }
 
@@ -334,7 +345,9 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
                                                int32 justifyWidth, int32 spaceAddon,
                                                float32 ascendScale, float32 descendScale,
                                                Vector<float32>* charSizes,
-                                               bool contentScaleIncluded)
+                                               bool contentScaleIncluded,
+                                               GlyphAtlas* atlas,
+                                               Vector<FTFont::GlyphQuad>* quads)
 {
     if (!initialized)
     {
@@ -429,7 +442,7 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
                 if (error == 0)
                 {
                     FT_Glyph_Get_CBox(image, FT_GLYPH_BBOX_PIXELS, &bbox);
-                    if (realDraw)
+                    if (realDraw && atlas == nullptr)
                     {
                         error = FT_Glyph_To_Bitmap(&image, FT_RENDER_MODE_NORMAL, 0, 1);
                     }
@@ -481,7 +494,24 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
                 metrics.drawRect.dy = Max(metrics.drawRect.dy, top + height);
             }
 
-            if (realDraw && bbox.xMin < bufWidth && bbox.yMin < bufHeight)
+            if (realDraw && atlas != nullptr)
+            {
+                const GlyphAtlas::Glyph* atlasGlyph = LookupAtlasGlyph(atlas, glyph, size, width, height);
+                if (atlasGlyph != nullptr && atlasGlyph->rect.dx > 0)
+                {
+                    // glyphs in atlas are rasterized at integer pen position
+                    int32 penX = FtRound(int32(pen.x)) >> ftToPixelShift;
+                    int32 penY = FtRound(int32(pen.y)) >> ftToPixelShift;
+
+                    FTFont::GlyphQuad quad;
+                    quad.rect = Rect2i(penX + atlasGlyph->left, multilineOffsetY - penY - atlasGlyph->top, atlasGlyph->rect.dx, atlasGlyph->rect.dy);
+                    quad.atlasRect = atlasGlyph->rect;
+                    quad.page = atlasGlyph->page;
+                    quad.generation = atlas->GetPageGeneration(atlasGlyph->page);
+                    quads->push_back(quad);
+                }
+            }
+            else if (realDraw && bbox.xMin < bufWidth && bbox.yMin < bufHeight)
             {
                 FT_BitmapGlyph bit = FT_BitmapGlyph(image);
                 FT_Bitmap* bitmap = &bit->bitmap;
@@ -652,6 +682,60 @@ void FTInternalFont::Prepare(FT_Face face, FT_Vector* advances)
     }
 }
 
+const GlyphAtlas::Glyph* FTInternalFont::LookupAtlasGlyph(GlyphAtlas* atlas, const Glyph& glyph, float32 size, int32 width, int32 height)
+{
+    GlyphAtlas::Key key;
+    key.face = this;
+    key.size = uint32(size * (1 << ftToPixelShift) + 0.5f);
+    key.glyphIndex = glyph.index;
+
+    const GlyphAtlas::Glyph* atlasGlyph = atlas->FindGlyph(key);
+    if (atlasGlyph != nullptr)
+    {
+        return atlasGlyph;
+    }
+
+    if (glyph.index == 0)
+    {
+        if (width <= 0 || height <= 0)
+        {
+            return nullptr;
+        }
+
+        // frame for undefined glyph, same as in DrawString
+        Vector<uint8> frame(width * height, 0);
+        for (int32 h = 0; h < height; h++)
+        {
+            for (int32 w = 0; w < width; w++)
+            {
+                if (w == 0 || w == width - 1 || h == 0 || h == height - 1)
+                    frame[h * width + w] = 255;
+            }
+        }
+        return atlas->AddGlyph(key, frame.data(), width, height, width, 0, height);
+    }
+
+    FT_Glyph image = nullptr;
+    if (FT_Glyph_Copy(glyph.image, &image) == 0)
+    {
+        if (FT_Glyph_To_Bitmap(&image, FT_RENDER_MODE_NORMAL, 0, 1) == 0)
+        {
+            FT_BitmapGlyph bit = FT_BitmapGlyph(image);
+            FT_Bitmap* bitmap = &bit->bitmap;
+
+            // negative pitch means that rows are stored from bottom to top
+            const uint8* topRow = bitmap->buffer;
+            if (bitmap->pitch < 0)
+            {
+                topRow -= bitmap->pitch * (int32(bitmap->rows) - 1);
+            }
+            atlasGlyph = atlas->AddGlyph(key, topRow, bitmap->width, bitmap->rows, bitmap->pitch, bit->left, bit->top);
+        }
+        FT_Done_Glyph(image);
+    }
+    return atlasGlyph;
+}
+
 void FTInternalFont::ClearString()
 {
     glyphs.clear();
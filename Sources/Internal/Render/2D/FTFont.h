@@ -12,6 +12,7 @@ namespace DAVA
 {
 class FontManager;
 class FTInternalFont;
+class GlyphAtlas;
 
 /** 
 	\ingroup fonts
@@ -22,6 +23,15 @@ class FTInternalFont;
 class FTFont : public Font
 {
 public:
+    /** Glyph placed by `DrawStringToAtlas`. */
+    struct GlyphQuad
+    {
+        Rect2i rect; //!< glyph rect in pixels of buffer which would be used by `DrawStringToBuffer`
+        Rect2i atlasRect; //!< glyph rect on atlas page in pixels
+        uint32 page = 0;
+        uint32 generation = 0; //!< generation of atlas page at the moment glyph was placed
+    };
+
     /**
 		\brief Factory method.
 		\param[in] path - path to freetype-supported file (.ttf, .otf)
@@ -82,6 +92,14 @@ public:
 	*/
     virtual StringMetrics DrawStringToBuffer(void* buffer, int32 bufWidth, int32 bufHeight, int32 offsetX, int32 offsetY, int32 justifyWidth, int32 spaceAddon, const WideString& str, bool contentScaleIncluded = false);
 
+    /**
+		\brief Layout string same way as `DrawStringToBuffer` does, but put glyphs into shared `atlas` instead of drawing them
+		\param[in] atlas - glyph cache, missing glyphs are rasterized into it
+		\param[out] quads - placed glyphs are appended to it, glyphs without pixels are skipped
+		\returns bounding rect for string in pixels
+	*/
+    StringMetrics DrawStringToAtlas(GlyphAtlas* atlas, Vector<GlyphQuad>& quads, int32 offsetX, int32 offsetY, int32 justifyWidth, int32 spaceAddon, const WideString& str, bool contentScaleIncluded = false);
+
     bool IsTextSupportsSoftwareRendering() const override
     {
         return true;
@@ -2,6 +2,7 @@
 #include "FileSystem/KeyedArchive.h"
 #include "Render/2D/FontManager.h"
 #include "Render/2D/FTFont.h"
+#include "Render/2D/GlyphAtlas.h"
 #include "Render/2D/Private/FTManager.h"
 #include "Logger/Logger.h"
 #include "Render/2D/Sprite.h"
@@ -13,6 +14,7 @@ namespace DAVA
 {
 FontManager::FontManager()
     : ftmanager(std::make_unique<FTManager>())
+    , glyphAtlas(std::make_unique<GlyphAtlas>())
 {
 }
 
@@ -8,6 +8,7 @@ namespace DAVA
 {
 class Font;
 class FTManager;
+class GlyphAtlas;
 
 class FontManager : public Singleton<FontManager>
 {
@@ -20,6 +21,14 @@ public:
         return ftmanager.get();
     }
 
+    /**
+	 \brief Get glyph cache shared by all FreeType fonts.
+	 */
+    GlyphAtlas* GetGlyphAtlas()
+    {
+        return glyphAtlas.get();
+    }
+
     /**
 	 \brief Register font.
 	 */
@@ -69,6 +78,7 @@ private:
     Map<Font*, String> registeredFonts;
     Map<String, Font*> fontMap;
     std::unique_ptr<FTManager> ftmanager;
+    std::unique_ptr<GlyphAtlas> glyphAtlas;
 };
 };
 
@@ -0,0 +1,316 @@
+#include "Render/2D/GlyphAtlas.h"
+#include "Debug/DVAssert.h"
+#include "Engine/Engine.h"
+#include "Render/RHI/rhi_Public.h"
+#include "Render/Texture.h"
+
+namespace DAVA
+{
+namespace GlyphAtlasDetails
+{
+const int32 GLYPH_PADDING = 1; // empty pixels between glyphs to avoid bleeding on linear filtering
+const int32 SHELF_HEIGHT_TOLERANCE = 4; // glyph is placed on shelf which is not higher than glyph + tolerance
+}
+
+size_t GlyphAtlas::KeyHash::operator()(const Key& key) const
+{
+    size_t hash = std::hash<const void*>()(key.face);
+    hash ^= std::hash<uint32>()(key.size) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<uint32>()(key.glyphIndex) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+GlyphAtlas::GlyphAtlas(uint32 pageSize_, uint32 maxPagesCount_)
+    : pageSize(pageSize_)
+    , maxPagesCount(maxPagesCount_)
+{
+    DVASSERT(pageSize > 0 && maxPagesCount > 0);
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+    for (Page& page : pages)
+    {
+        SafeRelease(page.texture);
+    }
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::FindGlyph(const Key& key)
+{
+    TrimPages();
+
+    auto found = glyphs.find(key);
+    if (found == glyphs.end())
+    {
+        return nullptr;
+    }
+
+    if (found->second.rect.dx > 0)
+    {
+        TouchPage(found->second.page);
+    }
+    return &found->second;
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::AddGlyph(const Key& key, const uint8* bitmap, uint32 width, uint32 height, int32 pitch, int32 left, int32 top)
+{
+    using namespace GlyphAtlasDetails;
+
+    DVASSERT(glyphs.find(key) == glyphs.end());
+    TrimPages();
+
+    Glyph glyph;
+    glyph.left = left;
+    glyph.top = top;
+
+    if (width == 0 || height == 0)
+    {
+        // glyph without pixels (e.g. space) doesn't occupy atlas space
+        glyph.rect = Rect2i(0, 0, 0, 0);
+        return &(glyphs[key] = glyph);
+    }
+
+    if (width + GLYPH_PADDING > pageSize || height + GLYPH_PADDING > pageSize)
+    {
+        return nullptr;
+    }
+
+    int32 w = static_cast<int32>(width);
+    int32 h = static_cast<int32>(height);
+
+    const uint32 currentFrame = GetCurrentFrame();
+    uint32 pageIndex = 0;
+    bool allocated = false;
+    for (; pageIndex < pages.size(); ++pageIndex)
+    {
+        // texture of page drawn in this frame is already used by pushed batches, so page isn't updated until next frame
+        if (!pages[pageIndex].pixels.empty() && pages[pageIndex].drawFrame != currentFrame && Allocate(pages[pageIndex], w, h, glyph.rect))
+        {
+            allocated = true;
+            break;
+        }
+    }
+
+    if (!allocated)
+    {
+        pageIndex = AcquirePage();
+        allocated = Allocate(pages[pageIndex], w, h, glyph.rect);
+        DVASSERT(allocated);
+    }
+
+    Page& page = pages[pageIndex];
+    for (int32 row = 0; row < h; ++row)
+    {
+        uint8* dst = page.pixels.data() + (glyph.rect.y + row) * pageSize + glyph.rect.x;
+        Memcpy(dst, bitmap + row * pitch, width);
+    }
+    page.keys.push_back(key);
+    page.dirty = true;
+
+    glyph.page = pageIndex;
+    TouchPage(pageIndex);
+
+    return &(glyphs[key] = glyph);
+}
+
+void GlyphAtlas::RemoveGlyphs(const void* face)
+{
+    for (auto it = glyphs.begin(); it != glyphs.end();)
+    {
+        if (it->first.face == face)
+        {
+            it = glyphs.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    for (Page& page : pages)
+    {
+        page.keys.erase(std::remove_if(page.keys.begin(), page.keys.end(), [face](const Key& key) { return key.face == face; }), page.keys.end());
+    }
+}
+
+void GlyphAtlas::Clear()
+{
+    glyphs.clear();
+    for (Page& page : pages)
+    {
+        ClearPage(page);
+    }
+}
+
+void GlyphAtlas::TouchPage(uint32 page)
+{
+    DVASSERT(page < pages.size());
+    pages[page].lastUse = ++useCounter;
+    pages[page].useFrame = GetCurrentFrame();
+}
+
+uint32 GlyphAtlas::GetPageGeneration(uint32 page) const
+{
+    DVASSERT(page < pages.size());
+    return pages[page].generation;
+}
+
+Texture* GlyphAtlas::GetPageTexture(uint32 pageIndex)
+{
+    DVASSERT(pageIndex < pages.size());
+    Page& page = pages[pageIndex];
+    DVASSERT(!page.pixels.empty());
+    page.drawFrame = GetCurrentFrame();
+    TrimPages();
+
+    if (page.texture == nullptr)
+    {
+        page.texture = Texture::CreateFromData(FORMAT_A8, page.pixels.data(), pageSize, pageSize, false);
+        page.texture->SetWrapMode(rhi::TEXADDR_CLAMP, rhi::TEXADDR_CLAMP);
+        page.texture->SetMinMagFilter(rhi::TEXFILTER_LINEAR, rhi::TEXFILTER_LINEAR, rhi::TEXMIPFILTER_NONE);
+        page.dirty = false;
+    }
+    else if (page.dirty || rhi::NeedRestoreTexture(page.texture->handle))
+    {
+        page.texture->TexImage(0, pageSize, pageSize, page.pixels.data(), static_cast<uint32>(page.pixels.size()), Texture::INVALID_CUBEMAP_FACE);
+        page.dirty = false;
+    }
+
+    return page.texture;
+}
+
+bool GlyphAtlas::Allocate(Page& page, int32 width, int32 height, Rect2i& rect)
+{
+    using namespace GlyphAtlasDetails;
+
+    const int32 size = static_cast<int32>(pageSize);
+    const int32 paddedWidth = width + GLYPH_PADDING;
+    const int32 paddedHeight = height + GLYPH_PADDING;
+
+    for (Shelf& shelf : page.shelves)
+    {
+        if (shelf.height >= paddedHeight && shelf.height <= paddedHeight + SHELF_HEIGHT_TOLERANCE && shelf.x + paddedWidth <= size)
+        {
+            rect = Rect2i(shelf.x, shelf.y, width, height);
+            shelf.x += paddedWidth;
+            return true;
+        }
+    }
+
+    int32 nextY = page.shelves.empty() ? 0 : page.shelves.back().y + page.shelves.back().height;
+    if (nextY + paddedHeight > size)
+    {
+        return false;
+    }
+
+    Shelf shelf;
+    shelf.y = nextY;
+    shelf.height = paddedHeight;
+    shelf.x = paddedWidth;
+    page.shelves.push_back(shelf);
+
+    rect = Rect2i(0, nextY, width, height);
+    return true;
+}
+
+uint32 GlyphAtlas::AcquirePage()
+{
+    // glyphs of pages used in this frame can be referenced by texts prepared or drawn earlier in the frame
+    const uint32 currentFrame = GetCurrentFrame();
+    uint32 lruPage = static_cast<uint32>(pages.size());
+    uint32 releasedPage = static_cast<uint32>(pages.size());
+    for (uint32 i = 0; i < pages.size(); ++i)
+    {
+        if (pages[i].pixels.empty())
+        {
+            releasedPage = std::min(releasedPage, i);
+        }
+        else if (pages[i].useFrame != currentFrame && pages[i].drawFrame != currentFrame && (lruPage == pages.size() || pages[i].lastUse < pages[lruPage].lastUse))
+        {
+            lruPage = i;
+        }
+    }
+
+    if (GetPagesCount() >= maxPagesCount && lruPage != pages.size())
+    {
+        Page& page = pages[lruPage];
+        for (const Key& key : page.keys)
+        {
+            glyphs.erase(key);
+        }
+        ClearPage(page);
+        return lruPage;
+    }
+
+    // released page keeps its generation, so it is reused instead of adding new one
+    if (releasedPage == pages.size())
+    {
+        pages.emplace_back();
+    }
+    pages[releasedPage].pixels.resize(pageSize * pageSize, 0);
+    return releasedPage;
+}
+
+void GlyphAtlas::ClearPage(Page& page)
+{
+    std::fill(page.pixels.begin(), page.pixels.end(), uint8(0));
+    page.shelves.clear();
+    page.keys.clear();
+    page.generation++;
+    page.dirty = true;
+}
+
+void GlyphAtlas::ReleasePage(Page& page)
+{
+    for (const Key& key : page.keys)
+    {
+        glyphs.erase(key);
+    }
+    ClearPage(page);
+    Vector<uint8>().swap(page.pixels);
+    SafeRelease(page.texture);
+}
+
+void GlyphAtlas::TrimPages()
+{
+    // pages over maxPagesCount are released once per frame, page used in previous frame is likely to be used again
+    const uint32 currentFrame = GetCurrentFrame();
+    if (trimFrame == currentFrame)
+    {
+        return;
+    }
+    trimFrame = currentFrame;
+
+    uint32 pagesCount = GetPagesCount();
+    while (pagesCount > maxPagesCount)
+    {
+        uint32 lruPage = static_cast<uint32>(pages.size());
+        for (uint32 i = 0; i < pages.size(); ++i)
+        {
+            const Page& page = pages[i];
+            if (!page.pixels.empty() && currentFrame - page.useFrame > 1 && currentFrame - page.drawFrame > 1 && (lruPage == pages.size() || page.lastUse < pages[lruPage].lastUse))
+            {
+                lruPage = i;
+            }
+        }
+
+        if (lruPage == pages.size())
+        {
+            break;
+        }
+
+        ReleasePage(pages[lruPage]);
+        --pagesCount;
+    }
+}
+
+uint32 GlyphAtlas::GetPagesCount() const
+{
+    return static_cast<uint32>(std::count_if(pages.begin(), pages.end(), [](const Page& page) { return !page.pixels.empty(); }));
+}
+
+uint32 GlyphAtlas::GetCurrentFrame() const
+{
+    return Engine::Instance()->GetGlobalFrameIndex();
+}
+}
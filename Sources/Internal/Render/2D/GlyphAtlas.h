@@ -0,0 +1,134 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/BaseMath.h"
+
+namespace DAVA
+{
+class Texture;
+
+/**
+    \ingroup fonts
+    Cache of rasterized glyphs packed into few shared `FORMAT_A8` atlas pages.
+
+    Glyphs are keyed by font face, physical size and glyph index, so same glyph rasterized once
+    is reused by all text blocks. Glyphs are packed into pages by shelves. When there is no space
+    for new glyph and all pages are allocated, least recently used page is cleared and reused.
+    Every clear increments generation of page, so users of glyphs can detect that their glyphs were evicted.
+
+    Pages used in current engine frame are never evicted and pages which textures were taken for drawing
+    in current frame are not changed, so batches pushed earlier in the frame keep valid glyphs.
+    If glyph can't be placed without that, new page is added even if `maxPagesCount` is reached.
+    Such surplus pages are released in later frames, when least recently used pages are not used for a whole frame.
+
+    Pixels of pages are kept in memory, textures are created and updated on `GetPageTexture` call
+    and re-uploaded after device loss. Atlas should be used from main thread.
+*/
+class GlyphAtlas
+{
+public:
+    struct Key
+    {
+        const void* face = nullptr;
+        uint32 size = 0; //!< physical size in 26.6 fixed point format
+        uint32 glyphIndex = 0;
+
+        bool operator==(const Key& other) const;
+    };
+
+    struct Glyph
+    {
+        uint32 page = 0;
+        Rect2i rect; //!< glyph bitmap rect on page in pixels
+        int32 left = 0; //!< horizontal distance from pen position to left edge of bitmap
+        int32 top = 0; //!< vertical distance from baseline to top edge of bitmap
+    };
+
+    GlyphAtlas(uint32 pageSize = 1024, uint32 maxPagesCount = 4);
+    ~GlyphAtlas();
+
+    /** Return glyph for `key` and mark its page as recently used, or return nullptr if glyph is not cached. */
+    const Glyph* FindGlyph(const Key& key);
+
+    /**
+        Copy glyph bitmap with `pitch` bytes per row into atlas and return added glyph.
+        Can evict least recently used page which is not used in current frame. Return nullptr if glyph is bigger than page.
+    */
+    const Glyph* AddGlyph(const Key& key, const uint8* bitmap, uint32 width, uint32 height, int32 pitch, int32 left, int32 top);
+
+    /** Remove all glyphs of `face`. Pages are not cleared, space is reused after page eviction. */
+    void RemoveGlyphs(const void* face);
+    /** Remove all glyphs and clear all pages. */
+    void Clear();
+
+    /** Mark page as recently used and protect it from eviction until next frame. */
+    void TouchPage(uint32 page);
+    /** Return counter incremented every time `page` is cleared. */
+    uint32 GetPageGeneration(uint32 page) const;
+    /**
+        Return texture of `page`, upload new glyphs into it if needed.
+        Page is not changed until next frame, so texture can be used by batches of current frame.
+    */
+    Texture* GetPageTexture(uint32 page);
+
+    uint32 GetPageSize() const;
+    /** Return number of pages which hold pixels, released surplus pages are not counted. */
+    uint32 GetPagesCount() const;
+    uint32 GetGlyphsCount() const;
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Shelf
+    {
+        int32 y = 0;
+        int32 height = 0;
+        int32 x = 0;
+    };
+
+    struct Page
+    {
+        Vector<uint8> pixels;
+        Vector<Shelf> shelves;
+        Vector<Key> keys;
+        Texture* texture = nullptr;
+        uint64 lastUse = 0;
+        uint32 useFrame = 0; //!< last frame in which page was used, page can't be evicted in this frame
+        uint32 drawFrame = 0; //!< last frame in which page texture was drawn, page can't be changed in this frame
+        uint32 generation = 0;
+        bool dirty = false;
+    };
+
+    bool Allocate(Page& page, int32 width, int32 height, Rect2i& rect);
+    uint32 AcquirePage();
+    void ClearPage(Page& page);
+    void ReleasePage(Page& page);
+    void TrimPages();
+    uint32 GetCurrentFrame() const;
+
+    uint32 pageSize = 0;
+    uint32 maxPagesCount = 0;
+    uint64 useCounter = 0;
+    uint32 trimFrame = 0;
+    Vector<Page> pages;
+    UnorderedMap<Key, Glyph, KeyHash> glyphs;
+};
+
+inline bool GlyphAtlas::Key::operator==(const Key& other) const
+{
+    return face == other.face && size == other.size && glyphIndex == other.glyphIndex;
+}
+
+inline uint32 GlyphAtlas::GetPageSize() const
+{
+    return pageSize;
+}
+
+inline uint32 GlyphAtlas::GetGlyphsCount() const
+{
+    return static_cast<uint32>(glyphs.size());
+}
+}
@@ -14,6 +14,7 @@ namespace DAVA
 class TextBlockRender;
 class TextBlockSoftwareRender;
 class TextBlockGraphicRender;
+class TextBlockGlyphAtlasRender;
 class TextBox;
 
 /**
@@ -52,6 +53,18 @@ public:
     */
     static bool IsBiDiSupportEnabled();
 
+    /**
+    * \brief Sets rendering of FreeType fonts through shared glyph atlas enabled.
+    * \param value true to draw FreeType text by glyph quads instead of sprite with whole text.
+    */
+    static void SetGlyphAtlasEnabled(bool value);
+
+    /**
+    * \brief Is rendering of FreeType fonts through shared glyph atlas enabled.
+    * \return true if glyph atlas is used.
+    */
+    static bool IsGlyphAtlasEnabled();
+
     static TextBlock* Create(const Vector2& size);
 
     virtual void SetFont(Font* font);
@@ -154,6 +167,7 @@ private:
     void CalculateCacheParamsIfNeed();
 
     void SetFontInternal(Font* _font);
+    void CreateRender();
 
     Vector2 scale;
     Vector2 rectSize;
@@ -202,12 +216,14 @@ private:
     bool needMeasureLines : 1;
 
     static bool isBiDiSupportEnabled; //!< true if BiDi transformation support enabled
+    static bool isGlyphAtlasEnabled; //!< true if FreeType text is drawn through shared glyph atlas
     static Set<TextBlock*> registredTextBlocks;
     static Mutex textblockListMutex;
 
     friend class TextBlockRender;
     friend class TextBlockSoftwareRender;
     friend class TextBlockGraphicRender;
+    friend class TextBlockGlyphAtlasRender;
 
     TextBlockRender* textBlockRender = nullptr;
     TextBox* textBox = nullptr;
@@ -278,6 +294,11 @@ inline bool TextBlock::IsBiDiSupportEnabled()
     return isBiDiSupportEnabled;
 }
 
+inline bool TextBlock::IsGlyphAtlasEnabled()
+{
+    return isGlyphAtlasEnabled;
+}
+
 }; //end of namespace
 
 #endif // __DAVAENGINE_TEXTBLOCK_H__
\ No newline at end of file
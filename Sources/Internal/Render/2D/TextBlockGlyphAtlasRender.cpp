@@ -0,0 +1,175 @@
+#include "Render/2D/TextBlockGlyphAtlasRender.h"
+#include "Engine/Engine.h"
+#include "Render/2D/FontManager.h"
+#include "Render/2D/GlyphAtlas.h"
+#include "Render/2D/Systems/RenderSystem2D.h"
+#include "Render/2D/Systems/VirtualCoordinatesSystem.h"
+#include "Render/2D/TextBlockGraphicRender.h"
+#include "Render/Texture.h"
+#include "UI/UIControlSystem.h"
+
+namespace DAVA
+{
+TextBlockGlyphAtlasRender::TextBlockGlyphAtlasRender(TextBlock* textBlock)
+    : TextBlockRender(textBlock)
+    , ftFont(static_cast<FTFont*>(textBlock->font))
+    , atlas(FontManager::Instance()->GetGlyphAtlas())
+{
+}
+
+TextBlockRender* TextBlockGlyphAtlasRender::Clone()
+{
+    TextBlockGlyphAtlasRender* result = new TextBlockGlyphAtlasRender(textBlock);
+    result->quads = quads;
+    result->vertexBuffer = vertexBuffer;
+    result->batches = batches;
+    return result;
+}
+
+void TextBlockGlyphAtlasRender::Prepare()
+{
+    TextBlockRender::Prepare();
+
+    quads.clear();
+    vertexBuffer.clear();
+    batches.clear();
+
+    if (textBlock->visualText.empty())
+    {
+        return;
+    }
+
+    DrawText();
+    BuildBatches();
+}
+
+void TextBlockGlyphAtlasRender::Draw(const Color& textColor, const Matrix4& worldMatrix)
+{
+    if (!IsActual())
+    {
+        // some glyphs were evicted from atlas by other texts, place them again
+        textBlock->PrepareInternal();
+    }
+
+    // transform vertices here instead of passing world matrix, which would break packet of every text
+    transformedVertexBuffer.resize(vertexBuffer.size());
+    for (size_t i = 0; i < vertexBuffer.size(); ++i)
+    {
+        transformedVertexBuffer[i].position = vertexBuffer[i].position * worldMatrix;
+        transformedVertexBuffer[i].texCoord = vertexBuffer[i].texCoord;
+    }
+
+    const uint16* indexBuffer = TextBlockGraphicRender::GetSharedIndexBuffer();
+    for (const PageBatch& pageBatch : batches)
+    {
+        if (atlas->GetPageGeneration(pageBatch.page) != pageBatch.generation)
+        {
+            continue;
+        }
+        atlas->TouchPage(pageBatch.page);
+
+        Texture* texture = atlas->GetPageTexture(pageBatch.page);
+        const GraphicFont::GraphicFontVertex& firstVertex = transformedVertexBuffer[pageBatch.firstVertex];
+
+        BatchDescriptor2D batch;
+        batch.material = RenderSystem2D::DEFAULT_2D_TEXTURE_ALPHA8_MATERIAL;
+        batch.singleColor = textColor;
+        batch.vertexStride = TextBlockGraphicRender::TextVerticesDefaultStride;
+        batch.texCoordStride = TextBlockGraphicRender::TextVerticesDefaultStride;
+        batch.vertexPointer = firstVertex.position.data;
+        batch.texCoordPointer[0] = firstVertex.texCoord.data;
+        batch.textureSetHandle = texture->singleTextureSet;
+        batch.samplerStateHandle = texture->samplerStateHandle;
+        batch.vertexCount = pageBatch.vertexCount;
+        batch.indexPointer = indexBuffer;
+        batch.indexCount = batch.vertexCount * 6 / 4;
+        RenderSystem2D::Instance()->PushBatch(batch);
+    }
+}
+
+Vector2 TextBlockGlyphAtlasRender::GetTextSize() const
+{
+    return textBlock->cacheFinalSize;
+}
+
+Font::StringMetrics TextBlockGlyphAtlasRender::DrawTextSL(const WideString& drawText, int32 x, int32 y, int32 w)
+{
+    return ftFont->DrawStringToAtlas(atlas, quads, -textBlock->cacheOx, -textBlock->cacheOy, 0, 0, drawText, true);
+}
+
+Font::StringMetrics TextBlockGlyphAtlasRender::DrawTextML(const WideString& drawText, int32 x, int32 y, int32 w, int32 xOffset, uint32 yOffset, int32 lineSize)
+{
+    VirtualCoordinatesSystem* vcs = GetEngineContext()->uiControlSystem->vcs;
+    int32 offsetX = -textBlock->cacheOx + int32(vcs->ConvertVirtualToPhysicalX(float32(xOffset)));
+    int32 offsetY = -textBlock->cacheOy + int32(vcs->ConvertVirtualToPhysicalY(float32(yOffset)));
+    if (textBlock->cacheUseJustify)
+    {
+        return ftFont->DrawStringToAtlas(atlas, quads, offsetX, offsetY,
+                                         int32(std::ceil(vcs->ConvertVirtualToPhysicalX(float32(w)))),
+                                         int32(std::ceil(vcs->ConvertVirtualToPhysicalY(float32(lineSize)))),
+                                         drawText, true);
+    }
+    return ftFont->DrawStringToAtlas(atlas, quads, offsetX, offsetY, 0, 0, drawText, true);
+}
+
+void TextBlockGlyphAtlasRender::BuildBatches()
+{
+    // glyphs of one page are drawn by one batch, batch size is limited by shared index buffer
+    const uint32 maxBatchVertexCount = TextBlockGraphicRender::GetSharedIndexBufferCapacity() / 6 * 4;
+
+    std::stable_sort(quads.begin(), quads.end(), [](const FTFont::GlyphQuad& l, const FTFont::GlyphQuad& r) {
+        return (l.page < r.page) || (l.page == r.page && l.generation < r.generation);
+    });
+
+    VirtualCoordinatesSystem* vcs = GetEngineContext()->uiControlSystem->vcs;
+    const float32 texelSize = 1.f / atlas->GetPageSize();
+
+    vertexBuffer.resize(quads.size() * 4);
+    for (size_t i = 0; i < quads.size(); ++i)
+    {
+        const FTFont::GlyphQuad& quad = quads[i];
+
+        float32 x0 = vcs->ConvertPhysicalToVirtualX(float32(quad.rect.x));
+        float32 y0 = vcs->ConvertPhysicalToVirtualY(float32(quad.rect.y));
+        float32 x1 = vcs->ConvertPhysicalToVirtualX(float32(quad.rect.x + quad.rect.dx));
+        float32 y1 = vcs->ConvertPhysicalToVirtualY(float32(quad.rect.y + quad.rect.dy));
+
+        float32 u0 = quad.atlasRect.x * texelSize;
+        float32 v0 = quad.atlasRect.y * texelSize;
+        float32 u1 = (quad.atlasRect.x + quad.atlasRect.dx) * texelSize;
+        float32 v1 = (quad.atlasRect.y + quad.atlasRect.dy) * texelSize;
+
+        GraphicFont::GraphicFontVertex* vertex = &vertexBuffer[i * 4];
+        vertex[0].position = Vector3(x0, y0, 0.f);
+        vertex[0].texCoord = Vector2(u0, v0);
+        vertex[1].position = Vector3(x1, y0, 0.f);
+        vertex[1].texCoord = Vector2(u1, v0);
+        vertex[2].position = Vector3(x1, y1, 0.f);
+        vertex[2].texCoord = Vector2(u1, v1);
+        vertex[3].position = Vector3(x0, y1, 0.f);
+        vertex[3].texCoord = Vector2(u0, v1);
+
+        if (batches.empty() || batches.back().page != quad.page || batches.back().generation != quad.generation || batches.back().vertexCount == maxBatchVertexCount)
+        {
+            PageBatch batch;
+            batch.page = quad.page;
+            batch.generation = quad.generation;
+            batch.firstVertex = uint32(i * 4);
+            batches.push_back(batch);
+        }
+        batches.back().vertexCount += 4;
+    }
+}
+
+bool TextBlockGlyphAtlasRender::IsActual() const
+{
+    for (const PageBatch& batch : batches)
+    {
+        if (atlas->GetPageGeneration(batch.page) != batch.generation)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Render/2D/TextBlockRender.h"
+#include "Render/2D/FTFont.h"
+#include "Render/2D/GraphicFont.h"
+
+namespace DAVA
+{
+class GlyphAtlas;
+
+/**
+    Render of FreeType text which takes glyphs from shared `GlyphAtlas` instead of rasterizing
+    whole text into own texture. Glyphs are drawn as quads batched per atlas page through `RenderSystem2D`.
+
+    Glyph layout is same as in `TextBlockSoftwareRender`, text is drawn as sprite of size `GetTextSize`
+    with top left corner transformed by world matrix passed to `Draw`. Vertices are transformed on CPU,
+    so glyphs of different texts on the same page are merged into one `RenderSystem2D` packet.
+*/
+class TextBlockGlyphAtlasRender : public TextBlockRender
+{
+public:
+    TextBlockGlyphAtlasRender(TextBlock*);
+
+    void Prepare() override;
+    TextBlockRender* Clone() override;
+
+    using TextBlockRender::Draw;
+    /** Draw text with `textColor`, glyph positions are transformed by `worldMatrix` before pushing batches. */
+    void Draw(const Color& textColor, const Matrix4& worldMatrix);
+    /** Return size of text in virtual coordinates. */
+    Vector2 GetTextSize() const;
+
+private:
+    Font::StringMetrics DrawTextSL(const WideString& drawText, int32 x, int32 y, int32 w) override;
+    Font::StringMetrics DrawTextML(const WideString& drawText, int32 x, int32 y, int32 w,
+                                   int32 xOffset, uint32 yOffset, int32 lineSize) override;
+
+    void BuildBatches();
+    bool IsActual() const;
+
+    struct PageBatch
+    {
+        uint32 page = 0;
+        uint32 generation = 0;
+        uint32 firstVertex = 0;
+        uint32 vertexCount = 0;
+    };
+
+    FTFont* ftFont = nullptr;
+    GlyphAtlas* atlas = nullptr;
+    Vector<FTFont::GlyphQuad> quads;
+    Vector<GraphicFont::GraphicFontVertex> vertexBuffer;
+    Vector<GraphicFont::GraphicFontVertex> transformedVertexBuffer;
+    Vector<PageBatch> batches;
+};
+}
@@ -1,4 +1,5 @@
 #include "Render/3D/PolygonGroup.h"
+#include "FileSystem/FastNameKeyedArchive.h"
 #include "FileSystem/KeyedArchive.h"
 #include "Render/Renderer.h"
 #include "Scene3D/SceneFileV2.h"
@@ -8,6 +9,22 @@
 
 namespace DAVA
 {
+namespace PolygonGroupDetails
+{
+// keys of polygon data archive, they are interned once instead of hashing strings for every loaded polygon group
+const FastName VERTEX_FORMAT("vertexFormat");
+const FastName VERTEX_COUNT("vertexCount");
+const FastName INDEX_COUNT("indexCount");
+const FastName TEXTURE_COORD_COUNT("textureCoordCount");
+const FastName PRIMITIVE_TYPE("rhi_primitiveType");
+const FastName PRIMITIVE_COUNT("primitiveCount");
+const FastName CUBE_TEXTURE_COORD_COUNT("cubeTextureCoordCount");
+const FastName PACKING("packing");
+const FastName VERTICES("vertices");
+const FastName INDEX_FORMAT("indexFormat");
+const FastName INDICES("indices");
+}
+
 DAVA_VIRTUAL_REFLECTION_IMPL(PolygonGroup)
 {
     ReflectionRegistrator<PolygonGroup>::Begin()
@@ -353,30 +370,32 @@ void PolygonGroup::Save(KeyedArchive* keyedArchive, SerializationContext* serial
     keyedArchive->SetInt32("cubeTextureCoordCount", cubeTextureCoordCount);
 }
 
-void PolygonGroup::LoadPolygonData(KeyedArchive* keyedArchive, SerializationContext* serializationContext, int32 requiredFlags, bool cutUnusedStreams)
+void PolygonGroup::LoadPolygonData(const FastNameKeyedArchive* archive, SerializationContext* serializationContext, int32 requiredFlags, bool cutUnusedStreams)
 {
+    using namespace PolygonGroupDetails;
+
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
 
-    vertexFormat = keyedArchive->GetInt32("vertexFormat");
+    vertexFormat = archive->GetInt32(VERTEX_FORMAT);
     vertexStride = GetVertexSize(vertexFormat);
-    vertexCount = keyedArchive->GetInt32("vertexCount");
-    indexCount = keyedArchive->GetInt32("indexCount");
-    textureCoordCount = keyedArchive->GetInt32("textureCoordCount");
-    primitiveType = rhi::PrimitiveType(keyedArchive->GetInt32("rhi_primitiveType", rhi::PRIMITIVE_TRIANGLELIST));
-    primitiveCount = keyedArchive->GetInt32("primitiveCount", CalculatePrimitiveCount(indexCount, primitiveType));
-    cubeTextureCoordCount = keyedArchive->GetInt32("cubeTextureCoordCount");
-
-    int32 formatPacking = keyedArchive->GetInt32("packing");
+    vertexCount = archive->GetInt32(VERTEX_COUNT);
+    indexCount = archive->GetInt32(INDEX_COUNT);
+    textureCoordCount = archive->GetInt32(TEXTURE_COORD_COUNT);
+    primitiveType = rhi::PrimitiveType(archive->GetInt32(PRIMITIVE_TYPE, rhi::PRIMITIVE_TRIANGLELIST));
+    primitiveCount = archive->GetInt32(PRIMITIVE_COUNT, CalculatePrimitiveCount(indexCount, primitiveType));
+    cubeTextureCoordCount = archive->GetInt32(CUBE_TEXTURE_COORD_COUNT);
+
+    int32 formatPacking = archive->GetInt32(PACKING);
     if (formatPacking == PACKING_NONE)
     {
-        int size = keyedArchive->GetByteArraySize("vertices");
+        int size = archive->GetByteArraySize(VERTICES);
         if (size != vertexCount * vertexStride)
         {
             Logger::Error("PolygonGroup::Load - Something is going wrong, size of vertex array is incorrect");
             return;
         }
 
-        const uint8* archiveData = keyedArchive->GetByteArray("vertices");
+        const uint8* archiveData = archive->GetByteArray(VERTICES);
 
         int32 resFormat = cutUnusedStreams ? requiredFlags : (vertexFormat | requiredFlags);
 
@@ -422,10 +441,10 @@ void PolygonGroup::LoadPolygonData(KeyedArchive* keyedArchive, SerializationCont
         }
     }
 
-    indexFormat = keyedArchive->GetInt32("indexFormat");
+    indexFormat = archive->GetInt32(INDEX_FORMAT);
     if (indexFormat == EIF_16)
     {
-        int size = keyedArchive->GetByteArraySize("indices");
+        int size = archive->GetByteArraySize(INDICES);
         if (size != indexCount * INDEX_FORMAT_SIZE[indexFormat])
         {
             Logger::Error("PolygonGroup::Load - Something is going wrong, size of index array is incorrect");
@@ -433,7 +452,7 @@ void PolygonGroup::LoadPolygonData(KeyedArchive* keyedArchive, SerializationCont
         }
         SafeDeleteArray(indexArray);
         indexArray = new int16[indexCount];
-        const uint8* archiveData = keyedArchive->GetByteArray("indices");
+        const uint8* archiveData = archive->GetByteArray(INDICES);
         memcpy(indexArray, archiveData, indexCount * INDEX_FORMAT_SIZE[indexFormat]);
     }
 
@@ -17,6 +17,7 @@ namespace DAVA
 
 class SceneFileV2;
 class GeometryOctTree;
+class FastNameKeyedArchive;
 class PolygonGroup : public DataNode
 {
     DAVA_ENABLE_CLASS_ALLOCATION_TRACKING(ALLOC_POOL_POLYGONGROUP)
@@ -161,7 +162,7 @@ public:
     void RestoreBuffers();
 
     void Save(KeyedArchive* keyedArchive, SerializationContext* serializationContext) override;
-    void LoadPolygonData(KeyedArchive* keyedArchive, SerializationContext* serializationContext, int32 requiredFlags, bool cutUnusedStreams);
+    void LoadPolygonData(const FastNameKeyedArchive* archive, SerializationContext* serializationContext, int32 requiredFlags, bool cutUnusedStreams);
 
     static void CopyData(const uint8** meshData, uint8** newMeshData, uint32 vertexFormat, uint32 newVertexFormat, uint32 format);
 
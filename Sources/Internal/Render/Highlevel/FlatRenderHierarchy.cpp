@@ -0,0 +1,369 @@
+#include "Render/Highlevel/FlatRenderHierarchy.h"
+#include "Render/Highlevel/RenderObject.h"
+#include "Render/Highlevel/Camera.h"
+#include "Render/Highlevel/Frustum.h"
+#include "Render/Highlevel/GeometryOctTree.h"
+#include "Render/Highlevel/Landscape.h"
+#include "Render/Highlevel/VisibilityQuadTree.h"
+#include "Render/Renderer.h"
+#include "Base/FrameArena.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
+#include "Math/SIMD.h"
+
+namespace DAVA
+{
+// Box is outside of plane if its nearest to plane point is in front of plane:
+// dot(n, center) + d - dot(abs(n), extent) > 0
+struct FlatRenderHierarchy::ClipPlanes
+{
+    uint32 count = 0;
+    float32 nx[6];
+    float32 ny[6];
+    float32 nz[6];
+    float32 absNx[6];
+    float32 absNy[6];
+    float32 absNz[6];
+    float32 d[6];
+};
+
+void FlatRenderHierarchy::AddRenderObject(RenderObject* renderObject)
+{
+    DVASSERT(renderObject->GetTreeNodeIndex() == QuadTree::INVALID_TREE_NODE_INDEX);
+    DVASSERT(objects.size() < QuadTree::INVALID_TREE_NODE_INDEX);
+
+    uint32 index = static_cast<uint32>(objects.size());
+    objects.push_back(renderObject);
+    centerX.push_back(0.0f);
+    centerY.push_back(0.0f);
+    centerZ.push_back(0.0f);
+    extentX.push_back(0.0f);
+    extentY.push_back(0.0f);
+    extentZ.push_back(0.0f);
+    alwaysVisible.push_back((renderObject->GetFlags() & RenderObject::ALWAYS_CLIPPING_VISIBLE) ? 1 : 0);
+
+    renderObject->SetTreeNodeIndex(static_cast<uint16>(index));
+    SetObjectBox(index, renderObject->GetWorldBoundingBox());
+}
+
+void FlatRenderHierarchy::RemoveRenderObject(RenderObject* renderObject)
+{
+    uint32 index = renderObject->GetTreeNodeIndex();
+    if (index == QuadTree::INVALID_TREE_NODE_INDEX)
+    {
+        // already removed by PrepareForShutdown
+        return;
+    }
+
+    DVASSERT(index < objects.size() && objects[index] == renderObject);
+    renderObject->SetTreeNodeIndex(QuadTree::INVALID_TREE_NODE_INDEX);
+
+    uint32 last = static_cast<uint32>(objects.size() - 1);
+    if (index != last)
+    {
+        objects[index] = objects[last];
+        centerX[index] = centerX[last];
+        centerY[index] = centerY[last];
+        centerZ[index] = centerZ[last];
+        extentX[index] = extentX[last];
+        extentY[index] = extentY[last];
+        extentZ[index] = extentZ[last];
+        alwaysVisible[index] = alwaysVisible[last];
+        objects[index]->SetTreeNodeIndex(static_cast<uint16>(index));
+    }
+
+    objects.pop_back();
+    centerX.pop_back();
+    centerY.pop_back();
+    centerZ.pop_back();
+    extentX.pop_back();
+    extentY.pop_back();
+    extentZ.pop_back();
+    alwaysVisible.pop_back();
+}
+
+void FlatRenderHierarchy::ObjectUpdated(RenderObject* renderObject)
+{
+    uint32 index = renderObject->GetTreeNodeIndex();
+    DVASSERT(index < objects.size() && objects[index] == renderObject);
+
+    alwaysVisible[index] = (renderObject->GetFlags() & RenderObject::ALWAYS_CLIPPING_VISIBLE) ? 1 : 0;
+    SetObjectBox(index, renderObject->GetWorldBoundingBox());
+}
+
+void FlatRenderHierarchy::PrepareForShutdown()
+{
+    for (RenderObject* renderObject : objects)
+    {
+        renderObject->SetTreeNodeIndex(QuadTree::INVALID_TREE_NODE_INDEX);
+    }
+
+    objects.clear();
+    centerX.clear();
+    centerY.clear();
+    centerZ.clear();
+    extentX.clear();
+    extentY.clear();
+    extentZ.clear();
+    alwaysVisible.clear();
+    broadPhaseCollisions.clear();
+}
+
+void FlatRenderHierarchy::SetObjectBox(uint32 index, const AABBox3& box)
+{
+    if (box.IsEmpty())
+    {
+        // empty box is never visible unless object is always visible
+        centerX[index] = centerY[index] = centerZ[index] = 0.0f;
+        extentX[index] = extentY[index] = extentZ[index] = -FLOAT_MAX;
+        return;
+    }
+
+    Vector3 center = box.GetCenter();
+    Vector3 extent = (box.max - box.min) * 0.5f;
+    centerX[index] = center.x;
+    centerY[index] = center.y;
+    centerZ[index] = center.z;
+    extentX[index] = extent.x;
+    extentY[index] = extent.y;
+    extentZ[index] = extent.z;
+
+    worldBBox.AddAABBox(box);
+}
+
+void FlatRenderHierarchy::ClipRange(const ClipPlanes& planes, uint32 begin, uint32 end, uint8* clipResults) const
+{
+    uint32 i = begin;
+
+#if defined(DAVA_SIMD_SSE)
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128 cx = _mm_loadu_ps(&centerX[i]);
+        __m128 cy = _mm_loadu_ps(&centerY[i]);
+        __m128 cz = _mm_loadu_ps(&centerZ[i]);
+        __m128 ex = _mm_loadu_ps(&extentX[i]);
+        __m128 ey = _mm_loadu_ps(&extentY[i]);
+        __m128 ez = _mm_loadu_ps(&extentZ[i]);
+
+        __m128 outside = zero;
+        for (uint32 p = 0; p < planes.count; ++p)
+        {
+            __m128 dist = _mm_add_ps(_mm_mul_ps(cx, _mm_set1_ps(planes.nx[p])), _mm_set1_ps(planes.d[p]));
+            dist = _mm_add_ps(dist, _mm_mul_ps(cy, _mm_set1_ps(planes.ny[p])));
+            dist = _mm_add_ps(dist, _mm_mul_ps(cz, _mm_set1_ps(planes.nz[p])));
+            __m128 radius = _mm_mul_ps(ex, _mm_set1_ps(planes.absNx[p]));
+            radius = _mm_add_ps(radius, _mm_mul_ps(ey, _mm_set1_ps(planes.absNy[p])));
+            radius = _mm_add_ps(radius, _mm_mul_ps(ez, _mm_set1_ps(planes.absNz[p])));
+            outside = _mm_or_ps(outside, _mm_cmpgt_ps(_mm_sub_ps(dist, radius), zero));
+        }
+
+        int32 outsideMask = _mm_movemask_ps(outside);
+        for (uint32 k = 0; k < 4; ++k)
+        {
+            clipResults[i + k] = ((outsideMask & (1 << k)) == 0 || alwaysVisible[i + k]) ? 1 : 0;
+        }
+    }
+#elif defined(DAVA_SIMD_NEON)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    for (; i + 4 <= end; i += 4)
+    {
+        float32x4_t cx = vld1q_f32(&centerX[i]);
+        float32x4_t cy = vld1q_f32(&centerY[i]);
+        float32x4_t cz = vld1q_f32(&centerZ[i]);
+        float32x4_t ex = vld1q_f32(&extentX[i]);
+        float32x4_t ey = vld1q_f32(&extentY[i]);
+        float32x4_t ez = vld1q_f32(&extentZ[i]);
+
+        uint32x4_t outside = vdupq_n_u32(0);
+        for (uint32 p = 0; p < planes.count; ++p)
+        {
+            float32x4_t dist = vmlaq_n_f32(vdupq_n_f32(planes.d[p]), cx, planes.nx[p]);
+            dist = vmlaq_n_f32(dist, cy, planes.ny[p]);
+            dist = vmlaq_n_f32(dist, cz, planes.nz[p]);
+            float32x4_t radius = vmulq_n_f32(ex, planes.absNx[p]);
+            radius = vmlaq_n_f32(radius, ey, planes.absNy[p]);
+            radius = vmlaq_n_f32(radius, ez, planes.absNz[p]);
+            outside = vorrq_u32(outside, vcgtq_f32(vsubq_f32(dist, radius), zero));
+        }
+
+        uint32 outsideLanes[4];
+        vst1q_u32(outsideLanes, outside);
+        for (uint32 k = 0; k < 4; ++k)
+        {
+            clipResults[i + k] = (outsideLanes[k] == 0 || alwaysVisible[i + k]) ? 1 : 0;
+        }
+    }
+#endif
+
+    for (; i < end; ++i)
+    {
+        bool outside = false;
+        for (uint32 p = 0; p < planes.count && !outside; ++p)
+        {
+            float32 dist = centerX[i] * planes.nx[p] + centerY[i] * planes.ny[p] + centerZ[i] * planes.nz[p] + planes.d[p];
+            float32 radius = extentX[i] * planes.absNx[p] + extentY[i] * planes.absNy[p] + extentZ[i] * planes.absNz[p];
+            outside = (dist - radius) > 0.0f;
+        }
+        clipResults[i] = (!outside || alwaysVisible[i]) ? 1 : 0;
+    }
+}
+
+void FlatRenderHierarchy::Clip(Camera* camera, Vector<RenderObject*>& visibilityArray, uint32 visibilityCriteria)
+{
+    Frustum* frustum = camera->GetFrustum();
+
+    ClipPlanes planes;
+    planes.count = static_cast<uint32>(std::min(frustum->GetPlaneCount(), 6));
+    for (uint32 p = 0; p < planes.count; ++p)
+    {
+        const Plane& plane = frustum->GetPlane(p);
+        planes.nx[p] = plane.n.x;
+        planes.ny[p] = plane.n.y;
+        planes.nz[p] = plane.n.z;
+        planes.absNx[p] = std::abs(plane.n.x);
+        planes.absNy[p] = std::abs(plane.n.y);
+        planes.absNz[p] = std::abs(plane.n.z);
+        planes.d[p] = plane.d;
+    }
+
+    // results are needed only during this call, so they are placed in frame arena
+    uint32 count = static_cast<uint32>(objects.size());
+    uint8* clipResults = static_cast<uint8*>(Renderer::GetFrameArena().Allocate(count, alignof(uint8)));
+
+    ParallelForOrSerial(0, count, CLIP_CHUNK_SIZE, [this, &planes, clipResults](uint32 begin, uint32 end) {
+        ClipRange(planes, begin, end, clipResults);
+    });
+
+    // objects are gathered in one thread to keep order of visibility array stable
+    for (uint32 i = 0; i < count; ++i)
+    {
+        if (clipResults[i] != 0)
+        {
+            RenderObject* renderObject = objects[i];
+            if ((renderObject->GetFlags() & visibilityCriteria) == visibilityCriteria)
+            {
+                visibilityArray.push_back(renderObject);
+#if defined(__DAVAENGINE_RENDERSTATS__)
+                ++Renderer::GetRenderStats().visibleRenderObjects;
+#endif
+            }
+        }
+    }
+}
+
+void FlatRenderHierarchy::GetAllObjectsInBBox(const AABBox3& bbox, Vector<RenderObject*>& visibilityArray)
+{
+    Vector3 center = bbox.GetCenter();
+    Vector3 extent = (bbox.max - bbox.min) * 0.5f;
+
+    uint32 count = static_cast<uint32>(objects.size());
+    for (uint32 i = 0; i < count; ++i)
+    {
+        if (std::abs(centerX[i] - center.x) <= extentX[i] + extent.x
+            && std::abs(centerY[i] - center.y) <= extentY[i] + extent.y
+            && std::abs(centerZ[i] - center.z) <= extentZ[i] + extent.z)
+        {
+            visibilityArray.push_back(objects[i]);
+        }
+    }
+}
+
+bool FlatRenderHierarchy::RayTrace(const Ray3& ray, RayTraceCollision& collision, const Vector<RenderObject*>& ignoreObjects)
+{
+    broadPhaseCollisions.clear();
+
+    uint32 count = static_cast<uint32>(objects.size());
+    for (uint32 i = 0; i < count; ++i)
+    {
+        if (extentX[i] < 0.0f)
+        {
+            continue;
+        }
+
+        Vector3 center(centerX[i], centerY[i], centerZ[i]);
+        Vector3 extent(extentX[i], extentY[i], extentZ[i]);
+        AABBox3 objectBox(center - extent, center + extent);
+
+        float32 tMin, tMax;
+        if (Intersection::RayBox(ray, objectBox, tMin, tMax))
+        {
+            auto lambda = [](const BroadPhaseCollision& pair, float val) -> bool { return pair.first < val; };
+            auto it = std::lower_bound(broadPhaseCollisions.begin(), broadPhaseCollisions.end(), tMin, lambda);
+            broadPhaseCollisions.insert(it, { tMin, objects[i] });
+        }
+    }
+
+    bool intersectionFound = false;
+    float32 closestT = FLOAT_MAX;
+
+    for (auto& pair : broadPhaseCollisions)
+    {
+        RenderObject* ro = pair.second;
+        if (std::find(std::begin(ignoreObjects), std::end(ignoreObjects), ro) != std::end(ignoreObjects))
+        {
+            continue;
+        }
+
+        if (pair.first > closestT)
+            break;
+
+        Vector3 rayOrigin = ray.origin * ro->GetInverseWorldTransform();
+        Vector3 rayDirection = MultiplyVectorMat3x3(ray.direction, ro->GetInverseWorldTransform());
+        Ray3Optimized rayInObjectSpace(rayOrigin, rayDirection);
+
+        uint32 activeBatchesCount = ro->GetActiveRenderBatchCount();
+        for (uint32 bi = 0; bi < activeBatchesCount; ++bi)
+        {
+            RenderBatch* rb = ro->GetActiveRenderBatch(bi);
+            DVASSERT(rb != nullptr);
+            PolygonGroup* geo = rb->GetPolygonGroup();
+
+            if (geo)
+            {
+                GeometryOctTree* geometryOctTree = geo->GetGeometryOctTree();
+                if (geometryOctTree)
+                {
+                    float32 currentT;
+                    uint32 currentTriangleIndex;
+
+                    if (geometryOctTree->IntersectionWithRay(rayInObjectSpace, currentT, currentTriangleIndex))
+                    {
+                        if (currentT < closestT)
+                        {
+                            intersectionFound = true;
+                            closestT = currentT;
+
+                            collision.renderObject = ro;
+                            collision.geometry = geo;
+                            collision.t = currentT;
+                            collision.triangleIndex = currentTriangleIndex;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (ro->GetType() == RenderObject::TYPE_LANDSCAPE)
+        {
+            Landscape* landscape = static_cast<Landscape*>(ro);
+            float32 currentT;
+            if (landscape->RayTrace(rayInObjectSpace, currentT))
+            {
+                if (currentT < closestT)
+                {
+                    intersectionFound = true;
+                    closestT = currentT;
+
+                    collision.renderObject = ro;
+                    collision.geometry = 0;
+                    collision.t = currentT;
+                    collision.triangleIndex = 0;
+                }
+            }
+        }
+    }
+
+    return intersectionFound;
+}
+}
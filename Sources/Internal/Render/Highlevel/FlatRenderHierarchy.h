@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Render/Highlevel/RenderHierarchy.h"
+
+namespace DAVA
+{
+/**
+    Render hierarchy without spatial subdivision.
+
+    World bounding boxes of objects are kept in contiguous structure-of-arrays as centers and extents,
+    so clipping is a linear pass that tests four boxes at a time against frustum planes with SIMD.
+    For big scenes the pass is split into chunks executed by worker threads (see `JobManager::ParallelFor`).
+    Object flags are checked only for objects that passed frustum test.
+
+    Index of object in arrays is stored in `RenderObject::treeNodeIndex`, so number of objects is limited by 65535.
+*/
+class FlatRenderHierarchy : public RenderHierarchy
+{
+public:
+    void AddRenderObject(RenderObject* renderObject) override;
+    void RemoveRenderObject(RenderObject* renderObject) override;
+    void ObjectUpdated(RenderObject* renderObject) override;
+    void Clip(Camera* camera, Vector<RenderObject*>& visibilityArray, uint32 visibilityCriteria) override;
+    void GetAllObjectsInBBox(const AABBox3& bbox, Vector<RenderObject*>& visibilityArray) override;
+    bool RayTrace(const Ray3& ray, RayTraceCollision& collision,
+                  const Vector<RenderObject*>& ignoreObjects) override;
+    void PrepareForShutdown() override;
+    const AABBox3& GetWorldBoundingBox() const override;
+
+    /** Number of objects clipped by one job. */
+    static const uint32 CLIP_CHUNK_SIZE = 2048;
+
+private:
+    struct ClipPlanes;
+
+    void SetObjectBox(uint32 index, const AABBox3& box);
+    void ClipRange(const ClipPlanes& planes, uint32 begin, uint32 end, uint8* clipResults) const;
+
+    Vector<RenderObject*> objects;
+
+    Vector<float32> centerX;
+    Vector<float32> centerY;
+    Vector<float32> centerZ;
+    Vector<float32> extentX;
+    Vector<float32> extentY;
+    Vector<float32> extentZ;
+    Vector<uint8> alwaysVisible;
+
+    Vector<BroadPhaseCollision> broadPhaseCollisions;
+    AABBox3 worldBBox = AABBox3();
+};
+
+inline const AABBox3& FlatRenderHierarchy::GetWorldBoundingBox() const
+{
+    return worldBBox;
+}
+}
@@ -1,47 +1,94 @@
 #include "Render/Highlevel/RenderBatchArray.h"
 #include "Render/Highlevel/RenderSystem.h"
 #include "Render/Highlevel/RenderPass.h"
+#include "Render/Renderer.h"
 
 namespace DAVA
 {
+namespace RenderBatchArrayDetails
+{
+//  Batches are drawn in ascending order of 64-bit sorting keys:
+//
+//  SORT_BY_MATERIAL                  (k:4)(shader:16)(material:16)(textures:12)(depth:16)
+//  SORT_BY_DISTANCE_BACK_TO_FRONT    (k:4)(0:28)(inverted distance:32)
+//  SORT_BY_DISTANCE_FRONT_TO_BACK    (k:4)(0:28)(distance:32)
+//
+//  'k' is inverted batch sorting key, so batches with greater key are drawn first.
+//  Shader, material and textures are hashed pointers/handles: they only group batches with equal states.
+//  Depth is a coarse front-to-back bucket inside a group of batches with equal states.
+
+const uint32 LAYER_KEY_SHIFT = 60;
+
+inline uint64 LayerKey(const RenderBatch* batch)
+{
+    return uint64(0x0F - (batch->GetSortingKey() & 0x0F)) << LAYER_KEY_SHIFT;
+}
+
+inline uint64 HashBits(uint64 value, uint32 bits)
+{
+    return (value * 0x9E3779B97F4A7C15ull) >> (64 - bits);
+}
+
+// for non-negative floats IEEE representation grows monotonically with value,
+// so upper bits of representation give logarithmic depth buckets
+inline uint64 DepthBucket(float32 distance)
+{
+    uint32 bits = 0;
+    Memcpy(&bits, &distance, sizeof(bits));
+    return bits >> 16;
+}
+}
+
 RenderBatchArray::RenderBatchArray()
-    : sortFlags(0)
+    : renderBatchArray(FrameArenaAllocator<RenderBatch*>(&Renderer::GetFrameArena()))
+    , sortFlags(0)
 {
     //sortFlags = SORT_ENABLED | SORT_BY_MATERIAL | SORT_BY_DISTANCE;
     //renderBatchArray.reserve(4096);
 }
 
-bool RenderBatchArray::MaterialCompareFunction(const RenderBatch* a, const RenderBatch* b)
+void RenderBatchArray::Clear()
 {
-    return a->layerSortingKey > b->layerSortingKey;
+    // storage of previous frame can be already reused by arena, so array is recreated
+    // with capacity of previous frame to avoid reallocations while adding batches
+    size_t lastCount = renderBatchArray.size();
+    renderBatchArray = FrameVector<RenderBatch*>(FrameArenaAllocator<RenderBatch*>(&Renderer::GetFrameArena()));
+    renderBatchArray.reserve(lastCount);
 }
 
 void RenderBatchArray::Sort(Camera* camera)
 {
+    using namespace RenderBatchArrayDetails;
+
     // Need sort
     sortFlags |= SORT_REQUIRED;
 
     if ((sortFlags & SORT_THIS_FRAME) == SORT_THIS_FRAME)
     {
+        uint32 count = GetRenderBatchCount();
+        RadixSortItem* sortItems = static_cast<RadixSortItem*>(Renderer::GetFrameArena().Allocate(count * sizeof(RadixSortItem), alignof(RadixSortItem)));
+
         if (sortFlags & SORT_BY_MATERIAL)
         {
-            //Vector3 cameraPosition = camera->GetPosition();
+            Vector3 cameraPosition = camera->GetPosition();
 
-            for (RenderBatch* batch : renderBatchArray)
+            for (uint32 i = 0; i < count; ++i)
             {
-                //pointer_size renderObjectId = (pointer_size)batch->GetRenderObject();
-                //RenderObject * renderObject = batch->GetRenderObject();
-                //Vector3 position = renderObject->GetWorldBoundingBox().GetCenter();
-                //float32 distance = (position - cameraPosition).Length();
-                //uint32 distanceBits = (0xFFFF - ((uint32)distance) & 0xFFFF);
-                uint32 materialIndex = batch->GetMaterial()->GetSortingKey();
-                //VI: sorting key has the following layout: (m:8)(s:4)(d:20)
-                //batch->layerSortingKey = (pointer_size)((materialIndex << 20) | (batch->GetSortingKey() << 28) | (distanceBits));
-                batch->layerSortingKey = static_cast<pointer_size>((materialIndex & 0x0FFFFFFF) | (batch->GetSortingKey() << 28));
-                //batch->layerSortingKey = (pointer_size)((batch->GetMaterial()->GetSortingKey() << 20) | (batch->GetSortingKey() << 28) | (renderObjectId & 0x000FFFFF));
+                RenderBatch* batch = renderBatchArray[i];
+                NMaterial* material = batch->GetMaterial();
+
+                Vector3 position = batch->GetRenderObject()->GetWorldBoundingBox().GetCenter();
+                float32 distance = (position - cameraPosition).SquareLength();
+
+                uint64 key = LayerKey(batch);
+                key |= HashBits(material->GetShaderSortingKey(), 16) << 44;
+                key |= HashBits(material->GetSortingKey(), 16) << 28;
+                key |= HashBits(material->GetTextureSetSortingKey(), 12) << 16;
+                key |= DepthBucket(distance);
+                sortItems[i] = { key, i };
             }
 
-            std::sort(renderBatchArray.begin(), renderBatchArray.end(), MaterialCompareFunction);
+            SortByKeys(sortItems);
 
             sortFlags &= ~SORT_REQUIRED;
         }
@@ -50,15 +97,16 @@ void RenderBatchArray::Sort(Camera* camera)
             Vector3 cameraPosition = camera->GetPosition();
             Vector3 cameraDirection = camera->GetDirection();
 
-            for (RenderBatch* batch : renderBatchArray)
+            for (uint32 i = 0; i < count; ++i)
             {
+                RenderBatch* batch = renderBatchArray[i];
                 Vector3 delta = batch->GetRenderObject()->GetWorldTransformPtr()->GetTranslationVector() - cameraPosition;
                 uint32 distance = delta.DotProduct(cameraDirection) < 0 ? 0 : (static_cast<uint32>(delta.Length() * 1000.0f)); //x1000.0f is to prevent resorting of nearby objects (still 26 km range)
                 distance = distance + 31 - batch->GetSortingOffset();
-                batch->layerSortingKey = (distance & 0x0fffffff) | (batch->GetSortingKey() << 28);
+                sortItems[i] = { LayerKey(batch) | (0xFFFFFFFFu - distance), i };
             }
 
-            std::stable_sort(renderBatchArray.begin(), renderBatchArray.end(), MaterialCompareFunction);
+            SortByKeys(sortItems);
 
             sortFlags |= SORT_REQUIRED;
         }
@@ -66,20 +114,40 @@ void RenderBatchArray::Sort(Camera* camera)
         {
             Vector3 cameraPosition = camera->GetPosition();
 
-            for (RenderBatch* batch : renderBatchArray)
+            for (uint32 i = 0; i < count; ++i)
             {
+                RenderBatch* batch = renderBatchArray[i];
                 RenderObject* renderObject = batch->GetRenderObject();
                 Vector3 position = renderObject->GetWorldBoundingBox().GetCenter();
                 uint32 distance = static_cast<uint32>((position - cameraPosition).Length() * 100.0f) + 31 - batch->GetSortingOffset();
-                uint32 distanceBits = 0x0fffffff - distance & 0x0fffffff;
-
-                batch->layerSortingKey = distanceBits | (batch->GetSortingKey() << 28);
+                sortItems[i] = { LayerKey(batch) | distance, i };
             }
 
-            std::sort(renderBatchArray.begin(), renderBatchArray.end(), MaterialCompareFunction);
+            SortByKeys(sortItems);
 
             sortFlags |= SORT_REQUIRED;
         }
     }
 }
+
+void RenderBatchArray::SortByKeys(RadixSortItem* sortItems)
+{
+    uint32 count = GetRenderBatchCount();
+    if (count < 2)
+    {
+        return;
+    }
+
+    FrameArena& arena = Renderer::GetFrameArena();
+    RadixSortItem* sortItemsTemp = static_cast<RadixSortItem*>(arena.Allocate(count * sizeof(RadixSortItem), alignof(RadixSortItem)));
+    RadixSort(sortItems, sortItemsTemp, count);
+
+    FrameVector<RenderBatch*> sortedBatches(count, nullptr, renderBatchArray.get_allocator());
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        sortedBatches[i] = renderBatchArray[sortItems[i].value];
+    }
+    renderBatchArray.swap(sortedBatches);
+}
 };
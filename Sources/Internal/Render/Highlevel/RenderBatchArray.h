@@ -2,6 +2,8 @@
 
 #include "Base/BaseTypes.h"
 #include "Base/FastName.h"
+#include "Base/FrameArena.h"
+#include "Base/Radix/Radix.h"
 #include "Reflection/Reflection.h"
 #include "Render/Highlevel/RenderBatch.h"
 
@@ -24,7 +26,8 @@ public:
 
     RenderBatchArray();
 
-    inline void Clear();
+    /** Remove all batches. Batches are stored in frame arena, so array should be cleared every frame before adding batches. */
+    void Clear();
     inline void AddRenderBatch(RenderBatch* batch);
     inline uint32 GetRenderBatchCount() const;
     inline RenderBatch* Get(uint32 index) const;
@@ -33,16 +36,12 @@ public:
     inline void SetSortingFlags(uint32 flags);
 
 private:
-    Vector<RenderBatch*> renderBatchArray;
+    void SortByKeys(RadixSortItem* sortItems);
+
+    FrameVector<RenderBatch*> renderBatchArray;
     uint32 sortFlags;
-    static bool MaterialCompareFunction(const RenderBatch* a, const RenderBatch* b);
 };
 
-inline void RenderBatchArray::Clear()
-{
-    renderBatchArray.clear();
-}
-
 inline void RenderBatchArray::AddRenderBatch(RenderBatch* batch)
 {
     renderBatchArray.push_back(batch);
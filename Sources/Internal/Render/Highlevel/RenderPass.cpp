@@ -9,6 +9,7 @@
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
 #include "Concurrency/Thread.h"
+#include "Time/SystemTimer.h"
 
 #include "Render/Renderer.h"
 #include "Render/Texture.h"
@@ -44,7 +45,7 @@ RenderPass::RenderPass(const FastName& _name)
 
 RenderPass::~RenderPass()
 {
-    ClearLayersArrays();
+    // layers batch arrays don't own batches and are not cleared, Clear would allocate from frame arena
     for (RenderLayer* layer : renderLayers)
     {
         SafeDelete(layer);
@@ -127,7 +128,7 @@ void RenderPass::PrepareVisibilityArrays(Camera* camera, RenderSystem* renderSys
     PrepareLayersArrays(visibilityArray, camera);
 }
 
-void RenderPass::PrepareLayersArrays(const Vector<RenderObject*> objectsArray, Camera* camera)
+void RenderPass::PrepareLayersArrays(const Vector<RenderObject*>& objectsArray, Camera* camera)
 {
     size_t size = objectsArray.size();
     for (size_t ro = 0; ro < size; ++ro)
@@ -172,8 +173,18 @@ void RenderPass::DrawLayers(Camera* camera)
     {
         RenderLayer* layer = renderLayers[k];
         RenderBatchArray& batchArray = layersBatchArrays[layer->GetRenderLayerID()];
+
+#if defined(__DAVAENGINE_RENDERSTATS__)
+        int64 sortStartTime = SystemTimer::GetNs();
         batchArray.Sort(camera);
 
+        RenderStats::LayerSortStats& sortStats = Renderer::GetRenderStats().layersSortStats[RenderLayer::GetLayerNameByID(layer->GetRenderLayerID())];
+        sortStats.sortedBatches += batchArray.GetRenderBatchCount();
+        sortStats.sortTimeNs += static_cast<uint64>(SystemTimer::GetNs() - sortStartTime);
+#else
+        batchArray.Sort(camera);
+#endif
+
         layer->Draw(camera, batchArray, packetList);
     }
 }
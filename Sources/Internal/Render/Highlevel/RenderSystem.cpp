@@ -100,6 +100,26 @@ void RenderSystem::RemoveRenderObject(RenderObject* renderObject)
     renderObject->SetRenderSystem(nullptr);
 }
 
+void RenderSystem::SetRenderHierarchy(RenderHierarchy* hierarchy)
+{
+    DVASSERT(hierarchy != nullptr);
+    if (hierarchy == renderHierarchy)
+        return;
+
+    for (RenderObject* renderObject : renderObjectArray)
+    {
+        renderHierarchy->RemoveRenderObject(renderObject);
+    }
+    SafeDelete(renderHierarchy);
+
+    renderHierarchy = hierarchy;
+    hierarchyInitialized = false;
+    for (RenderObject* renderObject : renderObjectArray)
+    {
+        renderHierarchy->AddRenderObject(renderObject);
+    }
+}
+
 void RenderSystem::PrebuildMaterial(NMaterial* material)
 {
     //pre-build for all passes
@@ -96,6 +96,12 @@ public:
         return renderHierarchy;
     }
 
+    /**
+        Replace render hierarchy used for clipping, e.g. with `LinearRenderHierarchy` or `FlatRenderHierarchy`
+        instead of default `QuadTree`. Render system takes ownership of `hierarchy`, all render objects are moved into it.
+    */
+    void SetRenderHierarchy(RenderHierarchy* hierarchy);
+
     inline bool IsRenderHierarchyInitialized() const
     {
         return hierarchyInitialized;
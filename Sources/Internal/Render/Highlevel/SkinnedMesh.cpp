@@ -1,4 +1,3 @@
-#include "Scene3D/SkeletonAnimation/JointTransform.h"
 #include "Render/Highlevel/SkinnedMesh.h"
 #include "Render/Renderer.h"
 
@@ -93,7 +92,7 @@ void SkinnedMesh::BindDynamicParameters(Camera* camera, RenderBatch* batch)
     RenderObject::BindDynamicParameters(camera, batch);
 }
 
-void SkinnedMesh::UpdateJointTransforms(const Vector<JointTransform>& finalTransforms)
+void SkinnedMesh::UpdateJointTransforms(const Vector<Vector4>& finalPositions, const Vector<Vector4>& finalOrientations)
 {
     for (auto& jointsData : jointTargetsData)
     {
@@ -103,11 +102,10 @@ void SkinnedMesh::UpdateJointTransforms(const Vector<JointTransform>& finalTrans
         for (uint32 j = 0; j < data.jointsDataCount; ++j)
         {
             uint32 transformIndex = targets[j];
-            DVASSERT(transformIndex < uint32(finalTransforms.size()));
+            DVASSERT(transformIndex < uint32(finalPositions.size()));
 
-            const JointTransform& finalTransform = finalTransforms[transformIndex];
-            data.positions[j] = Vector4(Vector3(finalTransform.GetPosition().data), finalTransform.GetScale());
-            data.quaternions[j] = Vector4(finalTransform.GetOrientation().data);
+            data.positions[j] = finalPositions[transformIndex];
+            data.quaternions[j] = finalOrientations[transformIndex];
         }
     }
 }
@@ -15,7 +15,6 @@ class PolygonGroup;
 class RenderBatch;
 class ShadowVolume;
 class NMaterial;
-class JointTransform;
 class SkinnedMesh : public RenderObject
 {
 public:
@@ -41,7 +40,7 @@ public:
     void BindDynamicParameters(Camera* camera, RenderBatch* batch) override;
 
     void SetBoundingBox(const AABBox3& box);
-    void UpdateJointTransforms(const Vector<JointTransform>& finalTransforms);
+    void UpdateJointTransforms(const Vector<Vector4>& finalPositions, const Vector<Vector4>& finalOrientations);
 
     void SetJointTargets(RenderBatch* batch, const JointTargets& jointTargets);
 
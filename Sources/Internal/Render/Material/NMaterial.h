@@ -158,6 +158,9 @@ public:
 
     inline uint32 GetRenderLayerID() const;
     inline uint32 GetSortingKey() const;
+    // keys of shader and texture set of active render variant, batches with equal keys share these states
+    inline pointer_size GetShaderSortingKey() const;
+    inline uint32 GetTextureSetSortingKey() const;
 
     //Configs managment
     uint32 GetConfigCount() const;
@@ -286,6 +289,14 @@ uint32 NMaterial::GetSortingKey() const
 {
     return sortingKey;
 }
+pointer_size NMaterial::GetShaderSortingKey() const
+{
+    return (activeVariantInstance != nullptr) ? reinterpret_cast<pointer_size>(activeVariantInstance->shader) : 0;
+}
+uint32 NMaterial::GetTextureSetSortingKey() const
+{
+    return (activeVariantInstance != nullptr) ? static_cast<uint32>(activeVariantInstance->textureSet) : 0;
+}
 
 inline uint32 NMaterial::GetCurrentConfigIndex() const
 {
@@ -16,6 +16,8 @@ using DAVA::DynamicMemoryFile;
 #include "Concurrency/LockGuard.h"
 using DAVA::Mutex;
 using DAVA::LockGuard;
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
 
 #include "Parser/sl_Parser.h"
 #include "Parser/sl_Tree.h"
@@ -29,94 +31,75 @@ namespace rhi
 {
 //==============================================================================
 
-class ShaderFileCallback : public DAVA::PreProc::FileCallback
+// include files shared by all shader sources, sources can be pre-processed in several threads at once
+class ShaderIncludeCache
 {
 public:
-    ShaderFileCallback(const char* base_dir)
+    ShaderIncludeCache(const char* base_dir)
     {
         inclDir.emplace_back(base_dir);
     }
 
-    ~ShaderFileCallback()
+    ~ShaderIncludeCache()
     {
         ClearCache();
     }
 
-    bool Open(const char* file_name) override
+    // returned data stays valid until `ClearCache`
+    bool Find(const char* file_name, const void** data, unsigned* data_sz)
     {
-        bool success = false;
+        LockGuard<Mutex> guard(mutex);
 
         for (size_t k = 0; k != _file.size(); ++k)
         {
             if (_file[k].name == file_name)
             {
-                _cur_data = _file[k].data;
-                _cur_data_sz = _file[k].data_sz;
-                success = true;
-                break;
+                *data = _file[k].data;
+                *data_sz = _file[k].data_sz;
+                return true;
             }
         }
 
-        if (!success)
-        {
-            DAVA::File* in = nullptr;
-
-            for (const std::string& d : inclDir)
-            {
-                in = DAVA::File::Create(d + "/" + file_name, DAVA::File::READ | DAVA::File::OPEN);
+        DAVA::File* in = nullptr;
 
-                if (in)
-                    break;
-            }
+        for (const std::string& d : inclDir)
+        {
+            in = DAVA::File::Create(d + "/" + file_name, DAVA::File::READ | DAVA::File::OPEN);
 
             if (in)
-            {
-                file_t f;
-
-                f.name = file_name;
-                f.data_sz = unsigned(in->GetSize());
-                f.data = ::malloc(f.data_sz);
+                break;
+        }
 
-                in->Read(f.data, f.data_sz);
-                in->Release();
+        if (in)
+        {
+            file_t f;
 
-                _file.push_back(f);
-                _cur_data = f.data;
-                _cur_data_sz = f.data_sz;
+            f.name = file_name;
+            f.data_sz = unsigned(in->GetSize());
+            f.data = ::malloc(f.data_sz);
 
-                success = true;
-            }
-        }
+            in->Read(f.data, f.data_sz);
+            in->Release();
 
-        return success;
-    }
+            _file.push_back(f);
+            *data = f.data;
+            *data_sz = f.data_sz;
 
-    void Close() override
-    {
-        _cur_data = nullptr;
-        _cur_data_sz = 0;
-    }
+            return true;
+        }
 
-    unsigned Size() const override
-    {
-        return _cur_data_sz;
-    }
-
-    unsigned Read(unsigned max_sz, void* dst) override
-    {
-        DVASSERT(_cur_data);
-        DVASSERT(max_sz <= _cur_data_sz);
-        memcpy(dst, _cur_data, max_sz);
-        return max_sz;
+        return false;
     }
 
     void AddIncludeDirectory(const char* dir)
     {
+        LockGuard<Mutex> guard(mutex);
         inclDir.emplace_back(dir);
     }
 
     void ClearCache()
     {
+        LockGuard<Mutex> guard(mutex);
         for (size_t k = 0; k != _file.size(); ++k)
         {
             ::free(_file[k].data);
@@ -132,13 +115,44 @@ private:
         void* data;
     };
     std::vector<file_t> _file;
-    const void* _cur_data;
-    unsigned _cur_data_sz;
-
     std::vector<std::string> inclDir;
+    Mutex mutex;
 };
 
-static ShaderFileCallback ShaderSourceFileCallback("~res:/Materials/Shaders");
+static ShaderIncludeCache ShaderSourceIncludeCache("~res:/Materials/Shaders");
+
+// reads include files of one pre-processed source from shared cache
+class ShaderFileCallback : public DAVA::PreProc::FileCallback
+{
+public:
+    bool Open(const char* file_name) override
+    {
+        return ShaderSourceIncludeCache.Find(file_name, &_cur_data, &_cur_data_sz);
+    }
+
+    void Close() override
+    {
+        _cur_data = nullptr;
+        _cur_data_sz = 0;
+    }
+
+    unsigned Size() const override
+    {
+        return _cur_data_sz;
+    }
+
+    unsigned Read(unsigned max_sz, void* dst) override
+    {
+        DVASSERT(_cur_data);
+        DVASSERT(max_sz <= _cur_data_sz);
+        memcpy(dst, _cur_data, max_sz);
+        return max_sz;
+    }
+
+private:
+    const void* _cur_data = nullptr;
+    unsigned _cur_data_sz = 0;
+};
 
 //==============================================================================
 
@@ -171,7 +185,8 @@ bool ShaderSource::Construct(ProgType progType, const char* srcText)
 bool ShaderSource::Construct(ProgType progType, const char* srcText, const std::vector<std::string>& defines)
 {
     bool success = false;
-    DAVA::PreProc pre_proc(&ShaderSourceFileCallback);
+    ShaderFileCallback fileCallback;
+    DAVA::PreProc pre_proc(&fileCallback);
     std::vector<char> src;
 
     DVASSERT(defines.size() % 2 == 0);
@@ -1742,10 +1757,11 @@ const DAVA::String& ShaderSource::GetSourceCode(Api targetApi) const
 
     if (code[targetApi].empty() && (ast != nullptr))
     {
+        // allocator has no state, but generators are not shared, so sources can be constructed in several threads at once
         static sl::Allocator alloc;
-        static sl::HLSLGenerator hlsl_gen(&alloc);
-        static sl::GLESGenerator gles_gen(&alloc);
-        static sl::MSLGenerator mtl_gen(&alloc);
+        sl::HLSLGenerator hlsl_gen(&alloc);
+        sl::GLESGenerator gles_gen(&alloc);
+        sl::MSLGenerator mtl_gen(&alloc);
 
         bool codeGenerated = false;
         const char* main = (type == PROG_VERTEX) ? "vp_main" : "fp_main";
@@ -1898,12 +1914,12 @@ void ShaderSource::Reset()
 
 void ShaderSource::AddIncludeDirectory(const char* dir)
 {
-    ShaderSourceFileCallback.AddIncludeDirectory(dir);
+    ShaderSourceIncludeCache.AddIncludeDirectory(dir);
 }
 
 void ShaderSource::PurgeIncludesCache()
 {
-    ShaderSourceFileCallback.ClearCache();
+    ShaderSourceIncludeCache.ClearCache();
 }
 
 //------------------------------------------------------------------------------
@@ -2013,15 +2029,20 @@ void ShaderSource::Dump() const
 
 //==============================================================================
 
+// number of cached sources parsed by one worker job on load
+static const uint32 LOAD_ENTRIES_GRAIN = 16;
+
 //version increment history:
 //5 is for new shader language
 //6 is after fixing Add/Update problem
 //7 is after MCPP replaced with in-house pre-processor
 //8 blend-state
-const uint32 ShaderSourceCache::FormatVersion = 8;
+//9 size-prefixed entries, loaded in parallel
+const uint32 ShaderSourceCache::FormatVersion = 9;
 
 Mutex shaderSourceEntryMutex;
 std::vector<ShaderSourceCache::entry_t> ShaderSourceCache::Entry;
+std::unordered_map<FastName, size_t> ShaderSourceCache::EntryIndex[RHI_API_COUNT];
 
 const ShaderSource* ShaderSourceCache::Get(FastName uid, uint32 srcHash)
 {
@@ -2032,13 +2053,10 @@ const ShaderSource* ShaderSourceCache::Get(FastName uid, uint32 srcHash)
     const ShaderSource* src = nullptr;
     Api api = HostApi();
 
-    for (std::vector<entry_t>::const_iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
+    std::unordered_map<FastName, size_t>::const_iterator i = EntryIndex[api].find(uid);
+    if (i != EntryIndex[api].end() && Entry[i->second].srcHash == srcHash)
     {
-        if (e->uid == uid && e->api == api && e->srcHash == srcHash)
-        {
-            src = e->src;
-            break;
-        }
+        src = Entry[i->second].src;
     }
     //    Logger::Info("  %s",(src)?"found":"not found");
 
@@ -2057,20 +2075,15 @@ const ShaderSource* ShaderSourceCache::Add(const char* filename, FastName uid, P
         uint32 api = HostApi();
         uint32 srcHash = DAVA::HashValue_N(srcText, unsigned(strlen(srcText)));
 
-        bool doAdd = true;
-        for (std::vector<entry_t>::iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
+        std::unordered_map<FastName, size_t>::const_iterator i = EntryIndex[api].find(uid);
+        if (i != EntryIndex[api].end())
         {
-            if ((e->uid == uid) && (e->api == api))
-            {
-                DAVA::SafeDelete(e->src);
-                e->src = src;
-                e->srcHash = srcHash;
-                doAdd = false;
-                break;
-            }
+            entry_t& e = Entry[i->second];
+            DAVA::SafeDelete(e.src);
+            e.src = src;
+            e.srcHash = srcHash;
         }
-
-        if (doAdd)
+        else
         {
             entry_t e;
             e.uid = uid;
@@ -2078,6 +2091,7 @@ const ShaderSource* ShaderSourceCache::Add(const char* filename, FastName uid, P
             e.srcHash = srcHash;
             e.src = src;
 
+            EntryIndex[api][uid] = Entry.size();
             Entry.push_back(e);
         }
     }
@@ -2099,6 +2113,9 @@ void ShaderSourceCache::Clear()
     for (std::vector<entry_t>::const_iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
         delete e->src;
     Entry.clear();
+
+    for (uint32 api = 0; api != RHI_API_COUNT; ++api)
+        EntryIndex[api].clear();
 }
 
 //------------------------------------------------------------------------------
@@ -2137,10 +2154,16 @@ void ShaderSourceCache::Save(const char* fileName)
         WRITE_CHECK(WriteUI4(file, static_cast<uint32>(Entry.size())));
         for (std::vector<entry_t>::const_iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
         {
+            // each source is prefixed with its size, so sources can be loaded independently
+            ScopedPtr<DynamicMemoryFile> srcData(DynamicMemoryFile::Create(File::WRITE | File::CREATE));
+            WRITE_CHECK(e->src->Save(Api(e->api), srcData));
+
+            uint32 srcDataSize = static_cast<uint32>(srcData->GetDataVector().size());
             WRITE_CHECK(WriteS0(file, e->uid.c_str()));
             WRITE_CHECK(WriteUI4(file, e->api));
             WRITE_CHECK(WriteUI4(file, e->srcHash));
-            WRITE_CHECK(e->src->Save(Api(e->api), file));
+            WRITE_CHECK(WriteUI4(file, srcDataSize));
+            WRITE_CHECK((file->Write(srcData->GetData(), srcDataSize) == srcDataSize));
         }
         
 #undef WRITE_CHECK
@@ -2183,17 +2206,40 @@ void ShaderSourceCache::Load(const char* fileName)
             Entry.resize(entryCount);
             Logger::Info("loading cached-shaders (%u): ", Entry.size());
 
-            for (std::vector<entry_t>::iterator e = Entry.begin(), e_end = Entry.end(); e != e_end; ++e)
+            // read raw data of all sources first, parsing is done below in worker jobs
+            std::vector<std::vector<uint8>> srcData(entryCount);
+            for (uint32 i = 0; i != entryCount; ++i)
             {
+                entry_t& e = Entry[i];
                 std::string str;
                 READ_CHECK(ReadS0(file, &str));
-                e->uid = FastName(str.c_str());
-                READ_CHECK(ReadUI4(file, &e->api));
-                READ_CHECK(ReadUI4(file, &e->srcHash));
-                e->src = new ShaderSource();
-
-                READ_CHECK(e->src->Load(Api(e->api), file));
+                e.uid = FastName(str.c_str());
+                READ_CHECK(ReadUI4(file, &e.api));
+                READ_CHECK(ReadUI4(file, &e.srcHash));
+                READ_CHECK((e.api < RHI_API_COUNT));
+                e.src = new ShaderSource();
+
+                uint32 srcDataSize = 0;
+                READ_CHECK(ReadUI4(file, &srcDataSize));
+                READ_CHECK((srcDataSize <= file->GetSize() - file->GetPos()));
+                srcData[i].resize(srcDataSize);
+                READ_CHECK((file->Read(srcData[i].data(), srcDataSize) == srcDataSize));
+
+                EntryIndex[e.api][e.uid] = i;
             }
+
+            std::vector<uint8> loaded(entryCount, 0);
+            auto loadEntries = [&](uint32 begin, uint32 end) {
+                for (uint32 i = begin; i != end; ++i)
+                {
+                    ScopedPtr<DynamicMemoryFile> in(DynamicMemoryFile::Create(std::move(srcData[i]), File::READ | File::OPEN, FilePath()));
+                    loaded[i] = Entry[i].src->Load(Api(Entry[i].api), in) ? 1 : 0;
+                }
+            };
+
+            ParallelForOrSerial(0, entryCount, LOAD_ENTRIES_GRAIN, loadEntries);
+
+            READ_CHECK((std::find(loaded.begin(), loaded.end(), 0) == loaded.end()));
         }
         else
         {
@@ -138,6 +138,7 @@ private:
     };
 
     static std::vector<entry_t> Entry;
+    static std::unordered_map<FastName, size_t> EntryIndex[RHI_API_COUNT]; // index in `Entry` by uid, for every api
     static const uint32 FormatVersion;
 };
 
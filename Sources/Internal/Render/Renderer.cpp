@@ -9,6 +9,7 @@
 #include "Render/PixelFormatDescriptor.h"
 #include "Render/Image/Image.h"
 #include "Render/Texture.h"
+#include "Base/FrameArena.h"
 #include "Concurrency/Mutex.h"
 #include "Concurrency/LockGuard.h"
 #include "Platform/DeviceInfo.h"
@@ -28,6 +29,7 @@ RenderOptions renderOptions;
 DynamicBindings dynamicBindings;
 RuntimeTextures runtimeTextures;
 RenderStats stats;
+FrameArena frameArena;
 
 rhi::ResetParam resetParams;
 
@@ -100,6 +102,10 @@ void Initialize(rhi::Api _api, rhi::InitParam& params)
     resetParams.window = params.window;
     resetParams.fullScreen = params.fullScreen;
 
+    // frame data may be used until render thread executes the frame
+    uint32 renderThreadFrameCount = params.threadedRenderEnabled ? params.threadedRenderFrameCount : 0;
+    frameArena.SetBufferCount(renderThreadFrameCount + 1);
+
     initialized = true;
 
     //must be called after setting initialized in true
@@ -120,6 +126,7 @@ void Uninitialize()
 {
     DVASSERT(RendererDetails::initialized);
 
+    RendererDetails::frameArena.SetBufferCount(1);
     VisibilityQueryResults::Cleanup();
     FXCache::Uninitialize();
     ShaderDescriptorCache::Uninitialize();
@@ -191,6 +198,11 @@ RenderStats& GetRenderStats()
     return RendererDetails::stats;
 }
 
+FrameArena& GetFrameArena()
+{
+    return RendererDetails::frameArena;
+}
+
 RenderSignals& GetSignals()
 {
     return RendererDetails::signals;
@@ -211,6 +223,7 @@ void BeginFrame()
     RendererDetails::ProcessSignals();
 
     DynamicBufferAllocator::BeginFrame();
+    RendererDetails::frameArena.BeginFrame();
 }
 
 void EndFrame()
@@ -304,6 +317,7 @@ void RenderStats::Reset()
     occludedRenderObjects = 0U;
 
     visibilityQueryResults.clear();
+    layersSortStats.clear();
 }
 
 } //ns DAVA
@@ -12,6 +12,7 @@ namespace DAVA
 {
 struct RenderStats;
 struct RenderSignals;
+class FrameArena;
 
 namespace Renderer
 {
@@ -50,6 +51,9 @@ RuntimeTextures& GetRuntimeTextures();
 //render stats
 RenderStats& GetRenderStats();
 
+//arena for transient frame data, buffers are switched in BeginFrame
+FrameArena& GetFrameArena();
+
 //signals
 RenderSignals& GetSignals();
 
@@ -95,5 +99,12 @@ struct RenderStats
     uint32 occludedRenderObjects = 0U;
 
     UnorderedMap<FastName, uint32> visibilityQueryResults = UnorderedMap<FastName, uint32>(16);
+
+    struct LayerSortStats
+    {
+        uint32 sortedBatches = 0U;
+        uint64 sortTimeNs = 0U;
+    };
+    UnorderedMap<FastName, LayerSortStats> layersSortStats = UnorderedMap<FastName, LayerSortStats>(16); // by render layer name
 };
 }
@@ -43,6 +43,7 @@ namespace ShaderDescriptorCache
 {
 ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines);
 void ReloadShaders();
+void SaveWarmupList(const FilePath& pathname);
 }
 
 class ShaderDescriptor
@@ -114,6 +115,7 @@ private:
 
     friend ShaderDescriptor* ShaderDescriptorCache::GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines);
     friend void ShaderDescriptorCache::ReloadShaders();
+    friend void ShaderDescriptorCache::SaveWarmupList(const FilePath& pathname);
 };
 
 inline bool ShaderDescriptor::IsValid()
@@ -5,6 +5,8 @@
 #include "Logger/Logger.h"
 #include "Utils/StringFormat.h"
 #include "Render/RHI/rhi_ShaderSource.h"
+#include "Time/SystemTimer.h"
+#include "Job/JobManager.h"
 
 #define RHI_TRACE_CACHE_USAGE 0
 
@@ -31,6 +33,22 @@ Map<FastName, ShaderSourceCode> shaderSourceCodes;
 Mutex shaderCacheMutex;
 bool loadingNotifyEnabled = false;
 bool initialized = false;
+
+const uint32 WARMUP_LIST_VERSION = 1;
+// number of warmup list shaders built by one worker job
+const uint32 PREWARM_SHADERS_GRAIN = 4;
+
+struct WarmupShader
+{
+    FastName name;
+    UnorderedMap<FastName, int32> defines;
+
+    bool needBuild = false;
+    Vector<String> progDefines;
+    FastName vProgUid;
+    FastName fProgUid;
+    const ShaderSourceCode* sourceCode = nullptr;
+};
 }
 
 void Initialize()
@@ -189,20 +207,9 @@ void SetLoadingNotifyEnabled(bool enable)
 #define LOG_TRACE_USAGE(...)
 #endif
 
-ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines)
+// fill defines passed to shader pre-processor, sorted by name, and return name of resulting program
+String BuildProgramDefines(const FastName& name, const UnorderedMap<FastName, int32>& defines, Vector<String>& progDefines)
 {
-    DVASSERT(initialized);
-
-    LockGuard<Mutex> guard(shaderCacheMutex);
-
-    Vector<size_t> key = BuildFlagsKey(name, defines);
-
-    auto descriptorIt = shaderDescriptors.find(key);
-    if (descriptorIt != shaderDescriptors.end())
-        return descriptorIt->second;
-
-    //not found - create new shader
-    Vector<String> progDefines;
     progDefines.reserve(defines.size() * 2);
     String resName(name.c_str());
     resName += "  defines: ";
@@ -231,6 +238,25 @@ ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<F
     for (size_t i = 0; i != progDefines.size(); i += 2)
         resName += Format("%s = %s, ", progDefines[i + 0].c_str(), progDefines[i + 1].c_str());
 
+    return resName;
+}
+
+ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines)
+{
+    DVASSERT(initialized);
+
+    LockGuard<Mutex> guard(shaderCacheMutex);
+
+    Vector<size_t> key = BuildFlagsKey(name, defines);
+
+    auto descriptorIt = shaderDescriptors.find(key);
+    if (descriptorIt != shaderDescriptors.end())
+        return descriptorIt->second;
+
+    //not found - create new shader
+    Vector<String> progDefines;
+    String resName = BuildProgramDefines(name, defines, progDefines);
+
     if (loadingNotifyEnabled)
     {
         Logger::Error("Forbidden call to GetShaderDescriptor %s", resName.c_str());
@@ -394,5 +420,165 @@ void ReloadShaders()
         }
     }
 }
+
+void SaveWarmupList(const FilePath& pathname)
+{
+    DVASSERT(initialized);
+
+    ScopedPtr<File> file(File::Create(pathname, File::CREATE | File::WRITE));
+    if (!file)
+    {
+        Logger::Error("Failed to save shaders warmup list %s", pathname.GetAbsolutePathname().c_str());
+        return;
+    }
+
+    bool written = true;
+    {
+        LockGuard<Mutex> guard(shaderCacheMutex);
+
+        uint32 count = 0;
+        for (const auto& it : shaderDescriptors)
+        {
+            if (it.second->valid)
+                ++count;
+        }
+
+        written &= (file->Write(&WARMUP_LIST_VERSION) == sizeof(WARMUP_LIST_VERSION));
+        written &= (file->Write(&count) == sizeof(count));
+        for (const auto& it : shaderDescriptors)
+        {
+            const ShaderDescriptor* shader = it.second;
+            if (!written)
+                break;
+            if (!shader->valid)
+                continue;
+
+            uint32 definesCount = static_cast<uint32>(shader->defines.size());
+            written &= file->WriteString(String(shader->sourceName.c_str()));
+            written &= (file->Write(&definesCount) == sizeof(definesCount));
+            for (const auto& define : shader->defines)
+            {
+                written &= file->WriteString(String(define.first.c_str()));
+                written &= (file->Write(&define.second) == sizeof(define.second));
+            }
+        }
+    }
+
+    written &= file->Flush();
+    if (!written)
+    {
+        // partially written list is removed, so next launch doesn't prewarm wrong shaders
+        Logger::Error("Failed to write shaders warmup list %s", pathname.GetAbsolutePathname().c_str());
+        file = nullptr;
+        FileSystem::Instance()->DeleteFile(pathname);
+    }
+}
+
+void Prewarm(const FilePath& pathname)
+{
+    DVASSERT(initialized);
+
+    ScopedPtr<File> file(File::Create(pathname, File::OPEN | File::READ));
+    if (!file)
+        return;
+
+    uint32 version = 0;
+    uint32 count = 0;
+    if (file->Read(&version) != sizeof(version) || version != WARMUP_LIST_VERSION || file->Read(&count) != sizeof(count))
+    {
+        Logger::Warning("Shaders warmup list %s is not valid, ignoring it", pathname.GetAbsolutePathname().c_str());
+        return;
+    }
+
+    int64 startTime = SystemTimer::GetMs();
+
+    Vector<WarmupShader> shaders;
+    shaders.reserve(count);
+
+    String str;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        WarmupShader shader;
+
+        str.clear();
+        if (file->ReadString(str) == 0)
+            break;
+        shader.name = FastName(str);
+
+        uint32 definesCount = 0;
+        if (file->Read(&definesCount) != sizeof(definesCount))
+            break;
+
+        bool definesRead = true;
+        for (uint32 d = 0; d < definesCount && definesRead; ++d)
+        {
+            int32 value = 0;
+            str.clear();
+            definesRead = (file->ReadString(str) != 0 && file->Read(&value) == sizeof(value));
+            shader.defines[FastName(str)] = value;
+        }
+        if (!definesRead)
+            break;
+
+        shaders.push_back(std::move(shader));
+    }
+
+    if (shaders.size() != count)
+    {
+        Logger::Warning("Shaders warmup list %s is truncated, prewarming %u of %u shaders", pathname.GetAbsolutePathname().c_str(), uint32(shaders.size()), count);
+    }
+
+    {
+        // other threads don't replace sources in rhi::ShaderSourceCache while they are built
+        LockGuard<Mutex> guard(shaderCacheMutex);
+
+        Set<Vector<size_t>> keys;
+        for (WarmupShader& shader : shaders)
+        {
+            Vector<size_t> key = BuildFlagsKey(shader.name, shader.defines);
+            shader.needBuild = (shaderDescriptors.count(key) == 0) && keys.insert(key).second;
+            if (shader.needBuild)
+            {
+                String resName = BuildProgramDefines(shader.name, shader.defines, shader.progDefines);
+                shader.vProgUid = FastName(String("vSource: ") + resName);
+                shader.fProgUid = FastName(String("fSource: ") + resName);
+                shader.sourceCode = &GetSourceCode(shader.name);
+            }
+        }
+
+        // pre-processing, parsing and code generation of sources are done in worker jobs
+        ParallelForOrSerial(0, static_cast<uint32>(shaders.size()), PREWARM_SHADERS_GRAIN, [&shaders](uint32 begin, uint32 end) {
+            for (uint32 i = begin; i != end; ++i)
+            {
+                const WarmupShader& shader = shaders[i];
+                if (!shader.needBuild)
+                    continue;
+
+                const ShaderSourceCode& sourceCode = *shader.sourceCode;
+                if (rhi::ShaderSourceCache::Get(shader.vProgUid, sourceCode.vSrcHash) == nullptr)
+                {
+                    rhi::ShaderSourceCache::Add(sourceCode.vertexProgSourcePath.GetFrameworkPath().c_str(), shader.vProgUid, rhi::PROG_VERTEX, sourceCode.vertexProgText.data(), shader.progDefines);
+                }
+                if (rhi::ShaderSourceCache::Get(shader.fProgUid, sourceCode.fSrcHash) == nullptr)
+                {
+                    rhi::ShaderSourceCache::Add(sourceCode.fragmentProgSourcePath.GetFrameworkPath().c_str(), shader.fProgUid, rhi::PROG_FRAGMENT, sourceCode.fragmentProgText.data(), shader.progDefines);
+                }
+            }
+        });
+    }
+
+    // pipeline states are created and descriptors are published on calling thread, sources are taken from cache
+    uint32 builtCount = 0;
+    for (const WarmupShader& shader : shaders)
+    {
+        if (shader.needBuild)
+        {
+            GetShaderDescriptor(shader.name, shader.defines);
+            ++builtCount;
+        }
+    }
+
+    Logger::Info("Prewarmed %u shaders in %lld ms", builtCount, SystemTimer::GetMs() - startTime);
+}
 }
 };
@@ -19,5 +19,14 @@ void SetLoadingNotifyEnabled(bool enable);
 ShaderDescriptor* GetShaderDescriptor(const FastName& name, const UnorderedMap<FastName, int32>& defines);
 Vector<size_t> BuildFlagsKey(const FastName& name, const UnorderedMap<FastName, int32>& defines);
 size_t GetUniqueFlagKey(FastName flagName);
+
+/** Save names and defines of all valid shader descriptors to `pathname`, to be created by `Prewarm` on next launch. */
+void SaveWarmupList(const FilePath& pathname);
+/**
+    Create shader descriptors listed in file written by `SaveWarmupList`, so they are not built on first use.
+    Shader sources are pre-processed and parsed in worker jobs, pipeline states are created on calling thread.
+    Should be called from main thread.
+*/
+void Prewarm(const FilePath& pathname);
 };
 };
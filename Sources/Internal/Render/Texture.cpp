@@ -456,28 +456,41 @@ Texture* Texture::CreateFromImage(TextureDescriptor* descriptor, eGPUFamily gpu)
 }
 
 bool Texture::LoadImages(eGPUFamily gpu, Vector<Image*>* images)
+{
+    if (!LoadDescriptorImages(texDescriptor, gpu, images))
+    {
+        return false;
+    }
+
+    isPink = false;
+    state = STATE_DATA_LOADED;
+
+    return true;
+}
+
+bool Texture::LoadDescriptorImages(const TextureDescriptor* descriptor, eGPUFamily gpu, Vector<Image*>* images)
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
 
     DVASSERT(gpu != GPU_INVALID);
 
-    if (!IsLoadAvailable(gpu))
+    if (!IsLoadAvailable(descriptor, gpu))
     {
         Logger::Error("[Texture::LoadImages] Load not available: invalid requested GPU family (%s)", GlobalEnumMap<eGPUFamily>::Instance()->ToString(gpu));
         return false;
     }
 
-    uint32 baseMipMap = GetBaseMipMap();
+    uint32 baseMipMap = GetBaseMipMap(descriptor);
     ImageSystem::LoadingParams params;
     params.baseMipmap = baseMipMap;
     params.firstMipmapIndex = 0;
     params.minimalWidth = Texture::MINIMAL_WIDTH;
     params.minimalHeight = Texture::MINIMAL_HEIGHT;
 
-    if (texDescriptor->IsCubeMap() && (!GPUFamilyDescriptor::IsGPUForDevice(gpu)))
+    if (descriptor->IsCubeMap() && (!GPUFamilyDescriptor::IsGPUForDevice(gpu)))
     {
         Vector<FilePath> facePathes;
-        texDescriptor->GetFacePathnames(facePathes);
+        descriptor->GetFacePathnames(facePathes);
 
         PixelFormat imagesFormat = FORMAT_INVALID;
         for (uint32 i = 0; i < CUBE_FACE_COUNT; ++i)
@@ -515,7 +528,7 @@ bool Texture::LoadImages(eGPUFamily gpu, Vector<Image*>* images)
             }
             //end of cubemap formats validation
 
-            if (texDescriptor->GetGenerateMipMaps())
+            if (descriptor->GetGenerateMipMaps())
             {
                 Vector<Image*> mipmapsImages = faceImage[0]->CreateMipMapsImages();
                 images->insert(images->end(), mipmapsImages.begin(), mipmapsImages.end());
@@ -530,7 +543,7 @@ bool Texture::LoadImages(eGPUFamily gpu, Vector<Image*>* images)
     else
     {
         Vector<FilePath> singleMipFiles;
-        bool hasSingleMipFiles = texDescriptor->CreateSingleMipPathnamesForGPU(gpu, singleMipFiles);
+        bool hasSingleMipFiles = descriptor->CreateSingleMipPathnamesForGPU(gpu, singleMipFiles);
         if (hasSingleMipFiles)
         {
             uint32 singleMipFilesCount = static_cast<uint32>(singleMipFiles.size());
@@ -547,7 +560,7 @@ bool Texture::LoadImages(eGPUFamily gpu, Vector<Image*>* images)
             params.baseMipmap = Max(static_cast<int32>(baseMipMap) - static_cast<int32>(singleMipFilesCount), 0);
         }
 
-        FilePath multipleMipPathname = texDescriptor->CreateMultiMipPathnameForGPU(gpu);
+        FilePath multipleMipPathname = descriptor->CreateMultiMipPathnameForGPU(gpu);
         ImageSystem::Load(multipleMipPathname, *images, params);
 
         ImageSystem::EnsurePowerOf2Images(*images);
@@ -567,22 +580,19 @@ bool Texture::LoadImages(eGPUFamily gpu, Vector<Image*>* images)
         return false;
     }
 
-    if (images->size() == 1 && texDescriptor->GetGenerateMipMaps())
+    if (images->size() == 1 && descriptor->GetGenerateMipMaps())
     {
         Image* img = *images->begin();
-        *images = img->CreateMipMapsImages(texDescriptor->dataSettings.GetIsNormalMap());
+        *images = img->CreateMipMapsImages(descriptor->dataSettings.GetIsNormalMap());
         SafeRelease(img);
 
         if (images->empty())
         {
-            Logger::Error("[Texture::LoadImages] Can't create mipmaps for GPU (%s) for %s", GlobalEnumMap<eGPUFamily>::Instance()->ToString(gpu), texDescriptor->pathname.GetStringValue().c_str());
+            Logger::Error("[Texture::LoadImages] Can't create mipmaps for GPU (%s) for %s", GlobalEnumMap<eGPUFamily>::Instance()->ToString(gpu), descriptor->pathname.GetStringValue().c_str());
             return false;
         }
     }
 
-    isPink = false;
-    state = STATE_DATA_LOADED;
-
     return true;
 }
 
@@ -786,6 +796,59 @@ Texture* Texture::PureCreate(const FilePath& pathName, const FastName& group)
     return texture;
 }
 
+eGPUFamily Texture::LoadImagesForDescriptor(const TextureDescriptor* descriptor, Vector<Image*>* images)
+{
+    DVASSERT(descriptor != nullptr && images != nullptr);
+
+    for (eGPUFamily gpu : gpuLoadingOrder)
+    {
+        eGPUFamily gpuForLoading = GetGPUForLoading(gpu, descriptor);
+        if (LoadDescriptorImages(descriptor, gpuForLoading, images))
+        {
+            return gpuForLoading;
+        }
+    }
+
+    Logger::Error("[Texture::LoadImagesForDescriptor] Cannot load images. Descriptor: %s, GPU: %s",
+                  descriptor->pathname.GetAbsolutePathname().c_str(), GlobalEnumMap<eGPUFamily>::Instance()->ToString(GetPrimaryGPUForLoading()));
+    return GPU_INVALID;
+}
+
+Texture* Texture::CreateFromLoadedImages(const TextureDescriptor* descriptor, eGPUFamily gpu, Vector<Image*>* images)
+{
+    DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
+
+    DVASSERT(descriptor != nullptr && images != nullptr && !images->empty());
+
+    Texture* texture = Texture::Get(descriptor->pathname);
+    if (texture == nullptr)
+    {
+        texture = new Texture();
+        texture->texDescriptor->Initialize(descriptor);
+        texture->isPink = false;
+
+        // renderer takes ownership of images and their vector
+        Vector<Image*>* flushedImages = new Vector<Image*>();
+        flushedImages->swap(*images);
+        texture->SetParamsFromImages(flushedImages);
+        texture->FlushDataToRenderer(flushedImages);
+        if (!texture->singleTextureSet.IsValid())
+        {
+            Logger::Error("[Texture::CreateFromLoadedImages] Cannot create rhi.texture from image. Descriptor: %s, GPU: %s",
+                          descriptor->pathname.GetAbsolutePathname().c_str(), GlobalEnumMap<eGPUFamily>::Instance()->ToString(gpu));
+            SafeRelease(texture);
+        }
+        else
+        {
+            texture->loadedAsFile = gpu;
+            AddToMap(texture);
+        }
+    }
+
+    ReleaseImages(images);
+    return texture;
+}
+
 void Texture::ReloadFromData(PixelFormat format, uint8* data, uint32 _width, uint32 _height)
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
@@ -849,12 +912,17 @@ void Texture::ReloadAs(eGPUFamily gpuFamily)
 
 bool Texture::IsLoadAvailable(const eGPUFamily gpuFamily) const
 {
-    if (texDescriptor->IsCompressedFile())
+    return IsLoadAvailable(texDescriptor, gpuFamily);
+}
+
+bool Texture::IsLoadAvailable(const TextureDescriptor* descriptor, const eGPUFamily gpuFamily)
+{
+    if (descriptor->IsCompressedFile())
     {
         return true;
     }
 
-    if (GPUFamilyDescriptor::IsGPUForDevice(gpuFamily) && texDescriptor->compression[gpuFamily].format == FORMAT_INVALID)
+    if (GPUFamilyDescriptor::IsGPUForDevice(gpuFamily) && descriptor->compression[gpuFamily].format == FORMAT_INVALID)
     {
         return false;
     }
@@ -1212,10 +1280,15 @@ void Texture::SetPixelization(bool value)
 }
 
 uint32 Texture::GetBaseMipMap() const
+{
+    return GetBaseMipMap(texDescriptor);
+}
+
+uint32 Texture::GetBaseMipMap(const TextureDescriptor* descriptor)
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
 
-    if (texDescriptor->GetQualityGroup().IsValid())
+    if (descriptor->GetQualityGroup().IsValid())
     {
         const TextureQuality* curTxQuality = QualitySettingsSystem::Instance()->GetTxQuality(QualitySettingsSystem::Instance()->GetCurTextureQuality());
         if (nullptr != curTxQuality)
@@ -114,6 +114,19 @@ public:
      */
     static Texture* PureCreate(const FilePath& pathName, const FastName& group = FastName());
 
+    /**
+        \brief Load images of texture described by `descriptor` for first GPU from loading order, for which they are available.
+        Neither texture cache nor renderer are used, so images can be loaded on any thread.
+        \returns GPU family of loaded images or GPU_INVALID if images can't be loaded
+     */
+    static eGPUFamily LoadImagesForDescriptor(const TextureDescriptor* descriptor, Vector<Image*>* images);
+
+    /**
+        \brief Create texture from images loaded by `LoadImagesForDescriptor` and put it into cache. Should be called on main thread.
+        If texture of `descriptor` is already in cache, cached texture is returned. Images are released in any case.
+     */
+    static Texture* CreateFromLoadedImages(const TextureDescriptor* descriptor, eGPUFamily gpu, Vector<Image*>* images);
+
     static Texture* CreatePink(rhi::TextureType requestedType = rhi::TEXTURE_TYPE_2D, bool checkers = true);
 
     static Texture* CreateFBO(uint32 width, uint32 height, PixelFormat format, bool needDepth = false,
@@ -183,6 +196,7 @@ public:
     static void SetPixelization(bool value);
 
     uint32 GetBaseMipMap() const;
+    static uint32 GetBaseMipMap(const TextureDescriptor* descriptor);
 
     static rhi::HSamplerState CreateSamplerStateHandle(const rhi::SamplerState::Descriptor::Sampler& samplerState);
 
@@ -198,12 +212,13 @@ protected:
     static Texture* CreateFromImage(TextureDescriptor* descriptor, eGPUFamily gpu);
 
     bool LoadImages(eGPUFamily gpu, Vector<Image*>* images);
+    static bool LoadDescriptorImages(const TextureDescriptor* descriptor, eGPUFamily gpu, Vector<Image*>* images);
 
     void SetParamsFromImages(const Vector<Image*>* images);
 
     void FlushDataToRenderer(Vector<Image*>* images);
 
-    void ReleaseImages(Vector<Image*>* images);
+    static void ReleaseImages(Vector<Image*>* images);
 
     void MakePink(bool checkers = true);
 
@@ -211,6 +226,7 @@ protected:
     virtual ~Texture();
 
     bool IsLoadAvailable(const eGPUFamily gpuFamily) const;
+    static bool IsLoadAvailable(const TextureDescriptor* descriptor, const eGPUFamily gpuFamily);
 
 public: // properties for fast access
     rhi::HTexture handle;
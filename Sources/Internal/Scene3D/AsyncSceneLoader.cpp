@@ -0,0 +1,404 @@
+#include "Scene3D/AsyncSceneLoader.h"
+#include "Concurrency/Thread.h"
+#include "Debug/DVAssert.h"
+#include "Engine/Engine.h"
+#include "FileSystem/DynamicMemoryFile.h"
+#include "FileSystem/KeyedArchive.h"
+#include "Logger/Logger.h"
+#include "Render/Highlevel/RenderBatch.h"
+#include "Render/Highlevel/RenderObject.h"
+#include "Render/Image/Image.h"
+#include "Render/Material/NMaterial.h"
+#include "Render/Material/NMaterialNames.h"
+#include "Render/Renderer.h"
+#include "Render/Texture.h"
+#include "Render/TextureDescriptor.h"
+#include "Scene3D/Components/ComponentHelpers.h"
+#include "Scene3D/Entity.h"
+#include "Scene3D/Scene.h"
+#include "Time/SystemTimer.h"
+#include "Utils/StringFormat.h"
+
+namespace DAVA
+{
+namespace AsyncSceneLoaderDetails
+{
+const size_t LOADING_THREAD_STACK_SIZE = 1024 * 1024;
+const int64 DEFAULT_FRAME_BUDGET_US = 4000;
+// parts of progress covered by loading thread and by steps performed on main thread
+const float32 LOADING_PROGRESS_PART = 0.3f;
+const float32 TEXTURES_PROGRESS_PART = 0.1f;
+const float32 SCENE_PROGRESS_PART = 0.4f;
+const float32 ENTITIES_PROGRESS_PART = 1.f - LOADING_PROGRESS_PART - TEXTURES_PROGRESS_PART - SCENE_PROGRESS_PART;
+
+/** Images of texture decoded by loading thread. */
+struct LoadedTexture
+{
+    std::unique_ptr<TextureDescriptor> descriptor;
+    eGPUFamily gpu = GPU_INVALID;
+    Vector<Image*> images;
+
+    ~LoadedTexture()
+    {
+        for (Image* image : images)
+        {
+            SafeRelease(image);
+        }
+    }
+};
+
+void CollectTextures(const KeyedArchive* materialArchive, const FilePath& scenePath, Map<FilePath, FastName>& textures)
+{
+    const KeyedArchive* texturesArchive = materialArchive->GetArchive("textures");
+    if (texturesArchive == nullptr)
+    {
+        return;
+    }
+
+    for (const auto& entry : texturesArchive->GetArchieveData())
+    {
+        // materials take textures with slot name as quality group, see `NMaterial::GetEffectiveTexture`
+        FilePath descriptorPath = TextureDescriptor::GetDescriptorPathname(scenePath + entry.second->AsString());
+        textures.emplace(descriptorPath, FastName(entry.first));
+    }
+}
+}
+
+AsyncSceneLoader::AsyncSceneLoader(Scene* scene_)
+    : scene(SafeRetain(scene_))
+    , frameBudgetUs(AsyncSceneLoaderDetails::DEFAULT_FRAME_BUDGET_US)
+{
+    DVASSERT(scene_ != nullptr);
+}
+
+AsyncSceneLoader::~AsyncSceneLoader()
+{
+    if (loadingThread)
+    {
+        loadingThread->Join();
+    }
+
+    ReleaseLoadedData();
+
+    Engine::Instance()->update.Disconnect(this);
+}
+
+void AsyncSceneLoader::Start(const FilePath& pathname_)
+{
+    DVASSERT(state == STATE_IDLE || state == STATE_FINISHED);
+
+    pathname = pathname_;
+    state = STATE_LOADING;
+    error = SceneFileV2::ERROR_NO_ERROR;
+    textureLoadEnabled = Renderer::GetOptions()->IsOptionEnabled(RenderOptions::TEXTURE_LOAD_ENABLED);
+    committedTexturesCount = 0;
+    sceneCreated = false;
+    committedCount = 0;
+
+    loadingThread = RefPtr<Thread>(Thread::Create([this]() { Load(); }));
+    loadingThread->SetStackSize(AsyncSceneLoaderDetails::LOADING_THREAD_STACK_SIZE);
+    loadingThread->Start();
+
+    Engine::Instance()->update.Connect(this, &AsyncSceneLoader::OnUpdate);
+}
+
+void AsyncSceneLoader::SetFrameBudget(int64 budgetUs)
+{
+    frameBudgetUs = budgetUs;
+}
+
+float32 AsyncSceneLoader::GetProgress() const
+{
+    using namespace AsyncSceneLoaderDetails;
+
+    switch (state)
+    {
+    case STATE_LOADING:
+        return 0.f;
+    case STATE_COMMITTING:
+    {
+        uint32 texturesCount = static_cast<uint32>(loadedTextures.size());
+        uint32 entitiesCount = static_cast<uint32>(loadedEntities.size());
+        float32 texturesPart = (texturesCount > 0) ? static_cast<float32>(committedTexturesCount) / texturesCount : 1.f;
+        float32 scenePart = sceneCreated ? 1.f : (sceneFile ? sceneFile->GetLoadSceneArchiveProgress() : 0.f);
+        float32 entitiesPart = sceneCreated ? ((entitiesCount > 0) ? static_cast<float32>(committedCount) / entitiesCount : 1.f) : 0.f;
+        return LOADING_PROGRESS_PART + TEXTURES_PROGRESS_PART * texturesPart + SCENE_PROGRESS_PART * scenePart + ENTITIES_PROGRESS_PART * entitiesPart;
+    }
+    case STATE_FINISHED:
+        return 1.f;
+    default:
+        return 0.f;
+    }
+}
+
+void AsyncSceneLoader::Load()
+{
+    // only file reading, parsing and image decoding are performed here, they don't touch engine caches
+    ScopedPtr<File> file(File::Create(pathname, File::OPEN | File::READ));
+    if (!file)
+    {
+        error = SceneFileV2::ERROR_FAILED_TO_CREATE_FILE;
+        return;
+    }
+
+    Vector<uint8> content(static_cast<size_t>(file->GetSize()));
+    uint32 contentSize = static_cast<uint32>(content.size());
+    if (file->Read(content.data(), contentSize) != contentSize)
+    {
+        error = SceneFileV2::ERROR_FILE_READ_ERROR;
+        return;
+    }
+
+    // scene file is parsed once here, main thread only creates scene objects from parsed archives
+    ScopedPtr<File> memoryFile(DynamicMemoryFile::Create(std::move(content), File::OPEN | File::READ, pathname));
+    ScopedPtr<SceneFileV2> archiveFile(new SceneFileV2());
+    archiveFile->EnableDebugLog(false);
+    sceneArchive = archiveFile->LoadSceneArchive(memoryFile);
+    if (!sceneArchive)
+    {
+        error = SceneFileV2::ERROR_FILE_READ_ERROR;
+        return;
+    }
+
+    if (textureLoadEnabled)
+    {
+        LoadTextures();
+    }
+}
+
+void AsyncSceneLoader::LoadTextures()
+{
+    using namespace AsyncSceneLoaderDetails;
+
+    Map<FilePath, FastName> textures;
+    const FilePath scenePath = pathname.GetDirectory();
+    for (const KeyedArchive* dataNode : sceneArchive->dataNodes)
+    {
+        uint32 configCount = dataNode->GetUInt32(NMaterialSerializationKey::ConfigCount, 1);
+        if (configCount == 1)
+        {
+            CollectTextures(dataNode, scenePath, textures);
+        }
+        else
+        {
+            for (uint32 i = 0; i < configCount; ++i)
+            {
+                const KeyedArchive* configArchive = dataNode->GetArchive(Format(NMaterialSerializationKey::ConfigArchive.c_str(), i));
+                if (configArchive != nullptr)
+                {
+                    CollectTextures(configArchive, scenePath, textures);
+                }
+            }
+        }
+    }
+
+    for (const auto& entry : textures)
+    {
+        std::unique_ptr<TextureDescriptor> descriptor(TextureDescriptor::CreateFromFile(entry.first));
+        if (!descriptor)
+        {
+            continue;
+        }
+        descriptor->SetQualityGroup(entry.second);
+
+        std::unique_ptr<LoadedTexture> texture(new LoadedTexture());
+        texture->gpu = Texture::LoadImagesForDescriptor(descriptor.get(), &texture->images);
+        if (texture->gpu != GPU_INVALID)
+        {
+            texture->descriptor = std::move(descriptor);
+            loadedTextures.push_back(texture.release());
+        }
+    }
+}
+
+void AsyncSceneLoader::OnUpdate(float32 timeElapsed)
+{
+    if (state == STATE_LOADING)
+    {
+        if (loadingThread->GetState() != Thread::STATE_ENDED)
+        {
+            return;
+        }
+        loadingThread->Join();
+        loadingThread = nullptr;
+
+        if (error != SceneFileV2::ERROR_NO_ERROR)
+        {
+            Logger::Error("[AsyncSceneLoader] failed to load scene %s, error %d", pathname.GetAbsolutePathname().c_str(), error);
+            Finish();
+            return;
+        }
+
+        state = STATE_COMMITTING;
+        progressChanged.Emit(this, GetProgress());
+    }
+
+    if (state == STATE_COMMITTING)
+    {
+        Commit();
+    }
+}
+
+void AsyncSceneLoader::Commit()
+{
+    int64 startTime = SystemTimer::GetUs();
+
+    bool hasSteps = true;
+    do
+    {
+        hasSteps = CommitStep();
+    } while (hasSteps && state == STATE_COMMITTING && SystemTimer::GetUs() - startTime < frameBudgetUs);
+
+    if (state != STATE_COMMITTING)
+    {
+        return;
+    }
+
+    progressChanged.Emit(this, GetProgress());
+
+    if (!hasSteps)
+    {
+        scene->SceneDidLoaded();
+        Finish();
+    }
+}
+
+bool AsyncSceneLoader::CommitStep()
+{
+    if (committedTexturesCount < loadedTextures.size())
+    {
+        AsyncSceneLoaderDetails::LoadedTexture* texture = loadedTextures[committedTexturesCount++];
+        Texture* created = Texture::CreateFromLoadedImages(texture->descriptor.get(), texture->gpu, &texture->images);
+        if (created != nullptr)
+        {
+            createdTextures.emplace(created->GetPathname(), created);
+        }
+        return true;
+    }
+
+    if (!sceneCreated)
+    {
+        if (!sceneFile)
+        {
+            // temporary scene without update systems, entities are created here from parsed archives
+            loadedScene = new Scene(0);
+            sceneFile = new SceneFileV2();
+            sceneFile->EnableDebugLog(false);
+            error = sceneFile->BeginLoadSceneArchive(sceneArchive, pathname, loadedScene);
+        }
+        else if (!sceneFile->LoadSceneArchiveStep())
+        {
+            FinishSceneCreation();
+        }
+        return true;
+    }
+
+    if (committedCount < loadedEntities.size())
+    {
+        Entity* entity = loadedEntities[committedCount];
+        loadedEntities[committedCount] = nullptr;
+        ++committedCount;
+
+        BindTextures(entity);
+        scene->AddNode(entity);
+        entity->Release();
+    }
+    return committedCount < loadedEntities.size();
+}
+
+void AsyncSceneLoader::FinishSceneCreation()
+{
+    error = sceneFile->GetError();
+    sceneFile = nullptr;
+    sceneArchive = nullptr;
+    sceneCreated = true;
+
+    if (error != SceneFileV2::ERROR_NO_ERROR)
+    {
+        Logger::Error("[AsyncSceneLoader] failed to load scene %s, error %d", pathname.GetAbsolutePathname().c_str(), error);
+        Finish();
+        return;
+    }
+
+    loadedEntities.reserve(loadedScene->GetChildrenCount());
+    for (int32 i = 0; i < loadedScene->GetChildrenCount(); ++i)
+    {
+        loadedEntities.push_back(SafeRetain(loadedScene->GetChild(i)));
+    }
+    loadedScene->RemoveAllChildren();
+
+    if (scene->GetGlobalMaterial() == nullptr && loadedScene->GetGlobalMaterial() != nullptr)
+    {
+        BindTextures(loadedScene->GetGlobalMaterial());
+        scene->SetGlobalMaterial(loadedScene->GetGlobalMaterial());
+    }
+}
+
+void AsyncSceneLoader::BindTextures(Entity* entity)
+{
+    RenderObject* renderObject = GetRenderObject(entity);
+    if (renderObject != nullptr)
+    {
+        for (uint32 i = 0; i < renderObject->GetRenderBatchCount(); ++i)
+        {
+            for (NMaterial* material = renderObject->GetRenderBatch(i)->GetMaterial(); material != nullptr; material = material->GetParent())
+            {
+                BindTextures(material);
+            }
+        }
+    }
+
+    for (int32 i = 0; i < entity->GetChildrenCount(); ++i)
+    {
+        BindTextures(entity->GetChild(i));
+    }
+}
+
+void AsyncSceneLoader::BindTextures(NMaterial* material)
+{
+    // materials take textures lazily, so created textures are bound here while they are retained by loader
+    for (const auto& entry : material->GetLocalTextures())
+    {
+        if (entry.second->texture == nullptr && createdTextures.count(TextureDescriptor::GetDescriptorPathname(entry.second->path)) > 0)
+        {
+            // created texture is taken from cache
+            material->GetEffectiveTexture(entry.first);
+        }
+    }
+}
+
+void AsyncSceneLoader::Finish()
+{
+    Engine::Instance()->update.Disconnect(this);
+
+    ReleaseLoadedData();
+    state = STATE_FINISHED;
+
+    loadFinished.Emit(this, error);
+}
+
+void AsyncSceneLoader::ReleaseLoadedData()
+{
+    for (AsyncSceneLoaderDetails::LoadedTexture* texture : loadedTextures)
+    {
+        SafeDelete(texture);
+    }
+    loadedTextures.clear();
+
+    for (auto& entry : createdTextures)
+    {
+        SafeRelease(entry.second);
+    }
+    createdTextures.clear();
+
+    for (Entity* entity : loadedEntities)
+    {
+        SafeRelease(entity);
+    }
+    loadedEntities.clear();
+
+    sceneFile = nullptr;
+    sceneArchive = nullptr;
+    loadedScene = nullptr;
+}
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Base/BaseObject.h"
+#include "Base/BaseTypes.h"
+#include "Base/RefPtr.h"
+#include "Base/ScopedPtr.h"
+#include "FileSystem/FilePath.h"
+#include "Functional/Signal.h"
+#include "Scene3D/SceneFileV2.h"
+
+namespace DAVA
+{
+class Entity;
+class NMaterial;
+class Scene;
+class Texture;
+class Thread;
+
+namespace AsyncSceneLoaderDetails
+{
+struct LoadedTexture;
+}
+
+/**
+    Loads scene file in background and adds loaded entities into target scene during several frames.
+
+    Loading thread reads and parses scene file into `SceneArchive` once, finds textures of scene materials in it and decodes their images.
+    Scene objects are never created there, as scenes, entities, materials and textures use caches shared with main thread.
+    After loading thread is finished, following steps are performed on main thread until frame budget is exceeded:
+    textures are created from decoded images, data nodes, top-level entities and polygon groups vertex data are created
+    one by one from parsed archives in temporary scene without update systems (see `SceneFileV2::LoadSceneArchiveStep`),
+    and loaded top-level entities are added into target scene one by one.
+    Entities are added to existing content of target scene, it is not cleared like in `Scene::LoadScene`.
+
+    Loader is driven by `Engine::update` signal and should be created and released on main thread.
+
+    \code
+    ScopedPtr<AsyncSceneLoader> loader(new AsyncSceneLoader(scene));
+    loader->progressChanged.Connect([](AsyncSceneLoader*, float32 progress) { ... });
+    loader->loadFinished.Connect([](AsyncSceneLoader*, SceneFileV2::eError error) { ... });
+    loader->Start("~res:/3d/Maps/map.sc2");
+    \endcode
+*/
+class AsyncSceneLoader : public BaseObject
+{
+public:
+    enum eState
+    {
+        STATE_IDLE = 0,
+        STATE_LOADING, //!< scene file is loaded on loading thread
+        STATE_COMMITTING, //!< loaded entities are being added into target scene
+        STATE_FINISHED
+    };
+
+    AsyncSceneLoader(Scene* scene);
+
+    /** Start loading of `pathname`. Loader should be idle or finished. */
+    void Start(const FilePath& pathname);
+
+    /** Set maximum time in microseconds spent per frame on steps performed on main thread. At least one step is performed per frame. */
+    void SetFrameBudget(int64 budgetUs);
+
+    eState GetState() const;
+    /** Return load progress in range [0, 1]. */
+    float32 GetProgress() const;
+    SceneFileV2::eError GetError() const;
+
+    Signal<AsyncSceneLoader*, float32> progressChanged; //!< Emitted on main thread when part of loaded scene is created or added to target scene.
+    Signal<AsyncSceneLoader*, SceneFileV2::eError> loadFinished; //!< Emitted on main thread when all entities are added or when loading failed.
+
+protected:
+    ~AsyncSceneLoader() override;
+
+private:
+    void Load();
+    void LoadTextures();
+    void OnUpdate(float32 timeElapsed);
+    void Commit();
+    // perform next step of commit on main thread, return false if nothing is left
+    bool CommitStep();
+    void FinishSceneCreation();
+    void BindTextures(Entity* entity);
+    void BindTextures(NMaterial* material);
+    void Finish();
+    void ReleaseLoadedData();
+
+    ScopedPtr<Scene> scene;
+    FilePath pathname;
+    eState state = STATE_IDLE;
+    SceneFileV2::eError error = SceneFileV2::ERROR_NO_ERROR;
+    int64 frameBudgetUs;
+    bool textureLoadEnabled = true;
+
+    // results of loading thread, accessed by main thread only after loading thread is joined
+    RefPtr<Thread> loadingThread;
+    ScopedPtr<SceneArchive> sceneArchive;
+    Vector<AsyncSceneLoaderDetails::LoadedTexture*> loadedTextures;
+
+    Map<FilePath, Texture*> createdTextures; // textures are retained until they are bound to loaded materials
+    uint32 committedTexturesCount = 0;
+    ScopedPtr<SceneFileV2> sceneFile; // creates scene objects from archive step by step
+    ScopedPtr<Scene> loadedScene;
+    bool sceneCreated = false;
+    Vector<Entity*> loadedEntities;
+    uint32 committedCount = 0;
+};
+
+inline AsyncSceneLoader::eState AsyncSceneLoader::GetState() const
+{
+    return state;
+}
+
+inline SceneFileV2::eError AsyncSceneLoader::GetError() const
+{
+    return error;
+}
+}
@@ -82,9 +82,15 @@ private:
     //transforms info
     Vector<JointTransform> localSpaceTransforms;
     Vector<JointTransform> objectSpaceTransforms;
-    Vector<JointTransform> finalTransforms;
+    //object space transforms are duplicated, final and inverse bind transforms are stored only as flat arrays
+    //in the same layout as skinning data: position with uniform scale in w and orientation quaternion
+    Vector<Vector4> objectSpacePositions;
+    Vector<Vector4> objectSpaceOrientations;
+    Vector<Vector4> finalPositions;
+    Vector<Vector4> finalOrientations;
     //bind pose
-    Vector<JointTransform> inverseBindTransforms;
+    Vector<Vector4> inverseBindPositions;
+    Vector<Vector4> inverseBindOrientations;
     //bounding boxes
     Vector<AABBox3> objectSpaceBoxes;
 
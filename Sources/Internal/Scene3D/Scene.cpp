@@ -489,6 +489,11 @@ void Scene::RegisterEntity(Entity* entity)
         entity->SetSceneID(sceneId);
     }
 
+    for (const std::unique_ptr<EntityGroupBase>& group : entityGroups)
+    {
+        group->UpdateEntity(entity, nullptr);
+    }
+
     for (auto& system : systems)
     {
         system->RegisterEntity(entity);
@@ -517,6 +522,11 @@ void Scene::UnregisterEntity(Entity* entity)
     {
         system->UnregisterEntity(entity);
     }
+
+    for (const std::unique_ptr<EntityGroupBase>& group : entityGroups)
+    {
+        group->RemoveEntity(entity);
+    }
 }
 
 void Scene::RegisterEntitiesInSystemRecursively(SceneSystem* system, Entity* entity)
@@ -526,9 +536,26 @@ void Scene::RegisterEntitiesInSystemRecursively(SceneSystem* system, Entity* ent
         RegisterEntitiesInSystemRecursively(system, entity->GetChild(i));
 }
 
+void Scene::RegisterEntitiesInGroupRecursively(EntityGroupBase* group, Entity* entity)
+{
+    group->UpdateEntity(entity, nullptr);
+    for (int32 i = 0, sz = entity->GetChildrenCount(); i < sz; ++i)
+        RegisterEntitiesInGroupRecursively(group, entity->GetChild(i));
+}
+
 void Scene::RegisterComponent(Entity* entity, Component* component)
 {
     DVASSERT(entity && component);
+
+    uint32 runtimeId = ComponentUtils::GetRuntimeId(component->GetType());
+    for (const std::unique_ptr<EntityGroupBase>& group : entityGroups)
+    {
+        if (group->GetComponentMask().test(runtimeId))
+        {
+            group->UpdateEntity(entity, nullptr);
+        }
+    }
+
     uint32 systemsCount = static_cast<uint32>(systems.size());
     for (uint32 k = 0; k < systemsCount; ++k)
     {
@@ -544,6 +571,15 @@ void Scene::UnregisterComponent(Entity* entity, Component* component)
     {
         systems[k]->UnregisterComponent(entity, component);
     }
+
+    uint32 runtimeId = ComponentUtils::GetRuntimeId(component->GetType());
+    for (const std::unique_ptr<EntityGroupBase>& group : entityGroups)
+    {
+        if (group->GetComponentMask().test(runtimeId))
+        {
+            group->UpdateEntity(entity, component);
+        }
+    }
 }
 
 void Scene::AddSystem(SceneSystem* sceneSystem, const ComponentMask& componentMask, uint32 processFlags /*= 0*/, SceneSystem* insertBeforeSceneForProcess /* = nullptr */, SceneSystem* insertBeforeSceneForInput /* = nullptr*/, SceneSystem* insertBeforeSceneForFixedProcess)
@@ -3,6 +3,7 @@
 #include "Base/BaseMath.h"
 #include "Base/BaseTypes.h"
 #include "Base/Observer.h"
+#include "Entity/EntityGroup.h"
 #include "Entity/SceneSystem.h"
 #include "Entity/SingletonComponent.h"
 #include "Render/Highlevel/Camera.h"
@@ -152,6 +153,13 @@ public:
     template <class T>
     T* GetSystem();
 
+    /**
+        Return group of scene entities which have components of all types `T...`, see `EntityGroup`.
+        Group is created and filled with entities already added to scene on first request, then it is kept up to date by scene.
+    */
+    template <typename... T>
+    EntityGroup<T...>* AcquireEntityGroup();
+
     Vector<SceneSystem*> systems;
     Vector<SceneSystem*> systemsToProcess;
     Vector<SceneSystem*> systemsToInput;
@@ -260,6 +268,7 @@ public: // deprecated methods
 
 protected:
     void RegisterEntitiesInSystemRecursively(SceneSystem* system, Entity* entity);
+    void RegisterEntitiesInGroupRecursively(EntityGroupBase* group, Entity* entity);
 
     bool RemoveSystem(Vector<SceneSystem*>& storage, SceneSystem* system);
 
@@ -270,6 +279,8 @@ protected:
 
     Vector<Camera*> cameras;
 
+    Vector<std::unique_ptr<EntityGroupBase>> entityGroups;
+
     NMaterial* sceneGlobalMaterial;
 
     Camera* mainCamera;
@@ -303,6 +314,24 @@ T* Scene::GetSystem()
     return res;
 }
 
+template <typename... T>
+EntityGroup<T...>* Scene::AcquireEntityGroup()
+{
+    for (const std::unique_ptr<EntityGroupBase>& group : entityGroups)
+    {
+        EntityGroup<T...>* typedGroup = dynamic_cast<EntityGroup<T...>*>(group.get());
+        if (typedGroup != nullptr)
+        {
+            return typedGroup;
+        }
+    }
+
+    EntityGroup<T...>* group = new EntityGroup<T...>();
+    entityGroups.emplace_back(group);
+    RegisterEntitiesInGroupRecursively(group, this);
+    return group;
+}
+
 template <class T>
 T* Scene::GetSingletonComponent()
 {
@@ -0,0 +1,576 @@
+#include "Scene3D/SceneFile/FlatArchive.h"
+#include "FileSystem/DynamicMemoryFile.h"
+#include "FileSystem/FastNameKeyedArchive.h"
+#include "FileSystem/File.h"
+#include "FileSystem/KeyedArchive.h"
+#include "FileSystem/MappedMemoryFile.h"
+#include "Math/AABBox3.h"
+#include "FileSystem/VariantType.h"
+#include "Logger/Logger.h"
+#include "Utils/UTF8Utils.h"
+
+namespace DAVA
+{
+namespace FlatArchiveDetails
+{
+template <typename T>
+void Append(Vector<uint8>& buffer, const T& value)
+{
+    const uint8* bytes = reinterpret_cast<const uint8*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void AppendBytes(Vector<uint8>& buffer, const void* bytes, uint32 count)
+{
+    Append(buffer, count);
+    const uint8* begin = static_cast<const uint8*>(bytes);
+    buffer.insert(buffer.end(), begin, begin + count);
+}
+
+void AppendString(Vector<uint8>& buffer, const String& value)
+{
+    AppendBytes(buffer, value.data(), static_cast<uint32>(value.size()));
+}
+
+template <typename T>
+void Patch(Vector<uint8>& buffer, size_t offset, const T& value)
+{
+    Memcpy(buffer.data() + offset, &value, sizeof(T));
+}
+
+struct Cursor
+{
+    const uint8* ptr;
+    const uint8* end;
+
+    template <typename T>
+    bool Read(T& value)
+    {
+        if (static_cast<size_t>(end - ptr) < sizeof(T))
+        {
+            return false;
+        }
+        Memcpy(&value, ptr, sizeof(T));
+        ptr += sizeof(T);
+        return true;
+    }
+
+    bool ReadBytes(const uint8*& bytes, uint32& count)
+    {
+        if (!Read(count) || static_cast<size_t>(end - ptr) < count)
+        {
+            return false;
+        }
+        bytes = ptr;
+        ptr += count;
+        return true;
+    }
+
+    bool ReadItemsCount(uint32& count)
+    {
+        // every item takes at least key index and type, so broken count can't reserve more than block size
+        return Read(count) && count <= static_cast<size_t>(end - ptr) / (sizeof(uint32) + sizeof(uint8));
+    }
+
+    bool ReadString(String& value)
+    {
+        const uint8* bytes = nullptr;
+        uint32 count = 0;
+        if (!ReadBytes(bytes, count))
+        {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(bytes), count);
+        return true;
+    }
+
+    template <typename T, typename M>
+    bool ReadValue(VariantType& variant, M setVariantMethod)
+    {
+        T value;
+        if (!Read(value))
+        {
+            return false;
+        }
+        (variant.*setVariantMethod)(value);
+        return true;
+    }
+};
+}
+
+bool FlatArchiveWriter::WriteArchive(const KeyedArchive* archive, File* file)
+{
+    DVASSERT(archive != nullptr && file != nullptr);
+
+    blockBuffer.clear();
+    AppendArchive(archive, blockBuffer);
+
+    uint32 blockSize = static_cast<uint32>(blockBuffer.size());
+    return file->Write(blockBuffer.data(), blockSize) == blockSize;
+}
+
+bool FlatArchiveWriter::WriteKeys(File* file) const
+{
+    Vector<uint8> buffer;
+    FlatArchiveDetails::Append(buffer, static_cast<uint32>(keys.size()));
+    for (const String& key : keys)
+    {
+        FlatArchiveDetails::AppendString(buffer, key);
+    }
+
+    uint32 bufferSize = static_cast<uint32>(buffer.size());
+    return file->Write(buffer.data(), bufferSize) == bufferSize;
+}
+
+void FlatArchiveWriter::AppendArchive(const KeyedArchive* archive, Vector<uint8>& buffer)
+{
+    using namespace FlatArchiveDetails;
+
+    // keys are ordered to make saved files independent of hash map order, as in `KeyedArchive::Save`
+    const KeyedArchive::UnderlyingMap& items = archive->GetArchieveData();
+    Map<String, const VariantType*> orderedItems(items.begin(), items.end());
+
+    size_t blockOffset = buffer.size();
+    Append(buffer, uint32(0)); // block size
+    Append(buffer, uint32(0)); // items count
+
+    uint32 itemsCount = 0;
+    for (const auto& item : orderedItems)
+    {
+        size_t itemOffset = buffer.size();
+        Append(buffer, GetKeyIndex(item.first));
+        if (AppendValue(item.second, buffer))
+        {
+            ++itemsCount;
+        }
+        else
+        {
+            buffer.resize(itemOffset);
+        }
+    }
+
+    Patch(buffer, blockOffset, static_cast<uint32>(buffer.size() - blockOffset - sizeof(uint32)));
+    Patch(buffer, blockOffset + sizeof(uint32), itemsCount);
+}
+
+bool FlatArchiveWriter::AppendValue(const VariantType* value, Vector<uint8>& buffer)
+{
+    using namespace FlatArchiveDetails;
+
+    VariantType::eVariantType type = value->GetType();
+    if (type == VariantType::TYPE_WIDE_STRING)
+    {
+        // wide strings are loaded as utf8 strings anyway, see VariantType::Read
+        type = VariantType::TYPE_STRING;
+    }
+    Append(buffer, static_cast<uint8>(type));
+
+    switch (type)
+    {
+    case VariantType::TYPE_BOOLEAN:
+        Append(buffer, static_cast<uint8>(value->AsBool()));
+        break;
+    case VariantType::TYPE_INT8:
+        Append(buffer, value->AsInt8());
+        break;
+    case VariantType::TYPE_UINT8:
+        Append(buffer, value->AsUInt8());
+        break;
+    case VariantType::TYPE_INT16:
+        Append(buffer, value->AsInt16());
+        break;
+    case VariantType::TYPE_UINT16:
+        Append(buffer, static_cast<uint16>(value->AsUInt16()));
+        break;
+    case VariantType::TYPE_INT32:
+        Append(buffer, value->AsInt32());
+        break;
+    case VariantType::TYPE_UINT32:
+        Append(buffer, value->AsUInt32());
+        break;
+    case VariantType::TYPE_FLOAT:
+        Append(buffer, value->AsFloat());
+        break;
+    case VariantType::TYPE_FLOAT64:
+        Append(buffer, value->AsFloat64());
+        break;
+    case VariantType::TYPE_INT64:
+        Append(buffer, value->AsInt64());
+        break;
+    case VariantType::TYPE_UINT64:
+        Append(buffer, value->AsUInt64());
+        break;
+    case VariantType::TYPE_VECTOR2:
+        Append(buffer, value->AsVector2());
+        break;
+    case VariantType::TYPE_VECTOR3:
+        Append(buffer, value->AsVector3());
+        break;
+    case VariantType::TYPE_VECTOR4:
+        Append(buffer, value->AsVector4());
+        break;
+    case VariantType::TYPE_MATRIX2:
+        Append(buffer, value->AsMatrix2());
+        break;
+    case VariantType::TYPE_MATRIX3:
+        Append(buffer, value->AsMatrix3());
+        break;
+    case VariantType::TYPE_MATRIX4:
+        Append(buffer, value->AsMatrix4());
+        break;
+    case VariantType::TYPE_COLOR:
+        Append(buffer, value->AsColor());
+        break;
+    case VariantType::TYPE_AABBOX3:
+        Append(buffer, value->AsAABBox3());
+        break;
+    case VariantType::TYPE_STRING:
+        AppendString(buffer, value->GetType() == VariantType::TYPE_WIDE_STRING ? UTF8Utils::EncodeToUTF8(value->AsWideString()) : value->AsString());
+        break;
+    case VariantType::TYPE_FASTNAME:
+    {
+        const FastName& fastName = value->AsFastName();
+        AppendString(buffer, fastName.IsValid() ? String(fastName.c_str()) : String());
+    }
+    break;
+    case VariantType::TYPE_FILEPATH:
+        AppendString(buffer, value->AsFilePath().GetAbsolutePathname());
+        break;
+    case VariantType::TYPE_BYTE_ARRAY:
+        AppendBytes(buffer, value->AsByteArray(), static_cast<uint32>(value->AsByteArraySize()));
+        break;
+    case VariantType::TYPE_KEYED_ARCHIVE:
+        AppendArchive(value->AsKeyedArchive(), buffer);
+        break;
+    default:
+    {
+        DVASSERT(false, Format("Variant type %d can't be written to flat archive", type).c_str());
+        return false;
+    }
+    }
+
+    return true;
+}
+
+uint32 FlatArchiveWriter::GetKeyIndex(const String& key)
+{
+    auto it = keyIndices.find(key);
+    if (it != keyIndices.end())
+    {
+        return it->second;
+    }
+
+    uint32 index = static_cast<uint32>(keys.size());
+    keys.push_back(key);
+    keyIndices.emplace(key, index);
+    return index;
+}
+
+FlatArchiveReader::FlatArchiveReader()
+    : emptyArchive(new KeyedArchive())
+{
+}
+
+FlatArchiveReader::~FlatArchiveReader() = default;
+
+bool FlatArchiveReader::Open(File* file, uint64 keysOffset)
+{
+    DVASSERT(file != nullptr);
+
+    contentFile = nullptr;
+    contentBuffer.clear();
+    keys.clear();
+
+    // content of memory file is already read (e.g. by background scene loader), so it is used as is
+    DynamicMemoryFile* memoryFile = dynamic_cast<DynamicMemoryFile*>(file);
+    MappedMemoryFile* mappedFile = dynamic_cast<MappedMemoryFile*>(file);
+    if (memoryFile != nullptr)
+    {
+        contentFile = SafeRetain(memoryFile);
+    }
+    else if (mappedFile != nullptr)
+    {
+        contentFile = SafeRetain(mappedFile);
+    }
+    else if (!file->GetFilename().IsEmpty())
+    {
+        mappedFile = MappedMemoryFile::Create(file->GetFilename());
+        if (mappedFile != nullptr && mappedFile->GetSize() == file->GetSize())
+        {
+            contentFile = mappedFile;
+        }
+        else
+        {
+            SafeRelease(mappedFile);
+        }
+    }
+
+    if (memoryFile != nullptr)
+    {
+        data = memoryFile->GetData();
+        size = memoryFile->GetSize();
+    }
+    else if (mappedFile != nullptr)
+    {
+        data = mappedFile->GetData();
+        size = mappedFile->GetSize();
+    }
+    else
+    {
+        // file can't be mapped (e.g. it is inside of compressed archive), so read its content at once
+        uint64 filePos = file->GetPos();
+        contentBuffer.resize(static_cast<size_t>(file->GetSize()));
+        uint32 contentSize = static_cast<uint32>(contentBuffer.size());
+        if (!file->Seek(0, File::SEEK_FROM_START) || file->Read(contentBuffer.data(), contentSize) != contentSize || !file->Seek(filePos, File::SEEK_FROM_START))
+        {
+            Logger::Error("FlatArchiveReader: can't read content of %s", file->GetFilename().GetStringValue().c_str());
+            return false;
+        }
+        data = contentBuffer.data();
+        size = contentBuffer.size();
+    }
+
+    if (keysOffset >= size)
+    {
+        Logger::Error("FlatArchiveReader: wrong keys offset in %s", file->GetFilename().GetStringValue().c_str());
+        return false;
+    }
+
+    FlatArchiveDetails::Cursor cursor = { data + keysOffset, data + size };
+    uint32 keysCount = 0;
+    if (!cursor.Read(keysCount))
+    {
+        return false;
+    }
+
+    keys.resize(keysCount);
+    for (String& key : keys)
+    {
+        if (!cursor.ReadString(key))
+        {
+            Logger::Error("FlatArchiveReader: keys table is broken in %s", file->GetFilename().GetStringValue().c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FlatArchiveReader::ReadArchive(uint64& offset, KeyedArchive* archive) const
+{
+    DVASSERT(archive != nullptr);
+
+    const uint8* begin = nullptr;
+    const uint8* end = nullptr;
+    return FindBlock(offset, begin, end) && ReadBlock(begin, end, archive);
+}
+
+bool FlatArchiveReader::ReadArchive(uint64& offset, FastNameKeyedArchive* archive) const
+{
+    DVASSERT(archive != nullptr);
+
+    const uint8* begin = nullptr;
+    const uint8* end = nullptr;
+    return FindBlock(offset, begin, end) && ReadBlock(begin, end, archive);
+}
+
+bool FlatArchiveReader::FindBlock(uint64& offset, const uint8*& begin, const uint8*& end) const
+{
+    FlatArchiveDetails::Cursor cursor = { data + offset, data + size };
+    uint32 blockSize = 0;
+    if (offset >= size || !cursor.Read(blockSize) || static_cast<size_t>(cursor.end - cursor.ptr) < blockSize)
+    {
+        return false;
+    }
+
+    offset += sizeof(uint32) + blockSize;
+    begin = cursor.ptr;
+    end = cursor.ptr + blockSize;
+    return true;
+}
+
+bool FlatArchiveReader::ReadBlock(const uint8* begin, const uint8* end, KeyedArchive* archive) const
+{
+    FlatArchiveDetails::Cursor cursor = { begin, end };
+
+    uint32 itemsCount = 0;
+    if (!cursor.ReadItemsCount(itemsCount))
+    {
+        return false;
+    }
+
+    // values of block are placed into one allocation of archive, read values are moved there without copying
+    archive->ReserveValues(itemsCount);
+    for (uint32 i = 0; i < itemsCount; ++i)
+    {
+        uint32 keyIndex = 0;
+        uint8 type = VariantType::TYPE_NONE;
+        VariantType value;
+        if (!cursor.Read(keyIndex) || !cursor.Read(type) || keyIndex >= keys.size() || !ReadValue(cursor, type, value))
+        {
+            return false;
+        }
+
+        archive->SetVariant(keys[keyIndex], std::move(value));
+    }
+
+    return true;
+}
+
+bool FlatArchiveReader::ReadBlock(const uint8* begin, const uint8* end, FastNameKeyedArchive* archive) const
+{
+    FlatArchiveDetails::Cursor cursor = { begin, end };
+
+    uint32 itemsCount = 0;
+    if (!cursor.ReadItemsCount(itemsCount))
+    {
+        return false;
+    }
+
+    for (uint32 i = 0; i < itemsCount; ++i)
+    {
+        uint32 keyIndex = 0;
+        uint8 type = VariantType::TYPE_NONE;
+        if (!cursor.Read(keyIndex) || !cursor.Read(type) || keyIndex >= keys.size())
+        {
+            return false;
+        }
+
+        FastName key(keys[keyIndex]);
+        if (type == VariantType::TYPE_BYTE_ARRAY)
+        {
+            // byte arrays are copied into archive straight from file content
+            const uint8* bytes = nullptr;
+            uint32 count = 0;
+            if (!cursor.ReadBytes(bytes, count))
+            {
+                return false;
+            }
+            archive->SetByteArray(key, bytes, count);
+            continue;
+        }
+
+        VariantType value;
+        if (!ReadValue(cursor, type, value))
+        {
+            return false;
+        }
+        archive->SetVariant(key, value);
+    }
+
+    return true;
+}
+
+bool FlatArchiveReader::ReadValue(FlatArchiveDetails::Cursor& cursor, uint8 type, VariantType& value) const
+{
+    bool valueRead = true;
+    switch (type)
+    {
+    case VariantType::TYPE_BOOLEAN:
+    {
+        uint8 boolValue = 0;
+        valueRead = cursor.Read(boolValue);
+        value.SetBool(boolValue != 0);
+    }
+    break;
+    case VariantType::TYPE_INT8:
+        valueRead = cursor.ReadValue<int8>(value, &VariantType::SetInt8);
+        break;
+    case VariantType::TYPE_UINT8:
+        valueRead = cursor.ReadValue<uint8>(value, &VariantType::SetUInt8);
+        break;
+    case VariantType::TYPE_INT16:
+        valueRead = cursor.ReadValue<int16>(value, &VariantType::SetInt16);
+        break;
+    case VariantType::TYPE_UINT16:
+        valueRead = cursor.ReadValue<uint16>(value, &VariantType::SetUInt16);
+        break;
+    case VariantType::TYPE_INT32:
+        valueRead = cursor.ReadValue<int32>(value, &VariantType::SetInt32);
+        break;
+    case VariantType::TYPE_UINT32:
+        valueRead = cursor.ReadValue<uint32>(value, &VariantType::SetUInt32);
+        break;
+    case VariantType::TYPE_FLOAT:
+        valueRead = cursor.ReadValue<float32>(value, &VariantType::SetFloat);
+        break;
+    case VariantType::TYPE_FLOAT64:
+        valueRead = cursor.ReadValue<float64>(value, &VariantType::SetFloat64);
+        break;
+    case VariantType::TYPE_INT64:
+        valueRead = cursor.ReadValue<int64>(value, &VariantType::SetInt64);
+        break;
+    case VariantType::TYPE_UINT64:
+        valueRead = cursor.ReadValue<uint64>(value, &VariantType::SetUInt64);
+        break;
+    case VariantType::TYPE_VECTOR2:
+        valueRead = cursor.ReadValue<Vector2>(value, &VariantType::SetVector2);
+        break;
+    case VariantType::TYPE_VECTOR3:
+        valueRead = cursor.ReadValue<Vector3>(value, &VariantType::SetVector3);
+        break;
+    case VariantType::TYPE_VECTOR4:
+        valueRead = cursor.ReadValue<Vector4>(value, &VariantType::SetVector4);
+        break;
+    case VariantType::TYPE_MATRIX2:
+        valueRead = cursor.ReadValue<Matrix2>(value, &VariantType::SetMatrix2);
+        break;
+    case VariantType::TYPE_MATRIX3:
+        valueRead = cursor.ReadValue<Matrix3>(value, &VariantType::SetMatrix3);
+        break;
+    case VariantType::TYPE_MATRIX4:
+        valueRead = cursor.ReadValue<Matrix4>(value, &VariantType::SetMatrix4);
+        break;
+    case VariantType::TYPE_COLOR:
+        valueRead = cursor.ReadValue<Color>(value, &VariantType::SetColor);
+        break;
+    case VariantType::TYPE_AABBOX3:
+        valueRead = cursor.ReadValue<AABBox3>(value, &VariantType::SetAABBox3);
+        break;
+    case VariantType::TYPE_STRING:
+    case VariantType::TYPE_FASTNAME:
+    case VariantType::TYPE_FILEPATH:
+    {
+        String stringValue;
+        valueRead = cursor.ReadString(stringValue);
+        if (type == VariantType::TYPE_STRING)
+        {
+            value.SetString(stringValue);
+        }
+        else if (type == VariantType::TYPE_FASTNAME)
+        {
+            value.SetFastName(FastName(stringValue));
+        }
+        else
+        {
+            value.SetFilePath(FilePath(stringValue));
+        }
+    }
+    break;
+    case VariantType::TYPE_BYTE_ARRAY:
+    {
+        const uint8* bytes = nullptr;
+        uint32 count = 0;
+        valueRead = cursor.ReadBytes(bytes, count);
+        value.SetByteArray(bytes, static_cast<int32>(count));
+    }
+    break;
+    case VariantType::TYPE_KEYED_ARCHIVE:
+    {
+        // nested archive is filled in place to avoid copying of loaded archive into variant
+        uint32 blockSize = 0;
+        valueRead = cursor.Read(blockSize) && static_cast<size_t>(cursor.end - cursor.ptr) >= blockSize;
+        if (valueRead)
+        {
+            value.SetKeyedArchive(emptyArchive);
+            valueRead = ReadBlock(cursor.ptr, cursor.ptr + blockSize, value.AsKeyedArchive());
+            cursor.ptr += blockSize;
+        }
+    }
+    break;
+    default:
+        valueRead = false;
+        break;
+    }
+    return valueRead;
+}
+}
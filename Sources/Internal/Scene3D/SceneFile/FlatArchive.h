@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/ScopedPtr.h"
+#include "Base/UnordererMap.h"
+
+namespace DAVA
+{
+class File;
+class KeyedArchive;
+class FastNameKeyedArchive;
+class VariantType;
+
+namespace FlatArchiveDetails
+{
+struct Cursor;
+}
+
+/**
+    Flat binary layout of scene archives, used by scene files saved with `SceneFileV2::EnableFlatArchives`.
+
+    Every archive is stored as size-prefixed block of items: key index, value type and raw value bytes,
+    nested archives are stored as nested blocks. Keys of all archives are written once into keys table at the end of file.
+    Archives are read directly from file content (memory-mapped when possible) instead of series of small file reads.
+
+    Block layout:
+    \code
+    uint32 blockSize                        // size of data below
+    uint32 itemsCount
+    {
+        uint32 keyIndex                     // index in keys table
+        uint8 type                          // VariantType::eVariantType
+        value                               // raw bytes for POD types, uint32 length + bytes for strings and arrays,
+                                            // nested block for keyed archives
+    } x itemsCount
+    \endcode
+*/
+class FlatArchiveWriter
+{
+public:
+    /** Write `archive` as flat block to `file`, keys of archive are added to keys table. */
+    bool WriteArchive(const KeyedArchive* archive, File* file);
+
+    /** Write keys table collected by previous `WriteArchive` calls. */
+    bool WriteKeys(File* file) const;
+
+private:
+    void AppendArchive(const KeyedArchive* archive, Vector<uint8>& buffer);
+    bool AppendValue(const VariantType* value, Vector<uint8>& buffer);
+    uint32 GetKeyIndex(const String& key);
+
+    Vector<String> keys;
+    UnorderedMap<String, uint32> keyIndices;
+    Vector<uint8> blockBuffer;
+};
+
+/**
+    Reader of archives written by `FlatArchiveWriter`.
+*/
+class FlatArchiveReader
+{
+public:
+    FlatArchiveReader();
+    ~FlatArchiveReader();
+
+    /**
+        Take whole content of `file` and read keys table from `keysOffset`.
+        Content of memory-mapped files is used directly, other files are mapped or read into memory.
+    */
+    bool Open(File* file, uint64 keysOffset);
+
+    /** Read archive block at `offset` into `archive` and move `offset` past the block. */
+    bool ReadArchive(uint64& offset, KeyedArchive* archive) const;
+    bool ReadArchive(uint64& offset, FastNameKeyedArchive* archive) const;
+
+private:
+    bool FindBlock(uint64& offset, const uint8*& begin, const uint8*& end) const;
+    bool ReadBlock(const uint8* begin, const uint8* end, KeyedArchive* archive) const;
+    bool ReadBlock(const uint8* begin, const uint8* end, FastNameKeyedArchive* archive) const;
+    bool ReadValue(FlatArchiveDetails::Cursor& cursor, uint8 type, VariantType& value) const;
+
+    ScopedPtr<File> contentFile;
+    Vector<uint8> contentBuffer;
+    const uint8* data = nullptr;
+    uint64 size = 0;
+
+    Vector<String> keys;
+    ScopedPtr<KeyedArchive> emptyArchive;
+};
+}
@@ -1,4 +1,6 @@
 #include "Scene3D/SceneFile/SerializationContext.h"
+#include "Scene3D/SceneFile/FlatArchive.h"
+#include "FileSystem/FastNameKeyedArchive.h"
 #include "Scene3D/DataNode.h"
 
 #include "Scene3D/Scene.h"
@@ -60,7 +62,7 @@ void SerializationContext::ResolveMaterialBindings()
     materialBindings.clear();
 }
 
-void SerializationContext::AddLoadedPolygonGroup(PolygonGroup* group, uint32 dataFilePos)
+void SerializationContext::AddLoadedPolygonGroup(PolygonGroup* group, uint64 dataFilePos)
 {
     DVASSERT(loadedPolygonGroups.find(group) == loadedPolygonGroups.end());
     PolygonGroupLoadInfo loadInfo;
@@ -79,17 +81,50 @@ bool SerializationContext::LoadPolygonGroupData(File* file)
 {
     bool resultLoaded = true;
     bool cutUnusedStreams = QualitySettingsSystem::Instance()->GetAllowCutUnusedVertexStreams();
+    // one archive is reused for all polygon groups, so its buffer is allocated once
+    ScopedPtr<FastNameKeyedArchive> archive(new FastNameKeyedArchive());
     for (Map<PolygonGroup *, PolygonGroupLoadInfo>::iterator it = loadedPolygonGroups.begin(), e = loadedPolygonGroups.end(); it != e; ++it)
     {
         if (it->second.onScene || !cutUnusedStreams)
         {
-            resultLoaded &= file->Seek(it->second.filePos, File::SEEK_FROM_START);
-            KeyedArchive* archive = new KeyedArchive();
+            resultLoaded &= file->Seek(static_cast<int64>(it->second.filePos), File::SEEK_FROM_START);
+            archive->DeleteAllKeys();
             resultLoaded &= archive->Load(file);
             it->first->LoadPolygonData(archive, this, it->second.requestedFormat, cutUnusedStreams);
-            SafeRelease(archive);
         }
     }
     return resultLoaded;
 }
+
+bool SerializationContext::LoadPolygonGroupData(const FlatArchiveReader& reader)
+{
+    bool resultLoaded = true;
+    bool cutUnusedStreams = QualitySettingsSystem::Instance()->GetAllowCutUnusedVertexStreams();
+    ScopedPtr<FastNameKeyedArchive> archive(new FastNameKeyedArchive());
+    for (Map<PolygonGroup *, PolygonGroupLoadInfo>::iterator it = loadedPolygonGroups.begin(), e = loadedPolygonGroups.end(); it != e; ++it)
+    {
+        if (it->second.onScene || !cutUnusedStreams)
+        {
+            uint64 offset = it->second.filePos;
+            archive->DeleteAllKeys();
+            resultLoaded &= reader.ReadArchive(offset, archive);
+            it->first->LoadPolygonData(archive, this, it->second.requestedFormat, cutUnusedStreams);
+        }
+    }
+    return resultLoaded;
+}
+
+void SerializationContext::LoadPolygonGroupData(PolygonGroup* group, const KeyedArchive* archive)
+{
+    auto foundGroup = loadedPolygonGroups.find(group);
+    DVASSERT(foundGroup != loadedPolygonGroups.end());
+
+    bool cutUnusedStreams = QualitySettingsSystem::Instance()->GetAllowCutUnusedVertexStreams();
+    if (foundGroup->second.onScene || !cutUnusedStreams)
+    {
+        ScopedPtr<FastNameKeyedArchive> data(new FastNameKeyedArchive());
+        data->CopyFrom(archive);
+        group->LoadPolygonData(data, this, foundGroup->second.requestedFormat, cutUnusedStreams);
+    }
+}
 }
\ No newline at end of file
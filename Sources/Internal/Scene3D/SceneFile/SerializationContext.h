@@ -15,13 +15,15 @@ class NMaterial;
 class Texture;
 class NMaterial;
 class PolygonGroup;
+class FlatArchiveReader;
+class KeyedArchive;
 
 class SerializationContext
 {
 public:
     struct PolygonGroupLoadInfo
     {
-        uint32 filePos = 0;
+        uint64 filePos = 0;
         int32 requestedFormat = EVF_VERTEX; //vertex position loading is required as all code assumes it is there
         bool onScene = false;
     };
@@ -134,9 +136,12 @@ public:
 
     void ResolveMaterialBindings();
 
-    void AddLoadedPolygonGroup(PolygonGroup* group, uint32 dataFilePos);
+    void AddLoadedPolygonGroup(PolygonGroup* group, uint64 dataFilePos);
     void AddRequestedPolygonGroupFormat(PolygonGroup* group, int32 format);
     bool LoadPolygonGroupData(File* file);
+    bool LoadPolygonGroupData(const FlatArchiveReader& reader);
+    /** Load vertex data of single `group` from its already parsed `archive`. */
+    void LoadPolygonGroupData(PolygonGroup* group, const KeyedArchive* archive);
 
     template <template <typename, typename> class Container, class T, class A>
     void GetDataNodes(Container<T, A>& container);
@@ -1,4 +1,5 @@
 #include "Scene3D/SceneFileV2.h"
+#include "Scene3D/SceneFile/FlatArchive.h"
 #include "Scene3D/Entity.h"
 #include "Render/Texture.h"
 #include "Scene3D/PathManip.h"
@@ -59,6 +60,7 @@ SceneFileV2::SceneFileV2() //-V730 no need to init descriptor
 
 SceneFileV2::~SceneFileV2()
 {
+    EndLoadSceneArchive();
 }
 
 void SceneFileV2::EnableSaveForGame(bool _isSaveForGame)
@@ -66,6 +68,11 @@ void SceneFileV2::EnableSaveForGame(bool _isSaveForGame)
     isSaveForGame = _isSaveForGame;
 }
 
+void SceneFileV2::EnableFlatArchives(bool enabled)
+{
+    isFlatArchivesEnabled = enabled;
+}
+
 void SceneFileV2::EnableDebugLog(bool _isDebugLogEnabled)
 {
     isDebugLogEnabled = _isDebugLogEnabled;
@@ -111,8 +118,9 @@ SceneFileV2::eError SceneFileV2::SaveScene(const FilePath& filename, Scene* scen
         header.nodeCount++;
     }
 
-    descriptor.size = sizeof(descriptor.fileType); // + sizeof(descriptor.additionalField1) + sizeof(descriptor.additionalField1) +....
+    descriptor.size = sizeof(descriptor.fileType) + sizeof(descriptor.flags); // + sizeof(descriptor.additionalField1) + sizeof(descriptor.additionalField1) +....
     descriptor.fileType = fileType;
+    descriptor.flags = isFlatArchivesEnabled ? DESCRIPTOR_FLAG_FLAT_ARCHIVES : 0;
 
     serializationContext.SetRootNodePath(filename);
     serializationContext.SetScenePath(FilePath(filename.GetDirectory()));
@@ -148,6 +156,23 @@ SceneFileV2::eError SceneFileV2::SaveScene(const FilePath& filename, Scene* scen
         return GetError();
     }
 
+    // offset of flat archives keys table is known only after all archives are written
+    uint64 keysOffsetPos = 0;
+    flatWriter.reset();
+    if ((descriptor.flags & DESCRIPTOR_FLAG_FLAT_ARCHIVES) != 0)
+    {
+        flatWriter.reset(new FlatArchiveWriter());
+        keysOffsetPos = file->GetPos();
+
+        uint64 keysOffset = 0;
+        if (sizeof(uint64) != file->Write(&keysOffset, sizeof(uint64)))
+        {
+            Logger::Error("SceneFileV2::SaveScene failed to write flat archives header file: %s", filename.GetAbsolutePathname().c_str());
+            SetError(ERROR_FILE_WRITE_ERROR);
+            return GetError();
+        }
+    }
+
     // save data objects
     if (isDebugLogEnabled)
     {
@@ -262,7 +287,7 @@ SceneFileV2::eError SceneFileV2::SaveScene(const FilePath& filename, Scene* scen
 
         archive->SetString("##name", "GlobalMaterial");
         archive->SetUInt64("globalMaterialId", globalMaterialId);
-        if (!archive->Save(file))
+        if (!WriteArchive(file, archive))
         {
             Logger::Error("SceneFileV2::SaveScene failed to write global material settings file: %s", filename.GetAbsolutePathname().c_str());
             SetError(ERROR_FILE_WRITE_ERROR);
@@ -285,6 +310,21 @@ SceneFileV2::eError SceneFileV2::SaveScene(const FilePath& filename, Scene* scen
         }
     }
 
+    if (flatWriter)
+    {
+        uint64 keysOffset = file->GetPos();
+        if (!flatWriter->WriteKeys(file)
+            || !file->Seek(keysOffsetPos, File::SEEK_FROM_START)
+            || sizeof(uint64) != file->Write(&keysOffset, sizeof(uint64))
+            || !file->Seek(0, File::SEEK_FROM_END))
+        {
+            Logger::Error("SceneFileV2::SaveScene failed to write flat archives keys file: %s", filename.GetAbsolutePathname().c_str());
+            SetError(ERROR_FILE_WRITE_ERROR);
+            return GetError();
+        }
+        flatWriter.reset();
+    }
+
     if (!file->Flush())
     {
         SetError(ERROR_FILE_WRITE_ERROR);
@@ -387,6 +427,14 @@ SceneFileV2::eError SceneFileV2::LoadScene(const FilePath& filename, Scene* scen
         return GetError();
     }
 
+    return LoadScene(file, scene);
+}
+
+SceneFileV2::eError SceneFileV2::LoadScene(File* file, Scene* scene)
+{
+    DVASSERT(file != nullptr);
+
+    const FilePath& filename = file->GetFilename();
     const bool headerValid = ReadHeader(header, file);
 
     if (!headerValid)
@@ -424,6 +472,19 @@ SceneFileV2::eError SceneFileV2::LoadScene(const FilePath& filename, Scene* scen
         }
     }
 
+    flatReader.reset();
+    if ((descriptor.flags & DESCRIPTOR_FLAG_FLAT_ARCHIVES) != 0)
+    {
+        uint64 keysOffset = 0;
+        flatReader.reset(new FlatArchiveReader());
+        if (sizeof(uint64) != file->Read(&keysOffset, sizeof(uint64)) || !flatReader->Open(file, keysOffset))
+        {
+            Logger::Error("SceneFileV2::LoadScene failed to open flat archives in file: %s", filename.GetAbsolutePathname().c_str());
+            SetError(ERROR_FILE_READ_ERROR);
+            return GetError();
+        }
+    }
+
     VersionInfo::eStatus status = GetEngineContext()->versionInfo->TestVersion(scene->version);
     switch (status)
     {
@@ -463,6 +524,7 @@ SceneFileV2::eError SceneFileV2::LoadScene(const FilePath& filename, Scene* scen
             SetError(ERROR_FILE_READ_ERROR);
             return GetError();
         }
+        flatReadOffset = file->GetPos();
 
         for (int k = 0; k < dataNodeCount; ++k)
         {
@@ -480,9 +542,9 @@ SceneFileV2::eError SceneFileV2::LoadScene(const FilePath& filename, Scene* scen
         if (header.nodeCount > 0)
         {
             // try to load global material
-            uint32 filePos = static_cast<uint32>(file->GetPos());
+            uint64 filePos = 0;
             ScopedPtr<KeyedArchive> archive(new KeyedArchive());
-            const bool loaded = archive->Load(file);
+            const bool loaded = ReadArchive(file, archive, filePos);
             if (!loaded)
             {
                 Logger::Error("SceneFileV2::LoadScene load KeyedArchive with global material failed in file: %s", filename.GetAbsolutePathname().c_str());
@@ -500,7 +562,7 @@ SceneFileV2::eError SceneFileV2::LoadScene(const FilePath& filename, Scene* scen
             }
             else
             {
-                const bool res = file->Seek(filePos, File::SEEK_FROM_START);
+                const bool res = SeekArchive(file, filePos);
                 if (!res)
                 {
                     Logger::Error("SceneFileV2::LoadScene seek failed in file: %s", filename.GetAbsolutePathname().c_str());
@@ -534,13 +596,14 @@ SceneFileV2::eError SceneFileV2::LoadScene(const FilePath& filename, Scene* scen
     }
 
     UpdatePolygonGroupRequestedFormatRecursively(scene);
-    const bool contextLoaded = serializationContext.LoadPolygonGroupData(file);
+    const bool contextLoaded = flatReader ? serializationContext.LoadPolygonGroupData(*flatReader) : serializationContext.LoadPolygonGroupData(file);
     if (!contextLoaded)
     {
         Logger::Error("SceneFileV2::LoadScene LoadPolygonGroupData failed in file: %s", filename.GetAbsolutePathname().c_str());
         SetError(ERROR_FILE_READ_ERROR);
         return GetError();
     }
+    flatReader.reset();
     OptimizeScene(scene);
 
     if (serializationContext.GetVersion() < LODSYSTEM2)
@@ -589,14 +652,22 @@ void SceneFileV2::ApplyFogQuality(NMaterial* globalMaterial)
 
 SceneArchive* SceneFileV2::LoadSceneArchive(const FilePath& filename)
 {
-    SceneArchive* res = nullptr;
     ScopedPtr<File> file(File::Create(filename, File::OPEN | File::READ));
     if (!file)
     {
         Logger::Error("SceneFileV2::LoadScene failed to open file: %s", filename.GetAbsolutePathname().c_str());
-        return res;
+        return nullptr;
     }
 
+    return LoadSceneArchive(file);
+}
+
+SceneArchive* SceneFileV2::LoadSceneArchive(File* file)
+{
+    DVASSERT(file != nullptr);
+
+    SceneArchive* res = nullptr;
+    const FilePath& filename = file->GetFilename();
     const bool headerValid = ReadHeader(header, file);
 
     if (!headerValid)
@@ -631,6 +702,18 @@ SceneArchive* SceneFileV2::LoadSceneArchive(const FilePath& filename)
         }
     }
 
+    flatReader.reset();
+    if ((descriptor.flags & DESCRIPTOR_FLAG_FLAT_ARCHIVES) != 0)
+    {
+        uint64 keysOffset = 0;
+        flatReader.reset(new FlatArchiveReader());
+        if (sizeof(uint64) != file->Read(&keysOffset, sizeof(uint64)) || !flatReader->Open(file, keysOffset))
+        {
+            Logger::Error("SceneFileV2::LoadScene failed to open flat archives in file: %s", filename.GetAbsolutePathname().c_str());
+            return res;
+        }
+    }
+
     VersionInfo::eStatus status = GetEngineContext()->versionInfo->TestVersion(version);
     switch (status)
     {
@@ -651,6 +734,7 @@ SceneArchive* SceneFileV2::LoadSceneArchive(const FilePath& filename)
     }
 
     res = new SceneArchive();
+    res->version = version;
 
     if (header.version >= 2)
     {
@@ -662,11 +746,14 @@ SceneArchive* SceneFileV2::LoadSceneArchive(const FilePath& filename)
             SafeRelease(res);
             return nullptr;
         }
+        flatReadOffset = file->GetPos();
+
         bool loadedNodes = true;
         for (int k = 0; k < dataNodeCount; ++k)
         {
+            uint64 archivePos = 0;
             KeyedArchive* archive = new KeyedArchive();
-            loadedNodes &= archive->Load(file);
+            loadedNodes &= ReadArchive(file, archive, archivePos);
             if (!loadedNodes)
             {
                 SafeRelease(archive);
@@ -691,7 +778,7 @@ SceneArchive* SceneFileV2::LoadSceneArchive(const FilePath& filename)
     for (int ci = 0; ci < header.nodeCount; ++ci)
     {
         SceneArchive::SceneArchiveHierarchyNode* child = new SceneArchive::SceneArchiveHierarchyNode();
-        loadNodes &= child->LoadHierarchy(file);
+        loadNodes &= flatReader ? child->LoadHierarchy(*flatReader, flatReadOffset) : child->LoadHierarchy(file);
         if (!loadNodes)
         {
             SafeRelease(child);
@@ -713,9 +800,266 @@ SceneArchive* SceneFileV2::LoadSceneArchive(const FilePath& filename)
         SafeRelease(res);
         return nullptr;
     }
+    flatReader.reset();
     return res;
 }
 
+SceneFileV2::eError SceneFileV2::BeginLoadSceneArchive(SceneArchive* archive, const FilePath& filename, Scene* scene)
+{
+    DVASSERT(archive != nullptr && scene != nullptr);
+    DVASSERT(loadingArchive == nullptr, "Scene archive is already being loaded");
+
+    // archive is created by LoadSceneArchive, so its version is already checked
+    header.version = archive->version.version;
+    scene->version = archive->version;
+
+    serializationContext.SetRootNodePath(filename);
+    serializationContext.SetScenePath(filename.GetDirectory());
+    serializationContext.SetVersion(header.version);
+    serializationContext.SetScene(scene);
+    serializationContext.SetDefaultMaterialQuality(NMaterialQualityName::DEFAULT_QUALITY_NAME);
+
+    loadingArchive = SafeRetain(archive);
+    loadingScene = SafeRetain(scene);
+    loadingDataNodesCount = 0;
+    loadingMaterialsResolved = false;
+    loadingHierarchyIndex = 0;
+    loadingFormatsRequested = false;
+    loadingPolygonGroups.clear();
+    loadingPolygonGroupsCount = 0;
+
+    scene->children.reserve(archive->children.size());
+    SetError(ERROR_NO_ERROR);
+    return GetError();
+}
+
+bool SceneFileV2::LoadSceneArchiveStep()
+{
+    DVASSERT(loadingArchive != nullptr);
+
+    if (loadingDataNodesCount < loadingArchive->dataNodes.size())
+    {
+        KeyedArchive* archive = loadingArchive->dataNodes[loadingDataNodesCount];
+        // index of archive is stored instead of file position, vertex data is taken from the same archive
+        if (!LoadDataNode(loadingScene, archive, loadingDataNodesCount))
+        {
+            Logger::Error("SceneFileV2::LoadSceneArchiveStep LoadDataNode failed in file: %s", serializationContext.GetRootNodePath().GetAbsolutePathname().c_str());
+            SetError(ERROR_FILE_READ_ERROR);
+            EndLoadSceneArchive();
+            return false;
+        }
+
+        if (archive->GetString("##name") == "PolygonGroup")
+        {
+            DataNode* node = serializationContext.GetDataBlock(archive->GetByteArrayAsType<uint64>("#id", 0));
+            if (node != nullptr)
+            {
+                loadingPolygonGroups.emplace_back(static_cast<PolygonGroup*>(node), archive);
+            }
+        }
+
+        ++loadingDataNodesCount;
+        return true;
+    }
+
+    if (!loadingMaterialsResolved)
+    {
+        LoadSceneArchiveMaterials();
+        return true;
+    }
+
+    if (loadingHierarchyIndex < loadingArchive->children.size())
+    {
+        LoadHierarchy(loadingScene, loadingScene, loadingArchive->children[loadingHierarchyIndex], 1);
+        ++loadingHierarchyIndex;
+        return true;
+    }
+
+    if (!loadingFormatsRequested)
+    {
+        UpdatePolygonGroupRequestedFormatRecursively(loadingScene);
+        loadingFormatsRequested = true;
+        return true;
+    }
+
+    if (loadingPolygonGroupsCount < loadingPolygonGroups.size())
+    {
+        const auto& entry = loadingPolygonGroups[loadingPolygonGroupsCount];
+        serializationContext.LoadPolygonGroupData(entry.first, entry.second);
+        ++loadingPolygonGroupsCount;
+        return true;
+    }
+
+    OptimizeScene(loadingScene);
+    if (serializationContext.GetVersion() < LODSYSTEM2)
+    {
+        FixLodForLodsystem2(loadingScene);
+    }
+
+    EndLoadSceneArchive();
+    return false;
+}
+
+float32 SceneFileV2::GetLoadSceneArchiveProgress() const
+{
+    if (loadingArchive == nullptr)
+    {
+        return 1.f;
+    }
+
+    // data nodes, material bindings, top-level entities, requested vertex formats, polygon groups and scene optimization
+    uint32 dataNodesCount = static_cast<uint32>(loadingArchive->dataNodes.size());
+    uint32 entitiesCount = static_cast<uint32>(loadingArchive->children.size());
+    uint32 stepsCount = dataNodesCount + 1 + entitiesCount + 1 + static_cast<uint32>(loadingPolygonGroups.size()) + 1;
+    uint32 stepsDone = loadingDataNodesCount + (loadingMaterialsResolved ? 1 : 0) + loadingHierarchyIndex + (loadingFormatsRequested ? 1 : 0) + loadingPolygonGroupsCount;
+    return static_cast<float32>(stepsDone) / stepsCount;
+}
+
+void SceneFileV2::LoadSceneArchiveMaterials()
+{
+    NMaterial* globalMaterial = nullptr;
+
+    if (header.version >= 2 && !loadingArchive->children.empty())
+    {
+        // first hierarchy archive may be global material settings instead of entity, as in LoadScene
+        KeyedArchive* archive = loadingArchive->children[0]->archive;
+        if (archive->GetString("##name") == "GlobalMaterial")
+        {
+            uint64 globalMaterialId = archive->GetUInt64("globalMaterialId");
+            globalMaterial = static_cast<NMaterial*>(serializationContext.GetDataBlock(globalMaterialId));
+            serializationContext.SetGlobalMaterialKey(globalMaterialId);
+            loadingHierarchyIndex = 1;
+        }
+    }
+
+    serializationContext.ResolveMaterialBindings();
+    loadingMaterialsResolved = true;
+
+    ApplyFogQuality(globalMaterial);
+    loadingScene->SetGlobalMaterial(globalMaterial);
+}
+
+void SceneFileV2::EndLoadSceneArchive()
+{
+    if (loadingArchive != nullptr && !loadingMaterialsResolved)
+    {
+        // bindings of interrupted loading should be resolved before serialization context is destroyed
+        serializationContext.ResolveMaterialBindings();
+        loadingMaterialsResolved = true;
+    }
+
+    loadingPolygonGroups.clear();
+    SafeRelease(loadingArchive);
+    SafeRelease(loadingScene);
+}
+
+SceneFileV2::eError SceneFileV2::ConvertToFlatArchives(const FilePath& sourceFile, const FilePath& destinationFile)
+{
+    // whole source is read before writing, so scene may be converted in place
+    Header header;
+    Descriptor descriptor;
+    ScopedPtr<KeyedArchive> tagsArchive(new KeyedArchive());
+    int32 dataNodeCount = 0;
+    Vector<ScopedPtr<KeyedArchive>> archives;
+    {
+        ScopedPtr<File> file(File::Create(sourceFile, File::OPEN | File::READ));
+        if (!file)
+        {
+            Logger::Error("SceneFileV2::ConvertToFlatArchives failed to open file: %s", sourceFile.GetAbsolutePathname().c_str());
+            return ERROR_FAILED_TO_CREATE_FILE;
+        }
+
+        if (!ReadHeader(header, file))
+        {
+            return ERROR_FILE_READ_ERROR;
+        }
+
+        if (header.version < COMPONENTS_REFLECTION_SCENE_VERSION)
+        {
+            Logger::Error("SceneFileV2::ConvertToFlatArchives scene version %d is too old, resave it first. File: %s", header.version, sourceFile.GetAbsolutePathname().c_str());
+            return ERROR_VERSION_IS_TOO_OLD;
+        }
+
+        if (!tagsArchive->Load(file) || !ReadDescriptor(file, descriptor))
+        {
+            Logger::Error("SceneFileV2::ConvertToFlatArchives failed to read version tags or descriptor in file: %s", sourceFile.GetAbsolutePathname().c_str());
+            return ERROR_FILE_READ_ERROR;
+        }
+
+        if ((descriptor.flags & DESCRIPTOR_FLAG_FLAT_ARCHIVES) != 0)
+        {
+            Logger::Error("SceneFileV2::ConvertToFlatArchives scene is already converted: %s", sourceFile.GetAbsolutePathname().c_str());
+            return ERROR_FILE_READ_ERROR;
+        }
+
+        if (sizeof(int32) != file->Read(&dataNodeCount, sizeof(int32)))
+        {
+            Logger::Error("SceneFileV2::ConvertToFlatArchives failed to read datanodes count in file: %s", sourceFile.GetAbsolutePathname().c_str());
+            return ERROR_FILE_READ_ERROR;
+        }
+
+        // data nodes, global material settings and hierarchy are stored as sequence of archives up to the end of file
+        uint64 fileSize = file->GetSize();
+        while (file->GetPos() < fileSize)
+        {
+            ScopedPtr<KeyedArchive> archive(new KeyedArchive());
+            if (!archive->Load(file))
+            {
+                Logger::Error("SceneFileV2::ConvertToFlatArchives failed to read archive in file: %s", sourceFile.GetAbsolutePathname().c_str());
+                return ERROR_FILE_READ_ERROR;
+            }
+            archives.push_back(archive);
+        }
+    }
+
+    ScopedPtr<File> file(File::Create(destinationFile, File::CREATE | File::WRITE));
+    if (!file)
+    {
+        Logger::Error("SceneFileV2::ConvertToFlatArchives failed to create file: %s", destinationFile.GetAbsolutePathname().c_str());
+        return ERROR_FAILED_TO_CREATE_FILE;
+    }
+
+    header.version = FLAT_ARCHIVES_SCENE_VERSION;
+    descriptor.size = sizeof(descriptor.fileType) + sizeof(descriptor.flags);
+    descriptor.flags |= DESCRIPTOR_FLAG_FLAT_ARCHIVES;
+
+    FlatArchiveWriter writer;
+    uint64 keysOffsetPos = 0;
+    uint64 keysOffset = 0;
+    bool written = (sizeof(Header) == file->Write(&header, sizeof(Header)))
+    && tagsArchive->Save(file)
+    && WriteDescriptor(file, descriptor);
+
+    if (written)
+    {
+        keysOffsetPos = file->GetPos();
+        written = (sizeof(uint64) == file->Write(&keysOffset, sizeof(uint64)))
+        && (sizeof(int32) == file->Write(&dataNodeCount, sizeof(int32)));
+    }
+
+    for (uint32 i = 0, count = static_cast<uint32>(archives.size()); written && i < count; ++i)
+    {
+        written = writer.WriteArchive(archives[i], file);
+    }
+
+    if (written)
+    {
+        keysOffset = file->GetPos();
+        written = writer.WriteKeys(file)
+        && file->Seek(keysOffsetPos, File::SEEK_FROM_START)
+        && (sizeof(uint64) == file->Write(&keysOffset, sizeof(uint64)))
+        && file->Flush();
+    }
+
+    if (!written)
+    {
+        Logger::Error("SceneFileV2::ConvertToFlatArchives failed to write file: %s", destinationFile.GetAbsolutePathname().c_str());
+        return ERROR_FILE_WRITE_ERROR;
+    }
+
+    return ERROR_NO_ERROR;
+}
+
 bool SceneFileV2::WriteDescriptor(File* file, const Descriptor& descriptor)
 {
     if (sizeof(descriptor.size) != file->Write(&descriptor.size, sizeof(descriptor.size)))
@@ -728,6 +1072,14 @@ bool SceneFileV2::WriteDescriptor(File* file, const Descriptor& descriptor)
         return false;
     }
 
+    if (descriptor.size >= sizeof(descriptor.fileType) + sizeof(descriptor.flags))
+    {
+        if (sizeof(descriptor.flags) != file->Write(&descriptor.flags, sizeof(descriptor.flags)))
+        {
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -746,10 +1098,22 @@ bool SceneFileV2::ReadDescriptor(File* file, /*out*/ Descriptor& descriptor)
         return false;
     }
 
-    if (descriptor.size > sizeof(descriptor.fileType))
+    uint32 readSize = sizeof(descriptor.fileType);
+    descriptor.flags = 0;
+    if (descriptor.size >= readSize + sizeof(descriptor.flags))
+    {
+        result = file->Read(&descriptor.flags, sizeof(descriptor.flags));
+        if (result != sizeof(descriptor.flags))
+        {
+            return false;
+        }
+        readSize += sizeof(descriptor.flags);
+    }
+
+    if (descriptor.size > readSize)
     {
         //skip extra data probably added by future versions
-        const bool seekResult = file->Seek(descriptor.size - sizeof(descriptor.fileType), File::SEEK_FROM_CURRENT);
+        const bool seekResult = file->Seek(descriptor.size - readSize, File::SEEK_FROM_CURRENT);
         if (!seekResult)
         {
             return false;
@@ -758,12 +1122,45 @@ bool SceneFileV2::ReadDescriptor(File* file, /*out*/ Descriptor& descriptor)
     return true;
 }
 
+bool SceneFileV2::ReadArchive(File* file, KeyedArchive* archive, uint64& archivePos)
+{
+    if (flatReader)
+    {
+        archivePos = flatReadOffset;
+        return flatReader->ReadArchive(flatReadOffset, archive);
+    }
+
+    archivePos = file->GetPos();
+    return archive->Load(file);
+}
+
+bool SceneFileV2::SeekArchive(File* file, uint64 archivePos)
+{
+    if (flatReader)
+    {
+        flatReadOffset = archivePos;
+        return true;
+    }
+
+    return file->Seek(archivePos, File::SEEK_FROM_START);
+}
+
+bool SceneFileV2::WriteArchive(File* file, const KeyedArchive* archive)
+{
+    if (flatWriter)
+    {
+        return flatWriter->WriteArchive(archive, file);
+    }
+
+    return archive->Save(file);
+}
+
 bool SceneFileV2::SaveDataNode(DataNode* node, File* file)
 {
     KeyedArchive* archive = new KeyedArchive();
 
     node->Save(archive, &serializationContext);
-    if (!archive->Save(file))
+    if (!WriteArchive(file, archive))
     {
         SafeRelease(archive);
         return false;
@@ -776,10 +1173,16 @@ bool SceneFileV2::SaveDataNode(DataNode* node, File* file)
 bool SceneFileV2::LoadDataNode(Scene* scene, DataNode* parent, File* file)
 {
     bool loaded = true;
-    uint32 currFilePos = static_cast<uint32>(file->GetPos());
+    uint64 currFilePos = 0;
     ScopedPtr<KeyedArchive> archive(new KeyedArchive());
-    loaded &= archive->Load(file);
+    loaded &= ReadArchive(file, archive, currFilePos);
+
+    const bool nodeLoaded = LoadDataNode(scene, archive, currFilePos);
+    return loaded && nodeLoaded;
+}
 
+bool SceneFileV2::LoadDataNode(Scene* scene, KeyedArchive* archive, uint64 archivePos)
+{
     String name = archive->GetString("##name");
     DataNode* node = dynamic_cast<DataNode*>(ObjectFactory::Instance()->New<BaseObject>(name));
 
@@ -802,7 +1205,7 @@ bool SceneFileV2::LoadDataNode(Scene* scene, DataNode* parent, File* file)
 
         if (name == "PolygonGroup")
         {
-            serializationContext.AddLoadedPolygonGroup(static_cast<PolygonGroup*>(node), currFilePos);
+            serializationContext.AddLoadedPolygonGroup(static_cast<PolygonGroup*>(node), archivePos);
         }
 
         int32 childrenCount = archive->GetInt32("#childrenCount", 0);
@@ -810,7 +1213,7 @@ bool SceneFileV2::LoadDataNode(Scene* scene, DataNode* parent, File* file)
 
         SafeRelease(node);
     }
-    return loaded;
+    return true;
 }
 
 bool SceneFileV2::SaveDataHierarchy(DataNode* node, File* /*file*/, int32 /*level*/)
@@ -822,8 +1225,9 @@ bool SceneFileV2::SaveDataHierarchy(DataNode* node, File* /*file*/, int32 /*leve
 
 void SceneFileV2::LoadDataHierarchy(Scene* scene, DataNode* root, File* file, int32 level)
 {
+    uint64 archivePos = 0;
     ScopedPtr<KeyedArchive> archive(new KeyedArchive());
-    archive->Load(file);
+    ReadArchive(file, archive, archivePos);
 
     // DataNode * node = dynamic_cast<DataNode*>(BaseObject::LoadFromArchive(archive));
 
@@ -871,7 +1275,7 @@ bool SceneFileV2::SaveHierarchy(Entity* node, File* file, int32 level)
 
     archive->SetInt32("#childrenCount", node->GetChildrenCount());
 
-    if (!archive->Save(file))
+    if (!WriteArchive(file, archive))
     {
         return false;
     }
@@ -887,13 +1291,51 @@ bool SceneFileV2::SaveHierarchy(Entity* node, File* file, int32 level)
 bool SceneFileV2::LoadHierarchy(Scene* scene, Entity* parent, File* file, int32 level)
 {
     bool resultLoad = true;
-    bool keepUnusedQualityEntities = QualitySettingsSystem::Instance()->GetKeepUnusedEntities();
+    uint64 archivePos = 0;
     ScopedPtr<KeyedArchive> archive(new KeyedArchive());
-    resultLoad &= archive->Load(file);
+    resultLoad &= ReadArchive(file, archive, archivePos);
 
-    String name = archive->GetString("##name");
+    bool removeChildren = false;
+    Entity* node = LoadHierarchyEntity(scene, parent, archive, level, removeChildren);
+    if (nullptr != node)
+    {
+        int32 childrenCount = archive->GetInt32("#childrenCount", 0);
+        node->children.reserve(childrenCount);
+        for (int ci = 0; ci < childrenCount; ++ci)
+        {
+            resultLoad &= LoadHierarchy(scene, node, file, level + 1);
+        }
+
+        FinishHierarchyEntity(node, removeChildren && childrenCount > 0);
+        SafeRelease(node);
+    }
+    return resultLoad;
+}
 
+void SceneFileV2::LoadHierarchy(Scene* scene, Entity* parent, const SceneArchive::SceneArchiveHierarchyNode* archiveNode, int32 level)
+{
     bool removeChildren = false;
+    Entity* node = LoadHierarchyEntity(scene, parent, archiveNode->archive, level, removeChildren);
+    if (nullptr != node)
+    {
+        node->children.reserve(archiveNode->children.size());
+        for (const SceneArchive::SceneArchiveHierarchyNode* child : archiveNode->children)
+        {
+            LoadHierarchy(scene, node, child, level + 1);
+        }
+
+        FinishHierarchyEntity(node, removeChildren && !archiveNode->children.empty());
+        SafeRelease(node);
+    }
+}
+
+// create entity from `archive` and add it to `parent`, returned entity should be released by caller
+Entity* SceneFileV2::LoadHierarchyEntity(Scene* scene, Entity* parent, KeyedArchive* archive, int32 level, bool& removeChildren)
+{
+    bool keepUnusedQualityEntities = QualitySettingsSystem::Instance()->GetKeepUnusedEntities();
+    String name = archive->GetString("##name");
+
+    removeChildren = false;
     bool skipNode = false;
 
     Entity* node = nullptr;
@@ -943,26 +1385,21 @@ bool SceneFileV2::LoadHierarchy(Scene* scene, Entity* parent, File* file, int32
         {
             parent->AddNode(node);
         }
+    }
+    return node;
+}
 
-        int32 childrenCount = archive->GetInt32("#childrenCount", 0);
-        node->children.reserve(childrenCount);
-        for (int ci = 0; ci < childrenCount; ++ci)
-        {
-            resultLoad &= LoadHierarchy(scene, node, file, level + 1);
-        }
-
-        if (removeChildren && childrenCount)
-        {
-            node->RemoveAllChildren();
-        }
-
-        ParticleEffectComponent* effect = node->GetComponent<ParticleEffectComponent>();
-        if (effect && (effect->loadedVersion == 0))
-            effect->CollapseOldEffect(&serializationContext);
-
-        SafeRelease(node);
+// called after children of `node` are loaded
+void SceneFileV2::FinishHierarchyEntity(Entity* node, bool removeChildren)
+{
+    if (removeChildren)
+    {
+        node->RemoveAllChildren();
     }
-    return resultLoad;
+
+    ParticleEffectComponent* effect = node->GetComponent<ParticleEffectComponent>();
+    if (effect && (effect->loadedVersion == 0))
+        effect->CollapseOldEffect(&serializationContext);
 }
 
 void SceneFileV2::FixLodForLodsystem2(Entity* entity)
@@ -1443,6 +1880,22 @@ bool SceneArchive::SceneArchiveHierarchyNode::LoadHierarchy(File* file)
     return resultLoad;
 }
 
+bool SceneArchive::SceneArchiveHierarchyNode::LoadHierarchy(const FlatArchiveReader& reader, uint64& offset)
+{
+    bool resultLoad = true;
+    archive = new KeyedArchive();
+    resultLoad &= reader.ReadArchive(offset, archive);
+    int32 childrenCount = archive->GetInt32("#childrenCount", 0);
+    children.reserve(childrenCount);
+    for (int ci = 0; ci < childrenCount; ++ci)
+    {
+        SceneArchiveHierarchyNode* child = new SceneArchiveHierarchyNode();
+        resultLoad &= child->LoadHierarchy(reader, offset);
+        children.push_back(child);
+    }
+    return resultLoad;
+}
+
 SceneArchive::SceneArchiveHierarchyNode::~SceneArchiveHierarchyNode()
 {
     SafeRelease(archive);
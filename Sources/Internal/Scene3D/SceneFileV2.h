@@ -64,6 +64,8 @@ namespace DAVA
 
 class NMaterial;
 class Scene;
+class FlatArchiveReader;
+class FlatArchiveWriter;
 
 class SceneArchive : public BaseObject
 {
@@ -74,6 +76,7 @@ public:
         Vector<SceneArchiveHierarchyNode*> children;
         SceneArchiveHierarchyNode();
         bool LoadHierarchy(File* file);
+        bool LoadHierarchy(const FlatArchiveReader& reader, uint64& offset);
 
     protected:
         ~SceneArchiveHierarchyNode();
@@ -81,6 +84,7 @@ public:
 
     Vector<SceneArchiveHierarchyNode*> children;
     Vector<KeyedArchive*> dataNodes;
+    VersionInfo::SceneVersion version;
 
 protected:
     ~SceneArchive();
@@ -125,12 +129,27 @@ public:
 
     eError SaveScene(const FilePath& filename, Scene* _scene, SceneFileV2::eFileType fileType = SceneFileV2::SceneFile);
     eError LoadScene(const FilePath& filename, Scene* _scene);
+    /** Load scene from opened `file`, name of file is used to resolve paths of scene resources. */
+    eError LoadScene(File* file, Scene* _scene);
     static VersionInfo::SceneVersion LoadSceneVersion(const FilePath& filename);
 
     void EnableDebugLog(bool _isDebugLogEnabled);
     bool DebugLogEnabled();
     void EnableSaveForGame(bool _isSaveForGame);
 
+    /**
+        Save entities and data nodes in flat binary layout (see `FlatArchiveWriter`) instead of `KeyedArchive` binary format.
+        Such scenes are read directly from memory-mapped file content, which is much faster for large scenes.
+        Scenes of both layouts are loaded transparently.
+    */
+    void EnableFlatArchives(bool enabled);
+
+    /**
+        Rewrite archives of scene file `sourceFile` in flat binary layout into `destinationFile` without creation of scene objects.
+        Files may be the same. Scenes saved before FLAT_ARCHIVES_SCENE_VERSION-1 should be resaved first, as they require conversion while loading.
+    */
+    static eError ConvertToFlatArchives(const FilePath& sourceFile, const FilePath& destinationFile);
+
     //Material * GetMaterial(int32 index);
     //StaticMesh * GetStaticMesh(int32 index);
 
@@ -150,6 +169,21 @@ public:
 
     void UpdatePolygonGroupRequestedFormatRecursively(Entity* entity);
     SceneArchive* LoadSceneArchive(const FilePath& filename); //purely load data
+    SceneArchive* LoadSceneArchive(File* file); //purely load data, doesn't create scene objects and can be called on any thread
+
+    /**
+        Start creation of scene objects in `scene` from `archive` loaded by `LoadSceneArchive`, so it can be spread over several frames.
+        `filename` is the name of loaded file, it is used to resolve paths of scene resources. Scene objects use caches shared
+        with main thread, so all steps should be performed on main thread.
+    */
+    eError BeginLoadSceneArchive(SceneArchive* archive, const FilePath& filename, Scene* scene);
+    /**
+        Perform next step of loading started by `BeginLoadSceneArchive`: create next data node, next top-level entity with its children
+        or load vertex data of next polygon group. Return false when loading is finished or failed, result is returned by `GetError`.
+    */
+    bool LoadSceneArchiveStep();
+    /** Return progress of loading started by `BeginLoadSceneArchive` in range [0, 1]. */
+    float32 GetLoadSceneArchiveProgress() const;
 
 private:
     static bool ReadHeader(Header& header, File* file);
@@ -158,13 +192,23 @@ private:
 
     Header header;
 
+    enum eDescriptorFlags : uint32
+    {
+        DESCRIPTOR_FLAG_FLAT_ARCHIVES = 1 << 0, // archives are stored in flat layout, see FlatArchiveWriter
+    };
+
     struct Descriptor
     {
         uint32 size = 0;
         uint32 fileType = 0; //see enum SceneFileV2::eFileType
+        uint32 flags = 0; //see enum SceneFileV2::eDescriptorFlags, stored since FLAT_ARCHIVES_SCENE_VERSION
     };
     Descriptor descriptor;
 
+    bool ReadArchive(File* file, KeyedArchive* archive, uint64& archivePos);
+    bool SeekArchive(File* file, uint64 archivePos);
+    bool WriteArchive(File* file, const KeyedArchive* archive);
+
     // Vector<StaticMesh*> staticMeshes;
 
     bool SaveDataHierarchy(DataNode* node, File* file, int32 level);
@@ -178,8 +222,16 @@ private:
         return (!node->IsRuntime());
     }
 
+    bool LoadDataNode(Scene* scene, KeyedArchive* archive, uint64 archivePos);
+
     bool SaveHierarchy(Entity* node, File* file, int32 level);
     bool LoadHierarchy(Scene* scene, Entity* node, File* file, int32 level);
+    void LoadHierarchy(Scene* scene, Entity* parent, const SceneArchive::SceneArchiveHierarchyNode* archiveNode, int32 level);
+    Entity* LoadHierarchyEntity(Scene* scene, Entity* parent, KeyedArchive* archive, int32 level, bool& removeChildren);
+    void FinishHierarchyEntity(Entity* node, bool removeChildren);
+
+    void LoadSceneArchiveMaterials();
+    void EndLoadSceneArchive();
 
     void FixLodForLodsystem2(Entity* entity);
 
@@ -195,8 +247,23 @@ private:
 
     bool isDebugLogEnabled;
     bool isSaveForGame;
+    bool isFlatArchivesEnabled = false;
     eError lastError;
 
+    std::unique_ptr<FlatArchiveWriter> flatWriter;
+    std::unique_ptr<FlatArchiveReader> flatReader;
+    uint64 flatReadOffset = 0;
+
+    // state of loading started by BeginLoadSceneArchive
+    SceneArchive* loadingArchive = nullptr;
+    Scene* loadingScene = nullptr;
+    uint32 loadingDataNodesCount = 0;
+    bool loadingMaterialsResolved = false;
+    uint32 loadingHierarchyIndex = 0;
+    bool loadingFormatsRequested = false;
+    Vector<std::pair<PolygonGroup*, KeyedArchive*>> loadingPolygonGroups;
+    uint32 loadingPolygonGroupsCount = 0;
+
     SerializationContext serializationContext;
 };
 
@@ -47,7 +47,10 @@ void SkeletonAnimation::BindSkeleton(const SkeletonComponent* skeleton)
             const AnimationTrack* track = clip.animationClip->FindTrack(joint.uid.c_str());
             if (track != nullptr)
             {
-                clip.boundTracks.emplace_back(std::make_pair(j, track));
+                BoundTrack boundTrack;
+                boundTrack.jointIndex = j;
+                boundTrack.track = track;
+                clip.boundTracks.emplace_back(boundTrack);
                 maxJointIndex = Max(maxJointIndex, j);
             }
         }
@@ -59,6 +62,7 @@ void SkeletonAnimation::BindRootNode(const FastName& rootNodeID)
     for (SkeletonAnimationClip& clip : animationClips)
     {
         clip.rootNodeTrack = clip.animationClip->FindTrack(rootNodeID.c_str());
+        clip.rootNodeCursor = AnimationTrack::Cursor();
         if (clip.rootNodeTrack != nullptr)
         {
             for (uint32 c = 0; c < clip.rootNodeTrack->GetChannelsCount(); ++c)
@@ -83,13 +87,9 @@ void SkeletonAnimation::EvaluatePose(float32 animationLocalTime, SkeletonPose* o
 
     SkeletonAnimationClip* clip = FindClip(animationLocalTime);
 
-    uint32 boundTrackCount = uint32(clip->boundTracks.size());
-    for (uint32 t = 0; t < boundTrackCount; ++t)
+    for (BoundTrack& boundTrack : clip->boundTracks)
     {
-        uint32 jointIndex = clip->boundTracks[t].first;
-        const AnimationTrack* track = clip->boundTracks[t].second;
-
-        outPose->SetTransform(jointIndex, EvaluateJointTransform(animationLocalTime, track));
+        outPose->SetTransform(boundTrack.jointIndex, EvaluateJointTransform(animationLocalTime, boundTrack.track, &boundTrack.cursor));
     }
 }
 
@@ -137,7 +137,7 @@ float32 SkeletonAnimation::GetDuration() const
 
 //////////////////////////////////////////////////////////////////////////
 
-JointTransform SkeletonAnimation::EvaluateJointTransform(float32 time, const AnimationTrack* track)
+JointTransform SkeletonAnimation::EvaluateJointTransform(float32 time, const AnimationTrack* track, AnimationTrack::Cursor* cursor)
 {
     static const uint32 MAX_CHANNEL_VALUE_SIZE = 4;
     DVASSERT(MAX_CHANNEL_VALUE_SIZE >= track->GetMaxChannelValueSize());
@@ -146,7 +146,7 @@ JointTransform SkeletonAnimation::EvaluateJointTransform(float32 time, const Ani
     Array<float32, MAX_CHANNEL_VALUE_SIZE> workData;
     for (uint32 c = 0; c < track->GetChannelsCount(); ++c)
     {
-        track->Evaluate(time, c, workData.data(), uint32(workData.size()));
+        track->Evaluate(time, c, workData.data(), uint32(workData.size()), cursor);
 
         AnimationTrack::eChannelTarget target = track->GetChannelTarget(c);
         switch (target)
@@ -180,7 +180,7 @@ void SkeletonAnimation::EvaluateRootPosition(SkeletonAnimationClip* clip, float3
 
     if (clip->rootNodePositionChannel != std::numeric_limits<uint32>::max() && clip->rootNodeTrack != nullptr)
     {
-        clip->rootNodeTrack->Evaluate(GetClipLocalTime(clip, animationLocalTime), clip->rootNodePositionChannel, outPosition->data, uint32(Vector3::AXIS_COUNT));
+        clip->rootNodeTrack->Evaluate(GetClipLocalTime(clip, animationLocalTime), clip->rootNodePositionChannel, outPosition->data, uint32(Vector3::AXIS_COUNT), &clip->rootNodeCursor);
     }
 }
 
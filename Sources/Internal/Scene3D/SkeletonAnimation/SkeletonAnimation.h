@@ -1,5 +1,6 @@
 #pragma once
 
+#include "Animation/AnimationTrack.h"
 #include "Base/BaseTypes.h"
 #include "Scene3D/Components/SkeletonComponent.h"
 
@@ -25,13 +26,21 @@ public:
     float32 GetDuration() const;
 
 protected:
+    struct BoundTrack
+    {
+        uint32 jointIndex = 0;
+        const AnimationTrack* track = nullptr;
+        AnimationTrack::Cursor cursor;
+    };
+
     struct SkeletonAnimationClip
     {
         AnimationClip* animationClip = nullptr;
         UnorderedSet<uint32> jointsIgnoreMask;
 
-        Vector<std::pair<uint32, const AnimationTrack*>> boundTracks; //[jointIndex, track]
+        Vector<BoundTrack> boundTracks;
         const AnimationTrack* rootNodeTrack = nullptr; //for root-node transform extraction
+        AnimationTrack::Cursor rootNodeCursor;
         uint32 rootNodePositionChannel = std::numeric_limits<uint32>::max();
 
         float32 duration = 0.f;
@@ -39,7 +48,7 @@ protected:
         float32 animationStartTimestamp = 0.f;
     };
 
-    static JointTransform EvaluateJointTransform(float32 time, const AnimationTrack* track);
+    static JointTransform EvaluateJointTransform(float32 time, const AnimationTrack* track, AnimationTrack::Cursor* cursor);
     void EvaluateRootPosition(SkeletonAnimationClip* clip, float32 animationLocalTime, Vector3* outPosition);
     SkeletonAnimationClip* FindClip(float32 animationTime);
     float32 GetClipLocalTime(SkeletonAnimationClip* clip, float32 animationLocalTime);
@@ -25,11 +25,15 @@
 #include "Scene3D/Systems/QualitySettingsSystem.h"
 #include "Engine/Engine.h"
 #include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
+#include "Concurrency/LockGuard.h"
 
 namespace DAVA
 {
 namespace ParticleEffectSystemDetails
 {
+const uint32 EFFECTS_PER_JOB = 4;
+
 Matrix3 GenerateEmitterRotationMatrix(Vector3 vector, float32 power)
 {
     Vector3 axis(vector.y, -vector.x, 0);
@@ -220,6 +224,9 @@ void ParticleEffectSystem::RunEmitter(ParticleEffectComponent* effect, ParticleE
         group.loopLayerStartTime = group.layer->startTime;
         group.loopDuration = group.layer->endTime;
 
+        if (layer->type == ParticleLayer::TYPE_PARTICLE_STRIPE)
+            layer->CalculateMaxStripeSizeOverLife(); // cache value on main thread, stripes read it while being updated in worker jobs
+
         if (layer->sprite && (layer->type != ParticleLayer::TYPE_SUPEREMITTER_PARTICLES))
         {
             DAVA::Texture* flowmap = layer->flowmap.get() != nullptr ? layer->flowmap->GetTexture(0) : nullptr;
@@ -405,10 +412,11 @@ void ParticleEffectSystem::Process(float32 timeElapsed)
     float32 speedMult = 1.0f + (perfSettings->GetPsPerformanceSpeedMult() - 1.0f) * (1 - currPSValue);
     float32 shortEffectTime = timeElapsed * speedMult;
 
-    size_t componentsCount = activeComponents.size();
-    for (size_t i = 0; i < componentsCount; i++)
+    parallelEffects.clear();
+    serialEffects.clear();
+    Random* random = GetEngineContext()->random;
+    for (ParticleEffectComponent* effect : activeComponents)
     {
-        ParticleEffectComponent* effect = activeComponents[i];
         if (effect->activeLodLevel != effect->desiredLodLevel)
             UpdateActiveLod(effect);
         if (effect->state == ParticleEffectComponent::STATE_STARTING)
@@ -418,7 +426,26 @@ void ParticleEffectSystem::Process(float32 timeElapsed)
 
         if (effect->isPaused)
             continue;
-        UpdateEffect(effect, timeElapsed * effect->playbackSpeed, shortEffectTime * effect->playbackSpeed);
+
+        // seeds are taken in order of active effects, so simulation doesn't depend on how effects are spread between jobs
+        UpdatedEffect updatedEffect;
+        updatedEffect.effect = effect;
+        updatedEffect.randomSeed = random->Rand();
+        if (IsParallelUpdateAllowed(effect))
+            parallelEffects.push_back(updatedEffect);
+        else
+            serialEffects.push_back(updatedEffect);
+    }
+
+    UpdateEffects(timeElapsed, shortEffectTime);
+
+    // restart/stop and render system notifications are done on main thread in order of active effects
+    size_t componentsCount = activeComponents.size();
+    for (size_t i = 0; i < componentsCount; i++)
+    {
+        ParticleEffectComponent* effect = activeComponents[i];
+        if (effect->isPaused)
+            continue;
 
         bool effectEnded = effect->stopWhenEmpty ? effect->effectData.groups.empty() : (effect->time > effect->effectDuration);
         if (effectEnded)
@@ -456,6 +483,84 @@ void ParticleEffectSystem::Process(float32 timeElapsed)
     }
 }
 
+void ParticleEffectSystem::UpdateEffects(float32 timeElapsed, float32 shortEffectTime)
+{
+    auto updateEffect = [this, timeElapsed, shortEffectTime](const UpdatedEffect& updatedEffect, EffectUpdateContext& context) {
+        ParticleEffectComponent* effect = updatedEffect.effect;
+        context.random.seed(updatedEffect.randomSeed);
+        UpdateEffect(effect, timeElapsed * effect->playbackSpeed, shortEffectTime * effect->playbackSpeed, context);
+    };
+
+    uint32 parallelCount = static_cast<uint32>(parallelEffects.size());
+    ParallelForOrSerial(0, parallelCount, ParticleEffectSystemDetails::EFFECTS_PER_JOB, [this, &updateEffect](uint32 begin, uint32 end) {
+        EffectUpdateContext* context = AcquireUpdateContext();
+        for (uint32 i = begin; i < end; ++i)
+        {
+            updateEffect(parallelEffects[i], *context);
+        }
+        ReleaseUpdateContext(context);
+    });
+
+    // superemitters start inner emitters and acquire materials while updating, so such effects are updated on main thread
+    for (const UpdatedEffect& updatedEffect : serialEffects)
+    {
+        updateEffect(updatedEffect, mainUpdateContext);
+    }
+
+    ReleaseFinishedGroups(mainUpdateContext);
+    LockGuard<Mutex> lock(updateContextsMutex);
+    for (const std::unique_ptr<EffectUpdateContext>& context : freeUpdateContexts)
+    {
+        ReleaseFinishedGroups(*context);
+    }
+}
+
+bool ParticleEffectSystem::IsParallelUpdateAllowed(ParticleEffectComponent* effect) const
+{
+    for (const ParticleGroup& group : effect->effectData.groups)
+    {
+        if (group.layer->type == ParticleLayer::TYPE_SUPEREMITTER_PARTICLES)
+            return false;
+    }
+    return true;
+}
+
+ParticleEffectSystem::EffectUpdateContext* ParticleEffectSystem::AcquireUpdateContext()
+{
+    LockGuard<Mutex> lock(updateContextsMutex);
+    if (freeUpdateContexts.empty())
+        return new EffectUpdateContext();
+
+    EffectUpdateContext* context = freeUpdateContexts.back().release();
+    freeUpdateContexts.pop_back();
+    return context;
+}
+
+void ParticleEffectSystem::ReleaseUpdateContext(EffectUpdateContext* context)
+{
+    LockGuard<Mutex> lock(updateContextsMutex);
+    freeUpdateContexts.emplace_back(context);
+}
+
+void ParticleEffectSystem::ReleaseFinishedGroups(EffectUpdateContext& context)
+{
+    for (ParticleEmitter* emitter : context.releasedEmitters)
+    {
+        SafeRelease(emitter);
+    }
+    for (ParticleLayer* layer : context.releasedLayers)
+    {
+        SafeRelease(layer);
+    }
+    context.releasedEmitters.clear();
+    context.releasedLayers.clear();
+}
+
+float32 ParticleEffectSystem::EffectUpdateContext::RandomFloat()
+{
+    return static_cast<float32>(random() - random.min()) / static_cast<float32>(random.max() - random.min());
+}
+
 void ParticleEffectSystem::UpdateActiveLod(ParticleEffectComponent* effect)
 {
     DVASSERT(effect->activeLodLevel != effect->desiredLodLevel);
@@ -474,42 +579,26 @@ void ParticleEffectSystem::UpdateActiveLod(ParticleEffectComponent* effect)
             ParticleGroup& group = *it;
             if (group.layer->degradeStrategy == ParticleLayer::DEGRADE_REMOVE)
             {
-                Particle* current = group.head;
-                while (current)
-                {
-                    Particle* next = current->next;
-                    delete current;
-                    current = next;
-                }
-                group.head = nullptr;
+                group.particles.Clear();
             }
             else if (group.layer->degradeStrategy == ParticleLayer::DEGRADE_CUT_PARTICLES)
             {
-                Particle* current = group.head;
-                Particle* prev = nullptr;
-                int32 i = 0;
-                while (current)
-                {
-                    Particle* next = current->next;
-                    if (i % 2) //cut every second particle
-                    {
-                        delete current;
-                        group.activeParticleCount--;
-                        if (prev)
-                            prev->next = next;
-                        else
-                            group.head = next;
-                    }
-                    prev = current;
-                    current = next;
-                    i++;
-                }
+                //cut every second particle, order of particles in block is arbitrary so just drop the second half
+                group.particles.Shrink((group.particles.GetSize() + 1) / 2);
+                group.activeParticleCount = static_cast<int32>(group.particles.GetSize());
             }
         }
     }
 }
 
 void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32 deltaTime, float32 shortEffectTime)
+{
+    mainUpdateContext.random.seed(GetEngineContext()->random->Rand());
+    UpdateEffect(effect, deltaTime, shortEffectTime, mainUpdateContext);
+    ReleaseFinishedGroups(mainUpdateContext);
+}
+
+void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32 deltaTime, float32 shortEffectTime, EffectUpdateContext& context)
 {
     effect->time += deltaTime;
     const Matrix4* worldTransformPtr;
@@ -526,12 +615,9 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
 
     AABBox3 bbox;
     List<ParticleGroup>::iterator it = effect->effectData.groups.begin();
-    Random* random = GetEngineContext()->random;
-    bool isInverseCalculated = false;
     while (it != effect->effectData.groups.end())
     {
         ParticleGroup& group = *it;
-        group.activeParticleCount = 0;
         float32 dt = group.emitter->shortEffect ? shortEffectTime : deltaTime;
         group.time += dt;
         float32 groupEndTime = group.layer->isLooped ? group.layer->loopEndTime : group.layer->endTime;
@@ -543,132 +629,83 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
         if ((!group.finishingGroup) && (group.layer->isLooped) && (currLoopTime > group.loopDuration)) //restart loop
         {
             group.loopStartTime = group.time;
-            group.loopLayerStartTime = group.layer->deltaTime + group.layer->deltaVariation * static_cast<float32>(random->RandFloat());
-            group.loopDuration = group.loopLayerStartTime + (group.layer->endTime - group.layer->startTime) + group.layer->loopVariation * static_cast<float32>(random->RandFloat());
+            group.loopLayerStartTime = group.layer->deltaTime + group.layer->deltaVariation * context.RandomFloat();
+            group.loopDuration = group.loopLayerStartTime + (group.layer->endTime - group.layer->startTime) + group.layer->loopVariation * context.RandomFloat();
             currLoopTime = 0;
         }
 
-        //prepare forces as they will now actually change in time even for already generated particles
-        static Vector<Vector3> currSimplifiedForceValues;
-        int32 simplifiedForcesCount;
-
-        static Vector<ParticleForce*> effectAlignCurrForces;
-        static Vector<ParticleForce*> worldAlignCurrForces;
-        uint32 forcesCountWorldAlign = 0;
-        uint32 effectAlignForcesCount = 0;
+        ParticleBlock& particles = group.particles;
+        particles.UpdateLife(dt);
+        group.activeParticleCount = static_cast<int32>(particles.GetSize());
 
-        static Matrix4 invWorld;
-        if (group.head)
+        uint32 particlesCount = particles.GetSize();
+        if (particlesCount > 0)
         {
-            simplifiedForcesCount = static_cast<int32>(group.layer->GetSimplifiedParticleForces().size());
-            if (simplifiedForcesCount)
-            {
-                currSimplifiedForceValues.resize(simplifiedForcesCount);
-                for (int32 i = 0; i < simplifiedForcesCount; ++i)
-                {
-                    if (group.layer->GetSimplifiedParticleForces()[i]->force)
-                        currSimplifiedForceValues[i] = group.layer->GetSimplifiedParticleForces()[i]->force->GetValue(currLoopTime);
-                    else
-                        currSimplifiedForceValues[i] = Vector3(0, 0, 0);
-                }
-            }
+            //prepare forces as they will now actually change in time even for already generated particles
+            PrepareGroupForces(group, currLoopTime, *worldTransformPtr, context);
 
-            uint32 allForcesCount = static_cast<uint32>(group.layer->GetParticleForces().size());
-            if (allForcesCount > 0)
-            {
-                effectAlignCurrForces.resize(allForcesCount);
-                worldAlignCurrForces.resize(allForcesCount);
-                for (uint32 i = 0; i < allForcesCount; ++i)
-                {
-                    DAVA::ParticleForce* currForce = group.layer->GetParticleForces()[i];
-                    if (currForce->isGlobal)
-                        continue;
-
-                    if (currForce->worldAlign)
-                    {
-                        currForce->worldPosition = currForce->position + worldTransformPtr->GetTranslationVector(); // Ignore emitter rotation.
-                        worldAlignCurrForces[forcesCountWorldAlign] = currForce;
-                        ++forcesCountWorldAlign;
-                    }
-                    else
-                    {
-                        effectAlignCurrForces[effectAlignForcesCount] = currForce;
-                        ++effectAlignForcesCount;
-                        if (!isInverseCalculated)
-                        {
-                            invWorld = GetInverseWithRemovedScale(*worldTransformPtr);
-                            isInverseCalculated = true;
-                        }
-                    }
-                }
-            }
+            context.overLife.resize(particlesCount);
+            for (uint32 i = 0; i < particlesCount; ++i)
+                context.overLife[i] = particles.GetOverLife(i);
         }
 
-        Particle* current = group.head;
-        Particle* prev = nullptr;
-
-        while (current)
+        if (particlesCount > 0 && group.layer->type != ParticleLayer::TYPE_PARTICLE_STRIPE)
         {
-            current->life += dt;
-            if (current->life >= current->lifeTime)
-            {
-                Particle* next = current->next;
-                if (prev == nullptr)
-                    group.head = next;
-                else
-                    prev->next = next;
-                delete current;
-                current = next;
-                continue;
-            }
-            group.activeParticleCount++;
-
-            float32 overLifeTime = current->life / current->lifeTime;
-
-            if (group.layer->type != ParticleLayer::TYPE_PARTICLE_STRIPE)
-            {
-                UpdateRegularParticleData(effect, current, group, overLifeTime, simplifiedForcesCount, currSimplifiedForceValues, dt, bbox, effectAlignCurrForces, effectAlignForcesCount, worldAlignCurrForces, forcesCountWorldAlign, *worldTransformPtr, invWorld, currLoopTimeNormalized);
-            }
+            UpdateRegularParticles(effect, group, context, dt, currLoopTimeNormalized, bbox);
+        }
 
-            if (group.layer->type == ParticleLayer::TYPE_SUPEREMITTER_PARTICLES)
+        if (group.layer->type == ParticleLayer::TYPE_SUPEREMITTER_PARTICLES)
+        {
+            for (uint32 i = 0; i < particlesCount; ++i)
             {
-                effect->effectData.infoSources[current->positionTarget].position = current->position;
-                effect->effectData.infoSources[current->positionTarget].size = current->currSize;
+                ParentInfo& info = effect->effectData.infoSources[particles.attributes[i].positionTarget];
+                info.position = particles.GetPosition(i);
+                info.size = particles.currSize[i];
             }
+        }
 
-            if (group.layer->enableNoise && group.layer->noise.get() != nullptr)
+        if (group.layer->enableNoise && group.layer->noise.get() != nullptr)
+        {
+            for (uint32 i = 0; i < particlesCount; ++i)
             {
+                float32 overLifeTime = context.overLife[i];
+                ParticleAttributes& attributes = particles.attributes[i];
                 if (group.layer->noiseScaleOverLife != nullptr)
-                    current->currNoiseScale = current->baseNoiseScale * group.layer->noiseScaleOverLife->GetValue(overLifeTime);
+                    attributes.currNoiseScale = attributes.baseNoiseScale * group.layer->noiseScaleOverLife->GetValue(overLifeTime);
 
                 DAVA::float32 overLifeScale = 1.0f;
                 if (group.layer->noiseUScrollSpeedOverLife != nullptr)
                 {
                     overLifeScale = group.layer->noiseUScrollSpeedOverLife->GetValue(overLifeTime);
                 }
-                current->currNoiseUOffset += current->baseNoiseUScrollSpeed * overLifeScale * deltaTime;
+                attributes.currNoiseUOffset += attributes.baseNoiseUScrollSpeed * overLifeScale * deltaTime;
 
                 overLifeScale = 1.0f;
                 if (group.layer->noiseVScrollSpeedOverLife != nullptr)
                 {
                     overLifeScale = group.layer->noiseVScrollSpeedOverLife->GetValue(overLifeTime);
                 }
-                current->currNoiseVOffset += current->baseNoiseVScrollSpeed * overLifeScale * deltaTime;
+                attributes.currNoiseVOffset += attributes.baseNoiseVScrollSpeed * overLifeScale * deltaTime;
             }
+        }
 
-            if (group.layer->enableAlphaRemap && group.layer->alphaRemapSprite.get() != nullptr && group.layer->alphaRemapOverLife != nullptr)
+        if (group.layer->enableAlphaRemap && group.layer->alphaRemapSprite.get() != nullptr && group.layer->alphaRemapOverLife != nullptr)
+        {
+            for (uint32 i = 0; i < particlesCount; ++i)
             {
-                float32 lookup = overLifeTime * group.layer->alphaRemapLoopCount;
+                float32 lookup = context.overLife[i] * group.layer->alphaRemapLoopCount;
                 float32 intPart;
-                current->alphaRemap = group.layer->alphaRemapOverLife->GetValue(modff(lookup, &intPart));
+                particles.attributes[i].alphaRemap = group.layer->alphaRemapOverLife->GetValue(modff(lookup, &intPart));
             }
+        }
 
-            if (group.layer->type == ParticleLayer::TYPE_PARTICLE_STRIPE)
-                UpdateStripe(current, effect->effectData, group, deltaTime, bbox, currSimplifiedForceValues, simplifiedForcesCount, group.layer->IsLodActive(effect->activeLodLevel));
-
-            prev = current;
-            current = current->next;
+        if (group.layer->type == ParticleLayer::TYPE_PARTICLE_STRIPE)
+        {
+            int32 simplifiedForcesCount = static_cast<int32>(context.simplifiedForceValues.size());
+            for (uint32 i = 0; i < particlesCount; ++i)
+                UpdateStripe(particles, i, effect->effectData, group, deltaTime, bbox, context.simplifiedForceValues, simplifiedForcesCount, group.layer->IsLodActive(effect->activeLodLevel));
         }
+
         bool allowParticleGeneration = !group.finishingGroup;
         allowParticleGeneration &= (currLoopTime > group.loopLayerStartTime);
         allowParticleGeneration &= group.visibleLod;
@@ -676,13 +713,13 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
         {
             if (group.layer->type == ParticleLayer::TYPE_SINGLE_PARTICLE || group.layer->type == ParticleLayer::TYPE_PARTICLE_STRIPE)
             {
-                if (!group.head)
+                if (group.particles.IsEmpty())
                 {
-                    current = GenerateNewParticle(effect, group, currLoopTime, *worldTransformPtr);
+                    uint32 index = GenerateNewParticle(effect, group, currLoopTime, *worldTransformPtr, context);
                     if (group.layer->GetInheritPosition())
-                        AddParticleToBBox(current->position + effect->effectData.infoSources[group.positionSource].position, current->currRadius, bbox);
+                        AddParticleToBBox(group.particles.GetPosition(index) + effect->effectData.infoSources[group.positionSource].position, group.particles.currRadius[index], bbox);
                     else
-                        AddParticleToBBox(current->position, current->currRadius, bbox);
+                        AddParticleToBBox(group.particles.GetPosition(index), group.particles.currRadius[index], bbox);
                 }
             }
             else
@@ -692,26 +729,29 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
                 if (group.layer->number)
                     newParticles = group.layer->number->GetValue(currLoopTime);
                 if (group.layer->numberVariation)
-                    newParticles += group.layer->numberVariation->GetValue(currLoopTime) * static_cast<float32>(random->RandFloat());
+                    newParticles += group.layer->numberVariation->GetValue(currLoopTime) * context.RandomFloat();
                 newParticles *= dt;
                 group.particlesToGenerate += newParticles;
 
                 while (group.particlesToGenerate >= 1.0f)
                 {
                     group.particlesToGenerate -= 1.0f;
-                    current = GenerateNewParticle(effect, group, currLoopTime, *worldTransformPtr);
+                    uint32 index = GenerateNewParticle(effect, group, currLoopTime, *worldTransformPtr, context);
                     if (group.layer->GetInheritPosition())
-                        AddParticleToBBox(current->position + effect->effectData.infoSources[group.positionSource].position, current->currRadius, bbox);
+                        AddParticleToBBox(group.particles.GetPosition(index) + effect->effectData.infoSources[group.positionSource].position, group.particles.currRadius[index], bbox);
                     else
-                        AddParticleToBBox(current->position, current->currRadius, bbox);
+                        AddParticleToBBox(group.particles.GetPosition(index), group.particles.currRadius[index], bbox);
                 }
             }
         }
 
-        if (group.finishingGroup && (group.head == nullptr))
+        if (group.finishingGroup && group.particles.IsEmpty())
         {
-            DAVA::SafeRelease(group.emitter);
-            DAVA::SafeRelease(group.layer);
+            // releasing may destroy layer with its resources, which is only safe on main thread
+            context.releasedEmitters.push_back(group.emitter);
+            context.releasedLayers.push_back(group.layer);
+            group.emitter = nullptr;
+            group.layer = nullptr;
             it = effect->effectData.groups.erase(it);
         }
         else
@@ -727,12 +767,12 @@ void ParticleEffectSystem::UpdateEffect(ParticleEffectComponent* effect, float32
     effect->effectRenderObject->SetAABBox(bbox);
 }
 
-void ParticleEffectSystem::UpdateStripe(Particle* particle, ParticleEffectData& effectData, ParticleGroup& group, float32 dt, AABBox3& bbox, const Vector<Vector3>& currForceValues, int32 forcesCount, bool isActive)
+void ParticleEffectSystem::UpdateStripe(const ParticleBlock& particles, uint32 index, ParticleEffectData& effectData, ParticleGroup& group, float32 dt, AABBox3& bbox, const Vector<Vector3>& currForceValues, int32 forcesCount, bool isActive)
 {
     ParticleLayer* layer = group.layer;
     StripeData& data = group.stripe;
     Vector3 prevBasePosition = data.baseNode.position;
-    data.baseNode.position = particle->position;
+    data.baseNode.position = particles.GetPosition(index);
     data.isActive = isActive;
 
     if (layer->GetInheritPosition())
@@ -745,7 +785,7 @@ void ParticleEffectSystem::UpdateStripe(Particle* particle, ParticleEffectData&
         data.baseNode.position = effectData.infoSources[group.positionSource].position;
     }
 
-    data.baseNode.speed = particle->speed;
+    data.baseNode.speed = particles.GetSpeed(index);
 
     bool shouldInsert = data.stripeNodes.empty() || (data.baseNode.position - data.stripeNodes.front().position).SquareLength() > layer->stripeVertexSpawnStep * layer->stripeVertexSpawnStep;
 
@@ -814,7 +854,7 @@ void ParticleEffectSystem::UpdateStripe(Particle* particle, ParticleEffectData&
         else
         {
             float32 delta = (data.baseNode.position - prevBasePosition).Length();
-            if (particle->speed.DotProduct(data.baseNode.position - prevBasePosition) <= 0)
+            if (data.baseNode.speed.DotProduct(data.baseNode.position - prevBasePosition) <= 0)
             {
                 data.uvOffset -= delta;
             }
@@ -833,212 +873,339 @@ void ParticleEffectSystem::AddParticleToBBox(const Vector3& position, float radi
     bbox.AddPoint(position + sz);
 }
 
-Particle* ParticleEffectSystem::GenerateNewParticle(ParticleEffectComponent* effect, ParticleGroup& group, float32 currLoopTime, const Matrix4& worldTransform)
+uint32 ParticleEffectSystem::GenerateNewParticle(ParticleEffectComponent* effect, ParticleGroup& group, float32 currLoopTime, const Matrix4& worldTransform, EffectUpdateContext& context)
 {
-    Particle* particle = new Particle();
-    particle->life = 0.0f;
+    ParticleBlock& particles = group.particles;
+    uint32 index = particles.Add();
+    ParticleAttributes& attributes = particles.attributes[index];
 
-    particle->color = Color();
+    Color color = Color();
     if (group.layer->colorRandom)
     {
-        particle->color = group.layer->colorRandom->GetValue(static_cast<float32>(GetEngineContext()->random->RandFloat()));
+        color = group.layer->colorRandom->GetValue(context.RandomFloat());
     }
     if (group.emitter->colorOverLife)
     {
-        particle->color *= group.emitter->colorOverLife->GetValue(group.time);
+        color *= group.emitter->colorOverLife->GetValue(group.time);
     }
+    particles.color[index] = color;
 
-    particle->lifeTime = 0.0f;
+    float32 lifeTime = 0.0f;
     if (group.layer->life)
-        particle->lifeTime += group.layer->life->GetValue(currLoopTime);
+        lifeTime += group.layer->life->GetValue(currLoopTime);
     if (group.layer->lifeVariation)
-        particle->lifeTime += (group.layer->lifeVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
+        lifeTime += (group.layer->lifeVariation->GetValue(currLoopTime) * context.RandomFloat());
+    particles.life[index] = 0.0f;
+    particles.lifeTime[index] = lifeTime;
 
     // Flow.
-    particle->baseFlowSpeed = 0.0f;
+    attributes.baseFlowSpeed = 0.0f;
     if (group.layer->flowSpeed)
-        particle->baseFlowSpeed += group.layer->flowSpeed->GetValue(currLoopTime);
+        attributes.baseFlowSpeed += group.layer->flowSpeed->GetValue(currLoopTime);
     if (group.layer->flowSpeedVariation)
-        particle->baseFlowSpeed += (group.layer->flowSpeedVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->currFlowSpeed = particle->baseFlowSpeed;
+        attributes.baseFlowSpeed += (group.layer->flowSpeedVariation->GetValue(currLoopTime) * context.RandomFloat());
+    attributes.currFlowSpeed = attributes.baseFlowSpeed;
 
-    particle->baseFlowOffset = 0.0f;
+    attributes.baseFlowOffset = 0.0f;
     if (group.layer->flowOffset)
-        particle->baseFlowOffset += group.layer->flowOffset->GetValue(currLoopTime);
+        attributes.baseFlowOffset += group.layer->flowOffset->GetValue(currLoopTime);
     if (group.layer->flowOffsetVariation)
-        particle->baseFlowOffset += (group.layer->flowOffsetVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->currFlowOffset = particle->baseFlowOffset;
+        attributes.baseFlowOffset += (group.layer->flowOffsetVariation->GetValue(currLoopTime) * context.RandomFloat());
+    attributes.currFlowOffset = attributes.baseFlowOffset;
 
     // Noise.
-    particle->baseNoiseScale = 0.0f;
+    attributes.baseNoiseScale = 0.0f;
     if (group.layer->noiseScale)
-        particle->baseNoiseScale += group.layer->noiseScale->GetValue(currLoopTime);
+        attributes.baseNoiseScale += group.layer->noiseScale->GetValue(currLoopTime);
     if (group.layer->noiseScaleVariation)
-        particle->baseNoiseScale += (group.layer->noiseScaleVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->currNoiseScale = particle->baseNoiseScale;
+        attributes.baseNoiseScale += (group.layer->noiseScaleVariation->GetValue(currLoopTime) * context.RandomFloat());
+    attributes.currNoiseScale = attributes.baseNoiseScale;
 
-    particle->baseNoiseUScrollSpeed = 0.0f;
+    attributes.baseNoiseUScrollSpeed = 0.0f;
     if (group.layer->noiseUScrollSpeed)
-        particle->baseNoiseUScrollSpeed += group.layer->noiseUScrollSpeed->GetValue(currLoopTime);
+        attributes.baseNoiseUScrollSpeed += group.layer->noiseUScrollSpeed->GetValue(currLoopTime);
     if (group.layer->noiseUScrollSpeedVariation)
-        particle->baseNoiseUScrollSpeed += (group.layer->noiseUScrollSpeedVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->currNoiseUOffset = particle->baseNoiseUScrollSpeed;
+        attributes.baseNoiseUScrollSpeed += (group.layer->noiseUScrollSpeedVariation->GetValue(currLoopTime) * context.RandomFloat());
+    attributes.currNoiseUOffset = attributes.baseNoiseUScrollSpeed;
 
-    particle->baseNoiseVScrollSpeed = 0.0f;
+    attributes.baseNoiseVScrollSpeed = 0.0f;
     if (group.layer->noiseVScrollSpeed)
-        particle->baseNoiseVScrollSpeed += group.layer->noiseVScrollSpeed->GetValue(currLoopTime);
+        attributes.baseNoiseVScrollSpeed += group.layer->noiseVScrollSpeed->GetValue(currLoopTime);
     if (group.layer->noiseVScrollSpeedVariation)
-        particle->baseNoiseVScrollSpeed += (group.layer->noiseVScrollSpeedVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->currNoiseVOffset = particle->baseNoiseVScrollSpeed;
+        attributes.baseNoiseVScrollSpeed += (group.layer->noiseVScrollSpeedVariation->GetValue(currLoopTime) * context.RandomFloat());
+    attributes.currNoiseVOffset = attributes.baseNoiseVScrollSpeed;
 
     // size
-    particle->baseSize = Vector2(1.0f, 1.0f);
+    Vector2 baseSize = Vector2(1.0f, 1.0f);
     if (group.layer->size)
-        particle->baseSize = group.layer->size->GetValue(currLoopTime);
+        baseSize = group.layer->size->GetValue(currLoopTime);
     if (group.layer->sizeVariation)
-        particle->baseSize += (group.layer->sizeVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->baseSize *= effect->effectData.infoSources[group.positionSource].size;
+        baseSize += (group.layer->sizeVariation->GetValue(currLoopTime) * context.RandomFloat());
+    baseSize *= effect->effectData.infoSources[group.positionSource].size;
 
-    particle->currSize = particle->baseSize;
+    Vector2 currSize = baseSize;
     if (group.layer->sizeOverLifeXY)
-        particle->currSize *= group.layer->sizeOverLifeXY->GetValue(0);
-    Vector2 pivotSize = particle->currSize * group.layer->layerPivotSizeOffsets;
-    particle->currRadius = pivotSize.Length();
-
-    particle->angle = 0.0f;
-    particle->spin = 0.0f;
+        currSize *= group.layer->sizeOverLifeXY->GetValue(0);
+    Vector2 pivotSize = currSize * group.layer->layerPivotSizeOffsets;
+    particles.baseSize[index] = baseSize;
+    particles.currSize[index] = currSize;
+    particles.currRadius[index] = pivotSize.Length();
+
+    float32 angle = 0.0f;
+    float32 spin = 0.0f;
     if (group.layer->angle)
-        particle->angle = DegToRad(group.layer->angle->GetValue(currLoopTime));
+        angle = DegToRad(group.layer->angle->GetValue(currLoopTime));
     if (group.layer->angleVariation)
-        particle->angle += DegToRad(group.layer->angleVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
+        angle += DegToRad(group.layer->angleVariation->GetValue(currLoopTime) * context.RandomFloat());
     if (group.layer->spin)
-        particle->spin = DegToRad(group.layer->spin->GetValue(currLoopTime));
+        spin = DegToRad(group.layer->spin->GetValue(currLoopTime));
     if (group.layer->spinVariation)
-        particle->spin += DegToRad(group.layer->spinVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
+        spin += DegToRad(group.layer->spinVariation->GetValue(currLoopTime) * context.RandomFloat());
     if (group.layer->randomSpinDirection)
     {
-        int32 dir = Rand() & 1;
-        particle->spin *= (dir)*2 - 1;
+        int32 dir = context.random() & 1;
+        spin *= (dir)*2 - 1;
     }
-    particle->frame = 0;
-    particle->animTime = 0;
+    particles.angle[index] = angle;
+    particles.spin[index] = spin;
+
+    attributes.frame = 0;
+    attributes.animTime = 0;
     if (group.layer->randomFrameOnStart && group.layer->sprite)
     {
-        particle->frame = static_cast<int32>(static_cast<float32>(GetEngineContext()->random->RandFloat()) * static_cast<float32>(group.layer->sprite->GetFrameCount()));
+        attributes.frame = static_cast<int32>(context.RandomFloat() * static_cast<float32>(group.layer->sprite->GetFrameCount()));
     }
 
-    PrepareEmitterParameters(particle, group, worldTransform);
+    uintptr_t groupAddress = reinterpret_cast<uintptr_t>(&group);
+    attributes.randomSeed = static_cast<uint32>(groupAddress) + group.particlesGenerated;
+
+    Vector3 position;
+    Vector3 speed;
+    PrepareEmitterParameters(group, worldTransform, position, speed, context);
 
     float32 vel = 0.0f;
     if (group.layer->velocity)
         vel += group.layer->velocity->GetValue(currLoopTime);
     if (group.layer->velocityVariation)
-        vel += (group.layer->velocityVariation->GetValue(currLoopTime) * static_cast<float32>(GetEngineContext()->random->RandFloat()));
-    particle->speed *= vel;
+        vel += (group.layer->velocityVariation->GetValue(currLoopTime) * context.RandomFloat());
+    speed *= vel;
 
     if (!group.layer->GetInheritPosition()) //just generate at correct position
     {
-        particle->position += effect->effectData.infoSources[group.positionSource].position;
+        position += effect->effectData.infoSources[group.positionSource].position;
     }
+    particles.SetPosition(index, position);
+    particles.SetSpeed(index, speed);
 
-    particle->next = group.head;
-    group.head = particle;
     group.activeParticleCount++;
     if (group.layer->type == ParticleLayer::TYPE_SUPEREMITTER_PARTICLES)
     {
         ParentInfo info;
-        info.position = particle->position;
-        info.size = particle->currSize;
+        info.position = position;
+        info.size = currSize;
         effect->effectData.infoSources.push_back(info);
-        particle->positionTarget = static_cast<int32>(effect->effectData.infoSources.size() - 1);
+        attributes.positionTarget = static_cast<int32>(effect->effectData.infoSources.size() - 1);
         ParticleEmitter* innerEmitter = group.layer->innerEmitter->GetEmitter();
         if (innerEmitter)
-            RunEmitter(effect, innerEmitter, Vector3(0, 0, 0), particle->positionTarget);
+            RunEmitter(effect, innerEmitter, Vector3(0, 0, 0), attributes.positionTarget);
     }
 
     group.particlesGenerated++;
-    return particle;
+    return index;
 }
 
-void ParticleEffectSystem::UpdateRegularParticleData(ParticleEffectComponent* effect, Particle* particle, const ParticleGroup& group, float32 overLife, int32 simplifiedForcesCount, Vector<Vector3>& currSimplifiedForceValues, float32 dt, AABBox3& bbox, const Vector<ParticleForce*>& effectAlignForces, uint32 effectAlignForcesCount, const Vector<ParticleForce*>& worldAlignForces, uint32 worldAlignForcesCount, const Matrix4& world, const Matrix4& invWorld, float32 layerOverLife)
+void ParticleEffectSystem::PrepareGroupForces(ParticleGroup& group, float32 currLoopTime, const Matrix4& worldTransform, EffectUpdateContext& context)
 {
-    float32 currVelocityOverLife = 1.0f;
-    if (group.layer->velocityOverLife)
-        currVelocityOverLife = group.layer->velocityOverLife->GetValue(overLife);
-    Vector3 prevParticlePosition = particle->position;
-    particle->position += particle->speed * (currVelocityOverLife * dt);
-
-    float32 currSpinOverLife = 1.0f;
-    if (group.layer->spinOverLife)
-        currSpinOverLife = group.layer->spinOverLife->GetValue(overLife);
-    particle->angle += particle->spin * currSpinOverLife * dt;
+    const Vector<ParticleForceSimplified*>& simplifiedForces = group.layer->GetSimplifiedParticleForces();
+    context.simplifiedForceValues.resize(simplifiedForces.size());
+    for (size_t i = 0; i < simplifiedForces.size(); ++i)
+    {
+        if (simplifiedForces[i]->force)
+            context.simplifiedForceValues[i] = simplifiedForces[i]->force->GetValue(currLoopTime);
+        else
+            context.simplifiedForceValues[i] = Vector3(0, 0, 0);
+    }
 
-    Vector3 acceleration(0.0f, 0.0f, 0.0f);
-    for (int32 i = 0; i < simplifiedForcesCount; ++i)
+    context.effectAlignForces.clear();
+    context.worldAlignForces.clear();
+    context.worldAlignForcePositions.clear();
+    for (ParticleForce* currForce : group.layer->GetParticleForces())
     {
-        acceleration += (group.layer->GetSimplifiedParticleForces()[i]->forceOverLife) ? (currSimplifiedForceValues[i] * group.layer->GetSimplifiedParticleForces()[i]->forceOverLife->GetValue(overLife)) : currSimplifiedForceValues[i];
+        if (currForce->isGlobal)
+            continue;
+
+        if (currForce->worldAlign)
+        {
+            context.worldAlignForces.push_back(currForce);
+            context.worldAlignForcePositions.push_back(currForce->position + worldTransform.GetTranslationVector()); // Ignore emitter rotation.
+        }
+        else
+        {
+            context.effectAlignForces.push_back(currForce);
+        }
     }
 
-    for (uint32 i = 0; i < worldAlignForcesCount; ++i)
-        ParticleForces::ApplyForce(worldAlignForces[i], particle->speed, particle->position, dt, overLife, layerOverLife, Vector3(0.0f, 0.0f, -1.0f), particle, prevParticlePosition, worldAlignForces[i]->worldPosition);
+    context.world = worldTransform;
+    if (!context.effectAlignForces.empty())
+        context.invWorld = GetInverseWithRemovedScale(worldTransform);
+}
 
-    if (effectAlignForcesCount > 0)
+void ParticleEffectSystem::UpdateRegularParticles(ParticleEffectComponent* effect, ParticleGroup& group, EffectUpdateContext& context, float32 dt, float32 layerOverLife, AABBox3& bbox)
+{
+    ParticleLayer* layer = group.layer;
+    ParticleBlock& particles = group.particles;
+    uint32 count = particles.GetSize();
+    const Vector<float32>& overLife = context.overLife;
+
+    // Property lines are evaluated per particle into temporary arrays,
+    // then positions, speeds and bbox are processed for all particles of group at once.
+    context.velocityScale.resize(count);
+    if (layer->velocityOverLife)
+    {
+        for (uint32 i = 0; i < count; ++i)
+            context.velocityScale[i] = layer->velocityOverLife->GetValue(overLife[i]);
+    }
+    else
     {
-        Vector3 effectSpacePosition;
-        Vector3 prevEffectSpacePosition;
-        Vector3 effectSpaceSpeed;
-        effectSpacePosition = particle->position * invWorld;
-        effectSpaceSpeed = particle->speed * Matrix3(invWorld);
-        if (group.layer->GetPlaneCollisiontForcesCount() > 0)
-            prevEffectSpacePosition = prevParticlePosition * invWorld;
+        std::fill(context.velocityScale.begin(), context.velocityScale.end(), 1.0f);
+    }
 
-        for (uint32 i = 0; i < effectAlignForcesCount; ++i)
-            ParticleForces::ApplyForce(effectAlignForces[i], effectSpaceSpeed, effectSpacePosition, dt, overLife, layerOverLife, -Vector3(invWorld._20, invWorld._21, invWorld._22), particle, prevEffectSpacePosition, effectAlignForces[i]->position);
+    bool applyForces = !context.worldAlignForces.empty() || !context.effectAlignForces.empty() || (layer->applyGlobalForces && !globalForces.empty());
+    if (applyForces)
+    {
+        context.prevPositionX.resize(count);
+        context.prevPositionY.resize(count);
+        context.prevPositionZ.resize(count);
+        particles.IntegratePositions(dt, context.velocityScale.data(), context.prevPositionX.data(), context.prevPositionY.data(), context.prevPositionZ.data());
+    }
+    else
+    {
+        particles.IntegratePositions(dt, context.velocityScale.data(), nullptr, nullptr, nullptr);
+    }
 
-        particle->speed = effectSpaceSpeed * Matrix3(world);
-        if (group.layer->GetAlterPositionForcesCount() > 0)
-            particle->position = effectSpacePosition * world;
+    if (layer->spinOverLife)
+    {
+        for (uint32 i = 0; i < count; ++i)
+            particles.angle[i] += particles.spin[i] * layer->spinOverLife->GetValue(overLife[i]) * dt;
+    }
+    else
+    {
+        for (uint32 i = 0; i < count; ++i)
+            particles.angle[i] += particles.spin[i] * dt;
+    }
+
+    const Vector<ParticleForceSimplified*>& simplifiedForces = layer->GetSimplifiedParticleForces();
+    if (!simplifiedForces.empty())
+    {
+        context.accelerationX.assign(count, 0.0f);
+        context.accelerationY.assign(count, 0.0f);
+        context.accelerationZ.assign(count, 0.0f);
+        for (size_t f = 0; f < simplifiedForces.size(); ++f)
+        {
+            Vector3 value = context.simplifiedForceValues[f];
+            for (uint32 i = 0; i < count; ++i)
+            {
+                Vector3 acceleration = (simplifiedForces[f]->forceOverLife) ? (value * simplifiedForces[f]->forceOverLife->GetValue(overLife[i])) : value;
+                context.accelerationX[i] += acceleration.x;
+                context.accelerationY[i] += acceleration.y;
+                context.accelerationZ[i] += acceleration.z;
+            }
+        }
     }
 
-    if (group.layer->applyGlobalForces)
-        ApplyGlobalForces(particle, dt, overLife, layerOverLife, prevParticlePosition);
+    if (applyForces)
+        ApplyParticleForces(group, context, dt, layerOverLife);
 
-    particle->speed += acceleration * dt;
+    if (!simplifiedForces.empty())
+        particles.IntegrateSpeeds(dt, context.accelerationX.data(), context.accelerationY.data(), context.accelerationZ.data());
 
-    if (group.layer->sizeOverLifeXY)
+    if (layer->sizeOverLifeXY)
     {
-        particle->currSize = particle->baseSize * group.layer->sizeOverLifeXY->GetValue(overLife);
-        Vector2 pivotSize = particle->currSize * group.layer->layerPivotSizeOffsets;
-        particle->currRadius = pivotSize.Length();
+        for (uint32 i = 0; i < count; ++i)
+        {
+            particles.currSize[i] = particles.baseSize[i] * layer->sizeOverLifeXY->GetValue(overLife[i]);
+            Vector2 pivotSize = particles.currSize[i] * layer->layerPivotSizeOffsets;
+            particles.currRadius[i] = pivotSize.Length();
+        }
     }
-    if (group.layer->GetInheritPosition())
-        AddParticleToBBox(particle->position + effect->effectData.infoSources[group.positionSource].position, particle->currRadius, bbox);
+
+    if (layer->GetInheritPosition())
+        particles.AddToBBox(effect->effectData.infoSources[group.positionSource].position, bbox);
     else
-        AddParticleToBBox(particle->position, particle->currRadius, bbox);
+        particles.AddToBBox(Vector3(0.0f, 0.0f, 0.0f), bbox);
 
-    if (group.layer->frameOverLifeEnabled && group.layer->sprite)
+    if (layer->frameOverLifeEnabled && layer->sprite)
     {
-        float32 animDelta = group.layer->frameOverLifeFPS;
-        if (group.layer->animSpeedOverLife)
-            animDelta *= group.layer->animSpeedOverLife->GetValue(overLife);
-        particle->animTime += animDelta * dt;
-
-        while (particle->animTime > 1.0f)
+        int32 framesCount = layer->sprite->GetFrameCount();
+        for (uint32 i = 0; i < count; ++i)
         {
-            particle->frame++;
-            particle->animTime -= 1.0f;
-            if (particle->frame >= group.layer->sprite->GetFrameCount())
+            ParticleAttributes& attributes = particles.attributes[i];
+            float32 animDelta = layer->frameOverLifeFPS;
+            if (layer->animSpeedOverLife)
+                animDelta *= layer->animSpeedOverLife->GetValue(overLife[i]);
+            attributes.animTime += animDelta * dt;
+
+            while (attributes.animTime > 1.0f)
             {
-                if (group.layer->loopSpriteAnimation)
-                    particle->frame = 0;
-                else
-                    particle->frame = group.layer->sprite->GetFrameCount() - 1;
+                attributes.frame++;
+                attributes.animTime -= 1.0f;
+                if (attributes.frame >= framesCount)
+                {
+                    if (layer->loopSpriteAnimation)
+                        attributes.frame = 0;
+                    else
+                        attributes.frame = framesCount - 1;
+                }
             }
         }
     }
 }
 
-void ParticleEffectSystem::ApplyGlobalForces(Particle* particle, float32 dt, float32 overLife, float32 layerOverLife, Vector3 prevParticlePosition)
+void ParticleEffectSystem::ApplyParticleForces(ParticleGroup& group, EffectUpdateContext& context, float32 dt, float32 layerOverLife)
+{
+    ParticleLayer* layer = group.layer;
+    ParticleBlock& particles = group.particles;
+    uint32 count = particles.GetSize();
+    const Matrix4& world = context.world;
+    const Matrix4& invWorld = context.invWorld;
+
+    for (uint32 i = 0; i < count; ++i)
+    {
+        float32 overLife = context.overLife[i];
+        Vector3 position = particles.GetPosition(i);
+        Vector3 speed = particles.GetSpeed(i);
+        Vector3 prevParticlePosition(context.prevPositionX[i], context.prevPositionY[i], context.prevPositionZ[i]);
+
+        for (size_t f = 0; f < context.worldAlignForces.size(); ++f)
+            ParticleForces::ApplyForce(context.worldAlignForces[f], speed, position, dt, overLife, layerOverLife, Vector3(0.0f, 0.0f, -1.0f), &particles, i, prevParticlePosition, context.worldAlignForcePositions[f]);
+
+        if (!context.effectAlignForces.empty())
+        {
+            Vector3 effectSpacePosition;
+            Vector3 prevEffectSpacePosition;
+            Vector3 effectSpaceSpeed;
+            effectSpacePosition = position * invWorld;
+            effectSpaceSpeed = speed * Matrix3(invWorld);
+            if (layer->GetPlaneCollisiontForcesCount() > 0)
+                prevEffectSpacePosition = prevParticlePosition * invWorld;
+
+            for (ParticleForce* force : context.effectAlignForces)
+                ParticleForces::ApplyForce(force, effectSpaceSpeed, effectSpacePosition, dt, overLife, layerOverLife, -Vector3(invWorld._20, invWorld._21, invWorld._22), &particles, i, prevEffectSpacePosition, force->position);
+
+            speed = effectSpaceSpeed * Matrix3(world);
+            if (layer->GetAlterPositionForcesCount() > 0)
+                position = effectSpacePosition * world;
+        }
+
+        if (layer->applyGlobalForces)
+            ApplyGlobalForces(particles, i, speed, position, dt, overLife, layerOverLife, prevParticlePosition);
+
+        particles.SetPosition(i, position);
+        particles.SetSpeed(i, speed);
+    }
+}
+
+void ParticleEffectSystem::ApplyGlobalForces(ParticleBlock& particles, uint32 index, Vector3& speed, Vector3& position, float32 dt, float32 overLife, float32 layerOverLife, const Vector3& prevParticlePosition)
 {
     for (auto& forcePair : globalForces)
     {
@@ -1049,8 +1216,8 @@ void ParticleEffectSystem::ApplyGlobalForces(Particle* particle, float32 dt, flo
         for (ParticleForce* force : forcePair.second.worldAlignForces)
         {
             Vector3 forceWorldPosition = worldTransformPtr->GetTranslationVector() + force->position;
-            if (force->isInfinityRange || (forceWorldPosition - particle->position).SquareLength() < force->GetSquaredRadius())
-                ParticleForces::ApplyForce(force, particle->speed, particle->position, dt, overLife, layerOverLife, Vector3(0.0f, 0.0f, -1.0f), particle, prevParticlePosition, forceWorldPosition);
+            if (force->isInfinityRange || (forceWorldPosition - position).SquareLength() < force->GetSquaredRadius())
+                ParticleForces::ApplyForce(force, speed, position, dt, overLife, layerOverLife, Vector3(0.0f, 0.0f, -1.0f), &particles, index, prevParticlePosition, forceWorldPosition);
         }
 
         if (!forcePair.second.effectAlignForces.empty())
@@ -1064,7 +1231,7 @@ void ParticleEffectSystem::ApplyGlobalForces(Particle* particle, float32 dt, flo
                     break;
                 }
                 Vector3 forceWorldPosition = worldTransformPtr->GetTranslationVector() + force->position; // Do not rotate global forces if force position is not zero.
-                float32 sqrDist = (forceWorldPosition - particle->position).SquareLength();
+                float32 sqrDist = (forceWorldPosition - position).SquareLength();
                 if (sqrDist < force->GetSquaredRadius())
                 {
                     inForceBoundingSphere = true;
@@ -1076,24 +1243,24 @@ void ParticleEffectSystem::ApplyGlobalForces(Particle* particle, float32 dt, flo
 
             Matrix4 invWorld = GetInverseWithRemovedScale(*worldTransformPtr);
 
-            Vector3 effectSpacePosition = particle->position * invWorld;
+            Vector3 effectSpacePosition = position * invWorld;
             Vector3 prevEffectSpacePosition = prevParticlePosition * invWorld;
-            Vector3 effectSpaceSpeed = particle->speed * Matrix3(invWorld);
+            Vector3 effectSpaceSpeed = speed * Matrix3(invWorld);
             bool transformPosition = false;
             for (ParticleForce* force : forcePair.second.effectAlignForces)
             {
                 if (force->CanAlterPosition())
                     transformPosition = true;
-                ParticleForces::ApplyForce(force, effectSpaceSpeed, effectSpacePosition, dt, overLife, layerOverLife, -Vector3(invWorld._20, invWorld._21, invWorld._22), particle, prevEffectSpacePosition, force->position);
+                ParticleForces::ApplyForce(force, effectSpaceSpeed, effectSpacePosition, dt, overLife, layerOverLife, -Vector3(invWorld._20, invWorld._21, invWorld._22), &particles, index, prevEffectSpacePosition, force->position);
             }
-            particle->speed = effectSpaceSpeed * Matrix3(*worldTransformPtr);
+            speed = effectSpaceSpeed * Matrix3(*worldTransformPtr);
             if (transformPosition)
-                particle->position = effectSpacePosition * (*worldTransformPtr);
+                position = effectSpacePosition * (*worldTransformPtr);
         }
     }
 }
 
-void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, ParticleGroup& group, const Matrix4& worldTransform)
+void ParticleEffectSystem::PrepareEmitterParameters(ParticleGroup& group, const Matrix4& worldTransform, Vector3& position, Vector3& speed, EffectUpdateContext& context)
 {
     //calculate position new particle position in emitter space (for point leave it V3(0,0,0))
     uintptr_t uptr = reinterpret_cast<uintptr_t>(&group);
@@ -1106,7 +1273,7 @@ void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, Particle
         if (group.emitter->size)
         {
             Vector3 currSize = group.emitter->size->GetValue(group.time);
-            particle->position = Vector3(currSize.x * (ParticlesRandom::VanDerCorputRnd(ind, 3) - 0.5f), currSize.y * (ParticlesRandom::VanDerCorputRnd(ind, 2) - 0.5f), currSize.z * (ParticlesRandom::VanDerCorputRnd(ind, 5) - 0.5f));
+            position = Vector3(currSize.x * (ParticlesRandom::VanDerCorputRnd(ind, 3) - 0.5f), currSize.y * (ParticlesRandom::VanDerCorputRnd(ind, 2) - 0.5f), currSize.z * (ParticlesRandom::VanDerCorputRnd(ind, 5) - 0.5f));
         }
     }
     else if ((group.emitter->emitterType == ParticleEmitter::EMITTER_ONCIRCLE_VOLUME) || (group.emitter->emitterType == ParticleEmitter::EMITTER_ONCIRCLE_EDGES) || (group.emitter->emitterType == ParticleEmitter::EMITTER_SHOCKWAVE))
@@ -1124,11 +1291,11 @@ void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, Particle
 
         float32 curAngle = angleBase + angleVariation * ParticlesRandom::VanDerCorputRnd(ind, 3);
         if (group.emitter->emitterType == ParticleEmitter::EMITTER_ONCIRCLE_VOLUME)
-            curRadius *= std::sqrt(static_cast<float32>(GetEngineContext()->random->RandFloat())); // Better distribution on circle.
+            curRadius *= std::sqrt(context.RandomFloat()); // Better distribution on circle.
         float32 sinAngle = 0.0f;
         float32 cosAngle = 0.0f;
         SinCosFast(curAngle, sinAngle, cosAngle);
-        particle->position = Vector3(curRadius * cosAngle, curRadius * sinAngle, 0.0f);
+        position = Vector3(curRadius * cosAngle, curRadius * sinAngle, 0.0f);
     }
 
     //current emission vector and it's length
@@ -1148,11 +1315,11 @@ void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, Particle
     //calculate speed in emitter space not transformed by emission vector yet
     if (group.emitter->emitterType == ParticleEmitter::EMITTER_SHOCKWAVE)
     {
-        particle->speed = particle->position;
-        float32 spl = particle->speed.SquareLength();
+        speed = position;
+        float32 spl = speed.SquareLength();
         if (spl > EPSILON)
         {
-            particle->speed *= currVelPower / std::sqrt(spl);
+            speed *= currVelPower / std::sqrt(spl);
         }
     }
     else
@@ -1161,11 +1328,11 @@ void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, Particle
         {
             float32 theta = ParticlesRandom::VanDerCorputRnd(ind, 3) * DegToRad(group.emitter->emissionRange->GetValue(group.time)) * 0.5f;
             float32 phi = ParticlesRandom::VanDerCorputRnd(ind, 4) * PI_2;
-            particle->speed = Vector3(currVelPower * cos(phi) * sin(theta), currVelPower * sin(phi) * sin(theta), currVelPower * cos(theta));
+            speed = Vector3(currVelPower * cos(phi) * sin(theta), currVelPower * sin(phi) * sin(theta), currVelPower * cos(theta));
         }
         else
         {
-            particle->speed = Vector3(0, 0, currVelPower);
+            speed = Vector3(0, 0, currVelPower);
         }
     }
 
@@ -1177,19 +1344,19 @@ void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, Particle
     {
         if (currEmissionVector.z < 0)
         {
-            particle->position = particle->position * PIRotationAroundX;
+            position = position * PIRotationAroundX;
 
             if (!hasCustomEmissionVector)
-                particle->speed = particle->speed * PIRotationAroundX;
+                speed = speed * PIRotationAroundX;
         }
     }
     else
     {
         Matrix3 rotation = ParticleEffectSystemDetails::GenerateEmitterRotationMatrix(currEmissionVector, currEmissionPower);
-        particle->position = particle->position * rotation;
+        position = position * rotation;
 
         if (!hasCustomEmissionVector)
-            particle->speed = particle->speed * rotation;
+            speed = speed * rotation;
     }
 
     if (hasCustomEmissionVector)
@@ -1197,16 +1364,16 @@ void ParticleEffectSystem::PrepareEmitterParameters(Particle* particle, Particle
         if ((std::abs(currVelVector.x) < EPSILON) && (std::abs(currVelVector.y) < EPSILON))
         {
             if (currVelVector.z < 0)
-                particle->speed = particle->speed * PIRotationAroundX;
+                speed = speed * PIRotationAroundX;
         }
         else
         {
-            particle->speed = particle->speed * ParticleEffectSystemDetails::GenerateEmitterRotationMatrix(currVelVector, currVelPower);
+            speed = speed * ParticleEffectSystemDetails::GenerateEmitterRotationMatrix(currVelVector, currVelPower);
         }
     }
-    particle->position += group.spawnPosition;
-    TransformPerserveLength(particle->speed, newTransform);
-    TransformPerserveLength(particle->position, newTransform); //note - from now emitter position is not effected by scale anymore (artist request)
+    position += group.spawnPosition;
+    TransformPerserveLength(speed, newTransform);
+    TransformPerserveLength(position, newTransform); //note - from now emitter position is not effected by scale anymore (artist request)
 }
 
 void ParticleEffectSystem::SetGlobalExtertnalValue(const String& name, float32 value)
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "Base/BaseTypes.h"
+#include "Concurrency/Mutex.h"
 #include "Entity/SceneSystem.h"
 #include "Scene3D/Components/ParticleEffectComponent.h"
 
+#include <random>
+
 namespace DAVA
 {
 class Component;
@@ -90,17 +93,64 @@ protected:
 
     void UpdateActiveLod(ParticleEffectComponent* effect);
     void UpdateEffect(ParticleEffectComponent* effect, float32 deltaTime, float32 shortEffectTime);
-    Particle* GenerateNewParticle(ParticleEffectComponent* effect, ParticleGroup& group, float32 currLoopTime, const Matrix4& worldTransform);
-    void UpdateRegularParticleData(ParticleEffectComponent* effect, Particle* particle, const ParticleGroup& group, float32 overLife, int32 simplifiedForcesCount, Vector<Vector3>& currSimplifiedForceValues, float32 dt, AABBox3& bbox, const Vector<ParticleForce*>& effectAlignForces, uint32 effectAlignForcesCount, const Vector<ParticleForce*>& worldAlignForces, uint32 worldAlignForcesCount, const Matrix4& world, const Matrix4& invWorld, float32 layerOverLife);
-
-    void PrepareEmitterParameters(Particle* particle, ParticleGroup& group, const Matrix4& worldTransform);
     void AddParticleToBBox(const Vector3& position, float radius, AABBox3& bbox);
 
     void RunEmitter(ParticleEffectComponent* effect, ParticleEmitter* emitter, const Vector3& spawnPosition, int32 positionSource = 0);
 
 private:
-    void ApplyGlobalForces(Particle* particle, float32 dt, float32 overLife, float32 layerOverLife, Vector3 prevParticlePosition);
-    void UpdateStripe(Particle* particle, ParticleEffectData& effectData, ParticleGroup& group, float32 dt, AABBox3& bbox, const Vector<Vector3>& currForceValues, int32 forcesCount, bool isActive);
+    /**
+        Scratch data of single effect update. Holds current values of group forces, per-particle temporary
+        arrays used by vectorized passes of `ParticleBlock` and random generator used for new particles.
+        Effects updated in worker jobs use separate contexts, so nothing here is shared between threads.
+        Layers and emitters of finished groups are collected in `releasedLayers` and `releasedEmitters`
+        and released on main thread by `ReleaseFinishedGroups` after update.
+    */
+    struct EffectUpdateContext
+    {
+        float32 RandomFloat();
+
+        std::minstd_rand random;
+
+        Vector<Vector3> simplifiedForceValues;
+        Vector<ParticleForce*> effectAlignForces;
+        Vector<ParticleForce*> worldAlignForces;
+        Vector<Vector3> worldAlignForcePositions;
+        Matrix4 world;
+        Matrix4 invWorld;
+
+        Vector<float32> overLife;
+        Vector<float32> velocityScale;
+        Vector<float32> accelerationX;
+        Vector<float32> accelerationY;
+        Vector<float32> accelerationZ;
+        Vector<float32> prevPositionX;
+        Vector<float32> prevPositionY;
+        Vector<float32> prevPositionZ;
+
+        Vector<ParticleLayer*> releasedLayers;
+        Vector<ParticleEmitter*> releasedEmitters;
+    };
+
+    struct UpdatedEffect
+    {
+        ParticleEffectComponent* effect = nullptr;
+        uint32 randomSeed = 0;
+    };
+
+    void UpdateEffects(float32 timeElapsed, float32 shortEffectTime);
+    void UpdateEffect(ParticleEffectComponent* effect, float32 deltaTime, float32 shortEffectTime, EffectUpdateContext& context);
+    bool IsParallelUpdateAllowed(ParticleEffectComponent* effect) const;
+    EffectUpdateContext* AcquireUpdateContext();
+    void ReleaseUpdateContext(EffectUpdateContext* context);
+    void ReleaseFinishedGroups(EffectUpdateContext& context);
+
+    uint32 GenerateNewParticle(ParticleEffectComponent* effect, ParticleGroup& group, float32 currLoopTime, const Matrix4& worldTransform, EffectUpdateContext& context);
+    void PrepareEmitterParameters(ParticleGroup& group, const Matrix4& worldTransform, Vector3& position, Vector3& speed, EffectUpdateContext& context);
+    void PrepareGroupForces(ParticleGroup& group, float32 currLoopTime, const Matrix4& worldTransform, EffectUpdateContext& context);
+    void UpdateRegularParticles(ParticleEffectComponent* effect, ParticleGroup& group, EffectUpdateContext& context, float32 dt, float32 layerOverLife, AABBox3& bbox);
+    void ApplyParticleForces(ParticleGroup& group, EffectUpdateContext& context, float32 dt, float32 layerOverLife);
+    void ApplyGlobalForces(ParticleBlock& particles, uint32 index, Vector3& speed, Vector3& position, float32 dt, float32 overLife, float32 layerOverLife, const Vector3& prevParticlePosition);
+    void UpdateStripe(const ParticleBlock& particles, uint32 index, ParticleEffectData& effectData, ParticleGroup& group, float32 dt, AABBox3& bbox, const Vector<Vector3>& currForceValues, int32 forcesCount, bool isActive);
     void SimulateEffect(ParticleEffectComponent* effect);
 
     Map<String, float32> globalExternalValues;
@@ -114,6 +164,13 @@ private:
     void RemoveForcesFromGlobal(ParticleEffectComponent* effect);
     void ExtractGlobalForces(ParticleEffectComponent* effect);
 
+    EffectUpdateContext mainUpdateContext;
+    Vector<std::unique_ptr<EffectUpdateContext>> freeUpdateContexts;
+    Mutex updateContextsMutex;
+
+    Vector<UpdatedEffect> parallelEffects;
+    Vector<UpdatedEffect> serialEffects;
+
 private: //materials stuff
     NMaterial* particleBaseMaterial;
     Vector<std::pair<MaterialData, NMaterial*>> particlesMaterials;
@@ -3,6 +3,9 @@
 #include "Animation/AnimationTrack.h"
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
+#include "Math/SIMD.h"
 #include "Render/Highlevel/SkinnedMesh.h"
 #include "Scene3D/Entity.h"
 #include "Scene3D/Components/ComponentHelpers.h"
@@ -16,10 +19,150 @@
 
 namespace DAVA
 {
+namespace SkeletonSystemDetails
+{
+// skeletons are independent from each other, so they are distributed across jobs by chunks of this size
+const uint32 SKELETONS_PER_JOB = 8;
+
+// Joint transform is packed into two float4: position with uniform scale in w and orientation quaternion.
+// Appending transform (ps1, q1) to (ps0, q0) gives: position = p0 + rotate(q0, p1) * s0, scale = s0 * s1, orientation = q0 * q1.
+// Box is transformed by its center and extent, result is the same as box of eight transformed corners.
+#if defined(DAVA_SIMD_SSE)
+inline __m128 Splat(__m128 v, int32 lane)
+{
+    switch (lane)
+    {
+    case 0:
+        return _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0));
+    case 1:
+        return _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1));
+    case 2:
+        return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2));
+    default:
+        return _mm_shuffle_ps(v, v, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+}
+
+// w of result is zero
+inline __m128 Cross(__m128 a, __m128 b)
+{
+    __m128 aYZX = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 bYZX = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+    __m128 c = _mm_sub_ps(_mm_mul_ps(a, bYZX), _mm_mul_ps(aYZX, b));
+    return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+}
+
+// same as Quaternion::ApplyToVectorFast, w of vector is kept as is
+inline __m128 Rotate(__m128 q, __m128 v)
+{
+    __m128 t = Cross(q, v);
+    t = _mm_add_ps(t, t);
+    return _mm_add_ps(_mm_add_ps(v, _mm_mul_ps(Splat(q, 3), t)), Cross(q, t));
+}
+
+inline __m128 Multiply(__m128 a, __m128 b)
+{
+    const __m128 signX = _mm_setr_ps(1.f, -1.f, 1.f, -1.f);
+    const __m128 signY = _mm_setr_ps(1.f, 1.f, -1.f, -1.f);
+    const __m128 signZ = _mm_setr_ps(-1.f, 1.f, 1.f, -1.f);
+
+    __m128 res = _mm_mul_ps(Splat(a, 3), b);
+    res = _mm_add_ps(res, _mm_mul_ps(_mm_mul_ps(Splat(a, 0), _mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3))), signX));
+    res = _mm_add_ps(res, _mm_mul_ps(_mm_mul_ps(Splat(a, 1), _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2))), signY));
+    res = _mm_add_ps(res, _mm_mul_ps(_mm_mul_ps(Splat(a, 2), _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1))), signZ));
+    return res;
+}
+
+inline __m128 Abs(__m128 v)
+{
+    return _mm_max_ps(v, _mm_sub_ps(_mm_setzero_ps(), v));
+}
+
+void AppendTransform(const Vector4& ps0, const Vector4& q0, const Vector4& ps1, const Vector4& q1, Vector4& psOut, Vector4& qOut)
+{
+    __m128 vps0 = _mm_loadu_ps(ps0.data);
+    __m128 vq0 = _mm_loadu_ps(q0.data);
+
+    // rotated position keeps s1 in w, so w of result is s0 * s1
+    __m128 p0 = _mm_mul_ps(vps0, _mm_setr_ps(1.f, 1.f, 1.f, 0.f));
+    __m128 ps = _mm_add_ps(p0, _mm_mul_ps(Rotate(vq0, _mm_loadu_ps(ps1.data)), Splat(vps0, 3)));
+    __m128 q = Multiply(vq0, _mm_loadu_ps(q1.data));
+
+    _mm_storeu_ps(psOut.data, ps);
+    _mm_storeu_ps(qOut.data, q);
+}
+
+AABBox3 TransformBox(const AABBox3& box, const Vector4& ps, const Vector4& q)
+{
+    __m128 vps = _mm_loadu_ps(ps.data);
+    __m128 vq = _mm_loadu_ps(q.data);
+    __m128 scale = Abs(Splat(vps, 3));
+
+    __m128 boxMin = _mm_setr_ps(box.min.x, box.min.y, box.min.z, 0.f);
+    __m128 boxMax = _mm_setr_ps(box.max.x, box.max.y, box.max.z, 0.f);
+    __m128 half = _mm_set1_ps(0.5f);
+    __m128 center = _mm_mul_ps(_mm_add_ps(boxMin, boxMax), half);
+    __m128 extent = _mm_mul_ps(_mm_sub_ps(boxMax, boxMin), half);
+
+    center = _mm_add_ps(vps, _mm_mul_ps(Rotate(vq, center), Splat(vps, 3)));
+
+    const __m128 axisX = _mm_setr_ps(1.f, 0.f, 0.f, 0.f);
+    const __m128 axisY = _mm_setr_ps(0.f, 1.f, 0.f, 0.f);
+    const __m128 axisZ = _mm_setr_ps(0.f, 0.f, 1.f, 0.f);
+    __m128 radius = Abs(Rotate(vq, _mm_mul_ps(extent, axisX)));
+    radius = _mm_add_ps(radius, Abs(Rotate(vq, _mm_mul_ps(extent, axisY))));
+    radius = _mm_add_ps(radius, Abs(Rotate(vq, _mm_mul_ps(extent, axisZ))));
+    radius = _mm_mul_ps(radius, scale);
+
+    float32 resMin[4];
+    float32 resMax[4];
+    _mm_storeu_ps(resMin, _mm_sub_ps(center, radius));
+    _mm_storeu_ps(resMax, _mm_add_ps(center, radius));
+    return AABBox3(Vector3(resMin), Vector3(resMax));
+}
+#else
+void AppendTransform(const Vector4& ps0, const Vector4& q0, const Vector4& ps1, const Vector4& q1, Vector4& psOut, Vector4& qOut)
+{
+    Quaternion orientation0(q0.data);
+    Vector3 position = Vector3(ps0.data) + orientation0.ApplyToVectorFast(Vector3(ps1.data)) * ps0.w;
+
+    psOut = Vector4(position, ps0.w * ps1.w);
+    qOut = Vector4((orientation0 * Quaternion(q1.data)).data);
+}
+
+AABBox3 TransformBox(const AABBox3& box, const Vector4& ps, const Vector4& q)
+{
+    Quaternion orientation(q.data);
+    float32 scale = std::abs(ps.w);
+
+    Vector3 center = Vector3(ps.data) + orientation.ApplyToVectorFast(box.GetCenter()) * ps.w;
+    Vector3 extent = box.GetSize() * 0.5f;
+
+    Vector3 axisX = orientation.ApplyToVectorFast(Vector3(extent.x, 0.f, 0.f));
+    Vector3 axisY = orientation.ApplyToVectorFast(Vector3(0.f, extent.y, 0.f));
+    Vector3 axisZ = orientation.ApplyToVectorFast(Vector3(0.f, 0.f, extent.z));
+    Vector3 radius(std::abs(axisX.x) + std::abs(axisY.x) + std::abs(axisZ.x),
+                   std::abs(axisX.y) + std::abs(axisY.y) + std::abs(axisZ.y),
+                   std::abs(axisX.z) + std::abs(axisY.z) + std::abs(axisZ.z));
+    radius *= scale;
+
+    return AABBox3(center - radius, center + radius);
+}
+#endif
+
+void StoreTransform(const Vector4& ps, const Vector4& q, JointTransform& transform)
+{
+    transform.SetPosition(Vector3(ps.data));
+    transform.SetOrientation(Quaternion(q.data));
+    transform.SetScale(ps.w);
+}
+}
+
 SkeletonSystem::SkeletonSystem(Scene* scene)
     : SceneSystem(scene)
 {
     scene->GetEventSystem()->RegisterSystemForEvent(this, EventSystem::SKELETON_CONFIG_CHANGED);
+    skeletons = scene->AcquireEntityGroup<SkeletonComponent>();
 }
 
 SkeletonSystem::~SkeletonSystem()
@@ -29,8 +172,6 @@ SkeletonSystem::~SkeletonSystem()
 
 void SkeletonSystem::AddEntity(Entity* entity)
 {
-    entities.push_back(entity);
-
     SkeletonComponent* component = GetSkeletonComponent(entity);
     DVASSERT(component);
 
@@ -38,24 +179,10 @@ void SkeletonSystem::AddEntity(Entity* entity)
         RebuildSkeleton(component);
 }
 
-void SkeletonSystem::RemoveEntity(Entity* entity)
-{
-    uint32 size = static_cast<uint32>(entities.size());
-    for (uint32 i = 0; i < size; ++i)
-    {
-        if (entities[i] == entity)
-        {
-            entities[i] = entities[size - 1];
-            entities.pop_back();
-            return;
-        }
-    }
-    DVASSERT(0);
-}
-
 void SkeletonSystem::PrepareForRemove()
 {
-    entities.clear();
+    updatedEntities.clear();
+    updatedSkeletons.clear();
 }
 
 void SkeletonSystem::ImmediateEvent(Component* component, uint32 event)
@@ -72,26 +199,41 @@ void SkeletonSystem::Process(float32 timeElapsed)
     UpdateTestSkeletons();
 #endif
 
-    for (int32 i = 0, sz = static_cast<int32>(entities.size()); i < sz; ++i)
+    updatedEntities.clear();
+    updatedSkeletons.clear();
+
+    const Vector<Entity*>& entities = skeletons->GetEntities();
+    const Vector<SkeletonComponent*>& components = skeletons->GetComponents<SkeletonComponent>();
+    for (uint32 i = 0, sz = skeletons->GetSize(); i < sz; ++i)
     {
-        SkeletonComponent* component = GetSkeletonComponent(entities[i]);
+        SkeletonComponent* component = components[i];
+        if (component->configUpdated)
+        {
+            RebuildSkeleton(component);
+        }
 
-        if (component != nullptr)
+        if (component->startJoint != SkeletonComponent::INVALID_JOINT_INDEX)
         {
-            if (component->configUpdated)
-            {
-                RebuildSkeleton(GetSkeletonComponent(entities[i]));
-            }
+            updatedEntities.push_back(entities[i]);
+            updatedSkeletons.push_back(component);
+        }
+    }
 
-            if (component->startJoint != SkeletonComponent::INVALID_JOINT_INDEX)
-            {
-                UpdateJointTransforms(component);
-                RenderObject* ro = GetRenderObject(entities[i]);
-                if (ro != nullptr && (RenderObject::TYPE_SKINNED_MESH == ro->GetType()))
-                {
-                    UpdateSkinnedMesh(component, static_cast<SkinnedMesh*>(ro));
-                }
-            }
+    // joint hierarchies are evaluated in worker threads, skinned meshes are updated on calling thread as they touch render system
+    uint32 updatedCount = static_cast<uint32>(updatedSkeletons.size());
+    ParallelForOrSerial(0, updatedCount, SkeletonSystemDetails::SKELETONS_PER_JOB, [this](uint32 begin, uint32 end) {
+        for (uint32 i = begin; i < end; ++i)
+        {
+            UpdateJointTransforms(updatedSkeletons[i]);
+        }
+    });
+
+    for (uint32 i = 0; i < updatedCount; ++i)
+    {
+        RenderObject* ro = GetRenderObject(updatedEntities[i]);
+        if (ro != nullptr && (RenderObject::TYPE_SKINNED_MESH == ro->GetType()))
+        {
+            UpdateSkinnedMesh(updatedSkeletons[i], static_cast<SkinnedMesh*>(ro));
         }
     }
 
@@ -100,9 +242,7 @@ void SkeletonSystem::Process(float32 timeElapsed)
 
 void SkeletonSystem::DrawSkeletons(RenderHelper* drawer)
 {
-    for (Entity* entity : entities)
-    {
-        SkeletonComponent* component = GetSkeletonComponent(entity);
+    skeletons->ForEach([drawer](Entity* entity, SkeletonComponent* component) {
         if (component->drawSkeleton)
         {
             const Matrix4& worldTransform = GetTransformComponent(entity)->GetWorldTransform();
@@ -110,7 +250,7 @@ void SkeletonSystem::DrawSkeletons(RenderHelper* drawer)
             Vector<Vector3> positions(component->GetJointsCount());
             for (uint32 i = 0; i < component->GetJointsCount(); ++i)
             {
-                positions[i] = component->objectSpaceTransforms[i].GetPosition() * worldTransform;
+                positions[i] = Vector3(component->objectSpacePositions[i].data) * worldTransform;
             }
 
             const Vector<SkeletonComponent::Joint>& joints = component->jointsArray;
@@ -123,9 +263,10 @@ void SkeletonSystem::DrawSkeletons(RenderHelper* drawer)
                     drawer->DrawArrow(positions[cfg.parentIndex], positions[i], arrowLength, Color(1.0f, 0.5f, 0.0f, 1.0), RenderHelper::eDrawType::DRAW_WIRE_NO_DEPTH);
                 }
 
-                Vector3 xAxis = component->objectSpaceTransforms[i].ApplyToPoint(Vector3(1.f, 0.f, 0.f)) * worldTransform;
-                Vector3 yAxis = component->objectSpaceTransforms[i].ApplyToPoint(Vector3(0.f, 1.f, 0.f)) * worldTransform;
-                Vector3 zAxis = component->objectSpaceTransforms[i].ApplyToPoint(Vector3(0.f, 0.f, 1.f)) * worldTransform;
+                const JointTransform& objectSpaceTransform = component->GetJointObjectSpaceTransform(i);
+                Vector3 xAxis = objectSpaceTransform.ApplyToPoint(Vector3(1.f, 0.f, 0.f)) * worldTransform;
+                Vector3 yAxis = objectSpaceTransform.ApplyToPoint(Vector3(0.f, 1.f, 0.f)) * worldTransform;
+                Vector3 zAxis = objectSpaceTransform.ApplyToPoint(Vector3(0.f, 0.f, 1.f)) * worldTransform;
 
                 drawer->DrawLine(positions[i], xAxis, Color::Red, RenderHelper::eDrawType::DRAW_WIRE_NO_DEPTH);
                 drawer->DrawLine(positions[i], yAxis, Color::Green, RenderHelper::eDrawType::DRAW_WIRE_NO_DEPTH);
@@ -134,35 +275,47 @@ void SkeletonSystem::DrawSkeletons(RenderHelper* drawer)
                 //drawer->DrawAABoxTransformed(component->objectSpaceBoxes[i], worldTransform, DAVA::Color::Red, RenderHelper::eDrawType::DRAW_WIRE_NO_DEPTH);
             }
         }
-    }
+    });
 }
 
 void SkeletonSystem::UpdateJointTransforms(SkeletonComponent* skeleton)
 {
+    using namespace SkeletonSystemDetails;
+
     DVASSERT(!skeleton->configUpdated);
 
+    // called from worker threads, should touch only data of passed skeleton
     uint32 count = skeleton->GetJointsCount();
     for (uint32 currJoint = skeleton->startJoint; currJoint < count; ++currJoint)
     {
         uint32 parentJoint = skeleton->jointInfo[currJoint] & SkeletonComponent::INFO_PARENT_MASK;
         if ((skeleton->jointInfo[currJoint] & SkeletonComponent::FLAG_MARKED_FOR_UPDATED) || ((parentJoint != SkeletonComponent::INVALID_JOINT_INDEX) && (skeleton->jointInfo[parentJoint] & SkeletonComponent::FLAG_UPDATED_THIS_FRAME)))
         {
+            const JointTransform& localTransform = skeleton->localSpaceTransforms[currJoint];
+            Vector4 localPosition(localTransform.GetPosition(), localTransform.GetScale());
+            Vector4 localOrientation(localTransform.GetOrientation().data);
+
+            Vector4& objectSpacePosition = skeleton->objectSpacePositions[currJoint];
+            Vector4& objectSpaceOrientation = skeleton->objectSpaceOrientations[currJoint];
+
             //calculate object space transforms
             if (parentJoint == SkeletonComponent::INVALID_JOINT_INDEX) //root
             {
-                skeleton->objectSpaceTransforms[currJoint] = skeleton->localSpaceTransforms[currJoint]; //just copy
+                objectSpacePosition = localPosition; //just copy
+                objectSpaceOrientation = localOrientation;
             }
             else
             {
-                skeleton->objectSpaceTransforms[currJoint] = skeleton->objectSpaceTransforms[parentJoint].AppendTransform(skeleton->localSpaceTransforms[currJoint]);
+                AppendTransform(skeleton->objectSpacePositions[parentJoint], skeleton->objectSpaceOrientations[parentJoint], localPosition, localOrientation, objectSpacePosition, objectSpaceOrientation);
             }
+            StoreTransform(objectSpacePosition, objectSpaceOrientation, skeleton->objectSpaceTransforms[currJoint]);
 
             //calculate final transform including bindTransform
-            skeleton->finalTransforms[currJoint] = skeleton->objectSpaceTransforms[currJoint].AppendTransform(skeleton->inverseBindTransforms[currJoint]);
+            AppendTransform(objectSpacePosition, objectSpaceOrientation, skeleton->inverseBindPositions[currJoint], skeleton->inverseBindOrientations[currJoint], skeleton->finalPositions[currJoint], skeleton->finalOrientations[currJoint]);
 
             if (!skeleton->jointsArray[currJoint].bbox.IsEmpty())
             {
-                skeleton->objectSpaceBoxes[currJoint] = skeleton->objectSpaceTransforms[currJoint].ApplyToAABBox(skeleton->jointsArray[currJoint].bbox);
+                skeleton->objectSpaceBoxes[currJoint] = TransformBox(skeleton->jointsArray[currJoint].bbox, objectSpacePosition, objectSpaceOrientation);
             }
             else
             {
@@ -197,7 +350,7 @@ void SkeletonSystem::UpdateSkinnedMesh(SkeletonComponent* skeleton, SkinnedMesh*
         }
     }
 
-    skinnedMeshObject->UpdateJointTransforms(skeleton->finalTransforms);
+    skinnedMeshObject->UpdateJointTransforms(skeleton->finalPositions, skeleton->finalOrientations);
     skinnedMeshObject->SetBoundingBox(resBox); //TODO: *Skinning* decide on bbox calculation
 
     GetScene()->GetRenderSystem()->MarkForUpdate(skinnedMeshObject);
@@ -205,14 +358,20 @@ void SkeletonSystem::UpdateSkinnedMesh(SkeletonComponent* skeleton, SkinnedMesh*
 
 void SkeletonSystem::RebuildSkeleton(SkeletonComponent* skeleton)
 {
+    using namespace SkeletonSystemDetails;
+
     skeleton->configUpdated = false;
 
     size_t jointsCount = skeleton->jointsArray.size();
     skeleton->jointInfo.resize(jointsCount);
     skeleton->localSpaceTransforms.resize(jointsCount);
     skeleton->objectSpaceTransforms.resize(jointsCount);
-    skeleton->finalTransforms.resize(jointsCount);
-    skeleton->inverseBindTransforms.resize(jointsCount);
+    skeleton->objectSpacePositions.resize(jointsCount);
+    skeleton->objectSpaceOrientations.resize(jointsCount);
+    skeleton->finalPositions.resize(jointsCount);
+    skeleton->finalOrientations.resize(jointsCount);
+    skeleton->inverseBindPositions.resize(jointsCount);
+    skeleton->inverseBindOrientations.resize(jointsCount);
     skeleton->objectSpaceBoxes.resize(jointsCount);
 
     DVASSERT(skeleton->jointsArray.size() < SkeletonComponent::INFO_PARENT_MASK);
@@ -227,16 +386,25 @@ void SkeletonSystem::RebuildSkeleton(SkeletonComponent* skeleton)
         localTransform.Construct(skeleton->jointsArray[i].bindTransform);
 
         skeleton->localSpaceTransforms[i] = localTransform;
-        if (skeleton->jointsArray[i].parentIndex == SkeletonComponent::INVALID_JOINT_INDEX)
+
+        Vector4 localPosition(localTransform.GetPosition(), localTransform.GetScale());
+        Vector4 localOrientation(localTransform.GetOrientation().data);
+        uint32 parentIndex = skeleton->jointsArray[i].parentIndex;
+        if (parentIndex == SkeletonComponent::INVALID_JOINT_INDEX)
         {
-            skeleton->objectSpaceTransforms[i] = localTransform;
+            skeleton->objectSpacePositions[i] = localPosition;
+            skeleton->objectSpaceOrientations[i] = localOrientation;
         }
         else
         {
-            skeleton->objectSpaceTransforms[i] = skeleton->objectSpaceTransforms[skeleton->jointsArray[i].parentIndex].AppendTransform(localTransform);
+            AppendTransform(skeleton->objectSpacePositions[parentIndex], skeleton->objectSpaceOrientations[parentIndex], localPosition, localOrientation, skeleton->objectSpacePositions[i], skeleton->objectSpaceOrientations[i]);
         }
+        StoreTransform(skeleton->objectSpacePositions[i], skeleton->objectSpaceOrientations[i], skeleton->objectSpaceTransforms[i]);
 
-        skeleton->inverseBindTransforms[i].Construct(skeleton->jointsArray[i].bindTransformInv);
+        JointTransform inverseBindTransform;
+        inverseBindTransform.Construct(skeleton->jointsArray[i].bindTransformInv);
+        skeleton->inverseBindPositions[i] = Vector4(inverseBindTransform.GetPosition(), inverseBindTransform.GetScale());
+        skeleton->inverseBindOrientations[i] = Vector4(inverseBindTransform.GetOrientation().data);
     }
 
     skeleton->startJoint = 0;
@@ -247,38 +415,33 @@ void SkeletonSystem::UpdateTestSkeletons(float32 timeElapsed)
     static float32 t = 0;
     t += timeElapsed;
 
-    for (Entity* entity : entities)
-    {
-        SkeletonComponent* component = GetSkeletonComponent(entity);
-        if (component != nullptr)
-        {
-            static const FastName SOFT_SKINNED_ENTITY_NAME("TestSoftSkinned");
+    skeletons->ForEach([](Entity* entity, SkeletonComponent* component) {
+        static const FastName SOFT_SKINNED_ENTITY_NAME("TestSoftSkinned");
 
-            if (entity->GetName() == SOFT_SKINNED_ENTITY_NAME)
+        if (entity->GetName() == SOFT_SKINNED_ENTITY_NAME)
+        {
+            //Manipulate test soft skinned mesh in 'Debug Functions' in RE
+            uint32 jointCount = component->GetJointsCount();
+            for (uint32 j = 1; j < jointCount; ++j)
             {
-                //Manipulate test soft skinned mesh in 'Debug Functions' in RE
-                uint32 jointCount = component->GetJointsCount();
-                for (uint32 j = 1; j < jointCount; ++j)
-                {
-                    component->GetJoint(j).bindTransform.GetTranslationVector();
+                component->GetJoint(j).bindTransform.GetTranslationVector();
 
-                    Vector3 position = component->GetJoint(j).bindTransform.GetTranslationVector();
-                    position.z += 5.f * sinf(float32(j + t));
+                Vector3 position = component->GetJoint(j).bindTransform.GetTranslationVector();
+                position.z += 5.f * sinf(float32(j + t));
 
-                    JointTransform transform;
-                    transform.SetPosition(position);
+                JointTransform transform;
+                transform.SetPosition(position);
 
-                    component->SetJointTransform(j, transform);
-                }
+                component->SetJointTransform(j, transform);
             }
-            else
+        }
+        else
+        {
+            for (uint32 i = 0, sz = component->GetJointsCount(); i < sz; ++i)
             {
-                for (uint32 i = 0, sz = component->GetJointsCount(); i < sz; ++i)
-                {
-                    component->SetJointOrientation(i, Quaternion::MakeRotationFastY(t));
-                }
+                component->SetJointOrientation(i, Quaternion::MakeRotationFastY(t));
             }
         }
-    }
+    });
 }
 }
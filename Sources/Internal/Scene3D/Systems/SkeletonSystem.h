@@ -8,6 +8,8 @@ namespace DAVA
 {
 class Component;
 class SkeletonComponent;
+template <typename... T>
+class EntityGroup;
 class SkinnedMesh;
 class RenderHelper;
 
@@ -18,7 +20,6 @@ public:
     ~SkeletonSystem();
 
     void AddEntity(Entity* entity) override;
-    void RemoveEntity(Entity* entity) override;
     void PrepareForRemove() override;
 
     void ImmediateEvent(Component* component, uint32 event) override;
@@ -34,7 +35,9 @@ private:
 
     void UpdateTestSkeletons(float32 timeElapsed);
 
-    Vector<Entity*> entities;
+    EntityGroup<SkeletonComponent>* skeletons = nullptr;
+    Vector<Entity*> updatedEntities; //entities with skeletons updated in current frame
+    Vector<SkeletonComponent*> updatedSkeletons; //skeletons of `updatedEntities`
 };
 
 } //ns
@@ -8,9 +8,19 @@
 #include "Scene3D/Components/SingleComponents/TransformSingleComponent.h"
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
+
+#include <algorithm>
 
 namespace DAVA
 {
+namespace TransformSystemDetails
+{
+const uint32 SUBTREES_PER_JOB = 16;
+}
+
 TransformSystem::TransformSystem(Scene* scene)
     : SceneSystem(scene)
 {
@@ -37,8 +47,8 @@ void TransformSystem::Process(float32 timeElapsed)
         HierarchicAddToUpdate(e);
     }
 
-    passedNodes = 0;
-    multipliedNodes = 0;
+    statistics = Statistics();
+    subtreeRoots.clear();
 
     uint32 size = static_cast<uint32>(updatableEntities.size());
     for (uint32 i = 0; i < size; ++i)
@@ -46,55 +56,131 @@ void TransformSystem::Process(float32 timeElapsed)
         FindNodeThatRequireUpdate(updatableEntities[i]);
     }
     updatableEntities.clear();
+
+    RemoveNestedSubtrees();
+    TransformSubtrees();
 }
 
 void TransformSystem::FindNodeThatRequireUpdate(Entity* entity)
 {
-    static const uint32 STACK_SIZE = 5000;
-    uint32 stackPosition = 0;
-    Entity* stack[STACK_SIZE];
-    stack[stackPosition++] = entity;
+    searchStack.clear();
+    searchStack.push_back(entity);
 
-    while (stackPosition > 0)
+    while (!searchStack.empty())
     {
-        Entity* entity = stack[--stackPosition];
+        Entity* entity = searchStack.back();
+        searchStack.pop_back();
+        statistics.passedNodes++;
 
         if (entity->GetFlags() & Entity::TRANSFORM_NEED_UPDATE)
         {
-            TransformAllChildEntities(entity);
+            // parent of found node is already up to date, so subtrees can be transformed independently
+            subtreeRoots.push_back(entity);
         }
         else
         {
             entity->RemoveFlag(Entity::TRANSFORM_NEED_UPDATE | Entity::TRANSFORM_DIRTY);
 
-            // We already marked all children as non-dirty if we entered to TransformAllChildEntities()
+            // Children of subtree roots are marked as non-dirty in TransformAllChildEntities()
             uint32 size = entity->GetChildrenCount();
             for (uint32 i = 0; i < size; ++i)
             {
                 Entity* childEntity = entity->GetChild(i);
                 if (childEntity->GetFlags() & Entity::TRANSFORM_DIRTY)
                 {
-                    DVASSERT(stackPosition < STACK_SIZE - 1);
-                    stack[stackPosition++] = childEntity;
+                    searchStack.push_back(childEntity);
                 }
             }
         }
     }
-    DVASSERT(stackPosition == 0);
 }
 
-void TransformSystem::TransformAllChildEntities(Entity* entity)
+void TransformSystem::RemoveNestedSubtrees()
+{
+    // Top-level entity and its child could be both scheduled for update (e.g. scene itself and its child).
+    // Nested subtree is already covered by outer one, and it shouldn't be transformed twice in different jobs.
+    if (subtreeRoots.size() < 2)
+        return;
+
+    sortedSubtreeRoots.assign(subtreeRoots.begin(), subtreeRoots.end());
+    std::sort(sortedSubtreeRoots.begin(), sortedSubtreeRoots.end());
+
+    auto isNested = [this](Entity* entity) {
+        for (Entity* parent = entity->GetParent(); parent != nullptr; parent = parent->GetParent())
+        {
+            if ((parent->GetFlags() & Entity::TRANSFORM_NEED_UPDATE) && std::binary_search(sortedSubtreeRoots.begin(), sortedSubtreeRoots.end(), parent))
+                return true;
+        }
+        return false;
+    };
+    subtreeRoots.erase(std::remove_if(subtreeRoots.begin(), subtreeRoots.end(), isNested), subtreeRoots.end());
+}
+
+void TransformSystem::TransformSubtrees()
+{
+    uint32 subtreesCount = static_cast<uint32>(subtreeRoots.size());
+    statistics.transformedSubtrees = subtreesCount;
+    if (subtreesCount == 0)
+        return;
+
+    // every chunk takes at least one subtree
+    if (chunks.size() < subtreesCount)
+    {
+        chunks.resize(subtreesCount);
+    }
+    usedChunksCount = 0;
+
+    auto transformChunk = [this](uint32 begin, uint32 end) {
+        DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::SCENE_TRANSFORM_SYSTEM_SUBTREES);
+
+        SubtreesChunk& chunk = chunks[usedChunksCount++];
+        chunk.firstSubtree = begin;
+        chunk.multipliedNodes = 0;
+        chunk.changedEntities.clear();
+        for (uint32 i = begin; i < end; ++i)
+        {
+            TransformAllChildEntities(subtreeRoots[i], chunk);
+        }
+    };
+
+    if (parallelUpdateEnabled)
+    {
+        ParallelForOrSerial(0, subtreesCount, TransformSystemDetails::SUBTREES_PER_JOB, transformChunk);
+    }
+    else
+    {
+        transformChunk(0, subtreesCount);
+    }
+
+    // changed entities are reported in order of subtrees whatever chunks were executed first
+    uint32 usedCount = usedChunksCount.Get();
+    std::sort(chunks.begin(), chunks.begin() + usedCount, [](const SubtreesChunk& l, const SubtreesChunk& r) {
+        return l.firstSubtree < r.firstSubtree;
+    });
+
+    TransformSingleComponent* tsc = GetScene()->transformSingleComponent;
+    for (uint32 i = 0; i < usedCount; ++i)
+    {
+        statistics.multipliedNodes += chunks[i].multipliedNodes;
+        for (Entity* entity : chunks[i].changedEntities)
+        {
+            tsc->worldTransformChanged.Push(entity);
+        }
+    }
+}
+
+void TransformSystem::TransformAllChildEntities(Entity* entity, SubtreesChunk& chunk)
 {
-    static const uint32 STACK_SIZE = 5000;
-    uint32 stackPosition = 0;
-    Entity* stack[STACK_SIZE];
-    stack[stackPosition++] = entity;
+    Vector<Entity*>& stack = chunk.stack;
+    stack.clear();
+    stack.push_back(entity);
 
-    int32 localMultiplied = 0;
+    uint32 localMultiplied = 0;
 
-    while (stackPosition > 0)
+    while (!stack.empty())
     {
-        Entity* entity = stack[--stackPosition];
+        Entity* entity = stack.back();
+        stack.pop_back();
 
         TransformComponent* transform = entity->GetComponent<TransformComponent>();
         if (transform->parentMatrix)
@@ -109,8 +195,7 @@ void TransformSystem::TransformAllChildEntities(Entity* entity)
             {
                 transform->worldMatrix = transform->localMatrix * *(transform->parentMatrix);
             }
-            TransformSingleComponent* tsc = GetScene()->transformSingleComponent;
-            tsc->worldTransformChanged.Push(entity);
+            chunk.changedEntities.push_back(entity);
         }
 
         entity->RemoveFlag(Entity::TRANSFORM_NEED_UPDATE | Entity::TRANSFORM_DIRTY);
@@ -118,12 +203,10 @@ void TransformSystem::TransformAllChildEntities(Entity* entity)
         uint32 size = entity->GetChildrenCount();
         for (uint32 i = 0; i < size; ++i)
         {
-            DVASSERT(stackPosition < STACK_SIZE - 1);
-            stack[stackPosition++] = entity->GetChild(i);
+            stack.push_back(entity->GetChild(i));
         }
     }
-    DVASSERT(stackPosition == 0);
-    multipliedNodes += localMultiplied;
+    chunk.multipliedNodes += localMultiplied;
 }
 
 void TransformSystem::EntityNeedUpdate(Entity* entity)
@@ -4,6 +4,7 @@
 #include "Math/MathConstants.h"
 #include "Math/Matrix4.h"
 #include "Base/Singleton.h"
+#include "Concurrency/Atomic.h"
 #include "Entity/SceneSystem.h"
 
 namespace DAVA
@@ -14,6 +15,14 @@ class Transform;
 class TransformSystem : public SceneSystem
 {
 public:
+    /** Counters of last `Process` call. */
+    struct Statistics
+    {
+        uint32 passedNodes = 0; ///< nodes visited while searching for changed transforms
+        uint32 multipliedNodes = 0; ///< nodes which world transform was recalculated
+        uint32 transformedSubtrees = 0; ///< independent subtrees which world transforms were recalculated
+    };
+
     TransformSystem(Scene* scene);
 
     void AddEntity(Entity* entity) override;
@@ -22,15 +31,55 @@ public:
     void PrepareForRemove() override;
     void Process(float32 timeElapsed) override;
 
+    /**
+        Enable or disable update of independent subtrees in worker jobs.
+        Result of update doesn't depend on this option, including order of entities in `TransformSingleComponent::worldTransformChanged`.
+    */
+    void SetParallelUpdateEnabled(bool enabled);
+    bool IsParallelUpdateEnabled() const;
+
+    const Statistics& GetStatistics() const;
+
 private:
+    struct SubtreesChunk
+    {
+        uint32 firstSubtree = 0;
+        uint32 multipliedNodes = 0;
+        Vector<Entity*> changedEntities;
+        Vector<Entity*> stack;
+    };
+
     Vector<Entity*> updatableEntities;
 
     void EntityNeedUpdate(Entity* entity);
     void HierarchicAddToUpdate(Entity* entity);
     void FindNodeThatRequireUpdate(Entity* entity);
-    void TransformAllChildEntities(Entity* entity);
+    void RemoveNestedSubtrees();
+    void TransformSubtrees();
+    void TransformAllChildEntities(Entity* entity, SubtreesChunk& chunk);
+
+    Vector<Entity*> searchStack;
+    Vector<Entity*> subtreeRoots;
+    Vector<Entity*> sortedSubtreeRoots;
+    Vector<SubtreesChunk> chunks;
+    Atomic<uint32> usedChunksCount;
 
-    int32 passedNodes;
-    int32 multipliedNodes;
+    Statistics statistics;
+    bool parallelUpdateEnabled = true;
 };
+
+inline void TransformSystem::SetParallelUpdateEnabled(bool enabled)
+{
+    parallelUpdateEnabled = enabled;
+}
+
+inline bool TransformSystem::IsParallelUpdateEnabled() const
+{
+    return parallelUpdateEnabled;
+}
+
+inline const TransformSystem::Statistics& TransformSystem::GetStatistics() const
+{
+    return statistics;
+}
 };
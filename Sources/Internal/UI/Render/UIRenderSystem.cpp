@@ -4,6 +4,7 @@
 #include "Render/2D/Systems/RenderSystem2D.h"
 #include "Render/2D/Systems/VirtualCoordinatesSystem.h"
 #include "Render/2D/TextBlock.h"
+#include "Render/2D/TextBlockGlyphAtlasRender.h"
 #include "Render/2D/TextBlockSoftwareRender.h"
 #include "Render/Renderer.h"
 #include "UI/Render/UIClipContentComponent.h"
@@ -23,6 +24,7 @@ namespace DAVA
 namespace RenderTextDetails
 {
 static void PrepareSprite(const UITextSystemLink* link);
+static void DrawGlyphs(TextBlockGlyphAtlasRender* glyphRender, const UIGeometricData& textGeomData, const Color& color, int32 align);
 
 #if defined(LOCALIZATION_DEBUG)
 static void DrawDebug(const UITextSystemLink* link, const UIGeometricData& textGeomData);
@@ -276,6 +278,9 @@ void UIRenderSystem::RenderText(const UIControl* control, const UITextComponent*
 
     textBg->SetAlign(textBlock->GetVisualAlign());
 
+    // text drawn through glyph atlas has no sprite, glyphs are aligned same way as sprite
+    TextBlockGlyphAtlasRender* glyphRender = dynamic_cast<TextBlockGlyphAtlasRender*>(textBlock->GetRenderer());
+
     UIGeometricData textGeomData;
     textGeomData.position = textBlock->GetSpriteOffset();
     textGeomData.size = control->GetSize();
@@ -293,11 +298,19 @@ void UIRenderSystem::RenderText(const UIControl* control, const UITextComponent*
 
         shadowBg->SetAlign(textBg->GetAlign());
         shadowBg->Draw(shadowGeomData);
+        if (glyphRender != nullptr)
+        {
+            RenderTextDetails::DrawGlyphs(glyphRender, shadowGeomData, shadowBg->GetDrawColor(), textBg->GetAlign());
+        }
     }
 
     textBlock->Draw(textBg->GetDrawColor());
 
     textBg->Draw(textGeomData);
+    if (glyphRender != nullptr)
+    {
+        RenderTextDetails::DrawGlyphs(glyphRender, textGeomData, textBg->GetDrawColor(), textBg->GetAlign());
+    }
      
 #if defined(LOCALIZATION_DEBUG)
     RenderTextDetails::DrawDebug(link, geometricData);
@@ -338,6 +351,57 @@ static void PrepareSprite(const UITextSystemLink* link)
 }
 
 
+static void DrawGlyphs(TextBlockGlyphAtlasRender* glyphRender, const UIGeometricData& textGeomData, const Color& color, int32 align)
+{
+    // same placement as in UIControlBackground::Draw for DRAW_ALIGNED type
+    UIGeometricData geometricData;
+    geometricData.size = textGeomData.size;
+    geometricData.AddGeometricData(textGeomData);
+    const Rect& drawRect = geometricData.GetUnrotatedRect();
+    Vector2 textSize = glyphRender->GetTextSize() * geometricData.scale;
+
+    Vector2 position;
+    if (align & ALIGN_LEFT)
+    {
+        position.x = drawRect.x;
+    }
+    else if (align & ALIGN_RIGHT)
+    {
+        position.x = drawRect.x + drawRect.dx - textSize.x;
+    }
+    else
+    {
+        position.x = drawRect.x + (drawRect.dx - textSize.x) * 0.5f;
+    }
+    if (align & ALIGN_TOP)
+    {
+        position.y = drawRect.y;
+    }
+    else if (align & ALIGN_BOTTOM)
+    {
+        position.y = drawRect.y + drawRect.dy - textSize.y;
+    }
+    else
+    {
+        position.y = drawRect.y + (drawRect.dy - textSize.y) * 0.5f;
+    }
+    if (geometricData.angle != 0)
+    {
+        float32 tmpX = position.x;
+        position.x = (tmpX - geometricData.position.x) * geometricData.cosA + (geometricData.position.y - position.y) * geometricData.sinA + geometricData.position.x;
+        position.y = (tmpX - geometricData.position.x) * geometricData.sinA + (position.y - geometricData.position.y) * geometricData.cosA + geometricData.position.y;
+    }
+
+    Matrix4 scaleMatrix;
+    scaleMatrix.BuildScale(Vector3(geometricData.scale.x, geometricData.scale.y, 1.f));
+    Matrix4 rotateMatrix;
+    rotateMatrix.BuildRotation(Vector3(0.f, 0.f, 1.f), -geometricData.angle); // sprites are rotated clockwise
+    Matrix4 translateMatrix;
+    translateMatrix.BuildTranslation(Vector3(position.x, position.y, 0.f));
+
+    glyphRender->Draw(color, scaleMatrix * rotateMatrix * translateMatrix);
+}
+
 #if defined(LOCALIZATION_DEBUG)
 enum DebugHighliteColor
 {